@@ -0,0 +1,49 @@
+/**
+ * telemetryToText.cpp, converts the tables of a telemetry file written by the
+ * monitors to text files named after the tables.
+ *
+ * Usage: telemetryToText xolotlTelemetry.h5 [table ...]
+ */
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <TelemetrySink.h>
+
+using namespace std;
+
+//................................................................................
+ int 
+ main( int argc, char **argv ) 
+ {
+  if (argc < 2) 
+  {
+   std::cerr << "Usage: " << argv[0] << " telemetryFile [table ...]" << std::endl;
+   return EXIT_FAILURE;
+  }
+  std::string fileName = argv[1];
+
+  try 
+  {
+// Convert all the tables if none is given
+   std::vector<std::string> tables(argv + 2, argv + argc);
+   if (tables.empty()) tables = xolotlCore::TelemetrySink::getTables(fileName);
+
+// Write each table in its own file
+   for (auto const& table : tables) 
+   {
+    std::ofstream outputFile(table + ".txt");
+    xolotlCore::TelemetrySink::writeText(fileName, table, outputFile);
+    outputFile.close();
+    std::cout << "Wrote " << table << ".txt" << std::endl;
+   }
+  } 
+  catch (const std::string& error) 
+  {
+   std::cerr << error << std::endl;
+   return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+ }
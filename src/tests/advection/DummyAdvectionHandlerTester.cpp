@@ -44,14 +44,15 @@ BOOST_AUTO_TEST_CASE(checkAdvection) {
 	DummyAdvectionHandler advectionHandler;
 
 	// Create ofill
-	int mat[dof * dof];
-	int *ofill = &mat[0];
+	SparseFillMap ofill;
 
 	// Initialize it
 	advectionHandler.initialize(network, ofill);
 
 	// Check the total number of advecting clusters, it should be 0 here
 	BOOST_REQUIRE_EQUAL(advectionHandler.getNumberOfAdvecting(), 0);
+	// Nothing should be set in ofill
+	BOOST_REQUIRE(ofill.empty());
 
 	// The size parameter
 	double hx = 1.0;
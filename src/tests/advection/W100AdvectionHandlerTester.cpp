@@ -47,8 +47,7 @@ BOOST_AUTO_TEST_CASE(checkAdvection) {
 	}
 
 	// Create ofill
-	int mat[dof * dof];
-	int *ofill = &mat[0];
+	SparseFillMap ofill;
 
 	// Create a collection of advection handlers
 	std::vector<IAdvectionHandler *> advectionHandlers;
@@ -61,13 +60,17 @@ BOOST_AUTO_TEST_CASE(checkAdvection) {
 	// Check the total number of advecting clusters
 	BOOST_REQUIRE_EQUAL(advectionHandler.getNumberOfAdvecting(), 6);
 
-	// Check the clusters in ofill
-	BOOST_REQUIRE_EQUAL(ofill[0], 1);
-	BOOST_REQUIRE_EQUAL(ofill[10], 1);
-	BOOST_REQUIRE_EQUAL(ofill[20], 1);
-	BOOST_REQUIRE_EQUAL(ofill[30], 1);
-	BOOST_REQUIRE_EQUAL(ofill[40], 1);
-	BOOST_REQUIRE_EQUAL(ofill[50], 1);
+	// Check the clusters in ofill, the row of each advecting cluster only
+	// has its own diagonal entry
+	for (int k = 0; k < 6; k++) {
+		BOOST_REQUIRE_EQUAL(ofill.at(k).size(), 1);
+		BOOST_REQUIRE_EQUAL(ofill.at(k)[0], k);
+	}
+	// The other clusters don't advect and have no row
+	BOOST_REQUIRE_EQUAL(ofill.size(), 6);
+	for (int k = 6; k < dof; k++) {
+		BOOST_REQUIRE_EQUAL(ofill.count(k), 0);
+	}
 
 	// Set the size parameter in the x direction
 	double hx = 1.0;
@@ -109,7 +109,8 @@ BOOST_AUTO_TEST_CASE(goodParamFile) {
 			<< std::endl << "initialV=0.05" << std::endl << "dimensions=1"
 			<< std::endl << "voidPortion=60.0" << std::endl << "regularGrid=no"
 			<< std::endl << "process=diff" << std::endl << "grouping=11 2 4"
-			<< std::endl << "sputtering=0.5" << std::endl;
+			<< std::endl << "sputtering=0.5" << std::endl << "threads=4"
+			<< std::endl << "networkCache=networkCache.h5" << std::endl;
 	goodParamFile.close();
 
 	string pathToFile("param_good.txt");
@@ -173,6 +174,12 @@ BOOST_AUTO_TEST_CASE(goodParamFile) {
 	// Check the sputtering option
 	BOOST_REQUIRE_EQUAL(opts.getSputteringYield(), 0.5);
 
+	// Check the threads option
+	BOOST_REQUIRE_EQUAL(opts.getNumThreads(), 4);
+
+	// Check the network cache option
+	BOOST_REQUIRE_EQUAL(opts.getNetworkCacheFilename(), "networkCache.h5");
+
 	// Check the physical processes option
 	auto map = opts.getProcesses();
 	BOOST_REQUIRE_EQUAL(map["diff"], true);
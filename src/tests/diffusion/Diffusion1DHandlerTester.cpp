@@ -54,21 +54,23 @@ BOOST_AUTO_TEST_CASE(checkDiffusion) {
 	std::vector<IAdvectionHandler *> advectionHandlers;
 
 	// Create ofill
-	int mat[dof * dof];
-	int *ofill = &mat[0];
+	SparseFillMap ofill;
 
 	// Initialize it
 	diffusionHandler.initializeOFill(network, ofill);
 	diffusionHandler.initializeDiffusionGrid(advectionHandlers, grid);
 
-	// All the clusters diffuse except the 7-th and 8-th one
-	BOOST_REQUIRE_EQUAL(ofill[0], 1);
-	BOOST_REQUIRE_EQUAL(ofill[10], 1);
-	BOOST_REQUIRE_EQUAL(ofill[20], 1);
-	BOOST_REQUIRE_EQUAL(ofill[30], 1);
-	BOOST_REQUIRE_EQUAL(ofill[40], 1);
-	BOOST_REQUIRE_EQUAL(ofill[50], 1);
-	BOOST_REQUIRE_EQUAL(ofill[80], 1);
+	// All the clusters diffuse except the 7-th and 8-th one, the row of each
+	// diffusing cluster only has its own diagonal entry
+	std::vector<int> diffusing = { 0, 1, 2, 3, 4, 5, 8 };
+	for (auto k : diffusing) {
+		BOOST_REQUIRE_EQUAL(ofill.at(k).size(), 1);
+		BOOST_REQUIRE_EQUAL(ofill.at(k)[0], k);
+	}
+	// The other clusters have no row
+	BOOST_REQUIRE_EQUAL(ofill.size(), diffusing.size());
+	BOOST_REQUIRE_EQUAL(ofill.count(6), 0);
+	BOOST_REQUIRE_EQUAL(ofill.count(7), 0);
 
 	// Check the total number of diffusing clusters
 	BOOST_REQUIRE_EQUAL(diffusionHandler.getNumberOfDiffusing(), 7);
@@ -45,14 +45,15 @@ BOOST_AUTO_TEST_CASE(checkDiffusion) {
 	DummyDiffusionHandler diffusionHandler;
 
 	// Create ofill
-	int mat[dof * dof];
-	int *ofill = &mat[0];
+	SparseFillMap ofill;
 
 	// Initialize it
 	diffusionHandler.initializeOFill(network, ofill);
 
 	// Check the total number of diffusing clusters, here 0
 	BOOST_REQUIRE_EQUAL(diffusionHandler.getNumberOfDiffusing(), 0);
+	// Nothing should be set in ofill
+	BOOST_REQUIRE(ofill.empty());
 
 	// The size parameter in the x direction
 	double hx = 1.0;
@@ -190,6 +190,59 @@ BOOST_AUTO_TEST_CASE(checkFluxAmplitude) {
 	return;
 }
 
+BOOST_AUTO_TEST_CASE(checkSurfaceMove) {
+	// Create the network loader
+	HDF5NetworkLoader loader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Define the filename to load the network from
+	string sourceDir(XolotlSourceDirectory);
+	string pathToFile("/tests/testfiles/tungsten_diminutive.h5");
+	string filename = sourceDir + pathToFile;
+	// Give the filename to the network loader
+	loader.setFilename(filename);
+
+	// Load the network
+	auto network = loader.load().get();
+	// Get its size
+	const int dof = network->getDOF();
+
+	// Create a grid
+	std::vector<double> grid;
+	for (int l = 0; l < 8; l++) {
+		grid.push_back((double) l * 1.25);
+	}
+
+	// Create the flux handler that will follow the surface
+	auto movingFlux = make_shared<W100FitFluxHandler>();
+	movingFlux->setFluxAmplitude(1.0);
+	movingFlux->initializeFluxHandler(network, 0, grid);
+
+	// Move the surface forward and back, the flux at each position must be
+	// the one of a flux handler initialized there
+	std::vector<int> positions = { 3, 1, 0, 3 };
+	for (int surfacePos : positions) {
+		movingFlux->setSurfacePosition(surfacePos);
+
+		auto freshFlux = make_shared<W100FitFluxHandler>();
+		freshFlux->setFluxAmplitude(1.0);
+		freshFlux->initializeFluxHandler(network, surfacePos, grid);
+
+		// Compare the flux at every grid point after the surface
+		for (int xi = surfacePos + 1; xi < grid.size(); xi++) {
+			std::vector<double> movingConc(dof, 0.0), freshConc(dof, 0.0);
+			movingFlux->computeIncidentFlux(1.0, movingConc.data(), xi,
+					surfacePos);
+			freshFlux->computeIncidentFlux(1.0, freshConc.data(), xi,
+					surfacePos);
+			for (int i = 0; i < dof; i++) {
+				BOOST_REQUIRE_EQUAL(movingConc[i], freshConc[i]);
+			}
+		}
+	}
+
+	return;
+}
+
 BOOST_AUTO_TEST_CASE(checkTimeProfileFlux) {
 	// Create the network loader
 	HDF5NetworkLoader loader = HDF5NetworkLoader(
@@ -283,6 +336,12 @@ BOOST_AUTO_TEST_CASE(checkTimeProfileFlux) {
 	// Check the value of the flux amplitude
 	BOOST_REQUIRE_EQUAL(testFitFlux->getFluxAmplitude(), 1500.0);
 
+	// The breakpoints are the times of the profile
+	auto breakpoints = testFitFlux->getBreakpoints();
+	BOOST_REQUIRE_EQUAL(breakpoints.size(), 5);
+	BOOST_REQUIRE_EQUAL(breakpoints[1], 1.0);
+	BOOST_REQUIRE_EQUAL(breakpoints[4], 4.0);
+
 	// Remove the created file
 	std::string tempFile = "fluxFile.dat";
 	std::remove(tempFile.c_str());
@@ -0,0 +1,167 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/included/unit_test.hpp>
+#include <HDF5Utils.h>
+#include <HDF5RestartReader.h>
+#include <mpi.h>
+
+using namespace std;
+using namespace xolotlCore;
+
+/**
+ * This suite is responsible for testing the HDF5RestartReader
+ */
+BOOST_AUTO_TEST_SUITE(HDF5RestartReader_testSuite)
+
+/**
+ * Method checking the reading of a 2D restart file written in a single
+ * dataset.
+ */
+BOOST_AUTO_TEST_CASE(checkRestart2D) {
+	// Initialize MPI for HDF5
+	int argc = 0;
+	char **argv;
+	MPI_Init(&argc, &argv);
+
+	// Create the file with its header
+	int nx = 4, ny = 3;
+	double hx = 0.5, hy = 1.0;
+	auto file = HDF5Utils::initializeFile("restart.h5");
+	HDF5Utils::fillHeader(file, nx, hx, ny, hy);
+	HDF5Utils::finalizeFile(file);
+
+	// Add the concentration sub group and the surface information
+	int timeStep = 2;
+	double currentTime = 0.0001, previousTime = 0.00001,
+			currentTimeStep = 0.000001;
+	file = HDF5Utils::openFile("restart.h5");
+	HDF5Utils::addConcentrationSubGroup(file, timeStep, currentTime,
+			previousTime, currentTimeStep);
+	std::vector<int> iSurface = { 2, 1, 0 };
+	std::vector<double> nInter = { 0.5, 0.0, 1.5 };
+	std::vector<double> previousFlux = { 0.1, 0.2, 0.3 };
+	HDF5Utils::writeSurface2D(file, timeStep, iSurface, nInter, previousFlux);
+
+	// Give (i + 1) concentrations to the grid points of the first row and
+	// none to the other ones except the last one
+	std::vector<double> concArray;
+	std::vector<int> concSizes;
+	for (int j = 0; j < ny; j++) {
+		for (int i = 0; i < nx; i++) {
+			int size = 0;
+			if (j == 0)
+				size = i + 1;
+			else if (i == nx - 1 && j == ny - 1)
+				size = 2;
+			for (int l = 0; l < size; l++) {
+				concArray.push_back((double) l);
+				concArray.push_back(100.0 * j + 10.0 * i + (double) l);
+			}
+			concSizes.push_back(size);
+		}
+	}
+	HDF5Utils::writeConcentrations(file, concArray, concSizes, nx, 0, nx, ny,
+			0, ny);
+	HDF5Utils::closeFile(file);
+
+	// Read it back
+	HDF5RestartReader reader("restart.h5");
+
+	// Check the header
+	int nxRead = 0, nyRead = 0, nzRead = 0;
+	double hxRead = 0.0, hyRead = 0.0, hzRead = 0.0;
+	reader.getHeader(nxRead, hxRead, nyRead, hyRead, nzRead, hzRead);
+	BOOST_REQUIRE_EQUAL(nxRead, nx);
+	BOOST_REQUIRE_EQUAL(nyRead, ny);
+	BOOST_REQUIRE_CLOSE(hxRead, hx, 0.0001);
+	BOOST_REQUIRE_CLOSE(hyRead, hy, 0.0001);
+
+	// Check the time step information
+	BOOST_REQUIRE(reader.hasConcentrations());
+	BOOST_REQUIRE_EQUAL(reader.getLastTimeStep(), timeStep);
+	double time = 0.0, deltaTime = 0.0;
+	reader.getTimes(time, deltaTime);
+	BOOST_REQUIRE_CLOSE(time, currentTime, 0.0001);
+	BOOST_REQUIRE_CLOSE(deltaTime, currentTimeStep, 0.0001);
+	BOOST_REQUIRE_CLOSE(reader.getPreviousTime(), previousTime, 0.0001);
+
+	// Check the surface information
+	auto surface = reader.getSurface2D();
+	auto nInterstitial = reader.getNInterstitial2D();
+	auto previousIFlux = reader.getPreviousIFlux2D();
+	BOOST_REQUIRE_EQUAL(surface.size(), ny);
+	for (int j = 0; j < ny; j++) {
+		BOOST_REQUIRE_EQUAL(surface[j], iSurface[j]);
+		BOOST_REQUIRE_CLOSE(nInterstitial[j], nInter[j], 0.0001);
+		BOOST_REQUIRE_CLOSE(previousIFlux[j], previousFlux[j], 0.0001);
+	}
+
+	// Read only a part of the grid, the points are not contiguous in the file
+	int xs = 2, xm = 2, ys = 0, ym = 3;
+	std::vector<double> readArray;
+	std::vector<int> readSizes;
+	reader.readConcentrations(readArray, readSizes, xs, xm, ys, ym);
+
+	// Check the values
+	BOOST_REQUIRE_EQUAL(readSizes.size(), xm * ym);
+	int p = 0, l = 0;
+	for (int j = ys; j < ys + ym; j++) {
+		for (int i = xs; i < xs + xm; i++, p++) {
+			BOOST_REQUIRE_EQUAL(readSizes[p], concSizes[i + j * nx]);
+			for (int n = 0; n < readSizes[p]; n++, l++) {
+				BOOST_REQUIRE_CLOSE(readArray[2 * l], (double) n, 0.0001);
+				BOOST_REQUIRE_CLOSE(readArray[2 * l + 1],
+						100.0 * j + 10.0 * i + (double) n, 0.0001);
+			}
+		}
+	}
+	BOOST_REQUIRE_EQUAL(readArray.size(), 2 * l);
+}
+
+/**
+ * Method checking the reading of a 1D restart file with one dataset per grid
+ * point.
+ */
+BOOST_AUTO_TEST_CASE(checkRestartGridPoints) {
+	// Create the file with its header
+	int nx = 3;
+	auto file = HDF5Utils::initializeFile("restart.h5");
+	HDF5Utils::fillHeader(file, nx, 1.0);
+	HDF5Utils::finalizeFile(file);
+
+	// Write the concentrations of the second grid point only
+	int timeStep = 0;
+	file = HDF5Utils::openFile("restart.h5");
+	HDF5Utils::addConcentrationSubGroup(file, timeStep, 1.0, 0.5, 0.1);
+	HDF5Utils::writeSurface1D(file, timeStep, 1, 2.0, 3.0);
+	std::vector<std::vector<double> > concVector = { { 4.0, 1.0e-3 }, { 7.0,
+			2.0e-3 } };
+	HDF5Utils::addConcentrationDataset(file, concVector.size(), 1);
+	HDF5Utils::fillConcentrations(file, concVector, 1);
+	HDF5Utils::closeFile(file);
+
+	// Read it back
+	HDF5RestartReader reader("restart.h5");
+	BOOST_REQUIRE_EQUAL(reader.getSurface1D(), 1);
+	BOOST_REQUIRE_CLOSE(reader.getNInterstitial1D(), 2.0, 0.0001);
+	BOOST_REQUIRE_CLOSE(reader.getPreviousIFlux1D(), 3.0, 0.0001);
+	std::vector<double> readArray;
+	std::vector<int> readSizes;
+	reader.readConcentrations(readArray, readSizes, 0, nx);
+
+	// Check the values
+	BOOST_REQUIRE_EQUAL(readSizes.size(), nx);
+	BOOST_REQUIRE_EQUAL(readSizes[0], 0);
+	BOOST_REQUIRE_EQUAL(readSizes[1], concVector.size());
+	BOOST_REQUIRE_EQUAL(readSizes[2], 0);
+	for (unsigned int l = 0; l < concVector.size(); l++) {
+		BOOST_REQUIRE_CLOSE(readArray[2 * l], concVector[l][0], 0.0001);
+		BOOST_REQUIRE_CLOSE(readArray[2 * l + 1], concVector[l][1], 0.0001);
+	}
+
+	// Finalize MPI
+	MPI_Finalize();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
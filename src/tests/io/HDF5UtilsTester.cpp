@@ -9,6 +9,8 @@
 #include <XolotlConfig.h>
 #include <mpi.h>
 #include <memory>
+#include <cstdio>
+#include <unistd.h>
 
 using namespace std;
 using namespace xolotlCore;
@@ -45,7 +47,7 @@ BOOST_AUTO_TEST_CASE(checkIO) {
 	// Set the time step number
 	int timeStep = 0;
 	// Initialize the HDF5 file
-	HDF5Utils::initializeFile("test.h5");
+	auto file = HDF5Utils::initializeFile("test.h5");
 
 	// Set the number of grid points and step size
 	int nGrid = 5;
@@ -58,27 +60,27 @@ BOOST_AUTO_TEST_CASE(checkIO) {
 	int iSurface = 3;
 	double nInter = 1.0, previousFlux = 0.1;
 	// Write the header in the HDF5 file
-	HDF5Utils::fillHeader(nGrid, stepSize);
+	HDF5Utils::fillHeader(file, nGrid, stepSize);
 
 	// Write the network in the HDF5 file
-	HDF5Utils::fillNetwork(filename);
+	HDF5Utils::fillNetwork(file, filename);
 
 	// Finalize the HDF5 file
-	HDF5Utils::finalizeFile();
+	HDF5Utils::finalizeFile(file);
 
 	// Open it again to add the concentrations
-	HDF5Utils::openFile("test.h5");
+	file = HDF5Utils::openFile("test.h5");
 
 	// Add the concentration sub group
-	HDF5Utils::addConcentrationSubGroup(timeStep, currentTime, previousTime, currentTimeStep);
+	HDF5Utils::addConcentrationSubGroup(file, timeStep, currentTime, previousTime, currentTimeStep);
 
 	// Write the surface position
-	HDF5Utils::writeSurface1D(timeStep, iSurface, nInter, previousFlux);
+	HDF5Utils::writeSurface1D(file, timeStep, iSurface, nInter, previousFlux);
 
 	// Add the concentration dataset
 	int length = 5;
 	int gridPoint = 0;
-	HDF5Utils::addConcentrationDataset(length, gridPoint);
+	HDF5Utils::addConcentrationDataset(file, length, gridPoint);
 
 	// Create a vector of concentration for one grid point
 	std::vector< std::vector<double> > concVector;
@@ -94,10 +96,10 @@ BOOST_AUTO_TEST_CASE(checkIO) {
 	}
 
 	// Write the concentrations in the HDF5 file
-	HDF5Utils::fillConcentrations(concVector, gridPoint);
+	HDF5Utils::fillConcentrations(file, concVector, gridPoint);
 
 	// Close the HDF5 file
-	xolotlCore::HDF5Utils::closeFile();
+	xolotlCore::HDF5Utils::closeFile(file);
 
 	// Read the header of the written file
 	int nx = 0, ny = 0, nz = 0;
@@ -141,9 +143,9 @@ BOOST_AUTO_TEST_CASE(checkIO) {
 
 		// Check the composition
 		auto composition = reactant->getComposition();
-		BOOST_REQUIRE_EQUAL((int) line[0], composition["He"]);
-		BOOST_REQUIRE_EQUAL((int) line[1], composition["V"]);
-		BOOST_REQUIRE_EQUAL((int) line[2], composition["I"]);
+		BOOST_REQUIRE_EQUAL((int) line[0], composition[PSISpecies::He]);
+		BOOST_REQUIRE_EQUAL((int) line[1], composition[PSISpecies::V]);
+		BOOST_REQUIRE_EQUAL((int) line[2], composition[PSISpecies::I]);
 
 		// Check the formation energy
 		auto formationEnergy = reactant->getFormationEnergy();
@@ -180,7 +182,7 @@ BOOST_AUTO_TEST_CASE(checkIO) {
  */
 BOOST_AUTO_TEST_CASE(checkSurface2D) {
 	// Initialize the HDF5 file
-	HDF5Utils::initializeFile("test.h5");
+	auto file = HDF5Utils::initializeFile("test.h5");
 
 	// Set the number of grid points and step size
 	int nGrid = 5;
@@ -190,19 +192,19 @@ BOOST_AUTO_TEST_CASE(checkSurface2D) {
 	double previousTime = 0.00001;
 	double currentTimeStep = 0.000001;
 	// Write the header in the HDF5 file
-	HDF5Utils::fillHeader(nGrid, stepSize);
+	HDF5Utils::fillHeader(file, nGrid, stepSize);
 
 	// Finalize the HDF5 file
-	HDF5Utils::finalizeFile();
+	HDF5Utils::finalizeFile(file);
 
 	// Open it again to add the concentrations
-	HDF5Utils::openFile("test.h5");
+	file = HDF5Utils::openFile("test.h5");
 
 	// Set the time step number
 	int timeStep = 0;
 
 	// Add the concentration sub group
-	HDF5Utils::addConcentrationSubGroup(timeStep, currentTime, previousTime, currentTimeStep);
+	HDF5Utils::addConcentrationSubGroup(file, timeStep, currentTime, previousTime, currentTimeStep);
 
 	// Set the surface information in 2D
 	std::vector<int> iSurface = {2, 3, 2, 0, 5};
@@ -210,10 +212,10 @@ BOOST_AUTO_TEST_CASE(checkSurface2D) {
 	std::vector<double> previousFlux = {0.0, 0.1, 3.0, -1.0, 5.0};
 
 	// Write the surface position
-	HDF5Utils::writeSurface2D(timeStep, iSurface, nInter, previousFlux);
+	HDF5Utils::writeSurface2D(file, timeStep, iSurface, nInter, previousFlux);
 
 	// Close the HDF5 file
-	xolotlCore::HDF5Utils::closeFile();
+	xolotlCore::HDF5Utils::closeFile(file);
 
 	// Read the surface position
 	auto surfacePos = HDF5Utils::readSurface2D("test.h5", timeStep);
@@ -243,7 +245,7 @@ BOOST_AUTO_TEST_CASE(checkSurface2D) {
  */
 BOOST_AUTO_TEST_CASE(checkSurface3D) {
 	// Initialize the HDF5 file
-	HDF5Utils::initializeFile("test.h5");
+	auto file = HDF5Utils::initializeFile("test.h5");
 
 	// Set the number of grid points and step size
 	int nGrid = 5;
@@ -253,19 +255,19 @@ BOOST_AUTO_TEST_CASE(checkSurface3D) {
 	double previousTime = 0.00001;
 	double currentTimeStep = 0.000001;
 	// Write the header in the HDF5 file
-	HDF5Utils::fillHeader(nGrid, stepSize);
+	HDF5Utils::fillHeader(file, nGrid, stepSize);
 
 	// Finalize the HDF5 file
-	HDF5Utils::finalizeFile();
+	HDF5Utils::finalizeFile(file);
 
 	// Open it again to add the concentrations
-	HDF5Utils::openFile("test.h5");
+	file = HDF5Utils::openFile("test.h5");
 
 	// Set the time step number
 	int timeStep = 0;
 
 	// Add the concentration sub group
-	HDF5Utils::addConcentrationSubGroup(timeStep, currentTime, previousTime, currentTimeStep);
+	HDF5Utils::addConcentrationSubGroup(file, timeStep, currentTime, previousTime, currentTimeStep);
 
 	// Set the surface information in 2D
 	std::vector< std::vector<int> > iSurface = {{2, 4, 1, 0, 5}, {2, 3, 2, 0, 5}, {6, 1, 2, 3, 2}};
@@ -275,10 +277,10 @@ BOOST_AUTO_TEST_CASE(checkSurface3D) {
 			{-2.0, 3.0, 2.0, 0.0, -0.5}, {0.0, 0.0, 0.0, 0.0, 0.0}};
 
 	// Write the surface position
-	HDF5Utils::writeSurface3D(timeStep, iSurface, nInter, previousFlux);
+	HDF5Utils::writeSurface3D(file, timeStep, iSurface, nInter, previousFlux);
 
 	// Close the HDF5 file
-	xolotlCore::HDF5Utils::closeFile();
+	xolotlCore::HDF5Utils::closeFile(file);
 
 	// Read the surface position
 	auto surfacePos = HDF5Utils::readSurface3D("test.h5", timeStep);
@@ -304,4 +306,129 @@ BOOST_AUTO_TEST_CASE(checkSurface3D) {
 	}
 }
 
+/**
+ * Method checking the writing of the concentrations of a 2D grid in a single
+ * dataset and the reading of each grid point.
+ */
+BOOST_AUTO_TEST_CASE(checkConcentrations2D) {
+	// Initialize the HDF5 file
+	auto file = HDF5Utils::initializeFile("test.h5");
+
+	// Set the number of grid points and step size
+	int nx = 3, ny = 2;
+	double stepSize = 0.5;
+	// Write the header in the HDF5 file
+	HDF5Utils::fillHeader(file, nx, stepSize, ny, stepSize);
+
+	// Finalize the HDF5 file
+	HDF5Utils::finalizeFile(file);
+
+	// Open it again to add the concentrations
+	file = HDF5Utils::openFile("test.h5");
+
+	// Add the concentration sub group
+	int timeStep = 0;
+	HDF5Utils::addConcentrationSubGroup(file, timeStep, 0.0001, 0.00001, 0.000001);
+
+	// Give a different number of concentrations to each grid point, the
+	// second one doesn't have any
+	std::vector<double> concArray;
+	std::vector<int> concSizes;
+	for (int n = 0; n < nx * ny; n++) {
+		int size = (n == 1) ? 0 : n + 1;
+		for (int l = 0; l < size; l++) {
+			concArray.push_back((double) (2 * l));
+			concArray.push_back(1.0e-3 * (n + 1) + (double) l);
+		}
+		concSizes.push_back(size);
+	}
+
+	// Write all the grid points at once
+	HDF5Utils::writeConcentrations(file, concArray, concSizes, nx, 0, nx, ny, 0,
+			ny);
+
+	// Close the HDF5 file
+	xolotlCore::HDF5Utils::closeFile(file);
+
+	// The indices are stored as 32 bits integers
+	hid_t fileId = H5Fopen("test.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+	hid_t datasetId = H5Dopen(fileId,
+			"concentrationsGroup/concentration_0/concIndices", H5P_DEFAULT);
+	hid_t typeId = H5Dget_type(datasetId);
+	BOOST_REQUIRE_EQUAL(H5Tget_class(typeId), H5T_INTEGER);
+	BOOST_REQUIRE_EQUAL(H5Tget_size(typeId), 4);
+	H5Tclose(typeId);
+	H5Dclose(datasetId);
+	H5Fclose(fileId);
+
+	// Read each grid point back
+	for (int j = 0; j < ny; j++) {
+		for (int i = 0; i < nx; i++) {
+			int n = i + j * nx;
+			auto returnedVector = HDF5Utils::readGridPoint("test.h5", timeStep,
+					i, j);
+
+			// Check the size of the vector
+			BOOST_REQUIRE_EQUAL(returnedVector.size(), concSizes[n]);
+			// Check the values
+			for (unsigned int l = 0; l < returnedVector.size(); l++) {
+				BOOST_REQUIRE_CLOSE(returnedVector[l][0], (double) (2 * l),
+						0.0001);
+				BOOST_REQUIRE_CLOSE(returnedVector[l][1],
+						1.0e-3 * (n + 1) + (double) l, 0.0001);
+			}
+		}
+	}
+}
+
+/**
+ * Method checking that the network group links to the absolute path of the
+ * network file even when it is given with a relative name.
+ */
+BOOST_AUTO_TEST_CASE(checkNetworkLink) {
+	// Create a network file in the current directory
+	string sourceDir(XolotlSourceDirectory);
+	string filename = sourceDir + "/tests/testfiles/tungsten_diminutive.h5";
+	auto file = HDF5Utils::initializeFile("networkLink.h5");
+	HDF5Utils::fillHeader(file, 5, 0.5);
+	HDF5Utils::fillNetwork(file, filename);
+	HDF5Utils::finalizeFile(file);
+
+	// Link to it with a relative name
+	file = HDF5Utils::initializeFile("linkToLink.h5");
+	HDF5Utils::fillHeader(file, 5, 0.5);
+	HDF5Utils::fillNetwork(file, "networkLink.h5");
+	HDF5Utils::finalizeFile(file);
+
+	// Read the target of the link
+	hid_t fileId = H5Fopen("linkToLink.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+	H5L_info_t info;
+	H5Lget_info(fileId, "networkGroup", &info, H5P_DEFAULT);
+	BOOST_REQUIRE_EQUAL(info.type, H5L_TYPE_EXTERNAL);
+	std::vector<char> value(info.u.val_size);
+	H5Lget_val(fileId, "networkGroup", value.data(), value.size(),
+			H5P_DEFAULT);
+	const char * targetFile = nullptr;
+	const char * targetObject = nullptr;
+	H5Lunpack_elink_val(value.data(), value.size(), NULL, &targetFile,
+			&targetObject);
+	string target(targetFile);
+	H5Fclose(fileId);
+
+	// It is the absolute path of the file
+	char cwd[4096];
+	BOOST_REQUIRE(getcwd(cwd, sizeof(cwd)));
+	char * realCwd = realpath(cwd, nullptr);
+	BOOST_REQUIRE_EQUAL(target, string(realCwd) + "/networkLink.h5");
+	free(realCwd);
+
+	// The network is still read through both links
+	auto networkVector = HDF5Utils::readNetwork("linkToLink.h5");
+	BOOST_REQUIRE(!networkVector.empty());
+
+	// Remove the created files
+	std::remove("linkToLink.h5");
+	std::remove("networkLink.h5");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,73 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/included/unit_test.hpp>
+#include <TelemetrySink.h>
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace xolotlCore;
+
+/**
+ * This suite is responsible for testing the TelemetrySink
+ */
+BOOST_AUTO_TEST_SUITE(TelemetrySink_testSuite)
+
+/**
+ * Method checking the writing of the tables and their conversion to text.
+ */
+BOOST_AUTO_TEST_CASE(checkTables) {
+	{
+		// Write a table every two rows
+		TelemetrySink sink("telemetry.h5", 2);
+		sink.addTable("retention", { "time", "retention" });
+		sink.addTable("profile", { "timestep", "depth", "value" });
+
+		// The tables and rows are checked
+		BOOST_REQUIRE_THROW(sink.addTable("retention", { "time" }),
+				std::string);
+		BOOST_REQUIRE_THROW(sink.append("unknown", { 1.0 }), std::string);
+		BOOST_REQUIRE_THROW(sink.append("retention", { 1.0 }), std::string);
+
+		// Five rows are not a multiple of the stride
+		for (int n = 0; n < 5; n++) {
+			sink.append("retention", { 0.5 * n, 10.0 * n });
+		}
+		sink.append("profile", { 3.0, 0.25, 1.0e-3 });
+
+		// Three rows are written, the other ones when the sink is destroyed
+		std::stringstream text;
+		sink.flush();
+		TelemetrySink::writeText("telemetry.h5", "retention", text);
+		std::string line;
+		int nLines = 0;
+		while (std::getline(text, line))
+			nLines++;
+		BOOST_REQUIRE_EQUAL(nLines, 6);
+	}
+
+	// The tables are in their creation order
+	auto tables = TelemetrySink::getTables("telemetry.h5");
+	BOOST_REQUIRE_EQUAL(tables.size(), 2);
+	BOOST_REQUIRE_EQUAL(tables[0], "retention");
+	BOOST_REQUIRE_EQUAL(tables[1], "profile");
+
+	// Check the text
+	std::stringstream retention;
+	TelemetrySink::writeText("telemetry.h5", "retention", retention);
+	BOOST_REQUIRE_EQUAL(retention.str(),
+			"# time retention\n0 0\n0.5 10\n1 20\n1.5 30\n2 40\n");
+	std::stringstream profile;
+	TelemetrySink::writeText("telemetry.h5", "profile", profile);
+	BOOST_REQUIRE_EQUAL(profile.str(),
+			"# timestep depth value\n3 0.25 0.001\n");
+
+	// A missing table
+	std::stringstream missing;
+	BOOST_REQUIRE_THROW(
+			TelemetrySink::writeText("telemetry.h5", "unknown", missing),
+			std::string);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -7,11 +7,71 @@
 #include <XolotlConfig.h>
 #include <DummyHandlerRegistry.h>
 #include <DummyAdvectionHandler.h>
+#include <YGBAdvectionHandler.h>
 #include <mpi.h>
+#include <set>
 
 using namespace std;
 using namespace xolotlCore;
 
+/**
+ * Check that two trap-mutation handlers give the same trap-mutation and
+ * partial derivatives at every grid point of a row in the depth direction.
+ *
+ * @param network The network
+ * @param movingHandler The handler whose surface was moved
+ * @param freshHandler The handler initialized at the same surface position
+ * @param nx The number of grid points in the depth direction
+ * @param yj The index of the row in the Y direction
+ */
+static void checkSameTrapMutation(IReactionNetwork *network,
+		ITrapMutationHandler &movingHandler,
+		ITrapMutationHandler &freshHandler, int nx, int yj) {
+	const int dof = network->getDOF();
+	const int nHelium = network->getAll(heType).size();
+
+	// The same concentrations are used everywhere
+	std::vector<double> concentration(dof);
+	for (int i = 0; i < dof; i++) {
+		concentration[i] = (double) i * i;
+	}
+	network->updateConcentrationsFromArray(concentration.data());
+
+	for (int xi = 0; xi < nx; xi++) {
+		// Compare the trap-mutation
+		std::vector<double> movingConc(dof, 0.0), freshConc(dof, 0.0);
+		movingHandler.computeTrapMutation(network, concentration.data(),
+				movingConc.data(), xi, yj);
+		freshHandler.computeTrapMutation(network, concentration.data(),
+				freshConc.data(), xi, yj);
+		for (int i = 0; i < dof; i++) {
+			BOOST_REQUIRE_EQUAL(movingConc[i], freshConc[i]);
+		}
+
+		// Compare the partial derivatives
+		std::vector<int> movingIndices(3 * nHelium), freshIndices(3 * nHelium);
+		std::vector<double> movingVal(3 * nHelium), freshVal(3 * nHelium);
+		int nMoving = movingHandler.computePartialsForTrapMutation(network,
+				movingVal.data(), movingIndices.data(), xi, yj);
+		int nFresh = freshHandler.computePartialsForTrapMutation(network,
+				freshVal.data(), freshIndices.data(), xi, yj);
+		BOOST_REQUIRE_EQUAL(nMoving, nFresh);
+		for (int i = 0; i < 3 * nMoving; i++) {
+			BOOST_REQUIRE_EQUAL(movingIndices[i], freshIndices[i]);
+			BOOST_REQUIRE_EQUAL(movingVal[i], freshVal[i]);
+		}
+
+		// Each bubble is only created once at a grid point
+		std::set<int> bubbleIndices;
+		for (int i = 0; i < nMoving; i++) {
+			bubbleIndices.insert(movingIndices[i * 3 + 1]);
+		}
+		BOOST_REQUIRE_EQUAL(bubbleIndices.size(), nMoving);
+	}
+
+	return;
+}
+
 /**
  * This suite is responsible for testing the W100TrapMutationHandler.
  */
@@ -176,6 +236,149 @@ BOOST_AUTO_TEST_CASE(checkModifiedTrapMutation) {
 	BOOST_REQUIRE_CLOSE(val[4], 2.14016e+13, 0.01);
 	BOOST_REQUIRE_CLOSE(val[5], 2.14016e+13, 0.01);
 
+	return;
+}
+
+/**
+ * Method checking that moving the surface gives the same modified
+ * trap-mutation as initializing the handler at the new position.
+ */
+BOOST_AUTO_TEST_CASE(checkSurfaceMove) {
+	// Create the network loader
+	HDF5NetworkLoader loader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Define the filename to load the network from
+	string sourceDir(XolotlSourceDirectory);
+	string pathToFile("/tests/testfiles/tungsten.h5");
+	string filename = sourceDir + pathToFile;
+	// Give the filename to the network loader
+	loader.setFilename(filename);
+
+	// Load the network
+	auto network = loader.load().get();
+	// Get all the reactants
+	auto allReactants = network->getAll();
+	// Get its size
+	const int size = network->size();
+	// Initialize the rate constants
+	for (int i = 0; i < size; i++) {
+		allReactants->at(i)->setTemperature(1000.0);
+	}
+	for (int i = 0; i < size; i++) {
+		auto cluster = (xolotlCore::PSICluster *) allReactants->at(i);
+		cluster->computeRateConstants();
+	}
+
+	// Suppose we have a grid with 13 grip points and distance of
+	// 0.1 nm between grid points
+	std::vector<double> grid;
+	for (int l = 0; l < 13; l++) {
+		grid.push_back((double) l * 0.1);
+	}
+
+	// Create the advection handlers needed to initialize the trap mutation handler
+	std::vector<xolotlCore::IAdvectionHandler *> advectionHandlers;
+	advectionHandlers.push_back(new DummyAdvectionHandler());
+
+	// Create the handler that will follow the surface
+	W100TrapMutationHandler movingHandler;
+	movingHandler.initialize(network, grid);
+	movingHandler.initializeIndex1D(0, network, advectionHandlers, grid);
+
+	// Move the surface forward and back, to new and already visited positions
+	std::vector<int> positions = { 2, 1, 0, 3, 2 };
+	for (int surfacePos : positions) {
+		movingHandler.setSurfacePosition(surfacePos);
+
+		// Create a handler directly initialized at this position
+		W100TrapMutationHandler freshHandler;
+		freshHandler.initialize(network, grid);
+		freshHandler.initializeIndex1D(surfacePos, network, advectionHandlers,
+				grid);
+
+		checkSameTrapMutation(network, movingHandler, freshHandler,
+				grid.size(), 0);
+	}
+
+	return;
+}
+
+/**
+ * Method checking that moving the surface in 2D with a grain boundary gives
+ * the same modified trap-mutation as initializing the handler at the new
+ * positions, the bubbles from both the depth and the grain boundary being
+ * created only once.
+ */
+BOOST_AUTO_TEST_CASE(checkSurfaceMoveGB) {
+	// Create the network loader
+	HDF5NetworkLoader loader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Define the filename to load the network from
+	string sourceDir(XolotlSourceDirectory);
+	string pathToFile("/tests/testfiles/tungsten.h5");
+	string filename = sourceDir + pathToFile;
+	// Give the filename to the network loader
+	loader.setFilename(filename);
+
+	// Load the network
+	auto network = loader.load().get();
+	// Get all the reactants
+	auto allReactants = network->getAll();
+	// Get its size
+	const int size = network->size();
+	// Initialize the rate constants
+	for (int i = 0; i < size; i++) {
+		allReactants->at(i)->setTemperature(1000.0);
+	}
+	for (int i = 0; i < size; i++) {
+		auto cluster = (xolotlCore::PSICluster *) allReactants->at(i);
+		cluster->computeRateConstants();
+	}
+
+	// Suppose we have a grid with 13 grip points and distance of
+	// 0.1 nm between grid points, and 5 grid points in the Y direction
+	std::vector<double> grid;
+	for (int l = 0; l < 13; l++) {
+		grid.push_back((double) l * 0.1);
+	}
+	const int ny = 5;
+	const double hy = 0.5;
+
+	// Create the advection handlers with a grain boundary in the Y direction,
+	// the second and fourth rows are at a trap-mutation distance from it
+	std::vector<xolotlCore::IAdvectionHandler *> advectionHandlers;
+	advectionHandlers.push_back(new DummyAdvectionHandler());
+	auto advecHandler = new YGBAdvectionHandler();
+	advecHandler->setLocation(1.0);
+	advecHandler->setDimension(2);
+	advectionHandlers.push_back(advecHandler);
+
+	// Create the handler that will follow the surface
+	W100TrapMutationHandler movingHandler;
+	movingHandler.initialize(network, grid, ny, hy);
+	movingHandler.initializeIndex2D(std::vector<int>(ny, 0), network,
+			advectionHandlers, grid, ny, hy);
+
+	// Move the surface forward and back, differently on each row
+	std::vector<std::vector<int> > positions = { { 0, 2, 0, 3, 0 }, { 0, 0,
+			0, 0, 0 }, { 1, 1, 2, 1, 1 } };
+	for (auto surfacePos : positions) {
+		for (int j = 0; j < ny; j++) {
+			movingHandler.setSurfacePosition(surfacePos[j], j);
+		}
+
+		// Create a handler directly initialized at these positions
+		W100TrapMutationHandler freshHandler;
+		freshHandler.initialize(network, grid, ny, hy);
+		freshHandler.initializeIndex2D(surfacePos, network, advectionHandlers,
+				grid, ny, hy);
+
+		for (int j = 0; j < ny; j++) {
+			checkSameTrapMutation(network, movingHandler, freshHandler,
+					grid.size(), j);
+		}
+	}
+
 	// Finalize MPI
 	MPI_Finalize();
 
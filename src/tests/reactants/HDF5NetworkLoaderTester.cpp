@@ -65,9 +65,9 @@ BOOST_AUTO_TEST_CASE(checkLoad) {
 	auto reactant = (PSICluster *) reactants->at(0);
 	// Check the composition
 	auto composition = reactant->getComposition();
-	BOOST_REQUIRE_EQUAL(composition["He"], 1);
-	BOOST_REQUIRE_EQUAL(composition["V"], 0);
-	BOOST_REQUIRE_EQUAL(composition["I"], 0);
+	BOOST_REQUIRE_EQUAL(composition[PSISpecies::He], 1);
+	BOOST_REQUIRE_EQUAL(composition[PSISpecies::V], 0);
+	BOOST_REQUIRE_EQUAL(composition[PSISpecies::I], 0);
 	// Check the formation energy
 	auto formationEnergy = reactant->getFormationEnergy();
 	BOOST_REQUIRE_EQUAL(formationEnergy, 6.15);
@@ -82,9 +82,9 @@ BOOST_AUTO_TEST_CASE(checkLoad) {
 	reactant = (PSICluster *) reactants->at(8);
 	// Check the composition
 	composition = reactant->getComposition();
-	BOOST_REQUIRE_EQUAL(composition["He"], 0);
-	BOOST_REQUIRE_EQUAL(composition["V"], 1);
-	BOOST_REQUIRE_EQUAL(composition["I"], 0);
+	BOOST_REQUIRE_EQUAL(composition[PSISpecies::He], 0);
+	BOOST_REQUIRE_EQUAL(composition[PSISpecies::V], 1);
+	BOOST_REQUIRE_EQUAL(composition[PSISpecies::I], 0);
 	// Check the formation energy
 	formationEnergy = reactant->getFormationEnergy();
 	BOOST_REQUIRE_EQUAL(formationEnergy, 3.6);
@@ -36,9 +36,9 @@ BOOST_AUTO_TEST_CASE(getSpeciesSize) {
 	auto composition = cluster.getComposition();
 
 	// Check the composition is the created one
-	BOOST_REQUIRE_EQUAL(composition["He"], 4);
-	BOOST_REQUIRE_EQUAL(composition["V"], 0);
-	BOOST_REQUIRE_EQUAL(composition["I"], 2);
+	BOOST_REQUIRE_EQUAL(composition[PSISpecies::He], 4);
+	BOOST_REQUIRE_EQUAL(composition[PSISpecies::V], 0);
+	BOOST_REQUIRE_EQUAL(composition[PSISpecies::I], 2);
 
 	// Check if it is a mixed cluster
 	BOOST_REQUIRE_EQUAL(cluster.isMixed(), true);
@@ -65,8 +65,8 @@ BOOST_AUTO_TEST_CASE(checkConnectivity) {
 	BOOST_REQUIRE_EQUAL("HeI", reactant->getType());
 	auto reactionConnectivity = reactant->getConnectivity();
 
-	BOOST_REQUIRE_EQUAL(reactant->getComposition().at("He"), 5);
-	BOOST_REQUIRE_EQUAL(reactant->getComposition().at("I"), 3);
+	BOOST_REQUIRE_EQUAL(reactant->getComposition()[PSISpecies::He], 5);
+	BOOST_REQUIRE_EQUAL(reactant->getComposition()[PSISpecies::I], 3);
 
 	// Check the connectivity for He, V, and I
 	int connectivityExpected[] = {
@@ -32,9 +32,9 @@ BOOST_AUTO_TEST_CASE(getSpeciesSize) {
 	auto composition = cluster.getComposition();
 
 	// Check the composition is the created one
-	BOOST_REQUIRE_EQUAL(composition["He"], 4);
-	BOOST_REQUIRE_EQUAL(composition["V"], 5);
-	BOOST_REQUIRE_EQUAL(composition["I"], 0);
+	BOOST_REQUIRE_EQUAL(composition[PSISpecies::He], 4);
+	BOOST_REQUIRE_EQUAL(composition[PSISpecies::V], 5);
+	BOOST_REQUIRE_EQUAL(composition[PSISpecies::I], 0);
 
 	// Check if it is a mixed cluster
 	BOOST_REQUIRE_EQUAL(cluster.isMixed(), true);
@@ -62,8 +62,8 @@ BOOST_AUTO_TEST_CASE(checkConnectivity) {
 	BOOST_REQUIRE_EQUAL("HeV", reactant->getType());
 	auto reactionConnectivity = reactant->getConnectivity();
 
-	BOOST_REQUIRE_EQUAL(reactant->getComposition().at("He"), 3);
-	BOOST_REQUIRE_EQUAL(reactant->getComposition().at("V"), 2);
+	BOOST_REQUIRE_EQUAL(reactant->getComposition()[PSISpecies::He], 3);
+	BOOST_REQUIRE_EQUAL(reactant->getComposition()[PSISpecies::V], 2);
 
 	// Check the connectivity for He, V, and I
 	int connectivityExpected[] = {
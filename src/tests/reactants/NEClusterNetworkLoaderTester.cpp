@@ -65,9 +65,9 @@ BOOST_AUTO_TEST_CASE(checkLoad) {
 	auto reactant = (NECluster *) reactants->at(0);
 	// Check the composition
 	auto composition = reactant->getComposition();
-	BOOST_REQUIRE_EQUAL(composition["Xe"], 1);
-	BOOST_REQUIRE_EQUAL(composition["V"], 0);
-	BOOST_REQUIRE_EQUAL(composition["I"], 0);
+	BOOST_REQUIRE_EQUAL(composition[NESpecies::Xe], 1);
+	BOOST_REQUIRE_EQUAL(composition[NESpecies::V], 0);
+	BOOST_REQUIRE_EQUAL(composition[NESpecies::I], 0);
 	// Check the formation energy
 	auto formationEnergy = reactant->getFormationEnergy();
 	BOOST_REQUIRE_EQUAL(formationEnergy, 7.0);
@@ -82,9 +82,9 @@ BOOST_AUTO_TEST_CASE(checkLoad) {
 	reactant = (NECluster *) reactants->at(2);
 	// Check the composition
 	composition = reactant->getComposition();
-	BOOST_REQUIRE_EQUAL(composition["Xe"], 3);
-	BOOST_REQUIRE_EQUAL(composition["V"], 0);
-	BOOST_REQUIRE_EQUAL(composition["I"], 0);
+	BOOST_REQUIRE_EQUAL(composition[NESpecies::Xe], 3);
+	BOOST_REQUIRE_EQUAL(composition[NESpecies::V], 0);
+	BOOST_REQUIRE_EQUAL(composition[NESpecies::I], 0);
 	// Check the formation energy
 	formationEnergy = reactant->getFormationEnergy();
 	BOOST_REQUIRE_EQUAL(formationEnergy, 17.15);
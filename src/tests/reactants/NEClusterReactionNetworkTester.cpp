@@ -3,9 +3,13 @@
 
 #include <boost/test/included/unit_test.hpp>
 #include <NECluster.h>
+#include <NESuperCluster.h>
+#include <NEClusterNetworkLoader.h>
 #include "SimpleReactionNetwork.h"
 #include <XeCluster.h>
+#include <XolotlConfig.h>
 #include <xolotlPerf.h>
+#include <mpi.h>
 
 using namespace std;
 using namespace xolotlCore;
@@ -255,4 +259,111 @@ BOOST_AUTO_TEST_CASE(checkRefCounts) {
 	return;
 }
 
+/**
+ * This operation checks that the fluxes and partial derivatives computed by
+ * each cluster from its state, super clusters included, are the same as the
+ * ones computed by the stateless computeFluxes() and computePartials().
+ */
+BOOST_AUTO_TEST_CASE(checkFluxes) {
+	// Initialize MPI for HDF5
+	int argc = 0;
+	char **argv;
+	MPI_Init(&argc, &argv);
+
+	// Create the network loader
+	NEClusterNetworkLoader loader = NEClusterNetworkLoader(registry);
+	// Define the filename to load the network from
+	string sourceDir(XolotlSourceDirectory);
+	string pathToFile("/tests/testfiles/fuel_diminutive.h5");
+	string filename = sourceDir + pathToFile;
+	// Give the filename to the network loader
+	loader.setFilename(filename);
+	// Set grouping parameters
+	loader.setXeMin(2);
+	loader.setWidth(2);
+
+	// Load the network
+	auto network = loader.load();
+
+	// Set the temperature in the network
+	int networkSize = network->size();
+	auto allReactants = network->getAll();
+	double temperature = 1000.0;
+	for (int i = 0; i < networkSize; i++) {
+		allReactants->at(i)->setTemperature(temperature);
+	}
+	for (int i = 0; i < networkSize; i++) {
+		allReactants->at(i)->computeRateConstants();
+	}
+	// Redefine the connectivities and the rate slots
+	network->reinitializeConnectivities();
+
+	// Set different concentrations for all the degrees of freedom
+	int dof = network->getDOF();
+	std::vector<double> concentrations(dof, 0.0);
+	for (int i = 0; i < dof; i++) {
+		concentrations[i] = 0.01 * (double) (i + 1);
+	}
+	network->updateConcentrationsFromArray(concentrations.data());
+
+	// Compute the fluxes and partial derivatives cluster by cluster, the
+	// partial derivatives of the momentums are only kept until the next
+	// super cluster computes its own
+	BOOST_REQUIRE(!network->getAll(NESuperType).empty());
+	std::vector<double> knownFluxes(dof, 0.0);
+	std::vector<std::vector<double> > knownPartials(dof);
+	for (int i = 0; i < networkSize; i++) {
+		auto cluster = allReactants->at(i);
+		knownFluxes[cluster->getId() - 1] += cluster->getTotalFlux();
+		knownPartials[cluster->getId() - 1] = cluster->getPartialDerivatives();
+		if (cluster->getType() != NESuperType)
+			continue;
+		auto superCluster = (NESuperCluster *) cluster;
+		knownFluxes[superCluster->getXeMomentumId() - 1] +=
+				superCluster->getMomentumFlux();
+		std::vector<double> momentumPartials(dof, 0.0);
+		superCluster->getMomentPartialDerivatives(momentumPartials);
+		knownPartials[superCluster->getXeMomentumId() - 1] = momentumPartials;
+	}
+
+	// Compute them from the concentrations and a rate table only
+	RateTable rates;
+	network->computeRateTable(temperature, rates);
+	std::vector<double> fluxes(dof, 0.0);
+	network->computeFluxes(concentrations.data(), fluxes.data(), rates);
+	for (int i = 0; i < dof; i++) {
+		if (knownFluxes[i] == 0.0)
+			BOOST_REQUIRE_SMALL(fluxes[i], 1.0e-10);
+		else
+			BOOST_REQUIRE_CLOSE(fluxes[i], knownFluxes[i], 1.0e-8);
+	}
+
+	// The partial derivatives of each cluster are the rows of the stateless
+	// ones
+	SparseFillMap dfill;
+	network->getDiagonalFill(dfill);
+	auto rowPointers = network->getPartialsRowPointers();
+	auto columnIds = network->getPartialsColumnIds();
+	std::vector<double> partials(rowPointers[dof], 0.0);
+	network->computePartials(concentrations.data(), partials.data(), rates);
+	for (int i = 0; i < dof; i++) {
+		for (int j = rowPointers[i]; j < rowPointers[i + 1]; j++) {
+			double knownPartial = knownPartials[i][columnIds[j]];
+			if (knownPartial == 0.0)
+				BOOST_REQUIRE_SMALL(partials[j], 1.0e-10);
+			else
+				BOOST_REQUIRE_CLOSE(partials[j], knownPartial, 1.0e-8);
+		}
+	}
+
+	// The fluxes computed from the state of the network are the same
+	std::vector<double> stateFluxes(dof, 0.0);
+	network->computeAllFluxes(stateFluxes.data());
+	for (int i = 0; i < dof; i++) {
+		BOOST_REQUIRE_EQUAL(stateFluxes[i], fluxes[i]);
+	}
+
+	return;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
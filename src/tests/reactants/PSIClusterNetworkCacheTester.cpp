@@ -0,0 +1,199 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/included/unit_test.hpp>
+#include <PSIClusterNetworkCache.h>
+#include <PSIClusterReactionNetwork.h>
+#include <PSISuperCluster.h>
+#include <HDF5NetworkLoader.h>
+#include <HDF5Utils.h>
+#include <DummyHandlerRegistry.h>
+#include <XolotlConfig.h>
+#include <mpi.h>
+#include <memory>
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+#include <dirent.h>
+
+using namespace std;
+using namespace xolotlCore;
+
+/**
+ * Load the grouped tungsten network, compute its rate constants at the
+ * given temperature and return its fluxes for fixed concentrations.
+ *
+ * @param cacheName The name of the cache file, empty for no cache
+ * @param temperature The temperature
+ * @param dof The number of degrees of freedom of the network
+ * @return The fluxes
+ */
+vector<double> computeFluxes(const string& cacheName, double temperature,
+		int & dof) {
+	// Create the network loader
+	HDF5NetworkLoader loader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Define the filename to load the network from
+	string sourceDir(XolotlSourceDirectory);
+	string pathToFile("/tests/testfiles/tungsten.h5");
+	string filename = sourceDir + pathToFile;
+	// Give the filename to the network loader
+	loader.setFilename(filename);
+	// Set grouping parameters
+	loader.setVMin(28);
+	loader.setHeWidth(4);
+	loader.setVWidth(2);
+	// And the cache
+	loader.setCacheFilename(cacheName);
+
+	// Load the network
+	auto network = loader.load();
+
+	// Set the temperature in the network
+	int networkSize = network->size();
+	auto allReactants = network->getAll();
+	for (int i = 0; i < networkSize; i++) {
+		allReactants->at(i)->setTemperature(temperature);
+	}
+	for (int i = 0; i < networkSize; i++) {
+		allReactants->at(i)->computeRateConstants();
+	}
+	// Redefine the connectivities and the reaction tables
+	network->reinitializeConnectivities();
+
+	// Set different concentrations for all the degrees of freedom
+	dof = network->getDOF();
+	vector<double> concentrations(dof, 0.0);
+	for (int i = 0; i < dof; i++) {
+		concentrations[i] = 0.001 * (double) (i % 17 + 1);
+	}
+	network->updateConcentrationsFromArray(concentrations.data());
+
+	// Compute the fluxes
+	vector<double> fluxes(dof, 0.0);
+	network->computeAllFluxes(fluxes.data());
+
+	return fluxes;
+}
+
+/**
+ * This suite is responsible for testing the PSIClusterNetworkCache.
+ */
+/**
+ * The cache written by the tests. Its name is unique to this process so that
+ * concurrent runs of the test don't share it, and it is removed at exit.
+ */
+struct TestCache {
+	std::string name = "networkCache_" + std::to_string(getpid()) + ".h5";
+
+	~TestCache() {
+		std::remove(name.c_str());
+	}
+} testCache;
+
+/**
+ * Count the files of the current directory whose name starts with the given
+ * prefix.
+ *
+ * @param prefix The prefix
+ * @return The number of files
+ */
+int countFiles(const std::string& prefix) {
+	int count = 0;
+	DIR * dir = opendir(".");
+	if (!dir)
+		return 0;
+	while (auto entry = readdir(dir)) {
+		if (std::string(entry->d_name).compare(0, prefix.size(), prefix) == 0)
+			count++;
+	}
+	closedir(dir);
+
+	return count;
+}
+
+BOOST_AUTO_TEST_SUITE(PSIClusterNetworkCache_testSuite)
+
+/**
+ * Method checking that the network read from the cache gives the same
+ * fluxes as the one built from the network file.
+ */
+BOOST_AUTO_TEST_CASE(checkCachedNetwork) {
+	// Initialize MPI for HDF5
+	int argc = 0;
+	char **argv;
+	MPI_Init(&argc, &argv);
+
+	// Start without cache
+	string cacheName = testCache.name;
+	std::remove(cacheName.c_str());
+
+	// The reference fluxes
+	int dof = 0;
+	auto knownFluxes = computeFluxes("", 1000.0, dof);
+	BOOST_REQUIRE_EQUAL(dof, 1929);
+
+	// The first run writes the cache
+	auto fluxes = computeFluxes(cacheName, 1000.0, dof);
+	BOOST_REQUIRE_EQUAL(dof, 1929);
+	BOOST_REQUIRE(std::ifstream(cacheName).good());
+	// No temporary file is left
+	BOOST_REQUIRE_EQUAL(countFiles(cacheName), 1);
+	for (int i = 0; i < dof; i++) {
+		BOOST_REQUIRE_EQUAL(fluxes[i], knownFluxes[i]);
+	}
+
+	// The second one reads it
+	fluxes = computeFluxes(cacheName, 1000.0, dof);
+	BOOST_REQUIRE_EQUAL(dof, 1929);
+	for (int i = 0; i < dof; i++) {
+		BOOST_REQUIRE_EQUAL(fluxes[i], knownFluxes[i]);
+	}
+
+	// At another temperature the optimized reactions are built again
+	knownFluxes = computeFluxes("", 600.0, dof);
+	fluxes = computeFluxes(cacheName, 600.0, dof);
+	BOOST_REQUIRE_EQUAL(dof, 1929);
+	for (int i = 0; i < dof; i++) {
+		BOOST_REQUIRE_EQUAL(fluxes[i], knownFluxes[i]);
+	}
+
+	return;
+}
+
+/**
+ * Method checking that the cache is only used with the same network and
+ * grouping parameters.
+ */
+BOOST_AUTO_TEST_CASE(checkKey) {
+	// The network file
+	string sourceDir(XolotlSourceDirectory);
+	string filename = sourceDir + "/tests/testfiles/tungsten.h5";
+	auto networkVector = HDF5Utils::readNetwork(filename);
+
+	// The file written by the previous test case
+	string cacheName = testCache.name;
+	PSIClusterNetworkCache sameCache(cacheName, networkVector, 28, 4, 2);
+	BOOST_REQUIRE(sameCache.isValid());
+
+	// Other grouping parameters
+	PSIClusterNetworkCache otherGrouping(cacheName, networkVector, 28, 2, 2);
+	BOOST_REQUIRE(!otherGrouping.isValid());
+
+	// Another network
+	networkVector[0][3] += 1.0;
+	PSIClusterNetworkCache otherNetwork(cacheName, networkVector, 28, 4, 2);
+	BOOST_REQUIRE(!otherNetwork.isValid());
+
+	// No file
+	std::remove(cacheName.c_str());
+	PSIClusterNetworkCache noFile(cacheName, networkVector, 28, 4, 2);
+	BOOST_REQUIRE(!noFile.isValid());
+
+	// Finalize MPI
+	MPI_Finalize();
+
+	return;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
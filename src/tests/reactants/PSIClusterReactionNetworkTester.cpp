@@ -9,6 +9,9 @@
 #include <VCluster.h>
 #include <InterstitialCluster.h>
 #include <HeInterstitialCluster.h>
+#include <PSISuperCluster.h>
+#include <HDF5NetworkLoader.h>
+#include <XolotlConfig.h>
 #include <xolotlPerf.h>
 
 using namespace std;
@@ -346,4 +349,228 @@ BOOST_AUTO_TEST_CASE(checkRefCounts) {
 	return;
 }
 
+/**
+ * This operation checks that the fluxes computed by the network, where each
+ * reaction is evaluated only once, are the same as the ones computed by
+ * each cluster, and that the stateless computeFluxes() and
+ * computePartials() give the same values as the fluxes and partial
+ * derivatives computed from the state of the clusters, super clusters
+ * included.
+ */
+BOOST_AUTO_TEST_CASE(checkFluxes) {
+	// Initialize MPI for HDF5
+	int argc = 0;
+	char **argv;
+	MPI_Init(&argc, &argv);
+
+	// Create the network loader
+	HDF5NetworkLoader loader = HDF5NetworkLoader(registry);
+	// Define the filename to load the network from
+	string sourceDir(XolotlSourceDirectory);
+	string pathToFile("/tests/testfiles/tungsten_diminutive_2D.h5");
+	string filename = sourceDir + pathToFile;
+	// Give the filename to the network loader
+	loader.setFilename(filename);
+	// Set grouping parameters
+	loader.setVMin(1);
+	loader.setHeWidth(4);
+	loader.setVWidth(1);
+
+	// Load the network
+	auto network = loader.load();
+
+	// Set the temperature in the network
+	int networkSize = network->size();
+	auto allReactants = network->getAll();
+	double temperature = 1000.0;
+	for (int i = 0; i < networkSize; i++) {
+		allReactants->at(i)->setTemperature(temperature);
+	}
+	for (int i = 0; i < networkSize; i++) {
+		allReactants->at(i)->computeRateConstants();
+	}
+	// Redefine the connectivities and the reaction tables
+	network->reinitializeConnectivities();
+
+	// Set different concentrations for all the degrees of freedom
+	int dof = network->getDOF();
+	std::vector<double> concentrations(dof, 0.0);
+	for (int i = 0; i < dof; i++) {
+		concentrations[i] = 0.01 * (double) (i + 1);
+	}
+	network->updateConcentrationsFromArray(concentrations.data());
+
+	// Compute the fluxes cluster by cluster
+	std::vector<double> knownFluxes(dof, 0.0);
+	for (int i = 0; i < networkSize; i++) {
+		auto cluster = allReactants->at(i);
+		knownFluxes[cluster->getId() - 1] += cluster->getTotalFlux();
+	}
+	auto superClusters = network->getAll(PSISuperType);
+	BOOST_REQUIRE(!superClusters.empty());
+	for (int i = 0; i < superClusters.size(); i++) {
+		auto cluster = (PSISuperCluster *) superClusters[i];
+		knownFluxes[cluster->getHeMomentumId() - 1] +=
+				cluster->getHeMomentumFlux();
+		knownFluxes[cluster->getVMomentumId() - 1] +=
+				cluster->getVMomentumFlux();
+	}
+
+	// Compute them with the network
+	std::vector<double> fluxes(dof, 0.0);
+	network->computeAllFluxes(fluxes.data());
+
+	// Check all the values
+	for (int i = 0; i < dof; i++) {
+		if (knownFluxes[i] == 0.0)
+			BOOST_REQUIRE_SMALL(fluxes[i], 1.0e-10);
+		else
+			BOOST_REQUIRE_CLOSE(fluxes[i], knownFluxes[i], 1.0e-8);
+	}
+
+	// Compute them again from the concentrations and a rate table only
+	RateTable rates;
+	network->computeRateTable(temperature, rates);
+	std::vector<double> statelessFluxes(dof, 0.0);
+	network->computeFluxes(concentrations.data(), statelessFluxes.data(),
+			rates);
+	for (int i = 0; i < dof; i++) {
+		if (fluxes[i] == 0.0)
+			BOOST_REQUIRE_SMALL(statelessFluxes[i], 1.0e-10);
+		else
+			BOOST_REQUIRE_CLOSE(statelessFluxes[i], fluxes[i], 1.0e-8);
+	}
+
+	// Same for the partial derivatives
+	SparseFillMap dfill;
+	network->getDiagonalFill(dfill);
+	int nPartials = network->getPartialsRowPointers()[dof];
+	std::vector<double> partials(nPartials, 0.0);
+	network->computeAllPartials(partials.data());
+	std::vector<double> statelessPartials(nPartials, 0.0);
+	network->computePartials(concentrations.data(), statelessPartials.data(),
+			rates);
+	for (int i = 0; i < nPartials; i++) {
+		if (partials[i] == 0.0)
+			BOOST_REQUIRE_SMALL(statelessPartials[i], 1.0e-10);
+		else
+			BOOST_REQUIRE_CLOSE(statelessPartials[i], partials[i], 1.0e-8);
+	}
+
+	// Compute the partial derivatives cluster by cluster, the ones of the
+	// momentums are only kept until the next super cluster computes its own
+	std::vector<std::vector<double> > knownPartials(dof);
+	for (int i = 0; i < networkSize; i++) {
+		auto cluster = allReactants->at(i);
+		knownPartials[cluster->getId() - 1] = cluster->getPartialDerivatives();
+		if (cluster->getType() != PSISuperType)
+			continue;
+		auto superCluster = (PSISuperCluster *) cluster;
+		std::vector<double> momentumPartials(dof, 0.0);
+		superCluster->getHeMomentPartialDerivatives(momentumPartials);
+		knownPartials[superCluster->getHeMomentumId() - 1] = momentumPartials;
+		superCluster->getVMomentPartialDerivatives(momentumPartials);
+		knownPartials[superCluster->getVMomentumId() - 1] = momentumPartials;
+	}
+
+	// They are the rows of the stateless ones
+	auto rowPointers = network->getPartialsRowPointers();
+	auto columnIds = network->getPartialsColumnIds();
+	for (int i = 0; i < dof; i++) {
+		for (int j = rowPointers[i]; j < rowPointers[i + 1]; j++) {
+			double knownPartial = knownPartials[i][columnIds[j]];
+			if (knownPartial == 0.0)
+				BOOST_REQUIRE_SMALL(statelessPartials[j], 1.0e-10);
+			else
+				BOOST_REQUIRE_CLOSE(statelessPartials[j], knownPartial, 1.0e-8);
+		}
+	}
+
+	return;
+}
+
+/**
+ * This operation checks that the rate constants computed by the rate kernel
+ * of the network are the same as the ones computed by each cluster.
+ */
+BOOST_AUTO_TEST_CASE(checkRateKernel) {
+	// Create the network loader
+	HDF5NetworkLoader loader = HDF5NetworkLoader(registry);
+	// Define the filename to load the network from
+	string sourceDir(XolotlSourceDirectory);
+	string pathToFile("/tests/testfiles/tungsten_diminutive_2D.h5");
+	string filename = sourceDir + pathToFile;
+	// Give the filename to the network loader
+	loader.setFilename(filename);
+	// Set grouping parameters
+	loader.setVMin(1);
+	loader.setHeWidth(4);
+	loader.setVWidth(1);
+
+	// Load the network
+	auto network = loader.load();
+
+	// Set the temperature in the network
+	int networkSize = network->size();
+	auto allReactants = network->getAll();
+	for (int i = 0; i < networkSize; i++) {
+		allReactants->at(i)->setTemperature(1000.0);
+	}
+	for (int i = 0; i < networkSize; i++) {
+		allReactants->at(i)->computeRateConstants();
+	}
+	// Redefine the connectivities and the reaction tables
+	network->reinitializeConnectivities();
+
+	// Set different concentrations for all the degrees of freedom
+	int dof = network->getDOF();
+	std::vector<double> concentrations(dof, 0.0);
+	for (int i = 0; i < dof; i++) {
+		concentrations[i] = 0.01 * (double) (i + 1);
+	}
+	network->updateConcentrationsFromArray(concentrations.data());
+
+	// Check other temperatures
+	double temperatures[2] = { 600.0, 1234.5 };
+	for (int n = 0; n < 2; n++) {
+		// Update the rates cluster by cluster
+		for (int i = 0; i < networkSize; i++) {
+			allReactants->at(i)->setTemperature(temperatures[n]);
+		}
+		for (int i = 0; i < networkSize; i++) {
+			allReactants->at(i)->updateRateConstants();
+		}
+		std::vector<double> knownFluxes(dof, 0.0);
+		network->computeAllFluxes(knownFluxes.data());
+		std::vector<double> knownRates(networkSize * 2, 0.0);
+		for (int i = 0; i < networkSize; i++) {
+			knownRates[2 * i] = allReactants->at(i)->getDiffusionCoefficient();
+			knownRates[2 * i + 1] = allReactants->at(i)->getBiggestRate();
+		}
+
+		// Update them with the rate kernel
+		network->setTemperature(temperatures[n]);
+		std::vector<double> fluxes(dof, 0.0);
+		network->computeAllFluxes(fluxes.data());
+
+		// Check all the values
+		for (int i = 0; i < networkSize; i++) {
+			BOOST_REQUIRE_EQUAL(allReactants->at(i)->getTemperature(),
+					temperatures[n]);
+			BOOST_REQUIRE_CLOSE(allReactants->at(i)->getDiffusionCoefficient(),
+					knownRates[2 * i], 1.0e-10);
+			BOOST_REQUIRE_CLOSE(allReactants->at(i)->getBiggestRate(),
+					knownRates[2 * i + 1], 1.0e-10);
+		}
+		for (int i = 0; i < dof; i++) {
+			BOOST_REQUIRE_CLOSE(fluxes[i], knownFluxes[i], 1.0e-10);
+		}
+	}
+
+	// Finalize MPI
+	MPI_Finalize();
+
+	return;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -10,6 +10,7 @@
 #include <XolotlConfig.h>
 #include <DummyHandlerRegistry.h>
 #include <Constants.h>
+#include <MomentumKernels.h>
 
 using namespace std;
 using namespace xolotlCore;
@@ -201,6 +202,117 @@ BOOST_AUTO_TEST_CASE(checkPartialDerivatives) {
 	return;
 }
 
+/**
+ * Compare the momentum rows accumulated by a kernel with the reference loop.
+ */
+static void checkKernel(void (*kernel)(const double (*)[4], int,
+		const double *, int, double *), const double (*rows)[4], int stride,
+		const double * values, int n) {
+	// The reference loop, with the scale of the terms for the tolerance
+	double reference[4] = { 0.5, -1.0, 2.0, 0.0 }, scale[3] = { 0.5, 1.0,
+			2.0 };
+	for (int t = 0; t < n; t++) {
+		for (int m = 0; m < 3; m++) {
+			reference[m] += values[t] * rows[t * stride][m];
+			scale[m] += fabs(values[t] * rows[t * stride][m]);
+		}
+	}
+
+	// The kernel accumulates on the same initial values
+	alignas(32) double result[4] = { 0.5, -1.0, 2.0, 0.0 };
+	kernel(rows, stride, values, n, result);
+	for (int m = 0; m < 3; m++) {
+		BOOST_REQUIRE_SMALL(result[m] - reference[m], 1.0e-13 * scale[m]);
+	}
+
+	return;
+}
+
+/**
+ * This operation checks each compiled momentum kernel against the reference
+ * loop on the coefficients of a super cluster, for every number of rows and
+ * for the strided accesses.
+ */
+BOOST_AUTO_TEST_CASE(checkMomentumKernels) {
+
+	// Create the network loader
+	HDF5NetworkLoader loader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Define the filename to load the network from
+	string sourceDir(XolotlSourceDirectory);
+	string pathToFile("/tests/testfiles/tungsten_diminutive_2D.h5");
+	string filename = sourceDir + pathToFile;
+	// Give the filename to the network loader
+	loader.setFilename(filename);
+	// Set grouping parameters
+	loader.setVMin(1);
+	loader.setHeWidth(4);
+	loader.setVWidth(1);
+
+	// Load the network
+	auto network = loader.load();
+
+	// Set the temperature in the network, the optimized reactions of the
+	// super clusters are built with the rates
+	int networkSize = network->size();
+	auto allReactants = network->getAll();
+	for (int i = 0; i < networkSize; i++) {
+		allReactants->at(i)->setTemperature(1000.0);
+	}
+	for (int i = 0; i < networkSize; i++) {
+		allReactants->at(i)->computeRateConstants();
+	}
+
+	// The kernels compiled with the current flags
+	std::vector<void (*)(const double (*)[4], int, const double *, int,
+			double *)> kernels = { accumulateMomentumsScalar,
+			accumulateMomentums };
+#if defined(__AVX__)
+	kernels.push_back(accumulateMomentumsAVX);
+#endif
+#if defined(__AVX512F__)
+	kernels.push_back(accumulateMomentumsAVX512);
+#endif
+
+	// Values that are not all the same
+	double values[9];
+	for (int t = 0; t < 9; t++) {
+		values[t] = 1.0 / (double) (t + 1) - 0.3;
+	}
+
+	// Loop on the super clusters and their reacting and dissociating pairs
+	int nChecked = 0;
+	auto superClusters = network->getAll(PSISuperType);
+	for (auto reactant : superClusters) {
+		auto cluster = (PSISuperCluster *) reactant;
+		for (auto & pair : cluster->getEffReactingList()) {
+			for (auto kernel : kernels) {
+				// Every number of rows, odd ones leave a remainder for
+				// the vector kernels
+				for (int n = 0; n <= 9; n++) {
+					checkKernel(kernel, pair.a, 1, values, n);
+				}
+				// The columns of the rows, like the partial derivatives
+				for (int j = 0; j < 3; j++) {
+					checkKernel(kernel, pair.a + j, 3, values, 3);
+				}
+			}
+			nChecked++;
+		}
+		for (auto & pair : cluster->getEffDissociatingList()) {
+			for (auto kernel : kernels) {
+				for (int n = 0; n <= 3; n++) {
+					checkKernel(kernel, pair.a, 1, values, n);
+				}
+			}
+			nChecked++;
+		}
+	}
+	BOOST_REQUIRE(nChecked > 0);
+
+	return;
+}
+
 /**
  * This operation checks the reaction radius for PSISuperCluster.
  */
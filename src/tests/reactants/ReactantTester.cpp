@@ -37,7 +37,11 @@ BOOST_AUTO_TEST_CASE(checkComposition) {
 	Reactant reactant(registry);
 
 	// Check its default composition
-	BOOST_REQUIRE_EQUAL(4U, reactant.getComposition().size());
+	auto composition = reactant.getComposition();
+	BOOST_REQUIRE_EQUAL(0, composition[PSISpecies::He]);
+	BOOST_REQUIRE_EQUAL(0, composition[PSISpecies::V]);
+	BOOST_REQUIRE_EQUAL(0, composition[PSISpecies::I]);
+	BOOST_REQUIRE_EQUAL(0, composition[NESpecies::Xe]);
 
 	return;
 }
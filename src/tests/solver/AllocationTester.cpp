@@ -0,0 +1,188 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/included/unit_test.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string.h>
+#include <PetscSolver.h>
+#include <XolotlConfig.h>
+#include <xolotlPerf.h>
+#include <DummyHandlerRegistry.h>
+#include <Options.h>
+#include <PetscSolver1DHandler.h>
+#include <IMaterialFactory.h>
+#include <TemperatureHandlerFactory.h>
+#include <IReactionHandlerFactory.h>
+#include <VizHandlerRegistryFactory.h>
+
+using namespace std;
+using namespace xolotlCore;
+
+/**
+ * The number of calls to the global operator new since it was last reset.
+ */
+static std::size_t nAllocations = 0;
+
+/**
+ * The global operator new of this test, it counts the allocations. The array
+ * and sized versions all end up calling these two.
+ */
+void * operator new(std::size_t size) {
+	nAllocations++;
+	void * ptr = std::malloc(size ? size : 1);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void operator delete(void * ptr) noexcept {
+	std::free(ptr);
+}
+
+namespace xolotlSolver {
+// The functions given to the TS by the PetscSolver
+extern PetscErrorCode RHSFunction(TS ts, PetscReal ftime, Vec C, Vec F,
+		void *);
+extern PetscErrorCode RHSJacobian(TS ts, PetscReal ftime, Vec C, Mat A, Mat J,
+		void *);
+}
+
+/**
+ * The test suite configuration
+ */
+BOOST_AUTO_TEST_SUITE (AllocationTester_testSuite)
+
+/**
+ * This operation checks that, once the caches of the handlers are filled, an
+ * evaluation of the RHS function or of the Jacobian in 1D doesn't allocate
+ * any memory with operator new.
+ */
+BOOST_AUTO_TEST_CASE(checkNoAllocation1D) {
+	// Initialize MPI for HDF5
+	int argc = 0;
+	char **argv;
+	MPI_Init(&argc, &argv);
+
+	// Local Declarations
+	string sourceDir(XolotlSourceDirectory);
+
+	// Create the path to the network file
+	string pathToFile("/tests/testfiles/tungsten_diminutive.h5");
+	string networkFilename = sourceDir + pathToFile;
+
+	// Create the parameter file
+	std::ofstream paramFile("param.txt");
+	paramFile << "vizHandler=dummy" << std::endl
+			<< "petscArgs=-ts_final_time 1000 -ts_max_steps 1" << std::endl
+			<< "startTemp=900" << std::endl << "perfHandler=dummy" << std::endl
+			<< "flux=4.0e5" << std::endl << "material=W100" << std::endl
+			<< "dimensions=1" << std::endl
+			<< "process=diff advec modifiedTM reaction" << std::endl
+			<< "voidPortion=0.0" << std::endl << "networkFile="
+			<< networkFilename << std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	argv = new char*[2];
+	std::string parameterFile = "param.txt";
+	argv[0] = new char[parameterFile.length() + 1];
+	strcpy(argv[0], parameterFile.c_str());
+	argv[1] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argv);
+	opts.setRegularXGrid(true);
+
+	// Create the solver
+	std::shared_ptr<xolotlSolver::PetscSolver> solver = std::make_shared<
+			xolotlSolver::PetscSolver>(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+
+	// Create the material factory
+	auto materialFactory =
+			xolotlFactory::IMaterialFactory::createMaterialFactory(
+					opts.getMaterial(), opts.getDimensionNumber());
+
+	// Initialize and get the temperature handler
+	bool tempInitOK = xolotlFactory::initializeTempHandler(opts);
+	BOOST_REQUIRE_EQUAL(tempInitOK, true);
+	auto tempHandler = xolotlFactory::getTemperatureHandler();
+
+	// Set up our dummy performance and visualization infrastructures
+	xolotlPerf::initialize(xolotlPerf::toPerfRegistryType("dummy"));
+	xolotlFactory::initializeVizHandler(false);
+
+	// Create the network handler factory
+	auto networkFactory =
+			xolotlFactory::IReactionHandlerFactory::createNetworkFactory(
+					opts.getMaterial());
+	networkFactory->initializeReactionNetwork(opts,
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Get the network handler
+	auto networkHandler = networkFactory->getNetworkHandler();
+
+	// Create a solver handler and initialize it
+	auto solvHandler = std::make_shared<xolotlSolver::PetscSolver1DHandler>();
+	solvHandler->initializeHandlers(materialFactory, tempHandler,
+			networkHandler, opts);
+
+	// Set the solver command line to give the PETSc options and initialize it
+	solver->setCommandLineOptions(opts.getPetscArgc(), opts.getPetscArgv());
+	solver->initialize(solvHandler);
+
+	// Build what the solver builds before the time stepping
+	PetscErrorCode ierr;
+	DM da;
+	solvHandler->createSolverContext(da);
+	Vec C, F;
+	ierr = DMCreateGlobalVector(da, &C);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDuplicate(C, &F);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	solvHandler->initializeConcentration(da, C);
+	TS ts;
+	ierr = TSCreate(PETSC_COMM_WORLD, &ts);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetDM(ts, da);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	Mat J;
+	ierr = DMCreateMatrix(da, &J);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// The first evaluations fill the caches (rate tables, local vectors)
+	ierr = xolotlSolver::RHSFunction(ts, 0.0, C, F, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = xolotlSolver::RHSJacobian(ts, 0.0, C, J, J, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// The next ones, at a later time like in the time stepping, must not
+	// allocate anything
+	nAllocations = 0;
+	ierr = xolotlSolver::RHSFunction(ts, 1.0e-3, C, F, NULL);
+	std::size_t rhsAllocations = nAllocations;
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	nAllocations = 0;
+	ierr = xolotlSolver::RHSJacobian(ts, 1.0e-3, C, J, J, NULL);
+	std::size_t jacobianAllocations = nAllocations;
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	BOOST_REQUIRE_EQUAL(rhsAllocations, 0);
+	BOOST_REQUIRE_EQUAL(jacobianAllocations, 0);
+
+	// Clean up and finalize
+	MatDestroy(&J);
+	TSDestroy(&ts);
+	VecDestroy(&F);
+	VecDestroy(&C);
+	DMDestroy(&da);
+	solver->finalize();
+
+	// Remove the created file
+	std::string tempFile = "param.txt";
+	std::remove(tempFile.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,192 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/included/unit_test.hpp>
+#include <petscts.h>
+#include <Breakpoints.h>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+namespace xolotlSolver {
+// The function used by the PetscSolver to make the time steps land on the
+// times of the flux and temperature profiles
+extern PetscErrorCode setBreakpoints(TS ts, std::vector<double> times);
+}
+
+/**
+ * The times seen by the monitor.
+ */
+static std::vector<PetscReal> monitoredTimes;
+
+/**
+ * The monitor recording the times.
+ */
+PetscErrorCode recordTime(TS, PetscInt, PetscReal time, Vec, void *) {
+	monitoredTimes.push_back(time);
+
+	return 0;
+}
+
+/**
+ * The right hand side of du/dt = -u.
+ */
+PetscErrorCode computeDecay(TS, PetscReal, Vec U, Vec F, void *) {
+	PetscErrorCode ierr;
+	ierr = VecCopy(U, F);
+	CHKERRQ(ierr);
+	ierr = VecScale(F, -1.0);
+	CHKERRQ(ierr);
+
+	return 0;
+}
+
+/**
+ * This suite is responsible for testing that the time steps land on the
+ * breakpoints of the profiles.
+ */
+BOOST_AUTO_TEST_SUITE(Breakpoints_testSuite)
+
+/**
+ * Method checking that the breakpoints are sorted without duplicates and that
+ * the steps are only shortened when they go over the next one.
+ */
+BOOST_AUTO_TEST_CASE(checkTimeStep) {
+	xolotlSolver::Breakpoints breakpoints( { 1.0, 0.6, 0.0, 0.5, 0.6, -1.0 });
+	auto times = breakpoints.getTimes();
+	BOOST_REQUIRE_EQUAL(times.size(), 5);
+	BOOST_REQUIRE_EQUAL(times[0], -1.0);
+	BOOST_REQUIRE_EQUAL(times[1], 0.0);
+	BOOST_REQUIRE_EQUAL(times[2], 0.5);
+	BOOST_REQUIRE_EQUAL(times[3], 0.6);
+	BOOST_REQUIRE_EQUAL(times[4], 1.0);
+
+	// The step from the initial time is not cut to 0.0
+	BOOST_REQUIRE_EQUAL(breakpoints.getTimeStep(0.0, 0.3), 0.3);
+	// It is shortened to land on the next breakpoint
+	BOOST_REQUIRE_CLOSE(breakpoints.getTimeStep(0.3, 0.3), 0.2, 1.0e-10);
+	// Landing on it already is not shortened
+	BOOST_REQUIRE_EQUAL(breakpoints.getTimeStep(0.3, 0.2), 0.2);
+	// A step landing on it within the tolerance is made to land on it exactly
+	BOOST_REQUIRE_EQUAL(breakpoints.getTimeStep(0.3, 0.2 - 1.0e-9),
+			breakpoints.getTimeStep(0.3, 0.3));
+	// The breakpoint the previous step landed on is passed, within the
+	// tolerance
+	BOOST_REQUIRE_CLOSE(breakpoints.getTimeStep(0.5 - 1.0e-9, 0.3), 0.1,
+			1.0e-6);
+	// After the last one nothing is shortened
+	BOOST_REQUIRE_EQUAL(breakpoints.getTimeStep(1.0, 0.3), 0.3);
+
+	// Without breakpoints nothing is shortened
+	xolotlSolver::Breakpoints noBreakpoints;
+	BOOST_REQUIRE(noBreakpoints.getTimes().empty());
+	BOOST_REQUIRE_EQUAL(noBreakpoints.getTimeStep(0.3, 0.3), 0.3);
+}
+
+/**
+ * Method checking that a step retried without the pre-step, with a shorter
+ * step as after a rejection or a failed nonlinear solve, doesn't go over the
+ * breakpoint and that the next step lands on it.
+ */
+BOOST_AUTO_TEST_CASE(checkRetriedStep) {
+	xolotlSolver::Breakpoints breakpoints( { 0.5, 0.6, 1.0 });
+
+	// Mimic the loop of TSSolve: the pre-step is only called before the first
+	// attempt of each step, every second step is rejected once and retried
+	// with half the step, then the adaptor lets the step grow back
+	std::vector<double> solutionTimes = { 0.0 };
+	double time = 0.0, dt = 0.3;
+	for (int step = 0; step < 12; step++) {
+		dt = breakpoints.getTimeStep(time, dt);
+		if (step % 2 == 1)
+			dt *= 0.5;
+		time += dt;
+		solutionTimes.push_back(time);
+		dt *= 2.0;
+	}
+	BOOST_REQUIRE_GT(time, 1.0);
+
+	// No step went over a breakpoint and each one is a time of the solution
+	for (auto breakpoint : breakpoints.getTimes()) {
+		auto it = std::lower_bound(solutionTimes.begin(), solutionTimes.end(),
+				breakpoint - 1.0e-12);
+		BOOST_REQUIRE(it != solutionTimes.end());
+		BOOST_REQUIRE_CLOSE(*it, breakpoint, 1.0e-10);
+	}
+}
+
+/**
+ * Method checking that the time steps are shortened to land exactly on each
+ * breakpoint ahead, and that the breakpoints already passed, including the
+ * one the previous step landed on, don't shorten them.
+ */
+BOOST_AUTO_TEST_CASE(checkStepToBreakpoint) {
+	// Initialize PETSc
+	int argc = 0;
+	char **argv;
+	PetscErrorCode ierr = PetscInitialize(&argc, &argv, NULL, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// Solve du/dt = -u with steps of 0.3 that are never adapted
+	const PetscInt maxSteps = 9;
+	const PetscReal dt = 0.3;
+	Vec u;
+	ierr = VecCreateSeq(PETSC_COMM_SELF, 1, &u);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecSet(u, 1.0);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	TS ts;
+	ierr = TSCreate(PETSC_COMM_SELF, &ts);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetProblemType(ts, TS_NONLINEAR);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetType(ts, TSEULER);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetRHSFunction(ts, NULL, computeDecay, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetInitialTimeStep(ts, 0.0, dt);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetDuration(ts, maxSteps, 100.0);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetExactFinalTime(ts, TS_EXACTFINALTIME_STEPOVER);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSMonitorSet(ts, recordTime, NULL, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// Unsorted breakpoints with a duplicate, the ones at or before the initial
+	// time are already passed
+	std::vector<double> times = { 1.0, 0.6, 0.0, 0.5, 0.6, -1.0 };
+	ierr = xolotlSolver::setBreakpoints(ts, times);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	ierr = TSSolve(ts, u);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// The steps go 0.3, 0.5, 0.6, then 0.1 up to 1.0 and on
+	BOOST_REQUIRE_EQUAL(monitoredTimes.size(), maxSteps + 1);
+	BOOST_REQUIRE_EQUAL(monitoredTimes[0], 0.0);
+	BOOST_REQUIRE_CLOSE(monitoredTimes[1], 0.3, 1.0e-10);
+
+	// Each breakpoint ahead is a time of the solution, exactly
+	BOOST_REQUIRE_EQUAL(monitoredTimes[2], 0.5);
+	BOOST_REQUIRE_EQUAL(monitoredTimes[3], 0.6);
+	BOOST_REQUIRE_EQUAL(monitoredTimes[7], 1.0);
+
+	// The passed breakpoints never shortened a step: the first step is not
+	// cut to 0.0 and no step restarts from the breakpoint it landed on
+	for (PetscInt i = 1; i <= maxSteps; i++) {
+		BOOST_REQUIRE_GT(monitoredTimes[i] - monitoredTimes[i - 1], 0.05);
+	}
+	BOOST_REQUIRE_CLOSE(monitoredTimes[maxSteps], 1.2, 1.0e-8);
+
+	// Clean up and finalize
+	ierr = TSDestroy(&ts);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDestroy(&u);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = PetscFinalize();
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,161 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/included/unit_test.hpp>
+#include <petscts.h>
+#include <vector>
+
+using namespace std;
+
+namespace xolotlSolver {
+// The functions used by the PetscSolver to continue the time stepping after a
+// repartition
+extern PetscErrorCode addMonitor(TS ts,
+		PetscErrorCode (*monitor)(TS, PetscInt, PetscReal, Vec, void *));
+extern PetscErrorCode continueTimeStepping(TS ts, PetscInt nSteps,
+		PetscInt maxSteps);
+}
+
+/**
+ * The time steps and times seen by the monitor.
+ */
+static std::vector<PetscInt> monitoredSteps;
+static std::vector<PetscReal> monitoredTimes;
+
+/**
+ * The monitor recording the time steps.
+ */
+PetscErrorCode recordStep(TS, PetscInt timestep, PetscReal time, Vec, void *) {
+	monitoredSteps.push_back(timestep);
+	monitoredTimes.push_back(time);
+
+	return 0;
+}
+
+/**
+ * The right hand side of du/dt = -u.
+ */
+PetscErrorCode computeDecay(TS, PetscReal, Vec U, Vec F, void *) {
+	PetscErrorCode ierr;
+	ierr = VecCopy(U, F);
+	CHKERRQ(ierr);
+	ierr = VecScale(F, -1.0);
+	CHKERRQ(ierr);
+
+	return 0;
+}
+
+/**
+ * The step after which the time stepping is stopped, like when the grid has
+ * to be repartitioned, -1 once it was stopped.
+ */
+static PetscInt stopStep = 4;
+
+/**
+ * The post step function stopping the time stepping once.
+ */
+PetscErrorCode stopOnce(TS ts) {
+	PetscErrorCode ierr;
+	PetscInt step;
+	ierr = TSGetTimeStepNumber(ts, &step);
+	CHKERRQ(ierr);
+	if (step == stopStep) {
+		stopStep = -1;
+		ierr = TSSetConvergedReason(ts, TS_CONVERGED_USER);
+		CHKERRQ(ierr);
+	}
+
+	return 0;
+}
+
+/**
+ * This suite is responsible for testing the numbering of the time steps when
+ * the time stepping is stopped and started again.
+ */
+BOOST_AUTO_TEST_SUITE(ContinuousSteps_testSuite)
+
+/**
+ * Method checking that the monitors see each time step once, numbered from
+ * the beginning, and that the maximum number of steps counts the steps of
+ * both parts.
+ */
+BOOST_AUTO_TEST_CASE(checkStepsAcrossRestart) {
+	// Initialize PETSc
+	int argc = 0;
+	char **argv;
+	PetscErrorCode ierr = PetscInitialize(&argc, &argv, NULL, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// Solve du/dt = -u with 10 steps of 0.1
+	const PetscInt maxSteps = 10;
+	const PetscReal dt = 0.1;
+	Vec u;
+	ierr = VecCreateSeq(PETSC_COMM_SELF, 1, &u);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecSet(u, 1.0);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	TS ts;
+	ierr = TSCreate(PETSC_COMM_SELF, &ts);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetProblemType(ts, TS_NONLINEAR);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetType(ts, TSEULER);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetRHSFunction(ts, NULL, computeDecay, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetInitialTimeStep(ts, 0.0, dt);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetDuration(ts, maxSteps, 100.0);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetExactFinalTime(ts, TS_EXACTFINALTIME_STEPOVER);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = xolotlSolver::addMonitor(ts, recordStep);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetPostStep(ts, stopOnce);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// The first part stops after 4 steps
+	ierr = TSSolve(ts, u);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	TSConvergedReason reason;
+	ierr = TSGetConvergedReason(ts, &reason);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	BOOST_REQUIRE_EQUAL(reason, TS_CONVERGED_USER);
+	PetscInt firstSteps;
+	ierr = TSGetTimeStepNumber(ts, &firstSteps);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	BOOST_REQUIRE_EQUAL(firstSteps, 4);
+
+	// Start again the way the solver does after a repartition
+	ierr = TSReset(ts);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetSolution(ts, u);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = xolotlSolver::continueTimeStepping(ts, firstSteps, maxSteps);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSolve(ts, u);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	PetscInt secondSteps;
+	ierr = TSGetTimeStepNumber(ts, &secondSteps);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// Only the steps left were done
+	BOOST_REQUIRE_EQUAL(firstSteps + secondSteps, maxSteps);
+
+	// Each step was monitored once, in order
+	BOOST_REQUIRE_EQUAL(monitoredSteps.size(), maxSteps + 1);
+	for (PetscInt i = 0; i <= maxSteps; i++) {
+		BOOST_REQUIRE_EQUAL(monitoredSteps[i], i);
+		BOOST_REQUIRE_CLOSE(monitoredTimes[i] + 1.0, i * dt + 1.0, 1.0e-10);
+	}
+
+	// Clean up and finalize
+	ierr = TSDestroy(&ts);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDestroy(&u);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = PetscFinalize();
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
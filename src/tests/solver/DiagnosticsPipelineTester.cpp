@@ -0,0 +1,125 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/included/unit_test.hpp>
+#include <DiagnosticsPipeline.h>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace xolotlSolver;
+
+/**
+ * This suite is responsible for testing the DiagnosticsPipeline
+ */
+BOOST_AUTO_TEST_SUITE(DiagnosticsPipeline_testSuite)
+
+/**
+ * Method checking that all the reductions are computed in a single sweep.
+ */
+BOOST_AUTO_TEST_CASE(checkSingleSweep) {
+	// Initialize MPI
+	int argc = 0;
+	char **argv;
+	MPI_Init(&argc, &argv);
+
+	int procId, worldSize;
+	MPI_Comm_rank(MPI_COMM_WORLD, &procId);
+	MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+
+	// Each process owns two grid points with two concentrations each
+	const int nx = 2 * worldSize, dof = 2;
+	int xs = 2 * procId, xm = 2;
+	std::vector<std::vector<double> > concentrations(nx,
+			std::vector<double>(dof, 0.0));
+	std::vector<double *> solutionArray(nx, nullptr);
+	for (int xi = xs; xi < xs + xm; xi++) {
+		concentrations[xi][0] = (double) xi;
+		concentrations[xi][1] = 1.0;
+		solutionArray[xi] = concentrations[xi].data();
+	}
+
+	// Count the network updates
+	int nUpdates = 0;
+	DiagnosticsPipeline pipeline([&nUpdates](double *) {
+		nUpdates++;
+	});
+	BOOST_REQUIRE(pipeline.empty());
+
+	// A sum over the grid
+	std::vector<double> total;
+	int offset = pipeline.addReduction(2,
+			[](int, const double *gridPointSolution, double *values) {
+				values[0] += gridPointSolution[0];
+				values[1] += gridPointSolution[1];
+			}, [&total](int, double, const double *values) {
+				total.assign(values, values + 2);
+			}, true);
+	BOOST_REQUIRE_EQUAL(offset, 0);
+
+	// A profile along the grid with two values per grid point, it has its own
+	// buffer
+	std::vector<double> profile;
+	int step = -1;
+	offset = pipeline.addProfile(nx, 2,
+			[](int xi, const double *gridPointSolution, double *values) {
+				values[2 * xi] = 2.0 * gridPointSolution[0];
+				values[2 * xi + 1] = gridPointSolution[1];
+			}, [&profile, &step, nx](int timestep, double, const double *values) {
+				profile.assign(values, values + 2 * nx);
+				step = timestep;
+			}, true);
+	BOOST_REQUIRE_EQUAL(offset, 0);
+	BOOST_REQUIRE(!pipeline.empty());
+
+	// Run it twice, the values are not accumulated between the steps
+	for (int n = 0; n < 2; n++) {
+		pipeline.execute(MPI_COMM_WORLD, xs, xm, solutionArray.data(), n,
+				0.1 * n);
+	}
+
+	// The network was updated once per grid point and step
+	BOOST_REQUIRE_EQUAL(nUpdates, 2 * xm);
+
+	// Check the sums, they are known by every process
+	BOOST_REQUIRE_CLOSE(total[0], (double) (nx * (nx - 1) / 2), 0.0001);
+	BOOST_REQUIRE_CLOSE(total[1], (double) nx, 0.0001);
+
+	// Only the master process receives the profile
+	if (procId != 0) {
+		BOOST_REQUIRE_EQUAL(step, -1);
+		BOOST_REQUIRE(profile.empty());
+		return;
+	}
+	BOOST_REQUIRE_EQUAL(step, 1);
+	for (int xi = 0; xi < nx; xi++) {
+		// Shifted because the first value is zero
+		BOOST_REQUIRE_CLOSE(profile[2 * xi] + 1.0, 2.0 * xi + 1.0, 0.0001);
+		BOOST_REQUIRE_CLOSE(profile[2 * xi + 1], 1.0, 0.0001);
+	}
+}
+
+/**
+ * Method checking that a network update is needed to register a kernel
+ * reading the network.
+ */
+BOOST_AUTO_TEST_CASE(checkNoUpdate) {
+	DiagnosticsPipeline pipeline;
+	auto kernel = [](int, const double *, double *) {
+	};
+	auto sink = [](int, double, const double *) {
+	};
+
+	BOOST_REQUIRE_THROW(pipeline.addReduction(1, kernel, sink, true),
+			std::string);
+	BOOST_REQUIRE_THROW(pipeline.addProfile(4, 1, kernel, sink, true),
+			std::string);
+	BOOST_REQUIRE_EQUAL(pipeline.addReduction(1, kernel, sink), 0);
+	BOOST_REQUIRE_EQUAL(pipeline.addProfile(4, 1, kernel, sink), 0);
+
+	// Finalize MPI
+	MPI_Finalize();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,93 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/included/unit_test.hpp>
+#include <GridPartitioner.h>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace xolotlSolver;
+
+/**
+ * This suite is responsible for testing the GridPartitioner.
+ */
+BOOST_AUTO_TEST_SUITE(GridPartitioner_testSuite)
+
+/**
+ * Method checking the modeled costs of the grid points.
+ */
+BOOST_AUTO_TEST_CASE(checkModelCosts) {
+	// A regular grid with a step of 1 nm and the surface at the third point
+	vector<double> grid = { 0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0 };
+	auto costs = GridPartitioner::computeModelCosts(grid, 2, 2.0);
+	BOOST_REQUIRE_EQUAL(costs.size(), grid.size());
+
+	// Left of the surface, the surface and the last point are only copied
+	BOOST_REQUIRE_EQUAL(costs[0], GridPartitioner::boundaryCost);
+	BOOST_REQUIRE_EQUAL(costs[2], GridPartitioner::boundaryCost);
+	BOOST_REQUIRE_EQUAL(costs[7], GridPartitioner::boundaryCost);
+	// Close to the surface
+	BOOST_REQUIRE_EQUAL(costs[3],
+			GridPartitioner::bulkCost + GridPartitioner::surfaceCost);
+	BOOST_REQUIRE_EQUAL(costs[4],
+			GridPartitioner::bulkCost + GridPartitioner::surfaceCost);
+	// In the bulk
+	BOOST_REQUIRE_EQUAL(costs[5], GridPartitioner::bulkCost);
+	BOOST_REQUIRE_EQUAL(costs[6], GridPartitioner::bulkCost);
+
+	return;
+}
+
+/**
+ * Method checking the split of the grid points between the processes.
+ */
+BOOST_AUTO_TEST_CASE(checkOwnershipRanges) {
+	// Uniform costs give the even split
+	vector<double> costs(12, 1.0);
+	auto ranges = GridPartitioner::computeOwnershipRanges(costs, 4);
+	BOOST_REQUIRE_EQUAL(ranges.size(), 4);
+	for (auto range : ranges) {
+		BOOST_REQUIRE_EQUAL(range, 3);
+	}
+	BOOST_REQUIRE_CLOSE(GridPartitioner::computeImbalance(costs, ranges),
+			1.0, 1.0e-10);
+
+	// Half of the grid is free, the other half is shared
+	costs.assign(12, 0.0);
+	for (int i = 6; i < 12; i++) {
+		costs[i] = 1.0;
+	}
+	ranges = GridPartitioner::computeOwnershipRanges(costs, 3);
+	BOOST_REQUIRE_EQUAL(ranges[0], 8);
+	BOOST_REQUIRE_EQUAL(ranges[1], 2);
+	BOOST_REQUIRE_EQUAL(ranges[2], 2);
+	BOOST_REQUIRE_CLOSE(GridPartitioner::computeImbalance(costs, ranges),
+			1.0, 1.0e-10);
+	// The even split is worse
+	vector<int> evenRanges = { 4, 4, 4 };
+	BOOST_REQUIRE_CLOSE(GridPartitioner::computeImbalance(costs, evenRanges),
+			2.0, 1.0e-10);
+
+	// Each process keeps at least one point, even without any cost
+	costs.assign(5, 0.0);
+	costs[4] = 10.0;
+	ranges = GridPartitioner::computeOwnershipRanges(costs, 5);
+	for (auto range : ranges) {
+		BOOST_REQUIRE_EQUAL(range, 1);
+	}
+	ranges = GridPartitioner::computeOwnershipRanges(costs, 3);
+	BOOST_REQUIRE_EQUAL(accumulate(ranges.begin(), ranges.end(), 0), 5);
+	for (auto range : ranges) {
+		BOOST_REQUIRE(range >= 1);
+	}
+
+	// More processes than grid points is an error
+	BOOST_REQUIRE_THROW(GridPartitioner::computeOwnershipRanges(costs, 6),
+			std::string);
+
+	return;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
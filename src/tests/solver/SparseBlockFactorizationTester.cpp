@@ -0,0 +1,189 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/included/unit_test.hpp>
+#include <SparseBlockFactorization.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace xolotlSolver;
+
+/**
+ * Multiply a dense matrix by a vector.
+ */
+vector<double> multiply(const vector<vector<double> > & matrix,
+		const vector<double> & x) {
+	vector<double> y(x.size(), 0.0);
+	for (unsigned int i = 0; i < matrix.size(); i++) {
+		for (unsigned int j = 0; j < x.size(); j++) {
+			y[i] += matrix[i][j] * x[j];
+		}
+	}
+
+	return y;
+}
+
+/**
+ * Get the columns of the nonzero entries of each row of a dense matrix.
+ */
+vector<vector<int> > getColumns(const vector<vector<double> > & matrix) {
+	vector<vector<int> > columns(matrix.size());
+	for (unsigned int i = 0; i < matrix.size(); i++) {
+		for (unsigned int j = 0; j < matrix[i].size(); j++) {
+			if (matrix[i][j] != 0.0)
+				columns[i].push_back(j);
+		}
+	}
+
+	return columns;
+}
+
+/**
+ * Copy a dense matrix in a block of the factorization.
+ */
+void setBlock(SparseBlockFactorization & factorization, int block,
+		const vector<vector<double> > & matrix) {
+	double * values = factorization.getValues(block);
+	for (unsigned int i = 0; i < matrix.size(); i++) {
+		for (unsigned int j = 0; j < matrix[i].size(); j++) {
+			if (matrix[i][j] != 0.0)
+				values[factorization.find(i, j)] = matrix[i][j];
+		}
+	}
+
+	return;
+}
+
+/**
+ * This suite is responsible for testing the SparseBlockFactorization.
+ */
+BOOST_AUTO_TEST_SUITE(SparseBlockFactorization_testSuite)
+
+/**
+ * Method checking that a large level of fill gives the exact solution and
+ * that the blocks sharing the pattern are independent.
+ */
+BOOST_AUTO_TEST_CASE(checkExactFactorization) {
+	// An arrow matrix, the first row and column are full so the exact
+	// factorization fills everything
+	const int n = 5;
+	vector<vector<double> > matrix(n, vector<double>(n, 0.0));
+	for (int i = 0; i < n; i++) {
+		matrix[i][i] = 10.0 + (double) i;
+		matrix[0][i] += 1.0;
+		matrix[i][0] += 2.0;
+	}
+
+	SparseBlockFactorization factorization;
+	factorization.setPattern(n, getColumns(matrix), n);
+	BOOST_REQUIRE_EQUAL(factorization.getSize(), n);
+	BOOST_REQUIRE_EQUAL(factorization.getNonZeros(), n * n);
+
+	// Two blocks, the second one is the matrix times 2
+	factorization.setNumberOfBlocks(2);
+	setBlock(factorization, 0, matrix);
+	auto doubleMatrix = matrix;
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < n; j++) {
+			doubleMatrix[i][j] *= 2.0;
+		}
+	}
+	setBlock(factorization, 1, doubleMatrix);
+	factorization.factor(0);
+	factorization.factor(1);
+
+	// Solve A x = b
+	vector<double> x = { 1.0, -2.0, 3.0, 0.5, 4.0 };
+	auto b = multiply(matrix, x);
+	auto solution = b;
+	factorization.solve(0, solution.data());
+	for (int i = 0; i < n; i++) {
+		BOOST_REQUIRE_CLOSE(solution[i], x[i], 1.0e-10);
+	}
+	// 2 A x = b
+	solution = b;
+	factorization.solve(1, solution.data());
+	for (int i = 0; i < n; i++) {
+		BOOST_REQUIRE_CLOSE(solution[i], 0.5 * x[i], 1.0e-10);
+	}
+
+	return;
+}
+
+/**
+ * Method checking that ILU(0) keeps the pattern of the matrix.
+ */
+BOOST_AUTO_TEST_CASE(checkIncompleteFactorization) {
+	// The same arrow matrix
+	const int n = 5;
+	vector<vector<double> > matrix(n, vector<double>(n, 0.0));
+	for (int i = 0; i < n; i++) {
+		matrix[i][i] = 10.0 + (double) i;
+		matrix[0][i] += 1.0;
+		matrix[i][0] += 2.0;
+	}
+
+	SparseBlockFactorization factorization;
+	factorization.setPattern(n, getColumns(matrix), 0);
+	BOOST_REQUIRE_EQUAL(factorization.getNonZeros(), 3 * n - 2);
+	BOOST_REQUIRE_EQUAL(factorization.find(1, 2), -1);
+	BOOST_REQUIRE(factorization.find(1, 0) >= 0);
+
+	// The reversed arrow doesn't fill, ILU(0) is exact
+	vector<vector<double> > reversed(n, vector<double>(n, 0.0));
+	for (int i = 0; i < n; i++) {
+		reversed[i][i] = 10.0 + (double) i;
+		reversed[n - 1][i] += 1.0;
+		reversed[i][n - 1] += 2.0;
+	}
+	factorization.setPattern(n, getColumns(reversed), 0);
+	BOOST_REQUIRE_EQUAL(factorization.getNonZeros(), 3 * n - 2);
+	factorization.setNumberOfBlocks(1);
+	setBlock(factorization, 0, reversed);
+	factorization.factor(0);
+	vector<double> x = { 1.0, -2.0, 3.0, 0.5, 4.0 };
+	auto solution = multiply(reversed, x);
+	factorization.solve(0, solution.data());
+	for (int i = 0; i < n; i++) {
+		BOOST_REQUIRE_CLOSE(solution[i], x[i], 1.0e-10);
+	}
+
+	// A zero pivot is an error
+	factorization.setNumberOfBlocks(1);
+	BOOST_REQUIRE_THROW(factorization.factor(0), std::string);
+
+	return;
+}
+
+/**
+ * Method checking the tridiagonal solve.
+ */
+BOOST_AUTO_TEST_CASE(checkTridiagonal) {
+	const int n = 4;
+	vector<double> lower = { 0.0, -1.0, -1.0, -1.0 };
+	vector<double> diag = { 4.0, 4.0, 4.0, 4.0 };
+	vector<double> upper = { -1.0, -2.0, -1.0, 0.0 };
+	vector<double> x = { 1.0, 2.0, -1.0, 3.0 };
+
+	// b = T x
+	vector<double> b(n, 0.0);
+	for (int i = 0; i < n; i++) {
+		b[i] = diag[i] * x[i];
+		if (i > 0)
+			b[i] += lower[i] * x[i - 1];
+		if (i < n - 1)
+			b[i] += upper[i] * x[i + 1];
+	}
+
+	vector<double> work(n, 0.0);
+	SparseBlockFactorization::solveTridiagonal(n, lower.data(), diag.data(),
+			upper.data(), b.data(), work.data());
+	for (int i = 0; i < n; i++) {
+		BOOST_REQUIRE_CLOSE(b[i], x[i], 1.0e-10);
+	}
+
+	return;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
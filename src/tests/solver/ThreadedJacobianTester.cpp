@@ -0,0 +1,230 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/included/unit_test.hpp>
+#include <fstream>
+#include <string.h>
+#include <PetscSolver.h>
+#include <XolotlConfig.h>
+#include <xolotlPerf.h>
+#include <DummyHandlerRegistry.h>
+#include <Options.h>
+#include <PetscSolver1DHandler.h>
+#include <IMaterialFactory.h>
+#include <TemperatureHandlerFactory.h>
+#include <IReactionHandlerFactory.h>
+#include <VizHandlerRegistryFactory.h>
+
+using namespace std;
+using namespace xolotlCore;
+
+/**
+ * This operation computes the Jacobian with the given solver handler the
+ * same way RHSJacobian does.
+ *
+ * @param handler The solver handler
+ * @param ts The TS
+ * @param da The DM
+ * @param C The concentrations
+ * @param J The Jacobian
+ */
+void computeJacobian(xolotlSolver::PetscSolver1DHandler & handler, TS ts,
+		DM da, Vec C, Mat J) {
+	PetscErrorCode ierr;
+	ierr = MatZeroEntries(J);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	Vec localC;
+	ierr = DMGetLocalVector(da, &localC);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	handler.globalToLocal(da, C, localC, true);
+	handler.globalToLocal(da, C, localC, false);
+
+	handler.computeOffDiagonalJacobian(ts, localC, J, 0.0);
+	ierr = MatAssemblyBegin(J, MAT_FINAL_ASSEMBLY);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatAssemblyEnd(J, MAT_FINAL_ASSEMBLY);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	handler.computeDiagonalJacobian(ts, localC, J, 0.0);
+	ierr = MatAssemblyBegin(J, MAT_FINAL_ASSEMBLY);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatAssemblyEnd(J, MAT_FINAL_ASSEMBLY);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	ierr = DMRestoreLocalVector(da, &localC);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	return;
+}
+
+/**
+ * The test suite configuration
+ */
+BOOST_AUTO_TEST_SUITE (ThreadedJacobianTester_testSuite)
+
+/**
+ * This operation checks that the Jacobian computed in 1D with the reaction
+ * partial derivatives added by several threads is the same as the one
+ * computed with a single thread.
+ */
+BOOST_AUTO_TEST_CASE(checkThreadedReactionPartials1D) {
+	// Initialize MPI for HDF5
+	int argc = 0;
+	char **argv;
+	MPI_Init(&argc, &argv);
+
+	// Local Declarations
+	string sourceDir(XolotlSourceDirectory);
+
+	// Create the path to the network file
+	string pathToFile("/tests/testfiles/tungsten_diminutive.h5");
+	string networkFilename = sourceDir + pathToFile;
+
+	// Create the parameter file
+	std::ofstream paramFile("param.txt");
+	paramFile << "vizHandler=dummy" << std::endl
+			<< "petscArgs=-ts_final_time 1000 -ts_max_steps 1" << std::endl
+			<< "startTemp=900" << std::endl << "perfHandler=dummy" << std::endl
+			<< "flux=4.0e5" << std::endl << "material=W100" << std::endl
+			<< "dimensions=1" << std::endl
+			<< "process=diff advec modifiedTM reaction" << std::endl
+			<< "voidPortion=0.0" << std::endl << "networkFile="
+			<< networkFilename << std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	argv = new char*[2];
+	std::string parameterFile = "param.txt";
+	argv[0] = new char[parameterFile.length() + 1];
+	strcpy(argv[0], parameterFile.c_str());
+	argv[1] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argv);
+	opts.setRegularXGrid(true);
+
+	// Create the solver
+	std::shared_ptr<xolotlSolver::PetscSolver> solver = std::make_shared<
+			xolotlSolver::PetscSolver>(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+
+	// Create the material factory
+	auto materialFactory =
+			xolotlFactory::IMaterialFactory::createMaterialFactory(
+					opts.getMaterial(), opts.getDimensionNumber());
+
+	// Initialize and get the temperature handler
+	bool tempInitOK = xolotlFactory::initializeTempHandler(opts);
+	BOOST_REQUIRE_EQUAL(tempInitOK, true);
+	auto tempHandler = xolotlFactory::getTemperatureHandler();
+
+	// Set up our dummy performance and visualization infrastructures
+	xolotlPerf::initialize(xolotlPerf::toPerfRegistryType("dummy"));
+	xolotlFactory::initializeVizHandler(false);
+
+	// Create the network handler factory
+	auto networkFactory =
+			xolotlFactory::IReactionHandlerFactory::createNetworkFactory(
+					opts.getMaterial());
+	networkFactory->initializeReactionNetwork(opts,
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Get the network handler
+	auto networkHandler = networkFactory->getNetworkHandler();
+
+	// Create one solver handler with a single thread and one with two
+	opts.setNumThreads(1);
+	auto serialHandler =
+			std::make_shared<xolotlSolver::PetscSolver1DHandler>();
+	serialHandler->initializeHandlers(materialFactory, tempHandler,
+			networkHandler, opts);
+	opts.setNumThreads(2);
+	auto threadedHandler =
+			std::make_shared<xolotlSolver::PetscSolver1DHandler>();
+	threadedHandler->initializeHandlers(materialFactory, tempHandler,
+			networkHandler, opts);
+
+	// Set the solver command line to give the PETSc options and initialize it
+	solver->setCommandLineOptions(opts.getPetscArgc(), opts.getPetscArgv());
+	solver->initialize(serialHandler);
+
+	// Build what the solver builds before the time stepping, for each handler
+	PetscErrorCode ierr;
+	DM serialDa, threadedDa;
+	serialHandler->createSolverContext(serialDa);
+	threadedHandler->createSolverContext(threadedDa);
+	Vec serialC, threadedC;
+	ierr = DMCreateGlobalVector(serialDa, &serialC);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = DMCreateGlobalVector(threadedDa, &threadedC);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	serialHandler->initializeConcentration(serialDa, serialC);
+	threadedHandler->initializeConcentration(threadedDa, threadedC);
+	// Set a concentration everywhere for all the clusters to react
+	ierr = VecSet(serialC, 1.0e-3);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecSet(threadedC, 1.0e-3);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	TS serialTs, threadedTs;
+	ierr = TSCreate(PETSC_COMM_WORLD, &serialTs);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetDM(serialTs, serialDa);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSCreate(PETSC_COMM_WORLD, &threadedTs);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetDM(threadedTs, threadedDa);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	Mat serialJ, threadedJ;
+	ierr = DMCreateMatrix(serialDa, &serialJ);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = DMCreateMatrix(threadedDa, &threadedJ);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// Compute the two Jacobians
+	computeJacobian(*serialHandler, serialTs, serialDa, serialC, serialJ);
+	computeJacobian(*threadedHandler, threadedTs, threadedDa, threadedC,
+			threadedJ);
+
+	// They must be the same, up to the rounding
+	PetscReal serialNorm, diffNorm;
+	ierr = MatNorm(serialJ, NORM_FROBENIUS, &serialNorm);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	BOOST_REQUIRE_GT(serialNorm, 0.0);
+	ierr = MatAXPY(threadedJ, -1.0, serialJ, SAME_NONZERO_PATTERN);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatNorm(threadedJ, NORM_FROBENIUS, &diffNorm);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	BOOST_REQUIRE_SMALL(diffNorm / serialNorm, 1.0e-12);
+
+	// The partial derivatives are added in place only in an assembled matrix,
+	// setting a value leaves it unassembled
+	Vec localC;
+	ierr = DMGetLocalVector(threadedDa, &localC);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	threadedHandler->globalToLocal(threadedDa, threadedC, localC, true);
+	threadedHandler->globalToLocal(threadedDa, threadedC, localC, false);
+	ierr = MatSetValue(threadedJ, 0, 0, 1.0, ADD_VALUES);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	BOOST_REQUIRE_THROW(
+			threadedHandler->computeDiagonalJacobian(threadedTs, localC,
+					threadedJ, 0.0), std::string);
+	ierr = DMRestoreLocalVector(threadedDa, &localC);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// Clean up and finalize
+	MatDestroy(&threadedJ);
+	MatDestroy(&serialJ);
+	TSDestroy(&threadedTs);
+	TSDestroy(&serialTs);
+	VecDestroy(&threadedC);
+	VecDestroy(&serialC);
+	DMDestroy(&threadedDa);
+	DMDestroy(&serialDa);
+	solver->finalize();
+
+	// Remove the created file
+	std::string tempFile = "param.txt";
+	std::remove(tempFile.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
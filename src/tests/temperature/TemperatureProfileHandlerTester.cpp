@@ -71,4 +71,43 @@ BOOST_AUTO_TEST_CASE(check_getTemperature) {
 	return;
 }
 
+BOOST_AUTO_TEST_CASE(check_getTemperatureAtKnots) {
+	// Create a file with a pulsed temperature profile
+	std::ofstream writeTempFile("tempFile.dat");
+	writeTempFile << "# time temperature \n"
+	"0.0 1000.0 \n"
+	"1.0 1000.0 \n"
+	"1.5 2000.0 \n"
+	"2.0 1000.0 \n"
+	"10.0 1000.0";
+	writeTempFile.close();
+
+	// Create and initialize the temperature profile handler
+	auto testTemp = make_shared<TemperatureProfileHandler>("tempFile.dat");
+	testTemp->initializeTemperature();
+	std::vector<double> pos = { 0.0, 0.0, 0.0 };
+
+	// The values at the knots are the stored ones
+	BOOST_REQUIRE_CLOSE(testTemp->getTemperature(pos, 1.0), 1000.0, 1.0e-10);
+	BOOST_REQUIRE_CLOSE(testTemp->getTemperature(pos, 1.5), 2000.0, 1.0e-10);
+	BOOST_REQUIRE_CLOSE(testTemp->getTemperature(pos, 2.0), 1000.0, 1.0e-10);
+
+	// The same time twice and going back in time give the interpolated value
+	BOOST_REQUIRE_CLOSE(testTemp->getTemperature(pos, 1.75), 1500.0, 1.0e-10);
+	BOOST_REQUIRE_CLOSE(testTemp->getTemperature(pos, 1.75), 1500.0, 1.0e-10);
+	BOOST_REQUIRE_CLOSE(testTemp->getTemperature(pos, 1.25), 1500.0, 1.0e-10);
+	BOOST_REQUIRE_CLOSE(testTemp->getTemperature(pos, 5.0), 1000.0, 1.0e-10);
+
+	// The breakpoints are the times of the profile
+	auto breakpoints = testTemp->getBreakpoints();
+	BOOST_REQUIRE_EQUAL(breakpoints.size(), 5);
+	BOOST_REQUIRE_EQUAL(breakpoints[2], 1.5);
+
+	// Remove the created file
+	std::string tempFile = "tempFile.dat";
+	std::remove(tempFile.c_str());
+
+	return;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
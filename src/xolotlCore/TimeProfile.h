@@ -0,0 +1,140 @@
+#ifndef TIMEPROFILE_H
+#define TIMEPROFILE_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+
+namespace xolotlCore {
+
+/**
+ * This class stores a quantity given as a table of (time, value) pairs and
+ * linearly interpolates it in time. It is used for the time profiles of the
+ * incident flux amplitude and of the temperature.
+ *
+ * The RHS and Jacobian evaluations ask for the value at the same time for
+ * every grid point, so the last evaluated time and its value are kept and
+ * the table is only searched, with a binary search, when the time changes.
+ */
+class TimeProfile {
+
+private:
+
+	/**
+	 * The times of the table, in increasing order.
+	 */
+	std::vector<double> times;
+
+	/**
+	 * The value at each time of the table.
+	 */
+	std::vector<double> values;
+
+	/**
+	 * The last time at which the value was evaluated and this value.
+	 */
+	mutable double lastTime;
+	mutable double lastValue;
+
+	/**
+	 * Is there a value evaluated at lastTime?
+	 */
+	mutable bool hasLastValue;
+
+public:
+
+	/**
+	 * The constructor.
+	 */
+	TimeProfile() :
+			lastTime(0.0), lastValue(0.0), hasLastValue(false) {
+	}
+
+	/**
+	 * This operation reads the table from a file with one time and its value
+	 * per line. Empty lines and lines starting with # are skipped.
+	 *
+	 * @param fileName The name of the file
+	 */
+	void readFile(const std::string& fileName) {
+		// Open the file containing the time and values
+		std::ifstream inputFile(fileName.c_str());
+		std::string line;
+
+		// Read the file and store the values in the two vectors
+		while (getline(inputFile, line)) {
+			if (!line.length() || line[0] == '#')
+				continue;
+			double xtime = 0.0, yvalue = 0.0;
+			sscanf(line.c_str(), "%lf %lf", &xtime, &yvalue);
+			times.push_back(xtime);
+			values.push_back(yvalue);
+		}
+		hasLastValue = false;
+
+		return;
+	}
+
+	/**
+	 * This operation returns the value at the given time, linearly
+	 * interpolated between the two surrounding times of the table. The
+	 * first and last values are used outside of the table.
+	 *
+	 * @param currentTime The time
+	 * @return The value at this time
+	 */
+	double getValue(double currentTime) const {
+		// Nothing to search if the time did not change
+		if (hasLastValue && currentTime == lastTime)
+			return lastValue;
+
+		double f = 0.0;
+		if (currentTime <= times.front())
+			f = values.front();
+		else if (currentTime >= times.back())
+			f = values.back();
+		else {
+			// Find the interval the time falls in,
+			// i.e. times[k] <= time < times[k + 1]
+			int k = std::upper_bound(times.begin(), times.end(), currentTime)
+					- times.begin() - 1;
+
+			// Compute the value following a linear interpolation between
+			// the two stored values
+			f = values[k]
+					+ (values[k + 1] - values[k]) * (currentTime - times[k])
+							/ (times[k + 1] - times[k]);
+		}
+
+		lastTime = currentTime;
+		lastValue = f;
+		hasLastValue = true;
+
+		return f;
+	}
+
+	/**
+	 * This operation returns the times of the table.
+	 *
+	 * @return The times
+	 */
+	const std::vector<double>& getTimes() const {
+		return times;
+	}
+
+	/**
+	 * Is the table empty?
+	 *
+	 * @return True if no value was read
+	 */
+	bool empty() const {
+		return times.empty();
+	}
+
+};
+//end class TimeProfile
+
+} /* end namespace xolotlCore */
+#endif
@@ -29,10 +29,10 @@ namespace xolotlCore
  * and doesn't fill them.
  *
  * @param network The network
- * @param ofill The pointer to the array that will contain the value 1 at the indices
+ * @param ofill The sparse fill map that will contain the diagonal entries at the indices
  * of the advecting clusters
  */
-   void initialize( IReactionNetwork* network, int* ofill ) 
+   void initialize( IReactionNetwork* network, SparseFillMap& ofill ) 
    {
 // Clear the index and sink strength vectors
     indexVector.clear();
@@ -5,6 +5,7 @@
 #include <PSICluster.h>
 #include <IReactionNetwork.h>
 #include <memory>
+#include <array>
 
 namespace xolotlCore {
 
@@ -27,10 +28,10 @@ public:
 	 * and their corresponding sink strength (or driving forces).
 	 *
 	 * @param network The network
-	 * @param ofill The pointer to the array that will contain the value 1 at the indices
+	 * @param ofill The sparse fill map that will contain the diagonal entries at the indices
 	 * of the advecting clusters
 	 */
-	virtual void initialize(IReactionNetwork *network, int *ofill) = 0;
+	virtual void initialize(IReactionNetwork *network, SparseFillMap &ofill) = 0;
 
 	/**
 	 * Set the number of dimension
@@ -116,9 +117,10 @@ public:
 	 * This method is called by the RHSJacobian from the PetscSolver.
 	 *
 	 * @param pos The position on the grid
-	 * @return The indices for the position in the Jacobian
+	 * @return The indices for the position in the Jacobian, returned by
+	 * value without any heap allocation
 	 */
-	virtual std::vector<int> getStencilForAdvection(std::vector<double> &pos) = 0;
+	virtual std::array<int, 3> getStencilForAdvection(std::vector<double> &pos) = 0;
 
 	/**
 	 * Check whether the grid point is located on the sink surface or not.
@@ -148,7 +148,7 @@ void SurfaceAdvectionHandler::computePartialsForAdvection(
 	return;
 }
 
-std::vector<int> SurfaceAdvectionHandler::getStencilForAdvection(
+std::array<int, 3> SurfaceAdvectionHandler::getStencilForAdvection(
 		std::vector<double> &pos) {
 	// Always return (1, 0, 0)
 	return {1, 0, 0};
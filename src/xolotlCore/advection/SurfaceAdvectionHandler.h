@@ -88,7 +88,7 @@ public:
 	 *
 	 * \see IAdvectionHandler.h
 	 */
-	std::vector<int> getStencilForAdvection(std::vector<double> &pos);
+	std::array<int, 3> getStencilForAdvection(std::vector<double> &pos);
 
 	/**
 	 * Check whether the grid point is located on the sink surface or not.
@@ -26,14 +26,13 @@ public:
 	 * (111) tungsten material.
 	 *
 	 * @param network The network
-	 * @param ofill The pointer to the array that will contain the value 1 at the indices
+	 * @param ofill The sparse fill map that will contain the diagonal entries at the indices
 	 * of the advecting clusters
 	 */
-	void initialize(IReactionNetwork *network, int *ofill) {
+	void initialize(IReactionNetwork *network, SparseFillMap &ofill) {
 		// Get all the reactants and their number
 		auto reactants = network->getAll();
 		int networkSize = reactants->size();
-		int dof = network->getDOF();
 
 		// Clear the index and sink strength vectors
 		indexVector.clear();
@@ -93,8 +92,8 @@ public:
 			// Set the off-diagonal part for the Jacobian to 1
 			// Get its id
 			int index = cluster->getId() - 1;
-			// Set the ofill value to 1 for this cluster
-			ofill[index * dof + index] = 1;
+			// Add the diagonal entry of this cluster to ofill
+			ofill[index].push_back(index);
 		}
 
 		return;
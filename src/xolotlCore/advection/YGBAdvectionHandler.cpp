@@ -4,11 +4,10 @@
 namespace xolotlCore {
 
 void YGBAdvectionHandler::initialize(IReactionNetwork *network,
-		int *ofill) {
+		SparseFillMap &ofill) {
 	// Get all the reactants and their number
 	auto reactants = network->getAll();
 	int networkSize = reactants->size();
-	int dof = network->getDOF();
 
 	// Clear the index and sink strength vectors
 	indexVector.clear();
@@ -71,8 +70,8 @@ void YGBAdvectionHandler::initialize(IReactionNetwork *network,
 		// Set the off-diagonal part for the Jacobian to 1
 		// Get its id
 		int index = cluster->getId() - 1;
-		// Set the ofill value to 1 for this cluster
-		ofill[index * dof + index] = 1;
+		// Add the diagonal entry of this cluster to ofill
+		ofill[index].push_back(index);
 	}
 
 	return;
@@ -183,7 +182,7 @@ void YGBAdvectionHandler::computePartialsForAdvection(
 	return;
 }
 
-std::vector<int> YGBAdvectionHandler::getStencilForAdvection(
+std::array<int, 3> YGBAdvectionHandler::getStencilForAdvection(
 		std::vector<double> &pos) {
 	// The second index is positive by convention if we are on the sink
 	if (isPointOnSink(pos))
@@ -30,7 +30,7 @@ public:
 	 *
 	 * \see IAdvectionHandler.h
 	 */
-	void initialize(IReactionNetwork *network, int *ofill);
+	void initialize(IReactionNetwork *network, SparseFillMap &ofill);
 
 	/**
 	 * Initialize an array of the dimension of the physical domain times the number of advecting
@@ -80,7 +80,7 @@ public:
 	 *
 	 * \see IAdvectionHandler.h
 	 */
-	std::vector<int> getStencilForAdvection(std::vector<double> &pos);
+	std::array<int, 3> getStencilForAdvection(std::vector<double> &pos);
 
 	/**
 	 * Check whether the grid point is located on the sink surface or not.
@@ -420,6 +420,35 @@ public:
 	 */
 	virtual void setSputteringYield(double yield) = 0;
 
+	/**
+	 * Obtain the number of threads used by each process to compute the grid
+	 * points it owns.
+	 *
+	 * @return The number of threads
+	 */
+	virtual int getNumThreads() const = 0;
+
+	/**
+	 * Set the number of threads used by each process.
+	 *
+	 * @param nThreads The number of threads
+	 */
+	virtual void setNumThreads(int nThreads) = 0;
+
+	/**
+	 * Get the name of the file caching the compiled reaction tables.
+	 *
+	 * @return The name of the file, empty if there is no cache
+	 */
+	virtual std::string getNetworkCacheFilename() const = 0;
+
+	/**
+	 * Set the name of the file caching the compiled reaction tables.
+	 *
+	 * @param name The name of the file
+	 */
+	virtual void setNetworkCacheFilename(const std::string& name) = 0;
+
 };
 //end class IOptions
 
@@ -19,6 +19,8 @@
 #include <GrainBoundariesOptionHandler.h>
 #include <GroupingOptionHandler.h>
 #include <SputteringOptionHandler.h>
+#include <ThreadsOptionHandler.h>
+#include <NetworkCacheOptionHandler.h>
 #include "Options.h"
 
 namespace xolotlCore {
@@ -46,7 +48,9 @@ Options::Options() :
 		groupingMin(std::numeric_limits<int>::max()),
 		groupingWidthA(1),
 		groupingWidthB(1),
-		sputteringYield(0.0) {
+		sputteringYield(0.0),
+		numThreads(1),
+		networkCacheFilename("") {
 
 	// Create the network option handler
 	auto networkHandler = new NetworkOptionHandler();
@@ -82,6 +86,10 @@ Options::Options() :
 	auto groupingHandler = new GroupingOptionHandler();
 	// Create the grouping option handler
 	auto sputteringHandler = new SputteringOptionHandler();
+	// Create the threads option handler
+	auto threadsHandler = new ThreadsOptionHandler();
+	// Create the network cache option handler
+	auto networkCacheHandler = new NetworkCacheOptionHandler();
 
 	// Add our notion of which options we support.
 	optionsMap[networkHandler->key] = networkHandler;
@@ -101,6 +109,8 @@ Options::Options() :
 	optionsMap[gbHandler->key] = gbHandler;
 	optionsMap[groupingHandler->key] = groupingHandler;
 	optionsMap[sputteringHandler->key] = sputteringHandler;
+	optionsMap[threadsHandler->key] = threadsHandler;
+	optionsMap[networkCacheHandler->key] = networkCacheHandler;
 }
 
 Options::~Options(void) {
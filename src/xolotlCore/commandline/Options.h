@@ -154,6 +154,16 @@ protected:
 	 */
 	double sputteringYield;
 
+	/**
+	 * Number of threads used by each process.
+	 */
+	int numThreads;
+
+	/**
+	 * The name of the file caching the compiled reaction tables.
+	 */
+	std::string networkCacheFilename;
+
 public:
 
 	/**
@@ -616,6 +626,38 @@ public:
 		sputteringYield = yield;
 	}
 
+	/**
+	 * Obtain the number of threads used by each process.
+	 * \see IOptions.h
+	 */
+	int getNumThreads() const {
+		return numThreads;
+	}
+
+	/**
+	 * Set the number of threads used by each process.
+	 * \see IOptions.h
+	 */
+	void setNumThreads(int nThreads) {
+		numThreads = nThreads;
+	}
+
+	/**
+	 * Get the name of the file caching the compiled reaction tables.
+	 * \see IOptions.h
+	 */
+	std::string getNetworkCacheFilename() const {
+		return networkCacheFilename;
+	}
+
+	/**
+	 * Set the name of the file caching the compiled reaction tables.
+	 * \see IOptions.h
+	 */
+	void setNetworkCacheFilename(const std::string& name) {
+		networkCacheFilename = name;
+	}
+
 };
 //end class Options
 
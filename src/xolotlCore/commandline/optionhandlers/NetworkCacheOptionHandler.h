@@ -0,0 +1,52 @@
+#ifndef NETWORKCACHEOPTIONHANDLER_H
+#define NETWORKCACHEOPTIONHANDLER_H
+
+// Includes
+#include "OptionHandler.h"
+
+namespace xolotlCore {
+
+/**
+ * NetworkCacheOptionHandler handles the name of the file caching the
+ * compiled reaction tables of the network.
+ */
+class NetworkCacheOptionHandler: public OptionHandler {
+public:
+
+	/**
+	 * The default constructor
+	 */
+	NetworkCacheOptionHandler() :
+			OptionHandler("networkCache",
+					"networkCache <filename>           "
+							"The compiled reaction tables of the network are read from "
+							"this HDF5 file if it matches the network file and grouping "
+							"parameters, otherwise they are written in it.\n") {
+	}
+
+	/**
+	 * The destructor
+	 */
+	~NetworkCacheOptionHandler() {
+	}
+
+	/**
+	 * This method will set the IOptions networkCacheFilename
+	 * to the value given as the argument.
+	 *
+	 * @param opt The pointer to the option that will be modified.
+	 * @param arg The argument for the networkCacheFilename.
+	 */
+	bool handler(IOptions *opt, const std::string& arg) {
+		// Set the name of the cache file
+		opt->setNetworkCacheFilename(arg);
+
+		return true;
+	}
+
+};
+//end class NetworkCacheOptionHandler
+
+} /* namespace xolotlCore */
+
+#endif
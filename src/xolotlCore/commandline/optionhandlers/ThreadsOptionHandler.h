@@ -0,0 +1,62 @@
+#ifndef THREADSOPTIONHANDLER_H
+#define THREADSOPTIONHANDLER_H
+
+// Includes
+#include "OptionHandler.h"
+
+namespace xolotlCore {
+
+/**
+ * ThreadsOptionHandler handles the number of threads used by each process
+ * to compute the grid points it owns.
+ */
+class ThreadsOptionHandler: public OptionHandler {
+public:
+
+	/**
+	 * The default constructor
+	 */
+	ThreadsOptionHandler() :
+			OptionHandler("threads",
+					"threads <number>                  "
+							"The number of threads used by each process to compute "
+							"its grid points (default is 1).") {
+	}
+
+	/**
+	 * The destructor
+	 */
+	~ThreadsOptionHandler() {
+	}
+
+	/**
+	 * This method will set the IOptions numThreads
+	 * to the value given as the argument.
+	 *
+	 * @param opt The pointer to the option that will be modified.
+	 * @param arg The number of threads.
+	 */
+	bool handler(IOptions *opt, const std::string& arg) {
+		// Convert to int
+		int nThreads = strtol(arg.c_str(), NULL, 10);
+
+		// Check the given value makes sense
+		if (nThreads < 1) {
+			std::cerr << "Options: wrong value for the threads option handler: "
+					<< arg << std::endl;
+			opt->showHelp(std::cerr);
+			opt->setShouldRunFlag(false);
+			opt->setExitCode(EXIT_FAILURE);
+			return false;
+		}
+
+		opt->setNumThreads(nThreads);
+		return true;
+	}
+
+};
+//end class ThreadsOptionHandler
+
+} /* namespace xolotlCore */
+
+#endif
@@ -30,17 +30,16 @@ public:
 	 * Initialize the off-diagonal part of the Jacobian. If this step is skipped it
 	 * won't be possible to set the partial derivatives for the diffusion.
 	 *
-	 * The value 1 is set in ofill if a cluster has a non zero diffusion coefficient.
+	 * A diagonal entry is added in ofill if a cluster has a non zero diffusion coefficient.
 	 *
 	 * @param network The network
-	 * @param ofill The pointer to the array that will contain the value 1 at the indices
+	 * @param ofill The sparse fill map that will contain the diagonal entries at the indices
 	 * of the diffusing clusters
 	 */
-	virtual void initializeOFill(IReactionNetwork *network, int *ofill) {
+	virtual void initializeOFill(IReactionNetwork *network, SparseFillMap &ofill) {
 		// Get all the reactants
 		auto reactants = network->getAll();
 		int networkSize = reactants->size();
-		int dof = network->getDOF();
 
 		// Clear the index vector
 		indexVector.clear();
@@ -60,8 +59,8 @@ public:
 
 			// Get its id
 			int index = cluster->getId() - 1;
-			// Set the ofill value to 1 for this cluster
-			ofill[index * dof + index] = 1;
+			// Add the diagonal entry of this cluster to ofill
+			ofill[index].push_back(index);
 		}
 
 		return;
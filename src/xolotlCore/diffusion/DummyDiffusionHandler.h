@@ -24,14 +24,14 @@ public:
 	 * Initialize the off-diagonal part of the Jacobian. If this step is skipped it
 	 * won't be possible to set the partials for the diffusion.
 	 *
-	 * We don't want any cluster to diffuse, so nothing is set to 1 in ofill, and no index
+	 * We don't want any cluster to diffuse, so nothing is added to ofill, and no index
 	 * is added to the vector.
 	 *
 	 * @param network The network
-	 * @param ofill The pointer to the array that will contain the value 1 at the indices
+	 * @param ofill The sparse fill map that will contain the diagonal entries at the indices
 	 * of the diffusing clusters
 	 */
-	void initializeOFill(IReactionNetwork *network, int *ofill) {
+	void initializeOFill(IReactionNetwork *network, SparseFillMap &ofill) {
 		// Clear the index vector
 		indexVector.clear();
 
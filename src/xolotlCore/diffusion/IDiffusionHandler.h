@@ -28,11 +28,11 @@ public:
 	 * won't be possible to set the partial derivatives for the diffusion.
 	 *
 	 * @param network The network
-	 * @param ofill The pointer to the array that will contain the value 1 at the indices
+	 * @param ofill The sparse fill map that will contain the diagonal entries at the indices
 	 * of the diffusing clusters
 	 */
 	virtual void initializeOFill(IReactionNetwork *network,
-			int *ofill) = 0;
+			SparseFillMap &ofill) = 0;
 
 	/**
 	 * Initialize an array of the dimension of the physical domain times the number of diffusion
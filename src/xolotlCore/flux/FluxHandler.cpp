@@ -10,22 +10,38 @@
 namespace xolotlCore {
 
 FluxHandler::FluxHandler() :
+		currentSurfacePos(-1),
+		currentProfile(nullptr),
 		fluence(0.0),
 		fluxAmplitude(0.0),
 		fluxIndex(-1),
-		useTimeProfile(false),
-		normFactor(0.0){
+		useTimeProfile(false) {
 	return;
 }
 
 void FluxHandler::initializeFluxHandler(IReactionNetwork *network,
 		int surfacePos, std::vector<double> grid) {
-	// Set the grid
+	// Set the grid, the profiles computed before are dropped
 	xGrid = grid;
+	incidentFluxProfiles.clear();
+	incidentFluxProfiles.resize(xGrid.size());
+
+	// Compute the profile of this position of the surface
+	setSurfacePosition(surfacePos);
+	currentProfile = &incidentFluxProfiles[surfacePos];
+	currentSurfacePos = surfacePos;
+
+	return;
+}
+
+void FluxHandler::setSurfacePosition(int surfacePos) {
+	auto & profile = incidentFluxProfiles[surfacePos];
+	if (!profile.empty())
+		return;
 
 	// Compute the norm factor because the fit function has an
 	// arbitrary amplitude
-	normFactor = 0.0;
+	double normFactor = 0.0;
 	// Loop on the x grid points skipping the first after the surface position
 	// and last because of the boundary conditions
 	for (int i = surfacePos + 1; i < xGrid.size() - 1; i++) {
@@ -36,46 +52,20 @@ void FluxHandler::initializeFluxHandler(IReactionNetwork *network,
 		normFactor += FitFunction(x) * (xGrid[i] - xGrid[i-1]);
 	}
 
-	// Factor the incident flux will be multiplied by to get
-	// the wanted intensity
-	double fluxNormalized = fluxAmplitude / normFactor;
-
-	// Clear the flux vector
-	incidentFluxVec.clear();
 	// The first value corresponding to the surface position should always be 0.0
-	incidentFluxVec.push_back(0.0);
+	profile.push_back(0.0);
 
 	// Starts a i = surfacePos + 1 because the first value was already put in the vector
 	for (int i = surfacePos + 1; i < xGrid.size() - 1; i++) {
 		// Get the x position
 		auto x = xGrid[i] - xGrid[surfacePos];
 
-		// Compute the flux value
-		double incidentFlux = fluxNormalized * FitFunction(x);
-		// Add it to the vector
-		incidentFluxVec.push_back(incidentFlux);
+		// Compute the flux value for a unit amplitude and add it to the vector
+		profile.push_back(FitFunction(x) / normFactor);
 	}
 
 	// The last value should always be 0.0 because of boundary conditions
-	incidentFluxVec.push_back(0.0);
-
-	return;
-}
-
-void FluxHandler::recomputeFluxHandler(int surfacePos) {
-	// Factor the incident flux will be multiplied by
-	double fluxNormalized = fluxAmplitude / normFactor;
-
-	// Starts a i = surfacePos + 1 because the first values were already put in the vector
-	for (int i = surfacePos + 1; i < xGrid.size() - 1; i++) {
-		// Get the x position
-		auto x = xGrid[i] - xGrid[surfacePos];
-
-		// Compute the flux value
-		double incidentFlux = fluxNormalized * FitFunction(x);
-		// Add it to the vector
-		incidentFluxVec[i - surfacePos] = incidentFlux;
-	}
+	profile.push_back(0.0);
 
 	return;
 }
@@ -84,61 +74,32 @@ void FluxHandler::initializeTimeProfile(const std::string& fileName) {
 	// Set use time profile to true
 	useTimeProfile = true;
 
-	// Open file dataFile.dat containing the time and amplitude
-	std::ifstream inputFile(fileName.c_str());
-	std::string line;
-
-	// Read the file and store the values in the two vectors
-	while (getline(inputFile, line)) {
-		if (!line.length() || line[0] == '#')
-			continue;
-		double xamp = 0.0, yamp = 0.0;
-		sscanf(line.c_str(), "%lf %lf", &xamp, &yamp);
-		time.push_back(xamp);
-		amplitudes.push_back(yamp);
-	}
+	// Read the time and amplitude from the file
+	amplitudeProfile.readFile(fileName);
 
 	return;
 }
 
-double FluxHandler::getProfileAmplitude(double currentTime) const {
-	// Initialize the amplitude to return
-	double f = 0.0;
-
-	// If the time is smaller than or equal than the first stored time
-	if (currentTime <= time[0])
-		return f = amplitudes[0];
-
-	// If the time is larger or equal to the last stored time
-	if (currentTime >= time[time.size() - 1])
-		return f = amplitudes[time.size() - 1];
-
-	// Else loop to determine the interval the time falls in
-	// i.e. time[k] < time < time[k + 1]
-	for (unsigned int k = 0; k < time.size() - 1; k++) {
-		if (currentTime < time[k]) continue;
-		if (currentTime > time[k + 1]) continue;
-
-		// Compute the amplitude following a linear interpolation between
-		// the two stored values
-		f = amplitudes[k]
-				+ (amplitudes[k + 1] - amplitudes[k]) * (currentTime - time[k])
-						/ (time[k + 1] - time[k]);
-		break;
-	}
-
-	return f;
+std::vector<double> FluxHandler::getBreakpoints() const {
+	return amplitudeProfile.getTimes();
 }
 
 void FluxHandler::computeIncidentFlux(double currentTime, double *updatedConcOffset, int xi, int surfacePos) {
-	// Recompute the flux vector if a time profile is used
+	// Update the amplitude if a time profile is used, the profile is only
+	// searched when the time changes
 	if (useTimeProfile) {
-		fluxAmplitude = getProfileAmplitude(currentTime);
-		recomputeFluxHandler(surfacePos);
+		fluxAmplitude = amplitudeProfile.getValue(currentTime);
+	}
+
+	// Use the profile of the current position of the surface, it was computed
+	// when the surface was set there
+	if (surfacePos != currentSurfacePos) {
+		currentProfile = &incidentFluxProfiles[surfacePos];
+		currentSurfacePos = surfacePos;
 	}
 
 	// Update the concentration array
-	updatedConcOffset[fluxIndex] += incidentFluxVec[xi - surfacePos];
+	updatedConcOffset[fluxIndex] += fluxAmplitude * (*currentProfile)[xi - surfacePos];
 
 	return;
 }
@@ -5,6 +5,7 @@
 #include <vector>
 #include <memory>
 #include <Constants.h>
+#include <TimeProfile.h>
 
 namespace xolotlCore {
 
@@ -17,10 +18,18 @@ class FluxHandler: public IFluxHandler {
 protected:
 
 	/**
-	 * Vector to hold the incident flux values at each grid
-	 * point (x position).
+	 * The incident flux for a unit amplitude, for each position of the surface
+	 * and then for each grid point starting at the surface. A move of the
+	 * surface only changes the profile that is used, the profile of a
+	 * position is computed when the surface is set there the first time.
+	 */
+	std::vector<std::vector<double> > incidentFluxProfiles;
+
+	/**
+	 * The position of the surface at the last computed flux, and its profile.
 	 */
-	std::vector<double> incidentFluxVec;
+	int currentSurfacePos;
+	const std::vector<double> * currentProfile;
 
 	/**
 	 * Vector to hold the position at each grid
@@ -49,21 +58,10 @@ protected:
 	bool useTimeProfile;
 
 	/**
-	 * Value of the fit function integrated on the grid.
-	 */
-	double normFactor;
-
-	/**
-	 * Vector to hold the time read from the input
-	 * time profile file.
+	 * The amplitude read from the input time profile file as a function
+	 * of time.
 	 */
-	std::vector<double> time;
-
-	/**
-	 * Vector to hold the amplitude read from the input
-	 * time profile file.
-	 */
-	std::vector<double> amplitudes;
+	TimeProfile amplitudeProfile;
 
 	/**
 	 * Function that calculates the flux at a given position x (in nm).
@@ -76,23 +74,6 @@ protected:
 		return 0.0;
 	}
 
-	/**
-	 * This method returns the value of the helium incident flux amplitude at the
-	 * given time when a time profile is used.
-	 *
-	 * @param currentTime The time
-	 * @return The value of the helium flux at this time
-	 */
-	double getProfileAmplitude(double currentTime) const;
-
-	/**
-	 * This method recomputes the values of the incident flux vector when
-	 * a time profile is given.
-	 *
-	 * @param surfacePos The current position of the surface
-	 */
-	void recomputeFluxHandler(int surfacePos);
-
 public:
 
 	FluxHandler();
@@ -107,6 +88,14 @@ public:
 	virtual void initializeFluxHandler(IReactionNetwork *network,
 			int surfacePos, std::vector<double> grid);
 
+	/**
+	 * This method computes the incident flux profile for a unit amplitude when
+	 * the surface is at the given position, if it was not done yet. The fit
+	 * function is normalized by its integral on the grid.
+	 * \see IFluxHandler.h
+	 */
+	virtual void setSurfacePosition(int surfacePos);
+
 	/**
 	 * This method reads the values on the time profile file and store them in the
 	 * time and amplitude vectors.
@@ -114,6 +103,12 @@ public:
 	 */
 	virtual void initializeTimeProfile(const std::string& fileName);
 
+	/**
+	 * This method returns the times of the time profile file.
+	 * \see IFluxHandler.h
+	 */
+	virtual std::vector<double> getBreakpoints() const;
+
 	/**
 	 * This operation computes the flux due to incoming particles at a given grid point.
 	 * \see IFluxHandler.h
@@ -30,6 +30,15 @@ namespace xolotlCore
    initializeFluxHandler( IReactionNetwork* network,
                           int surfacePos, std::vector<double> grid ) = 0;
 		
+/**
+ * This method prepares the incident flux for a new position of the surface,
+ * so that computing the flux there does not allocate anything.
+ *
+ * @param surfacePos The new position of the surface
+ */
+   virtual void 
+   setSurfacePosition( int surfacePos ) = 0;
+
 /**
  * This method reads the values on the time profile file and store them in the
  * time and amplitude vectors.
@@ -39,6 +48,15 @@ namespace xolotlCore
    virtual void 
    initializeTimeProfile( const std::string& fileName ) = 0;
 
+/**
+ * This method returns the times at which the amplitude of the flux is not
+ * smooth, the time stepping should land on them.
+ *
+ * @return The times of the time profile, empty without one
+ */
+   virtual std::vector<double> 
+   getBreakpoints() const = 0;
+
 /**
  * This operation computes the flux due to incoming particles at a given grid point.
  *
@@ -46,7 +64,8 @@ namespace xolotlCore
  * @param updatedConcOffset The pointer to the array of the concentration at the grid
  * point where the diffusion is computed used to find the next solution
  * @param ix The position on the x grid
- * @param surfacePos The current position of the surface
+ * @param surfacePos The current position of the surface, it must have been set
+ * with setSurfacePosition() or initializeFluxHandler()
  */
    virtual void 
    computeIncidentFlux( double currentTime, double* updatedConcOffset, 
@@ -0,0 +1,378 @@
+#include "HDF5RestartReader.h"
+#include <mpi.h>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+
+using namespace xolotlCore;
+
+HDF5RestartReader::HDF5RestartReader(const std::string& fileName) :
+		subGroupId(-1), lastTimeStep(-1), nx(0), ny(0), nz(0), hx(0.0), hy(
+				0.0), hz(0.0), time(0.0), deltaTime(0.0), previousTime(0.0) {
+	// Set up file access property list with parallel I/O access
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
+
+	// Open the given HDF5 file with read only access
+	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	H5Pclose(propertyListId);
+	if (fileId < 0)
+		throw std::string(
+				"HDF5RestartReader Exception: Unable to open " + fileName);
+
+	// Read the header
+	hid_t groupId = H5Gopen(fileId, "/headerGroup", H5P_DEFAULT);
+	hid_t attributeId = H5Aopen(groupId, "nx", H5P_DEFAULT);
+	H5Aread(attributeId, H5T_STD_I32LE, &nx);
+	H5Aclose(attributeId);
+	attributeId = H5Aopen(groupId, "hx", H5P_DEFAULT);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &hx);
+	H5Aclose(attributeId);
+	attributeId = H5Aopen(groupId, "ny", H5P_DEFAULT);
+	H5Aread(attributeId, H5T_STD_I32LE, &ny);
+	H5Aclose(attributeId);
+	attributeId = H5Aopen(groupId, "hy", H5P_DEFAULT);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &hy);
+	H5Aclose(attributeId);
+	attributeId = H5Aopen(groupId, "nz", H5P_DEFAULT);
+	H5Aread(attributeId, H5T_STD_I32LE, &nz);
+	H5Aclose(attributeId);
+	attributeId = H5Aopen(groupId, "hz", H5P_DEFAULT);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &hz);
+	H5Aclose(attributeId);
+	H5Gclose(groupId);
+
+	// Nothing else to read if the concentrations were never written
+	if (H5Lexists(fileId, "/concentrationsGroup", H5P_DEFAULT) <= 0)
+		return;
+
+	// Read the last written time step
+	groupId = H5Gopen(fileId, "/concentrationsGroup", H5P_DEFAULT);
+	attributeId = H5Aopen(groupId, "lastTimeStep", H5P_DEFAULT);
+	H5Aread(attributeId, H5T_STD_I32LE, &lastTimeStep);
+	H5Aclose(attributeId);
+	H5Gclose(groupId);
+	if (lastTimeStep < 0)
+		return;
+
+	// Open the sub group of the last time step, it stays open until the
+	// concentrations are read
+	std::stringstream subGroupName;
+	subGroupName << "concentrationsGroup/concentration_" << lastTimeStep;
+	subGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
+
+	// Read the times
+	attributeId = H5Aopen(subGroupId, "absoluteTime", H5P_DEFAULT);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &time);
+	H5Aclose(attributeId);
+	attributeId = H5Aopen(subGroupId, "deltaTime", H5P_DEFAULT);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &deltaTime);
+	H5Aclose(attributeId);
+	attributeId = H5Aopen(subGroupId, "previousTime", H5P_DEFAULT);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &previousTime);
+	H5Aclose(attributeId);
+
+	// Read the surface information, all the quantities have the same shape
+	std::vector<hsize_t> dims;
+	readSurfaceQuantity("iSurface", H5T_NATIVE_INT, surface, surfaceDims);
+	readSurfaceQuantity("nInterstitial", H5T_NATIVE_DOUBLE, nInterstitial,
+			dims);
+	readSurfaceQuantity("previousIFlux", H5T_NATIVE_DOUBLE, previousIFlux,
+			dims);
+
+	return;
+}
+
+HDF5RestartReader::~HDF5RestartReader() {
+	// Close everything
+	if (subGroupId >= 0)
+		H5Gclose(subGroupId);
+	if (fileId >= 0)
+		H5Fclose(fileId);
+}
+
+template<typename T>
+void HDF5RestartReader::readSurfaceQuantity(const char* name, hid_t memType,
+		std::vector<T>& values, std::vector<hsize_t>& dims) {
+	values.clear();
+	dims.clear();
+
+	// 1D: scalar attribute
+	if (H5Aexists(subGroupId, name) > 0) {
+		values.resize(1);
+		hid_t attributeId = H5Aopen(subGroupId, name, H5P_DEFAULT);
+		H5Aread(attributeId, memType, values.data());
+		H5Aclose(attributeId);
+		return;
+	}
+
+	// 2D and 3D: dataset
+	if (H5Lexists(subGroupId, name, H5P_DEFAULT) <= 0)
+		return;
+	hid_t datasetId = H5Dopen(subGroupId, name, H5P_DEFAULT);
+	hid_t dataspaceId = H5Dget_space(datasetId);
+	dims.resize(H5Sget_simple_extent_ndims(dataspaceId));
+	H5Sget_simple_extent_dims(dataspaceId, dims.data(), NULL);
+	values.resize(H5Sget_simple_extent_npoints(dataspaceId));
+	H5Dread(datasetId, memType, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+	H5Sclose(dataspaceId);
+	H5Dclose(datasetId);
+
+	return;
+}
+
+void HDF5RestartReader::getHeader(int &nx, double &hx, int &ny, double &hy,
+		int &nz, double &hz) const {
+	nx = this->nx, hx = this->hx;
+	ny = this->ny, hy = this->hy;
+	nz = this->nz, hz = this->hz;
+
+	return;
+}
+
+void HDF5RestartReader::getTimes(double &time, double &deltaTime) const {
+	time = this->time;
+	deltaTime = this->deltaTime;
+
+	return;
+}
+
+int HDF5RestartReader::getSurface1D() const {
+	return surface.empty() ? 0 : surface[0];
+}
+
+std::vector<int> HDF5RestartReader::getSurface2D() const {
+	return surface;
+}
+
+std::vector<std::vector<int> > HDF5RestartReader::getSurface3D() const {
+	std::vector<std::vector<int> > toReturn;
+	if (surfaceDims.size() < 2)
+		return toReturn;
+	for (hsize_t i = 0; i < surfaceDims[0]; i++) {
+		toReturn.push_back(
+				std::vector<int>(surface.begin() + i * surfaceDims[1],
+						surface.begin() + (i + 1) * surfaceDims[1]));
+	}
+
+	return toReturn;
+}
+
+double HDF5RestartReader::getNInterstitial1D() const {
+	return nInterstitial.empty() ? 0.0 : nInterstitial[0];
+}
+
+std::vector<double> HDF5RestartReader::getNInterstitial2D() const {
+	return nInterstitial;
+}
+
+std::vector<std::vector<double> > HDF5RestartReader::getNInterstitial3D() const {
+	std::vector<std::vector<double> > toReturn;
+	if (surfaceDims.size() < 2)
+		return toReturn;
+	for (hsize_t i = 0; i < surfaceDims[0]; i++) {
+		toReturn.push_back(
+				std::vector<double>(nInterstitial.begin() + i * surfaceDims[1],
+						nInterstitial.begin() + (i + 1) * surfaceDims[1]));
+	}
+
+	return toReturn;
+}
+
+double HDF5RestartReader::getPreviousIFlux1D() const {
+	return previousIFlux.empty() ? 0.0 : previousIFlux[0];
+}
+
+std::vector<double> HDF5RestartReader::getPreviousIFlux2D() const {
+	return previousIFlux;
+}
+
+std::vector<std::vector<double> > HDF5RestartReader::getPreviousIFlux3D() const {
+	std::vector<std::vector<double> > toReturn;
+	if (surfaceDims.size() < 2)
+		return toReturn;
+	for (hsize_t i = 0; i < surfaceDims[0]; i++) {
+		toReturn.push_back(
+				std::vector<double>(previousIFlux.begin() + i * surfaceDims[1],
+						previousIFlux.begin() + (i + 1) * surfaceDims[1]));
+	}
+
+	return toReturn;
+}
+
+void HDF5RestartReader::readConcentrations(std::vector<double>& concArray,
+		std::vector<int>& concSizes, int xs, int xm, int ys, int ym, int zs,
+		int zm) {
+	concArray.clear();
+	concSizes.clear();
+	if (subGroupId < 0)
+		return;
+
+	// Files with one dataset per grid point are read point by point
+	if (H5Lexists(subGroupId, "concOffsets", H5P_DEFAULT) <= 0) {
+		readGridPoints(concArray, concSizes, xs, xm, ys, ym, zs, zm);
+		return;
+	}
+
+	// Create property list for collective dataset read
+	hid_t xferListId = H5Pcreate(H5P_DATASET_XFER);
+	H5Pset_dxpl_mpio(xferListId, H5FD_MPIO_COLLECTIVE);
+
+	// Open the offsets dataset, it has the shape of the grid
+	hid_t datasetId = H5Dopen(subGroupId, "concOffsets", H5P_DEFAULT);
+	hid_t dataspaceId = H5Dget_space(datasetId);
+	int rank = H5Sget_simple_extent_ndims(dataspaceId);
+	if ((rank > 2 && ys < 0) || (rank > 3 && zs < 0))
+		throw std::string(
+				"HDF5RestartReader Exception: The restart file doesn't have "
+						"the same number of dimensions as the simulation.");
+
+	// Select the local part of the grid
+	hsize_t start[4], count[4];
+	int n = 0;
+	if (rank > 3)
+		start[n] = zs, count[n] = zm, n++;
+	if (rank > 2)
+		start[n] = ys, count[n] = ym, n++;
+	start[n] = xs, count[n] = xm, n++;
+	start[n] = 0, count[n] = 2;
+	int nPoints = xm * ym * zm;
+	std::vector<long long> offsetArray(2 * nPoints);
+	hid_t memspaceId = H5Screate_simple(rank, count, NULL);
+	if (nPoints == 0) {
+		H5Sselect_none(dataspaceId);
+		H5Sselect_none(memspaceId);
+	}
+	else {
+		H5Sselect_hyperslab(dataspaceId, H5S_SELECT_SET, start, NULL, count,
+				NULL);
+	}
+	H5Dread(datasetId, H5T_NATIVE_LLONG, memspaceId, dataspaceId, xferListId,
+			offsetArray.data());
+	H5Sclose(memspaceId);
+	H5Sclose(dataspaceId);
+	H5Dclose(datasetId);
+
+	// Group the local grid points in blocks that are contiguous in the
+	// file: (position in the file, number of pairs, position in concArray)
+	std::vector<std::vector<long long> > blocks;
+	long long localSize = 0;
+	for (int i = 0; i < nPoints; i++) {
+		long long position = offsetArray[2 * i], size = offsetArray[2 * i + 1];
+		concSizes.push_back(size);
+		if (size == 0)
+			continue;
+		if (!blocks.empty()
+				&& blocks.back()[0] + blocks.back()[1] == position) {
+			blocks.back()[1] += size;
+		}
+		else {
+			blocks.push_back( { position, size, localSize });
+		}
+		localSize += size;
+	}
+
+	// HDF5 transfers the selected elements in the order of the file
+	std::sort(blocks.begin(), blocks.end());
+
+	// Older files store the pairs as doubles in a single dataset
+	bool pairs = H5Lexists(subGroupId, "concIndices", H5P_DEFAULT) <= 0;
+	int width = pairs ? 2 : 1;
+
+	// Select all the blocks, only the first dimension is used by the one
+	// dimensional datasets
+	datasetId = H5Dopen(subGroupId, pairs ? "concs" : "concIndices",
+			H5P_DEFAULT);
+	dataspaceId = H5Dget_space(datasetId);
+	H5Sselect_none(dataspaceId);
+	for (unsigned int i = 0; i < blocks.size(); i++) {
+		hsize_t concStart[2] = { (hsize_t) blocks[i][0], 0 };
+		hsize_t concCount[2] = { (hsize_t) blocks[i][1], 2 };
+		H5Sselect_hyperslab(dataspaceId, H5S_SELECT_OR, concStart, NULL,
+				concCount, NULL);
+	}
+	hsize_t memDims[2] = { (hsize_t) localSize, 2 };
+	memspaceId = H5Screate_simple(width, memDims, NULL);
+	if (localSize == 0)
+		H5Sselect_none(memspaceId);
+
+	// Read them, the values are read with the same selection when they are
+	// in their own dataset
+	std::vector<double> buffer(2 * localSize);
+	if (pairs) {
+		H5Dread(datasetId, H5T_NATIVE_DOUBLE, memspaceId, dataspaceId,
+				xferListId, buffer.data());
+	}
+	else {
+		std::vector<int> indexBuffer(localSize);
+		H5Dread(datasetId, H5T_NATIVE_INT, memspaceId, dataspaceId,
+				xferListId, indexBuffer.data());
+		H5Dclose(datasetId);
+		datasetId = H5Dopen(subGroupId, "concValues", H5P_DEFAULT);
+		std::vector<double> valueBuffer(localSize);
+		H5Dread(datasetId, H5T_NATIVE_DOUBLE, memspaceId, dataspaceId,
+				xferListId, valueBuffer.data());
+		for (long long l = 0; l < localSize; l++) {
+			buffer[2 * l] = (double) indexBuffer[l];
+			buffer[2 * l + 1] = valueBuffer[l];
+		}
+	}
+
+	// Put them back in the grid order
+	concArray.resize(2 * localSize);
+	long long bufferPosition = 0;
+	for (unsigned int i = 0; i < blocks.size(); i++) {
+		std::memcpy(concArray.data() + 2 * blocks[i][2],
+				buffer.data() + 2 * bufferPosition,
+				2 * blocks[i][1] * sizeof(double));
+		bufferPosition += blocks[i][1];
+	}
+
+	// Close everything
+	H5Sclose(memspaceId);
+	H5Sclose(dataspaceId);
+	H5Dclose(datasetId);
+	H5Pclose(xferListId);
+
+	return;
+}
+
+void HDF5RestartReader::readGridPoints(std::vector<double>& concArray,
+		std::vector<int>& concSizes, int xs, int xm, int ys, int ym, int zs,
+		int zm) {
+	// Loop on the local grid points
+	for (int k = zs; k < zs + zm; k++) {
+		for (int j = ys; j < ys + ym; j++) {
+			for (int i = xs; i < xs + xm; i++) {
+				// Set the dataset name
+				std::stringstream datasetName;
+				datasetName << "position_" << i << "_" << j << "_" << k;
+
+				// The dataset doesn't exist if there was no concentration
+				if (H5Lexists(subGroupId, datasetName.str().c_str(),
+						H5P_DEFAULT) <= 0) {
+					concSizes.push_back(0);
+					continue;
+				}
+
+				// Read the whole dataset
+				hid_t datasetId = H5Dopen(subGroupId, datasetName.str().c_str(),
+						H5P_DEFAULT);
+				hid_t dataspaceId = H5Dget_space(datasetId);
+				hsize_t dims[2];
+				H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
+				int size = concArray.size();
+				concArray.resize(size + 2 * dims[0]);
+				H5Dread(datasetId, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL,
+						H5P_DEFAULT, concArray.data() + size);
+				concSizes.push_back(dims[0]);
+
+				// Close everything
+				H5Sclose(dataspaceId);
+				H5Dclose(datasetId);
+			}
+		}
+	}
+
+	return;
+}
@@ -0,0 +1,221 @@
+#ifndef HDF5RESTARTREADER_H
+#define HDF5RESTARTREADER_H
+
+#include <hdf5.h>
+#include <string>
+#include <vector>
+
+namespace xolotlCore {
+
+/**
+ * This class reads everything that is needed to restart a simulation from
+ * an HDF5 file. The file is opened only once with parallel I/O access,
+ * the header and the information of the last written time step (times,
+ * surface positions, interstitial quantities) are read when the reader is
+ * created, and each process then reads only the concentrations of the grid
+ * points it owns.
+ *
+ * All the processes must create the reader and call readConcentrations()
+ * collectively.
+ */
+class HDF5RestartReader {
+
+private:
+
+	//! The HDF5 file
+	hid_t fileId;
+
+	//! The concentration sub group of the last written time step
+	hid_t subGroupId;
+
+	//! The last written time step, negative if there is none
+	int lastTimeStep;
+
+	//! The number of grid points and step size in each direction
+	int nx, ny, nz;
+	double hx, hy, hz;
+
+	//! The times of the last written time step
+	double time, deltaTime, previousTime;
+
+	//! The surface positions, flattened, and their dimensions
+	std::vector<int> surface;
+	std::vector<hsize_t> surfaceDims;
+
+	//! The interstitial quantities at the surface, flattened
+	std::vector<double> nInterstitial;
+
+	//! The previous interstitial fluxes at the surface, flattened
+	std::vector<double> previousIFlux;
+
+	/**
+	 * Read a quantity of the sub group stored as a scalar attribute (1D)
+	 * or as a dataset (2D and 3D).
+	 *
+	 * @param name The name of the quantity
+	 * @param memType The HDF5 type to read it as
+	 * @param values The flattened values
+	 * @param dims The dimensions, empty for a scalar
+	 */
+	template<typename T>
+	void readSurfaceQuantity(const char* name, hid_t memType,
+			std::vector<T>& values, std::vector<hsize_t>& dims);
+
+	/**
+	 * Read the concentrations of the local grid points from a file with one
+	 * dataset per grid point.
+	 */
+	void readGridPoints(std::vector<double>& concArray,
+			std::vector<int>& concSizes, int xs, int xm, int ys, int ym,
+			int zs, int zm);
+
+public:
+
+	/**
+	 * The constructor opens the file and reads the header and the
+	 * information of the last written time step.
+	 *
+	 * @param fileName The name of the file to read from
+	 */
+	HDF5RestartReader(const std::string& fileName);
+
+	/**
+	 * The destructor closes the file.
+	 */
+	~HDF5RestartReader();
+
+	/**
+	 * Get the number of points and step size in each direction.
+	 *
+	 * @param nx The number of grid points in the x direction (depth)
+	 * @param hx The step size in the x direction
+	 * @param ny The number of grid points in the y direction
+	 * @param hy The step size in the y direction
+	 * @param nz The number of grid points in the z direction
+	 * @param hz The step size in the z direction
+	 */
+	void getHeader(int &nx, double &hx, int &ny, double &hy, int &nz,
+			double &hz) const;
+
+	/**
+	 * To know if concentrations were written in the file.
+	 *
+	 * @return True if there is a valid concentration sub group
+	 */
+	bool hasConcentrations() const {
+		return lastTimeStep >= 0;
+	}
+
+	/**
+	 * Get the last written time step.
+	 *
+	 * @return The last time step
+	 */
+	int getLastTimeStep() const {
+		return lastTimeStep;
+	}
+
+	/**
+	 * Get the time information of the last written time step.
+	 *
+	 * @param time The absolute time
+	 * @param deltaTime The time step length
+	 */
+	void getTimes(double &time, double &deltaTime) const;
+
+	/**
+	 * Get the previous time of the last written time step.
+	 *
+	 * @return The previous time
+	 */
+	double getPreviousTime() const {
+		return previousTime;
+	}
+
+	/**
+	 * Get the surface position in 1D.
+	 *
+	 * @return The index of the surface position
+	 */
+	int getSurface1D() const;
+
+	/**
+	 * Get the surface positions in 2D.
+	 *
+	 * @return The indices of the surface position for each y
+	 */
+	std::vector<int> getSurface2D() const;
+
+	/**
+	 * Get the surface positions in 3D.
+	 *
+	 * @return The indices of the surface position for each (y, z)
+	 */
+	std::vector<std::vector<int> > getSurface3D() const;
+
+	/**
+	 * Get the interstitial quantity at the surface in 1D.
+	 *
+	 * @return The quantity of interstitial
+	 */
+	double getNInterstitial1D() const;
+
+	/**
+	 * Get the interstitial quantities at the surface in 2D.
+	 *
+	 * @return The quantity of interstitial for each y
+	 */
+	std::vector<double> getNInterstitial2D() const;
+
+	/**
+	 * Get the interstitial quantities at the surface in 3D.
+	 *
+	 * @return The quantity of interstitial for each (y, z)
+	 */
+	std::vector<std::vector<double> > getNInterstitial3D() const;
+
+	/**
+	 * Get the previous interstitial flux at the surface in 1D.
+	 *
+	 * @return The previous flux
+	 */
+	double getPreviousIFlux1D() const;
+
+	/**
+	 * Get the previous interstitial fluxes at the surface in 2D.
+	 *
+	 * @return The previous flux for each y
+	 */
+	std::vector<double> getPreviousIFlux2D() const;
+
+	/**
+	 * Get the previous interstitial fluxes at the surface in 3D.
+	 *
+	 * @return The previous flux for each (y, z)
+	 */
+	std::vector<std::vector<double> > getPreviousIFlux3D() const;
+
+	/**
+	 * Read the concentrations of the grid points owned by this process
+	 * at the last written time step. It must be called by all the processes.
+	 * The concentrations are returned in the format of
+	 * HDF5Utils::writeConcentrations().
+	 *
+	 * @param concArray The (index, concentration) pairs of the local grid
+	 * points, x being the fastest direction, then y, then z
+	 * @param concSizes The number of pairs of each local grid point
+	 * @param xs The first local grid point on the x direction
+	 * @param xm The number of local grid points on the x direction
+	 * @param ys The first local grid point on the y direction, -1 in 1D
+	 * @param ym The number of local grid points on the y direction
+	 * @param zs The first local grid point on the z direction, -1 in 1D
+	 * and 2D
+	 * @param zm The number of local grid points on the z direction
+	 */
+	void readConcentrations(std::vector<double>& concArray,
+			std::vector<int>& concSizes, int xs, int xm, int ys = -1,
+			int ym = 1, int zs = -1, int zm = 1);
+};
+
+} /* namespace xolotlCore */
+#endif
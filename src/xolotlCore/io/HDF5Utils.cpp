@@ -2,209 +2,241 @@
 #include <PSICluster.h>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <cstdlib>
 #include <hdf5.h>
 #include <mpi.h>
 
 using namespace xolotlCore;
 
-hid_t propertyListId, fileId, concentrationGroupId, subConcGroupId, concDataspaceId,
-	headerGroupId;
-herr_t status;
+namespace {
+
+//! The maximum number of elements in a chunk of the concentration datasets
+const hsize_t concChunkSize = 65536;
+
+//! The deflate level of the concentration datasets
+const unsigned int concDeflateLevel = 4;
+
+/**
+ * Create the creation property list of a one dimensional concentration
+ * dataset. It is chunked and compressed with the shuffle and deflate filters
+ * when they are available. Parallel HDF5 can only write filtered datasets
+ * collectively since 1.10.2.
+ *
+ * @param size The number of elements of the dataset
+ * @return The property list
+ */
+hid_t createConcentrationPropertyList(hsize_t size) {
+	hid_t plistId = H5Pcreate(H5P_DATASET_CREATE);
+#if H5_VERSION_GE(1, 10, 2)
+	if (size > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0
+			&& H5Zfilter_avail(H5Z_FILTER_SHUFFLE) > 0) {
+		hsize_t chunkDims[1] = { std::min(size, concChunkSize) };
+		H5Pset_chunk(plistId, 1, chunkDims);
+		H5Pset_shuffle(plistId);
+		H5Pset_deflate(plistId, concDeflateLevel);
+	}
+#endif
+
+	return plistId;
+}
+
+} /* end namespace */
+
+HDF5Utils::FileHandle HDF5Utils::initializeFile(const std::string& fileName,
+		MPI_Comm comm) {
+	// The handle of the new file
+	FileHandle file;
+	file.comm = comm;
 
-void HDF5Utils::initializeFile(const std::string& fileName) {
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
-	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	H5Pset_fapl_mpio(propertyListId, comm, MPI_INFO_NULL);
 
 	// Create the file
-	fileId = H5Fcreate(fileName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, propertyListId);
+	file.fileId = H5Fcreate(fileName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Create the group where the header will be stored
-	headerGroupId = H5Gcreate2(fileId, "headerGroup", H5P_DEFAULT, H5P_DEFAULT,
+	file.headerGroupId = H5Gcreate2(file.fileId, "headerGroup", H5P_DEFAULT, H5P_DEFAULT,
 	H5P_DEFAULT);
 
 	// Create the group where the concentrations will be stored
-	concentrationGroupId = H5Gcreate2(fileId, "concentrationsGroup", H5P_DEFAULT,
+	file.concGroupId = H5Gcreate2(file.fileId, "concentrationsGroup", H5P_DEFAULT,
 	H5P_DEFAULT, H5P_DEFAULT);
 
 	// Create, write, and close the last written time step attribute
 	int lastTimeStep = -1;
 	hid_t lastDataspaceId = H5Screate(H5S_SCALAR);
-	hid_t lastAttributeId = H5Acreate2(concentrationGroupId, "lastTimeStep", H5T_STD_I32LE,
+	hid_t lastAttributeId = H5Acreate2(file.concGroupId, "lastTimeStep", H5T_STD_I32LE,
 			lastDataspaceId,
 			H5P_DEFAULT, H5P_DEFAULT);
-	status = H5Awrite(lastAttributeId, H5T_STD_I32LE, &lastTimeStep);
+	H5Awrite(lastAttributeId, H5T_STD_I32LE, &lastTimeStep);
 
 	// Close everything
-	status = H5Aclose(lastAttributeId);
-	status = H5Sclose(lastDataspaceId);
+	H5Aclose(lastAttributeId);
+	H5Sclose(lastDataspaceId);
 
-	return;
+	return file;
 }
 
-void HDF5Utils::openFile(const std::string& fileName) {
+HDF5Utils::FileHandle HDF5Utils::openFile(const std::string& fileName,
+		MPI_Comm comm) {
+	// The handle of the opened file
+	FileHandle file;
+	file.comm = comm;
+
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
-	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	H5Pset_fapl_mpio(propertyListId, comm, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDWR, propertyListId);
+	file.fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDWR, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Open the concentration group
-	concentrationGroupId = H5Gopen(fileId, "concentrationsGroup", H5P_DEFAULT);
-	return;
+	file.concGroupId = H5Gopen(file.fileId, "concentrationsGroup", H5P_DEFAULT);
+	return file;
 }
 
-void HDF5Utils::fillHeader(int nx, double hx, int ny,
+void HDF5Utils::fillHeader(FileHandle& file, int nx, double hx, int ny,
 		double hy, int nz, double hz) {
 	// Create, write, and close the nx attribute
 	hid_t dataspaceId = H5Screate(H5S_SCALAR);
-	hid_t attributeId = H5Acreate2(headerGroupId, "nx", H5T_STD_I32LE,
+	hid_t attributeId = H5Acreate2(file.headerGroupId, "nx", H5T_STD_I32LE,
 			dataspaceId,
 			H5P_DEFAULT, H5P_DEFAULT);
-	status = H5Awrite(attributeId, H5T_STD_I32LE, &nx);
-	status = H5Aclose(attributeId);
+	H5Awrite(attributeId, H5T_STD_I32LE, &nx);
+	H5Aclose(attributeId);
 	// Create, write, and close the hx attribute
-	attributeId = H5Acreate2(headerGroupId, "hx", H5T_IEEE_F64LE,
+	attributeId = H5Acreate2(file.headerGroupId, "hx", H5T_IEEE_F64LE,
 			dataspaceId,
 			H5P_DEFAULT, H5P_DEFAULT);
-	status = H5Awrite(attributeId, H5T_IEEE_F64LE, &hx);
-	status = H5Aclose(attributeId);
+	H5Awrite(attributeId, H5T_IEEE_F64LE, &hx);
+	H5Aclose(attributeId);
 
 	// Create, write, and close the ny attribute
-	attributeId = H5Acreate2(headerGroupId, "ny", H5T_STD_I32LE,
+	attributeId = H5Acreate2(file.headerGroupId, "ny", H5T_STD_I32LE,
 			dataspaceId,
 			H5P_DEFAULT, H5P_DEFAULT);
-	status = H5Awrite(attributeId, H5T_STD_I32LE, &ny);
-	status = H5Aclose(attributeId);
+	H5Awrite(attributeId, H5T_STD_I32LE, &ny);
+	H5Aclose(attributeId);
 	// Create, write, and close the hy attribute
-	attributeId = H5Acreate2(headerGroupId, "hy", H5T_IEEE_F64LE,
+	attributeId = H5Acreate2(file.headerGroupId, "hy", H5T_IEEE_F64LE,
 			dataspaceId,
 			H5P_DEFAULT, H5P_DEFAULT);
-	status = H5Awrite(attributeId, H5T_IEEE_F64LE, &hy);
-	status = H5Aclose(attributeId);
+	H5Awrite(attributeId, H5T_IEEE_F64LE, &hy);
+	H5Aclose(attributeId);
 
 	// Create, write, and close the nz attribute
-	attributeId = H5Acreate2(headerGroupId, "nz", H5T_STD_I32LE,
+	attributeId = H5Acreate2(file.headerGroupId, "nz", H5T_STD_I32LE,
 			dataspaceId,
 			H5P_DEFAULT, H5P_DEFAULT);
-	status = H5Awrite(attributeId, H5T_STD_I32LE, &nz);
-	status = H5Aclose(attributeId);
+	H5Awrite(attributeId, H5T_STD_I32LE, &nz);
+	H5Aclose(attributeId);
 	// Create, write, and close the hz attribute
-	attributeId = H5Acreate2(headerGroupId, "hz", H5T_IEEE_F64LE,
+	attributeId = H5Acreate2(file.headerGroupId, "hz", H5T_IEEE_F64LE,
 			dataspaceId,
 			H5P_DEFAULT, H5P_DEFAULT);
-	status = H5Awrite(attributeId, H5T_IEEE_F64LE, &hz);
+	H5Awrite(attributeId, H5T_IEEE_F64LE, &hz);
 
 	// Close everything
-	status = H5Aclose(attributeId);
-	status = H5Sclose(dataspaceId);
+	H5Aclose(attributeId);
+	H5Sclose(dataspaceId);
 
 	return;
 }
 
-void HDF5Utils::fillNetwork(const std::string& fileName) {
-	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
-	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
-
-	// Open the given HDF5 file with read only access
-	hid_t fromFileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
-
-	// Close the property list
-	status = H5Pclose(propertyListId);
-
-	status = H5Ocopy(fromFileId, "/networkGroup", fileId, "/networkGroup",
-			H5P_DEFAULT, H5P_DEFAULT);
-
-	// Close the from file
-	status = H5Fclose(fromFileId);
+void HDF5Utils::fillNetwork(FileHandle& file, const std::string& fileName) {
+	// Link to the network group of the given file instead of copying it. A
+	// relative name would be resolved from the directory of the reader, so
+	// the absolute path of the file is stored.
+	std::string linkTarget = fileName;
+	char * absolutePath = realpath(fileName.c_str(), nullptr);
+	if (absolutePath) {
+		linkTarget = absolutePath;
+		free(absolutePath);
+	}
+	H5Lcreate_external(linkTarget.c_str(), "/networkGroup", file.fileId,
+			"networkGroup", H5P_DEFAULT, H5P_DEFAULT);
 
 	return;
 }
 
-void HDF5Utils::addConcentrationSubGroup(int timeStep, double time,
+void HDF5Utils::addConcentrationSubGroup(FileHandle& file, int timeStep, double time,
 		double previousTime, double deltaTime) {
 	// Set the name of the sub group
 	std::stringstream subGroupName;
 	subGroupName << "concentration_" << timeStep;
 
 	// Create the subgroup where the concentrations at this time step will be stored
-	subConcGroupId = H5Gcreate2(concentrationGroupId, subGroupName.str().c_str(),
+	file.subConcGroupId = H5Gcreate2(file.concGroupId, subGroupName.str().c_str(),
 			H5P_DEFAULT,
 			H5P_DEFAULT, H5P_DEFAULT);
 
 	// Create, write, and close the absolute time attribute
 	hid_t dataspaceId = H5Screate(H5S_SCALAR);
-	hid_t attributeId = H5Acreate2(subConcGroupId, "absoluteTime", H5T_IEEE_F64LE,
+	hid_t attributeId = H5Acreate2(file.subConcGroupId, "absoluteTime", H5T_IEEE_F64LE,
 			dataspaceId,
 			H5P_DEFAULT, H5P_DEFAULT);
-	status = H5Awrite(attributeId, H5T_IEEE_F64LE, &time);
-	status = H5Aclose(attributeId);
+	H5Awrite(attributeId, H5T_IEEE_F64LE, &time);
+	H5Aclose(attributeId);
 
 	// Create, write, and close the previous time attribute
-	attributeId = H5Acreate2(subConcGroupId, "previousTime", H5T_IEEE_F64LE,
+	attributeId = H5Acreate2(file.subConcGroupId, "previousTime", H5T_IEEE_F64LE,
 			dataspaceId,
 			H5P_DEFAULT, H5P_DEFAULT);
-	status = H5Awrite(attributeId, H5T_IEEE_F64LE, &previousTime);
-	status = H5Aclose(attributeId);
+	H5Awrite(attributeId, H5T_IEEE_F64LE, &previousTime);
+	H5Aclose(attributeId);
 
 	// Create, write, and close the timestep time attribute
-	attributeId = H5Acreate2(subConcGroupId, "deltaTime", H5T_IEEE_F64LE,
+	attributeId = H5Acreate2(file.subConcGroupId, "deltaTime", H5T_IEEE_F64LE,
 			dataspaceId,
 			H5P_DEFAULT, H5P_DEFAULT);
-	status = H5Awrite(attributeId, H5T_IEEE_F64LE, &deltaTime);
-	status = H5Aclose(attributeId);
-	status = H5Sclose(dataspaceId);
+	H5Awrite(attributeId, H5T_IEEE_F64LE, &deltaTime);
+	H5Aclose(attributeId);
+	H5Sclose(dataspaceId);
 
 	// Overwrite the last time step attribute of the concentration group
-	attributeId = H5Aopen(concentrationGroupId, "lastTimeStep", H5P_DEFAULT);
-	status = H5Awrite(attributeId, H5T_STD_I32LE, &timeStep);
-	status = H5Aclose(attributeId);
-
-	// Create property list for independent dataset write
-	// (needed to be able to write the datasets without having
-	// HDF5 screaming).
-	propertyListId = H5Pcreate(H5P_DATASET_XFER);
-	status = H5Pset_dxpl_mpio(propertyListId, H5FD_MPIO_INDEPENDENT);
+	attributeId = H5Aopen(file.concGroupId, "lastTimeStep", H5P_DEFAULT);
+	H5Awrite(attributeId, H5T_STD_I32LE, &timeStep);
+	H5Aclose(attributeId);
 
 	return;
 }
 
-void HDF5Utils::writeSurface1D(int timeStep, int iSurface,
+void HDF5Utils::writeSurface1D(FileHandle& file, int timeStep, int iSurface,
 		double nInter, double previousFlux) {
 	// Create, write, and close the surface position attribute
 	hid_t dataspaceId = H5Screate(H5S_SCALAR);
-	hid_t attributeId = H5Acreate2(subConcGroupId, "iSurface", H5T_STD_I32LE,
+	hid_t attributeId = H5Acreate2(file.subConcGroupId, "iSurface", H5T_STD_I32LE,
 			dataspaceId, H5P_DEFAULT, H5P_DEFAULT);
-	status = H5Awrite(attributeId, H5T_STD_I32LE, &iSurface);
-	status = H5Aclose(attributeId);
+	H5Awrite(attributeId, H5T_STD_I32LE, &iSurface);
+	H5Aclose(attributeId);
 
 	// Create, write, and close the quantity of interstitial attribute
-	attributeId = H5Acreate2(subConcGroupId, "nInterstitial", H5T_IEEE_F64LE,
+	attributeId = H5Acreate2(file.subConcGroupId, "nInterstitial", H5T_IEEE_F64LE,
 			dataspaceId, H5P_DEFAULT, H5P_DEFAULT);
-	status = H5Awrite(attributeId, H5T_IEEE_F64LE, &nInter);
-	status = H5Aclose(attributeId);
+	H5Awrite(attributeId, H5T_IEEE_F64LE, &nInter);
+	H5Aclose(attributeId);
 
 	// Create, write, and close the flux of interstitial attribute
-	attributeId = H5Acreate2(subConcGroupId, "previousIFlux", H5T_IEEE_F64LE,
+	attributeId = H5Acreate2(file.subConcGroupId, "previousIFlux", H5T_IEEE_F64LE,
 			dataspaceId, H5P_DEFAULT, H5P_DEFAULT);
-	status = H5Awrite(attributeId, H5T_IEEE_F64LE, &previousFlux);
-	status = H5Aclose(attributeId);
+	H5Awrite(attributeId, H5T_IEEE_F64LE, &previousFlux);
+	H5Aclose(attributeId);
 
 	// Close the dataspace
-	status = H5Sclose(dataspaceId);
+	H5Sclose(dataspaceId);
 
 	return;
 }
 
-void HDF5Utils::writeSurface2D(int timeStep, std::vector<int> iSurface,
+void HDF5Utils::writeSurface2D(FileHandle& file, int timeStep, std::vector<int> iSurface,
 		std::vector<double> nInter, std::vector<double> previousFlux) {
 	// Create the array that will store the indices and fill it
 	int size = iSurface.size();
@@ -219,15 +251,15 @@ void HDF5Utils::writeSurface2D(int timeStep, std::vector<int> iSurface,
 	hid_t dataspaceId = H5Screate_simple(1, dims, NULL);
 
 	// Create the dataset for the surface indices
-	hid_t datasetId = H5Dcreate2(subConcGroupId, "iSurface", H5T_STD_I32LE,
+	hid_t datasetId = H5Dcreate2(file.subConcGroupId, "iSurface", H5T_STD_I32LE,
 			dataspaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
 
 	// Write networkArray in the dataset
-	status = H5Dwrite(datasetId, H5T_STD_I32LE, H5S_ALL, H5S_ALL,
+	H5Dwrite(datasetId, H5T_STD_I32LE, H5S_ALL, H5S_ALL,
 	H5P_DEFAULT, &indexArray);
 
 	// Close the dataset
-	status = H5Dclose(datasetId);
+	H5Dclose(datasetId);
 
 	// Create the array that will store the quantities and fill it
 	double quantityArray[size];
@@ -236,15 +268,15 @@ void HDF5Utils::writeSurface2D(int timeStep, std::vector<int> iSurface,
 	}
 
 	// Create the dataset for the surface indices
-	datasetId = H5Dcreate2(subConcGroupId, "nInterstitial", H5T_IEEE_F64LE,
+	datasetId = H5Dcreate2(file.subConcGroupId, "nInterstitial", H5T_IEEE_F64LE,
 			dataspaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
 
 	// Write networkArray in the dataset
-	status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+	H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
 	H5P_DEFAULT, &quantityArray);
 
 	// Close the dataset
-	status = H5Dclose(datasetId);
+	H5Dclose(datasetId);
 
 	// Fill the array with the previous flux
 	for (int i = 0; i < size; i++) {
@@ -252,21 +284,21 @@ void HDF5Utils::writeSurface2D(int timeStep, std::vector<int> iSurface,
 	}
 
 	// Create the dataset for the surface indices
-	datasetId = H5Dcreate2(subConcGroupId, "previousIFlux", H5T_IEEE_F64LE,
+	datasetId = H5Dcreate2(file.subConcGroupId, "previousIFlux", H5T_IEEE_F64LE,
 			dataspaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
 
 	// Write networkArray in the dataset
-	status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+	H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
 	H5P_DEFAULT, &quantityArray);
 
 	// Close everything
-	status = H5Dclose(datasetId);
-	status = H5Sclose(dataspaceId);
+	H5Dclose(datasetId);
+	H5Sclose(dataspaceId);
 
 	return;
 }
 
-void HDF5Utils::writeSurface3D(int timeStep, std::vector< std::vector<int> > iSurface,
+void HDF5Utils::writeSurface3D(FileHandle& file, int timeStep, std::vector< std::vector<int> > iSurface,
 		std::vector< std::vector<double> > nInter,
 		std::vector< std::vector<double> > previousFlux) {
 	// Create the array that will store the indices and fill it
@@ -286,13 +318,13 @@ void HDF5Utils::writeSurface3D(int timeStep, std::vector< std::vector<int> > iSu
 	hid_t dataspaceId = H5Screate_simple(2, dims, NULL);
 
 	// Create the dataset for the surface indices
-	hid_t datasetId = H5Dcreate2(subConcGroupId, "iSurface", H5T_STD_I32LE,
+	hid_t datasetId = H5Dcreate2(file.subConcGroupId, "iSurface", H5T_STD_I32LE,
 			dataspaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
 	// Write in the dataset
-	status = H5Dwrite(datasetId, H5T_STD_I32LE, H5S_ALL, H5S_ALL,
+	H5Dwrite(datasetId, H5T_STD_I32LE, H5S_ALL, H5S_ALL,
 	H5P_DEFAULT, &indexArray);
 	// Close the dataset
-	status = H5Dclose(datasetId);
+	H5Dclose(datasetId);
 
 	// Create the array that will store the interstitial quantities and fill it
 	double quantityArray[xSize][ySize];
@@ -303,13 +335,13 @@ void HDF5Utils::writeSurface3D(int timeStep, std::vector< std::vector<int> > iSu
 	}
 
 	// Create the dataset for the interstitial quantities
-	datasetId = H5Dcreate2(subConcGroupId, "nInterstitial", H5T_IEEE_F64LE,
+	datasetId = H5Dcreate2(file.subConcGroupId, "nInterstitial", H5T_IEEE_F64LE,
 			dataspaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
 	// Write in the dataset
-	status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+	H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
 	H5P_DEFAULT, &quantityArray);
 	// Close the dataset
-	status = H5Dclose(datasetId);
+	H5Dclose(datasetId);
 
 	// Fill the array that will store the interstitial flux
 	for (int i = 0; i < xSize; i++) {
@@ -319,21 +351,21 @@ void HDF5Utils::writeSurface3D(int timeStep, std::vector< std::vector<int> > iSu
 	}
 
 	// Create the dataset for the interstitial quantities
-	datasetId = H5Dcreate2(subConcGroupId, "previousIFlux", H5T_IEEE_F64LE,
+	datasetId = H5Dcreate2(file.subConcGroupId, "previousIFlux", H5T_IEEE_F64LE,
 			dataspaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
 	// Write in the dataset
-	status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+	H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
 	H5P_DEFAULT, &quantityArray);
 	// Close the dataset
-	status = H5Dclose(datasetId);
+	H5Dclose(datasetId);
 
 	// Close the dataspace
-	status = H5Sclose(dataspaceId);
+	H5Sclose(dataspaceId);
 
 	return;
 }
 
-void HDF5Utils::addConcentrationDataset(int size, int i, int j, int k) {
+void HDF5Utils::addConcentrationDataset(FileHandle& file, int size, int i, int j, int k) {
 	// Set the dataset name
 	std::stringstream datasetName;
 	datasetName << "position_" << i << "_" << j << "_" << k;
@@ -342,26 +374,23 @@ void HDF5Utils::addConcentrationDataset(int size, int i, int j, int k) {
 	hsize_t dims[2];
 	dims[0] = size;
 	dims[1] = 2;
-	concDataspaceId = H5Screate_simple(2, dims, NULL);
+	hid_t concDataspaceId = H5Screate_simple(2, dims, NULL);
 
 	// Create the dataset of concentrations for this position
-	hid_t datasetId = H5Dcreate2(subConcGroupId, datasetName.str().c_str(),
+	hid_t datasetId = H5Dcreate2(file.subConcGroupId, datasetName.str().c_str(),
 	H5T_IEEE_F64LE, concDataspaceId,
 	H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
 
-	// Create property list for independent dataset write.
-	propertyListId = H5Pcreate(H5P_DATASET_XFER);
-	status = H5Pset_dxpl_mpio(propertyListId, H5FD_MPIO_INDEPENDENT);
-
 	// Close everything
-	status = H5Sclose(concDataspaceId);
-	status = H5Dclose(datasetId);
+	H5Sclose(concDataspaceId);
+	H5Dclose(datasetId);
 
 	return;
 }
 
-void HDF5Utils::fillConcentrations(const std::vector<std::vector<double> >& concVector,
-		int i, int j, int k) {
+void HDF5Utils::fillConcentrations(FileHandle& file,
+		const std::vector<std::vector<double> >& concVector, int i, int j,
+		int k) {
 	// Create the concentration array
 	double concArray[concVector.size()][2];
 
@@ -376,34 +405,153 @@ void HDF5Utils::fillConcentrations(const std::vector<std::vector<double> >& conc
 	datasetName << "position_" << i << "_" << j << "_" << k;
 
 	// Open the already created dataset of concentrations for this position
-	hid_t datasetId = H5Dopen(subConcGroupId, datasetName.str().c_str(),
+	hid_t datasetId = H5Dopen(file.subConcGroupId, datasetName.str().c_str(),
 			H5P_DEFAULT);
 
+	// Create property list for independent dataset write
+	hid_t propertyListId = H5Pcreate(H5P_DATASET_XFER);
+	H5Pset_dxpl_mpio(propertyListId, H5FD_MPIO_INDEPENDENT);
+
 	// Write concArray in the dataset
-	status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL, propertyListId,
+	H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL, propertyListId,
 			&concArray);
 
 	// Close everything
-	status = H5Dclose(datasetId);
+	H5Pclose(propertyListId);
+	H5Dclose(datasetId);
+
+	return;
+}
+
+void HDF5Utils::writeConcentrations(FileHandle& file,
+		const std::vector<double>& concArray,
+		const std::vector<int>& concSizes, int nx, int xs, int xm, int ny,
+		int ys, int ym, int nz, int zs, int zm) {
+	// Get the number of pairs written by this process, by the ones before it,
+	// and by all of them
+	long long localSize = concArray.size() / 2, localStart = 0, totalSize = 0;
+	MPI_Exscan(&localSize, &localStart, 1, MPI_LONG_LONG, MPI_SUM, file.comm);
+	MPI_Allreduce(&localSize, &totalSize, 1, MPI_LONG_LONG, MPI_SUM,
+			file.comm);
+	// MPI_Exscan leaves the result undefined on the first process
+	int procId;
+	MPI_Comm_rank(file.comm, &procId);
+	if (procId == 0)
+		localStart = 0;
+
+	// Create property list for collective dataset write
+	hid_t xferListId = H5Pcreate(H5P_DATASET_XFER);
+	H5Pset_dxpl_mpio(xferListId, H5FD_MPIO_COLLECTIVE);
+
+	// The offsets dataset has the shape of the grid (z, y, x) with the
+	// position and the size as the last dimension
+	int rank = 0;
+	hsize_t dims[4], start[4], count[4];
+	if (nz > 0) {
+		dims[rank] = nz, start[rank] = zs, count[rank] = zm;
+		rank++;
+	}
+	if (ny > 0) {
+		dims[rank] = ny, start[rank] = ys, count[rank] = ym;
+		rank++;
+	}
+	dims[rank] = nx, start[rank] = xs, count[rank] = xm;
+	rank++;
+	dims[rank] = 2, start[rank] = 0, count[rank] = 2;
+	rank++;
+
+	// Compute the position of each local grid point in the full array
+	std::vector<long long> offsetArray(2 * concSizes.size());
+	long long position = localStart;
+	for (unsigned int n = 0; n < concSizes.size(); n++) {
+		offsetArray[2 * n] = position;
+		offsetArray[2 * n + 1] = concSizes[n];
+		position += concSizes[n];
+	}
+
+	// Create the offsets dataset and write the local part of it
+	hid_t dataspaceId = H5Screate_simple(rank, dims, NULL);
+	hid_t datasetId = H5Dcreate2(file.subConcGroupId, "concOffsets", H5T_STD_I64LE,
+			dataspaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	hid_t memspaceId = H5Screate_simple(rank, count, NULL);
+	if (concSizes.empty()) {
+		H5Sselect_none(dataspaceId);
+		H5Sselect_none(memspaceId);
+	}
+	else {
+		H5Sselect_hyperslab(dataspaceId, H5S_SELECT_SET, start, NULL,
+				count, NULL);
+	}
+	H5Dwrite(datasetId, H5T_NATIVE_LLONG, memspaceId, dataspaceId,
+			xferListId, offsetArray.data());
+
+	// Close everything
+	H5Sclose(memspaceId);
+	H5Sclose(dataspaceId);
+	H5Dclose(datasetId);
+
+	// Split the pairs in 32 bits indices and values
+	std::vector<int> indexArray(localSize);
+	std::vector<double> valueArray(localSize);
+	for (long long l = 0; l < localSize; l++) {
+		indexArray[l] = (int) concArray[2 * l];
+		valueArray[l] = concArray[2 * l + 1];
+	}
+
+	// Each process writes its contiguous block of the index and value
+	// datasets
+	hsize_t concDims[1] = { (hsize_t) totalSize };
+	hsize_t concStart[1] = { (hsize_t) localStart };
+	hsize_t concCount[1] = { (hsize_t) localSize };
+	dataspaceId = H5Screate_simple(1, concDims, NULL);
+	memspaceId = H5Screate_simple(1, concCount, NULL);
+	if (localSize == 0) {
+		H5Sselect_none(dataspaceId);
+		H5Sselect_none(memspaceId);
+	}
+	else {
+		H5Sselect_hyperslab(dataspaceId, H5S_SELECT_SET, concStart,
+				NULL, concCount, NULL);
+	}
+	hid_t plistId = createConcentrationPropertyList(totalSize);
+
+	// Create and write the indices
+	datasetId = H5Dcreate2(file.subConcGroupId, "concIndices", H5T_STD_I32LE,
+			dataspaceId, H5P_DEFAULT, plistId, H5P_DEFAULT);
+	H5Dwrite(datasetId, H5T_NATIVE_INT, memspaceId, dataspaceId,
+			xferListId, indexArray.data());
+	H5Dclose(datasetId);
+
+	// Create and write the values
+	datasetId = H5Dcreate2(file.subConcGroupId, "concValues", H5T_IEEE_F64LE,
+			dataspaceId, H5P_DEFAULT, plistId, H5P_DEFAULT);
+	H5Dwrite(datasetId, H5T_NATIVE_DOUBLE, memspaceId, dataspaceId,
+			xferListId, valueArray.data());
+	H5Dclose(datasetId);
+
+	// Close everything
+	H5Pclose(plistId);
+	H5Sclose(memspaceId);
+	H5Sclose(dataspaceId);
+	H5Pclose(xferListId);
 
 	return;
 }
 
-void HDF5Utils::finalizeFile() {
+void HDF5Utils::finalizeFile(FileHandle& file) {
 	// Close everything
-	status = H5Gclose(headerGroupId);
-	status = H5Gclose(concentrationGroupId);
-	status = H5Fclose(fileId);
+	H5Gclose(file.headerGroupId);
+	H5Gclose(file.concGroupId);
+	H5Fclose(file.fileId);
 
 	return;
 }
 
-void HDF5Utils::closeFile() {
+void HDF5Utils::closeFile(FileHandle& file) {
 	// Close everything
-	status = H5Pclose(propertyListId);
-	status = H5Gclose(subConcGroupId);
-	status = H5Gclose(concentrationGroupId);
-	status = H5Fclose(fileId);
+	H5Gclose(file.subConcGroupId);
+	H5Gclose(file.concGroupId);
+	H5Fclose(file.fileId);
 
 	return;
 }
@@ -411,48 +559,48 @@ void HDF5Utils::closeFile() {
 void HDF5Utils::readHeader(const std::string& fileName, int &nx, double &hx, int &ny,
 		double &hy, int &nz, double &hz) {
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Open the header group
 	hid_t groupId = H5Gopen(fileId, "/headerGroup", H5P_DEFAULT);
 
 	// Open and read the nx attribute
 	hid_t attributeId = H5Aopen(groupId, "nx", H5P_DEFAULT);
-	status = H5Aread(attributeId, H5T_STD_I32LE, &nx);
-	status = H5Aclose(attributeId);
+	H5Aread(attributeId, H5T_STD_I32LE, &nx);
+	H5Aclose(attributeId);
 	// Open and read the hx attribute
 	attributeId = H5Aopen(groupId, "hx", H5P_DEFAULT);
-	status = H5Aread(attributeId, H5T_IEEE_F64LE, &hx);
-	status = H5Aclose(attributeId);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &hx);
+	H5Aclose(attributeId);
 
 	// Open and read the ny attribute
 	attributeId = H5Aopen(groupId, "ny", H5P_DEFAULT);
-	status = H5Aread(attributeId, H5T_STD_I32LE, &ny);
-	status = H5Aclose(attributeId);
+	H5Aread(attributeId, H5T_STD_I32LE, &ny);
+	H5Aclose(attributeId);
 	// Open and read the hy attribute
 	attributeId = H5Aopen(groupId, "hy", H5P_DEFAULT);
-	status = H5Aread(attributeId, H5T_IEEE_F64LE, &hy);
-	status = H5Aclose(attributeId);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &hy);
+	H5Aclose(attributeId);
 
 	// Open and read the nz attribute
 	attributeId = H5Aopen(groupId, "nz", H5P_DEFAULT);
-	status = H5Aread(attributeId, H5T_STD_I32LE, &nz);
-	status = H5Aclose(attributeId);
+	H5Aread(attributeId, H5T_STD_I32LE, &nz);
+	H5Aclose(attributeId);
 	// Open and read the hz attribute
 	attributeId = H5Aopen(groupId, "hz", H5P_DEFAULT);
-	status = H5Aread(attributeId, H5T_IEEE_F64LE, &hz);
-	status = H5Aclose(attributeId);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &hz);
+	H5Aclose(attributeId);
 
 	// Close everything
-	status = H5Gclose(groupId);
-	status = H5Fclose(fileId);
+	H5Gclose(groupId);
+	H5Fclose(fileId);
 
 	return;
 }
@@ -463,28 +611,28 @@ bool HDF5Utils::hasConcentrationGroup(const std::string& fileName,
 	bool hasGroup = true;
 
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Check the group
 	bool groupExist = H5Lexists(fileId, "/concentrationsGroup", H5P_DEFAULT);
 	// If the group exist
 	if (groupExist) {
 		// Open the concentration group
-		concentrationGroupId = H5Gopen(fileId, "/concentrationsGroup", H5P_DEFAULT);
+		hid_t concentrationGroupId = H5Gopen(fileId, "/concentrationsGroup", H5P_DEFAULT);
 
 		// Open and read the lastTimeStep attribute
 		hid_t lastAttributeId = H5Aopen(concentrationGroupId, "lastTimeStep", H5P_DEFAULT);
-		status = H5Aread(lastAttributeId, H5T_STD_I32LE, &lastTimeStep);
-		status = H5Aclose(lastAttributeId);
+		H5Aread(lastAttributeId, H5T_STD_I32LE, &lastTimeStep);
+		H5Aclose(lastAttributeId);
 
-		status = H5Gclose(concentrationGroupId);
+		H5Gclose(concentrationGroupId);
 
 		// if lastTimeStep is still negative the group is not valid
 		if (lastTimeStep < 0)
@@ -495,7 +643,7 @@ bool HDF5Utils::hasConcentrationGroup(const std::string& fileName,
 		hasGroup = false;
 
 	// Close everything
-	status = H5Fclose(fileId);
+	H5Fclose(fileId);
 
 	return hasGroup;
 }
@@ -503,66 +651,66 @@ bool HDF5Utils::hasConcentrationGroup(const std::string& fileName,
 void HDF5Utils::readTimes(const std::string& fileName, int lastTimeStep, double &time,
 		double &deltaTime) {
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Set the name of the sub group
 	std::stringstream subGroupName;
 	subGroupName << "concentrationsGroup/concentration_" << lastTimeStep;
 
 	// Open this specific concentration sub group
-	subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
+	hid_t subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
 
 	// Open and read the absoluteTime attribute
 	hid_t attributeId = H5Aopen(subConcGroupId, "absoluteTime", H5P_DEFAULT);
-	status = H5Aread(attributeId, H5T_IEEE_F64LE, &time);
-	status = H5Aclose(attributeId);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &time);
+	H5Aclose(attributeId);
 
 	// Open and read the deltaTime attribute
 	attributeId = H5Aopen(subConcGroupId, "deltaTime", H5P_DEFAULT);
-	status = H5Aread(attributeId, H5T_IEEE_F64LE, &deltaTime);
-	status = H5Aclose(attributeId);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &deltaTime);
+	H5Aclose(attributeId);
 
 	// Close everything
-	status = H5Gclose(subConcGroupId);
-	status = H5Fclose(fileId);
+	H5Gclose(subConcGroupId);
+	H5Fclose(fileId);
 
 	return;
 }
 
 double HDF5Utils::readPreviousTime(const std::string& fileName, int lastTimeStep) {
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Set the name of the sub group
 	std::stringstream subGroupName;
 	subGroupName << "concentrationsGroup/concentration_" << lastTimeStep;
 
 	// Open this specific concentration sub group
-	subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
+	hid_t subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
 
 	// Open and read the previousTime attribute
 	double previousTime = 0.0;
 	hid_t attributeId = H5Aopen(subConcGroupId, "previousTime", H5P_DEFAULT);
-	status = H5Aread(attributeId, H5T_IEEE_F64LE, &previousTime);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &previousTime);
 
 	// Close everything
-	status = H5Aclose(attributeId);
-	status = H5Gclose(subConcGroupId);
-	status = H5Fclose(fileId);
+	H5Aclose(attributeId);
+	H5Gclose(subConcGroupId);
+	H5Fclose(fileId);
 
 	return previousTime;
 }
@@ -572,30 +720,30 @@ int HDF5Utils::readSurface1D(const std::string& fileName, int lastTimeStep) {
 	int iSurface = 0;
 
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Set the name of the sub group
 	std::stringstream subGroupName;
 	subGroupName << "concentrationsGroup/concentration_" << lastTimeStep;
 
 	// Open this specific concentration sub group
-	subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
+	hid_t subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
 
 	// Open and read the iSurface attribute
 	hid_t attributeId = H5Aopen(subConcGroupId, "iSurface", H5P_DEFAULT);
-	status = H5Aread(attributeId, H5T_STD_I32LE, &iSurface);
-	status = H5Aclose(attributeId);
+	H5Aread(attributeId, H5T_STD_I32LE, &iSurface);
+	H5Aclose(attributeId);
 
 	// Close everything
-	status = H5Gclose(subConcGroupId);
-	status = H5Fclose(fileId);
+	H5Gclose(subConcGroupId);
+	H5Fclose(fileId);
 
 	return iSurface;
 }
@@ -605,21 +753,21 @@ std::vector<int> HDF5Utils::readSurface2D(const std::string& fileName, int lastT
 	std::vector<int> toReturn;
 
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Set the name of the sub group
 	std::stringstream subGroupName;
 	subGroupName << "concentrationsGroup/concentration_" << lastTimeStep;
 
 	// Open this specific concentration sub group
-	subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
+	hid_t subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
 
 	// Open the dataset
 	hid_t datasetId = H5Dopen(subConcGroupId, "iSurface", H5P_DEFAULT);
@@ -629,13 +777,13 @@ std::vector<int> HDF5Utils::readSurface2D(const std::string& fileName, int lastT
 
 	// Get the dimensions of the dataset
 	hsize_t dims[1];
-	status = H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
+	H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
 
 	// Create the array that will receive the indices
 	int index[dims[0]];
 
 	// Read the data set
-	status = H5Dread(datasetId, H5T_STD_I32LE, H5S_ALL, H5S_ALL,
+	H5Dread(datasetId, H5T_STD_I32LE, H5S_ALL, H5S_ALL,
 			H5P_DEFAULT, &index);
 
 	// Loop on the length and fill the vector to return
@@ -644,10 +792,10 @@ std::vector<int> HDF5Utils::readSurface2D(const std::string& fileName, int lastT
 	}
 
 	// Close everything
-	status = H5Dclose(datasetId);
-	status = H5Sclose(dataspaceId);
-	status = H5Gclose(subConcGroupId);
-	status = H5Fclose(fileId);
+	H5Dclose(datasetId);
+	H5Sclose(dataspaceId);
+	H5Gclose(subConcGroupId);
+	H5Fclose(fileId);
 
 	return toReturn;
 }
@@ -658,21 +806,21 @@ std::vector< std::vector<int> > HDF5Utils::readSurface3D(const std::string& file
 	std::vector< std::vector<int> > toReturn;
 
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Set the name of the sub group
 	std::stringstream subGroupName;
 	subGroupName << "concentrationsGroup/concentration_" << lastTimeStep;
 
 	// Open this specific concentration sub group
-	subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
+	hid_t subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
 
 	// Open the dataset
 	hid_t datasetId = H5Dopen(subConcGroupId, "iSurface", H5P_DEFAULT);
@@ -682,13 +830,13 @@ std::vector< std::vector<int> > HDF5Utils::readSurface3D(const std::string& file
 
 	// Get the dimensions of the dataset
 	hsize_t dims[2];
-	status = H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
+	H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
 
 	// Create the array that will receive the indices
 	int index[dims[0]][dims[1]];
 
 	// Read the data set
-	status = H5Dread(datasetId, H5T_STD_I32LE, H5S_ALL, H5S_ALL,
+	H5Dread(datasetId, H5T_STD_I32LE, H5S_ALL, H5S_ALL,
 			H5P_DEFAULT, &index);
 
 	// Loop on the length and fill the vector to return
@@ -703,10 +851,10 @@ std::vector< std::vector<int> > HDF5Utils::readSurface3D(const std::string& file
 	}
 
 	// Close everything
-	status = H5Dclose(datasetId);
-	status = H5Sclose(dataspaceId);
-	status = H5Gclose(subConcGroupId);
-	status = H5Fclose(fileId);
+	H5Dclose(datasetId);
+	H5Sclose(dataspaceId);
+	H5Gclose(subConcGroupId);
+	H5Fclose(fileId);
 
 	return toReturn;
 }
@@ -716,30 +864,30 @@ double HDF5Utils::readNInterstitial1D(const std::string& fileName, int lastTimeS
 	double nInter = 0.0;
 
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Set the name of the sub group
 	std::stringstream subGroupName;
 	subGroupName << "concentrationsGroup/concentration_" << lastTimeStep;
 
 	// Open this specific concentration sub group
-	subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
+	hid_t subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
 
 	// Open and read the iSurface attribute
 	hid_t attributeId = H5Aopen(subConcGroupId, "nInterstitial", H5P_DEFAULT);
-	status = H5Aread(attributeId, H5T_IEEE_F64LE, &nInter);
-	status = H5Aclose(attributeId);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &nInter);
+	H5Aclose(attributeId);
 
 	// Close everything
-	status = H5Gclose(subConcGroupId);
-	status = H5Fclose(fileId);
+	H5Gclose(subConcGroupId);
+	H5Fclose(fileId);
 
 	return nInter;
 }
@@ -749,21 +897,21 @@ std::vector<double> HDF5Utils::readNInterstitial2D(const std::string& fileName,
 	std::vector<double> toReturn;
 
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Set the name of the sub group
 	std::stringstream subGroupName;
 	subGroupName << "concentrationsGroup/concentration_" << lastTimeStep;
 
 	// Open this specific concentration sub group
-	subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
+	hid_t subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
 
 	// Open the dataset
 	hid_t datasetId = H5Dopen(subConcGroupId, "nInterstitial", H5P_DEFAULT);
@@ -773,13 +921,13 @@ std::vector<double> HDF5Utils::readNInterstitial2D(const std::string& fileName,
 
 	// Get the dimensions of the dataset
 	hsize_t dims[1];
-	status = H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
+	H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
 
 	// Create the array that will receive the indices
 	double quantity[dims[0]];
 
 	// Read the data set
-	status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+	H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
 			H5P_DEFAULT, &quantity);
 
 	// Loop on the length and fill the vector to return
@@ -788,10 +936,10 @@ std::vector<double> HDF5Utils::readNInterstitial2D(const std::string& fileName,
 	}
 
 	// Close everything
-	status = H5Dclose(datasetId);
-	status = H5Sclose(dataspaceId);
-	status = H5Gclose(subConcGroupId);
-	status = H5Fclose(fileId);
+	H5Dclose(datasetId);
+	H5Sclose(dataspaceId);
+	H5Gclose(subConcGroupId);
+	H5Fclose(fileId);
 
 	return toReturn;
 }
@@ -802,21 +950,21 @@ std::vector< std::vector<double> > HDF5Utils::readNInterstitial3D(const std::str
 	std::vector< std::vector<double> > toReturn;
 
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Set the name of the sub group
 	std::stringstream subGroupName;
 	subGroupName << "concentrationsGroup/concentration_" << lastTimeStep;
 
 	// Open this specific concentration sub group
-	subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
+	hid_t subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
 
 	// Open the dataset
 	hid_t datasetId = H5Dopen(subConcGroupId, "nInterstitial", H5P_DEFAULT);
@@ -826,13 +974,13 @@ std::vector< std::vector<double> > HDF5Utils::readNInterstitial3D(const std::str
 
 	// Get the dimensions of the dataset
 	hsize_t dims[2];
-	status = H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
+	H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
 
 	// Create the array that will receive the indices
 	double quantity[dims[0]][dims[1]];
 
 	// Read the data set
-	status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+	H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
 			H5P_DEFAULT, &quantity);
 
 	// Loop on the length and fill the vector to return
@@ -847,10 +995,10 @@ std::vector< std::vector<double> > HDF5Utils::readNInterstitial3D(const std::str
 	}
 
 	// Close everything
-	status = H5Dclose(datasetId);
-	status = H5Sclose(dataspaceId);
-	status = H5Gclose(subConcGroupId);
-	status = H5Fclose(fileId);
+	H5Dclose(datasetId);
+	H5Sclose(dataspaceId);
+	H5Gclose(subConcGroupId);
+	H5Fclose(fileId);
 
 	return toReturn;
 }
@@ -860,30 +1008,30 @@ double HDF5Utils::readPreviousIFlux1D(const std::string& fileName, int lastTimeS
 	double previousFlux = 0.0;
 
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Set the name of the sub group
 	std::stringstream subGroupName;
 	subGroupName << "concentrationsGroup/concentration_" << lastTimeStep;
 
 	// Open this specific concentration sub group
-	subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
+	hid_t subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
 
 	// Open and read the iSurface attribute
 	hid_t attributeId = H5Aopen(subConcGroupId, "previousIFlux", H5P_DEFAULT);
-	status = H5Aread(attributeId, H5T_IEEE_F64LE, &previousFlux);
-	status = H5Aclose(attributeId);
+	H5Aread(attributeId, H5T_IEEE_F64LE, &previousFlux);
+	H5Aclose(attributeId);
 
 	// Close everything
-	status = H5Gclose(subConcGroupId);
-	status = H5Fclose(fileId);
+	H5Gclose(subConcGroupId);
+	H5Fclose(fileId);
 
 	return previousFlux;
 }
@@ -893,21 +1041,21 @@ std::vector<double> HDF5Utils::readPreviousIFlux2D(const std::string& fileName,
 	std::vector<double> toReturn;
 
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Set the name of the sub group
 	std::stringstream subGroupName;
 	subGroupName << "concentrationsGroup/concentration_" << lastTimeStep;
 
 	// Open this specific concentration sub group
-	subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
+	hid_t subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
 
 	// Open the dataset
 	hid_t datasetId = H5Dopen(subConcGroupId, "previousIFlux", H5P_DEFAULT);
@@ -917,13 +1065,13 @@ std::vector<double> HDF5Utils::readPreviousIFlux2D(const std::string& fileName,
 
 	// Get the dimensions of the dataset
 	hsize_t dims[1];
-	status = H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
+	H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
 
 	// Create the array that will receive the indices
 	double flux[dims[0]];
 
 	// Read the data set
-	status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+	H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
 			H5P_DEFAULT, &flux);
 
 	// Loop on the length and fill the vector to return
@@ -932,10 +1080,10 @@ std::vector<double> HDF5Utils::readPreviousIFlux2D(const std::string& fileName,
 	}
 
 	// Close everything
-	status = H5Dclose(datasetId);
-	status = H5Sclose(dataspaceId);
-	status = H5Gclose(subConcGroupId);
-	status = H5Fclose(fileId);
+	H5Dclose(datasetId);
+	H5Sclose(dataspaceId);
+	H5Gclose(subConcGroupId);
+	H5Fclose(fileId);
 
 	return toReturn;
 }
@@ -946,21 +1094,21 @@ std::vector< std::vector<double> > HDF5Utils::readPreviousIFlux3D(const std::str
 	std::vector< std::vector<double> > toReturn;
 
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Set the name of the sub group
 	std::stringstream subGroupName;
 	subGroupName << "concentrationsGroup/concentration_" << lastTimeStep;
 
 	// Open this specific concentration sub group
-	subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
+	hid_t subConcGroupId = H5Gopen(fileId, subGroupName.str().c_str(), H5P_DEFAULT);
 
 	// Open the dataset
 	hid_t datasetId = H5Dopen(subConcGroupId, "previousIFlux", H5P_DEFAULT);
@@ -970,13 +1118,13 @@ std::vector< std::vector<double> > HDF5Utils::readPreviousIFlux3D(const std::str
 
 	// Get the dimensions of the dataset
 	hsize_t dims[2];
-	status = H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
+	H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
 
 	// Create the array that will receive the indices
 	double quantity[dims[0]][dims[1]];
 
 	// Read the data set
-	status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+	H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
 			H5P_DEFAULT, &quantity);
 
 	// Loop on the length and fill the vector to return
@@ -991,24 +1139,24 @@ std::vector< std::vector<double> > HDF5Utils::readPreviousIFlux3D(const std::str
 	}
 
 	// Close everything
-	status = H5Dclose(datasetId);
-	status = H5Sclose(dataspaceId);
-	status = H5Gclose(subConcGroupId);
-	status = H5Fclose(fileId);
+	H5Dclose(datasetId);
+	H5Sclose(dataspaceId);
+	H5Gclose(subConcGroupId);
+	H5Fclose(fileId);
 
 	return toReturn;
 }
 
 std::vector<std::vector<double> > HDF5Utils::readNetwork(const std::string& fileName) {
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
 	// Open the dataset
 	hid_t datasetId = H5Dopen(fileId, "/networkGroup/network", H5P_DEFAULT);
@@ -1016,14 +1164,14 @@ std::vector<std::vector<double> > HDF5Utils::readNetwork(const std::string& file
 	// Open and read the networkSize attribute
 	hid_t networkSizeAttributeId = H5Aopen(datasetId, "networkSize", H5P_DEFAULT);
 	int networkSize = 0;
-	status = H5Aread(networkSizeAttributeId, H5T_STD_I32LE, &networkSize);
-	status = H5Aclose(networkSizeAttributeId);
+	H5Aread(networkSizeAttributeId, H5T_STD_I32LE, &networkSize);
+	H5Aclose(networkSizeAttributeId);
 
 	// Create the array that will receive the network
 	double *networkArray = new double[networkSize*6];
 
 	// Read the data set
-	status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+	H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
 			networkArray);
 
 	// Fill the vector to return with the dataset
@@ -1039,8 +1187,8 @@ std::vector<std::vector<double> > HDF5Utils::readNetwork(const std::string& file
 	}
 
 	// Close everything
-	status = H5Dclose(datasetId);
-	status = H5Fclose(fileId);
+	H5Dclose(datasetId);
+	H5Fclose(fileId);
 	delete [] networkArray;
 
 	return networkVector;
@@ -1052,19 +1200,121 @@ std::vector< std::vector<double> > HDF5Utils::readGridPoint(const std::string& f
 	std::vector< std::vector<double> > toReturn;
 
 	// Set up file access property list with parallel I/O access
-	propertyListId = H5Pcreate(H5P_FILE_ACCESS);
+	hid_t propertyListId = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(propertyListId, MPI_COMM_WORLD, MPI_INFO_NULL);
 
 	// Open the given HDF5 file with read only access
-	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, propertyListId);
 
 	// Close the property list
-	status = H5Pclose(propertyListId);
+	H5Pclose(propertyListId);
 
-	// Set the dataset name
+	// Set the sub group name
+	std::stringstream groupName;
+	groupName << "concentrationsGroup/concentration_" << lastTimeStep;
+
+	// Check if the concentrations were written in a single dataset
+	std::string offsetsName = groupName.str() + "/concOffsets";
+	if (H5Lexists(fileId, offsetsName.c_str(), H5P_DEFAULT) > 0) {
+		// Open the offsets dataset and get its shape
+		hid_t datasetId = H5Dopen(fileId, offsetsName.c_str(), H5P_DEFAULT);
+		hid_t dataspaceId = H5Dget_space(datasetId);
+		int rank = H5Sget_simple_extent_ndims(dataspaceId);
+
+		// Select the position and size of this grid point
+		hsize_t start[4], count[4];
+		int n = 0;
+		if (rank > 3)
+			start[n] = k, count[n] = 1, n++;
+		if (rank > 2)
+			start[n] = j, count[n] = 1, n++;
+		start[n] = i, count[n] = 1, n++;
+		start[n] = 0, count[n] = 2;
+		H5Sselect_hyperslab(dataspaceId, H5S_SELECT_SET, start, NULL,
+				count, NULL);
+		hsize_t memDims[1] = { 2 };
+		hid_t memspaceId = H5Screate_simple(1, memDims, NULL);
+		long long offset[2];
+		H5Dread(datasetId, H5T_NATIVE_LLONG, memspaceId, dataspaceId,
+				H5P_DEFAULT, offset);
+
+		// Close everything
+		H5Sclose(memspaceId);
+		H5Sclose(dataspaceId);
+		H5Dclose(datasetId);
+
+		// Read the pairs of this grid point
+		if (offset[1] > 0) {
+			std::vector<double> concArray(2 * offset[1]);
+			std::string indicesName = groupName.str() + "/concIndices";
+			if (H5Lexists(fileId, indicesName.c_str(), H5P_DEFAULT) > 0) {
+				// The indices and the values are in separate datasets
+				hsize_t concStart[1] = { (hsize_t) offset[0] };
+				hsize_t concCount[1] = { (hsize_t) offset[1] };
+				memspaceId = H5Screate_simple(1, concCount, NULL);
+				std::vector<int> indexArray(offset[1]);
+				std::vector<double> valueArray(offset[1]);
+
+				// Read the indices
+				datasetId = H5Dopen(fileId, indicesName.c_str(), H5P_DEFAULT);
+				dataspaceId = H5Dget_space(datasetId);
+				H5Sselect_hyperslab(dataspaceId, H5S_SELECT_SET,
+						concStart, NULL, concCount, NULL);
+				H5Dread(datasetId, H5T_NATIVE_INT, memspaceId,
+						dataspaceId, H5P_DEFAULT, indexArray.data());
+				H5Sclose(dataspaceId);
+				H5Dclose(datasetId);
+
+				// Read the values
+				std::string valuesName = groupName.str() + "/concValues";
+				datasetId = H5Dopen(fileId, valuesName.c_str(), H5P_DEFAULT);
+				dataspaceId = H5Dget_space(datasetId);
+				H5Sselect_hyperslab(dataspaceId, H5S_SELECT_SET,
+						concStart, NULL, concCount, NULL);
+				H5Dread(datasetId, H5T_NATIVE_DOUBLE, memspaceId,
+						dataspaceId, H5P_DEFAULT, valueArray.data());
+
+				for (long long l = 0; l < offset[1]; l++) {
+					concArray[2 * l] = (double) indexArray[l];
+					concArray[2 * l + 1] = valueArray[l];
+				}
+			}
+			else {
+				// The pairs are stored as doubles
+				std::string concsName = groupName.str() + "/concs";
+				datasetId = H5Dopen(fileId, concsName.c_str(), H5P_DEFAULT);
+				dataspaceId = H5Dget_space(datasetId);
+				hsize_t concStart[2] = { (hsize_t) offset[0], 0 };
+				hsize_t concCount[2] = { (hsize_t) offset[1], 2 };
+				H5Sselect_hyperslab(dataspaceId, H5S_SELECT_SET,
+						concStart, NULL, concCount, NULL);
+				memspaceId = H5Screate_simple(2, concCount, NULL);
+				H5Dread(datasetId, H5T_NATIVE_DOUBLE, memspaceId,
+						dataspaceId, H5P_DEFAULT, concArray.data());
+			}
+
+			// Create the concentration vector for each cluster
+			for (long long l = 0; l < offset[1]; l++) {
+				toReturn.push_back(
+						{ concArray[2 * l], concArray[2 * l + 1] });
+			}
+
+			// Close everything
+			H5Sclose(memspaceId);
+			H5Sclose(dataspaceId);
+			H5Dclose(datasetId);
+		}
+
+		// Close the file
+		H5Fclose(fileId);
+
+		return toReturn;
+	}
+
+	// Otherwise each grid point has its own dataset
 	std::stringstream datasetName;
-	datasetName << "concentrationsGroup/concentration_" << lastTimeStep
-			<< "/position_" << i << "_" << j << "_" << k;
+	datasetName << groupName.str() << "/position_" << i << "_" << j << "_"
+			<< k;
 
 	// Check the dataset
 	bool datasetExist = H5Lexists(fileId, datasetName.str().c_str(),
@@ -1080,13 +1330,13 @@ std::vector< std::vector<double> > HDF5Utils::readGridPoint(const std::string& f
 
 		// Get the dimensions of the dataset
 		hsize_t dims[2];
-		status = H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
+		H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
 
 		// Create the array that will receive the concentrations
 		double conc[dims[0]][dims[1]];
 
 		// Read the data set
-		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+		H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
 				H5P_DEFAULT, &conc);
 
 		// Loop on the length
@@ -1101,12 +1351,12 @@ std::vector< std::vector<double> > HDF5Utils::readGridPoint(const std::string& f
 		}
 
 		// Close everything
-		status = H5Dclose(datasetId);
-		status = H5Sclose(dataspaceId);
+		H5Dclose(datasetId);
+		H5Sclose(dataspaceId);
 	}
 
 	// Close the file
-	status = H5Fclose(fileId);
+	H5Fclose(fileId);
 
 	return toReturn;
 }
@@ -3,29 +3,60 @@
 
 #include <IReactionNetwork.h>
 #include <memory>
+#include <hdf5.h>
+#include <mpi.h>
 
 namespace xolotlCore {
 
 namespace HDF5Utils {
 
+	/**
+	 * The identifiers of a file opened for writing. Each file has its own
+	 * handle so that several files, on different communicators, can be open
+	 * at the same time.
+	 */
+	struct FileHandle {
+		//! The file
+		hid_t fileId = -1;
+
+		//! The header group, only open between initializeFile() and finalizeFile()
+		hid_t headerGroupId = -1;
+
+		//! The concentration group
+		hid_t concGroupId = -1;
+
+		//! The concentration sub group of the current time step
+		hid_t subConcGroupId = -1;
+
+		//! The communicator of the processes sharing the file
+		MPI_Comm comm = MPI_COMM_WORLD;
+	};
+
 	/**
 	 * Create the HDF5 file with the needed structure.
 	 *
 	 * @param fileName The name of the file to create
+	 * @param comm The communicator of the processes sharing the file
+	 * @return The handle of the file
 	 */
-	void initializeFile(const std::string& fileName);
+	FileHandle initializeFile(const std::string& fileName,
+			MPI_Comm comm = MPI_COMM_WORLD);
 
 	/**
 	 * Open the already existing HDF5 file.
 	 *
 	 * @param fileName The name of the file to open
+	 * @param comm The communicator of the processes sharing the file
+	 * @return The handle of the file
 	 */
-	void openFile(const std::string& fileName);
+	FileHandle openFile(const std::string& fileName,
+			MPI_Comm comm = MPI_COMM_WORLD);
 
 	/**
 	 * Fill the header with the number of points and step size in
 	 * each direction.
 	 *
+	 * @param file The handle of the file
 	 * @param nx The number of grid points in the x direction (depth)
 	 * @param hx The step size in the x direction
 	 * @param ny The number of grid points in the y direction
@@ -33,61 +64,68 @@ namespace HDF5Utils {
 	 * @param nz The number of grid points in the z direction
 	 * @param hz The step size in the z direction
 	 */
-	void fillHeader(int nx, double hx, int ny = 0,
+	void fillHeader(FileHandle& file, int nx, double hx, int ny = 0,
 			double hy = 0.0, int nz = 0, double hz = 0.0);
 
 	/**
-	 * Fill the network dataset.
+	 * Fill the network group. It is an external link, with an absolute path,
+	 * to the network group of the given file, which must thus stay available
+	 * to read the network back.
 	 *
+	 * @param file The handle of the file
 	 * @param fileName The name of the file from which the network will be taken
 	 */
-	void fillNetwork(const std::string& fileName);
+	void fillNetwork(FileHandle& file, const std::string& fileName);
 
 	/**
 	 * Add a concentration subgroup for the given time step to the HDF5 file.
 	 *
+	 * @param file The handle of the file
 	 * @param timeStep The number of the time step
 	 * @param time The physical time at this time step
 	 * @param previousTime The physical time at the previous time step
 	 * @param deltaTime The physical length of the time step
 	 */
-	void addConcentrationSubGroup(int timeStep, double time,
+	void addConcentrationSubGroup(FileHandle& file, int timeStep, double time,
 			double previousTime, double deltaTime);
 
 	/**
 	 * Write the surface position as an attribute of the
 	 * concentration subgroup.
 	 *
+	 * @param file The handle of the file
 	 * @param timeStep The number of the time step
 	 * @param iSurface The index of the surface position
 	 * @param nInter The quantity of interstitial at each surface position
 	 * @param previousFlux The previous I flux at each surface position
 	 */
-	void writeSurface1D(int timeStep, int iSurface,
+	void writeSurface1D(FileHandle& file, int timeStep, int iSurface,
 			double nInter, double previousFlux);
 
 	/**
 	 * Write the surface positions as a dataset of the
 	 * concentration subgroup.
 	 *
+	 * @param file The handle of the file
 	 * @param timeStep The number of the time step
 	 * @param iSurface The indices of the surface position
 	 * @param nInter The quantity of interstitial at each surface position
 	 * @param previousFlux The previous I flux at each surface position
 	 */
-	void writeSurface2D(int timeStep, std::vector<int> iSurface,
+	void writeSurface2D(FileHandle& file, int timeStep, std::vector<int> iSurface,
 			std::vector<double> nInter, std::vector<double> previousFlux);
 
 	/**
 	 * Write the surface positions as a dataset of the
 	 * concentration subgroup.
 	 *
+	 * @param file The handle of the file
 	 * @param timeStep The number of the time step
 	 * @param iSurface The indices of the surface position
 	 * @param nInter The quantity of interstitial at each surface position
 	 * @param previousFlux The previous I flux at each surface position
 	 */
-	void writeSurface3D(int timeStep,
+	void writeSurface3D(FileHandle& file, int timeStep,
 			std::vector< std::vector<int> > iSurface,
 			std::vector< std::vector<double> > nInter,
 			std::vector< std::vector<double> > previousFlux);
@@ -95,33 +133,70 @@ namespace HDF5Utils {
 	/**
 	 * Add the concentration dataset at a specific grid point.
 	 *
+	 * @param file The handle of the file
 	 * @param size The size of the dataset to create
 	 * @param i The index of the position on the grid on the x direction
 	 * @param j The index of the position on the grid on the y direction
 	 * @param k The index of the position on the grid on the z direction
 	 */
-	void addConcentrationDataset(int size, int i, int j = -1, int k = -1);
+	void addConcentrationDataset(FileHandle& file, int size, int i, int j = -1, int k = -1);
 
 	/**
 	 * Fill the concentration dataset at a specific grid point.
 	 *
+	 * @param file The handle of the file
 	 * @param concVector The vector of concentration at a grid point
 	 * @param i The index of the position on the grid on the x direction
 	 * @param j The index of the position on the grid on the y direction
 	 * @param k The index of the position on the grid on the z direction
 	 */
-	void fillConcentrations(const std::vector< std::vector<double> >& concVector,
+	void fillConcentrations(FileHandle& file,
+			const std::vector< std::vector<double> >& concVector,
 			int i, int j = -1, int k = -1);
 
+	/**
+	 * Write the concentrations of all the grid points of the current
+	 * sub group at once. Every process must call it collectively with the
+	 * points it owns. "concIndices" (32 bits integers) and "concValues" hold
+	 * the (index, concentration) pairs of all the grid points one after the
+	 * other, they are chunked and compressed with the shuffle and deflate
+	 * filters when possible. "concOffsets", which has the shape of the grid,
+	 * holds the position of the first pair of each grid point in them and
+	 * its number of pairs.
+	 *
+	 * @param file The handle of the file
+	 * @param concArray The (index, concentration) pairs of the local grid
+	 * points, x being the fastest direction, then y, then z
+	 * @param concSizes The number of pairs of each local grid point
+	 * @param nx The number of grid points on the x direction
+	 * @param xs The first local grid point on the x direction
+	 * @param xm The number of local grid points on the x direction
+	 * @param ny The number of grid points on the y direction
+	 * @param ys The first local grid point on the y direction
+	 * @param ym The number of local grid points on the y direction
+	 * @param nz The number of grid points on the z direction
+	 * @param zs The first local grid point on the z direction
+	 * @param zm The number of local grid points on the z direction
+	 */
+	void writeConcentrations(FileHandle& file,
+			const std::vector<double>& concArray,
+			const std::vector<int>& concSizes, int nx, int xs, int xm,
+			int ny = 0, int ys = 0, int ym = 0, int nz = 0, int zs = 0,
+			int zm = 0);
+
 	/**
 	 * Close the file for the first time after creating it.
+	 *
+	 * @param file The handle of the file
 	 */
-	void finalizeFile();
+	void finalizeFile(FileHandle& file);
 
 	/**
 	 * Close the file when it had been opened by openFile().
+	 *
+	 * @param file The handle of the file
 	 */
-	void closeFile();
+	void closeFile(FileHandle& file);
 
 	/**
 	 * Read the header of a HDF5 file.
@@ -272,6 +347,8 @@ namespace HDF5Utils {
 
 	/**
 	 * Read the (i,j,k)-th grid point concentrations from a HDF5 file.
+	 * Files written with writeConcentrations() and files with one dataset
+	 * per grid point are both supported.
 	 *
 	 * @param fileName The name of the file to read from
 	 * @param lastTimeStep The value of the last written time step
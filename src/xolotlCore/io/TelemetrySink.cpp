@@ -0,0 +1,248 @@
+#include "TelemetrySink.h"
+#include <algorithm>
+
+using namespace xolotlCore;
+
+namespace {
+
+//! The maximum number of rows in a chunk of the column datasets
+const hsize_t maxChunkSize = 65536;
+
+/**
+ * Get the names of the links of a group in their creation order.
+ *
+ * @param locId The group
+ * @return The names
+ */
+std::vector<std::string> getLinkNames(hid_t locId) {
+	std::vector<std::string> names;
+
+	H5G_info_t info;
+	H5Gget_info(locId, &info);
+	for (hsize_t i = 0; i < info.nlinks; i++) {
+		ssize_t size = H5Lget_name_by_idx(locId, ".", H5_INDEX_CRT_ORDER,
+				H5_ITER_INC, i, NULL, 0, H5P_DEFAULT);
+		std::vector<char> name(size + 1, '\0');
+		H5Lget_name_by_idx(locId, ".", H5_INDEX_CRT_ORDER, H5_ITER_INC, i,
+				name.data(), size + 1, H5P_DEFAULT);
+		names.push_back(name.data());
+	}
+
+	return names;
+}
+
+/**
+ * Create the property list keeping the creation order of the links of a
+ * group or file.
+ *
+ * @param classId H5P_FILE_CREATE or H5P_GROUP_CREATE
+ * @return The property list
+ */
+hid_t createOrderedPropertyList(hid_t classId) {
+	hid_t plistId = H5Pcreate(classId);
+	H5Pset_link_creation_order(plistId,
+			H5P_CRT_ORDER_TRACKED | H5P_CRT_ORDER_INDEXED);
+
+	return plistId;
+}
+
+} /* end namespace */
+
+TelemetrySink::TelemetrySink(const std::string& fileName, int flushStride) :
+		flushStride(flushStride) {
+	if (flushStride < 1)
+		throw std::string(
+				"TelemetrySink Exception: the flush stride must be at least 1.");
+
+	// Create the file
+	hid_t plistId = createOrderedPropertyList(H5P_FILE_CREATE);
+	fileId = H5Fcreate(fileName.c_str(), H5F_ACC_TRUNC, plistId, H5P_DEFAULT);
+	H5Pclose(plistId);
+	if (fileId < 0)
+		throw std::string(
+				"TelemetrySink Exception: unable to create " + fileName + ".");
+}
+
+TelemetrySink::~TelemetrySink() {
+	// Write what is left
+	flush();
+
+	// Close everything
+	for (auto& pair : tables) {
+		for (auto datasetId : pair.second.datasetIds) {
+			H5Dclose(datasetId);
+		}
+		H5Gclose(pair.second.groupId);
+	}
+	H5Fclose(fileId);
+}
+
+void TelemetrySink::addTable(const std::string& name,
+		const std::vector<std::string>& columns) {
+	if (tables.find(name) != tables.end())
+		throw std::string(
+				"TelemetrySink Exception: the table " + name
+						+ " already exists.");
+
+	// Create the group of the table
+	Table table;
+	hid_t plistId = createOrderedPropertyList(H5P_GROUP_CREATE);
+	table.groupId = H5Gcreate2(fileId, name.c_str(), H5P_DEFAULT, plistId,
+			H5P_DEFAULT);
+	H5Pclose(plistId);
+	table.nRows = 0;
+
+	// The columns can be extended, one chunk holds the rows of a flush
+	hsize_t dims[1] = { 0 };
+	hsize_t maxDims[1] = { H5S_UNLIMITED };
+	hid_t dataspaceId = H5Screate_simple(1, dims, maxDims);
+	plistId = H5Pcreate(H5P_DATASET_CREATE);
+	hsize_t chunkDims[1] = { std::min((hsize_t) flushStride, maxChunkSize) };
+	H5Pset_chunk(plistId, 1, chunkDims);
+
+	// Create one dataset per column
+	for (auto const& column : columns) {
+		hid_t datasetId = H5Dcreate2(table.groupId, column.c_str(),
+				H5T_IEEE_F64LE, dataspaceId, H5P_DEFAULT, plistId, H5P_DEFAULT);
+		table.datasetIds.push_back(datasetId);
+		table.buffers.push_back(std::vector<double>());
+		table.buffers.back().reserve(flushStride);
+	}
+
+	H5Pclose(plistId);
+	H5Sclose(dataspaceId);
+
+	tables[name] = table;
+
+	return;
+}
+
+void TelemetrySink::append(const std::string& name,
+		const std::vector<double>& row) {
+	auto it = tables.find(name);
+	if (it == tables.end())
+		throw std::string(
+				"TelemetrySink Exception: the table " + name
+						+ " doesn't exist.");
+	auto& table = it->second;
+	if (row.size() != table.buffers.size())
+		throw std::string(
+				"TelemetrySink Exception: wrong number of values for the table "
+						+ name + ".");
+
+	// Buffer the row
+	for (unsigned int i = 0; i < row.size(); i++) {
+		table.buffers[i].push_back(row[i]);
+	}
+
+	// Write the table when enough rows are buffered
+	if (!table.buffers.empty()
+			&& table.buffers[0].size() >= (unsigned int) flushStride)
+		flushTable(table);
+
+	return;
+}
+
+void TelemetrySink::flushTable(Table& table) {
+	if (table.buffers.empty() || table.buffers[0].empty())
+		return;
+
+	// The rows are added at the end of each column
+	hsize_t count[1] = { table.buffers[0].size() };
+	hsize_t offset[1] = { table.nRows };
+	hsize_t newSize[1] = { table.nRows + count[0] };
+	hid_t memspaceId = H5Screate_simple(1, count, NULL);
+	for (unsigned int i = 0; i < table.datasetIds.size(); i++) {
+		H5Dset_extent(table.datasetIds[i], newSize);
+		hid_t dataspaceId = H5Dget_space(table.datasetIds[i]);
+		H5Sselect_hyperslab(dataspaceId, H5S_SELECT_SET, offset, NULL, count,
+				NULL);
+		H5Dwrite(table.datasetIds[i], H5T_NATIVE_DOUBLE, memspaceId,
+				dataspaceId, H5P_DEFAULT, table.buffers[i].data());
+		H5Sclose(dataspaceId);
+		table.buffers[i].clear();
+	}
+	H5Sclose(memspaceId);
+
+	table.nRows = newSize[0];
+
+	return;
+}
+
+void TelemetrySink::flush() {
+	for (auto& pair : tables) {
+		flushTable(pair.second);
+	}
+
+	// Make the rows visible to readers
+	H5Fflush(fileId, H5F_SCOPE_LOCAL);
+
+	return;
+}
+
+std::vector<std::string> TelemetrySink::getTables(const std::string& fileName) {
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+	if (fileId < 0)
+		throw std::string(
+				"TelemetrySink Exception: unable to open " + fileName + ".");
+
+	auto names = getLinkNames(fileId);
+
+	H5Fclose(fileId);
+
+	return names;
+}
+
+void TelemetrySink::writeText(const std::string& fileName,
+		const std::string& name, std::ostream& out) {
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+	if (fileId < 0)
+		throw std::string(
+				"TelemetrySink Exception: unable to open " + fileName + ".");
+	if (H5Lexists(fileId, name.c_str(), H5P_DEFAULT) <= 0) {
+		H5Fclose(fileId);
+		throw std::string(
+				"TelemetrySink Exception: the table " + name
+						+ " doesn't exist.");
+	}
+	hid_t groupId = H5Gopen2(fileId, name.c_str(), H5P_DEFAULT);
+
+	// Read all the columns
+	auto columns = getLinkNames(groupId);
+	std::vector<std::vector<double> > values;
+	for (auto const& column : columns) {
+		hid_t datasetId = H5Dopen2(groupId, column.c_str(), H5P_DEFAULT);
+		hid_t dataspaceId = H5Dget_space(datasetId);
+		hsize_t dims[1];
+		H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
+		values.push_back(std::vector<double>(dims[0]));
+		if (dims[0] > 0)
+			H5Dread(datasetId, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+					values.back().data());
+		H5Sclose(dataspaceId);
+		H5Dclose(datasetId);
+	}
+
+	H5Gclose(groupId);
+	H5Fclose(fileId);
+
+	// The header
+	out << "#";
+	for (auto const& column : columns) {
+		out << " " << column;
+	}
+	out << std::endl;
+
+	// The rows
+	hsize_t nRows = values.empty() ? 0 : values[0].size();
+	for (hsize_t n = 0; n < nRows; n++) {
+		for (unsigned int i = 0; i < values.size(); i++) {
+			if (i > 0)
+				out << " ";
+			out << values[i][n];
+		}
+		out << std::endl;
+	}
+
+	return;
+}
@@ -0,0 +1,119 @@
+#ifndef TELEMETRYSINK_H
+#define TELEMETRYSINK_H
+
+#include <hdf5.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <ostream>
+
+namespace xolotlCore {
+
+/**
+ * This class stores the time series written by the monitors in a binary
+ * HDF5 file instead of appending lines to text files at each time step.
+ *
+ * The file holds one group per table with one extendible dataset per column.
+ * The rows are buffered in memory and a table is written when it holds
+ * flushStride rows, when flush() is called, or when the sink is destroyed.
+ * The tables can be converted back to text with writeText().
+ *
+ * The sink is used by a single process.
+ */
+class TelemetrySink {
+
+private:
+
+	/**
+	 * A table of the file.
+	 */
+	struct Table {
+		//! The HDF5 group of the table
+		hid_t groupId;
+
+		//! One dataset per column
+		std::vector<hid_t> datasetIds;
+
+		//! The rows that are not written yet, stored by column
+		std::vector<std::vector<double> > buffers;
+
+		//! The number of rows already in the file
+		hsize_t nRows;
+	};
+
+	//! The HDF5 file
+	hid_t fileId;
+
+	//! The number of rows buffered before a table is written
+	int flushStride;
+
+	//! The tables by name
+	std::map<std::string, Table> tables;
+
+	/**
+	 * Write the buffered rows of a table.
+	 *
+	 * @param table The table
+	 */
+	void flushTable(Table& table);
+
+public:
+
+	/**
+	 * The constructor creates the file, it replaces an existing one.
+	 *
+	 * @param fileName The name of the file
+	 * @param flushStride The number of rows buffered before a table is
+	 * written, at least 1
+	 */
+	TelemetrySink(const std::string& fileName, int flushStride = 1000);
+
+	/**
+	 * The destructor writes the buffered rows and closes the file.
+	 */
+	~TelemetrySink();
+
+	/**
+	 * Add a table to the file.
+	 *
+	 * @param name The name of the table
+	 * @param columns The names of its columns
+	 */
+	void addTable(const std::string& name,
+			const std::vector<std::string>& columns);
+
+	/**
+	 * Add a row at the end of a table.
+	 *
+	 * @param name The name of the table
+	 * @param row One value per column
+	 */
+	void append(const std::string& name, const std::vector<double>& row);
+
+	/**
+	 * Write the buffered rows of all the tables.
+	 */
+	void flush();
+
+	/**
+	 * Get the names of the tables of a file, in their creation order.
+	 *
+	 * @param fileName The name of the file
+	 * @return The names of the tables
+	 */
+	static std::vector<std::string> getTables(const std::string& fileName);
+
+	/**
+	 * Write a table of a file as text, with the names of the columns on the
+	 * first line and one row per line.
+	 *
+	 * @param fileName The name of the file
+	 * @param name The name of the table
+	 * @param out The stream where the text is written
+	 */
+	static void writeText(const std::string& fileName, const std::string& name,
+			std::ostream& out);
+};
+
+} /* namespace xolotlCore */
+#endif
@@ -87,6 +87,17 @@ namespace xolotlCore
                                    std::vector<double> grid, int ny, double hy,
                                    int nz, double hz ) = 0;
 
+/**
+ * This method moves the surface at one grid point in the Y and Z directions
+ * after the indices were initialized. The trap-mutation allowed at each grid
+ * point follows the surface without being redefined.
+ *
+ * @param surfacePos The index of the new position of the surface
+ * @param yj The index of the position on the grid in the Y direction
+ * @param zk The index of the position on the grid in the Z direction
+ */
+   virtual void setSurfacePosition( int surfacePos, int yj = 0, int zk = 0 ) = 0;
+
 /**
  * This method update the rate for the modified trap-mutation if the rates
  * changed in the network, it should be called when temperature changes
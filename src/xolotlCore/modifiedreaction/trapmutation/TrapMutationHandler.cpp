@@ -17,9 +17,9 @@ namespace xolotlCore
 // Each (He_i)(V) cluster and I clusters are connected to He_i
 
 // Get all the He clusters from the network
-  auto heClusters = network->getAll(heType);
+  heClusters = network->getAll(heType);
 // Get all the HeV bubbles from the network
-  auto bubbles = network->getAll(heVType);
+  bubbles = network->getAll(heVType);
 // Get the single interstitial cluster
   auto singleInterstitial = (PSICluster *) network->get(iType, 1);
 // Get the double interstitial cluster
@@ -31,41 +31,9 @@ namespace xolotlCore
 // there is no trap-mutation
   if (!singleInterstitial || !doubleInterstitial || !tripleInterstitial) 
   {
-// Clear the vector of HeV indices created by He undergoing trap-mutation
-// at each grid point
-   indexVector.clear();
+// No bubble is created through trap-mutation at any grid point
+   initializeSurfaceIndices(grid, ny, nz);
 
-// Change the value of ny and nz in 1D and 2D so that the same loop
-// works in every case
-   if (nz == 0) nz = 1;
-   if (ny == 0) ny = 1;
-
-// Loop on the grid points in the Z direction
-   for (int k = 0; k < nz; k++) 
-   {
-// Create the temporary 2D vector
-    std::vector<std::vector<std::vector<int>>> temp2DVector;
-// Loop on the grid points in the Y direction
-    for (int j = 0; j < ny; j++) 
-    {
-// Create the temporary 1D vector
-     std::vector<std::vector<int> > temp1DVector;
-// Loop on the grid points in the depth direction
-     for (int i = 0; i < grid.size(); i++) 
-     {
-// Create the list (vector) of indices at this grid point
-      std::vector<int> indices;
-// And give it empty to the 1D vector
-      temp1DVector.push_back(indices);
-     }
-
-// Give the 1D vector to the 2D vector
-     temp2DVector.push_back(temp1DVector);
-    }
-
-// Give the 2D vector to the final vector
-    indexVector.push_back(temp2DVector);
-   }
 // Inform the user
    std::cout << "The modified trap-mutation won't happen because "
                 "the interstitial clusters are missing." << std::endl;
@@ -96,10 +64,10 @@ namespace xolotlCore
     auto comp = bubble->getComposition();
 
 // We are only interested in bubbles with one, two, or three vacancies
-    if (comp[vType] > 3) continue;
+    if (comp[PSISpecies::V] > 3) continue;
 
 // Connect with He if the number of helium in the bubble is the same
-    if (comp[heType] == heSize) 
+    if (comp[PSISpecies::He] == heSize) 
     {
      bubble->setDissociationConnectivity(cluster->getId());
     }
@@ -121,75 +89,157 @@ namespace xolotlCore
  }
 
 //--------------------------------------------------------------------------------
- void 
- TrapMutationHandler::initializeIndex1D( int surfacePos, IReactionNetwork* network,
-                                   std::vector<IAdvectionHandler*> advectionHandlers,
-                                   std::vector<double> grid ) 
- {
-// Clear the vector of HeV indices created by He undergoing trap-mutation
-// at each grid point
-  indexVector.clear();
+void TrapMutationHandler::initializeSurfaceIndices(
+		const std::vector<double> & grid, int ny, int nz) {
+	// Keep the grid, the lists computed for the previous one are dropped
+	xGrid = grid;
+	depthIndices.clear();
+	depthIndices.resize(grid.size());
+
+	// Change the value of ny and nz in 1D and 2D so that the same loop
+	// works in every case
+	if (nz == 0) nz = 1;
+	if (ny == 0) ny = 1;
+	surfacePositions.assign(nz, std::vector<int>(ny, 0));
+	gbIndices.assign(nz, std::vector<std::vector<int> >(ny));
+
+	// Find the bubble each helium size trap-mutates into at the depths of
+	// depthVec
+	depthBubbles.assign(depthVec.size(), std::vector<int>());
+	for (int l = 0; l < depthVec.size(); l++) {
+		// Loop on the bubbles
+		for (int m = 0; m < bubbles.size(); m++) {
+			// Get the bubble and its composition
+			auto bubble = (PSICluster *) bubbles[m];
+			auto comp = bubble->getComposition();
+			// Get the correct bubble
+			if (comp[PSISpecies::He] == l + 1
+					&& comp[PSISpecies::V] == sizeVec[l]) {
+				depthBubbles[l].push_back(m);
+			}
+		}
+	}
 
-// Get all the He clusters from the network
-  auto heClusters = network->getAll(heType);
-// Get all the HeV bubbles from the network
-  auto bubbles = network->getAll(heVType);
-// No GB trap mutation handler in 1D for now
+	return;
+}
 
-// Create the temporary 2D vector
-  std::vector<std::vector<std::vector<int> > > temp2DVector;
-// Create the temporary 1D vector
-  std::vector<std::vector<int> > temp1DVector;
+//--------------------------------------------------------------------------------
+void TrapMutationHandler::computeDepthIndices(int surfacePos) {
+	auto & indices = depthIndices[surfacePos];
+
+	// Compute them the first time the surface is at this position
+	if (indices.empty()) {
+		// Nothing happens at the surface
+		indices.resize(1);
+
+		// The deepest grid point that can undergo trap-mutation
+		double maxDepth = 0.0;
+		for (int l = 0; l < depthVec.size(); l++) {
+			maxDepth = std::max(maxDepth, depthVec[l]);
+		}
 
-// Loop on the grid points in the depth direction
-  for (int i = 0; i < grid.size(); i++) 
-  {
-// Create the list (vector) of indices at this grid point
-   std::vector<int> indices;
+		// Loop on the grid points in the depth direction
+		for (int i = surfacePos + 1; i < xGrid.size(); i++) {
+			// Get the depth
+			double depth = xGrid[i] - xGrid[surfacePos];
+			if (depth > maxDepth + 0.01) break;
+
+			// Loop on the depth vector
+			std::vector<int> pointIndices;
+			for (int l = 0; l < depthVec.size(); l++) {
+				// Check if a helium cluster undergo TM at this depth
+				if (std::fabs(depth - depthVec[l]) < 0.01) {
+					// Add the bubble of size l+1 to the indices
+					pointIndices.insert(pointIndices.end(),
+							depthBubbles[l].begin(), depthBubbles[l].end());
+				}
+			}
 
-// If we are on the left side of the surface there is no
-// modified trap-mutation
-   if (i <= surfacePos) 
-   {
-    temp1DVector.push_back(indices);
-    continue;
-   }
+			// Only keep the grid points up to the last one with indices
+			if (!pointIndices.empty()) {
+				indices.resize(i - surfacePos + 1);
+				indices[i - surfacePos] = pointIndices;
+			}
+		}
+	}
 
-// Get the depth
-   double depth = grid[i] - grid[surfacePos];
+	return;
+}
 
-// Loop on the depth vector
-   for (int l = 0; l < depthVec.size(); l++) 
-   {
-// Check if a helium cluster undergo TM at this depth
-    if (std::fabs(depth - depthVec[l])  < 0.01) 
-    {
-// Add the bubble of size l+1 to the indices
-// Loop on the bubbles
-     for (int m = 0; m < bubbles.size(); m++) 
-     {
-// Get the bubble and its composition
-      auto bubble =  (PSICluster *) bubbles[m];
-      auto comp = bubble->getComposition();
-// Get the correct bubble
-      if (comp[heType] == l+1 && comp[vType] == sizeVec[l]) 
-      {
-// Add this bubble to the indices
-       indices.push_back(m);
-      }
-     }
-    }
-   }
+//--------------------------------------------------------------------------------
+void TrapMutationHandler::initializeGBIndices(
+		std::vector<IAdvectionHandler *> advectionHandlers, int ny, double hy,
+		int nz) {
+	// Create a Sigma 3 trap mutation handler because it is the
+	// only one available right now
+	Sigma3TrapMutationHandler sigma3Handler;
+	auto sigma3DistanceVec = sigma3Handler.getDistanceVector();
+	auto sigma3SizeVec = sigma3Handler.getSizeVector();
 
-// Add indices to the index vector
-   temp1DVector.push_back(indices);
-  }
+	if (nz == 0) nz = 1;
 
-// Give the 1D vector to the 2D vector
-  temp2DVector.push_back(temp1DVector);
+	// Loop on the grid points in the Z and Y directions, the indices are the
+	// same at every depth
+	for (int k = 0; k < nz; k++) {
+		for (int j = 0; j < ny; j++) {
+			// The list of indices of this column
+			auto & indices = gbIndices[k][j];
+
+			// Get the Y position
+			double yPos = (double) j * hy;
+			// Loop on the GB advection handlers
+			for (int n = 1; n < advectionHandlers.size(); n++) {
+				// Get the location of the GB
+				double location = advectionHandlers[n]->getLocation();
+				// Get the current distance from the GB
+				double distance = fabs(yPos - location);
+
+				// Loop on the sigma 3 distance vector
+				for (int l = 0; l < sigma3DistanceVec.size(); l++) {
+					// Check if a helium cluster undergo TM at this depth
+					if (std::fabs(distance - sigma3DistanceVec[l]) < 0.01) {
+						// Add the bubble of size l+1 to the indices
+						// Loop on the bubbles
+						for (int m = 0; m < bubbles.size(); m++) {
+							// Get the bubble and its composition
+							auto bubble = (PSICluster *) bubbles[m];
+							auto comp = bubble->getComposition();
+							// Get the correct bubble
+							if (comp[PSISpecies::He] == l + 1
+									&& comp[PSISpecies::V] == sigma3SizeVec[l]) {
+								// Check if this bubble is already in the indices
+								if (std::find(indices.begin(), indices.end(), m)
+										== indices.end()) {
+									// Add this bubble to the indices
+									indices.push_back(m);
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
 
-// Give the 2D vector to the final vector
-  indexVector.push_back(temp2DVector);
+	return;
+}
+
+//--------------------------------------------------------------------------------
+ void 
+ TrapMutationHandler::initializeIndex1D( int surfacePos, IReactionNetwork* network,
+                                   std::vector<IAdvectionHandler*> advectionHandlers,
+                                   std::vector<double> grid ) 
+ {
+// Get all the He clusters from the network
+  heClusters = network->getAll(heType);
+// Get all the HeV bubbles from the network
+  bubbles = network->getAll(heVType);
+// No GB trap mutation handler in 1D for now
+
+// The indices at each grid point only depend on the depth, they are
+// computed when the surface reaches a new position
+  initializeSurfaceIndices(grid, 0, 0);
+  setSurfacePosition(surfacePos);
 
   return;
  }
@@ -201,236 +251,61 @@ namespace xolotlCore
                                   std::vector<IAdvectionHandler *> advectionHandlers,
                                   std::vector<double> grid, int ny, double hy) 
  {
-// Clear the vector of HeV indices created by He undergoing trap-mutation
-// at each grid point
-  indexVector.clear();
-
 // Get all the He clusters from the network
-  auto heClusters = network->getAll(heType);
+  heClusters = network->getAll(heType);
 // Get all the HeV bubbles from the network
-  auto bubbles = network->getAll(heVType);
-// Create a Sigma 3 trap mutation handler because it is the
-// only one available right now
-  auto sigma3Handler = new Sigma3TrapMutationHandler();
-  auto sigma3DistanceVec = sigma3Handler->getDistanceVector();
-  auto sigma3SizeVec = sigma3Handler->getSizeVector();
-
-// Create the temporary 2D vector
-  std::vector<std::vector<std::vector<int> > > temp2DVector;
-// Loop on the grid points in the Y direction
+  bubbles = network->getAll(heVType);
+
+// The indices from the depth are computed when the surface reaches a new
+// position, the ones from the grain boundaries only depend on Y
+  initializeSurfaceIndices(grid, ny, 0);
+  initializeGBIndices(advectionHandlers, ny, hy, 0);
   for (int j = 0; j < ny; j++) 
   {
-// Create the temporary 1D vector
-   std::vector<std::vector<int> > temp1DVector;
-// Loop on the grid points in the depth direction
-   for (int i = 0; i < grid.size(); i++) 
-   {
-// Create the list (vector) of indices at this grid point
-    std::vector<int> indices;
-
-// If we are on the left side of the surface there is no
-// modified trap-mutation
-    if (i <= surfacePos[j])  
-    {
-     temp1DVector.push_back(indices);
-     continue;
-    }
-
-// Get the depth
-    double depth = grid[i] - grid[surfacePos[j]];
-
-// Loop on the depth vector
-    for (int l = 0; l < depthVec.size(); l++) 
-    {
-// Check if a helium cluster undergo TM at this depth
-     if (std::fabs(depth - depthVec[l])  < 0.01) 
-     {
-// Add the bubble of size l+1 to the indices
-// Loop on the bubbles
-      for (int m = 0; m < bubbles.size(); m++) 
-      {
-// Get the bubble and its composition
-       auto bubble =  (PSICluster *) bubbles[m];
-       auto comp = bubble->getComposition();
-// Get the correct bubble
-       if (comp[heType] == l+1 && comp[vType] == sizeVec[l]) 
-       {
-// Add this bubble to the indices
-        indices.push_back(m);
-       }
-      }
-     }
-    }
-
-// Get the Y position
-    double yPos = (double) j * hy;
-// Loop on the GB advection handlers
-    for (int n = 1; n < advectionHandlers.size(); n++) 
-    {
-// Get the location of the GB
-     double location = advectionHandlers[n]->getLocation();
-// Get the current distance from the GB
-     double distance = fabs(yPos - location);
-// Loop on the sigma 3 distance vector
-     for (int l = 0; l < sigma3DistanceVec.size(); l++) 
-     {
-// Check if a helium cluster undergo TM at this depth
-      if (std::fabs(distance - sigma3DistanceVec[l])  < 0.01) 
-      {
-// Add the bubble of size l+1 to the indices
-// Loop on the bubbles
-       for (int m = 0; m < bubbles.size(); m++) 
-       {
-// Get the bubble and its composition
-        auto bubble =  (PSICluster *) bubbles[m];
-        auto comp = bubble->getComposition();
-// Get the correct bubble
-        if (comp[heType] == l+1 && comp[vType] == sigma3SizeVec[l]) 
-        {
-// Check if this bubble is already in the indices
-         if (std::find(indices.begin(), indices.end(), m) == indices.end()) 
-         {
-// Add this bubble to the indices
-          indices.push_back(m);
-         }
-        }
-       }
-      }
-     }
-    }
-
-// Add indices to the index vector
-    temp1DVector.push_back(indices);
-   }
-
-// Give the 1D vector to the 2D vector
-   temp2DVector.push_back(temp1DVector);
+   setSurfacePosition(surfacePos[j], j);
   }
 
-// Give the 2D vector to the final vector
-  indexVector.push_back(temp2DVector);
-
-// Clear the memory
-  delete sigma3Handler;
-
   return;
  }
 
 //--------------------------------------------------------------------------------
- void TrapMutationHandler::initializeIndex3D(std::vector<std::vector<int> > surfacePos,
+void TrapMutationHandler::initializeIndex3D(std::vector<std::vector<int> > surfacePos,
 		IReactionNetwork *network,
 		std::vector<IAdvectionHandler *> advectionHandlers,
 		std::vector<double> grid, int ny, double hy, int nz, double hz) {
-	// Clear the vector of HeV indices created by He undergoing trap-mutation
-	// at each grid point
-	indexVector.clear();
-
 	// Get all the He clusters from the network
-	auto heClusters = network->getAll(heType);
+	heClusters = network->getAll(heType);
 	// Get all the HeV bubbles from the network
-	auto bubbles = network->getAll(heVType);
-	// Create a Sigma 3 trap mutation handler because it is the
-	// only one available right now
-	auto sigma3Handler = new Sigma3TrapMutationHandler();
-	auto sigma3DistanceVec = sigma3Handler->getDistanceVector();
-	auto sigma3SizeVec = sigma3Handler->getSizeVector();
+	bubbles = network->getAll(heVType);
 
-	// Loop on the grid points in the Z direction
+	// The indices from the depth are computed when the surface reaches a new
+	// position, the ones from the grain boundaries only depend on Y
+	initializeSurfaceIndices(grid, ny, nz);
+	initializeGBIndices(advectionHandlers, ny, hy, nz);
 	for (int k = 0; k < nz; k++) {
-		// Create the temporary 2D vector
-		std::vector<std::vector<std::vector<int> > > temp2DVector;
-		// Loop on the grid points in the Y direction
 		for (int j = 0; j < ny; j++) {
-			// Create the temporary 1D vector
-			std::vector<std::vector<int> > temp1DVector;
-			// Loop on the grid points in the depth direction
-			for (int i = 0; i < grid.size(); i++) {
-				// Create the list (vector) of indices at this grid point
-				std::vector<int> indices;
-
-				// If we are on the left side of the surface there is no
-				// modified trap-mutation
-				if (i <= surfacePos[j][k]) {
-					temp1DVector.push_back(indices);
-					continue;
-				}
-
-				// Get the depth
-				double depth = grid[i] - grid[surfacePos[j][k]];
-
-				// Loop on the depth vector
-				for (int l = 0; l < depthVec.size(); l++) {
-					// Check if a helium cluster undergo TM at this depth
-					if (std::fabs(depth - depthVec[l])  < 0.01) {
-						// Add the bubble of size l+1 to the indices
-						// Loop on the bubbles
-						for (int m = 0; m < bubbles.size(); m++) {
-							// Get the bubble and its composition
-							auto bubble =  (PSICluster *) bubbles[m];
-							auto comp = bubble->getComposition();
-							// Get the correct bubble
-							if (comp[heType] == l+1 && comp[vType] == sizeVec[l]) {
-								// Add this bubble to the indices
-								indices.push_back(m);
-							}
-						}
-					}
-				}
-
-				// Get the Y position
-				double yPos = (double) j * hy;
-				// Loop on the GB advection handlers
-				for (int n = 1; n < advectionHandlers.size(); n++) {
-					// Get the location of the GB
-					double location = advectionHandlers[n]->getLocation();
-					// Get the current distance from the GB
-					double distance = fabs(yPos - location);
-
-					// Loop on the sigma 3 distance vector
-					for (int l = 0; l < sigma3DistanceVec.size(); l++) {
-						// Check if a helium cluster undergo TM at this depth
-						if (std::fabs(distance - sigma3DistanceVec[l])  < 0.01) {
-							// Add the bubble of size l+1 to the indices
-							// Loop on the bubbles
-							for (int m = 0; m < bubbles.size(); m++) {
-								// Get the bubble and its composition
-								auto bubble =  (PSICluster *) bubbles[m];
-								auto comp = bubble->getComposition();
-								// Get the correct bubble
-								if (comp[heType] == l+1 && comp[vType] == sigma3SizeVec[l]) {
-									// Check if this bubble is already in the indices
-									if (std::find(indices.begin(), indices.end(), m) == indices.end()) {
-										// Add this bubble to the indices
-										indices.push_back(m);
-									}
-								}
-							}
-						}
-					}
-				}
-
-				// Add indices to the index vector
-				temp1DVector.push_back(indices);
-			}
-
-			// Give the 1D vector to the 2D vector
-			temp2DVector.push_back(temp1DVector);
+			setSurfacePosition(surfacePos[j][k], j, k);
 		}
-
-		// Give the 2D vector to the final vector
-		indexVector.push_back(temp2DVector);
 	}
 
-	// Clear the memory
-	delete sigma3Handler;
+	return;
+}
+
+//--------------------------------------------------------------------------------
+void TrapMutationHandler::setSurfacePosition(int surfacePos, int yj, int zk) {
+	surfacePositions[zk][yj] = surfacePos;
+
+	// Compute the depth indices now so that the RHS and Jacobian evaluations
+	// never allocate
+	computeDepthIndices(surfacePos);
 
 	return;
 }
 
 //--------------------------------------------------------------------------------
 void TrapMutationHandler::updateTrapMutationRate(IReactionNetwork *network) {
-	// Get all the He clusters from the network
-	auto heClusters = network->getAll(heType);
+	// The He clusters were saved by initializeIndex*D(), the network only
+	// changed its rates
 
 	// Update the rate by finding the biggest rate in all the He clusters
 	kMutation = 0.0;
@@ -468,8 +343,7 @@ void TrapMutationHandler::updateDisappearingRate(double conc) {
 void TrapMutationHandler::computeTrapMutation(IReactionNetwork *network,
 		double *concOffset, double *updatedConcOffset,
 		int xi, int yj, int zk) {
-	// Get all the HeV bubbles
-	auto bubbles = network->getAll(heVType);
+	// The HeV bubbles were saved by initializeIndex*D()
 	// Initialyze the pointers to interstitial and helium clusters and their ID
 	PSICluster * iCluster = nullptr, * heCluster = nullptr, * bubble = nullptr;
 	int iIndex = -1, heIndex = -1, bubbleIndex = -1;
@@ -477,30 +351,44 @@ void TrapMutationHandler::computeTrapMutation(IReactionNetwork *network,
 	// Initialize the rate of the reaction
 	double rate = 0.0;
 
-	// Get the pointer to list of indices at this grid point
-	std::vector<int> * indices = &indexVector[zk][yj][xi];
-
-	// Loop on the list
-	for (int i = 0; i < indices->size(); i++) {
+	// Nothing happens at or left of the surface
+	const int surfacePos = surfacePositions[zk][yj];
+	if (xi <= surfacePos) return;
+
+	// Get the list of indices from the depth of this grid point (the one of
+	// the surface is empty) and the one from the grain boundaries
+	const auto & depthLists = depthIndices[surfacePos];
+	const auto & depthList = (xi - surfacePos < depthLists.size()) ?
+			depthLists[xi - surfacePos] : depthLists[0];
+	const auto & gbList = gbIndices[zk][yj];
+	const int nDepth = depthList.size();
+
+	// Loop on both lists, the bubbles from the grain boundaries that are
+	// already in the depth list are skipped
+	for (int i = 0; i < nDepth + gbList.size(); i++) {
 		// Get the stored bubble and its ID
-		bubble = (PSICluster *) bubbles[indices->at(i)];
+		int m = (i < nDepth) ? depthList[i] : gbList[i - nDepth];
+		if (i >= nDepth && std::find(depthList.begin(), depthList.end(), m)
+				!= depthList.end())
+			continue;
+		bubble = (PSICluster *) bubbles[m];
 		bubbleIndex = bubble->getId() - 1;
 
 		// Get the helium cluster with the same number of He and its ID
 		auto comp = bubble->getComposition();
-		heCluster = (PSICluster *) network->get(heType, comp[heType]);
+		heCluster = (PSICluster *) network->get(heType, comp[PSISpecies::He]);
 		heIndex = heCluster->getId() - 1;
 
 		// Get the interstitial cluster with the same number of I as the number
 		// of vacancies in the bubble and its ID
-		iCluster = (PSICluster *) network->get(iType, comp[vType]);
+		iCluster = (PSICluster *) network->get(iType, comp[PSISpecies::V]);
 		iIndex = iCluster->getId() - 1;
 
 		// Get the initial concentration of helium
 		double oldConc = concOffset[heIndex];
 
 		// Check the desorption
-		if (comp[heType] == desorp.size) {
+		if (comp[PSISpecies::He] == desorp.size) {
 			// Get the left side rate (combination + emission)
 			double totalRate = heCluster->getLeftSideRate();
 			// Define the trap-mutation rate taking into account the desorption
@@ -523,8 +411,7 @@ void TrapMutationHandler::computeTrapMutation(IReactionNetwork *network,
 int TrapMutationHandler::computePartialsForTrapMutation(
 		IReactionNetwork *network, double *val,
 		int *indices, int xi, int yj, int zk) {
-	// Get all the HeV bubbles
-	auto bubbles = network->getAll(heVType);
+	// The HeV bubbles were saved by initializeIndex*D()
 	// Initialyze the pointers to interstitial and helium clusters and their ID
 	PSICluster * iCluster = nullptr, * heCluster = nullptr, * bubble = nullptr;
 	int iIndex = -1, heIndex = -1, bubbleIndex = -1;
@@ -532,26 +419,44 @@ int TrapMutationHandler::computePartialsForTrapMutation(
 	// Initialize the rate of the reaction
 	double rate = 0.0;
 
-	// Get the pointer to list of indices at this grid point
-	std::vector<int> * clusterIndices = &indexVector[zk][yj][xi];
-	// Loop on the list
-	for (int i = 0; i < clusterIndices->size(); i++) {
+	// The number of helium clusters undergoing trap-mutation
+	int nMutating = 0;
+
+	// Nothing happens at or left of the surface
+	const int surfacePos = surfacePositions[zk][yj];
+	if (xi <= surfacePos) return 0;
+
+	// Get the list of indices from the depth of this grid point (the one of
+	// the surface is empty) and the one from the grain boundaries
+	const auto & depthLists = depthIndices[surfacePos];
+	const auto & depthList = (xi - surfacePos < depthLists.size()) ?
+			depthLists[xi - surfacePos] : depthLists[0];
+	const auto & gbList = gbIndices[zk][yj];
+	const int nDepth = depthList.size();
+
+	// Loop on both lists, the bubbles from the grain boundaries that are
+	// already in the depth list are skipped
+	for (int i = 0; i < nDepth + gbList.size(); i++) {
 		// Get the stored bubble and its ID
-		bubble = (PSICluster *) bubbles[clusterIndices->at(i)];
+		int m = (i < nDepth) ? depthList[i] : gbList[i - nDepth];
+		if (i >= nDepth && std::find(depthList.begin(), depthList.end(), m)
+				!= depthList.end())
+			continue;
+		bubble = (PSICluster *) bubbles[m];
 		bubbleIndex = bubble->getId() - 1;
 
 		// Get the helium cluster with the same number of He and its ID
 		auto comp = bubble->getComposition();
-		heCluster = (PSICluster *) network->get(heType, comp[heType]);
+		heCluster = (PSICluster *) network->get(heType, comp[PSISpecies::He]);
 		heIndex = heCluster->getId() - 1;
 
 		// Get the interstitial cluster with the same number of I as the number
 		// of vacancies in the bubble and its ID
-		iCluster = (PSICluster *) network->get(iType, comp[vType]);
+		iCluster = (PSICluster *) network->get(iType, comp[PSISpecies::V]);
 		iIndex = iCluster->getId() - 1;
 
 		// Check the desorption
-		if (comp[heType] == desorp.size) {
+		if (comp[PSISpecies::He] == desorp.size) {
 			// Get the left side rate (combination + emission)
 			double totalRate = heCluster->getLeftSideRate();
 			// Define the trap-mutation rate taking into account the desorption
@@ -562,19 +467,21 @@ int TrapMutationHandler::computePartialsForTrapMutation(
 		}
 
 		// Set the helium cluster partial derivative
-		indices[i * 3] = heIndex;
-		val[i * 3] = -rate;
+		indices[nMutating * 3] = heIndex;
+		val[nMutating * 3] = -rate;
 
 		// Set the bubble cluster partial derivative
-		indices[(i * 3) + 1] = bubbleIndex;
-		val[(i * 3) + 1] = rate;
+		indices[(nMutating * 3) + 1] = bubbleIndex;
+		val[(nMutating * 3) + 1] = rate;
 
 		// Set the interstitial cluster partial derivative
-		indices[(i * 3) + 2] = iIndex;
-		val[(i * 3) + 2] = rate;
+		indices[(nMutating * 3) + 2] = iIndex;
+		val[(nMutating * 3) + 2] = rate;
+
+		nMutating++;
 	}
 
-	return clusterIndices->size();
+	return nMutating;
 }
 
 }/* end namespace xolotlCore */
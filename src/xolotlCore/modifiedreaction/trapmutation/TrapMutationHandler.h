@@ -57,18 +57,83 @@ namespace xolotlCore
    bool attenuation;
 
 /**
- * The vector containing the indices of the bubbles created through modified
- * trap-mutation for each grid point. The difference between this vector and depthVec
- * is that this one is used for the actual computation whereas the other one is
- * defined by the user. indexVector is created with the depthVec information.
-*/
-   std::vector<std::vector<std::vector<std::vector<int>>>> indexVector;
+ * The grid in the depth direction, saved by initializeIndex*D().
+ */
+   std::vector<double> xGrid;
+
+/**
+ * The position of the surface for each grid point in the Z and Y directions.
+ */
+   std::vector<std::vector<int>> surfacePositions;
+
+/**
+ * For each helium size, the indices of the bubbles it trap-mutates into at the
+ * depth given by depthVec. The indices are the rank of the bubbles in the
+ * bubbles vector.
+ */
+   std::vector<std::vector<int>> depthBubbles;
+
+/**
+ * The indices of the bubbles created through modified trap-mutation close to
+ * the surface, for each position of the surface and then for each grid point
+ * starting at the surface. They only depend on the depth, so a move of the
+ * surface only changes the list that is used. The lists of a position are
+ * computed when the surface is set there the first time, up to the deepest
+ * grid point undergoing trap-mutation, and only read by the RHS and Jacobian.
+ */
+   std::vector<std::vector<std::vector<int>>> depthIndices;
+
+/**
+ * The indices of the bubbles created through modified trap-mutation close to
+ * the grain boundaries, for each grid point in the Z and Y directions. They
+ * are the same at every depth.
+ */
+   std::vector<std::vector<std::vector<int>>> gbIndices;
+
+/**
+ * The He clusters and the HeV bubbles of the network, saved when indexVector
+ * is created so that the computations at each grid point don't have to ask
+ * the network for new vectors.
+ */
+   std::vector<IReactant *> heClusters, bubbles;
 
 /**
  * The desorption information
  */
    Desorption desorp;
 
+/**
+ * Save the grid and size the vectors of indices, without any trap-mutation
+ * from the grain boundaries. It is called by initializeIndex*D() once the
+ * bubbles are saved.
+ *
+ * @param grid The grid on the x axis
+ * @param ny The number of grid points in the Y direction
+ * @param nz The number of grid points in the Z direction
+ */
+   void initializeSurfaceIndices( const std::vector<double> & grid, int ny, int nz );
+
+/**
+ * Compute the lists of indices from the depth at each grid point starting at
+ * the given position of the surface, if it was not done yet. The first list,
+ * the one of the surface, is empty.
+ *
+ * @param surfacePos The index of the position of the surface
+ */
+   void computeDepthIndices( int surfacePos );
+
+/**
+ * Fill the lists of indices from the grain boundaries for each grid point in
+ * the Z and Y directions.
+ *
+ * @param advectionHandlers The vector of advection handlers
+ * @param ny The number of grid points in the Y direction
+ * @param hy The step size in the Y direction
+ * @param nz The number of grid points in the Z direction
+ */
+   void initializeGBIndices( std::vector<IAdvectionHandler*> advectionHandlers,
+                             int ny, double hy, int nz );
+
 /**
  * This method fills two vectors to define the modified trap-mutation: for the first 
  * one, the first value corresponds to the depth at which the He1 cluster undergo 
@@ -108,6 +173,7 @@ namespace xolotlCore
  * This method defines which trap-mutation is allowed at each grid point.
  * The stored indices correspond to the HeV bubbles, and more precisely to their
  * rank in the bubbles vector obtained with bubbles = network->getAll(heVType).
+ * They are defined relative to the surface.
  *
  * \see ITrapMutationHandler.h
  */
@@ -119,6 +185,7 @@ namespace xolotlCore
  * This method defines which trap-mutation is allowed at each grid point.
  * The stored indices correspond to the HeV bubbles, and more precisely to their
  * rank in the bubbles vector obtained with bubbles = network->getAll(heVType).
+ * They are defined relative to the surface.
  *
  * \see ITrapMutationHandler.h
  */
@@ -130,6 +197,7 @@ namespace xolotlCore
  * This method defines which trap-mutation is allowed at each grid point.
  * The stored indices correspond to the HeV bubbles, and more precisely to their
  * rank in the bubbles vector obtained with bubbles = network->getAll(heVType).
+ * They are defined relative to the surface.
  *
  * \see ITrapMutationHandler.h
  */
@@ -139,6 +207,14 @@ namespace xolotlCore
                            std::vector<double> grid, int ny, double hy,
                            int nz, double hz );
 
+/**
+ * This method moves the surface, the indices are already defined relative
+ * to it and the ones of a new position are computed here.
+ *
+ * \see ITrapMutationHandler.h
+ */
+   void setSurfacePosition( int surfacePos, int yj = 0, int zk = 0 );
+
 /**
  * This method update the rate for the modified trap-mutation if the rates
  * changed in the network, it should be called when temperature changes
@@ -0,0 +1,99 @@
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+// Includes
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+namespace xolotlCore {
+
+/**
+ * This is a minimal allocator returning memory aligned on Alignment bytes.
+ * It is used by the containers whose content is read with vector instructions
+ * because the default allocator only guarantees the alignment of the
+ * fundamental types.
+ *
+ * Alignment must be a power of two and a multiple of sizeof(void *).
+ */
+template<class T, std::size_t Alignment>
+class AlignedAllocator {
+public:
+
+	typedef T value_type;
+	typedef T * pointer;
+	typedef const T * const_pointer;
+	typedef T & reference;
+	typedef const T & const_reference;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template<class U>
+	struct rebind {
+		typedef AlignedAllocator<U, Alignment> other;
+	};
+
+	//! The constructor
+	AlignedAllocator() {
+	}
+
+	//! The copy constructor from another type
+	template<class U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment> &) {
+	}
+
+	/**
+	 * Allocate the memory for n objects of type T.
+	 *
+	 * @param n The number of objects
+	 * @return The pointer to the aligned memory
+	 */
+	T * allocate(std::size_t n) {
+		void * ptr = nullptr;
+		if (posix_memalign(&ptr, Alignment, n * sizeof(T)) != 0)
+			throw std::bad_alloc();
+		return static_cast<T *>(ptr);
+	}
+
+	/**
+	 * Release the memory.
+	 *
+	 * @param ptr The pointer to the memory
+	 * @param n The number of objects
+	 */
+	void deallocate(T * ptr, std::size_t n) {
+		free(ptr);
+	}
+
+	//! Construct an object in place
+	template<class U, class ... Args>
+	void construct(U * ptr, Args&&... args) {
+		::new ((void *) ptr) U(std::forward<Args>(args)...);
+	}
+
+	//! Destroy an object in place
+	template<class U>
+	void destroy(U * ptr) {
+		ptr->~U();
+	}
+
+	//! The maximum number of objects that can be allocated
+	std::size_t max_size() const {
+		return std::size_t(-1) / sizeof(T);
+	}
+};
+
+template<class T, class U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment> &,
+		const AlignedAllocator<U, Alignment> &) {
+	return true;
+}
+
+template<class T, class U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment> &,
+		const AlignedAllocator<U, Alignment> &) {
+	return false;
+}
+
+} /* end namespace xolotlCore */
+#endif
@@ -0,0 +1,96 @@
+#ifndef COMPOSITION_H
+#define COMPOSITION_H
+
+// Includes
+#include <type_traits>
+
+namespace xolotlCore {
+
+/**
+ * The index of each species in the composition of a PSI cluster.
+ */
+enum class PSISpecies {
+	He = 0, V = 1, I = 2
+};
+
+/**
+ * The index of each species in the composition of a NE cluster.
+ */
+enum class NESpecies {
+	Xe = 0, V = 1, I = 2
+};
+
+/**
+ * This class holds the composition of a cluster: the number of atoms of
+ * the main species (helium for the PSI clusters, xenon for the NE clusters),
+ * the number of vacancies and the number of interstitials.
+ *
+ * It is a small fixed-size object that can be copied without any heap
+ * allocation. The amounts are accessed with the PSISpecies or NESpecies
+ * indices, depending on the family of the cluster.
+ */
+class Composition {
+
+private:
+
+	//! The number of species in a composition
+	static const int numSpecies = 3;
+
+	//! The amount of each species
+	int amounts[numSpecies];
+
+public:
+
+	//! The default constructor, the cluster is empty
+	Composition() :
+			amounts { 0, 0, 0 } {
+	}
+
+	/**
+	 * The constructor.
+	 *
+	 * @param numA The number of atoms of the main species
+	 * @param numV The number of vacancies
+	 * @param numI The number of interstitials
+	 */
+	Composition(int numA, int numV, int numI) :
+			amounts { numA, numV, numI } {
+	}
+
+	//! Access the amount of a PSI species
+	int & operator[](PSISpecies species) {
+		return amounts[static_cast<int>(species)];
+	}
+
+	//! Access the amount of a PSI species
+	int operator[](PSISpecies species) const {
+		return amounts[static_cast<int>(species)];
+	}
+
+	//! Access the amount of a NE species
+	int & operator[](NESpecies species) {
+		return amounts[static_cast<int>(species)];
+	}
+
+	//! Access the amount of a NE species
+	int operator[](NESpecies species) const {
+		return amounts[static_cast<int>(species)];
+	}
+
+	//! Check that two compositions are identical
+	bool operator==(const Composition & other) const {
+		return amounts[0] == other.amounts[0] && amounts[1] == other.amounts[1]
+				&& amounts[2] == other.amounts[2];
+	}
+
+	//! Check that two compositions are different
+	bool operator!=(const Composition & other) const {
+		return !(*this == other);
+	}
+};
+
+static_assert(std::is_trivially_copyable<Composition>::value,
+		"Composition must be trivially copyable.");
+
+} /* end namespace xolotlCore */
+#endif
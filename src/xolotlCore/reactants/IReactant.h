@@ -3,6 +3,7 @@
 
 // Includes
 #include "IReactionNetwork.h"
+#include "Composition.h"
 #include <memory>
 #include <vector>
 #include <map>
@@ -123,6 +124,16 @@ namespace xolotlCore
  */
    virtual std::vector<int> getConnectivity() const = 0;
 
+/**
+ * This operation returns the sparse version of the connectivity: the
+ * sorted indices (id - 1) of the reactants this reactant interacts with.
+ * It is equivalent to the positions of the ones in getConnectivity()
+ * without creating an array of the size of the network.
+ *
+ * @return The sorted indices of the connected reactants
+ */
+   virtual std::vector<int> getConnectivityIds() const = 0;
+
 /**
  * This operation returns the list of partial derivatives of this reactant
  * with respect to all other reactants in the network. The combined lists
@@ -167,13 +178,13 @@ namespace xolotlCore
    virtual std::string getType() const = 0;
 
 /**
- * This operation returns the composition of this reactant. This map is empty
- * when returned by the base class.
+ * This operation returns the composition of this reactant. The composition
+ * is empty when returned by the base class.
  *
- * @return The composition returned as a map with keys naming distinct
- * elements and values indicating the amount of the element present.
+ * @return The composition giving the amount of each species present,
+ * indexed by PSISpecies or NESpecies.
  */
-   virtual const std::map<std::string, int>& getComposition() const = 0;
+   virtual const Composition& getComposition() const = 0;
 
 /**
  * Get a string containing the canonical representation of the
@@ -368,6 +379,15 @@ namespace xolotlCore
  */
    virtual void updateRateConstants() = 0;
 
+/**
+ * Add the addresses of all the values of this reactant that depend on the
+ * temperature (its temperature, diffusion coefficient, biggest rate and the
+ * rate constants updated by updateRateConstants) to the given vector.
+ *
+ * @param slots The vector of addresses
+ */
+   virtual void getRateSlots(std::vector<double *> & slots) = 0;
+
 /**
  * This operation returns true if the cluster is a mixed-species or compound
  * cluster and false if it is a single species cluster.
@@ -2,15 +2,25 @@
 #define IREACTIONNETWORK_H
 
 #include "IReactant.h"
+#include "RateTable.h"
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <memory>
 
 namespace xolotlCore {
 
 class IReactant;
 
+/**
+ * A sparse representation of a dof x dof fill (connectivity) block of the
+ * Jacobian. Its keys are row indices (id - 1) and its values are the column
+ * indices of the non-zero entries of that row. Rows without any non-zero
+ * entry don't need to be present.
+ */
+typedef std::unordered_map<int, std::vector<int> > SparseFillMap;
+
 /**
  *  This class manages the set of reactants and compound reactants
  *  (combinations of normal reactants). It also manages a set of properties
@@ -43,6 +53,26 @@ public:
 	 */
 	virtual double getTemperature() const = 0;
 
+	/**
+	 * This operation sets the temperature of the network and stores all the
+	 * resulting temperature dependent values (diffusion coefficients and rate
+	 * constants) in a rate table. It has to be called after the
+	 * connectivities are initialized.
+	 *
+	 * @param temp The temperature
+	 * @param rates The rate table that will be filled
+	 */
+	virtual void computeRateTable(double temp, RateTable & rates) = 0;
+
+	/**
+	 * This operation loads a rate table computed by computeRateTable() in
+	 * the network. It is equivalent to setTemperature() with the temperature
+	 * of the table but nothing is recomputed.
+	 *
+	 * @param rates The rate table
+	 */
+	virtual void setRateTable(const RateTable & rates) = 0;
+
 	/**
 	 * This operation returns a reactant with the given type and size if it
 	 * exists in the network or null if not.
@@ -176,6 +206,17 @@ public:
 	 */
 	virtual void updateConcentrationsFromArray(double * concentrations) = 0;
 
+	/**
+	 * This operation fills an array of doubles with the concentrations of all
+	 * of the reactants and the momentums of the super clusters, in the layout
+	 * read by updateConcentrationsFromArray(), computeFluxes() and
+	 * computePartials().
+	 *
+	 * @param concentrations The array that will be filled, its size is
+	 * getDOF()
+	 */
+	virtual void fillDOFArray(double * concentrations) = 0;
+
 	/**
 	 * Request that all reactants in the network release their
 	 * pointers to the network, to break cycles and allow the
@@ -194,10 +235,32 @@ public:
 
 	/**
 	 * Get the diagonal fill for the Jacobian, corresponding to the reactions.
+	 * It also builds the sparse (CSR) pattern of the partial derivatives
+	 * returned by computeAllPartials().
+	 *
+	 * @param diagFill The map where the connectivity information is kept,
+	 * the column indices of each row are sorted
+	 */
+	virtual void getDiagonalFill(SparseFillMap &diagFill) = 0;
+
+	/**
+	 * Get the row pointers of the compressed sparse row (CSR) pattern of the
+	 * partial derivatives. It has dof + 1 entries, the entries of row i
+	 * (the cluster or momentum of id i + 1) are located between rowPtr[i]
+	 * and rowPtr[i + 1] - 1. It is only valid after getDiagonalFill().
 	 *
-	 * @param diagFill The pointer to the vector where the connectivity information is kept
+	 * @return The row pointers
 	 */
-	virtual void getDiagonalFill(int *diagFill) = 0;
+	virtual const std::vector<int> & getPartialsRowPointers() const = 0;
+
+	/**
+	 * Get the column indices of the compressed sparse row (CSR) pattern of
+	 * the partial derivatives, sorted within each row. It is only valid after
+	 * getDiagonalFill().
+	 *
+	 * @return The column indices
+	 */
+	virtual const std::vector<int> & getPartialsColumnIds() const = 0;
 
 	/**
 	 * Get the total concentration of atoms in the network.
@@ -240,14 +303,45 @@ public:
 	 * Compute the partial derivatives generated by all the reactions
 	 * for all the clusters and their momentum.
 	 *
+	 * The values are written in place following the CSR pattern given by
+	 * getPartialsRowPointers() and getPartialsColumnIds().
+	 *
+	 * @param vals The pointer to the array that will contain the values of
+	 * partials for the reactions, it must hold getPartialsRowPointers()[dof]
+	 * entries
+	 */
+	virtual void computeAllPartials(double *vals) = 0;
+
+	/**
+	 * Compute the fluxes generated by all the reactions for all the clusters
+	 * and their momentum, like computeAllFluxes(), but only from the given
+	 * concentrations and rate table. The state of the network and of its
+	 * reactants is neither read nor modified so several grid points can be
+	 * computed at the same time.
+	 *
+	 * @param concs The concentrations at the grid point, indexed by id - 1
+	 * @param updatedConcOffset The pointer to the array where the fluxes are
+	 * added
+	 * @param rates The rate table at the temperature of the grid point
+	 */
+	virtual void computeFluxes(const double *concs, double *updatedConcOffset,
+			const RateTable & rates) const = 0;
+
+	/**
+	 * Compute the partial derivatives generated by all the reactions for all
+	 * the clusters and their momentum, like computeAllPartials(), but only
+	 * from the given concentrations and rate table. The state of the network
+	 * and of its reactants is neither read nor modified so several grid
+	 * points can be computed at the same time.
+	 *
+	 * @param concs The concentrations at the grid point, indexed by id - 1
 	 * @param vals The pointer to the array that will contain the values of
-	 * partials for the reactions
-	 * @param indices The pointer to the array that will contain the indices
-	 * of the clusters for the partial derivatives
-	 * @param size The pointer to the array that will contain the number of reactions for
-	 * this cluster
+	 * partials for the reactions, in the same CSR pattern as
+	 * computeAllPartials()
+	 * @param rates The rate table at the temperature of the grid point
 	 */
-	virtual void computeAllPartials(double *vals, int *indices, int *size) = 0;
+	virtual void computePartials(const double *concs, double *vals,
+			const RateTable & rates) const = 0;
 
 	/**
 	 * Are reactions enabled?
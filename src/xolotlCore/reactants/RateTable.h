@@ -0,0 +1,38 @@
+#ifndef RATETABLE_H
+#define RATETABLE_H
+
+// Includes
+#include <vector>
+
+namespace xolotlCore {
+
+/**
+ * This class holds all the temperature dependent values of a reaction
+ * network computed at a given temperature: the temperature, the diffusion
+ * coefficient and the biggest production rate of each reactant, and the
+ * rate constants of all the reactions.
+ *
+ * It is filled by IReactionNetwork::computeRateTable() and loaded back in
+ * the network with IReactionNetwork::setRateTable(), which is much cheaper
+ * than recomputing all the rates when the temperature varies on the grid.
+ * The order of the values is defined by the network and is only valid until
+ * its connectivities are reinitialized.
+ */
+class RateTable {
+
+public:
+
+	//! The temperature at which the values were computed
+	double temperature;
+
+	//! The values, in the order defined by the network
+	std::vector<double> values;
+
+	//! The constructor
+	RateTable() :
+			temperature(0.0) {
+	}
+};
+
+} /* end namespace xolotlCore */
+#endif
@@ -18,11 +18,6 @@ Reactant::Reactant() : concentration(0.0), id(0), xeMomId(0), heMomId(0), vMomId
                        migrationEnergy(0.0), name("Reactant"), reactionRadius(0.0), 
                        biggestRate(0.0) 
 {
- // Setup the composition map.
- compositionMap[xeType] = 0;
- compositionMap[heType] = 0;
- compositionMap[vType]  = 0;
- compositionMap[iType]  = 0;
 }
 
 //--------------------------------------------------------------------------------
@@ -33,11 +28,6 @@ Reactant::Reactant( std::shared_ptr<xolotlPerf::IHandlerRegistry> registry ) :
           diffusionFactor(0.0), diffusionCoefficient(0.0), migrationEnergy(0.0), 
           name("Reactant"), reactionRadius(0.0), biggestRate(0.0) 
 {
-// Setup the composition map.
- compositionMap[xeType] = 0;
- compositionMap[heType] = 0;
- compositionMap[vType] = 0;
- compositionMap[iType] = 0;
 }
 
 //--------------------------------------------------------------------------------
@@ -45,7 +35,8 @@ Reactant::Reactant( Reactant& other ) : concentration(other.concentration),
           name(other.name), typeName(other.typeName), id(other.id), 
           xeMomId(other.xeMomId), heMomId(other.heMomId), vMomId(other.vMomId), 
           temperature(other.temperature), network(other.network), 
-          handlerRegistry(other.handlerRegistry), size(other.size), 
+          handlerRegistry(other.handlerRegistry), 
+          composition(other.composition), size(other.size), 
           formationEnergy(other.formationEnergy), 
           diffusionFactor(other.diffusionFactor), 
           diffusionCoefficient(other.diffusionCoefficient), 
@@ -55,11 +46,6 @@ Reactant::Reactant( Reactant& other ) : concentration(other.concentration),
           reactionConnectivitySet(other.reactionConnectivitySet), 
           dissociationConnectivitySet( other.dissociationConnectivitySet) 
 {
-// Setup the composition map.
- compositionMap[xeType] = other.compositionMap[xeType];
- compositionMap[heType] = other.compositionMap[heType];
- compositionMap[vType] = other.compositionMap[vType];
- compositionMap[iType] = other.compositionMap[iType];
 }
 
 //--------------------------------------------------------------------------------
@@ -192,6 +178,14 @@ Reactant::getConnectivity() const
  return connectivity;
 }
 
+//--------------------------------------------------------------------------------
+std::vector<int> 
+Reactant::getConnectivityIds() const 
+{
+// This reactant is only connected to itself by default
+ return std::vector<int>(1, id - 1);
+}
+
 //--------------------------------------------------------------------------------
 std::vector<double> 
 Reactant::getPartialDerivatives() const 
@@ -227,37 +221,24 @@ Reactant::getType() const
 }
 
 //--------------------------------------------------------------------------------
-const std::map<std::string, int>& 
+const Composition& 
 Reactant::getComposition() const 
 {
-// Return the composition map
- return compositionMap;
+ return composition;
 }
 
 //--------------------------------------------------------------------------------
 std::string 
 Reactant::toCanonicalString( std::string type, 
-                             const std::map<std::string, int>& composition) 
+                             const Composition& composition) 
 {
 // Construct the canonical string representation of the given composition.
-// Note that this can only be considered to produce a canonical representation of the 
-// reactant map's contents if the reactant map is kept in a collection where we are 
-// guaranteed that iterating over its contents will always be done in the same order, 
-// regardless of how the map was produced. Thankfully, std::map is an ordered map and 
-// gives this guarantee.
- std::ostringstream ostr;
- ostr << type << ':';
-// std::cout << "**************************************************" << std::endl;
- for ( auto iter = composition.begin(); iter != composition.end(); ++iter )
- {
-// Add the current reactant's name and size to the string.
-// Note that we don't really care about nice formatting, since
+// The species are always written in the same order so the representation
+// is canonical. Note that we don't really care about nice formatting, since
 // this isn't intended to be a human-readable string.
-//  std::cout << "first = " << iter->first << std::endl;
-//  std::cout << "secon = " << iter->second << std::endl;
-  ostr << iter->first << iter->second;
-//  std::cout << ostr.str() << std::endl;
- }
+ std::ostringstream ostr;
+ ostr << type << ':' << composition[PSISpecies::He] << ':'
+      << composition[PSISpecies::V] << ':' << composition[PSISpecies::I];
  return ostr.str();
 }
 
@@ -273,7 +254,7 @@ Reactant::getCompositionString() const
 // so that no changes to it could be made without us knowing about it.
 // (i.e., need a protected function for derived classes to make changes,
 // and the map itself becomes private to us.)
- return toCanonicalString(getType(), compositionMap);
+ return toCanonicalString(getType(), composition);
 }
 
 //--------------------------------------------------------------------------------
@@ -450,3 +431,37 @@ Reactant::updateRateConstants()
 
  return;
 }
+
+//--------------------------------------------------------------------------------
+bool 
+Reactant::fillStateScratch() const 
+{
+// Nothing to compute outside of a network
+ if (!network || id <= 0) return false;
+
+// The concentrations and momentums
+ concScratch.resize(network->getDOF());
+ network->fillDOFArray(concScratch.data());
+
+// The temperature dependent values, getRateSlots() only returns their addresses
+ std::vector<double *> slots;
+ const_cast<Reactant *>(this)->getRateSlots(slots);
+ rateScratch.resize(slots.size());
+ for (int i = 0; i < slots.size(); i++) 
+ {
+  rateScratch[i] = *(slots[i]);
+ }
+
+ return true;
+}
+
+//--------------------------------------------------------------------------------
+void 
+Reactant::getRateSlots(std::vector<double *> & slots) 
+{
+ slots.push_back(&temperature);
+ slots.push_back(&diffusionCoefficient);
+ slots.push_back(&biggestRate);
+
+ return;
+}
@@ -81,9 +81,9 @@ protected:
 	std::shared_ptr<IReactionNetwork> network;
 
 	/**
-	 * The map that contains the composition of this cluster.
+	 * The composition of this cluster.
 	 */
-	std::map<std::string, int> compositionMap;
+	Composition composition;
 
 	/**
 	 * The performance handler registry that will be used with
@@ -149,6 +149,14 @@ protected:
 	 */
 	std::set<int> dissociationConnectivitySet;
 
+	/**
+	 * The scratch arrays holding the current concentrations of the network
+	 * and the temperature dependent values of this reactant, filled by
+	 * fillStateScratch().
+	 */
+	mutable std::vector<double> concScratch;
+	mutable std::vector<double> rateScratch;
+
 	/**
 	 * Calculate the reaction constant dependent on the
 	 * reaction radii and the diffusion coefficients for the
@@ -182,6 +190,18 @@ protected:
 	 */
 	void recomputeDiffusionCoefficient(double temp);
 
+	/**
+	 * This operation copies the current concentrations of the network and the
+	 * values of this reactant that depend on the temperature, in the order of
+	 * getRateSlots(), to concScratch and rateScratch. This is how the fluxes
+	 * and partial derivatives computed from the state of the reactants reuse
+	 * the ones computed from a concentration array and a rate table.
+	 *
+	 * @return False if the reactant is not in a network, it then doesn't
+	 * take part in any reaction
+	 */
+	bool fillStateScratch() const;
+
 	/**
 	 * The constructor.
 	 */
@@ -302,6 +322,14 @@ public:
 	 */
 	virtual std::vector<int> getConnectivity() const;
 
+	/**
+	 * This operation returns the sorted indices (id - 1) of the reactants
+	 * this reactant interacts with, the sparse version of getConnectivity().
+	 *
+	 * @return The sorted indices of the connected reactants
+	 */
+	virtual std::vector<int> getConnectivityIds() const;
+
 	/**
 	 * This operation returns the list of partial derivatives of this reactant
 	 * with respect to all other reactants in the network. The combined lists
@@ -346,13 +374,13 @@ public:
 	std::string getType() const;
 
 	/**
-	 * This operation returns the composition of this reactant. This map is empty
-	 * when returned by the base class.
+	 * This operation returns the composition of this reactant. The composition
+	 * is empty when returned by the base class.
 	 *
-	 * @return The composition returned as a map with keys naming distinct
-	 * elements and values indicating the amount of the element present.
+	 * @return The composition giving the amount of each species present,
+	 * indexed by PSISpecies or NESpecies.
 	 */
-	virtual const std::map<std::string, int> & getComposition() const;
+	virtual const Composition & getComposition() const;
 
 	/**
 	 * Get a string containing the canonical representation of the
@@ -550,6 +578,14 @@ public:
 	 */
 	virtual void updateRateConstants();
 
+	/**
+	 * Add the addresses of all the values of this reactant that depend on the
+	 * temperature to the given vector.
+	 *
+	 * @param slots The vector of addresses
+	 */
+	virtual void getRateSlots(std::vector<double *> & slots);
+
 	/**
 	 * This operation returns true if the cluster is a mixed-species or compound
 	 * cluster and false if it is a single species cluster.
@@ -566,13 +602,12 @@ public:
 	 * the composition maps themselves).
 	 *
 	 * @param type The type that will be used with the given composition.
-	 * @param composition A map containing the names and amounts of each
-	 * part of the reactant.
+	 * @param composition The composition of the reactant.
 	 * @return A string containing the canonical representation of our
 	 * composition.
 	 */
 	static std::string toCanonicalString(std::string type,
-			const std::map<std::string, int>& composition);
+			const Composition& composition);
 
 };
 
@@ -0,0 +1,152 @@
+#ifndef REACTANTLOOKUPTABLE_H
+#define REACTANTLOOKUPTABLE_H
+
+// Includes
+#include "IReactant.h"
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+namespace xolotlCore {
+
+/**
+ * This class gives access to the reactants of a network from their
+ * composition in three species: the main species (helium or xenon), the
+ * vacancies and the interstitials, without building any string.
+ *
+ * Because a cluster never contains vacancies and interstitials at the same
+ * time, the reactants are stored in a dense two-dimensional table indexed by
+ * the size of the main species and by the difference between the number of
+ * vacancies and the number of interstitials. The table grows as reactants
+ * are added. The very unlikely compositions with both vacancies and
+ * interstitials are kept in a hash map instead.
+ */
+class ReactantLookupTable {
+
+private:
+
+	//! The maximum size of the main species in the table
+	int maxA;
+
+	//! The maximum number of vacancies in the table
+	int maxV;
+
+	//! The maximum number of interstitials in the table
+	int maxI;
+
+	//! The dense table, of size (maxA + 1) * (maxV + maxI + 1)
+	std::vector<IReactant *> table;
+
+	//! The reactants with both vacancies and interstitials
+	std::unordered_map<long long, IReactant *> overflowMap;
+
+	/**
+	 * Get the position of a composition in the dense table.
+	 */
+	int getIndex(int a, int v, int i) const {
+		return a * (maxV + maxI + 1) + (v - i + maxI);
+	}
+
+	/**
+	 * Get the key of a composition in the overflow map.
+	 */
+	static long long getKey(int a, int v, int i) {
+		return ((long long) a << 42) | ((long long) v << 21) | (long long) i;
+	}
+
+	/**
+	 * Enlarge the dense table so that it can hold the given composition. The
+	 * exceeded bounds are at least doubled to limit the number of copies.
+	 */
+	void grow(int a, int v, int i) {
+		int newMaxA = (a > maxA) ? std::max(a, 2 * maxA) : maxA;
+		int newMaxV = (v > maxV) ? std::max(v, 2 * maxV) : maxV;
+		int newMaxI = (i > maxI) ? std::max(i, 2 * maxI) : maxI;
+
+		std::vector<IReactant *> newTable(
+				(newMaxA + 1) * (newMaxV + newMaxI + 1), nullptr);
+		// Copy the current content
+		for (int m = 0; m <= maxA; m++) {
+			for (int n = -maxI; n <= maxV; n++) {
+				newTable[m * (newMaxV + newMaxI + 1) + (n + newMaxI)] = table[m
+						* (maxV + maxI + 1) + (n + maxI)];
+			}
+		}
+
+		table.swap(newTable);
+		maxA = newMaxA, maxV = newMaxV, maxI = newMaxI;
+
+		return;
+	}
+
+public:
+
+	//! The constructor
+	ReactantLookupTable() :
+			maxA(-1), maxV(0), maxI(0) {
+	}
+
+	/**
+	 * Get the reactant with the given composition.
+	 *
+	 * @param a The size of the main species
+	 * @param v The number of vacancies
+	 * @param i The number of interstitials
+	 * @return The reactant or nullptr if it is not in the table
+	 */
+	IReactant * get(int a, int v, int i) const {
+		if (a < 0 || v < 0 || i < 0)
+			return nullptr;
+		if (v > 0 && i > 0) {
+			auto it = overflowMap.find(getKey(a, v, i));
+			return (it == overflowMap.end()) ? nullptr : it->second;
+		}
+		if (a > maxA || v > maxV || i > maxI)
+			return nullptr;
+		return table[getIndex(a, v, i)];
+	}
+
+	/**
+	 * Set the reactant with the given composition. Setting a null pointer
+	 * removes the reactant from the table.
+	 *
+	 * @param a The size of the main species
+	 * @param v The number of vacancies
+	 * @param i The number of interstitials
+	 * @param reactant The reactant
+	 */
+	void set(int a, int v, int i, IReactant * reactant) {
+		if (a < 0 || v < 0 || i < 0)
+			return;
+		if (v > 0 && i > 0) {
+			if (reactant)
+				overflowMap[getKey(a, v, i)] = reactant;
+			else
+				overflowMap.erase(getKey(a, v, i));
+			return;
+		}
+		if (a > maxA || v > maxV || i > maxI) {
+			// Nothing to remove
+			if (!reactant)
+				return;
+			grow(a, v, i);
+		}
+		table[getIndex(a, v, i)] = reactant;
+
+		return;
+	}
+
+	/**
+	 * Remove all the reactants from the table.
+	 */
+	void clear() {
+		table.clear();
+		overflowMap.clear();
+		maxA = -1, maxV = 0, maxI = 0;
+
+		return;
+	}
+};
+
+} /* end namespace xolotlCore */
+#endif
@@ -60,6 +60,31 @@ ReactionNetwork::ReactionNetwork( const ReactionNetwork& other )
  return;
 }
 
+//--------------------------------------------------------------------------------
+void 
+ReactionNetwork::setDiagonalFillPattern( 
+                 const std::vector<std::vector<int> > &columnIds )
+{
+ const int nRows = columnIds.size();
+
+// Count the entries to allocate the pattern only once
+ dFillRowPtr.assign(nRows + 1, 0);
+ for (int i = 0; i < nRows; i++) 
+ {
+  dFillRowPtr[i + 1] = dFillRowPtr[i] + columnIds[i].size();
+ }
+
+// Copy the column ids, they are already sorted within each row
+ dFillColIds.clear();
+ dFillColIds.reserve(dFillRowPtr[nRows]);
+ for (int i = 0; i < nRows; i++) 
+ {
+  dFillColIds.insert(dFillColIds.end(), columnIds[i].begin(), columnIds[i].end());
+ }
+
+ return;
+}
+
 //--------------------------------------------------------------------------------
 void 
 ReactionNetwork::fillConcentrationsArray( double* concentrations )
@@ -140,6 +165,125 @@ ReactionNetwork::getTemperature() const
  return temperature;
 }
 
+//--------------------------------------------------------------------------------
+void 
+ReactionNetwork::buildRateSlots() 
+{
+ rateSlots.clear();
+ rateOffsets.assign(networkSize, 0);
+
+// Each reactant gives the addresses of its own values
+ for (int i = 0; i < networkSize; i++) 
+ {
+  rateOffsets[i] = rateSlots.size();
+  allReactants->at(i)->getRateSlots(rateSlots);
+ }
+ rateSlots.shrink_to_fit();
+
+ return;
+}
+
+//--------------------------------------------------------------------------------
+void 
+ReactionNetwork::computeRateTable(double temp, RateTable & rates) 
+{
+// Compute all the rates at this temperature
+ setTemperature(temp);
+
+// Save them in the table
+ fillRateTable(rates);
+
+ return;
+}
+
+//--------------------------------------------------------------------------------
+void 
+ReactionNetwork::fillRateTable(RateTable & rates) const 
+{
+ rates.temperature = temperature;
+ rates.values.resize(rateSlots.size());
+ for (int i = 0; i < rateSlots.size(); i++) 
+ {
+  rates.values[i] = *(rateSlots[i]);
+ }
+
+ return;
+}
+
+//--------------------------------------------------------------------------------
+void 
+ReactionNetwork::fillStateScratch() 
+{
+ stateConcentrations.resize(getDOF());
+ fillDOFArray(stateConcentrations.data());
+ fillRateTable(stateRates);
+
+ return;
+}
+
+//--------------------------------------------------------------------------------
+void 
+ReactionNetwork::computeAllFluxes(double *updatedConcOffset) 
+{
+// The fluxes only have one implementation, the stateless one
+ fillStateScratch();
+ computeFluxes(stateConcentrations.data(), updatedConcOffset, stateRates);
+
+ return;
+}
+
+//--------------------------------------------------------------------------------
+void 
+ReactionNetwork::computeAllPartials(double *vals) 
+{
+// The partial derivatives only have one implementation, the stateless one
+ fillStateScratch();
+ computePartials(stateConcentrations.data(), vals, stateRates);
+
+ return;
+}
+
+//--------------------------------------------------------------------------------
+void 
+ReactionNetwork::checkRateTable(const RateTable & rates) const 
+{
+ if (rates.values.size() != rateSlots.size()) 
+ {
+  throw std::string("ReactionNetwork Message: "
+                    "the rate table does not match the network.");
+ }
+
+ return;
+}
+
+//--------------------------------------------------------------------------------
+double * 
+ReactionNetwork::getThreadScratch(int size) 
+{
+// Each thread keeps its own array, it only grows
+ static thread_local std::vector<double> scratch;
+ if (scratch.size() < size) scratch.resize(size, 0.0);
+
+ return scratch.data();
+}
+
+//--------------------------------------------------------------------------------
+void 
+ReactionNetwork::setRateTable(const RateTable & rates) 
+{
+// The table has to come from this network
+ checkRateTable(rates);
+
+ temperature = rates.temperature;
+// Copy the values back in the reactants
+ for (int i = 0; i < rateSlots.size(); i++) 
+ {
+  *(rateSlots[i]) = rates.values[i];
+ }
+
+ return;
+}
+
 //--------------------------------------------------------------------------------
 IReactant* 
 ReactionNetwork::get(const std::string& type, const int size) const 
@@ -87,12 +87,45 @@ protected:
 	std::shared_ptr<std::vector<IReactant *> > allReactants;
 
 	/**
-	 * A map for storing the dfill configuration and accelerating the formation of
-	 * the Jacobian. Its keys are reactant/cluster ids and its values are integer
-	 * vectors of the column ids that are marked as connected for that cluster in
-	 * the dfill array.
+	 * The row pointers of the compressed sparse row (CSR) pattern of the dfill
+	 * configuration. Row i (the reactant or momentum of id i + 1) owns the
+	 * entries dFillRowPtr[i] to dFillRowPtr[i + 1] - 1 of dFillColIds and of
+	 * the values computed by computeAllPartials().
 	 */
-	std::unordered_map<int, std::vector<int> > dFillMap;
+	std::vector<int> dFillRowPtr;
+
+	/**
+	 * The column ids of the CSR pattern of the dfill configuration.
+	 */
+	std::vector<int> dFillColIds;
+
+	/**
+	 * The current concentrations and momentums of the network, copied by
+	 * fillStateScratch() so that computeAllFluxes() and computeAllPartials()
+	 * can use computeFluxes() and computePartials().
+	 */
+	std::vector<double> stateConcentrations;
+
+	/**
+	 * The current temperature dependent values of the reactants, copied by
+	 * fillStateScratch() with the concentrations.
+	 */
+	RateTable stateRates;
+
+	/**
+	 * The addresses of all the temperature dependent values of the
+	 * reactants, in the order used by the rate tables. It is built by
+	 * buildRateSlots() when the connectivities are reinitialized.
+	 */
+	std::vector<double *> rateSlots;
+
+	/**
+	 * The position of the first value of each reactant in the rate tables,
+	 * in the order of allReactants. The values of a reactant are its
+	 * temperature, diffusion coefficient and biggest rate followed by its
+	 * rate constants, in the order given by its getRateSlots().
+	 */
+	std::vector<int> rateOffsets;
 
 	/**
 	 * The current temperature at which the network's clusters exist.
@@ -155,6 +188,63 @@ protected:
 	 */
 	ReactionNetwork();
 
+	/**
+	 * Build the CSR pattern of the partial derivatives from the column ids
+	 * of each row.
+	 *
+	 * @param columnIds The connected column ids of each row, its size is dof
+	 */
+	void setDiagonalFillPattern(const std::vector<std::vector<int> > &columnIds);
+
+	/**
+	 * Gather the addresses of the temperature dependent values of all the
+	 * reactants. It has to be called each time the reactions of the
+	 * reactants are redefined.
+	 */
+	void buildRateSlots();
+
+	/**
+	 * Move the partial derivatives of one row from the given dense scratch
+	 * array to the CSR values and reset the corresponding scratch entries to
+	 * zero.
+	 *
+	 * @param rowId The index of the row (id - 1)
+	 * @param scratch The dense partial derivatives of the row
+	 * @param vals The CSR values
+	 */
+	void gatherPartials(int rowId, double *scratch, double *vals) const {
+		const int end = dFillRowPtr[rowId + 1];
+		for (int k = dFillRowPtr[rowId]; k < end; k++) {
+			vals[k] = scratch[dFillColIds[k]];
+			// Reset the value to zero, much faster than using memset
+			scratch[dFillColIds[k]] = 0.0;
+		}
+	}
+
+	/**
+	 * Check that a rate table was computed by this network with its current
+	 * reactions, throw an exception otherwise.
+	 *
+	 * @param rates The rate table
+	 */
+	void checkRateTable(const RateTable & rates) const;
+
+	/**
+	 * Get a dense scratch array owned by the calling thread, used by the
+	 * stateless partial derivatives. It is filled with zeros and has to be
+	 * given back that way.
+	 *
+	 * @param size The minimum size of the array
+	 * @return The scratch array
+	 */
+	static double * getThreadScratch(int size);
+
+	/**
+	 * Copy the current concentrations and temperature dependent values of the
+	 * network to stateConcentrations and stateRates.
+	 */
+	void fillStateScratch();
+
 public:
 
 	/**
@@ -195,6 +285,34 @@ public:
 	 */
 	virtual double getTemperature() const;
 
+	/**
+	 * This operation sets the temperature of the network and stores all the
+	 * resulting temperature dependent values (diffusion coefficients and rate
+	 * constants) in a rate table. It has to be called after the
+	 * connectivities are initialized.
+	 *
+	 * @param temp The temperature
+	 * @param rates The rate table that will be filled
+	 */
+	void computeRateTable(double temp, RateTable & rates);
+
+	/**
+	 * This operation loads a rate table computed by computeRateTable() in
+	 * the network. It is equivalent to setTemperature() with the temperature
+	 * of the table but nothing is recomputed.
+	 *
+	 * @param rates The rate table
+	 */
+	void setRateTable(const RateTable & rates);
+
+	/**
+	 * This operation stores the current temperature dependent values of the
+	 * network in a rate table, without recomputing them.
+	 *
+	 * @param rates The rate table that will be filled
+	 */
+	void fillRateTable(RateTable & rates) const;
+
 	/**
 	 * This operation returns a reactant with the given type and size if it
 	 * exists in the network or null if not.
@@ -334,6 +452,17 @@ public:
 	 */
 	virtual void updateConcentrationsFromArray(double * concentrations);
 
+	/**
+	 * This operation fills an array of doubles with the concentrations of all
+	 * of the reactants, there are no super clusters here.
+	 *
+	 * @param concentrations The array that will be filled, its size is
+	 * getDOF()
+	 */
+	virtual void fillDOFArray(double * concentrations) {
+		fillConcentrationsArray(concentrations);
+	}
+
 	/**
 	 * Request that all reactants in the network release their
 	 * pointers to the network, to break cycles and allow the
@@ -356,12 +485,32 @@ public:
 	 * Do nothing here, this method need to be implemented in
 	 * subclasses.
 	 *
-	 * @param diagFill The pointer to the vector where the connectivity information is kept
+	 * @param diagFill The map where the connectivity information is kept
 	 */
-	virtual void getDiagonalFill(int *diagFill) {
+	virtual void getDiagonalFill(SparseFillMap &diagFill) {
 		return;
 	}
 
+	/**
+	 * Get the row pointers of the compressed sparse row (CSR) pattern of the
+	 * partial derivatives.
+	 *
+	 * @return The row pointers
+	 */
+	const std::vector<int> & getPartialsRowPointers() const {
+		return dFillRowPtr;
+	}
+
+	/**
+	 * Get the column indices of the compressed sparse row (CSR) pattern of
+	 * the partial derivatives.
+	 *
+	 * @return The column indices
+	 */
+	const std::vector<int> & getPartialsColumnIds() const {
+		return dFillColIds;
+	}
+
 	/**
 	 * Get the total concentration of atoms contained in the network.
 	 *
@@ -410,33 +559,25 @@ public:
 	 * Compute the fluxes generated by all the reactions
 	 * for all the clusters and their momentum.
 	 *
-	 * Do nothing here, this method need to be implemented in
-	 * subclasses.
+	 * They are computed by computeFluxes() from the current concentrations
+	 * and rates of the network.
 	 *
 	 * @param updatedConcOffset The pointer to the array of the concentration at the grid
 	 * point where the fluxes are computed used to find the next solution
 	 */
-	virtual void computeAllFluxes(double *updatedConcOffset) {
-		return;
-	}
+	virtual void computeAllFluxes(double *updatedConcOffset);
 
 	/**
 	 * Compute the partial derivatives generated by all the reactions
 	 * for all the clusters and their momentum.
 	 *
-	 * Do nothing here, this method need to be implemented in
-	 * subclasses.
+	 * They are computed by computePartials() from the current concentrations
+	 * and rates of the network.
 	 *
 	 * @param vals The pointer to the array that will contain the values of
 	 * partials for the reactions
-	 * @param indices The pointer to the array that will contain the indices
-	 * of the clusters
-	 * @param size The pointer to the array that will contain the number of reactions for
-	 * this cluster
 	 */
-	virtual void computeAllPartials(double *vals, int *indices, int *size) {
-		return;
-	}
+	virtual void computeAllPartials(double *vals);
 
 	/**
 	 * Are reactions enabled?
@@ -2,6 +2,8 @@
 #include <xolotlPerf.h>
 #include <Constants.h>
 #include <MathUtils.h>
+#include <algorithm>
+#include <iterator>
 
 using namespace xolotlCore;
 
@@ -179,25 +181,24 @@ void NECluster::emitClusters(NECluster * firstEmittedCluster,
 void NECluster::combineClusters(std::vector<IReactant *> & reactants,
 		const std::string& productName) {
 	// Initial declarations
-	std::map<std::string, int> myComposition = getComposition(),
-			secondComposition;
+	Composition myComposition = getComposition(), secondComposition;
 	int numXe = 0, numV = 0, numI = 0, secondNumXe = 0, secondNumV = 0,
 			secondNumI = 0, productSize = 0;
 	std::vector<int> compositionSizes { 0, 0, 0 };
 	NECluster *productCluster = nullptr, *secondCluster = nullptr;
 	// Setup the composition variables for this cluster
-	numXe = myComposition[xeType];
-	numV = myComposition[vType];
-	numI = myComposition[iType];
+	numXe = myComposition[NESpecies::Xe];
+	numV = myComposition[NESpecies::V];
+	numI = myComposition[NESpecies::I];
 
 	int reactantVecSize = reactants.size();
 	for (int i = 0; i < reactantVecSize; i++) {
 		// Get the second reactant, its composition and its index
 		secondCluster = (NECluster *) reactants[i];
 		secondComposition = secondCluster->getComposition();
-		secondNumXe = secondComposition[xeType];
-		secondNumV = secondComposition[vType];
-		secondNumI = secondComposition[iType];
+		secondNumXe = secondComposition[NESpecies::Xe];
+		secondNumV = secondComposition[NESpecies::V];
+		secondNumI = secondComposition[NESpecies::I];
 		// Compute the product size
 		productSize = size + secondCluster->size;
 		// Get and handle product for compounds
@@ -346,148 +347,154 @@ double NECluster::getMomentum() const {
 }
 
 double NECluster::getTotalFlux() {
-	// Get the fluxes
-	double prodFlux = getProductionFlux();
-	double dissFlux = getDissociationFlux();
-	double combFlux = getCombinationFlux();
-	double emissFlux = getEmissionFlux();
+	// Compute it from the current concentrations and rates
+	if (!fillStateScratch())
+		return 0.0;
 
-	return prodFlux - combFlux + dissFlux - emissFlux;
+	return computeFlux(concScratch.data(), rateScratch.data());
 }
 
 double NECluster::getDissociationFlux() const {
-	// Initial declarations
-	int nPairs = 0;
-	double flux = 0.0;
-	NECluster *dissociatingCluster = nullptr;
-
-	// Set the total number of reactants that dissociate to form this one
-	nPairs = dissociatingPairs.size();
-	// Loop over all dissociating clusters that form this cluster
-	for (int j = 0; j < nPairs; j++) {
-		// Get the dissociating cluster
-		dissociatingCluster = dissociatingPairs[j].first;
-		// Calculate the Dissociation flux
-		flux += dissociatingPairs[j].kConstant
-				* dissociatingCluster->getConcentration(
-						dissociatingPairs[j].firstDistance);
-	}
+	// The flux of each reaction type
+	double fluxes[4] = { };
+	if (fillStateScratch())
+		computeReactionFluxes(concScratch.data(), rateScratch.data(), fluxes);
 
 	// Return the flux
-	return flux;
+	return fluxes[2];
 }
 
 double NECluster::getEmissionFlux() const {
-	// Initial declarations
-	int nPairs = 0;
-	double flux = 0.0;
+	// The flux of each reaction type
+	double fluxes[4] = { };
+	if (fillStateScratch())
+		computeReactionFluxes(concScratch.data(), rateScratch.data(), fluxes);
 
-	// Set the total number of emission pairs
-	nPairs = emissionPairs.size();
-	// Loop over all the pairs
-	for (int i = 0; i < nPairs; i++) {
-		// Update the flux
-		flux += emissionPairs[i].kConstant;
-	}
-
-	return flux * concentration;
+	return fluxes[3];
 }
 
 double NECluster::getProductionFlux() const {
-	// Local declarations
-	double flux = 0.0;
-	int nPairs = 0;
-	NECluster *firstReactant = nullptr, *secondReactant = nullptr;
-
-	// Set the total number of reacting pairs
-	nPairs = reactingPairs.size();
-	// Loop over all the reacting pairs
-	for (int i = 0; i < nPairs; i++) {
-		// Get the two reacting clusters
-		firstReactant = reactingPairs[i].first;
-		secondReactant = reactingPairs[i].second;
-		// Update the flux
-		flux += reactingPairs[i].kConstant
-				* firstReactant->getConcentration(
-						reactingPairs[i].firstDistance)
-				* secondReactant->getConcentration(
-						reactingPairs[i].secondDistance);
-	}
+	// The flux of each reaction type
+	double fluxes[4] = { };
+	if (fillStateScratch())
+		computeReactionFluxes(concScratch.data(), rateScratch.data(), fluxes);
 
 	// Return the production flux
-	return flux;
+	return fluxes[0];
 }
 
 double NECluster::getCombinationFlux() const {
-	// Local declarations
-	double flux = 0.0;
-	int nReactants = 0;
-	NECluster *combiningCluster = nullptr;
-
-	// Set the total number of reactants that combine to form this one
-	nReactants = combiningReactants.size();
-	// Loop over all possible clusters
-	for (int j = 0; j < nReactants; j++) {
-		// Get the cluster that combines with this one
-		combiningCluster = combiningReactants[j].combining;
-		// Calculate Second term of production flux
-		flux += combiningReactants[j].kConstant
-				* combiningCluster->getConcentration(
-						combiningReactants[j].distance);
-	}
+	// The flux of each reaction type
+	double fluxes[4] = { };
+	if (fillStateScratch())
+		computeReactionFluxes(concScratch.data(), rateScratch.data(), fluxes);
 
-	return flux * concentration;
+	return fluxes[1];
 }
 
 std::vector<double> NECluster::getPartialDerivatives() const {
 	// Local Declarations
 	std::vector<double> partials(network->getDOF(), 0.0);
 
-	// Get the partial derivatives for each reaction type
-	getProductionPartialDerivatives(partials);
-	getCombinationPartialDerivatives(partials);
-	getDissociationPartialDerivatives(partials);
-	getEmissionPartialDerivatives(partials);
+	// Get the partial derivatives for all the reactions
+	getPartialDerivatives(partials);
 
 	return partials;
 }
 
 void NECluster::getPartialDerivatives(std::vector<double> & partials) const {
-	// Get the partial derivatives for each reaction type
-	getProductionPartialDerivatives(partials);
-	getCombinationPartialDerivatives(partials);
-	getDissociationPartialDerivatives(partials);
-	getEmissionPartialDerivatives(partials);
+	// Compute them from the current concentrations and rates
+	if (fillStateScratch())
+		computePartialDerivatives(concScratch.data(), rateScratch.data(),
+				partials.data());
+
+	return;
+}
+
+void NECluster::computeReactionFluxes(const double * concs,
+		const double * rates, double * fluxes) const {
+	// Initial declarations
+	double prodFlux = 0.0, combFlux = 0.0, dissFlux = 0.0, emissFlux = 0.0;
+	// The rate constants come after the temperature, diffusion coefficient
+	// and biggest rate, in the order of getRateSlots()
+	const double * k = rates + 3;
+
+	// Production
+	int nPairs = reactingPairs.size();
+	for (int i = 0; i < nPairs; i++, k++) {
+		prodFlux += *k
+				* reactingPairs[i].first->getConcentrationFrom(concs,
+						reactingPairs[i].firstDistance)
+				* reactingPairs[i].second->getConcentrationFrom(concs,
+						reactingPairs[i].secondDistance);
+	}
+
+	// Combination
+	nPairs = combiningReactants.size();
+	for (int i = 0; i < nPairs; i++, k++) {
+		combFlux += *k
+				* combiningReactants[i].combining->getConcentrationFrom(concs,
+						combiningReactants[i].distance);
+	}
+	combFlux *= concs[id - 1];
+
+	// Dissociation
+	nPairs = dissociatingPairs.size();
+	for (int i = 0; i < nPairs; i++, k++) {
+		dissFlux += *k
+				* dissociatingPairs[i].first->getConcentrationFrom(concs,
+						dissociatingPairs[i].firstDistance);
+	}
+
+	// Emission
+	nPairs = emissionPairs.size();
+	for (int i = 0; i < nPairs; i++, k++) {
+		emissFlux += *k;
+	}
+	emissFlux *= concs[id - 1];
+
+	fluxes[0] = prodFlux;
+	fluxes[1] = combFlux;
+	fluxes[2] = dissFlux;
+	fluxes[3] = emissFlux;
 
 	return;
 }
 
-void NECluster::getProductionPartialDerivatives(
-		std::vector<double> & partials) const {
+double NECluster::computeFlux(const double * concs,
+		const double * rates) const {
+	// The flux of each reaction type
+	double fluxes[4] = { };
+	computeReactionFluxes(concs, rates, fluxes);
+
+	return fluxes[0] - fluxes[1] + fluxes[2] - fluxes[3];
+}
+
+void NECluster::computePartialDerivatives(const double * concs,
+		const double * rates, double * partials) const {
 	// Initial declarations
-	int numReactants = 0, index = 0;
+	int index = 0;
 	double value = 0.0;
+	NECluster *cluster = nullptr;
+	// The rate constants come after the temperature, diffusion coefficient
+	// and biggest rate, in the order of getRateSlots()
+	const double * k = rates + 3;
 
 	// Production
 	// A + B --> D, D being this cluster
-	// The flux for D is
-	// F(C_D) = k+_(A,B)*C_A*C_B
-	// Thus, the partial derivatives
-	// dF(C_D)/dC_A = k+_(A,B)*C_B
-	// dF(C_D)/dC_B = k+_(A,B)*C_A
-	numReactants = reactingPairs.size();
-	for (int i = 0; i < numReactants; i++) {
+	int nPairs = reactingPairs.size();
+	for (int i = 0; i < nPairs; i++, k++) {
 		// Compute the contribution from the first part of the reacting pair
-		value = reactingPairs[i].kConstant
-				* reactingPairs[i].second->getConcentration(
+		value = *k
+				* reactingPairs[i].second->getConcentrationFrom(concs,
 						reactingPairs[i].secondDistance);
 		index = reactingPairs[i].first->id - 1;
 		partials[index] += value;
 		index = reactingPairs[i].first->xeMomId - 1;
 		partials[index] += value * reactingPairs[i].firstDistance;
 		// Compute the contribution from the second part of the reacting pair
-		value = reactingPairs[i].kConstant
-				* reactingPairs[i].first->getConcentration(
+		value = *k
+				* reactingPairs[i].first->getConcentrationFrom(concs,
 						reactingPairs[i].firstDistance);
 		index = reactingPairs[i].second->id - 1;
 		partials[index] += value;
@@ -495,85 +502,39 @@ void NECluster::getProductionPartialDerivatives(
 		partials[index] += value * reactingPairs[i].secondDistance;
 	}
 
-	return;
-}
-
-void NECluster::getCombinationPartialDerivatives(
-		std::vector<double> & partials) const {
-	// Initial declarations
-	int numReactants = 0, otherIndex = 0;
-	NECluster *cluster = nullptr;
-	double value = 0.0;
-
 	// Combination
 	// A + B --> D, A being this cluster
-	// The flux for A is outgoing
-	// F(C_A) = - k+_(A,B)*C_A*C_B
-	// Thus, the partial derivatives
-	// dF(C_A)/dC_A = - k+_(A,B)*C_B
-	// dF(C_A)/dC_B = - k+_(A,B)*C_A
-	numReactants = combiningReactants.size();
-	for (int i = 0; i < numReactants; i++) {
-		cluster = (NECluster *) combiningReactants[i].combining;
-		// Remember that the flux due to combinations is OUTGOING (-=)!
+	nPairs = combiningReactants.size();
+	for (int i = 0; i < nPairs; i++, k++) {
+		cluster = combiningReactants[i].combining;
 		// Compute the contribution from this cluster
-		partials[id - 1] -= combiningReactants[i].kConstant
-				* cluster->getConcentration(combiningReactants[i].distance);
+		partials[id - 1] -= *k
+				* cluster->getConcentrationFrom(concs,
+						combiningReactants[i].distance);
 		// Compute the contribution from the combining cluster
-		value = combiningReactants[i].kConstant * concentration;
-		// Get the index of cluster
-		otherIndex = cluster->id - 1;
-		partials[otherIndex] -= value;
-		otherIndex = cluster->xeMomId - 1;
-		partials[otherIndex] -= value * combiningReactants[i].distance;
+		value = *k * concs[id - 1];
+		index = cluster->id - 1;
+		partials[index] -= value;
+		index = cluster->xeMomId - 1;
+		partials[index] -= value * combiningReactants[i].distance;
 	}
 
-	return;
-}
-
-void NECluster::getDissociationPartialDerivatives(
-		std::vector<double> & partials) const {
-	// Initial declarations
-	int numPairs = 0, index = 0;
-	NECluster *cluster = nullptr;
-
 	// Dissociation
 	// A --> B + D, B being this cluster
-	// The flux for B is
-	// F(C_B) = k-_(B,D)*C_A
-	// Thus, the partial derivatives
-	// dF(C_B)/dC_A = k-_(B,D)
-	numPairs = dissociatingPairs.size();
-	for (int i = 0; i < numPairs; i++) {
-		// Get the dissociating cluster
+	nPairs = dissociatingPairs.size();
+	for (int i = 0; i < nPairs; i++, k++) {
 		cluster = dissociatingPairs[i].first;
 		index = cluster->id - 1;
-		partials[index] += dissociatingPairs[i].kConstant;
+		partials[index] += *k;
 		index = cluster->xeMomId - 1;
-		partials[index] += dissociatingPairs[i].kConstant
-				* dissociatingPairs[i].firstDistance;
+		partials[index] += *k * dissociatingPairs[i].firstDistance;
 	}
 
-	return;
-}
-
-void NECluster::getEmissionPartialDerivatives(
-		std::vector<double> & partials) const {
-	// Initial declarations
-	int numPairs = 0, index = 0;
-
 	// Emission
 	// A --> B + D, A being this cluster
-	// The flux for A is
-	// F(C_A) = - k-_(B,D)*C_A
-	// Thus, the partial derivatives
-	// dF(C_A)/dC_A = - k-_(B,D)
-	numPairs = emissionPairs.size();
-	for (int i = 0; i < numPairs; i++) {
-		// Modify the partial derivative. Remember that the flux
-		// due to emission is OUTGOING (-=)!
-		index = id - 1;
-		partials[index] -= emissionPairs[i].kConstant;
+	nPairs = emissionPairs.size();
+	for (int i = 0; i < nPairs; i++, k++) {
+		partials[id - 1] -= *k;
 	}
 
 	return;
@@ -644,6 +605,24 @@ std::vector<int> NECluster::getConnectivity() const {
 	return connectivity;
 }
 
+std::vector<int> NECluster::getConnectivityIds() const {
+	// Merge the two sorted sets
+	std::vector<int> ids;
+	ids.reserve(
+			reactionConnectivitySet.size()
+					+ dissociationConnectivitySet.size());
+	std::set_union(reactionConnectivitySet.begin(),
+			reactionConnectivitySet.end(), dissociationConnectivitySet.begin(),
+			dissociationConnectivitySet.end(), std::back_inserter(ids));
+
+	// The sets contain the ids, shift them to get the indices
+	for (int i = 0; i < ids.size(); i++) {
+		ids[i] -= 1;
+	}
+
+	return ids;
+}
+
 void NECluster::computeRateConstants() {
 	// Local declarations
 	NECluster *firstReactant = nullptr, *secondReactant = nullptr,
@@ -737,3 +716,24 @@ void NECluster::computeRateConstants() {
 
 	return;
 }
+
+void NECluster::getRateSlots(std::vector<double *> & slots) {
+	// The values of the reactant itself
+	Reactant::getRateSlots(slots);
+
+	// The same rate constants as the ones computed by computeRateConstants()
+	for (int i = 0; i < reactingPairs.size(); i++) {
+		slots.push_back(&(reactingPairs[i].kConstant));
+	}
+	for (int i = 0; i < combiningReactants.size(); i++) {
+		slots.push_back(&(combiningReactants[i].kConstant));
+	}
+	for (int i = 0; i < dissociatingPairs.size(); i++) {
+		slots.push_back(&(dissociatingPairs[i].kConstant));
+	}
+	for (int i = 0; i < emissionPairs.size(); i++) {
+		slots.push_back(&(emissionPairs[i].kConstant));
+	}
+
+	return;
+}
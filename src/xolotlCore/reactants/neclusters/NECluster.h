@@ -224,6 +224,19 @@ protected:
 	 */
 	const std::set<int> & getDissociationConnectivitySet() const;
 
+	/**
+	 * Compute the flux of each reaction type from the given concentrations
+	 * and rates.
+	 *
+	 * @param concs The concentrations of the grid point, indexed by id - 1
+	 * @param rates The values of this cluster in the rate table, in the
+	 * order of getRateSlots()
+	 * @param fluxes The array where the production, combination,
+	 * dissociation and emission fluxes are written
+	 */
+	void computeReactionFluxes(const double * concs, const double * rates,
+			double * fluxes) const;
+
 	/**
 	 * The default constructor is protected
 	 */
@@ -328,6 +341,44 @@ public:
 	 */
 	virtual double getMomentum() const;
 
+	/**
+	 * This operation returns the concentration of this cluster, or of the
+	 * cluster at the given distance in the group for a super cluster, read
+	 * from the concentration array of a grid point.
+	 *
+	 * @param concs The concentrations, indexed by id - 1
+	 * @param distXe The xenon distance in the group
+	 * @return The concentration
+	 */
+	virtual double getConcentrationFrom(const double * concs,
+			double distXe = 0.0) const {
+		return concs[id - 1];
+	}
+
+	/**
+	 * This operation returns the first xenon momentum read from the
+	 * concentration array of a grid point.
+	 *
+	 * @param concs The concentrations, indexed by id - 1
+	 * @return The momentum
+	 */
+	virtual double getMomentumFrom(const double * concs) const {
+		return 0.0;
+	}
+
+	/**
+	 * This operation computes the total flux of this cluster like
+	 * getTotalFlux(), but only from the given concentrations and rates so
+	 * that it can be called by several threads at the same time.
+	 *
+	 * @param concs The concentrations of the grid point, indexed by id - 1
+	 * @param rates The values of this cluster in the rate table, in the
+	 * order of getRateSlots()
+	 * @return The total change in flux for this cluster due to all
+	 * reactions
+	 */
+	double computeFlux(const double * concs, const double * rates) const;
+
 	/**
 	 * This operation returns the total flux of this cluster in the
 	 * current network.
@@ -397,44 +448,18 @@ public:
 	virtual void getPartialDerivatives(std::vector<double> & partials) const;
 
 	/**
-	 * This operation computes the partial derivatives due to production
-	 * reactions.
+	 * This operation computes the partial derivatives of this cluster like
+	 * getPartialDerivatives(), but only from the given concentrations and
+	 * rates so that it can be called by several threads at the same time.
 	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
+	 * @param concs The concentrations of the grid point, indexed by id - 1
+	 * @param rates The values of this cluster in the rate table, in the
+	 * order of getRateSlots()
+	 * @param partials The dense array where the partial derivatives are
+	 * added, its size is the number of degrees of freedom
 	 */
-	virtual void getProductionPartialDerivatives(std::vector<double> & partials) const;
-
-	/**
-	 * This operation computes the partial derivatives due to combination
-	 * reactions.
-	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
-	 */
-	virtual void getCombinationPartialDerivatives(std::vector<double> & partials) const;
-
-	/**
-	 * This operation computes the partial derivatives due to dissociation of
-	 * other clusters into this one.
-	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
-	 */
-	virtual void getDissociationPartialDerivatives(std::vector<double> & partials) const;
-
-	/**
-	 * This operation computes the partial derivatives due to emission
-	 * reactions.
-	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
-	 */
-	virtual void getEmissionPartialDerivatives(std::vector<double> & partials) const;
+	void computePartialDerivatives(const double * concs, const double * rates,
+			double * partials) const;
 
 	/**
 	 * This operation reset the connectivity sets based on the information
@@ -483,6 +508,15 @@ public:
 	 */
 	std::vector<int> getConnectivity() const;
 
+	/**
+	 * This operation returns the sorted indices (id - 1) of the clusters
+	 * this cluster interacts with, merging the reaction and dissociation
+	 * connectivity sets without creating the full connectivity array.
+	 *
+	 * @return The sorted indices of the connected clusters
+	 */
+	std::vector<int> getConnectivityIds() const;
+
 	/**
 	 * Calculate all the rate constants for the reactions and dissociations in which this
 	 * cluster is taking part. Store these values in the kConstant field of ClusterPair
@@ -490,6 +524,15 @@ public:
 	 */
 	void computeRateConstants();
 
+	/**
+	 * Add the addresses of the temperature dependent values of this cluster,
+	 * including all the rate constants updated by computeRateConstants(), to
+	 * the given vector.
+	 *
+	 * @param slots The vector of addresses
+	 */
+	virtual void getRateSlots(std::vector<double *> & slots);
+
 };
 
 } /* end namespace xolotlCore */
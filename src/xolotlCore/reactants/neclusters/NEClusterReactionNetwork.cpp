@@ -87,26 +87,22 @@ NEClusterReactionNetwork::NEClusterReactionNetwork(
 	// Reset the properties table so that it can be properly updated when the
 	// network is filled.
 	setDefaultPropsAndNames();
-	// Get all of the reactants from the other network and add them to this one
-	// Load the single-species clusters. Calling getAll() will not work because
-	// it is not const.
-	std::vector<std::shared_ptr<IReactant> > reactants;
-	for (auto it = other.singleSpeciesMap.begin();
-			it != other.singleSpeciesMap.end(); ++it) {
-		reactants.push_back(it->second);
-	}
-	// Load the mixed-species clusters
-	for (auto it = other.mixedSpeciesMap.begin();
-			it != other.mixedSpeciesMap.end(); ++it) {
-		reactants.push_back(it->second);
-	}
-	// Load the super-species clusters
-	for (auto it = other.superSpeciesMap.begin();
-			it != other.superSpeciesMap.end(); ++it) {
-		reactants.push_back(it->second);
+	// Get all of the reactants from the other network and add them to this one,
+	// type by type. Calling getAll() will not work because it is not const.
+	for (auto it = other.clusterTypeMap.begin();
+			it != other.clusterTypeMap.end(); ++it) {
+		// The super clusters are added last
+		if (it->first == NESuperType)
+			continue;
+		auto clusters = it->second;
+		for (unsigned int i = 0; i < clusters->size(); i++) {
+			add(clusters->at(i)->clone());
+		}
 	}
-	for (unsigned int i = 0; i < reactants.size(); i++) {
-		add(reactants[i]->clone());
+	// Load the super clusters
+	auto superClusters = other.clusterTypeMap.at(NESuperType);
+	for (unsigned int i = 0; i < superClusters->size(); i++) {
+		addSuper(superClusters->at(i)->clone());
 	}
 
 	return;
@@ -132,81 +128,41 @@ double NEClusterReactionNetwork::getTemperature() const {
 
 IReactant * NEClusterReactionNetwork::get(const std::string& type,
 		const int size) const {
-	// Local Declarations
-	static std::map<std::string, int> composition = { { xeType, 0 },
-			{ vType, 0 }, { iType, 0 }, { heType, 0 } };
-	std::shared_ptr<IReactant> retReactant;
-
-	// Setup the composition map to default values because it is static
-	composition[xeType] = 0;
-	composition[vType] = 0;
-	composition[iType] = 0;
-
 	// Only pull the reactant if the name and size are valid
-	if ((type == xeType || type == vType || type == iType) && size >= 1) {
-		composition[type] = size;
-		//std::string encodedName = NECluster::encodeCompositionAsName(composition);
-		// Make sure the reactant is in the map
-		std::string compStr = Reactant::toCanonicalString(type, composition);
-		if (singleSpeciesMap.count(compStr)) {
-			retReactant = singleSpeciesMap.at(compStr);
-		}
-	}
-
-	return retReactant.get();
+	if (size < 1)
+		return nullptr;
+	if (type == xeType)
+		return clusterTable.get(size, 0, 0);
+	if (type == vType)
+		return clusterTable.get(0, size, 0);
+	if (type == iType)
+		return clusterTable.get(0, 0, size);
+
+	return nullptr;
 }
 
 IReactant * NEClusterReactionNetwork::getCompound(const std::string& type,
 		const std::vector<int>& sizes) const {
-	// Local Declarations
-	static std::map<std::string, int> composition = { { xeType, 0 },
-			{ vType, 0 }, { iType, 0 }, { heType, 0 } };
-	std::shared_ptr<IReactant> retReactant;
-
-	// Setup the composition map to default values because it is static
-	composition[xeType] = 0;
-	composition[vType] = 0;
-	composition[iType] = 0;
-
 	// Only pull the reactant if the name is valid and there are enough sizes
 	// to fill the composition.
 	if ((type == xeVType || type == xeIType) && sizes.size() == 3) {
-		composition[xeType] = sizes[0];
-		composition[vType] = sizes[1];
-		composition[iType] = sizes[2];
-		// Make sure the reactant is in the map
-		std::string compStr = Reactant::toCanonicalString(type, composition);
-		if (mixedSpeciesMap.count(compStr)) {
-			retReactant = mixedSpeciesMap.at(compStr);
-		}
+		IReactant * reactant = clusterTable.get(sizes[0], sizes[1], sizes[2]);
+		// Make sure the reactant has the requested type
+		if (reactant && reactant->getType() == type)
+			return reactant;
 	}
 
-	return retReactant.get();
+	return nullptr;
 }
 
 IReactant * NEClusterReactionNetwork::getSuper(const std::string& type,
 		const int size) const {
-	// Local Declarations
-	static std::map<std::string, int> composition = { { xeType, 0 },
-			{ vType, 0 }, { iType, 0 }, { heType, 0 } };
-	std::shared_ptr<IReactant> retReactant;
-
-	// Setup the composition map to default values
-	composition[xeType] = 0;
-	composition[vType] = 0;
-	composition[iType] = 0;
-
 	// Only pull the reactant if the name and size are valid.
 	if (type == NESuperType && size >= 1) {
-		composition[xeType] = size;
-		// Make sure the reactant is in the map
-		std::string compStr = Reactant::toCanonicalString(type, composition);
-		if (superSpeciesMap.count(compStr)) {
-			retReactant = superSpeciesMap.at(compStr);
-		}
+		return superTable.get(size, 0, 0);
 	}
 
-	return retReactant.get();
+	return nullptr;
 }
 
 const std::shared_ptr<std::vector<IReactant *>> & NEClusterReactionNetwork::getAll() const {
@@ -243,22 +199,22 @@ void NEClusterReactionNetwork::add(std::shared_ptr<IReactant> reactant) {
 	if (reactant != NULL) {
 		// Get the composition
 		auto composition = reactant->getComposition();
-		std::string compStr = reactant->getCompositionString();
 
 		// Get the species sizes
-		numXe = composition.at(xeType);
-		numV = composition.at(vType);
-		numI = composition.at(iType);
+		numXe = composition[NESpecies::Xe];
+		numV = composition[NESpecies::V];
+		numI = composition[NESpecies::I];
 
 		// Determine if the cluster is a compound. If there is more than one
 		// type, then the check below will sum to greater than one and we know
 		// that we have a mixed cluster.
 		isMixed = ((numXe > 0) + (numV > 0) + (numI > 0)) > 1;
 		// Only add the element if we don't already have it
+		bool isNew = (clusterTable.get(numXe, numV, numI) == nullptr);
 		// Add the compound or regular reactant.
-		if (isMixed && mixedSpeciesMap.count(compStr) == 0) {
-			// Put the compound in its map
-			mixedSpeciesMap[compStr] = reactant;
+		if (isMixed && isNew) {
+			// Put the compound in the table
+			clusterTable.set(numXe, numV, numI, reactant.get());
 			// Figure out whether we have XeV or XeI
 			if (numV > 0) {
 				numClusters = &numXeVClusters;
@@ -267,9 +223,9 @@ void NEClusterReactionNetwork::add(std::shared_ptr<IReactant> reactant) {
 				numClusters = &numXeIClusters;
 				maxClusterSize = &maxXeIClusterSize;
 			}
-		} else if (!isMixed && singleSpeciesMap.count(compStr) == 0) {
-			/// Put the reactant in its map
-			singleSpeciesMap[compStr] = reactant;
+		} else if (!isMixed && isNew) {
+			// Put the reactant in the table
+			clusterTable.set(numXe, numV, numI, reactant.get());
 
 			// Figure out whether we have Xe, V or I
 			if (numXe > 0) {
@@ -321,19 +277,18 @@ void NEClusterReactionNetwork::addSuper(std::shared_ptr<IReactant> reactant) {
 		// Get the composition
 		auto composition = reactant->getComposition();
 		// Get the species sizes
-		numXe = composition.at(xeType);
-		numV = composition.at(vType);
-		numI = composition.at(iType);
+		numXe = composition[NESpecies::Xe];
+		numV = composition[NESpecies::V];
+		numI = composition[NESpecies::I];
 		// Determine if the cluster is a compound. If there is more than one
 		// type, then the check below will sum to greater than one and we know
 		// that we have a mixed cluster.
 		isMixed = ((numXe > 0) + (numV > 0) + (numI > 0)) > 1;
 		// Only add the element if we don't already have it
 		// Add the compound or regular reactant.
-		std::string compStr = reactant->getCompositionString();
-		if (!isMixed && superSpeciesMap.count(compStr) == 0) {
-			// Put the compound in its map
-			superSpeciesMap[compStr] = reactant;
+		if (!isMixed && superTable.get(numXe, numV, numI) == nullptr) {
+			// Put the compound in the table
+			superTable.set(numXe, numV, numI, reactant.get());
 			// Set the key
 			numClusters = &numSuperClusters;
 		} else {
@@ -370,6 +325,16 @@ void NEClusterReactionNetwork::removeReactants(
 	// calls we would build these strings several times in this function.
 	ReactionNetwork::ReactantMatcher doomedReactantMatcher(doomedReactants);
 
+	// Remove the doomed reactants from the lookup table. This must be done
+	// first because the type-specific vectors own the reactants.
+	for (auto reactant : doomedReactants) {
+		auto composition = reactant->getComposition();
+		int numXe = composition[NESpecies::Xe], numV = composition[NESpecies::V], numI =
+				composition[NESpecies::I];
+		if (clusterTable.get(numXe, numV, numI) == reactant)
+			clusterTable.set(numXe, numV, numI, nullptr);
+	}
+
 	// Remove the doomed reactants from our collection of all known reactants.
 	auto ariter = std::remove_if(allReactants->begin(), allReactants->end(),
 			doomedReactantMatcher);
@@ -392,18 +357,6 @@ void NEClusterReactionNetwork::removeReactants(
 		clusters->erase(citer, clusters->end());
 	}
 
-	// Remove the doomed reactants from the SpeciesMap.
-	// We cannot use std::remove_if and our ReactantMatcher here
-	// because std::remove_if reorders the elements in the underlying
-	// container to move the doomed elements to the end of the container,
-	// but the std::map doesn't support reordering.
-	for (auto reactant : doomedReactants) {
-		if (reactant->isMixed())
-			mixedSpeciesMap.erase(reactant->getCompositionString());
-		else
-			singleSpeciesMap.erase(reactant->getCompositionString());
-	}
-
 	return;
 }
 
@@ -438,6 +391,9 @@ void NEClusterReactionNetwork::reinitializeConnectivities() {
 		(*it)->resetConnectivities();
 	}
 
+	// Gather the addresses of the rate constants
+	buildRateSlots();
+
 	return;
 }
 
@@ -468,191 +424,138 @@ void NEClusterReactionNetwork::updateConcentrationsFromArray(
 	return;
 }
 
-void NEClusterReactionNetwork::getDiagonalFill(int *diagFill) {
-	// Get all the super clusters
-	auto superClusters = getAll(NESuperType);
+void NEClusterReactionNetwork::fillDOFArray(double * concentrations) {
+	// Fill the concentrations of the reactants
+	fillConcentrationsArray(concentrations);
 
+	// Fill the moments
+	auto reactants = getAll();
+	int size = reactants->size();
+	for (int i = size - numSuperClusters; i < size; i++) {
+		// Get the superCluster
+		auto cluster = (NESuperCluster *) reactants->at(i);
+		concentrations[cluster->getXeMomentumId() - 1] = cluster->getMomentum();
+	}
+
+	return;
+}
+
+void NEClusterReactionNetwork::getDiagonalFill(SparseFillMap &diagFill) {
 	// Degrees of freedom is the total number of clusters in the network
 	const int dof = getDOF();
 
+	// The column ids of each row, used to build the CSR pattern
+	std::vector<std::vector<int> > columnIds(dof);
+
 	// Declarations for the loop
-	std::vector<int> connectivity;
-	int connectivityLength, id, index;
+	int id;
 
 	// Get the connectivity for each reactant
 	for (int i = 0; i < networkSize; i++) {
 		// Get the reactant and its connectivity
 		auto reactant = allReactants->at(i);
-		connectivity = reactant->getConnectivity();
-		connectivityLength = connectivity.size();
 		// Get the reactant id so that the connectivity can be lined up in
-		// the proper column
+		// the proper row
 		id = reactant->getId() - 1;
-		// Create the vector that will be inserted into the dFill map
-		std::vector<int> columnIds;
-		// Add it to the diagonal fill block
-		for (int j = 0; j < connectivityLength; j++) {
-			// The id starts at j*connectivity length and is always offset
-			// by the id, which denotes the exact column.
-			index = id * dof + j;
-			diagFill[index] = connectivity[j];
-			// Add a column id if the connectivity is equal to 1.
-			if (connectivity[j] == 1) {
-				columnIds.push_back(j);
-			}
-		}
-		// Update the map
-		dFillMap[id] = columnIds;
+		columnIds[id] = reactant->getConnectivityIds();
 	}
 	// Get the connectivity for each moment
-	for (int i = 0; i < superClusters.size(); i++) {
-		// Get the reactant and its connectivity
-		auto reactant = superClusters[i];
-		connectivity = reactant->getConnectivity();
-		connectivityLength = connectivity.size();
-		// Get the xenon momentum id so that the connectivity can be lined up in
-		// the proper column
-		id = reactant->getXeMomentumId() - 1;
-
-		// Create the vector that will be inserted into the dFill map
-		std::vector<int> columnIds;
-		// Add it to the diagonal fill block
-		for (int j = 0; j < connectivityLength; j++) {
-			// The id starts at j*connectivity length and is always offset
-			// by the id, which denotes the exact column.
-			index = (id) * dof + j;
-			diagFill[index] = connectivity[j];
-			// Add a column id if the connectivity is equal to 1.
-			if (connectivity[j] == 1) {
-				columnIds.push_back(j);
-			}
-		}
-		// Update the map
-		dFillMap[id] = columnIds;
+	for (int i = networkSize - numSuperClusters; i < networkSize; i++) {
+		// Get the super cluster
+		auto reactant = (NESuperCluster *) allReactants->at(i);
+		// The momentum has the same connectivity as the super cluster
+		id = reactant->getId() - 1;
+		columnIds[reactant->getXeMomentumId() - 1] = columnIds[id];
 	}
 
+	// Fill the map
+	for (int i = 0; i < dof; i++) {
+		if (!columnIds[i].empty())
+			diagFill[i] = columnIds[i];
+	}
+
+	// Build the CSR pattern used by computeAllPartials
+	setDiagonalFillPattern(columnIds);
+
 	return;
 }
 
-void NEClusterReactionNetwork::computeAllFluxes(double *updatedConcOffset) {
+void NEClusterReactionNetwork::computeFluxes(const double *concs,
+		double *updatedConcOffset, const RateTable & rates) const {
 	// Initial declarations
-	IReactant * cluster;
 	NESuperCluster * superCluster;
-	double flux = 0.0;
+	double superFluxes[2] = { };
 	int reactantIndex = 0;
-	auto superClusters = getAll(NESuperType);
+	const int firstSuperIndex = networkSize - numSuperClusters;
+
+	// The table has to come from this network
+	checkRateTable(rates);
+	const double * k = rates.values.data();
 
 	// ----- Compute all of the new fluxes -----
-	for (int i = 0; i < networkSize; i++) {
-		cluster = allReactants->at(i);
-		// Compute the flux
-		flux = cluster->getTotalFlux();
+	for (int i = 0; i < firstSuperIndex; i++) {
+		auto cluster = (NECluster *) allReactants->at(i);
 		// Update the concentration of the cluster
 		reactantIndex = cluster->getId() - 1;
-		updatedConcOffset[reactantIndex] += flux;
+		updatedConcOffset[reactantIndex] += cluster->computeFlux(concs,
+				k + rateOffsets[i]);
 	}
 
-	// ---- Moments ----
-	for (int i = 0; i < superClusters.size(); i++) {
-		superCluster = (xolotlCore::NESuperCluster *) superClusters[i];
+	// ---- Super clusters and their moments ----
+	for (int i = firstSuperIndex; i < networkSize; i++) {
+		superCluster = (NESuperCluster *) allReactants->at(i);
 
-		// Compute the xenon momentum flux
-		flux = superCluster->getMomentumFlux();
-		// Update the concentration of the cluster
+		// Compute the flux and the xenon momentum flux
+		superCluster->computeFluxes(concs, k + rateOffsets[i], superFluxes);
+		// Update the concentrations
+		reactantIndex = superCluster->getId() - 1;
+		updatedConcOffset[reactantIndex] += superFluxes[0];
 		reactantIndex = superCluster->getXeMomentumId() - 1;
-		updatedConcOffset[reactantIndex] += flux;
+		updatedConcOffset[reactantIndex] += superFluxes[1];
 	}
 
 	return;
 }
 
-void NEClusterReactionNetwork::computeAllPartials(double *vals, int *indices,
-		int *size) {
+void NEClusterReactionNetwork::computePartials(const double *concs,
+		double *vals, const RateTable & rates) const {
 	// Initial declarations
-	int reactantIndex = 0, pdColIdsVectorSize = 0;
-	const int dof = getDOF();
-	std::vector<double> clusterPartials;
-	clusterPartials.resize(dof, 0.0);
-	// Get the super clusters
-	auto superClusters = getAll(NESuperType);
+	int reactantIndex = 0;
+	const int firstSuperIndex = networkSize - numSuperClusters;
+	const int dof = dFillRowPtr.size() - 1;
 
-	// Update the column in the Jacobian that represents each normal reactant
-	for (int i = 0; i < networkSize - superClusters.size(); i++) {
-		auto reactant = allReactants->at(i);
+	// The table has to come from this network
+	checkRateTable(rates);
+	const double * k = rates.values.data();
+
+	// The dense rows of a cluster and its moment, owned by this thread
+	double * partials = getThreadScratch(2 * dof);
+	double * momPartials = partials + dof;
+
+	// Update the row in the Jacobian that represents each normal reactant
+	for (int i = 0; i < firstSuperIndex; i++) {
+		auto reactant = (NECluster *) allReactants->at(i);
 		// Get the reactant index
 		reactantIndex = reactant->getId() - 1;
 
-		// Get the partial derivatives
-		reactant->getPartialDerivatives(clusterPartials);
-		// Get the list of column ids from the map
-		auto pdColIdsVector = dFillMap.at(reactantIndex);
-		// Number of partial derivatives
-		pdColIdsVectorSize = pdColIdsVector.size();
-		size[reactantIndex] = pdColIdsVectorSize;
-
-		// Loop over the list of column ids
-		for (int j = 0; j < pdColIdsVectorSize; j++) {
-			// Set the index
-			indices[reactantIndex * dof + j] = pdColIdsVector[j];
-
-			// Get the partial derivative from the array of all of the partials
-			vals[reactantIndex * dof + j] = clusterPartials[pdColIdsVector[j]];
-
-			// Reset the cluster partial value to zero. This is much faster
-			// than using memset.
-			clusterPartials[pdColIdsVector[j]] = 0.0;
-		}
+		// Get the partial derivatives and move them to their CSR row
+		reactant->computePartialDerivatives(concs, k + rateOffsets[i],
+				partials);
+		gatherPartials(reactantIndex, partials, vals);
 	}
 
-	// Update the column in the Jacobian that represents the moment for the super clusters
-	for (int i = 0; i < superClusters.size(); i++) {
-		auto reactant = (NESuperCluster *) superClusters[i];
+	// Update the rows in the Jacobian that represent the super clusters and their moment
+	for (int i = firstSuperIndex; i < networkSize; i++) {
+		auto reactant = (NESuperCluster *) allReactants->at(i);
 
-		// Get the super cluster index
+		// Get the partial derivatives of the two rows
+		reactant->computePartialDerivatives(concs, k + rateOffsets[i],
+				partials, momPartials);
+		// And move them to their CSR rows
 		reactantIndex = reactant->getId() - 1;
-
-		// Get the partial derivatives
-		reactant->getPartialDerivatives(clusterPartials);
-		// Get the list of column ids from the map
-		auto pdColIdsVector = dFillMap.at(reactantIndex);
-		// Number of partial derivatives
-		pdColIdsVectorSize = pdColIdsVector.size();
-		size[reactantIndex] = pdColIdsVectorSize;
-
-		// Loop over the list of column ids
-		for (int j = 0; j < pdColIdsVectorSize; j++) {
-			// Set the index
-			indices[reactantIndex * dof + j] = pdColIdsVector[j];
-			// Get the partial derivative from the array of all of the partials
-			vals[reactantIndex * dof + j] = clusterPartials[pdColIdsVector[j]];
-
-			// Reset the cluster partial value to zero. This is much faster
-			// than using memset.
-			clusterPartials[pdColIdsVector[j]] = 0.0;
-		}
-
-		// Get the helium momentum index
+		gatherPartials(reactantIndex, partials, vals);
 		reactantIndex = reactant->getXeMomentumId() - 1;
-
-		// Get the partial derivatives
-		reactant->getMomentPartialDerivatives(clusterPartials);
-		// Get the list of column ids from the map
-		pdColIdsVector = dFillMap.at(reactantIndex);
-		// Number of partial derivatives
-		pdColIdsVectorSize = pdColIdsVector.size();
-		size[reactantIndex] = pdColIdsVectorSize;
-
-		// Loop over the list of column ids
-		for (int j = 0; j < pdColIdsVectorSize; j++) {
-			// Set the index
-			indices[reactantIndex * dof + j] = pdColIdsVector[j];
-			// Get the partial derivative from the array of all of the partials
-			vals[reactantIndex * dof + j] = clusterPartials[pdColIdsVector[j]];
-
-			// Reset the cluster partial value to zero. This is much faster
-			// than using memset.
-			clusterPartials[pdColIdsVector[j]] = 0.0;
-		}
+		gatherPartials(reactantIndex, momPartials, vals);
 	}
 
 	return;
@@ -9,6 +9,7 @@
 #include <map>
 #include <unordered_map>
 #include <ReactionNetwork.h>
+#include <ReactantLookupTable.h>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -32,24 +33,16 @@ class NEClusterReactionNetwork: public ReactionNetwork {
 private:
 
 	/**
-	 * The map of single-species clusters, indexed by a string representation
-	 * of a map that contains the name of the reactant and its size.
+	 * The lookup table of the single-species and mixed-species clusters,
+	 * indexed by their xenon, vacancy and interstitial sizes.
 	 */
-	std::unordered_map<std::string, std::shared_ptr<IReactant> > singleSpeciesMap;
+	ReactantLookupTable clusterTable;
 
 	/**
-	 * The map of mixed or compound species clusters, indexed by a 
-	 * string representation of a map that contains the name of the
-	 * constituents of the compound reactant and their sizes.
+	 * The lookup table of the super clusters, indexed by their (truncated)
+	 * xenon size.
 	 */
-	std::unordered_map<std::string, std::shared_ptr<IReactant> > mixedSpeciesMap;
-
-	/**
-	 * The map of super species clusters, indexed by a string representation
-	 * of a map that contains the name of the constituents of the
-	 * compound reactant and their sizes.
-	 */
-	std::unordered_map<std::string, std::shared_ptr<IReactant> > superSpeciesMap;
+	ReactantLookupTable superTable;
 
 	/**
 	 * This map stores all of the clusters in the network by type.
@@ -167,6 +160,21 @@ public:
 	 */
 	IReactant * getSuper(const std::string& type, const int size) const;
 
+	/**
+	 * This operation returns the single-species or mixed-species cluster
+	 * with the given composition if it exists in the network or null if not.
+	 * It is a direct lookup in a table, get() and getCompound() should be
+	 * avoided in loops.
+	 *
+	 * @param numXe The number of xenon atoms
+	 * @param numV The number of vacancies
+	 * @param numI The number of interstitials
+	 * @return A pointer to the cluster
+	 */
+	IReactant * getCluster(int numXe, int numV, int numI) const {
+		return clusterTable.get(numXe, numV, numI);
+	}
+
 	/**
 	 * This operation returns all reactants in the network without regard for
 	 * their composition or whether they are compound reactants. The list may
@@ -260,6 +268,15 @@ public:
 	 */
 	void updateConcentrationsFromArray(double * concentrations);
 
+	/**
+	 * This operation fills an array of doubles with the concentrations of all
+	 * of the reactants and the xenon momentums of the super clusters.
+	 *
+	 * @param concentrations The array that will be filled, its size is
+	 * getDOF()
+	 */
+	void fillDOFArray(double * concentrations);
+
 	/**
 	 * This operation returns the size or number of reactants and momentums in the network.
 	 *
@@ -272,31 +289,34 @@ public:
 	/**
 	 * Get the diagonal fill for the Jacobian, corresponding to the reactions.
 	 *
-	 * @param diagFill The pointer to the vector where the connectivity information is kept
+	 * @param diagFill The map where the connectivity information is kept
 	 */
-	void getDiagonalFill(int *diagFill);
+	void getDiagonalFill(SparseFillMap &diagFill);
 
 	/**
-	 * Compute the fluxes generated by all the reactions
-	 * for all the clusters and their momentums.
+	 * Compute the fluxes generated by all the reactions for all the clusters
+	 * and their momentums from the given concentrations and rate table only.
 	 *
-	 * @param updatedConcOffset The pointer to the array of the concentration at the grid
-	 * point where the fluxes are computed used to find the next solution
+	 * @param concs The concentrations at the grid point, indexed by id - 1
+	 * @param updatedConcOffset The pointer to the array where the fluxes are
+	 * added
+	 * @param rates The rate table at the temperature of the grid point
 	 */
-	void computeAllFluxes(double *updatedConcOffset);
+	void computeFluxes(const double *concs, double *updatedConcOffset,
+			const RateTable & rates) const;
 
 	/**
-	 * Compute the partial derivatives generated by all the reactions
-	 * for all the clusters and their momentum.
+	 * Compute the partial derivatives generated by all the reactions for all
+	 * the clusters and their momentum from the given concentrations and rate
+	 * table only, in the CSR pattern of computeAllPartials().
 	 *
+	 * @param concs The concentrations at the grid point, indexed by id - 1
 	 * @param vals The pointer to the array that will contain the values of
 	 * partials for the reactions
-	 * @param indices The pointer to the array that will contain the indices
-	 * of the clusters
-	 * @param size The pointer to the array that will contain the number of reactions for
-	 * this cluster
+	 * @param rates The rate table at the temperature of the grid point
 	 */
-	virtual void computeAllPartials(double *vals, int *indices, int *size);
+	void computePartials(const double *concs, double *vals,
+			const RateTable & rates) const;
 
 	/**
 	 * Number of Xe clusters in our network.
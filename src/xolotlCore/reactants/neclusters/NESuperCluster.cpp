@@ -19,7 +19,7 @@ NESuperCluster::NESuperCluster(double num, int nTot, int width, double radius,
 	size = (int) numXe;
 
 	// Update the composition map
-	compositionMap[xeType] = (int) (numXe * (double) nTot);
+	composition[NESpecies::Xe] = (int) (numXe * (double) nTot);
 
 	// Set the width
 	sectionWidth = width;
@@ -279,8 +279,8 @@ void NESuperCluster::computeRateConstants() {
 	else {
 		dispersion = 2.0
 				* (nXeSquare
-						- ((double) compositionMap[xeType]
-								* ((double) compositionMap[xeType]
+						- ((double) composition[NESpecies::Xe]
+								* ((double) composition[NESpecies::Xe]
 										/ (double) sectionWidth)))
 				/ ((double) (sectionWidth * (sectionWidth - 1)));
 	}
@@ -650,6 +650,29 @@ void NESuperCluster::updateRateConstants() {
 	return;
 }
 
+void NESuperCluster::getRateSlots(std::vector<double *> & slots) {
+	// The values of the reactant itself
+	Reactant::getRateSlots(slots);
+
+	// The same rate constants as the ones updated by updateRateConstants()
+	for (auto it = effReactingList.begin(); it != effReactingList.end(); ++it) {
+		slots.push_back(&((*it).kConstant));
+	}
+	for (auto it = effCombiningList.begin(); it != effCombiningList.end();
+			++it) {
+		slots.push_back(&((*it).kConstant));
+	}
+	for (auto it = effDissociatingList.begin(); it != effDissociatingList.end();
+			++it) {
+		slots.push_back(&((*it).kConstant));
+	}
+	for (auto it = effEmissionList.begin(); it != effEmissionList.end(); ++it) {
+		slots.push_back(&((*it).kConstant));
+	}
+
+	return;
+}
+
 void NESuperCluster::resetConnectivities() {
 	// Clear both sets
 	reactionConnectivitySet.clear();
@@ -697,287 +720,288 @@ void NESuperCluster::resetConnectivities() {
 }
 
 double NESuperCluster::getTotalFlux() {
-	// Initialize the momentum flux
-	momentumFlux = 0.0;
+	// The flux and momentum flux
+	double fluxes[2] = { };
+
+	// Compute them from the current concentrations and rates
+	if (fillStateScratch())
+		computeFluxes(concScratch.data(), rateScratch.data(), fluxes);
 
-	// Get the fluxes
-	double prodFlux = getProductionFlux();
-	double dissFlux = getDissociationFlux();
-	double combFlux = getCombinationFlux();
-	double emissFlux = getEmissionFlux();
+	// Set the momentum flux
+	momentumFlux = fluxes[1];
 
-	return prodFlux - combFlux + dissFlux - emissFlux;
+	return fluxes[0];
 }
 
 double NESuperCluster::getDissociationFlux() {
-	// Initial declarations
-	double flux = 0.0, value = 0.0;
-	NECluster *dissociatingCluster = nullptr;
+	// The flux and momentum flux of each reaction type
+	double results[4][2] = { };
+	if (fillStateScratch())
+		computeReactionFluxes(concScratch.data(), rateScratch.data(), results);
 
-	// Loop over all the dissociating pairs
-	for (auto it = effDissociatingList.begin(); it != effDissociatingList.end();
-			++it) {
-		// Get the dissociating clusters
-		dissociatingCluster = (*it).first;
-		double l0A = dissociatingCluster->getConcentration(0.0);
-		double l1A = dissociatingCluster->getMomentum();
-		// Update the flux
-		value = (*it).kConstant;
-		flux += value * ((*it).a00 * l0A + (*it).a10 * l1A);
-		// Compute the momentum fluxes
-		momentumFlux += value * ((*it).a01 * l0A + (*it).a11 * l1A);
-	}
+	// Compute the momentum fluxes
+	momentumFlux += results[2][1];
 
 	// Return the flux
-	return flux;
+	return results[2][0];
 }
 
 double NESuperCluster::getEmissionFlux() {
-	// Initial declarations
-	double flux = 0.0, value = 0.0;
+	// The flux and momentum flux of each reaction type
+	double results[4][2] = { };
+	if (fillStateScratch())
+		computeReactionFluxes(concScratch.data(), rateScratch.data(), results);
 
-	// Loop over all the emission pairs
-	for (auto it = effEmissionList.begin(); it != effEmissionList.end(); ++it) {
-		// Update the flux
-		value = (*it).kConstant;
-		flux += value * ((*it).a00 * l0 + (*it).a10 * l1);
-		// Compute the momentum fluxes
-		momentumFlux -= value * ((*it).a01 * l0 + (*it).a11 * l1);
-	}
+	// Compute the momentum fluxes
+	momentumFlux -= results[3][1];
 
-	return flux;
+	return results[3][0];
 }
 
 double NESuperCluster::getProductionFlux() {
-	// Local declarations
-	double flux = 0.0, value = 0.0;
-	NECluster *firstReactant = nullptr, *secondReactant = nullptr;
+	// The flux and momentum flux of each reaction type
+	double results[4][2] = { };
+	if (fillStateScratch())
+		computeReactionFluxes(concScratch.data(), rateScratch.data(), results);
 
-	// Loop over all the reacting pairs
-	for (auto it = effReactingList.begin(); it != effReactingList.end(); ++it) {
+	// Compute the momentum flux
+	momentumFlux += results[0][1];
+
+	// Return the production flux
+	return results[0][0];
+}
+
+double NESuperCluster::getCombinationFlux() {
+	// The flux and momentum flux of each reaction type
+	double results[4][2] = { };
+	if (fillStateScratch())
+		computeReactionFluxes(concScratch.data(), rateScratch.data(), results);
+
+	// Compute the momentum flux
+	momentumFlux -= results[1][1];
+
+	return results[1][0];
+}
+
+void NESuperCluster::getPartialDerivatives(
+		std::vector<double> & partials) const {
+	// Reinitialize the momentum partial derivatives vector
+	std::fill(momentumPartials.begin(), momentumPartials.end(), 0.0);
+
+	// Compute them from the current concentrations and rates
+	if (fillStateScratch())
+		computePartialDerivatives(concScratch.data(), rateScratch.data(),
+				partials.data(), momentumPartials.data());
+
+	return;
+}
+
+void NESuperCluster::getMomentPartialDerivatives(
+		std::vector<double> & partials) const {
+	// Loop on the size of the vector
+	for (int i = 0; i < partials.size(); i++) {
+		// Set to the values that were already computed
+		partials[i] = momentumPartials[i];
+	}
+
+	return;
+}
+
+void NESuperCluster::computeReactionFluxes(const double * concs,
+		const double * rates, double (*results)[2]) const {
+	// Initial declarations
+	double prodFlux = 0.0, combFlux = 0.0, dissFlux = 0.0, emissFlux = 0.0,
+			momFlux = 0.0, value = 0.0;
+	// The momentums of this cluster
+	const double l0This = concs[id - 1], l1This = concs[xeMomId - 1];
+	// The rate constants come after the temperature, diffusion coefficient
+	// and biggest rate, in the order of getRateSlots()
+	const double * k = rates + 3;
+
+	// Production
+	for (auto it = effReactingList.begin(); it != effReactingList.end();
+			++it, ++k) {
 		// Get the two reacting clusters
-		firstReactant = (*it).first;
-		secondReactant = (*it).second;
-		double l0A = firstReactant->getConcentration();
-		double l0B = secondReactant->getConcentration();
-		double l1A = firstReactant->getMomentum();
-		double l1B = secondReactant->getMomentum();
+		double l0A = (*it).first->getConcentrationFrom(concs);
+		double l0B = (*it).second->getConcentrationFrom(concs);
+		double l1A = (*it).first->getMomentumFrom(concs);
+		double l1B = (*it).second->getMomentumFrom(concs);
 		// Update the flux
-		value = (*it).kConstant;
-		flux += value
+		value = *k;
+		prodFlux += value
 				* ((*it).a000 * l0A * l0B + (*it).a010 * l0A * l1B
 						+ (*it).a100 * l1A * l0B + (*it).a110 * l1A);
 		// Compute the momentum flux
-		momentumFlux += value
+		momFlux += value
 				* ((*it).a001 * l0A * l0B + (*it).a011 * l0A * l1B
 						+ (*it).a101 * l1A * l0B + (*it).a111 * l1A);
 	}
 
-	// Return the production flux
-	return flux;
-}
+	// Combination
+	double combMomFlux = 0.0;
+	for (auto it = effCombiningList.begin(); it != effCombiningList.end();
+			++it, ++k) {
+		// Get the combining cluster
+		double l0A = (*it).first->getConcentrationFrom(concs);
+		double l1A = (*it).first->getMomentumFrom(concs);
+		// Update the flux
+		value = *k;
+		combFlux += value
+				* ((*it).a000 * l0A * l0This + (*it).a100 * l0A * l1This
+						+ (*it).a010 * l1A * l0This
+						+ (*it).a110 * l1A * l1This);
+		// Compute the momentum flux
+		combMomFlux += value
+				* ((*it).a001 * l0A * l0This + (*it).a101 * l0A * l1This
+						+ (*it).a011 * l1A * l0This
+						+ (*it).a111 * l1A * l1This);
+	}
 
-double NESuperCluster::getCombinationFlux() {
-	// Local declarations
-	double flux = 0.0, value = 0.0;
-	NECluster *combiningCluster = nullptr;
+	// Dissociation
+	double dissMomFlux = 0.0;
+	for (auto it = effDissociatingList.begin(); it != effDissociatingList.end();
+			++it, ++k) {
+		// Get the dissociating cluster
+		double l0A = (*it).first->getConcentrationFrom(concs);
+		double l1A = (*it).first->getMomentumFrom(concs);
+		// Update the flux
+		value = *k;
+		dissFlux += value * ((*it).a00 * l0A + (*it).a10 * l1A);
+		// Compute the momentum flux
+		dissMomFlux += value * ((*it).a01 * l0A + (*it).a11 * l1A);
+	}
 
-	// Loop over all the combining clusters
-	for (auto it = effCombiningList.begin(); it != effCombiningList.end();
-			++it) {
-		// Get the two reacting clusters
-		combiningCluster = (*it).first;
-		double l0A = combiningCluster->getConcentration();
-		double l1A = combiningCluster->getMomentum();
+	// Emission
+	double emissMomFlux = 0.0;
+	for (auto it = effEmissionList.begin(); it != effEmissionList.end();
+			++it, ++k) {
 		// Update the flux
-		value = (*it).kConstant;
-		flux += value
-				* ((*it).a000 * l0A * l0 + (*it).a100 * l0A * l1
-						+ (*it).a010 * l1A * l0 + (*it).a110 * l1A * l1);
+		value = *k;
+		emissFlux += value * ((*it).a00 * l0This + (*it).a10 * l1This);
 		// Compute the momentum flux
-		momentumFlux -= value
-				* ((*it).a001 * l0A * l0 + (*it).a101 * l0A * l1
-						+ (*it).a011 * l1A * l0 + (*it).a111 * l1A * l1);
+		emissMomFlux += value * ((*it).a01 * l0This + (*it).a11 * l1This);
 	}
 
-	return flux;
+	// Production, combination, dissociation and emission
+	results[0][0] = prodFlux;
+	results[0][1] = momFlux;
+	results[1][0] = combFlux;
+	results[1][1] = combMomFlux;
+	results[2][0] = dissFlux;
+	results[2][1] = dissMomFlux;
+	results[3][0] = emissFlux;
+	results[3][1] = emissMomFlux;
+
+	return;
 }
 
-void NESuperCluster::getPartialDerivatives(
-		std::vector<double> & partials) const {
-	// Reinitialize the momentum partial derivatives vector
-	std::fill(momentumPartials.begin(), momentumPartials.end(), 0.0);
+void NESuperCluster::computeFluxes(const double * concs, const double * rates,
+		double * fluxes) const {
+	// The flux and momentum flux of each reaction type
+	double results[4][2] = { };
+	computeReactionFluxes(concs, rates, results);
 
-	// Get the partial derivatives for each reaction type
-	getProductionPartialDerivatives(partials);
-	getCombinationPartialDerivatives(partials);
-	getDissociationPartialDerivatives(partials);
-	getEmissionPartialDerivatives(partials);
+	// Gather everything
+	fluxes[0] = results[0][0] - results[1][0] + results[2][0] - results[3][0];
+	fluxes[1] = results[0][1] + results[2][1] - results[1][1] - results[3][1];
 
 	return;
 }
 
-void NESuperCluster::getProductionPartialDerivatives(
-		std::vector<double> & partials) const {
+void NESuperCluster::computePartialDerivatives(const double * concs,
+		const double * rates, double * partials, double * momPartials) const {
 	// Initial declarations
 	double value = 0.0;
 	int index = 0;
-	NECluster *firstReactant = nullptr, *secondReactant = nullptr;
+	NECluster *cluster = nullptr;
+	// The momentums of this cluster
+	const double l0This = concs[id - 1], l1This = concs[xeMomId - 1];
+	// The rate constants come after the temperature, diffusion coefficient
+	// and biggest rate, in the order of getRateSlots()
+	const double * k = rates + 3;
 
 	// Production
 	// A + B --> D, D being this cluster
-	// The flux for D is
-	// F(C_D) = k+_(A,B)*C_A*C_B
-	// Thus, the partial derivatives
-	// dF(C_D)/dC_A = k+_(A,B)*C_B
-	// dF(C_D)/dC_B = k+_(A,B)*C_A
-
-	// Loop over all the reacting pairs
-	for (auto it = effReactingList.begin(); it != effReactingList.end(); ++it) {
+	for (auto it = effReactingList.begin(); it != effReactingList.end();
+			++it, ++k) {
 		// Get the two reacting clusters
-		firstReactant = (*it).first;
-		secondReactant = (*it).second;
-		double l0A = firstReactant->getConcentration();
-		double l0B = secondReactant->getConcentration();
-		double l1A = firstReactant->getMomentum();
-		double l1B = secondReactant->getMomentum();
+		NECluster *firstReactant = (*it).first, *secondReactant = (*it).second;
+		double l0A = firstReactant->getConcentrationFrom(concs);
+		double l0B = secondReactant->getConcentrationFrom(concs);
+		double l1A = firstReactant->getMomentumFrom(concs);
+		double l1B = secondReactant->getMomentumFrom(concs);
 
 		// Compute the contribution from the first part of the reacting pair
-		value = (*it).kConstant;
+		value = *k;
 		index = firstReactant->getId() - 1;
 		partials[index] += value * ((*it).a000 * l0B + (*it).a010 * l1B);
-		momentumPartials[index] += value
-				* ((*it).a001 * l0B + (*it).a011 * l1B);
+		momPartials[index] += value * ((*it).a001 * l0B + (*it).a011 * l1B);
 		index = firstReactant->getXeMomentumId() - 1;
 		partials[index] += value * ((*it).a100 * l0B + (*it).a110 * l1B);
-		momentumPartials[index] += value
-				* ((*it).a101 * l0B + (*it).a111 * l1B);
+		momPartials[index] += value * ((*it).a101 * l0B + (*it).a111 * l1B);
 		// Compute the contribution from the second part of the reacting pair
 		index = secondReactant->getId() - 1;
 		partials[index] += value * ((*it).a000 * l0A + (*it).a100 * l1A);
-		momentumPartials[index] += value
-				* ((*it).a001 * l0A + (*it).a101 * l1A);
+		momPartials[index] += value * ((*it).a001 * l0A + (*it).a101 * l1A);
 		index = secondReactant->getXeMomentumId() - 1;
 		partials[index] += value * ((*it).a010 * l0A + (*it).a110 * l1A);
-		momentumPartials[index] += value
-				* ((*it).a011 * l0A + (*it).a111 * l1A);
+		momPartials[index] += value * ((*it).a011 * l0A + (*it).a111 * l1A);
 	}
 
-	return;
-}
-
-void NESuperCluster::getCombinationPartialDerivatives(
-		std::vector<double> & partials) const {
-	// Initial declarations
-	int index = 0;
-	NECluster *cluster = nullptr;
-	double value = 0.0;
-
 	// Combination
 	// A + B --> D, A being this cluster
-	// The flux for A is outgoing
-	// F(C_A) = - k+_(A,B)*C_A*C_B
-	// Thus, the partial derivatives
-	// dF(C_A)/dC_A = - k+_(A,B)*C_B
-	// dF(C_A)/dC_B = - k+_(A,B)*C_A
-
-	// Loop over all the combining clusters
 	for (auto it = effCombiningList.begin(); it != effCombiningList.end();
-			++it) {
-		// Get the two reacting clusters
+			++it, ++k) {
+		// Get the combining cluster
 		cluster = (*it).first;
-		double l0A = cluster->getConcentration();
-		double l1A = cluster->getMomentum();
+		double l0A = cluster->getConcentrationFrom(concs);
+		double l1A = cluster->getMomentumFrom(concs);
 
 		// Compute the contribution from the combining cluster
-		value = (*it).kConstant;
+		value = *k;
 		index = cluster->getId() - 1;
-		partials[index] -= value * ((*it).a000 * l0 + (*it).a100 * l1);
-		momentumPartials[index] -= value * ((*it).a001 * l0 + (*it).a101 * l1);
+		partials[index] -= value * ((*it).a000 * l0This + (*it).a100 * l1This);
+		momPartials[index] -= value
+				* ((*it).a001 * l0This + (*it).a101 * l1This);
 		index = cluster->getXeMomentumId() - 1;
-		partials[index] -= value * ((*it).a010 * l0 + (*it).a110 * l1);
-		momentumPartials[index] -= value * ((*it).a011 * l0 + (*it).a111 * l1);
+		partials[index] -= value * ((*it).a010 * l0This + (*it).a110 * l1This);
+		momPartials[index] -= value
+				* ((*it).a011 * l0This + (*it).a111 * l1This);
 		// Compute the contribution from this cluster
 		index = id - 1;
 		partials[index] -= value * ((*it).a000 * l0A + (*it).a010 * l1A);
-		momentumPartials[index] -= value
-				* ((*it).a001 * l0A + (*it).a011 * l1A);
+		momPartials[index] -= value * ((*it).a001 * l0A + (*it).a011 * l1A);
 		index = xeMomId - 1;
 		partials[index] -= value * ((*it).a100 * l0A + (*it).a110 * l1A);
-		momentumPartials[index] -= value
-				* ((*it).a101 * l0A + (*it).a111 * l1A);
+		momPartials[index] -= value * ((*it).a101 * l0A + (*it).a111 * l1A);
 	}
 
-	return;
-}
-
-void NESuperCluster::getDissociationPartialDerivatives(
-		std::vector<double> & partials) const {
-	// Initial declarations
-	int index = 0;
-	NECluster *cluster = nullptr;
-	double value = 0.0;
-
 	// Dissociation
 	// A --> B + D, B being this cluster
-	// The flux for B is
-	// F(C_B) = k-_(B,D)*C_A
-	// Thus, the partial derivatives
-	// dF(C_B)/dC_A = k-_(B,D)
-
-	// Loop over all the dissociating pairs
 	for (auto it = effDissociatingList.begin(); it != effDissociatingList.end();
-			++it) {
-		// Get the dissociating clusters
+			++it, ++k) {
+		// Get the dissociating cluster
 		cluster = (*it).first;
-
-		// Compute the contribution from the dissociating cluster
-		value = (*it).kConstant;
+		value = *k;
 		index = cluster->getId() - 1;
 		partials[index] += value * ((*it).a00);
-		momentumPartials[index] += value * ((*it).a01);
+		momPartials[index] += value * ((*it).a01);
 		index = cluster->getXeMomentumId() - 1;
 		partials[index] += value * ((*it).a10);
-		momentumPartials[index] += value * ((*it).a11);
+		momPartials[index] += value * ((*it).a11);
 	}
 
-	return;
-}
-
-void NESuperCluster::getEmissionPartialDerivatives(
-		std::vector<double> & partials) const {
-	// Initial declarations
-	int index = 0;
-	double value = 0.0;
-
 	// Emission
 	// A --> B + D, A being this cluster
-	// The flux for A is
-	// F(C_A) = - k-_(B,D)*C_A
-	// Thus, the partial derivatives
-	// dF(C_A)/dC_A = - k-_(B,D)
-
-	// Loop over all the emission pairs
-	for (auto it = effEmissionList.begin(); it != effEmissionList.end(); ++it) {
-		// Compute the contribution from the dissociating cluster
-		value = (*it).kConstant;
+	for (auto it = effEmissionList.begin(); it != effEmissionList.end();
+			++it, ++k) {
+		value = *k;
 		index = id - 1;
 		partials[index] -= value * ((*it).a00);
-		momentumPartials[index] -= value * ((*it).a01);
+		momPartials[index] -= value * ((*it).a01);
 		index = xeMomId - 1;
 		partials[index] -= value * ((*it).a10);
-		momentumPartials[index] -= value * ((*it).a11);
-	}
-
-	return;
-}
-
-void NESuperCluster::getMomentPartialDerivatives(
-		std::vector<double> & partials) const {
-	// Loop on the size of the vector
-	for (int i = 0; i < partials.size(); i++) {
-		// Set to the values that were already computed
-		partials[i] = momentumPartials[i];
+		momPartials[index] -= value * ((*it).a11);
 	}
 
 	return;
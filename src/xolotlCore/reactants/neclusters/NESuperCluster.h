@@ -162,6 +162,19 @@ private:
 	 */
 	void optimizeReactions();
 
+	/**
+	 * Compute the flux and the momentum flux of each reaction type from the
+	 * given concentrations and rates.
+	 *
+	 * @param concs The concentrations of the grid point, indexed by id - 1
+	 * @param rates The values of this cluster in the rate table, in the
+	 * order of getRateSlots()
+	 * @param results The flux and the momentum flux of the production,
+	 * combination, dissociation and emission
+	 */
+	void computeReactionFluxes(const double * concs, const double * rates,
+			double (*results)[2]) const;
+
 public:
 
 	//! The vector of Xe clusters it will replace
@@ -282,6 +295,15 @@ public:
 	 */
 	void updateRateConstants();
 
+	/**
+	 * Add the addresses of the temperature dependent values of this cluster,
+	 * including all the rate constants updated by updateRateConstants(), to
+	 * the given vector.
+	 *
+	 * @param slots The vector of addresses
+	 */
+	void getRateSlots(std::vector<double *> & slots);
+
 	/**
 	 * This operation sets the zeroth order momentum.
 	 *
@@ -355,59 +377,59 @@ public:
 	double getMomentumFlux() {return momentumFlux;}
 
 	/**
-	 * This operation works as getPartialDerivatives above, but instead of
-	 * returning a vector that it creates it fills a vector that is passed to
-	 * it by the caller. This allows the caller to optimize the amount of
-	 * memory allocations to just one if they are accessing the partial
-	 * derivatives many times.
-	 *
-	 * @param the vector that should be filled with the partial derivatives
-	 * for this reactant where index zero corresponds to the first reactant in
-	 * the list returned by the ReactionNetwork::getAll() operation. The size of
-	 * the vector should be equal to ReactionNetwork::size().
+	 * This operation returns the concentration of the cluster at the given
+	 * distance in the group, read from the concentration array of a grid
+	 * point.
 	 *
+	 * @param concs The concentrations, indexed by id - 1
+	 * @param distXe The xenon distance in the group
+	 * @return The concentration
 	 */
-	void getPartialDerivatives(std::vector<double> & partials) const;
+	double getConcentrationFrom(const double * concs,
+			double distXe = 0.0) const {
+		return concs[id - 1] + (distXe * concs[xeMomId - 1]);
+	}
 
 	/**
-	 * This operation computes the partial derivatives due to production
-	 * reactions.
+	 * This operation returns the first xenon momentum read from the
+	 * concentration array of a grid point.
 	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
+	 * @param concs The concentrations, indexed by id - 1
+	 * @return The momentum
 	 */
-	void getProductionPartialDerivatives(std::vector<double> & partials) const;
+	double getMomentumFrom(const double * concs) const {
+		return concs[xeMomId - 1];
+	}
 
 	/**
-	 * This operation computes the partial derivatives due to combination
-	 * reactions.
+	 * This operation computes the total flux of this cluster and the flux of
+	 * its momentum like getTotalFlux(), but only from the given
+	 * concentrations and rates so that it can be called by several threads
+	 * at the same time.
 	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
+	 * @param concs The concentrations of the grid point, indexed by id - 1
+	 * @param rates The values of this cluster in the rate table, in the
+	 * order of getRateSlots()
+	 * @param fluxes The array where the flux and the momentum flux are
+	 * written
 	 */
-	void getCombinationPartialDerivatives(std::vector<double> & partials) const;
+	void computeFluxes(const double * concs, const double * rates,
+			double * fluxes) const;
 
 	/**
-	 * This operation computes the partial derivatives due to dissociation of
-	 * other clusters into this one.
+	 * This operation works as getPartialDerivatives above, but instead of
+	 * returning a vector that it creates it fills a vector that is passed to
+	 * it by the caller. This allows the caller to optimize the amount of
+	 * memory allocations to just one if they are accessing the partial
+	 * derivatives many times.
 	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
-	 */
-	void getDissociationPartialDerivatives(std::vector<double> & partials) const;
-
-	/**
-	 * This operation computes the partial derivatives due to emission
-	 * reactions.
+	 * @param the vector that should be filled with the partial derivatives
+	 * for this reactant where index zero corresponds to the first reactant in
+	 * the list returned by the ReactionNetwork::getAll() operation. The size of
+	 * the vector should be equal to ReactionNetwork::size().
 	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
 	 */
-	void getEmissionPartialDerivatives(std::vector<double> & partials) const;
+	void getPartialDerivatives(std::vector<double> & partials) const;
 
 	/**
 	 * This operation computes the partial derivatives for the xenon momentum.
@@ -417,6 +439,22 @@ public:
 	 */
 	void getMomentPartialDerivatives(std::vector<double> & partials) const;
 
+	/**
+	 * This operation computes the partial derivatives of this cluster and
+	 * of its momentum like getPartialDerivatives(), but only from the given
+	 * concentrations and rates so that it can be called by several threads
+	 * at the same time.
+	 *
+	 * @param concs The concentrations of the grid point, indexed by id - 1
+	 * @param rates The values of this cluster in the rate table, in the
+	 * order of getRateSlots()
+	 * @param partials The dense array where the partial derivatives of the
+	 * cluster are added, its size is the number of degrees of freedom
+	 * @param momPartials The same for the xenon momentum
+	 */
+	void computePartialDerivatives(const double * concs, const double * rates,
+			double * partials, double * momPartials) const;
+
 	/**
 	 * This operation returns the section width.
 	 *
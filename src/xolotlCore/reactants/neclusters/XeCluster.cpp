@@ -12,7 +12,7 @@ XeCluster::XeCluster(int nXe,
 	// Set the size
 	size = nXe;
 	// Update the composition map
-	compositionMap[xeType] = size;
+	composition[NESpecies::Xe] = size;
 
 	// Set the reactant name appropriately
 	std::stringstream nameStream;
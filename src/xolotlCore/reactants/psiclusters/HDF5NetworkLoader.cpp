@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <vector>
 #include "PSIClusterReactionNetwork.h"
+#include "PSIClusterNetworkCache.h"
 #include <xolotlPerf.h>
 #include <HDF5Utils.h>
 
@@ -23,6 +24,12 @@ std::shared_ptr<IReactionNetwork> HDF5NetworkLoader::load() {
 	std::shared_ptr<PSIClusterReactionNetwork> network = std::make_shared
 			< PSIClusterReactionNetwork > (handlerRegistry);
 
+	// The compiled reaction tables can be read from a cache
+	std::shared_ptr<PSIClusterNetworkCache> cache;
+	if (!cacheFileName.empty() && !dummyReactions)
+		cache = std::make_shared<PSIClusterNetworkCache>(cacheFileName,
+				networkVector, vMin, heSectionWidth, vSectionWidth);
+
 	// Loop on the networkVector
 	for (auto lineIt = networkVector.begin(); lineIt != networkVector.end();
 			lineIt++) {
@@ -61,6 +68,21 @@ std::shared_ptr<IReactionNetwork> HDF5NetworkLoader::load() {
 		}
 	}
 
+	// Check if the reaction tables can be read from the cache
+	if (cache && cache->isValid()) {
+		// Only set the network, the connectivities come from the cache
+		for (auto reactantsIt = reactants.begin();
+				reactantsIt != reactants.end(); ++reactantsIt) {
+			(*reactantsIt)->Reactant::setReactionNetwork(network);
+		}
+
+		// Group the network and fill the reaction tables
+		cache->restore(network, handlerRegistry);
+		network->setNetworkCache(cache);
+
+		return network;
+	}
+
 	// Set the reaction network for each reactant
 	for (auto reactantsIt = reactants.begin(); reactantsIt != reactants.end();
 			++reactantsIt) {
@@ -73,6 +95,10 @@ std::shared_ptr<IReactionNetwork> HDF5NetworkLoader::load() {
 		applySectionalGrouping(network);
 	}
 
+	// The cache is written once the rate constants are computed
+	if (cache)
+		network->setNetworkCache(cache);
+
 	return network;
 }
 
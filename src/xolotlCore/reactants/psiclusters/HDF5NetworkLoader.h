@@ -13,6 +13,12 @@ namespace xolotlCore {
 class HDF5NetworkLoader: public PSIClusterNetworkLoader {
 private:
 
+	/**
+	 * The name of the file caching the compiled reaction tables, empty if
+	 * they are always built.
+	 */
+	std::string cacheFileName;
+
 	/**
 	 * Private nullary constructor.
 	 */
@@ -41,6 +47,17 @@ public:
 	 */
 	std::shared_ptr<IReactionNetwork> load();
 
+	/**
+	 * This operation sets the name of the file caching the compiled reaction
+	 * tables. They are read from it if it matches the network file and
+	 * grouping parameters, otherwise they are built and written in it.
+	 *
+	 * @param name The name of the cache file
+	 */
+	void setCacheFilename(const std::string& name) {
+		cacheFileName = name;
+	}
+
 };
 
 } /* namespace xolotlCore */
@@ -12,7 +12,7 @@ HeCluster::HeCluster(int nHe,
 	// Set the size
 	size = nHe;
 	// Update the composition map
-	compositionMap[heType] = size;
+	composition[PSISpecies::He] = size;
 
 	// Set the reactant name appropriately
 	std::stringstream nameStream;
@@ -35,7 +35,7 @@ HeCluster::HeCluster(int nHe,
 void HeCluster::combineClusters(std::vector<IReactant *> & clusters,
 		const std::string& productName) {
 	// Initial declarations
-	std::map<std::string, int> secondComposition;
+	Composition secondComposition;
 
 	// Get all the I clusters to loop on them
 	auto iClusters = network->getAll(iType);
@@ -48,12 +48,12 @@ void HeCluster::combineClusters(std::vector<IReactant *> & clusters,
 		// Check that the simple product [He_(a+c)](V_b) doesn't exist
 		// b can be 0 so the simple product would be a helium cluster
 		PSICluster * simpleProduct;
-		if (secondComposition[vType] == 0) {
+		if (secondComposition[PSISpecies::V] == 0) {
 			simpleProduct = (PSICluster *) network->get(heType,
-					size + secondComposition[heType]);
+					size + secondComposition[PSISpecies::He]);
 		} else {
-			std::vector<int> comp = { size + secondComposition[heType],
-					secondComposition[vType], secondComposition[iType] };
+			std::vector<int> comp = { size + secondComposition[PSISpecies::He],
+					secondComposition[PSISpecies::V], secondComposition[PSISpecies::I] };
 			simpleProduct = (PSICluster *) network->getCompound(productName,
 					comp);
 		}
@@ -68,8 +68,8 @@ void HeCluster::combineClusters(std::vector<IReactant *> & clusters,
 			int iSize = (*it)->getSize();
 
 			// Create the composition of the potential product
-			std::vector<int> comp = { size + secondComposition[heType],
-					secondComposition[vType] + 1, secondComposition[iType] };
+			std::vector<int> comp = { size + secondComposition[PSISpecies::He],
+					secondComposition[PSISpecies::V] + 1, secondComposition[PSISpecies::I] };
 			auto firstProduct = (PSICluster *) network->getCompound(productName,
 					comp);
 			// If the first product exists
@@ -173,17 +173,17 @@ void HeCluster::createDissociationConnectivity() {
 			auto comp = cluster->getComposition();
 
 			// Skip He_1V_1 because it was counted in the V dissociation
-			if (comp[heType] == 1 && comp[vType] == 1)
+			if (comp[PSISpecies::He] == 1 && comp[PSISpecies::V] == 1)
 				continue;
 
-			std::vector<int> compositionVec = { comp[heType] - size,
-					comp[vType], 0 };
+			std::vector<int> compositionVec = { comp[PSISpecies::He] - size,
+					comp[PSISpecies::V], 0 };
 			auto smallerReactant = (PSICluster *) network->getCompound(heVType,
 					compositionVec);
-			// Special case for comp[heType] = 1
-			if (comp[heType] == 1) {
+			// Special case for comp[PSISpecies::He] = 1
+			if (comp[PSISpecies::He] == 1) {
 				smallerReactant = (PSICluster *) network->get(vType,
-						comp[vType]);
+						comp[PSISpecies::V]);
 			}
 			dissociateCluster(cluster, smallerReactant);
 		}
@@ -200,7 +200,7 @@ void HeCluster::createDissociationConnectivity() {
 			// that is also emitted during the dissociation
 			auto comp = cluster->getComposition();
 			std::vector<int> compositionVec =
-					{ comp[heType] - 1, 0, comp[iType] };
+					{ comp[PSISpecies::He] - 1, 0, comp[PSISpecies::I] };
 			auto smallerReactant = (PSICluster *) network->getCompound(heIType,
 					compositionVec);
 			dissociateCluster(cluster, smallerReactant);
@@ -14,8 +14,8 @@ HeInterstitialCluster::HeInterstitialCluster(int numHelium, int numInterstitial,
 	size = numHe + numI;
 
 	// Update the composition map
-	compositionMap[heType] = numHe;
-	compositionMap[iType] = numI;
+	composition[PSISpecies::He] = numHe;
+	composition[PSISpecies::I] = numI;
 
 	// Set the reactant name appropriately
 	std::stringstream nameStream;
@@ -45,11 +45,10 @@ HeInterstitialCluster::HeInterstitialCluster(HeInterstitialCluster &other) :
 }
 
 void HeInterstitialCluster::replaceInCompound(std::vector<IReactant *> & reactants,
-		const std::string& oldComponentName) {
+		PSISpecies oldComponent) {
 	// Local Declarations
-	std::map<std::string, int> myComp = getComposition(),
-			productReactantComp;
-	int myComponentNumber = myComp[oldComponentName];
+	Composition myComp = getComposition(), productReactantComp;
+	int myComponentNumber = myComp[oldComponent];
 	int secondId = 0;
 
 	// Loop over all of the extra reactants in this reaction and handle the replacement
@@ -60,11 +59,11 @@ void HeInterstitialCluster::replaceInCompound(std::vector<IReactant *> & reactan
 		// Create the composition vector
 		productReactantComp = myComp;
 		// Updated the modified components
-		productReactantComp[oldComponentName] =
+		productReactantComp[oldComponent] =
 				myComponentNumber - secondReactantSize;
 		// Create the composition vector -- FIXME! This should be general!
-		std::vector<int> productCompositionVector = { productReactantComp[heType],
-				0, productReactantComp[iType] };
+		std::vector<int> productCompositionVector = { productReactantComp[PSISpecies::He],
+				0, productReactantComp[PSISpecies::I] };
 		// Get the product of the same type as the second reactant
 		auto productReactant = network->getCompound(typeName,
 				productCompositionVector);
@@ -100,8 +99,8 @@ void HeInterstitialCluster::createReactionConnectivity() {
 		// Get the second reactant, i.e. HeI cluster with He number smaller
 		// by the size of the helium reactant
 		auto comp = getComposition();
-		std::vector<int> compositionVec = { comp[heType] - heliumReactantSize,
-				0, comp[iType] };
+		std::vector<int> compositionVec = { comp[PSISpecies::He] - heliumReactantSize,
+				0, comp[PSISpecies::I] };
 		auto secondReactant = (PSICluster *) network->getCompound(typeName, compositionVec);
 		// Create a ReactingPair with the two reactants if they both exist
 		if (secondReactant) {
@@ -123,8 +122,8 @@ void HeInterstitialCluster::createReactionConnectivity() {
 	auto singleIReactant = (PSICluster *) network->get(iType, 1);
 	// Get the second reactant, i.e. HeI cluster with one less I
 	auto comp = getComposition();
-	std::vector<int> compositionVec = { comp[heType], 0,
-			comp[iType] - 1 };
+	std::vector<int> compositionVec = { comp[PSISpecies::He], 0,
+			comp[PSISpecies::I] - 1 };
 	auto secondReactant = (PSICluster *) network->getCompound(typeName, compositionVec);
 	// Create a ReactingPair with the two reactants if they both exist
 	if (singleIReactant && secondReactant) {
@@ -168,8 +167,8 @@ void HeInterstitialCluster::createReactionConnectivity() {
 		// Get the second reactant, i.e. HeI cluster with I number bigger
 		// by the size of the vacancy reactant
 		auto comp = getComposition();
-		std::vector<int> compositionVec = { comp[heType],
-				0, comp[iType] + vacancyReactantSize};
+		std::vector<int> compositionVec = { comp[PSISpecies::He],
+				0, comp[PSISpecies::I] + vacancyReactantSize};
 		auto secondReactant = (PSICluster *) network->getCompound(typeName, compositionVec);
 		// Create a ReactingPair with the two reactants if they both exist
 		if (secondReactant) {
@@ -190,7 +189,7 @@ void HeInterstitialCluster::createReactionConnectivity() {
 	// Get all the V clusters from the network
 	reactants = network->getAll(vType);
 	// replaceInCompound handles this reaction, it is overridden in this class
-	replaceInCompound(reactants, iType);
+	replaceInCompound(reactants, PSISpecies::I);
 
 	// Helium absorption by HeI clusters
 	// He_c + (He_a)(I_b) --> [He_(a+c)](I_b)
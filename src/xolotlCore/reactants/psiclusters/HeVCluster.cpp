@@ -16,8 +16,8 @@ HeVCluster::HeVCluster( int numHe, int numV,
  size = numHe + numV;
 
 // Update the composition map
- compositionMap[heType] = numHe;
- compositionMap[vType]  = numV;
+ composition[PSISpecies::He] = numHe;
+ composition[PSISpecies::V]  = numV;
 
 // Set the reactant name appropriately
  std::stringstream nameStream;
@@ -48,11 +48,11 @@ HeVCluster::HeVCluster( HeVCluster &other ) : PSICluster(other)
 //--------------------------------------------------------------------------------
 void 
 HeVCluster::replaceInCompound( std::vector<IReactant*>& reactants,
-                               const std::string& oldComponentName) 
+                               PSISpecies oldComponent) 
 {
 // Local Declarations
-std::map<std::string, int> myComp = getComposition(), productReactantComp;
-int myComponentNumber = myComp[oldComponentName];
+Composition myComp = getComposition(), productReactantComp;
+int myComponentNumber = myComp[oldComponent];
 int secondId = 0;
 
 // Loop over all of the extra reactants in this reaction and handle the replacement
@@ -63,11 +63,11 @@ int secondReactantSize = secondReactant->getSize();
 // Create the composition vector
 productReactantComp = myComp;
 // Updated the modified components
-productReactantComp[oldComponentName] = myComponentNumber
+productReactantComp[oldComponent] = myComponentNumber
 - secondReactantSize;
 // Create the composition vector -- FIXME! This should be general!
 std::vector<int> productCompositionVector = {
-productReactantComp[heType], productReactantComp[vType], 0 };
+productReactantComp[PSISpecies::He], productReactantComp[PSISpecies::V], 0 };
 // Get the product of the same type as the second reactant
 auto productReactant = network->getCompound(typeName,
 productCompositionVector);
@@ -93,8 +93,7 @@ HeVCluster::combineClusters( std::vector<IReactant *> & clusters,
                              const std::string& productName) 
 {
 // Initial declarations
-std::map<std::string, int> myComposition = getComposition(),
-secondComposition;
+Composition myComposition = getComposition(), secondComposition;
 
 // Get all the I clusters to loop on them
 auto iClusters = network->getAll(iType);
@@ -105,10 +104,10 @@ for (unsigned int i = 0; i < clusters.size(); i++) {
 auto secondCluster = (PSICluster *) clusters[i];
 secondComposition = secondCluster->getComposition();
 // Check that the simple product [He_(a+c)](V_b) doesn't exist
-std::vector<int> comp = { myComposition[heType]
-+ secondComposition[heType], myComposition[vType]
-+ secondComposition[vType], myComposition[iType]
-+ secondComposition[iType] };
+std::vector<int> comp = { myComposition[PSISpecies::He]
++ secondComposition[PSISpecies::He], myComposition[PSISpecies::V]
++ secondComposition[PSISpecies::V], myComposition[PSISpecies::I]
++ secondComposition[PSISpecies::I] };
 auto simpleProduct = network->getCompound(productName, comp);
 
 if (simpleProduct)
@@ -121,9 +120,9 @@ for (auto it = iClusters.begin(); it != iClusters.end(); it++) {
 // Get the size of the I cluster
 int iSize = (*it)->getSize();
 // Create the composition of the potential product
-comp = {myComposition[heType] + secondComposition[heType],
-myComposition[vType] + secondComposition[vType] + iSize,
-myComposition[iType] + secondComposition[iType]};
+comp = {myComposition[PSISpecies::He] + secondComposition[PSISpecies::He],
+myComposition[PSISpecies::V] + secondComposition[PSISpecies::V] + iSize,
+myComposition[PSISpecies::I] + secondComposition[PSISpecies::I]};
 auto firstProduct = network->getCompound(productName, comp);
 auto secondProduct = network->get(iType, iSize);
 // If both products exist
@@ -163,8 +162,8 @@ for (unsigned int i = 0; i < reactants.size(); i++) {
 		// Get the second reactant, i.e. HeV cluster with He number smaller
 		// by the size of the helium reactant
 		auto comp = getComposition();
-		std::vector<int> compositionVec = { comp[heType] - heliumReactantSize,
-				comp[vType], 0 };
+		std::vector<int> compositionVec = { comp[PSISpecies::He] - heliumReactantSize,
+				comp[PSISpecies::V], 0 };
 		auto secondReactant = (PSICluster *) network->getCompound(typeName,
 				compositionVec);
 		// Create a ReactingPair with the two reactants if they both exist
@@ -187,7 +186,7 @@ for (unsigned int i = 0; i < reactants.size(); i++) {
 	auto singleVReactant = (PSICluster *) network->get(vType, 1);
 	// Get the second reactant, i.e. HeV cluster with one less V
 	auto comp = getComposition();
-	std::vector<int> compositionVec = { comp[heType], comp[vType] - 1, 0 };
+	std::vector<int> compositionVec = { comp[PSISpecies::He], comp[PSISpecies::V] - 1, 0 };
 	auto secondReactant = (PSICluster *) network->getCompound(typeName,
 			compositionVec);
 	// Create a ReactingPair with the two reactants if they both exist
@@ -233,7 +232,7 @@ for (unsigned int i = 0; i < reactants.size(); i++) {
 		int interstitialReactantSize = interstitialReactant->getSize();
 		// Get the second reactant, i.e. HeV cluster with V number bigger
 		// by the size of the interstitial reactant
-		std::vector<int> compositionVec = { comp[heType], comp[vType]
+		std::vector<int> compositionVec = { comp[PSISpecies::He], comp[PSISpecies::V]
 				+ interstitialReactantSize, 0 };
 		auto secondReactant = (PSICluster *) network->getCompound(typeName,
 				compositionVec);
@@ -256,7 +255,7 @@ for (unsigned int i = 0; i < reactants.size(); i++) {
 	// Get all the I clusters from the network
 	reactants = network->getAll(iType);
 	// replaceInCompound handles this reaction, it is overridden in this class
-	replaceInCompound(reactants, vType);
+	replaceInCompound(reactants, PSISpecies::V);
 
 	// Helium absorption by HeV clusters
 	// He_c + (He_a)(V_b) --> [He_(a+c)](V_b)
@@ -290,10 +289,10 @@ for (unsigned int i = 0; i < reactants.size(); i++) {
 	auto iClusters = network->getAll(iType);
 	PSICluster * smallerCluster;
 	// (b-1) can be 0 so (He_a)[V_(b-1)] can be a helium cluster
-	if (comp[vType] == 1) {
-		smallerCluster = (PSICluster *) network->get(heType, comp[heType]);
+	if (comp[PSISpecies::V] == 1) {
+		smallerCluster = (PSICluster *) network->get(heType, comp[PSISpecies::He]);
 	} else {
-		std::vector<int> compositionVec = { comp[heType], comp[vType] - 1, 0 };
+		std::vector<int> compositionVec = { comp[PSISpecies::He], comp[PSISpecies::V] - 1, 0 };
 		smallerCluster = (PSICluster *) network->getCompound(typeName,
 				compositionVec);
 	}
@@ -309,17 +308,17 @@ for (unsigned int i = 0; i < reactants.size(); i++) {
 				int iSize = (*it)->getSize();
 				// Get the other reactant [He_(a-c)][V_(b-d)] that can be He or HeV
 				PSICluster * otherReactant;
-				if (comp[vType] == iSize) {
+				if (comp[PSISpecies::V] == iSize) {
 					// We want (a-c) to be smaller or equal to c in order to avoid double counting
-					if (comp[heType] > 2 * heReactant->getSize())
+					if (comp[PSISpecies::He] > 2 * heReactant->getSize())
 						continue;
 
 					otherReactant = (PSICluster *) network->get(heType,
-							comp[heType] - heReactant->getSize());
+							comp[PSISpecies::He] - heReactant->getSize());
 				}
 				else {
-					std::vector<int> compositionVec = { comp[heType]
-							- heReactant->getSize(), comp[vType] - iSize, 0 };
+					std::vector<int> compositionVec = { comp[PSISpecies::He]
+							- heReactant->getSize(), comp[PSISpecies::V] - iSize, 0 };
 					otherReactant = (PSICluster *) network->getCompound(typeName,
 							compositionVec);
 					// Get the cluster smaller than this one
@@ -42,11 +42,11 @@ private:
 	 * @param clusters The clusters that have part of their B components
 	 * replaced. It is assumed that each element of this set represents a
 	 * cluster of the form C_z.
-	 * @param oldComponentName The name of the component that will be partially
+	 * @param oldComponent The species of the component that will be partially
 	 * replaced.
 	 */
 	void replaceInCompound(std::vector<IReactant *> & clusters,
-			const std::string& oldComponentName);
+			PSISpecies oldComponent);
 
 	/**
 	 * This operation "combines" clusters in the sense that it handles all of
@@ -10,7 +10,7 @@ InterstitialCluster::InterstitialCluster(int nI,
 	// Set the size
 	size = nI;
 	// Update the composition map
-	compositionMap[iType] = size;
+	composition[PSISpecies::I] = size;
 
 	// Set the reactant name appropriately
 	std::stringstream nameStream;
@@ -71,7 +71,7 @@ void InterstitialCluster::createReactionConnectivity() {
 	// Get all the HeV clusters from the network
 	reactants = network->getAll(heVType);
 	// replaceInCompound handles this reaction
-	replaceInCompound(reactants, vType);
+	replaceInCompound(reactants, PSISpecies::V);
 
 	// Vacancy-Interstitial annihilation producing this cluster
 	// I_(a+b) + V_b --> I_a
@@ -118,16 +118,16 @@ void InterstitialCluster::createReactionConnectivity() {
 			auto heCluster = (PSICluster *) heReactants[j];
 			auto heComp = heCluster->getComposition();
 			// Check that the smaller product [He_(b+d)][V_(c+a-1)] doesn't exist
-			std::vector<int> comp = { heVComp[heType] + heComp[heType],
-					heVComp[vType] + size - 1, 0 };
+			std::vector<int> comp = { heVComp[PSISpecies::He] + heComp[PSISpecies::He],
+					heVComp[PSISpecies::V] + size - 1, 0 };
 			auto smallerProduct = network->getCompound(heVType, comp);
 			if (smallerProduct)
 				continue;
 			// The smaller product doesn't exist so the reaction producing
 			// a interstitial is allowed if the second product is
 			// present in the network [He_(b+d)][V_(c+a)]
-			comp = {heVComp[heType] + heComp[heType],
-				heVComp[vType] + size, 0};
+			comp = {heVComp[PSISpecies::He] + heComp[PSISpecies::He],
+				heVComp[PSISpecies::V] + size, 0};
 			auto otherProduct = network->getCompound(heVType, comp);
 			if (otherProduct) {
 				// The reaction is really allowed
@@ -217,8 +217,8 @@ void InterstitialCluster::createDissociationConnectivity() {
 			// (He_c)(I_b) is the dissociating one, (He_c)[I_(b-a)] is the one
 			// that is also emitted during the dissociation
 			auto comp = cluster->getComposition();
-			std::vector<int> compositionVec = { comp[heType], comp[vType],
-					comp[iType] - 1 };
+			std::vector<int> compositionVec = { comp[PSISpecies::He], comp[PSISpecies::V],
+					comp[PSISpecies::I] - 1 };
 			auto smallerReactant = (PSICluster *) network->getCompound(heIType,
 					compositionVec);
 			dissociateCluster(cluster, smallerReactant);
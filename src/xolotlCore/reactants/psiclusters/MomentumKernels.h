@@ -0,0 +1,128 @@
+#ifndef MOMENTUMKERNELS_H
+#define MOMENTUMKERNELS_H
+
+// Includes
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace xolotlCore {
+
+/**
+ * The kernels used by PSISuperCluster to accumulate in result the contraction
+ * of n rows of momentum coefficients with the given values:
+ *
+ * result[m] += sum_t values[t] * rows[t * stride][m]
+ *
+ * for the three momentums m (l0, He, V). Each row is made of four doubles,
+ * the last one being padding, so that it fits in one 256 bits register, and
+ * the rows must be aligned on 32 bytes.
+ *
+ * The AVX-512 and AVX (with FMA if available) kernels only exist when the
+ * compiler flags enable them, accumulateMomentums() uses the widest one and
+ * the scalar kernel is the fallback.
+ */
+
+/**
+ * The scalar kernel, always available.
+ *
+ * @param rows The aligned coefficient rows
+ * @param stride The number of rows between two consecutive used rows
+ * @param values The values multiplying each row
+ * @param n The number of rows to use
+ * @param result The array of four doubles where the result is accumulated
+ */
+inline void accumulateMomentumsScalar(const double (*rows)[4], int stride,
+		const double * values, int n, double * result) {
+	for (int t = 0; t < n; t++) {
+		const double * row = rows[t * stride];
+		result[0] += values[t] * row[0];
+		result[1] += values[t] * row[1];
+		result[2] += values[t] * row[2];
+	}
+
+	return;
+}
+
+#if defined(__AVX__)
+/**
+ * The AVX kernel, one row per 256 bits register.
+ *
+ * \see accumulateMomentumsScalar()
+ */
+inline void accumulateMomentumsAVX(const double (*rows)[4], int stride,
+		const double * values, int n, double * result) {
+	// Use independent accumulators to break the dependency chain
+	__m256d acc[3] = { _mm256_loadu_pd(result), _mm256_setzero_pd(),
+			_mm256_setzero_pd() };
+	for (int t = 0; t < n; t++) {
+		__m256d row = _mm256_load_pd(rows[t * stride]);
+		__m256d val = _mm256_broadcast_sd(values + t);
+#if defined(__FMA__)
+		acc[t % 3] = _mm256_fmadd_pd(val, row, acc[t % 3]);
+#else
+		acc[t % 3] = _mm256_add_pd(acc[t % 3], _mm256_mul_pd(val, row));
+#endif
+	}
+	_mm256_storeu_pd(result,
+			_mm256_add_pd(acc[0], _mm256_add_pd(acc[1], acc[2])));
+
+	return;
+}
+#endif
+
+#if defined(__AVX512F__)
+/**
+ * The AVX-512 kernel, two consecutive rows per 512 bits register when the
+ * stride is 1, the last odd row and the strided rows use the AVX kernel.
+ *
+ * \see accumulateMomentumsScalar()
+ */
+inline void accumulateMomentumsAVX512(const double (*rows)[4], int stride,
+		const double * values, int n, double * result) {
+	if (stride != 1 || n < 2) {
+		accumulateMomentumsAVX(rows, stride, values, n, result);
+		return;
+	}
+
+	__m512d acc512 = _mm512_setzero_pd();
+	int t = 0;
+	for (; t + 1 < n; t += 2) {
+		__m512d row = _mm512_loadu_pd(rows[t]);
+		__m512d val = _mm512_insertf64x4(_mm512_set1_pd(values[t]),
+				_mm256_set1_pd(values[t + 1]), 1);
+		acc512 = _mm512_fmadd_pd(val, row, acc512);
+	}
+	__m256d acc = _mm256_add_pd(_mm256_loadu_pd(result),
+			_mm256_add_pd(_mm512_castpd512_pd256(acc512),
+					_mm512_extractf64x4_pd(acc512, 1)));
+	_mm256_storeu_pd(result, acc);
+
+	// The last row if n is odd
+	accumulateMomentumsAVX(rows + t, 1, values + t, n - t, result);
+
+	return;
+}
+#endif
+
+/**
+ * Accumulate the momentums with the widest kernel enabled by the compiler
+ * flags.
+ *
+ * \see accumulateMomentumsScalar()
+ */
+inline void accumulateMomentums(const double (*rows)[4], int stride,
+		const double * values, int n, double * result) {
+#if defined(__AVX512F__)
+	accumulateMomentumsAVX512(rows, stride, values, n, result);
+#elif defined(__AVX__)
+	accumulateMomentumsAVX(rows, stride, values, n, result);
+#else
+	accumulateMomentumsScalar(rows, stride, values, n, result);
+#endif
+
+	return;
+}
+
+} /* end namespace xolotlCore */
+#endif
@@ -1,7 +1,10 @@
 #include "PSICluster.h"
+#include "PSIRateKernel.h"
 #include <xolotlPerf.h>
 #include <Constants.h>
 #include <MathUtils.h>
+#include <algorithm>
+#include <iterator>
 
 using namespace xolotlCore;
 
@@ -195,16 +198,16 @@ PSICluster::combineClusters( std::vector<IReactant*>& reactants,
                              const std::string& productName ) 
 {
 // Initial declarations
- std::map<std::string, int> myComposition = getComposition(), secondComposition;
+ Composition myComposition = getComposition(), secondComposition;
  int numHe = 0, numV = 0, numI = 0, secondNumHe = 0, secondNumV = 0,
  secondNumI = 0, productSize = 0;
  std::vector<int> compositionSizes { 0, 0, 0 };
  PSICluster* productCluster = nullptr; 
  PSICluster* secondCluster = nullptr;
 // Setup the composition variables for this cluster
- numHe = myComposition[heType];
- numV  = myComposition[vType];
- numI  = myComposition[iType];
+ numHe = myComposition[PSISpecies::He];
+ numV  = myComposition[PSISpecies::V];
+ numI  = myComposition[PSISpecies::I];
 
  int reactantVecSize = reactants.size();
  for (int i = 0; i < reactantVecSize; i++) 
@@ -212,9 +215,9 @@ PSICluster::combineClusters( std::vector<IReactant*>& reactants,
 // Get the second reactant, its composition and its index
   secondCluster = (PSICluster*) reactants[i];
   secondComposition = secondCluster->getComposition();
-  secondNumHe = secondComposition[heType];
-  secondNumV = secondComposition[vType];
-  secondNumI = secondComposition[iType];
+  secondNumHe = secondComposition[PSISpecies::He];
+  secondNumV = secondComposition[PSISpecies::V];
+  secondNumI = secondComposition[PSISpecies::I];
 // Compute the product size
   productSize = size + secondCluster->size;
 // Get and handle product for compounds
@@ -252,9 +255,9 @@ PSICluster::combineClusters( std::vector<IReactant*>& reactants,
 
 //--------------------------------------------------------------------------------
 void PSICluster::replaceInCompound(std::vector<IReactant *> & reactants,
-const std::string& oldComponentName) {
+PSISpecies oldComponent) {
 // Local Declarations
-std::map<std::string, int> secondReactantComp, productReactantComp;
+Composition secondReactantComp, productReactantComp;
 int numReactants = reactants.size();
 std::vector<int> productCompositionVector { 0, 0, 0 };
 PSICluster *secondReactant = nullptr, *productReactant = nullptr;
@@ -267,12 +270,12 @@ secondReactantComp = secondReactant->getComposition();
 // Create the composition vector
 productReactantComp = secondReactantComp;
 // Updated the modified components
-productReactantComp[oldComponentName] =
-secondReactantComp[oldComponentName] - size;
+productReactantComp[oldComponent] =
+secondReactantComp[oldComponent] - size;
 // Create the composition vector -- FIXME! This should be general!
-productCompositionVector = {productReactantComp[heType],
-productReactantComp[vType],
-productReactantComp[iType]};
+productCompositionVector = {productReactantComp[PSISpecies::He],
+productReactantComp[PSISpecies::V],
+productReactantComp[PSISpecies::I]};
 // Get the product of the same type as the second reactant
 productReactant = (PSICluster *) network->getCompound(
 secondReactant->typeName, productCompositionVector);
@@ -626,11 +629,8 @@ PSICluster::getPartialDerivatives() const
 // Local Declarations
 std::vector<double> partials(network->getDOF(), 0.0);
 
-// Get the partial derivatives for each reaction type
-getProductionPartialDerivatives(partials);
-getCombinationPartialDerivatives(partials);
-getDissociationPartialDerivatives(partials);
-getEmissionPartialDerivatives(partials);
+// Get the partial derivatives for all the reactions
+getPartialDerivatives(partials);
 
 return partials;
 }
@@ -639,147 +639,90 @@ return partials;
 void 
 PSICluster::getPartialDerivatives( std::vector<double> & partials ) const 
 {
-// Get the partial derivatives for each reaction type
-getProductionPartialDerivatives(partials);
-getCombinationPartialDerivatives(partials);
-getDissociationPartialDerivatives(partials);
-getEmissionPartialDerivatives(partials);
+// Compute them from the current concentrations and rates
+if (fillStateScratch())
+computePartialDerivatives(concScratch.data(), rateScratch.data(), 
+partials.data());
 
 return;
 }
 
 //--------------------------------------------------------------------------------
 void 
-PSICluster::getProductionPartialDerivatives( std::vector<double> & partials) const 
+PSICluster::computePartialDerivatives(const double * concs, const double * rates, 
+                                      double * partials) const 
 {
 // Initial declarations
-int numReactants = 0, index = 0;
-double value = 0.0;
+int index = 0;
+double value = 0.0, thisConc = concs[id - 1];
+PSICluster *cluster = nullptr;
+// The rate constants come after the temperature, diffusion coefficient and
+// biggest rate, in the order of getRateSlots()
+const double * k = rates + 3;
 
 // Production
 // A + B --> D, D being this cluster
-// The flux for D is
-// F(C_D) = k+_(A,B)*C_A*C_B
-// Thus, the partial derivatives
-// dF(C_D)/dC_A = k+_(A,B)*C_B
-// dF(C_D)/dC_B = k+_(A,B)*C_A
-numReactants = effReactingPairs.size();
-for (int i = 0; i < numReactants; i++) {
+int nPairs = effReactingPairs.size();
+for (int i = 0; i < nPairs; i++, k++) {
+auto pair = effReactingPairs[i];
 // Compute the contribution from the first part of the reacting pair
-value = effReactingPairs[i]->kConstant
-* effReactingPairs[i]->second->getConcentration(
-effReactingPairs[i]->secondHeDistance,
-effReactingPairs[i]->secondVDistance);
-index = effReactingPairs[i]->first->id - 1;
+value = *k * pair->second->getConcentrationFrom(concs,
+pair->secondHeDistance, pair->secondVDistance);
+index = pair->first->id - 1;
 partials[index] += value;
-index = effReactingPairs[i]->first->heMomId - 1;
-partials[index] += value * effReactingPairs[i]->firstHeDistance;
-index = effReactingPairs[i]->first->vMomId - 1;
-partials[index] += value * effReactingPairs[i]->firstVDistance;
+index = pair->first->heMomId - 1;
+partials[index] += value * pair->firstHeDistance;
+index = pair->first->vMomId - 1;
+partials[index] += value * pair->firstVDistance;
 // Compute the contribution from the second part of the reacting pair
-value = effReactingPairs[i]->kConstant
-* effReactingPairs[i]->first->getConcentration(
-effReactingPairs[i]->firstHeDistance,
-effReactingPairs[i]->firstVDistance);
-index = effReactingPairs[i]->second->id - 1;
+value = *k * pair->first->getConcentrationFrom(concs,
+pair->firstHeDistance, pair->firstVDistance);
+index = pair->second->id - 1;
 partials[index] += value;
-index = effReactingPairs[i]->second->heMomId - 1;
-partials[index] += value * effReactingPairs[i]->secondHeDistance;
-index = effReactingPairs[i]->second->vMomId - 1;
-partials[index] += value * effReactingPairs[i]->secondVDistance;
+index = pair->second->heMomId - 1;
+partials[index] += value * pair->secondHeDistance;
+index = pair->second->vMomId - 1;
+partials[index] += value * pair->secondVDistance;
 }
 
-return;
-}
-
-//--------------------------------------------------------------------------------
-void 
-PSICluster::getCombinationPartialDerivatives( std::vector<double>& partials ) const 
-{
-// Initial declarations
-int numReactants = 0, otherIndex = 0;
-PSICluster *cluster = nullptr;
-double value = 0.0;
-
 // Combination
 // A + B --> D, A being this cluster
-// The flux for A is outgoing
-// F(C_A) = - k+_(A,B)*C_A*C_B
-// Thus, the partial derivatives
-// dF(C_A)/dC_A = - k+_(A,B)*C_B
-// dF(C_A)/dC_B = - k+_(A,B)*C_A
-numReactants = effCombiningReactants.size();
-for (int i = 0; i < numReactants; i++) {
-cluster = (PSICluster *) effCombiningReactants[i]->combining;
-// Remember that the flux due to combinations is OUTGOING (-=)!
+nPairs = effCombiningReactants.size();
+for (int i = 0; i < nPairs; i++, k++) {
+auto comb = effCombiningReactants[i];
+cluster = comb->combining;
 // Compute the contribution from this cluster
-partials[id - 1] -= effCombiningReactants[i]->kConstant
-* cluster->getConcentration(
-effCombiningReactants[i]->heDistance,
-effCombiningReactants[i]->vDistance);
+partials[id - 1] -= *k * cluster->getConcentrationFrom(concs,
+comb->heDistance, comb->vDistance);
 // Compute the contribution from the combining cluster
-value = effCombiningReactants[i]->kConstant * concentration;
-otherIndex = cluster->id - 1;
-partials[otherIndex] -= value;
-otherIndex = cluster->heMomId - 1;
-partials[otherIndex] -= value * effCombiningReactants[i]->heDistance;
-otherIndex = cluster->vMomId - 1;
-partials[otherIndex] -= value * effCombiningReactants[i]->vDistance;
-}
-
-return;
+value = *k * thisConc;
+index = cluster->id - 1;
+partials[index] -= value;
+index = cluster->heMomId - 1;
+partials[index] -= value * comb->heDistance;
+index = cluster->vMomId - 1;
+partials[index] -= value * comb->vDistance;
 }
 
-//--------------------------------------------------------------------------------
-void 
-PSICluster::getDissociationPartialDerivatives( std::vector<double> & partials ) const 
-{
-// Initial declarations
-int numPairs = 0, index = 0;
-PSICluster *cluster = nullptr;
-double value = 0.0;
-
 // Dissociation
 // A --> B + D, B being this cluster
-// The flux for B is
-// F(C_B) = k-_(B,D)*C_A
-// Thus, the partial derivatives
-// dF(C_B)/dC_A = k-_(B,D)
-numPairs = effDissociatingPairs.size();
-for (int i = 0; i < numPairs; i++) {
-// Get the dissociating cluster
-cluster = effDissociatingPairs[i]->first;
-value = effDissociatingPairs[i]->kConstant;
+nPairs = effDissociatingPairs.size();
+for (int i = 0; i < nPairs; i++, k++) {
+auto pair = effDissociatingPairs[i];
+cluster = pair->first;
 index = cluster->id - 1;
-partials[index] += value;
+partials[index] += *k;
 index = cluster->heMomId - 1;
-partials[index] += value * effDissociatingPairs[i]->firstHeDistance;
+partials[index] += *k * pair->firstHeDistance;
 index = cluster->vMomId - 1;
-partials[index] += value * effDissociatingPairs[i]->firstVDistance;
-}
-
-return;
+partials[index] += *k * pair->firstVDistance;
 }
 
-//--------------------------------------------------------------------------------
-void 
-PSICluster::getEmissionPartialDerivatives( std::vector<double> & partials ) const 
-{
-// Initial declarations
-int numPairs = 0, index = 0;
-
 // Emission
 // A --> B + D, A being this cluster
-// The flux for A is
-// F(C_A) = - k-_(B,D)*C_A
-// Thus, the partial derivatives
-// dF(C_A)/dC_A = - k-_(B,D)
-numPairs = effEmissionPairs.size();
-for (int i = 0; i < numPairs; i++) {
-// Modify the partial derivative. Remember that the flux
-// due to emission is OUTGOING (-=)!
-index = id - 1;
-partials[index] -= effEmissionPairs[i]->kConstant;
+nPairs = effEmissionPairs.size();
+for (int i = 0; i < nPairs; i++, k++) {
+partials[id - 1] -= *k;
 }
 
 return;
@@ -863,6 +806,25 @@ connectivity[i] = reactionConnVector[i] || dissociationConnVector[i];
 return connectivity;
 }
 
+//--------------------------------------------------------------------------------
+std::vector<int> 
+PSICluster::getConnectivityIds() const 
+{
+// Merge the two sorted sets
+std::vector<int> ids;
+ids.reserve(reactionConnectivitySet.size() + dissociationConnectivitySet.size());
+std::set_union(reactionConnectivitySet.begin(), reactionConnectivitySet.end(),
+dissociationConnectivitySet.begin(), dissociationConnectivitySet.end(),
+std::back_inserter(ids));
+
+// The sets contain the ids, shift them to get the indices
+for (int i = 0; i < ids.size(); i++) {
+ids[i] -= 1;
+}
+
+return ids;
+}
+
 //--------------------------------------------------------------------------------
 void 
 PSICluster::computeRateConstants() 
@@ -1088,3 +1050,57 @@ biggestRate = biggestProductionRate;
 
 return;
 }
+
+//--------------------------------------------------------------------------------
+void 
+PSICluster::getRateSlots(std::vector<double *> & slots) 
+{
+// The values of the reactant itself
+Reactant::getRateSlots(slots);
+
+// The same rate constants as the ones updated by updateRateConstants()
+for (int i = 0; i < effReactingPairs.size(); i++) {
+slots.push_back(&(effReactingPairs[i]->kConstant));
+}
+for (int i = 0; i < effCombiningReactants.size(); i++) {
+slots.push_back(&(effCombiningReactants[i]->kConstant));
+}
+for (int i = 0; i < effDissociatingPairs.size(); i++) {
+slots.push_back(&(effDissociatingPairs[i]->kConstant));
+}
+for (int i = 0; i < effEmissionPairs.size(); i++) {
+slots.push_back(&(effEmissionPairs[i]->kConstant));
+}
+
+return;
+}
+
+//--------------------------------------------------------------------------------
+void 
+PSICluster::getRateTerms(PSIRateKernel & kernel) const 
+{
+// Same order and operations as updateRateConstants()
+for (int i = 0; i < effReactingPairs.size(); i++) {
+kernel.addProduction(*(effReactingPairs[i]->first),
+*(effReactingPairs[i]->second));
+}
+for (int i = 0; i < effCombiningReactants.size(); i++) {
+kernel.addCombination(*this, *(effCombiningReactants[i]->combining));
+}
+for (int i = 0; i < effDissociatingPairs.size(); i++) {
+// The single cluster comes first
+if (size == 1) {
+kernel.addDissociation(*(effDissociatingPairs[i]->first), *this,
+*(effDissociatingPairs[i]->second));
+} else {
+kernel.addDissociation(*(effDissociatingPairs[i]->first),
+*(effDissociatingPairs[i]->second), *this);
+}
+}
+for (int i = 0; i < effEmissionPairs.size(); i++) {
+kernel.addDissociation(*this, *(effEmissionPairs[i]->first),
+*(effEmissionPairs[i]->second));
+}
+
+return;
+}
@@ -12,6 +12,8 @@ namespace xolotlPerf
 namespace xolotlCore 
 {
 
+class PSIRateKernel;
+
 /**
  * The PSICluster class is a Reactant that is specialized to work for
  * simulations of plasma-surface interactions. It provides special routines
@@ -32,6 +34,9 @@ namespace xolotlCore
  */
 class PSICluster: public Reactant {
 
+	//! The network cache reads and writes the reaction pairs directly
+	friend class PSIClusterNetworkCache;
+
 protected:
 
 	/**
@@ -237,11 +242,11 @@ protected:
 	 * @param clusters The clusters that have part of their B components
 	 * replaced. It is assumed that each element of this set represents a
 	 * cluster of the form (A_x)(B_y).
-	 * @param oldComponentName The name of the component that will be partially
+	 * @param oldComponent The species of the component that will be partially
 	 * replaced
 	 */
 	virtual void replaceInCompound(std::vector<IReactant *> & clusters,
-			const std::string& oldComponentName);
+			PSISpecies oldComponent);
 
 	/** This operation handles reactions where interstitials fill vacancies,
 	 * sometimes referred to vacancy-interstitial annihilation. The reaction
@@ -429,6 +434,43 @@ public:
 	 */
 	virtual double getVMomentum() const;
 
+	/**
+	 * This operation returns the concentration of this cluster, or of the
+	 * cluster at the given distances in the group for a super cluster, read
+	 * from the concentration array of a grid point.
+	 *
+	 * @param concs The concentrations, indexed by id - 1
+	 * @param distHe The helium distance in the group
+	 * @param distV The vacancy distance in the group
+	 * @return The concentration
+	 */
+	virtual double getConcentrationFrom(const double * concs,
+			double distHe = 0.0, double distV = 0.0) const {
+		return concs[id - 1];
+	}
+
+	/**
+	 * This operation returns the first helium momentum read from the
+	 * concentration array of a grid point.
+	 *
+	 * @param concs The concentrations, indexed by id - 1
+	 * @return The momentum
+	 */
+	virtual double getHeMomentumFrom(const double * concs) const {
+		return 0.0;
+	}
+
+	/**
+	 * This operation returns the first vacancy momentum read from the
+	 * concentration array of a grid point.
+	 *
+	 * @param concs The concentrations, indexed by id - 1
+	 * @return The momentum
+	 */
+	virtual double getVMomentumFrom(const double * concs) const {
+		return 0.0;
+	}
+
 	/**
 	 * This operation returns the total flux of this cluster in the
 	 * current network.
@@ -498,44 +540,18 @@ public:
 	virtual void getPartialDerivatives(std::vector<double> & partials) const;
 
 	/**
-	 * This operation computes the partial derivatives due to production
-	 * reactions.
+	 * This operation computes the partial derivatives of this cluster like
+	 * getPartialDerivatives(), but only from the given concentrations and
+	 * rates so that it can be called by several threads at the same time.
 	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
+	 * @param concs The concentrations of the grid point, indexed by id - 1
+	 * @param rates The values of this cluster in the rate table, in the
+	 * order of getRateSlots()
+	 * @param partials The dense array where the partial derivatives are
+	 * added, its size is the number of degrees of freedom
 	 */
-	virtual void getProductionPartialDerivatives(std::vector<double> & partials) const;
-
-	/**
-	 * This operation computes the partial derivatives due to combination
-	 * reactions.
-	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
-	 */
-	virtual void getCombinationPartialDerivatives(std::vector<double> & partials) const;
-
-	/**
-	 * This operation computes the partial derivatives due to dissociation of
-	 * other clusters into this one.
-	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
-	 */
-	virtual void getDissociationPartialDerivatives(std::vector<double> & partials) const;
-
-	/**
-	 * This operation computes the partial derivatives due to emission
-	 * reactions.
-	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
-	 */
-	virtual void getEmissionPartialDerivatives(std::vector<double> & partials) const;
+	void computePartialDerivatives(const double * concs, const double * rates,
+			double * partials) const;
 
 	/**
 	 * This operation reset the connectivity sets based on the information
@@ -584,6 +600,15 @@ public:
 	 */
 	std::vector<int> getConnectivity() const;
 
+	/**
+	 * This operation returns the sorted indices (id - 1) of the clusters
+	 * this cluster interacts with, merging the reaction and dissociation
+	 * connectivity sets without creating the full connectivity array.
+	 *
+	 * @return The sorted indices of the connected clusters
+	 */
+	std::vector<int> getConnectivityIds() const;
+
 	/**
 	 * Calculate all the rate constants for the reactions and dissociations in which this
 	 * cluster is taking part. Store these values in the kConstant field of ClusterPair
@@ -598,6 +623,24 @@ public:
 	 */
 	virtual void updateRateConstants();
 
+	/**
+	 * Add the addresses of the temperature dependent values of this cluster,
+	 * including all the rate constants updated by updateRateConstants(), to
+	 * the given vector.
+	 *
+	 * @param slots The vector of addresses
+	 */
+	virtual void getRateSlots(std::vector<double *> & slots);
+
+	/**
+	 * Describe the rate constants updated by updateRateConstants() to the
+	 * rate kernel, in the order of getRateSlots(), so that it can compute
+	 * them without calling this cluster.
+	 *
+	 * @param kernel The rate kernel
+	 */
+	virtual void getRateTerms(PSIRateKernel & kernel) const;
+
 };
 
 } /* end namespace xolotlCore */
@@ -0,0 +1,584 @@
+#include "PSIClusterNetworkCache.h"
+#include "PSIClusterReactionNetwork.h"
+#include "PSISuperCluster.h"
+#include <MathUtils.h>
+#include <hdf5.h>
+#include <mpi.h>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <cmath>
+#include <fstream>
+
+using namespace xolotlCore;
+
+namespace {
+
+//! The number of columns of the tables
+const int clusterColumns = 3;
+const int superColumns = 8;
+const int pairColumns = 9;
+const int combiningColumns = 6;
+const int productionListColumns = 3 + 9 * 3;
+const int dissociationListColumns = 3 + 3 * 3;
+
+/**
+ * Add the bytes of a buffer to a FNV-1a hash.
+ *
+ * @param data The buffer
+ * @param size Its size in bytes
+ * @param hash The hash to update
+ * @return The new hash
+ */
+std::uint64_t hashBytes(const void *data, std::size_t size,
+		std::uint64_t hash) {
+	auto bytes = (const unsigned char *) data;
+	for (std::size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+/**
+ * Write a table of doubles with the given number of columns.
+ *
+ * @param fileId The HDF5 file
+ * @param name The name of the dataset
+ * @param nColumns The number of columns
+ * @param values The values, row after row
+ */
+void writeTable(hid_t fileId, const std::string& name, int nColumns,
+		const std::vector<double>& values) {
+	hsize_t dims[2] = { values.size() / nColumns, (hsize_t) nColumns };
+	hid_t dataspaceId = H5Screate_simple(2, dims, NULL);
+	hid_t datasetId = H5Dcreate2(fileId, name.c_str(), H5T_IEEE_F64LE,
+			dataspaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	if (!values.empty())
+		H5Dwrite(datasetId, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+				values.data());
+	H5Dclose(datasetId);
+	H5Sclose(dataspaceId);
+
+	return;
+}
+
+/**
+ * Read a table of doubles written by writeTable().
+ *
+ * @param fileId The HDF5 file
+ * @param name The name of the dataset
+ * @param nColumns The expected number of columns
+ * @return The values, row after row
+ */
+std::vector<double> readTable(hid_t fileId, const std::string& name,
+		int nColumns) {
+	hid_t datasetId = H5Dopen2(fileId, name.c_str(), H5P_DEFAULT);
+	if (datasetId < 0)
+		throw std::string(
+				"PSIClusterNetworkCache Exception: the table " + name
+						+ " is missing.");
+	hid_t dataspaceId = H5Dget_space(datasetId);
+	hsize_t dims[2] = { 0, 0 };
+	H5Sget_simple_extent_dims(dataspaceId, dims, NULL);
+	if (dims[1] != (hsize_t) nColumns) {
+		H5Sclose(dataspaceId);
+		H5Dclose(datasetId);
+		throw std::string(
+				"PSIClusterNetworkCache Exception: wrong number of columns in the table "
+						+ name + ".");
+	}
+
+	std::vector<double> values(dims[0] * dims[1]);
+	if (!values.empty())
+		H5Dread(datasetId, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+				values.data());
+	H5Sclose(dataspaceId);
+	H5Dclose(datasetId);
+
+	return values;
+}
+
+/**
+ * Write a scalar attribute of the file.
+ *
+ * @param fileId The HDF5 file
+ * @param name The name of the attribute
+ * @param typeId The file type of the attribute
+ * @param memTypeId The memory type of the value
+ * @param value The value
+ */
+void writeAttribute(hid_t fileId, const std::string& name, hid_t typeId,
+		hid_t memTypeId, const void *value) {
+	hid_t dataspaceId = H5Screate(H5S_SCALAR);
+	hid_t attributeId = H5Acreate2(fileId, name.c_str(), typeId, dataspaceId,
+			H5P_DEFAULT, H5P_DEFAULT);
+	H5Awrite(attributeId, memTypeId, value);
+	H5Aclose(attributeId);
+	H5Sclose(dataspaceId);
+
+	return;
+}
+
+/**
+ * Read a scalar attribute of the file.
+ *
+ * @param fileId The HDF5 file
+ * @param name The name of the attribute
+ * @param memTypeId The memory type of the value
+ * @param value Where the value is read
+ * @return False if the attribute doesn't exist
+ */
+bool readAttribute(hid_t fileId, const std::string& name, hid_t memTypeId,
+		void *value) {
+	if (H5Aexists(fileId, name.c_str()) <= 0)
+		return false;
+	hid_t attributeId = H5Aopen(fileId, name.c_str(), H5P_DEFAULT);
+	H5Aread(attributeId, memTypeId, value);
+	H5Aclose(attributeId);
+
+	return true;
+}
+
+/**
+ * Add a production or dissociation pair to a table.
+ *
+ * @param ownerId The id of the cluster owning the pair
+ * @param heIndex The helium size of the original cluster, 0 if it is not a
+ * super cluster
+ * @param vIndex The vacancy size of the original cluster, 0 if it is not a
+ * super cluster
+ * @param first The first cluster
+ * @param second The second cluster
+ * @param distances The four distances of the pair
+ * @param values The table
+ */
+void addPair(int ownerId, int heIndex, int vIndex, IReactant * first,
+		IReactant * second, const double distances[4],
+		std::vector<double>& values) {
+	values.push_back(ownerId);
+	values.push_back(heIndex);
+	values.push_back(vIndex);
+	values.push_back(first->getId());
+	values.push_back(second->getId());
+	values.insert(values.end(), distances, distances + 4);
+
+	return;
+}
+
+} /* end namespace */
+
+PSIClusterNetworkCache::PSIClusterNetworkCache(const std::string& fileName,
+		const std::vector<std::vector<double> >& networkVector, int vMin,
+		int heWidth, int vWidth) :
+		fileName(fileName), key(14695981039346656037ULL), vMin(vMin), valid(
+				false) {
+	// Hash the layout version, grouping parameters and clusters
+	int parameters[4] = { version, vMin, heWidth, vWidth };
+	key = hashBytes(parameters, sizeof(parameters), key);
+	for (auto const& line : networkVector) {
+		key = hashBytes(line.data(), line.size() * sizeof(double), key);
+	}
+
+	// Check if the file exists before HDF5 complains about it
+	if (!std::ifstream(fileName).good())
+		return;
+
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+	if (fileId < 0)
+		return;
+
+	// The file is used if it has the same version and key
+	int fileVersion = -1;
+	unsigned long long fileKey = 0;
+	valid = readAttribute(fileId, "version", H5T_NATIVE_INT, &fileVersion)
+			&& readAttribute(fileId, "key", H5T_NATIVE_ULLONG, &fileKey)
+			&& fileVersion == version && fileKey == key;
+
+	H5Fclose(fileId);
+}
+
+void PSIClusterNetworkCache::restore(
+		std::shared_ptr<PSIClusterReactionNetwork> network,
+		std::shared_ptr<xolotlPerf::IHandlerRegistry> registry) {
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+	if (fileId < 0)
+		throw std::string(
+				"PSIClusterNetworkCache Exception: unable to open " + fileName
+						+ ".");
+
+	// Create the super clusters
+	double temperature = -1.0;
+	readAttribute(fileId, "temperature", H5T_NATIVE_DOUBLE, &temperature);
+	auto supers = readTable(fileId, "superClusters", superColumns);
+	for (std::size_t n = 0; n < supers.size(); n += superColumns) {
+		const double *row = &supers[n];
+		// The mean formation energy is not used by the super clusters
+		auto superCluster = std::make_shared<PSISuperCluster>(row[0], row[1],
+				(int) row[2], (int) row[3], (int) row[4], row[5], 0.0,
+				registry);
+		superCluster->dispersionHe = row[6];
+		superCluster->dispersionV = row[7];
+		superCluster->cachedTemperature = temperature;
+		network->addSuper(superCluster);
+		superCluster->Reactant::setReactionNetwork(network);
+	}
+
+	// Remove the HeV clusters replaced by the super clusters
+	std::vector<IReactant*> doomedReactants;
+	for (auto currCluster : network->getAll(heVType)) {
+		if (currCluster->getComposition()[PSISpecies::V] >= vMin)
+			doomedReactants.push_back(currCluster);
+	}
+	network->removeReactants(doomedReactants);
+	network->reinitializeNetwork();
+
+	// Check that the ids are the ones of the file
+	auto reactants = network->getAll();
+	int networkSize = reactants->size();
+	auto compositions = readTable(fileId, "clusters", clusterColumns);
+	bool sameClusters = compositions.size()
+			== (std::size_t) networkSize * clusterColumns;
+	for (int i = 0; sameClusters && i < networkSize; i++) {
+		auto composition = reactants->at(i)->getComposition();
+		sameClusters = composition[PSISpecies::He]
+				== (int) compositions[i * clusterColumns]
+				&& composition[PSISpecies::V]
+						== (int) compositions[i * clusterColumns + 1]
+				&& composition[PSISpecies::I]
+						== (int) compositions[i * clusterColumns + 2];
+	}
+	if (!sameClusters) {
+		H5Fclose(fileId);
+		throw std::string(
+				"PSIClusterNetworkCache Exception: the clusters of " + fileName
+						+ " don't match the network.");
+	}
+
+	// Get the cluster from its id in the file
+	auto getCluster = [&reactants, networkSize](double id) {
+		int index = (int) id - 1;
+		if (index < 0 || index >= networkSize)
+			throw std::string(
+					"PSIClusterNetworkCache Exception: wrong cluster id in the cache.");
+		return (PSICluster *) reactants->at(index);
+	};
+	// And the super cluster owning the pairs of a row
+	auto getSuper = [&getCluster](double id) -> PSISuperCluster * {
+		auto cluster = getCluster(id);
+		if (cluster->getType() != PSISuperType)
+			return nullptr;
+		return (PSISuperCluster *) cluster;
+	};
+
+	// The production and dissociation pairs
+	std::vector<std::string> pairTables = { "reactingPairs",
+			"dissociatingPairs", "emissionPairs" };
+	for (int t = 0; t < 3; t++) {
+		auto values = readTable(fileId, pairTables[t], pairColumns);
+		for (std::size_t n = 0; n < values.size(); n += pairColumns) {
+			const double *row = &values[n];
+			PSICluster::ClusterPair pair(getCluster(row[3]),
+					getCluster(row[4]), 0.0);
+			pair.firstHeDistance = row[5];
+			pair.firstVDistance = row[6];
+			pair.secondHeDistance = row[7];
+			pair.secondVDistance = row[8];
+
+			// Super clusters keep them by original composition
+			auto superCluster = getSuper(row[0]);
+			if (superCluster) {
+				auto mapKey = std::make_pair((int) row[1], (int) row[2]);
+				if (t == 0)
+					superCluster->reactingMap[mapKey].push_back(pair);
+				else if (t == 1)
+					superCluster->dissociatingMap[mapKey].push_back(pair);
+				else
+					superCluster->emissionMap[mapKey].push_back(pair);
+			} else {
+				auto cluster = getCluster(row[0]);
+				if (t == 0)
+					cluster->reactingPairs.push_back(pair);
+				else if (t == 1)
+					cluster->dissociatingPairs.push_back(pair);
+				else
+					cluster->emissionPairs.push_back(pair);
+			}
+		}
+	}
+
+	// The combining reactants
+	auto values = readTable(fileId, "combiningReactants", combiningColumns);
+	for (std::size_t n = 0; n < values.size(); n += combiningColumns) {
+		const double *row = &values[n];
+		PSICluster::CombiningCluster combining(getCluster(row[3]), 0.0);
+		combining.heDistance = row[4];
+		combining.vDistance = row[5];
+
+		auto superCluster = getSuper(row[0]);
+		if (superCluster)
+			superCluster->combiningMap[std::make_pair((int) row[1],
+					(int) row[2])].push_back(combining);
+		else
+			getCluster(row[0])->combiningReactants.push_back(combining);
+	}
+
+	// The optimized reactions of the super clusters
+	values = readTable(fileId, "superProductionLists", productionListColumns);
+	for (std::size_t n = 0; n < values.size(); n += productionListColumns) {
+		const double *row = &values[n];
+		auto superCluster = getSuper(row[0]);
+		// The combining reactions don't have a second cluster
+		auto second = (row[2] > 0.0) ? getCluster(row[2]) : nullptr;
+		PSISuperCluster::SuperClusterProductionPair superPair(
+				getCluster(row[1]), second, 0.0);
+		for (int i = 0; i < 9; i++) {
+			for (int m = 0; m < 3; m++) {
+				superPair.a[i][m] = row[3 + 3 * i + m];
+			}
+		}
+		// The combining reactions are the ones without a second cluster
+		if (second)
+			superCluster->effReactingList.push_back(superPair);
+		else
+			superCluster->effCombiningList.push_back(superPair);
+	}
+	values = readTable(fileId, "superDissociationLists",
+			dissociationListColumns);
+	for (std::size_t n = 0; n < values.size(); n += dissociationListColumns) {
+		const double *row = &values[n];
+		auto superCluster = getSuper(row[0]);
+		PSISuperCluster::SuperClusterDissociationPair superPair(
+				getCluster(row[1]), getCluster(std::abs(row[2])), 0.0);
+		for (int i = 0; i < 3; i++) {
+			for (int m = 0; m < 3; m++) {
+				superPair.a[i][m] = row[3 + 3 * i + m];
+			}
+		}
+		// The emission reactions are stored with a negative second id
+		if (row[2] > 0.0)
+			superCluster->effDissociatingList.push_back(superPair);
+		else
+			superCluster->effEmissionList.push_back(superPair);
+	}
+
+	H5Fclose(fileId);
+
+	// Shrink the vectors like the loader does
+	for (int i = 0; i < networkSize; i++) {
+		auto cluster = (PSICluster *) reactants->at(i);
+		cluster->reactingPairs.shrink_to_fit();
+		cluster->combiningReactants.shrink_to_fit();
+		cluster->dissociatingPairs.shrink_to_fit();
+		cluster->emissionPairs.shrink_to_fit();
+	}
+
+	return;
+}
+
+void PSIClusterNetworkCache::write(PSIClusterReactionNetwork& network) {
+	auto reactants = network.getAll();
+	int networkSize = reactants->size();
+	auto superClusters = network.getAll(PSISuperType);
+	double temperature =
+			(networkSize > 0) ? reactants->at(0)->getTemperature() : 0.0;
+
+	// Nothing to write if the optimized reactions were read from the file
+	if (valid
+			&& (superClusters.empty()
+					|| xolotlCore::equal(
+							((PSISuperCluster *) superClusters[0])->cachedTemperature,
+							temperature)))
+		return;
+
+	// Only the master process writes
+	int procId;
+	MPI_Comm_rank(MPI_COMM_WORLD, &procId);
+	if (procId != 0)
+		return;
+
+	std::vector<double> compositions, supers, reacting, combining,
+			dissociating, emission, productionLists, dissociationLists;
+	compositions.reserve(networkSize * clusterColumns);
+	for (int i = 0; i < networkSize; i++) {
+		auto cluster = (PSICluster *) reactants->at(i);
+		auto composition = cluster->getComposition();
+		compositions.push_back(composition[PSISpecies::He]);
+		compositions.push_back(composition[PSISpecies::V]);
+		compositions.push_back(composition[PSISpecies::I]);
+		int id = cluster->getId();
+
+		// The pairs of the normal clusters
+		if (cluster->getType() != PSISuperType) {
+			for (auto const& pair : cluster->reactingPairs) {
+				double distances[4] = { pair.firstHeDistance,
+						pair.firstVDistance, pair.secondHeDistance,
+						pair.secondVDistance };
+				addPair(id, 0, 0, pair.first, pair.second, distances, reacting);
+			}
+			for (auto const& pair : cluster->dissociatingPairs) {
+				double distances[4] = { pair.firstHeDistance,
+						pair.firstVDistance, pair.secondHeDistance,
+						pair.secondVDistance };
+				addPair(id, 0, 0, pair.first, pair.second, distances,
+						dissociating);
+			}
+			for (auto const& pair : cluster->emissionPairs) {
+				double distances[4] = { pair.firstHeDistance,
+						pair.firstVDistance, pair.secondHeDistance,
+						pair.secondVDistance };
+				addPair(id, 0, 0, pair.first, pair.second, distances, emission);
+			}
+			for (auto const& comb : cluster->combiningReactants) {
+				double row[combiningColumns] = { (double) id, 0.0, 0.0,
+						(double) comb.combining->getId(), comb.heDistance,
+						comb.vDistance };
+				combining.insert(combining.end(), row, row + combiningColumns);
+			}
+
+			continue;
+		}
+
+		// The super clusters
+		auto superCluster = (PSISuperCluster *) cluster;
+		double parameters[superColumns] = { superCluster->numHe,
+				superCluster->numV, (double) superCluster->nTot,
+				(double) superCluster->sectionHeWidth,
+				(double) superCluster->sectionVWidth,
+				superCluster->getReactionRadius(), superCluster->dispersionHe,
+				superCluster->dispersionV };
+		supers.insert(supers.end(), parameters, parameters + superColumns);
+
+		// Their pairs by original composition
+		for (auto const& mapPair : superCluster->reactingMap) {
+			for (auto const& pair : mapPair.second) {
+				double distances[4] = { pair.firstHeDistance,
+						pair.firstVDistance, pair.secondHeDistance,
+						pair.secondVDistance };
+				addPair(id, mapPair.first.first, mapPair.first.second,
+						pair.first, pair.second, distances, reacting);
+			}
+		}
+		for (auto const& mapPair : superCluster->dissociatingMap) {
+			for (auto const& pair : mapPair.second) {
+				double distances[4] = { pair.firstHeDistance,
+						pair.firstVDistance, pair.secondHeDistance,
+						pair.secondVDistance };
+				addPair(id, mapPair.first.first, mapPair.first.second,
+						pair.first, pair.second, distances, dissociating);
+			}
+		}
+		for (auto const& mapPair : superCluster->emissionMap) {
+			for (auto const& pair : mapPair.second) {
+				double distances[4] = { pair.firstHeDistance,
+						pair.firstVDistance, pair.secondHeDistance,
+						pair.secondVDistance };
+				addPair(id, mapPair.first.first, mapPair.first.second,
+						pair.first, pair.second, distances, emission);
+			}
+		}
+		for (auto const& mapPair : superCluster->combiningMap) {
+			for (auto const& comb : mapPair.second) {
+				double row[combiningColumns] = { (double) id,
+						(double) mapPair.first.first,
+						(double) mapPair.first.second,
+						(double) comb.combining->getId(), comb.heDistance,
+						comb.vDistance };
+				combining.insert(combining.end(), row, row + combiningColumns);
+			}
+		}
+
+		// Their optimized reactions, the combining ones have no second
+		// cluster
+		for (int l = 0; l < 2; l++) {
+			auto const& list =
+					(l == 0) ?
+							superCluster->effReactingList :
+							superCluster->effCombiningList;
+			for (auto const& superPair : list) {
+				productionLists.push_back(id);
+				productionLists.push_back(superPair.first->getId());
+				productionLists.push_back(
+						superPair.second ? superPair.second->getId() : 0);
+				for (int i = 0; i < 9; i++) {
+					productionLists.insert(productionLists.end(),
+							superPair.a[i], superPair.a[i] + 3);
+				}
+			}
+		}
+		// The emission ones are written with a negative second id
+		for (int l = 0; l < 2; l++) {
+			auto const& list =
+					(l == 0) ?
+							superCluster->effDissociatingList :
+							superCluster->effEmissionList;
+			for (auto const& superPair : list) {
+				dissociationLists.push_back(id);
+				dissociationLists.push_back(superPair.first->getId());
+				dissociationLists.push_back(
+						(l == 0) ?
+								superPair.second->getId() :
+								-superPair.second->getId());
+				for (int i = 0; i < 3; i++) {
+					dissociationLists.insert(dissociationLists.end(),
+							superPair.a[i], superPair.a[i] + 3);
+				}
+			}
+		}
+	}
+
+	// Write in a temporary file first so that the other runs never read a
+	// partial cache. Its name is unique so that concurrent runs writing the
+	// same cache don't write in the same file, and it is in the same
+	// directory for the rename to be atomic.
+	std::vector<char> tempPath(fileName.begin(), fileName.end());
+	const std::string suffix = ".XXXXXX";
+	tempPath.insert(tempPath.end(), suffix.begin(), suffix.end());
+	tempPath.push_back('\0');
+	int tempFd = mkstemp(tempPath.data());
+	if (tempFd < 0)
+		throw std::string(
+				"PSIClusterNetworkCache Exception: unable to create a temporary file for "
+						+ fileName + ".");
+	close(tempFd);
+	std::string tempName(tempPath.data());
+	hid_t fileId = H5Fcreate(tempName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT,
+			H5P_DEFAULT);
+	if (fileId < 0) {
+		std::remove(tempName.c_str());
+		throw std::string(
+				"PSIClusterNetworkCache Exception: unable to create " + tempName
+						+ ".");
+	}
+
+	int fileVersion = version;
+	unsigned long long fileKey = key;
+	writeAttribute(fileId, "version", H5T_STD_I32LE, H5T_NATIVE_INT,
+			&fileVersion);
+	writeAttribute(fileId, "key", H5T_STD_U64LE, H5T_NATIVE_ULLONG, &fileKey);
+	writeAttribute(fileId, "temperature", H5T_IEEE_F64LE, H5T_NATIVE_DOUBLE,
+			&temperature);
+
+	writeTable(fileId, "clusters", clusterColumns, compositions);
+	writeTable(fileId, "superClusters", superColumns, supers);
+	writeTable(fileId, "reactingPairs", pairColumns, reacting);
+	writeTable(fileId, "combiningReactants", combiningColumns, combining);
+	writeTable(fileId, "dissociatingPairs", pairColumns, dissociating);
+	writeTable(fileId, "emissionPairs", pairColumns, emission);
+	writeTable(fileId, "superProductionLists", productionListColumns,
+			productionLists);
+	writeTable(fileId, "superDissociationLists", dissociationListColumns,
+			dissociationLists);
+
+	H5Fclose(fileId);
+
+	if (std::rename(tempName.c_str(), fileName.c_str()) != 0) {
+		std::remove(tempName.c_str());
+		throw std::string(
+				"PSIClusterNetworkCache Exception: unable to replace "
+						+ fileName + ".");
+	}
+
+	return;
+}
@@ -0,0 +1,101 @@
+#ifndef PSICLUSTERNETWORKCACHE_H
+#define PSICLUSTERNETWORKCACHE_H
+
+// Includes
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <IHandlerRegistry.h>
+
+namespace xolotlCore {
+
+class PSIClusterReactionNetwork;
+
+/**
+ * This class stores the compiled reaction tables of a PSI network in an HDF5
+ * file so that the later runs using the same network file and grouping
+ * parameters don't have to build them again.
+ *
+ * The file holds the production, combination, dissociation and emission pairs
+ * of each cluster (by original composition for the super clusters), the
+ * parameters and dispersions of the super clusters, and their optimized
+ * reactions with the momentum coefficients. The rate constants are not
+ * stored, they are computed when the temperature is set, and the
+ * connectivities are rebuilt from the effective reactions by
+ * reinitializeConnectivities().
+ *
+ * The file is identified by a version number and a key hashing the content
+ * of the network file with the grouping parameters. A file with another
+ * version or key is ignored and replaced.
+ *
+ * The optimized reactions only keep the reactions with a non zero rate at the
+ * temperature they were compiled at, so they are only reused at this
+ * temperature. At another temperature they are built again from the pairs.
+ */
+class PSIClusterNetworkCache {
+
+private:
+
+	//! The name of the cache file
+	std::string fileName;
+
+	//! The key of the network file and grouping parameters
+	std::uint64_t key;
+
+	//! The vacancy size at which the grouping scheme starts
+	int vMin;
+
+	//! Does the file match the version and key?
+	bool valid;
+
+public:
+
+	//! The version of the file layout, to increment when it changes
+	static const int version = 1;
+
+	/**
+	 * The constructor computes the key and checks if the file can be used.
+	 *
+	 * @param fileName The name of the cache file
+	 * @param networkVector The clusters read from the network file
+	 * @param vMin The vacancy size at which the grouping scheme starts
+	 * @param heWidth The width of the groups in the helium direction
+	 * @param vWidth The width of the groups in the vacancy direction
+	 */
+	PSIClusterNetworkCache(const std::string& fileName,
+			const std::vector<std::vector<double> >& networkVector, int vMin,
+			int heWidth, int vWidth);
+
+	/**
+	 * Does the file match the network and grouping parameters?
+	 *
+	 * @return True if the reaction tables can be read from it
+	 */
+	bool isValid() const {
+		return valid;
+	}
+
+	/**
+	 * Group the network and fill the reaction tables of its clusters from
+	 * the file. The network must hold the clusters of the network file, with
+	 * their network set but without their connectivities.
+	 *
+	 * @param network The network
+	 * @param registry The performance handler registry
+	 */
+	void restore(std::shared_ptr<PSIClusterReactionNetwork> network,
+			std::shared_ptr<xolotlPerf::IHandlerRegistry> registry);
+
+	/**
+	 * Write the reaction tables of the network in the file if they were
+	 * not read from it. It has to be called after computeRateConstants(),
+	 * only the master process writes.
+	 *
+	 * @param network The network
+	 */
+	void write(PSIClusterReactionNetwork& network);
+};
+
+} /* namespace xolotlCore */
+#endif
@@ -184,6 +184,10 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 		std::shared_ptr<IReactionNetwork> network) {
 	// Get the HeV cluster map
 	auto heVMap = network->getAll(heVType);
+	// The PSI network gives a direct access to the clusters from their
+	// composition
+	auto psiNetwork = std::static_pointer_cast<PSIClusterReactionNetwork>(
+			network);
 
 	// Create a temporary vector for the loop
 	std::vector<PSICluster *> tempVector;
@@ -191,13 +195,14 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 	// Initialize variables for the loop
 	PSICluster * cluster = nullptr;
 	std::shared_ptr<PSISuperCluster> superCluster;
-	static std::map<std::string, int> composition;
+	Composition composition;
 	int count = 0, heIndex = 1, vIndex = vMin, heWidth =
 			heSectionWidth, vWidth = vSectionWidth;
 	double heSize = 0.0, vSize = 0.0, radius = 0.0, energy = 0.0;
 
-	// Map to know which cluster is in which group
-	std::map<std::vector<int>, std::pair<int, int> > clusterGroupMap;
+	// Map to know which cluster is in which group, indexed by the helium
+	// and vacancy sizes of the cluster
+	std::map<std::pair<int, int>, std::pair<int, int> > clusterGroupMap;
 	// Map to know which super cluster gathers which group
 	std::map<std::pair<int, int>, PSISuperCluster *> superGroupMap;
 
@@ -207,10 +212,7 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 		// Loop within the group
 		for (int m = k * 4 - 3; m < (k + 1) * 4; m++) {
 			// Get the corresponding cluster
-			std::vector<int> compositionVector = { m, k, 0 };
-			// Get the product of the same type as the second reactant
-			cluster = (PSICluster *) network->getCompound(heVType,
-					compositionVector);
+			cluster = (PSICluster *) psiNetwork->getCluster(m, k, 0);
 
 			// Verify if the cluster exists
 			if (!cluster)
@@ -226,7 +228,7 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 			radius += cluster->getReactionRadius();
 			energy += cluster->getFormationEnergy();
 			// Keep the information of the group
-			clusterGroupMap[compositionVector] = std::make_pair(-1, k);
+			clusterGroupMap[std::make_pair(m, k)] = std::make_pair(-1, k);
 		}
 
 		// Check if there were clusters in this group
@@ -272,17 +274,14 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 			for (int n = vIndex; n < vIndex + vWidth; n++) {
 				for (int m = heIndex; m < heIndex + heWidth; m++) {
 					// Get the corresponding cluster
-					std::vector<int> compositionVector = { m, n, 0 };
-					// Get the product of the same type as the second reactant
-					cluster = (PSICluster *) network->getCompound(heVType,
-							compositionVector);
+					cluster = (PSICluster *) psiNetwork->getCluster(m, n, 0);
 
 					// Verify if the cluster exists
 					if (!cluster)
 						continue;
 
 					// Verify it was not already used
-					if (clusterGroupMap.find(compositionVector)
+					if (clusterGroupMap.find(std::make_pair(m, n))
 							!= clusterGroupMap.end())
 						continue;
 
@@ -306,7 +305,7 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 					radius += cluster->getReactionRadius();
 					energy += cluster->getFormationEnergy();
 					// Keep the information of the group
-					clusterGroupMap[compositionVector] = std::make_pair(j, k);
+					clusterGroupMap[std::make_pair(m, n)] = std::make_pair(j, k);
 				}
 			}
 
@@ -388,17 +387,15 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 				// Get its composition
 				composition = react[l].first->getComposition();
 				// Test its size
-				if (composition[vType] >= vMin) {
+				if (composition[PSISpecies::V] >= vMin) {
 					// It has to be replaced by a super cluster
-					std::vector<int> compositionVector = { composition[heType],
-							composition[vType], 0 };
-					newCluster =
-							superGroupMap[clusterGroupMap[compositionVector]];
+					newCluster = superGroupMap[clusterGroupMap[std::make_pair(
+							composition[PSISpecies::He], composition[PSISpecies::V])]];
 					react[l].first = newCluster;
 					react[l].firstHeDistance = newCluster->getHeDistance(
-							composition[heType]);
+							composition[PSISpecies::He]);
 					react[l].firstVDistance = newCluster->getVDistance(
-							composition[vType]);
+							composition[PSISpecies::V]);
 				}
 			}
 
@@ -407,17 +404,15 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 				// Get its composition
 				composition = react[l].second->getComposition();
 				// Test its size
-				if (composition[vType] >= vMin) {
+				if (composition[PSISpecies::V] >= vMin) {
 					// It has to be replaced by a super cluster
-					std::vector<int> compositionVector = { composition[heType],
-							composition[vType], 0 };
-					newCluster =
-							superGroupMap[clusterGroupMap[compositionVector]];
+					newCluster = superGroupMap[clusterGroupMap[std::make_pair(
+							composition[PSISpecies::He], composition[PSISpecies::V])]];
 					react[l].second = newCluster;
 					react[l].secondHeDistance = newCluster->getHeDistance(
-							composition[heType]);
+							composition[PSISpecies::He]);
 					react[l].secondVDistance = newCluster->getVDistance(
-							composition[vType]);
+							composition[PSISpecies::V]);
 				}
 			}
 		}
@@ -429,17 +424,15 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 				// Get its composition
 				composition = combi[l].combining->getComposition();
 				// Test its size
-				if (composition[vType] >= vMin) {
+				if (composition[PSISpecies::V] >= vMin) {
 					// It has to be replaced by a super cluster
-					std::vector<int> compositionVector = { composition[heType],
-							composition[vType], 0 };
-					newCluster =
-							superGroupMap[clusterGroupMap[compositionVector]];
+					newCluster = superGroupMap[clusterGroupMap[std::make_pair(
+							composition[PSISpecies::He], composition[PSISpecies::V])]];
 					combi[l].combining = newCluster;
 					combi[l].heDistance = newCluster->getHeDistance(
-							composition[heType]);
+							composition[PSISpecies::He]);
 					combi[l].vDistance = newCluster->getVDistance(
-							composition[vType]);
+							composition[PSISpecies::V]);
 				}
 			}
 		}
@@ -451,17 +444,15 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 				// Get its composition
 				composition = disso[l].first->getComposition();
 				// Test its size
-				if (composition[vType] >= vMin) {
+				if (composition[PSISpecies::V] >= vMin) {
 					// It has to be replaced by a super cluster
-					std::vector<int> compositionVector = { composition[heType],
-							composition[vType], 0 };
-					newCluster =
-							superGroupMap[clusterGroupMap[compositionVector]];
+					newCluster = superGroupMap[clusterGroupMap[std::make_pair(
+							composition[PSISpecies::He], composition[PSISpecies::V])]];
 					disso[l].first = newCluster;
 					disso[l].firstHeDistance = newCluster->getHeDistance(
-							composition[heType]);
+							composition[PSISpecies::He]);
 					disso[l].firstVDistance = newCluster->getVDistance(
-							composition[vType]);
+							composition[PSISpecies::V]);
 				}
 			}
 
@@ -470,17 +461,15 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 				// Get its composition
 				composition = disso[l].second->getComposition();
 				// Test its size
-				if (composition[vType] >= vMin) {
+				if (composition[PSISpecies::V] >= vMin) {
 					// It has to be replaced by a super cluster
-					std::vector<int> compositionVector = { composition[heType],
-							composition[vType], 0 };
-					newCluster =
-							superGroupMap[clusterGroupMap[compositionVector]];
+					newCluster = superGroupMap[clusterGroupMap[std::make_pair(
+							composition[PSISpecies::He], composition[PSISpecies::V])]];
 					disso[l].second = newCluster;
 					disso[l].secondHeDistance = newCluster->getHeDistance(
-							composition[heType]);
+							composition[PSISpecies::He]);
 					disso[l].secondVDistance = newCluster->getVDistance(
-							composition[vType]);
+							composition[PSISpecies::V]);
 				}
 			}
 		}
@@ -492,17 +481,15 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 				// Get its composition
 				composition = emi[l].first->getComposition();
 				// Test its size
-				if (composition[vType] >= vMin) {
+				if (composition[PSISpecies::V] >= vMin) {
 					// It has to be replaced by a super cluster
-					std::vector<int> compositionVector = { composition[heType],
-							composition[vType], 0 };
-					newCluster =
-							superGroupMap[clusterGroupMap[compositionVector]];
+					newCluster = superGroupMap[clusterGroupMap[std::make_pair(
+							composition[PSISpecies::He], composition[PSISpecies::V])]];
 					emi[l].first = newCluster;
 					emi[l].firstHeDistance = newCluster->getHeDistance(
-							composition[heType]);
+							composition[PSISpecies::He]);
 					emi[l].firstVDistance = newCluster->getVDistance(
-							composition[vType]);
+							composition[PSISpecies::V]);
 				}
 			}
 
@@ -511,17 +498,15 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 				// Get its composition
 				composition = emi[l].second->getComposition();
 				// Test its size
-				if (composition[vType] >= vMin) {
+				if (composition[PSISpecies::V] >= vMin) {
 					// It has to be replaced by a super cluster
-					std::vector<int> compositionVector = { composition[heType],
-							composition[vType], 0 };
-					newCluster =
-							superGroupMap[clusterGroupMap[compositionVector]];
+					newCluster = superGroupMap[clusterGroupMap[std::make_pair(
+							composition[PSISpecies::He], composition[PSISpecies::V])]];
 					emi[l].second = newCluster;
 					emi[l].secondHeDistance = newCluster->getHeDistance(
-							composition[heType]);
+							composition[PSISpecies::He]);
 					emi[l].secondVDistance = newCluster->getVDistance(
-							composition[vType]);
+							composition[PSISpecies::V]);
 				}
 			}
 		}
@@ -549,7 +534,7 @@ void PSIClusterNetworkLoader::applySectionalGrouping(
 		composition = currCluster->getComposition();
 
 		// Check if the cluster is too large.
-		if (composition[vType] >= vMin) {
+		if (composition[PSISpecies::V] >= vMin) {
 			// The cluster is too large.  Add it to the ones we will remove.
 			doomedReactants.push_back(currCluster);
 		}
@@ -1,8 +1,11 @@
 #include "PSIClusterReactionNetwork.h"
 #include "PSICluster.h"
 #include "PSISuperCluster.h"
+#include "PSIClusterNetworkCache.h"
 #include <xolotlPerf.h>
 #include <Constants.h>
+#include <tuple>
+#include <unordered_map>
 
 using namespace xolotlCore;
 
@@ -36,31 +39,23 @@ PSIClusterReactionNetwork::PSIClusterReactionNetwork(
 // Reset the properties table so that it can be properly updated when the
 // network is filled.
  setDefaultPropsAndNames();
-// Get all of the reactants from the other network and add them to this one
-// Load the single-species clusters. Calling getAll() will not work because
-// it is not const.
- std::vector<std::shared_ptr<IReactant> > reactants;
- for (auto it = other.singleSpeciesMap.begin();  
-           it != other.singleSpeciesMap.end(); ++it) 
+// Get all of the reactants from the other network and add them to this one,
+// type by type. Calling getAll() will not work because it is not const.
+ for (auto it = other.clusterTypeMap.begin(); it != other.clusterTypeMap.end(); ++it) 
  {
-  reactants.push_back(it->second);
- }
-// Load the mixed-species clusters
- for (auto it = other.mixedSpeciesMap.begin();
-      it != other.mixedSpeciesMap.end(); ++it) 
- {
-  reactants.push_back(it->second);
- }
-// Load the super-species clusters
- for (auto it = other.superSpeciesMap.begin();
- 		it != other.superSpeciesMap.end(); ++it) 
- {
-  reactants.push_back(it->second);
+// The super clusters are added last
+  if (it->first == PSISuperType) continue;
+  auto clusters = it->second;
+  for (unsigned int i = 0; i < clusters->size(); i++) 
+  {
+   add(clusters->at(i)->clone());
+  }
  }
-
- for (unsigned int i = 0; i < reactants.size(); i++) 
+// Load the super clusters
+ auto superClusters = other.clusterTypeMap.at(PSISuperType);
+ for (unsigned int i = 0; i < superClusters->size(); i++) 
  {
-  add(reactants[i]->clone());
+  addSuper(superClusters->at(i)->clone());
  }
 
  return;
@@ -126,6 +121,16 @@ PSIClusterReactionNetwork::setDefaultPropsAndNames()
 void 
 PSIClusterReactionNetwork::setTemperature(double temp) 
 {
+// Use the flat arrays of the rate kernel when they describe the current
+// reactions
+ if (!rateSlots.empty() && rateKernel.size() == (int) rateSlots.size()) 
+ {
+  rateKernel.compute(temp, kernelRates);
+  setRateTable(kernelRates);
+
+  return;
+ }
+
  ReactionNetwork::setTemperature(temp);
 
  for (int i = 0; i < networkSize; i++) 
@@ -151,31 +156,13 @@ PSIClusterReactionNetwork::getTemperature() const
 IReactant* 
 PSIClusterReactionNetwork::get( const std::string& type, const int size ) const 
 {
-// Local Declarations
- static std::map<std::string, int> composition = { { heType, 0 },
- { vType, 0 }, { iType, 0 }, { xeType, 0 } };
-
- std::shared_ptr<IReactant> retReactant;
-
-// Initialize the values because it's static
- composition[heType] = 0;
- composition[vType] = 0;
- composition[iType] = 0;
-
 // Only pull the reactant if the name and size are valid
- if ((type == heType || type == vType || type == iType) && size >= 1) 
- {
-  composition[type] = size;
-//std::string encodedName = PSICluster::encodeCompositionAsName(composition);
-// Make sure the reactant is in the map
-  std::string compStr = Reactant::toCanonicalString(type, composition);
-  if (singleSpeciesMap.count(compStr)) 
-  {
-   retReactant = singleSpeciesMap.at(compStr);
-  }
- }
+ if (size < 1) return nullptr;
+ if (type == heType) return clusterTable.get(size, 0, 0);
+ if (type == vType) return clusterTable.get(0, size, 0);
+ if (type == iType) return clusterTable.get(0, 0, size);
 
- return retReactant.get();
+ return nullptr;
 }
 
 //--------------------------------------------------------------------------------
@@ -183,43 +170,16 @@ IReactant*
 PSIClusterReactionNetwork::getCompound( const std::string& type,
                                         const std::vector<int>& sizes ) const 
 {
-// Local Declarations
- static std::map<std::string, int> composition = { { heType, 0 },
- { vType, 0 }, { iType, 0 }, { xeType, 0 } };
-
- std::shared_ptr<IReactant> retReactant; // null pointer
-
-// Initialize the values because it's static
- composition[heType] = 0;
- composition[vType]  = 0;
- composition[iType]  = 0;
-
 // Only pull the reactant if the name is valid and there are enough sizes
 // to fill the composition.
  if ( (type == heVType || type == heIType) && sizes.size() == 3 ) 
  {
-  composition[heType] = sizes[0];
-  composition[vType]  = sizes[1];
-  composition[iType]  = sizes[2];
-
-// Make sure the reactant is in the map
-// format is: type:composition, e.g.: HeV:He156I0, HeV:He156I0V39Xe0, HeV:He157I0V40
-  std::string compStr = Reactant::toCanonicalString( type, composition );
-
-  if ( mixedSpeciesMap.count( compStr ) ) 
-  {
-   retReactant = mixedSpeciesMap.at( compStr );
-
-/*   std::cout << retReactant->getId() << std::endl;
-   std::cout << retReactant->getCompositionString() << std::endl;
-   std::cout << retReactant->getName() << std::endl;
-   std::cout << std::endl; */
-  }
-
+  IReactant* reactant = clusterTable.get(sizes[0], sizes[1], sizes[2]);
+// Make sure the reactant has the requested type
+  if (reactant && reactant->getType() == type) return reactant;
  }
 
- return retReactant.get();
-
+ return nullptr;
 }
 
 //--------------------------------------------------------------------------------
@@ -227,32 +187,14 @@ IReactant*
 PSIClusterReactionNetwork::getSuper(const std::string& type,
 		const std::vector<int>& sizes) const 
 {
-// Local Declarations
- static std::map<std::string, int> composition = { { heType, 0 },
-        { vType, 0 }, { iType, 0 }, { xeType, 0 } };
- std::shared_ptr<IReactant> retReactant;
-
-// Setup the composition map to default values
- composition[heType] = 0;
- composition[vType] = 0;
- composition[iType] = 0;
-
 // Only pull the reactant if the name is valid and there are enough sizes
 // to fill the composition.
  if (type == PSISuperType && sizes.size() == 3) 
  {
-  composition[heType] = sizes[0];
-  composition[vType] = sizes[1];
-  composition[iType] = sizes[2];
-// Make sure the reactant is in the map
-  std::string compStr = Reactant::toCanonicalString(type, composition);
-  if (superSpeciesMap.count(compStr)) 
-  {
-   retReactant = superSpeciesMap.at(compStr);
-  }
+  return superTable.get(sizes[0], sizes[1], sizes[2]);
  }
 
- return retReactant.get();
+ return nullptr;
 }
 
 //--------------------------------------------------------------------------------
@@ -300,22 +242,22 @@ PSIClusterReactionNetwork::add( std::shared_ptr<IReactant> reactant )
  {
 // Get the composition
   auto composition = reactant->getComposition();
-  std::string compStr = reactant->getCompositionString();
 // Get the species sizes
-  numHe = composition.at(heType);
-  numV = composition.at(vType);
-  numI = composition.at(iType);
+  numHe = composition[PSISpecies::He];
+  numV = composition[PSISpecies::V];
+  numI = composition[PSISpecies::I];
 
 // Determine if the cluster is a compound. If there is more than one
 // type, then the check below will sum to greater than one and we know
 // that we have a mixed cluster.
   isMixed = ((numHe > 0) + (numV > 0) + (numI > 0)) > 1;
 // Only add the element if we don't already have it
+  bool isNew = (clusterTable.get(numHe, numV, numI) == nullptr);
 // Add the compound or regular reactant.
-  if (isMixed && mixedSpeciesMap.count(compStr) == 0) 
+  if (isMixed && isNew) 
   {
-// Put the compound in its map
-   mixedSpeciesMap[compStr] = reactant;
+// Put the compound in the table
+   clusterTable.set(numHe, numV, numI, reactant.get());
 // Figure out whether we have HeV or HeI and set the keys
    if (numV > 0)
    {
@@ -328,10 +270,10 @@ PSIClusterReactionNetwork::add( std::shared_ptr<IReactant> reactant )
     maxClusterSize = &maxHeIClusterSize;
    }
   } 
-  else if (!isMixed && singleSpeciesMap.count(compStr) == 0) 
+  else if (!isMixed && isNew) 
   {
-/// Put the reactant in its map
-   singleSpeciesMap[compStr] = reactant;
+// Put the reactant in the table
+   clusterTable.set(numHe, numV, numI, reactant.get());
 
 // Figure out whether we have He, V or I and set the keys
    if (numHe > 0) 
@@ -392,20 +334,19 @@ PSIClusterReactionNetwork::addSuper(std::shared_ptr<IReactant> reactant)
 	if (reactant != NULL) {
 		// Get the composition
 		auto composition = reactant->getComposition();
-		std::string compStr = reactant->getCompositionString();
 		// Get the species sizes
-		numHe = composition.at(heType);
-		numV = composition.at(vType);
-		numI = composition.at(iType);
+		numHe = composition[PSISpecies::He];
+		numV = composition[PSISpecies::V];
+		numI = composition[PSISpecies::I];
 		// Determine if the cluster is a compound. If there is more than one
 		// type, then the check below will sum to greater than one and we know
 		// that we have a mixed cluster.
 		isMixed = ((numHe > 0) + (numV > 0) + (numI > 0)) > 1;
 		// Only add the element if we don't already have it
 		// Add the compound or regular reactant.
-		if (isMixed && superSpeciesMap.count(compStr) == 0) {
-			// Put the compound in its map
-			superSpeciesMap[compStr] = reactant;
+		if (isMixed && superTable.get(numHe, numV, numI) == nullptr) {
+			// Put the compound in the table
+			superTable.set(numHe, numV, numI, reactant.get());
 			// Set the key
 			numClusters = &numSuperClusters;
 		} else {
@@ -443,6 +384,16 @@ void PSIClusterReactionNetwork::removeReactants(
 	// calls we would build these strings several times in this function.
 	ReactionNetwork::ReactantMatcher doomedReactantMatcher(doomedReactants);
 
+	// Remove the doomed reactants from the lookup table. This must be done
+	// first because the type-specific vectors own the reactants.
+	for (auto reactant : doomedReactants) {
+		auto composition = reactant->getComposition();
+		int numHe = composition[PSISpecies::He], numV = composition[PSISpecies::V], numI =
+				composition[PSISpecies::I];
+		if (clusterTable.get(numHe, numV, numI) == reactant)
+			clusterTable.set(numHe, numV, numI, nullptr);
+	}
+
 	// Remove the doomed reactants from our collection of all known reactants.
 	auto ariter = std::remove_if(allReactants->begin(), allReactants->end(),
 			doomedReactantMatcher);
@@ -465,18 +416,6 @@ void PSIClusterReactionNetwork::removeReactants(
 		clusters->erase(citer, clusters->end());
 	}
 
-	// Remove the doomed reactants from the SpeciesMap.
-	// We cannot use std::remove_if and our ReactantMatcher here
-	// because std::remove_if reorders the elements in the underlying
-	// container to move the doomed elements to the end of the container,
-	// but the std::map doesn't support reordering.
-	for (auto reactant : doomedReactants) {
-		if (reactant->isMixed())
-			mixedSpeciesMap.erase(reactant->getCompositionString());
-		else
-			singleSpeciesMap.erase(reactant->getCompositionString());
-	}
-
 	return;
 }
 
@@ -516,6 +455,213 @@ void PSIClusterReactionNetwork::reinitializeConnectivities() {
 		(*it)->resetConnectivities();
 	}
 
+	// The effective reactions are known now, gather them
+	buildReactionTables();
+
+	// And the addresses of their rate constants
+	buildRateSlots();
+	setReactionRateIndices();
+	buildRateKernel();
+
+	// Save the compiled reaction tables for the next runs
+	if (networkCache) {
+		networkCache->write(*this);
+		networkCache.reset();
+	}
+
+	return;
+}
+
+//--------------------------------------------------------------------------------
+void PSIClusterReactionNetwork::buildRateKernel() {
+	rateKernel.clear();
+
+	// Each cluster describes its rate constants in the order of its slots
+	for (int i = 0; i < networkSize; i++) {
+		auto cluster = (PSICluster *) allReactants->at(i);
+		rateKernel.addCluster(*cluster);
+		cluster->getRateTerms(rateKernel);
+	}
+
+	// Both have to give the same table
+	if (rateKernel.size() != (int) rateSlots.size())
+		throw std::string(
+				"PSIClusterReactionNetwork Exception: the rate kernel does "
+						"not match the rate slots.");
+
+	return;
+}
+
+//--------------------------------------------------------------------------------
+void PSIClusterReactionNetwork::buildReactionTables() {
+	// Clear the previous tables
+	productionReactions.clear();
+	dissociationReactions.clear();
+
+	// A reaction is identified by the id and distances of its participants,
+	// the maps give the indices of the reactions sharing the same key
+	typedef std::tuple<int, double, double, int, double, double> ProductionKey;
+	typedef std::tuple<int, double, double, int, int> DissociationKey;
+	std::map<ProductionKey, std::vector<int> > productionMap;
+	std::map<DissociationKey, std::vector<int> > dissociationMap;
+
+	// Lambda ordering the reactants in the key so that A + B and B + A match
+	auto productionKey = [](PSICluster * first, double firstHe, double firstV,
+			PSICluster * second, double secondHe, double secondV) {
+		auto firstPart = std::make_tuple(first->getId(), firstHe, firstV);
+		auto secondPart = std::make_tuple(second->getId(), secondHe, secondV);
+		if (secondPart < firstPart) std::swap(firstPart, secondPart);
+		return std::tuple_cat(firstPart, secondPart);
+	};
+	// Same for the emitted clusters of a dissociation
+	auto dissociationKey = [](PSICluster * dissociating, double he, double v,
+			PSICluster * first, PSICluster * second) {
+		int firstId = first->getId(), secondId = second->getId();
+		return DissociationKey(dissociating->getId(), he, v,
+				std::min(firstId, secondId), std::max(firstId, secondId));
+	};
+
+	// Each production pair of a normal cluster is a new reaction
+	for (int i = 0; i < networkSize - numSuperClusters; i++) {
+		auto cluster = (PSICluster *) allReactants->at(i);
+		int index = cluster->getId() - 1;
+		for (auto pair : cluster->effReactingPairs) {
+			ProductionReaction reaction(pair->first, pair->second,
+					&pair->kConstant);
+			reaction.firstHeDistance = pair->firstHeDistance;
+			reaction.firstVDistance = pair->firstVDistance;
+			reaction.secondHeDistance = pair->secondHeDistance;
+			reaction.secondVDistance = pair->secondVDistance;
+			reaction.productIndex = index;
+			productionMap[productionKey(pair->first, pair->firstHeDistance,
+					pair->firstVDistance, pair->second, pair->secondHeDistance,
+					pair->secondVDistance)].push_back(
+					productionReactions.size());
+			productionReactions.push_back(reaction);
+		}
+	}
+
+	// Attach the combining clusters to the reactions. A + A is present twice
+	// in the effective combining vector of A so it takes both slots.
+	for (int i = 0; i < networkSize - numSuperClusters; i++) {
+		auto cluster = (PSICluster *) allReactants->at(i);
+		int index = cluster->getId() - 1;
+		for (auto comb : cluster->effCombiningReactants) {
+			auto & candidates = productionMap[productionKey(cluster, 0.0, 0.0,
+					comb->combining, comb->heDistance, comb->vDistance)];
+			bool found = false;
+			for (auto j : candidates) {
+				auto & reaction = productionReactions[j];
+				if (reaction.first == cluster && reaction.firstIndex < 0) {
+					reaction.firstIndex = index;
+					found = true;
+					break;
+				}
+				if (reaction.second == cluster && reaction.secondIndex < 0) {
+					reaction.secondIndex = index;
+					found = true;
+					break;
+				}
+			}
+
+			// The product is not a normal cluster (super cluster or annihilation)
+			if (!found) {
+				ProductionReaction reaction(cluster, comb->combining,
+						&comb->kConstant);
+				reaction.secondHeDistance = comb->heDistance;
+				reaction.secondVDistance = comb->vDistance;
+				reaction.firstIndex = index;
+				candidates.push_back(productionReactions.size());
+				productionReactions.push_back(reaction);
+			}
+		}
+	}
+
+	// Each dissociating pair of a normal cluster is one of the emitted ones
+	for (int i = 0; i < networkSize - numSuperClusters; i++) {
+		auto cluster = (PSICluster *) allReactants->at(i);
+		int index = cluster->getId() - 1;
+		for (auto pair : cluster->effDissociatingPairs) {
+			auto & candidates = dissociationMap[dissociationKey(pair->first,
+					pair->firstHeDistance, pair->firstVDistance, cluster,
+					pair->second)];
+			bool found = false;
+			for (auto j : candidates) {
+				auto & reaction = dissociationReactions[j];
+				if (reaction.first == cluster && reaction.firstIndex < 0) {
+					reaction.firstIndex = index;
+					found = true;
+					break;
+				}
+				if (reaction.second == cluster && reaction.secondIndex < 0) {
+					reaction.secondIndex = index;
+					found = true;
+					break;
+				}
+			}
+
+			if (!found) {
+				DissociationReaction reaction(pair->first, cluster,
+						pair->second, &pair->kConstant);
+				reaction.heDistance = pair->firstHeDistance;
+				reaction.vDistance = pair->firstVDistance;
+				reaction.firstIndex = index;
+				candidates.push_back(dissociationReactions.size());
+				dissociationReactions.push_back(reaction);
+			}
+		}
+	}
+
+	// Attach the dissociating clusters with their emission pairs
+	for (int i = 0; i < networkSize - numSuperClusters; i++) {
+		auto cluster = (PSICluster *) allReactants->at(i);
+		int index = cluster->getId() - 1;
+		for (auto pair : cluster->effEmissionPairs) {
+			auto & candidates = dissociationMap[dissociationKey(cluster, 0.0,
+					0.0, pair->first, pair->second)];
+			bool found = false;
+			for (auto j : candidates) {
+				auto & reaction = dissociationReactions[j];
+				if (reaction.dissociatingIndex < 0) {
+					reaction.dissociatingIndex = index;
+					found = true;
+					break;
+				}
+			}
+
+			if (!found) {
+				DissociationReaction reaction(cluster, pair->first,
+						pair->second, &pair->kConstant);
+				reaction.dissociatingIndex = index;
+				candidates.push_back(dissociationReactions.size());
+				dissociationReactions.push_back(reaction);
+			}
+		}
+	}
+
+	// Shrink the vectors to save some space
+	productionReactions.shrink_to_fit();
+	dissociationReactions.shrink_to_fit();
+
+	return;
+}
+
+//--------------------------------------------------------------------------------
+void PSIClusterReactionNetwork::setReactionRateIndices() {
+	// Map the address of each rate constant to its position
+	std::unordered_map<const double *, int> slotMap;
+	for (int i = 0; i < rateSlots.size(); i++) {
+		slotMap[rateSlots[i]] = i;
+	}
+
+	// The rate constants of all the reactions are stored by normal clusters
+	for (auto & reaction : productionReactions) {
+		reaction.rateIndex = slotMap.at(reaction.kConstant);
+	}
+	for (auto & reaction : dissociationReactions) {
+		reaction.rateIndex = slotMap.at(reaction.kConstant);
+	}
+
 	return;
 }
 
@@ -549,83 +695,63 @@ void PSIClusterReactionNetwork::updateConcentrationsFromArray(
 }
 
 //--------------------------------------------------------------------------------
-void PSIClusterReactionNetwork::getDiagonalFill(int *diagFill) {
-	// Get all the super clusters
-	auto superClusters = getAll(PSISuperType);
+void PSIClusterReactionNetwork::fillDOFArray(double * concentrations) {
+	// Fill the concentrations of the reactants
+	fillConcentrationsArray(concentrations);
+
+	// Fill the moments
+	auto reactants = getAll();
+	int size = reactants->size();
+	for (int i = size - numSuperClusters; i < size; i++) {
+		auto cluster = (PSISuperCluster *) reactants->at(i);
+		concentrations[cluster->getHeMomentumId() - 1] =
+				cluster->getHeMomentum();
+		concentrations[cluster->getVMomentumId() - 1] =
+				cluster->getVMomentum();
+	}
+
+	return;
+}
 
+//--------------------------------------------------------------------------------
+void PSIClusterReactionNetwork::getDiagonalFill(SparseFillMap &diagFill) {
 	// Degrees of freedom is the total number of clusters in the network
 	const int dof = getDOF();
 
+	// The column ids of each row, used to build the CSR pattern
+	std::vector<std::vector<int> > columnIds(dof);
+
 	// Declarations for the loop
-	std::vector<int> connectivity;
-	int connectivityLength, id, index;
+	int id;
 
 	// Get the connectivity for each reactant
 	for (int i = 0; i < networkSize; i++) {
 		// Get the reactant and its connectivity
 		auto reactant = allReactants->at(i);
-		connectivity = reactant->getConnectivity();
-		connectivityLength = connectivity.size();
 		// Get the reactant id so that the connectivity can be lined up in
-		// the proper column
+		// the proper row
 		id = reactant->getId() - 1;
-		// Create the vector that will be inserted into the dFill map
-		std::vector<int> columnIds;
-		// Add it to the diagonal fill block
-		for (int j = 0; j < connectivityLength; j++) {
-			// The id starts at j*connectivity length and is always offset
-			// by the id, which denotes the exact column.
-			index = id * dof + j;
-			diagFill[index] = connectivity[j];
-			// Add a column id if the connectivity is equal to 1.
-			if (connectivity[j] == 1) {
-				columnIds.push_back(j);
-			}
-		}
-		// Update the map
-		dFillMap[id] = columnIds;
+		columnIds[id] = reactant->getConnectivityIds();
 	}
 	// Get the connectivity for each moment
-	for (int i = 0; i < superClusters.size(); i++) {
-		// Get the reactant and its connectivity
-		auto reactant = superClusters[i];
-		connectivity = reactant->getConnectivity();
-		connectivityLength = connectivity.size();
-		// Get the helium momentum id so that the connectivity can be lined up in
-		// the proper column
-		id = reactant->getHeMomentumId() - 1;
-
-		// Create the vector that will be inserted into the dFill map
-		std::vector<int> columnIds;
-		// Add it to the diagonal fill block
-		for (int j = 0; j < connectivityLength; j++) {
-			// The id starts at j*connectivity length and is always offset
-			// by the id, which denotes the exact column.
-			index = (id) * dof + j;
-			diagFill[index] = connectivity[j];
-			// Add a column id if the connectivity is equal to 1.
-			if (connectivity[j] == 1) {
-				columnIds.push_back(j);
-			}
-		}
-		// Update the map
-		dFillMap[id] = columnIds;
-
-		// Get the vacancy momentum id so that the connectivity can be lined up in
-		// the proper column
-		id = reactant->getVMomentumId() - 1;
-
-		// Add it to the diagonal fill block
-		for (int j = 0; j < connectivityLength; j++) {
-			// The id starts at j*connectivity length and is always offset
-			// by the id, which denotes the exact column.
-			index = (id) * dof + j;
-			diagFill[index] = connectivity[j];
-		}
-		// Update the map
-		dFillMap[id] = columnIds;
+	for (int i = networkSize - numSuperClusters; i < networkSize; i++) {
+		// Get the super cluster
+		auto reactant = (PSISuperCluster *) allReactants->at(i);
+		// Both momentums have the same connectivity as the super cluster
+		id = reactant->getId() - 1;
+		columnIds[reactant->getHeMomentumId() - 1] = columnIds[id];
+		columnIds[reactant->getVMomentumId() - 1] = columnIds[id];
+	}
+
+	// Fill the map
+	for (int i = 0; i < dof; i++) {
+		if (!columnIds[i].empty())
+			diagFill[i] = columnIds[i];
 	}
 
+	// Build the CSR pattern used by computeAllPartials
+	setDiagonalFillPattern(columnIds);
+
 	return;
 }
 
@@ -637,12 +763,12 @@ PSIClusterReactionNetwork::getTotalAtomConcentration()
  double heliumConc = 0.0;
 
 // Get all the He clusters
- auto heClusters = getAll(heType);
+ auto & heClusters = *(clusterTypeMap.at(heType));
 // Loop on them
  for (int i = 0; i < heClusters.size(); i++) 
  {
 // Get the cluster and its composition
-  auto cluster = heClusters[i];
+  auto cluster = heClusters[i].get();
   double size = cluster->getSize();
 
 // Add the concentration times the He content to the total helium concentration
@@ -650,25 +776,25 @@ PSIClusterReactionNetwork::getTotalAtomConcentration()
  }
 
 // Get all the HeV clusters
- auto heVClusters = getAll(heVType);
+ auto & heVClusters = *(clusterTypeMap.at(heVType));
 // Loop on them
  for (int i = 0; i < heVClusters.size(); i++) 
  {
 // Get the cluster and its composition
-  auto cluster = heVClusters[i];
+  auto cluster = heVClusters[i].get();
   auto comp = cluster->getComposition();
 
 // Add the concentration times the He content to the total helium concentration
-  heliumConc += cluster->getConcentration() * comp[heType];
+  heliumConc += cluster->getConcentration() * comp[PSISpecies::He];
  }
 
 // Get all the super clusters
- auto superClusters = getAll(PSISuperType);
+ auto & superClusters = *(clusterTypeMap.at(PSISuperType));
 // Loop on them
  for (int i = 0; i < superClusters.size(); i++) 
  {
 // Get the cluster
-  auto cluster = (PSISuperCluster *) superClusters[i];
+  auto cluster = (PSISuperCluster *) superClusters[i].get();
 
 // Add its total helium concentration helium concentration
   heliumConc += cluster->getTotalHeliumConcentration();
@@ -685,25 +811,25 @@ PSIClusterReactionNetwork::getTotalTrappedAtomConcentration()
  double heliumConc = 0.0;
 
 // Get all the HeV clusters
- auto heVClusters = getAll(heVType);
+ auto & heVClusters = *(clusterTypeMap.at(heVType));
 // Loop on them
  for (int i = 0; i < heVClusters.size(); i++) 
  {
 // Get the cluster and its composition
-  auto cluster = heVClusters[i];
+  auto cluster = heVClusters[i].get();
   auto comp = cluster->getComposition();
 
 // Add the concentration times the He content to the total helium concentration
-  heliumConc += cluster->getConcentration() * comp[heType];
+  heliumConc += cluster->getConcentration() * comp[PSISpecies::He];
  }
 
 // Get all the super clusters
- auto superClusters = getAll(PSISuperType);
+ auto & superClusters = *(clusterTypeMap.at(PSISuperType));
 // Loop on them
  for (int i = 0; i < superClusters.size(); i++) 
  {
 // Get the cluster
-  auto cluster = (PSISuperCluster *) superClusters[i];
+  auto cluster = (PSISuperCluster *) superClusters[i].get();
 
 // Add its total helium concentration
   heliumConc += cluster->getTotalHeliumConcentration();
@@ -720,12 +846,12 @@ PSIClusterReactionNetwork::getTotalVConcentration()
  double vConc = 0.0;
 
 // Get all the V clusters
- auto vClusters = getAll(vType);
+ auto & vClusters = *(clusterTypeMap.at(vType));
 // Loop on them
  for (int i = 0; i < vClusters.size(); i++) 
  {
 // Get the cluster and its composition
-  auto cluster = vClusters[i];
+  auto cluster = vClusters[i].get();
   double size = cluster->getSize();
 
 // Add the concentration times the V content to the total vacancy concentration
@@ -733,25 +859,25 @@ PSIClusterReactionNetwork::getTotalVConcentration()
  }
 
 // Get all the HeV clusters
- auto heVClusters = getAll(heVType);
+ auto & heVClusters = *(clusterTypeMap.at(heVType));
 // Loop on them
  for (int i = 0; i < heVClusters.size(); i++) 
  {
 // Get the cluster and its composition
-  auto cluster = heVClusters[i];
+  auto cluster = heVClusters[i].get();
   auto comp = cluster->getComposition();
 
 // Add the concentration times the V content to the total vacancy concentration
-  vConc += cluster->getConcentration() * comp[vType];
+  vConc += cluster->getConcentration() * comp[PSISpecies::V];
  }
 
 // Get all the super clusters
- auto superClusters = getAll(PSISuperType);
+ auto & superClusters = *(clusterTypeMap.at(PSISuperType));
 // Loop on them
  for (int i = 0; i < superClusters.size(); i++) 
  {
 // Get the cluster
-  auto cluster = (PSISuperCluster *) superClusters[i];
+  auto cluster = (PSISuperCluster *) superClusters[i].get();
 
 // Add its total vacancy concentration
   vConc += cluster->getTotalVacancyConcentration();
@@ -768,12 +894,12 @@ PSIClusterReactionNetwork::getTotalIConcentration()
  double iConc = 0.0;
 
 // Get all the V clusters
- auto iClusters = getAll(iType);
+ auto & iClusters = *(clusterTypeMap.at(iType));
 // Loop on them
  for (int i = 0; i < iClusters.size(); i++) 
  {
 // Get the cluster and its composition
-  auto cluster = iClusters[i];
+  auto cluster = iClusters[i].get();
   double size = cluster->getSize();
 
 // Add the concentration times the I content to the total interstitial concentration
@@ -785,42 +911,57 @@ PSIClusterReactionNetwork::getTotalIConcentration()
 
 //--------------------------------------------------------------------------------
 void 
-PSIClusterReactionNetwork::computeAllFluxes(double *updatedConcOffset) 
+PSIClusterReactionNetwork::computeFluxes(const double *concs, 
+                                         double *updatedConcOffset, 
+                                         const RateTable & rates) const 
 {
 // Initial declarations
- IReactant * cluster;
  PSISuperCluster * superCluster;
- double flux = 0.0;
+ double flux = 0.0, superFluxes[3] = { };
  int reactantIndex = 0;
- auto superClusters = getAll(PSISuperType);
 
-// ----- Compute all of the new fluxes -----
- for (int i = 0; i < networkSize; i++) 
+// The table has to come from this network
+ checkRateTable(rates);
+ const double * k = rates.values.data();
+
+// ----- Two body reactions, each one is computed only once -----
+ for (auto it = productionReactions.begin(); it != productionReactions.end(); ++it) 
  {
-  cluster = allReactants->at(i);
-// Compute the flux
-  flux = cluster->getTotalFlux();
-// Update the concentration of the cluster
-  reactantIndex = cluster->getId() - 1;
-  updatedConcOffset[reactantIndex] += flux;
+  flux = k[it->rateIndex]
+         * it->first->getConcentrationFrom(concs, it->firstHeDistance, it->firstVDistance)
+         * it->second->getConcentrationFrom(concs, it->secondHeDistance, it->secondVDistance);
+// Scatter it to the clusters taking part in it
+  if (it->productIndex >= 0) updatedConcOffset[it->productIndex] += flux;
+  if (it->firstIndex >= 0) updatedConcOffset[it->firstIndex] -= flux;
+  if (it->secondIndex >= 0) updatedConcOffset[it->secondIndex] -= flux;
  }
 
-// ---- Moments ----
- for (int i = 0; i < superClusters.size(); i++) 
+// ----- Dissociations -----
+ for (auto it = dissociationReactions.begin(); it != dissociationReactions.end(); ++it) 
  {
-  superCluster = (xolotlCore::PSISuperCluster *) superClusters[i];
+  flux = k[it->rateIndex]
+         * it->dissociating->getConcentrationFrom(concs, it->heDistance, it->vDistance);
+// Scatter it to the clusters taking part in it
+  if (it->dissociatingIndex >= 0) updatedConcOffset[it->dissociatingIndex] -= flux;
+  if (it->firstIndex >= 0) updatedConcOffset[it->firstIndex] += flux;
+  if (it->secondIndex >= 0) updatedConcOffset[it->secondIndex] += flux;
+ }
 
-// Compute the helium momentum flux
-  flux = superCluster->getHeMomentumFlux();
-// Update the concentration of the cluster
-  reactantIndex = superCluster->getHeMomentumId() - 1;
-  updatedConcOffset[reactantIndex] += flux;
+// ----- Super clusters and their moments -----
+// They are the last ones in allReactants
+ for (int i = networkSize - numSuperClusters; i < networkSize; i++) 
+ {
+  superCluster = (xolotlCore::PSISuperCluster *) allReactants->at(i);
 
-// Compute the vacancy momentum flux
-  flux = superCluster->getVMomentumFlux();
-// Update the concentration of the cluster
+// Compute the flux and the momentum fluxes
+  superCluster->computeFluxes(concs, k + rateOffsets[i], superFluxes);
+// Update the concentrations
+  reactantIndex = superCluster->getId() - 1;
+  updatedConcOffset[reactantIndex] += superFluxes[0];
+  reactantIndex = superCluster->getHeMomentumId() - 1;
+  updatedConcOffset[reactantIndex] += superFluxes[1];
   reactantIndex = superCluster->getVMomentumId() - 1;
-  updatedConcOffset[reactantIndex] += flux;
+  updatedConcOffset[reactantIndex] += superFluxes[2];
  }
 
  return;
@@ -828,122 +969,50 @@ PSIClusterReactionNetwork::computeAllFluxes(double *updatedConcOffset)
 
 //--------------------------------------------------------------------------------
 void 
-PSIClusterReactionNetwork::computeAllPartials(double* vals, int* indices, int* size) 
+PSIClusterReactionNetwork::computePartials(const double *concs, double *vals, 
+                                           const RateTable & rates) const 
 {
 // Initial declarations
- int reactantIndex = 0, pdColIdsVectorSize = 0;
- const int dof = getDOF();
- std::vector<double> clusterPartials;
- clusterPartials.resize(dof, 0.0);
-// Get the super clusters
- auto superClusters = getAll(PSISuperType);
-
-// Update the column in the Jacobian that represents each normal reactant
- for (int i = 0; i < networkSize - superClusters.size(); i++) 
- {
-  auto reactant = allReactants->at(i);
-// Get the reactant index
-  reactantIndex = reactant->getId() - 1;
+ int reactantIndex = 0;
+ const int firstSuperIndex = networkSize - numSuperClusters;
+ const int dof = dFillRowPtr.size() - 1;
 
-// Get the partial derivatives
-  reactant->getPartialDerivatives(clusterPartials);
-// Get the list of column ids from the map
-  auto pdColIdsVector = dFillMap.at(reactantIndex);
-// Number of partial derivatives
-  pdColIdsVectorSize = pdColIdsVector.size();
-  size[reactantIndex] = pdColIdsVectorSize;
+// The table has to come from this network
+ checkRateTable(rates);
+ const double * k = rates.values.data();
 
-// Loop over the list of column ids
-  for (int j = 0; j < pdColIdsVectorSize; j++) 
-  {
-// Set the index
-   indices[reactantIndex * dof + j] = pdColIdsVector[j];
+// The dense rows of a cluster and its momentums, owned by this thread
+ double * partials = getThreadScratch(3 * dof);
+ double * hePartials = partials + dof;
+ double * vPartials = partials + 2 * dof;
 
-// Get the partial derivative from the array of all of the partials
-   vals[reactantIndex * dof + j] = clusterPartials[pdColIdsVector[j]];
+// Update the row in the Jacobian that represents each normal reactant
+ for (int i = 0; i < firstSuperIndex; i++) 
+ {
+  auto reactant = (PSICluster *) allReactants->at(i);
+// Get the reactant index
+  reactantIndex = reactant->getId() - 1;
 
-// Reset the cluster partial value to zero. This is much faster
-// than using memset.
-   clusterPartials[pdColIdsVector[j]] = 0.0;
-  }
+// Get the partial derivatives and move them to their CSR row
+  reactant->computePartialDerivatives(concs, k + rateOffsets[i], partials);
+  gatherPartials(reactantIndex, partials, vals);
  }
 
-// Update the column in the Jacobian that represents the moment for the super clusters
- for (int i = 0; i < superClusters.size(); i++) 
+// Update the rows in the Jacobian that represent the super clusters and their momentum
+ for (int i = firstSuperIndex; i < networkSize; i++) 
  {
-  auto reactant = (PSISuperCluster *) superClusters[i];
+  auto reactant = (PSISuperCluster *) allReactants->at(i);
 
-// Get the super cluster index
+// Get the partial derivatives of the three rows
+  reactant->computePartialDerivatives(concs, k + rateOffsets[i], partials,
+                                      hePartials, vPartials);
+// And move them to their CSR rows
   reactantIndex = reactant->getId() - 1;
-
-// Get the partial derivatives
-  reactant->getPartialDerivatives(clusterPartials);
-// Get the list of column ids from the map
-  auto pdColIdsVector = dFillMap.at(reactantIndex);
-// Number of partial derivatives
-  pdColIdsVectorSize = pdColIdsVector.size();
-  size[reactantIndex] = pdColIdsVectorSize;
-
-// Loop over the list of column ids
-  for (int j = 0; j < pdColIdsVectorSize; j++) 
-  {
-// Set the index
-   indices[reactantIndex * dof + j] = pdColIdsVector[j];
-// Get the partial derivative from the array of all of the partials
-   vals[reactantIndex * dof + j] = clusterPartials[pdColIdsVector[j]];
-
-// Reset the cluster partial value to zero. This is much faster
-// than using memset.
-   clusterPartials[pdColIdsVector[j]] = 0.0;
-  }
-
-// Get the helium momentum index
+  gatherPartials(reactantIndex, partials, vals);
   reactantIndex = reactant->getHeMomentumId() - 1;
-
-// Get the partial derivatives
-  reactant->getHeMomentPartialDerivatives(clusterPartials);
-// Get the list of column ids from the map
-  pdColIdsVector = dFillMap.at(reactantIndex);
-// Number of partial derivatives
-  pdColIdsVectorSize = pdColIdsVector.size();
-  size[reactantIndex] = pdColIdsVectorSize;
-
-// Loop over the list of column ids
-  for (int j = 0; j < pdColIdsVectorSize; j++) 
-  {
-// Set the index
-   indices[reactantIndex * dof + j] = pdColIdsVector[j];
-// Get the partial derivative from the array of all of the partials
-   vals[reactantIndex * dof + j] = clusterPartials[pdColIdsVector[j]];
-
-// Reset the cluster partial value to zero. This is much faster
-// than using memset.
-   clusterPartials[pdColIdsVector[j]] = 0.0;
-  }
-
-// Get the vacancy momentum index
+  gatherPartials(reactantIndex, hePartials, vals);
   reactantIndex = reactant->getVMomentumId() - 1;
-
-// Get the partial derivatives
-  reactant->getVMomentPartialDerivatives(clusterPartials);
-// Get the list of column ids from the map
-  pdColIdsVector = dFillMap.at(reactantIndex);
-// Number of partial derivatives
-  pdColIdsVectorSize = pdColIdsVector.size();
-  size[reactantIndex] = pdColIdsVectorSize;
-
-// Loop over the list of column ids
-  for (int j = 0; j < pdColIdsVectorSize; j++) 
-  {
-// Set the index
-   indices[reactantIndex * dof + j] = pdColIdsVector[j];
-// Get the partial derivative from the array of all of the partials
-   vals[reactantIndex * dof + j] = clusterPartials[pdColIdsVector[j]];
-
-// Reset the cluster partial value to zero. This is much faster
-// than using memset.
-   clusterPartials[pdColIdsVector[j]] = 0.0;
-  }
+  gatherPartials(reactantIndex, vPartials, vals);
  }
 
  return;
@@ -9,12 +9,17 @@
 #include <map>
 #include <unordered_map>
 #include <ReactionNetwork.h>
+#include <ReactantLookupTable.h>
+#include "PSIRateKernel.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 
 namespace xolotlCore {
 
+class PSICluster;
+class PSIClusterNetworkCache;
+
 /**
  *  This class manages the set of reactants and compound reactants (
  *  combinations of normal reactants) for PSI clusters. It also manages a
@@ -32,24 +37,16 @@ class PSIClusterReactionNetwork: public ReactionNetwork {
 private:
 
 	/**
-	 * The map of single-species clusters, indexed by a string representation
-	 * of a map that contains the name of the reactant and its size.
+	 * The lookup table of the single-species and mixed-species clusters,
+	 * indexed by their helium, vacancy and interstitial sizes.
 	 */
-	std::unordered_map<std::string, std::shared_ptr<IReactant> > singleSpeciesMap;
+	ReactantLookupTable clusterTable;
 
 	/**
-	 * The map of mixed or compound species clusters, indexed by a string
-	 * representation of a map that contains the name of the constituents
-	 * of the compound reactant and their sizes.
+	 * The lookup table of the super clusters, indexed by their (truncated)
+	 * helium and vacancy sizes.
 	 */
-	std::unordered_map<std::string, std::shared_ptr<IReactant> > mixedSpeciesMap;
-
-	/**
-	 * The map of super species clusters, indexed by a map that
-	 * contains the name of the constituents of the compound reactant and their
-	 * sizes.
-	 */
-	std::unordered_map<std::string, std::shared_ptr<IReactant> > superSpeciesMap;
+	ReactantLookupTable superTable;
 
 	/**
 	 * This map stores all of the clusters in the network by type.
@@ -86,12 +83,212 @@ private:
 	 */
 	int maxHeIClusterSize;
 
+	/**
+	 * This is a private class that is used to compute the flux of a two body
+	 * reaction A + B --> C only once per call to computeAllFluxes(). The
+	 * flux is then added to the product and removed from both reactants.
+	 *
+	 * The rate constant is not copied, kConstant points to the one stored in
+	 * the clusters so that it stays correct when the temperature changes.
+	 */
+	class ProductionReaction {
+	public:
+
+		/**
+		 * The first reacting cluster
+		 */
+		PSICluster * first;
+
+		/**
+		 * The second reacting cluster
+		 */
+		PSICluster * second;
+
+		/**
+		 * The first cluster helium distance in the group (0.0 for non-super clusters)
+		 */
+		double firstHeDistance;
+
+		/**
+		 * The first cluster vacancy distance in the group (0.0 for non-super clusters)
+		 */
+		double firstVDistance;
+
+		/**
+		 * The second cluster helium distance in the group (0.0 for non-super clusters)
+		 */
+		double secondHeDistance;
+
+		/**
+		 * The second cluster vacancy distance in the group (0.0 for non-super clusters)
+		 */
+		double secondVDistance;
+
+		/**
+		 * Pointer to the reaction constant stored by one of the clusters
+		 */
+		double * kConstant;
+
+		/**
+		 * The position of the reaction constant in the rate tables
+		 */
+		int rateIndex;
+
+		/**
+		 * The index of the product, -1 if it is not a normal cluster of the network
+		 */
+		int productIndex;
+
+		/**
+		 * The index of the first cluster, -1 if it is not losing this flux
+		 */
+		int firstIndex;
+
+		/**
+		 * The index of the second cluster, -1 if it is not losing this flux
+		 */
+		int secondIndex;
+
+		//! The constructor
+		ProductionReaction(PSICluster * firstPtr, PSICluster * secondPtr,
+				double * k) :
+				first(firstPtr), second(secondPtr), firstHeDistance(0.0), firstVDistance(
+						0.0), secondHeDistance(0.0), secondVDistance(0.0), kConstant(
+						k), rateIndex(-1), productIndex(-1), firstIndex(-1), secondIndex(
+						-1) {
+		}
+	};
+
+	/**
+	 * This is a private class that is used to compute the flux of a
+	 * dissociation A --> B + C only once per call to computeAllFluxes().
+	 * The flux is then removed from the dissociating cluster and added to
+	 * both emitted clusters.
+	 */
+	class DissociationReaction {
+	public:
+
+		/**
+		 * The dissociating cluster
+		 */
+		PSICluster * dissociating;
+
+		/**
+		 * The first emitted cluster
+		 */
+		PSICluster * first;
+
+		/**
+		 * The second emitted cluster
+		 */
+		PSICluster * second;
+
+		/**
+		 * The dissociating cluster helium distance in the group (0.0 for non-super clusters)
+		 */
+		double heDistance;
+
+		/**
+		 * The dissociating cluster vacancy distance in the group (0.0 for non-super clusters)
+		 */
+		double vDistance;
+
+		/**
+		 * Pointer to the dissociation constant stored by one of the clusters
+		 */
+		double * kConstant;
+
+		/**
+		 * The position of the dissociation constant in the rate tables
+		 */
+		int rateIndex;
+
+		/**
+		 * The index of the dissociating cluster, -1 if it is not losing this flux
+		 */
+		int dissociatingIndex;
+
+		/**
+		 * The index of the first emitted cluster, -1 if it is not gaining this flux
+		 */
+		int firstIndex;
+
+		/**
+		 * The index of the second emitted cluster, -1 if it is not gaining this flux
+		 */
+		int secondIndex;
+
+		//! The constructor
+		DissociationReaction(PSICluster * dissociatingPtr,
+				PSICluster * firstPtr, PSICluster * secondPtr, double * k) :
+				dissociating(dissociatingPtr), first(firstPtr), second(
+						secondPtr), heDistance(0.0), vDistance(0.0), kConstant(
+						k), rateIndex(-1), dissociatingIndex(-1), firstIndex(-1), secondIndex(
+						-1) {
+		}
+	};
+
+	/**
+	 * All the two body reactions of the network where at least one of the
+	 * participating clusters is not a super cluster.
+	 */
+	std::vector<ProductionReaction> productionReactions;
+
+	/**
+	 * All the dissociations of the network where at least one of the
+	 * participating clusters is not a super cluster.
+	 */
+	std::vector<DissociationReaction> dissociationReactions;
+
+	/**
+	 * The cache where the reaction tables are written once they are
+	 * compiled, null if there is none or if they were already written.
+	 */
+	std::shared_ptr<PSIClusterNetworkCache> networkCache;
+
+	/**
+	 * The flat arrays used to compute all the rate constants when the
+	 * temperature changes. It is empty until the connectivities are
+	 * initialized.
+	 */
+	PSIRateKernel rateKernel;
+
+	/**
+	 * The values computed by the rate kernel at the current temperature.
+	 */
+	RateTable kernelRates;
+
 	/**
 	 * This operation sets the default values of the properties table and names
 	 * for this network. It is used on construction and during a copy.
 	 */
 	void setDefaultPropsAndNames();
 
+	/**
+	 * This operation gathers the effective reactions of all the normal
+	 * clusters into the productionReactions and dissociationReactions
+	 * vectors, merging the entries describing the same reaction so that
+	 * each one is only evaluated once by computeAllFluxes().
+	 *
+	 * Super clusters are not handled here because they compute their fluxes
+	 * and momentum fluxes themselves.
+	 */
+	void buildReactionTables();
+
+	/**
+	 * This operation finds the position in the rate tables of the rate
+	 * constant of each reaction of the productionReactions and
+	 * dissociationReactions vectors. It has to be called after
+	 * buildRateSlots().
+	 */
+	void setReactionRateIndices();
+
+	/**
+	 * This operation describes the rate constants of all the clusters to the
+	 * rate kernel. It has to be called after buildRateSlots().
+	 */
+	void buildRateKernel();
+
 	/**
 	 * The Constructor
 	 */
@@ -121,6 +318,9 @@ public:
 	 * This is the simplest way to set the temperature for all reactants is to
 	 * call the ReactionNetwork::setTemperature() operation.
 	 *
+	 * Once the connectivities are initialized, all the values are computed
+	 * by the rate kernel instead and copied in the reactants.
+	 *
 	 * @param temp The new temperature
 	 */
 	virtual void setTemperature(double temp);
@@ -170,6 +370,33 @@ public:
 	IReactant * getSuper(const std::string& type,
 			const std::vector<int>& sizes) const;
 
+	/**
+	 * This operation returns the single-species or mixed-species cluster
+	 * with the given composition if it exists in the network or null if not.
+	 * It is a direct lookup in a table, get() and getCompound() should be
+	 * avoided in loops.
+	 *
+	 * @param numHe The number of helium atoms
+	 * @param numV The number of vacancies
+	 * @param numI The number of interstitials
+	 * @return A pointer to the cluster
+	 */
+	IReactant * getCluster(int numHe, int numV, int numI) const {
+		return clusterTable.get(numHe, numV, numI);
+	}
+
+	/**
+	 * This operation returns the super cluster with the given composition if
+	 * it exists in the network or null if not.
+	 *
+	 * @param numHe The number of helium atoms
+	 * @param numV The number of vacancies
+	 * @return A pointer to the super cluster
+	 */
+	IReactant * getSuperCluster(int numHe, int numV) const {
+		return superTable.get(numHe, numV, 0);
+	}
+
 	/**
 	 * This operation returns all reactants in the network without regard for
 	 * their composition or whether they are compound reactants. The list may
@@ -248,10 +475,24 @@ public:
 
 	/**
 	 * This method redefines the connectivities for each cluster in the
-	 * allReactans vector.
+	 * allReactans vector and rebuilds the reaction tables used to compute
+	 * the fluxes. It has to be called after computeRateConstants().
+	 *
+	 * The compiled reaction tables are written in the network cache the
+	 * first time it is called.
 	 */
 	void reinitializeConnectivities();
 
+	/**
+	 * This operation sets the cache where the compiled reaction tables
+	 * are written.
+	 *
+	 * @param cache The network cache
+	 */
+	void setNetworkCache(std::shared_ptr<PSIClusterNetworkCache> cache) {
+		networkCache = cache;
+	}
+
 	/**
 	 * This operation updates the concentrations for all reactants in the
 	 * network from an array.
@@ -263,6 +504,16 @@ public:
 	 */
 	void updateConcentrationsFromArray(double * concentrations);
 
+	/**
+	 * This operation fills an array of doubles with the concentrations of all
+	 * of the reactants and the helium and vacancy momentums of the super
+	 * clusters.
+	 *
+	 * @param concentrations The array that will be filled, its size is
+	 * getDOF()
+	 */
+	void fillDOFArray(double * concentrations);
+
 	/**
 	 * This operation returns the size or number of reactants and momentums in the network.
 	 *
@@ -275,9 +526,9 @@ public:
 	/**
 	 * Get the diagonal fill for the Jacobian, corresponding to the reactions.
 	 *
-	 * @param diagFill The pointer to the vector where the connectivity information is kept
+	 * @param diagFill The map where the connectivity information is kept
 	 */
-	void getDiagonalFill(int *diagFill);
+	void getDiagonalFill(SparseFillMap &diagFill);
 
 	/**
 	 * Get the total concentration of atoms contained in the network.
@@ -312,26 +563,33 @@ public:
 	double getTotalIConcentration();
 
 	/**
-	 * Compute the fluxes generated by all the reactions
-	 * for all the clusters and their momentums.
+	 * Compute the fluxes generated by all the reactions for all the clusters
+	 * and their momentums from the given concentrations and rate table only.
+	 *
+	 * Each reaction is evaluated only once and its flux is scattered to all
+	 * the normal clusters taking part in it. Super clusters still compute
+	 * their own fluxes because of the momentum equations.
 	 *
-	 * @param updatedConcOffset The pointer to the array of the concentration at the grid
-	 * point where the fluxes are computed used to find the next solution
+	 * @param concs The concentrations at the grid point, indexed by id - 1
+	 * @param updatedConcOffset The pointer to the array where the fluxes are
+	 * added
+	 * @param rates The rate table at the temperature of the grid point
 	 */
-	void computeAllFluxes(double *updatedConcOffset);
+	void computeFluxes(const double *concs, double *updatedConcOffset,
+			const RateTable & rates) const;
 
 	/**
-	 * Compute the partial derivatives generated by all the reactions
-	 * for all the clusters and their momentum.
+	 * Compute the partial derivatives generated by all the reactions for all
+	 * the clusters and their momentums from the given concentrations and rate
+	 * table only, in the CSR pattern of computeAllPartials().
 	 *
+	 * @param concs The concentrations at the grid point, indexed by id - 1
 	 * @param vals The pointer to the array that will contain the values of
 	 * partials for the reactions
-	 * @param indices The pointer to the array that will contain the indices
-	 * of the clusters
-	 * @param size The pointer to the array that will contain the number of reactions for
-	 * this cluster
+	 * @param rates The rate table at the temperature of the grid point
 	 */
-	virtual void computeAllPartials(double *vals, int *indices, int *size);
+	void computePartials(const double *concs, double *vals,
+			const RateTable & rates) const;
 
 	/**
 	 * Number of He clusters in our network.
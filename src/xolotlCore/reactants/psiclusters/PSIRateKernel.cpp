@@ -0,0 +1,178 @@
+#include "PSIRateKernel.h"
+#include "PSICluster.h"
+#include <Constants.h>
+#include <MathUtils.h>
+#include <cmath>
+#include <string>
+
+using namespace xolotlCore;
+
+void PSIRateKernel::clear() {
+	diffusionFactors.clear();
+	migrationEnergies.clear();
+	valueOffsets.clear();
+	firstTerms.clear();
+	nProductions.clear();
+	firstIndices.clear();
+	secondIndices.clear();
+	prefactors.clear();
+	divisors.clear();
+	dissociationTerms.clear();
+	bindingEnergies.clear();
+
+	return;
+}
+
+void PSIRateKernel::addCluster(const PSICluster & cluster) {
+	// The cluster is stored at the position of its id, the clusters have to
+	// be added in the order of the network
+	if (cluster.getId() != (int) diffusionFactors.size() + 1)
+		throw std::string(
+				"PSIRateKernel Exception: the clusters have to be added "
+						"in the order of their ids.");
+
+	// A cluster that doesn't diffuse gets exp(0) * 0 = 0 as diffusion
+	// coefficient, whatever its migration energy
+	double factor = cluster.getDiffusionFactor();
+	if (xolotlCore::equal(factor, 0.0)) {
+		diffusionFactors.push_back(0.0);
+		migrationEnergies.push_back(0.0);
+	} else {
+		diffusionFactors.push_back(factor);
+		migrationEnergies.push_back(cluster.getMigrationEnergy());
+	}
+
+	// Its values start with the temperature, diffusion coefficient and
+	// biggest rate
+	valueOffsets.push_back(size());
+	firstTerms.push_back(prefactors.size());
+	nProductions.push_back(0);
+
+	return;
+}
+
+void PSIRateKernel::addTerm(const PSICluster & first,
+		const PSICluster & second, double divisor) {
+	if (valueOffsets.empty())
+		throw std::string(
+				"PSIRateKernel Exception: a cluster has to be added "
+						"before its rate constants.");
+
+	firstIndices.push_back(first.getId() - 1);
+	secondIndices.push_back(second.getId() - 1);
+	// Same operations as Reactant::calculateReactionRateConstant()
+	prefactors.push_back(
+			4.0 * xolotlCore::pi
+					* (first.getReactionRadius() + second.getReactionRadius()));
+	divisors.push_back(divisor);
+
+	return;
+}
+
+void PSIRateKernel::addProduction(const PSICluster & first,
+		const PSICluster & second, double divisor) {
+	// The production rates are the first ones of the cluster
+	if (nProductions.back() != (int) prefactors.size() - firstTerms.back())
+		throw std::string(
+				"PSIRateKernel Exception: the production rates have to be "
+						"added first.");
+
+	addTerm(first, second, divisor);
+	nProductions.back()++;
+
+	return;
+}
+
+void PSIRateKernel::addCombination(const PSICluster & first,
+		const PSICluster & second, double divisor) {
+	addTerm(first, second, divisor);
+
+	return;
+}
+
+void PSIRateKernel::addDissociation(const PSICluster & dissociating,
+		const PSICluster & single, const PSICluster & second,
+		double divisor) {
+	dissociationTerms.push_back(prefactors.size());
+	// Same operations as Reactant::computeBindingEnergy()
+	bindingEnergies.push_back(
+			single.getFormationEnergy() + second.getFormationEnergy()
+					- dissociating.getFormationEnergy());
+	addTerm(single, second, divisor);
+
+	return;
+}
+
+void PSIRateKernel::compute(double temp, RateTable & table) {
+	int nClusters = diffusionFactors.size();
+	int nTerms = prefactors.size();
+	int nDissociations = bindingEnergies.size();
+	double kT = xolotlCore::kBoltzmann * temp;
+	// The atomic volume, see PSICluster::calculateDissociationConstant()
+	double atomicVolume = 0.5 * xolotlCore::tungstenLatticeConstant
+			* xolotlCore::tungstenLatticeConstant
+			* xolotlCore::tungstenLatticeConstant;
+	double inverseVolume = 1.0 / atomicVolume;
+
+	diffusionCoefficients.resize(nClusters);
+	rates.resize(nTerms);
+	exponentials.resize(nDissociations);
+	double * D = diffusionCoefficients.data();
+	double * k = rates.data();
+	double * e = exponentials.data();
+
+	// The Arrhenius equation of the diffusion coefficients. The exponentials
+	// are computed in their own loop so that it can use a vector exp.
+	for (int i = 0; i < nClusters; i++) {
+		D[i] = -1.0 * migrationEnergies[i] / kT;
+	}
+#pragma omp simd
+	for (int i = 0; i < nClusters; i++) {
+		D[i] = exp(D[i]);
+	}
+	for (int i = 0; i < nClusters; i++) {
+		D[i] = diffusionFactors[i] * D[i];
+	}
+
+	// The reaction rates k+ of all the rate constants
+	for (int i = 0; i < nTerms; i++) {
+		k[i] = prefactors[i] * (D[firstIndices[i]] + D[secondIndices[i]]);
+	}
+
+	// The exponentials of the binding energies
+	for (int i = 0; i < nDissociations; i++) {
+		e[i] = -1.0 * bindingEnergies[i] / kT;
+	}
+#pragma omp simd
+	for (int i = 0; i < nDissociations; i++) {
+		e[i] = exp(e[i]);
+	}
+	for (int i = 0; i < nDissociations; i++) {
+		int index = dissociationTerms[i];
+		k[index] = inverseVolume * k[index] * e[i];
+	}
+
+	// Store everything in the order of the rate tables
+	table.temperature = temp;
+	table.values.resize(size());
+	double * values = table.values.data();
+	for (int i = 0; i < nClusters; i++) {
+		double * clusterValues = values + valueOffsets[i];
+		int first = firstTerms[i];
+		int last = (i + 1 < nClusters) ? firstTerms[i + 1] : nTerms;
+		// The biggest rate is the biggest production rate
+		double biggestRate = 0.0;
+		for (int j = first; j < first + nProductions[i]; j++) {
+			if (k[j] > biggestRate)
+				biggestRate = k[j];
+		}
+		clusterValues[0] = temp;
+		clusterValues[1] = D[i];
+		clusterValues[2] = biggestRate;
+		for (int j = first; j < last; j++) {
+			clusterValues[3 + j - first] = k[j] / divisors[j];
+		}
+	}
+
+	return;
+}
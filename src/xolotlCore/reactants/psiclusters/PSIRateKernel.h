@@ -0,0 +1,155 @@
+#ifndef PSIRATEKERNEL_H
+#define PSIRATEKERNEL_H
+
+// Includes
+#include <vector>
+#include <RateTable.h>
+
+namespace xolotlCore {
+
+class PSICluster;
+
+/**
+ * This class computes all the temperature dependent values of a PSI network
+ * from flat arrays instead of asking each cluster to update its rate
+ * constants pair by pair.
+ *
+ * A rate constant is split into a part that doesn't depend on the
+ * temperature, 4 pi (r_A + r_B) for the reaction A + B, and the diffusion
+ * coefficients of A and B. A dissociation constant also needs the
+ * exponential of its binding energy. These parts are stored once when the
+ * connectivities are initialized and a new temperature only requires a few
+ * passes on contiguous arrays: the diffusion coefficients of all the
+ * clusters, the reaction rates, the exponentials of all the binding
+ * energies, and the final values.
+ *
+ * The values are computed in the order of the rate tables: for each cluster,
+ * its temperature, diffusion coefficient and biggest rate followed by its
+ * rate constants in the order of getRateSlots(). The clusters describe their
+ * rate constants in the same order with getRateTerms().
+ */
+class PSIRateKernel {
+
+private:
+
+	//! The diffusion factor of each cluster, indexed by id - 1
+	std::vector<double> diffusionFactors;
+
+	//! The migration energy of each cluster, zero if it doesn't diffuse
+	std::vector<double> migrationEnergies;
+
+	//! The position of the values of each cluster in the rate tables
+	std::vector<int> valueOffsets;
+
+	//! The index of the first rate constant of each cluster
+	std::vector<int> firstTerms;
+
+	//! The number of production rates of each cluster, they come first
+	std::vector<int> nProductions;
+
+	//! The index of the first cluster giving its diffusion coefficient
+	std::vector<int> firstIndices;
+
+	//! The index of the second cluster giving its diffusion coefficient
+	std::vector<int> secondIndices;
+
+	//! The temperature independent factor 4 pi (r_A + r_B) of each rate
+	std::vector<double> prefactors;
+
+	//! The number each rate is divided by (nTot for the super clusters)
+	std::vector<double> divisors;
+
+	//! The index of the rate of each dissociation
+	std::vector<int> dissociationTerms;
+
+	//! The binding energy of each dissociation
+	std::vector<double> bindingEnergies;
+
+	//! The diffusion coefficients at the current temperature
+	std::vector<double> diffusionCoefficients;
+
+	//! The rates at the current temperature
+	std::vector<double> rates;
+
+	//! The exponentials of the binding energies at the current temperature
+	std::vector<double> exponentials;
+
+	/**
+	 * Add a rate constant of the current cluster.
+	 *
+	 * @param first The first cluster of the reaction
+	 * @param second The second cluster of the reaction
+	 * @param divisor The number the rate is divided by
+	 */
+	void addTerm(const PSICluster & first, const PSICluster & second,
+			double divisor);
+
+public:
+
+	/**
+	 * Remove all the clusters.
+	 */
+	void clear();
+
+	/**
+	 * Add a cluster, in the order of the network. Its rate constants are
+	 * added right after it with the add methods below, the production rates
+	 * first.
+	 *
+	 * @param cluster The cluster
+	 */
+	void addCluster(const PSICluster & cluster);
+
+	/**
+	 * Add the rate of the production A + B --> C of the current cluster, it
+	 * is used for its biggest rate.
+	 *
+	 * @param first The cluster A
+	 * @param second The cluster B
+	 * @param divisor The number the rate is divided by
+	 */
+	void addProduction(const PSICluster & first, const PSICluster & second,
+			double divisor = 1.0);
+
+	/**
+	 * Add the rate of the combination A + B --> C of the current cluster.
+	 *
+	 * @param first The cluster A
+	 * @param second The cluster B
+	 * @param divisor The number the rate is divided by
+	 */
+	void addCombination(const PSICluster & first, const PSICluster & second,
+			double divisor = 1.0);
+
+	/**
+	 * Add the rate of the dissociation A --> B + C of the current cluster.
+	 *
+	 * @param dissociating The cluster A
+	 * @param single The cluster B, the one of size 1
+	 * @param second The cluster C
+	 * @param divisor The number the rate is divided by
+	 */
+	void addDissociation(const PSICluster & dissociating,
+			const PSICluster & single, const PSICluster & second,
+			double divisor = 1.0);
+
+	/**
+	 * Get the number of values computed by compute().
+	 *
+	 * @return The size of the rate tables
+	 */
+	int size() const {
+		return valueOffsets.size() * 3 + prefactors.size();
+	}
+
+	/**
+	 * Compute all the values at the given temperature.
+	 *
+	 * @param temp The temperature
+	 * @param table The rate table where the values are stored
+	 */
+	void compute(double temp, RateTable & table);
+};
+
+} /* end namespace xolotlCore */
+#endif
@@ -1,8 +1,10 @@
 // Includes
 #include "PSISuperCluster.h"
 #include "PSIClusterReactionNetwork.h"
+#include "PSIRateKernel.h"
 #include <Constants.h>
 #include <MathUtils.h>
+#include "MomentumKernels.h"
 
 using namespace xolotlCore;
 
@@ -20,15 +22,15 @@ PSISuperCluster::PSISuperCluster(double numHe, double numV, int nTot,
 		int heWidth, int vWidth, double radius, double energy,
 		std::shared_ptr<xolotlPerf::IHandlerRegistry> registry) :
 		PSICluster(registry), numHe(numHe), numV(numV), nTot(nTot), l0(0.0), l1He(
-				0.0), l1V(0.0), dispersionHe(0.0), dispersionV(0.0), heMomentumFlux(
-				0.0), vMomentumFlux(0.0) {
+				0.0), l1V(0.0), dispersionHe(0.0), dispersionV(0.0), cachedTemperature(
+				-1.0), heMomentumFlux(0.0), vMomentumFlux(0.0) {
 	// Set the cluster size as the sum of
 	// the number of Helium and Vacancies
 	size = (int) (numHe + numV);
 
 	// Update the composition map
-	compositionMap[heType] = (int) (numHe * (double) nTot);
-	compositionMap[vType] = (int) (numV * (double) nTot);
+	composition[PSISpecies::He] = (int) (numHe * (double) nTot);
+	composition[PSISpecies::V] = (int) (numV * (double) nTot);
 
 	// Set the width
 	sectionHeWidth = heWidth;
@@ -76,6 +78,7 @@ PSISuperCluster::PSISuperCluster(PSISuperCluster &other) :
 	effCombiningList = other.effCombiningList;
 	effDissociatingList = other.effDissociatingList;
 	effEmissionList = other.effEmissionList;
+	cachedTemperature = other.cachedTemperature;
 	heMomentumFlux = other.heMomentumFlux;
 	vMomentumFlux = other.vMomentumFlux;
 
@@ -219,7 +222,7 @@ void PSISuperCluster::createReactionConnectivity() {
 		auto combi = heVVector[i]->combiningReactants;
 
 		// Create the key to the map
-		auto key = std::make_pair(comp[heType], comp[vType]);
+		auto key = std::make_pair(comp[PSISpecies::He], comp[PSISpecies::V]);
 
 		// Set them in the super cluster map
 		reactingMap[key] = react;
@@ -240,7 +243,7 @@ void PSISuperCluster::createDissociationConnectivity() {
 		auto emi = heVVector[i]->emissionPairs;
 
 		// Create the key to the map
-		auto key = std::make_pair(comp[heType], comp[vType]);
+		auto key = std::make_pair(comp[PSISpecies::He], comp[PSISpecies::V]);
 
 		// Set them in the super cluster map
 		dissociatingMap[key] = disso;
@@ -251,6 +254,27 @@ void PSISuperCluster::createDissociationConnectivity() {
 }
 
 void PSISuperCluster::computeRateConstants() {
+	// The optimized reactions read from the network cache only keep the
+	// reactions with a non zero rate at the temperature they were compiled at
+	if (xolotlCore::equal(temperature, cachedTemperature)) {
+		// Only the keys of the effective reacting map are used from now on
+		for (auto const& pair : reactingMap) {
+			effReactingMap[pair.first];
+		}
+
+		// The coefficients are known, only the rates have to be computed
+		updateRateConstants();
+
+		return;
+	}
+
+	// The optimized vectors are built from scratch
+	effReactingList.clear();
+	effCombiningList.clear();
+	effDissociatingList.clear();
+	effEmissionList.clear();
+	cachedTemperature = -1.0;
+
 	// Local declarations
 	PSICluster *firstReactant = nullptr, *secondReactant = nullptr,
 			*combiningReactant = nullptr, *dissociatingCluster = nullptr,
@@ -426,8 +450,8 @@ void PSISuperCluster::computeRateConstants() {
 	else
 		dispersionHe = 2.0
 				* (nHeSquare
-						- ((double) compositionMap[heType]
-								* ((double) compositionMap[heType]
+						- ((double) composition[PSISpecies::He]
+								* ((double) composition[PSISpecies::He]
 										/ (double) nTot)))
 				/ ((double) (nTot * (sectionHeWidth - 1)));
 
@@ -436,8 +460,8 @@ void PSISuperCluster::computeRateConstants() {
 	else
 		dispersionV = 2.0
 				* (nVSquare
-						- ((double) compositionMap[vType]
-								* ((double) compositionMap[vType]
+						- ((double) composition[PSISpecies::V]
+								* ((double) composition[PSISpecies::V]
 										/ (double) nTot)))
 				/ ((double) (nTot * (sectionVWidth - 1)));
 
@@ -494,44 +518,44 @@ void PSISuperCluster::optimizeReactions() {
 					if (firstReactantBis == firstReactant
 							&& secondReactantBis == secondReactant) {
 						// First is A, second is B, in A + B -> this
-						superPair.a000 += 1.0;
-						superPair.a001 += heFactor;
-						superPair.a002 += vFactor;
-						superPair.a100 += (*itBis)->firstHeDistance;
-						superPair.a101 += (*itBis)->firstHeDistance * heFactor;
-						superPair.a102 += (*itBis)->firstHeDistance * vFactor;
-						superPair.a200 += (*itBis)->firstVDistance;
-						superPair.a201 += (*itBis)->firstVDistance * heFactor;
-						superPair.a202 += (*itBis)->firstVDistance * vFactor;
-						superPair.a010 += (*itBis)->secondHeDistance;
-						superPair.a011 += (*itBis)->secondHeDistance * heFactor;
-						superPair.a012 += (*itBis)->secondHeDistance * vFactor;
-						superPair.a020 += (*itBis)->secondVDistance;
-						superPair.a021 += (*itBis)->secondVDistance * heFactor;
-						superPair.a022 += (*itBis)->secondVDistance * vFactor;
-						superPair.a110 += (*itBis)->firstHeDistance
+						superPair.a[0][0] += 1.0;
+						superPair.a[0][1] += heFactor;
+						superPair.a[0][2] += vFactor;
+						superPair.a[3][0] += (*itBis)->firstHeDistance;
+						superPair.a[3][1] += (*itBis)->firstHeDistance * heFactor;
+						superPair.a[3][2] += (*itBis)->firstHeDistance * vFactor;
+						superPair.a[6][0] += (*itBis)->firstVDistance;
+						superPair.a[6][1] += (*itBis)->firstVDistance * heFactor;
+						superPair.a[6][2] += (*itBis)->firstVDistance * vFactor;
+						superPair.a[1][0] += (*itBis)->secondHeDistance;
+						superPair.a[1][1] += (*itBis)->secondHeDistance * heFactor;
+						superPair.a[1][2] += (*itBis)->secondHeDistance * vFactor;
+						superPair.a[2][0] += (*itBis)->secondVDistance;
+						superPair.a[2][1] += (*itBis)->secondVDistance * heFactor;
+						superPair.a[2][2] += (*itBis)->secondVDistance * vFactor;
+						superPair.a[4][0] += (*itBis)->firstHeDistance
 								* (*itBis)->secondHeDistance;
-						superPair.a111 += (*itBis)->firstHeDistance
+						superPair.a[4][1] += (*itBis)->firstHeDistance
 								* (*itBis)->secondHeDistance * heFactor;
-						superPair.a112 += (*itBis)->firstHeDistance
+						superPair.a[4][2] += (*itBis)->firstHeDistance
 								* (*itBis)->secondHeDistance * vFactor;
-						superPair.a120 += (*itBis)->firstHeDistance
+						superPair.a[5][0] += (*itBis)->firstHeDistance
 								* (*itBis)->secondVDistance;
-						superPair.a121 += (*itBis)->firstHeDistance
+						superPair.a[5][1] += (*itBis)->firstHeDistance
 								* (*itBis)->secondVDistance * heFactor;
-						superPair.a122 += (*itBis)->firstHeDistance
+						superPair.a[5][2] += (*itBis)->firstHeDistance
 								* (*itBis)->secondVDistance * vFactor;
-						superPair.a210 += (*itBis)->firstVDistance
+						superPair.a[7][0] += (*itBis)->firstVDistance
 								* (*itBis)->secondHeDistance;
-						superPair.a211 += (*itBis)->firstVDistance
+						superPair.a[7][1] += (*itBis)->firstVDistance
 								* (*itBis)->secondHeDistance * heFactor;
-						superPair.a212 += (*itBis)->firstVDistance
+						superPair.a[7][2] += (*itBis)->firstVDistance
 								* (*itBis)->secondHeDistance * vFactor;
-						superPair.a220 += (*itBis)->firstVDistance
+						superPair.a[8][0] += (*itBis)->firstVDistance
 								* (*itBis)->secondVDistance;
-						superPair.a221 += (*itBis)->firstVDistance
+						superPair.a[8][1] += (*itBis)->firstVDistance
 								* (*itBis)->secondVDistance * heFactor;
-						superPair.a222 += (*itBis)->firstVDistance
+						superPair.a[8][2] += (*itBis)->firstVDistance
 								* (*itBis)->secondVDistance * vFactor;
 
 						// Do not delete the element if it is the original one
@@ -553,7 +577,7 @@ void PSISuperCluster::optimizeReactions() {
 			}
 
 			// Add the super pair
-			effReactingList.push_front(superPair);
+			effReactingList.push_back(superPair);
 
 			// Remove the reaction from the vector
 			it = pairs.erase(it);
@@ -599,40 +623,40 @@ void PSISuperCluster::optimizeReactions() {
 					// Check if it is the same reaction
 					if (combiningReactantBis == combiningReactant) {
 						// This is A, itBis is B, in this + B -> C
-						superPair.a000 += 1.0;
-						superPair.a001 += heFactor;
-						superPair.a002 += vFactor;
-						superPair.a010 += (*itBis)->heDistance;
-						superPair.a011 += (*itBis)->heDistance * heFactor;
-						superPair.a012 += (*itBis)->heDistance * vFactor;
-						superPair.a020 += (*itBis)->vDistance;
-						superPair.a021 += (*itBis)->vDistance * heFactor;
-						superPair.a022 += (*itBis)->vDistance * vFactor;
-						superPair.a100 += heDistance;
-						superPair.a101 += heDistance * heFactor;
-						superPair.a102 += heDistance * vFactor;
-						superPair.a200 += vDistance;
-						superPair.a201 += vDistance * heFactor;
-						superPair.a202 += vDistance * vFactor;
-						superPair.a110 += (*itBis)->heDistance * heDistance;
-						superPair.a111 += (*itBis)->heDistance * heDistance
+						superPair.a[0][0] += 1.0;
+						superPair.a[0][1] += heFactor;
+						superPair.a[0][2] += vFactor;
+						superPair.a[1][0] += (*itBis)->heDistance;
+						superPair.a[1][1] += (*itBis)->heDistance * heFactor;
+						superPair.a[1][2] += (*itBis)->heDistance * vFactor;
+						superPair.a[2][0] += (*itBis)->vDistance;
+						superPair.a[2][1] += (*itBis)->vDistance * heFactor;
+						superPair.a[2][2] += (*itBis)->vDistance * vFactor;
+						superPair.a[3][0] += heDistance;
+						superPair.a[3][1] += heDistance * heFactor;
+						superPair.a[3][2] += heDistance * vFactor;
+						superPair.a[6][0] += vDistance;
+						superPair.a[6][1] += vDistance * heFactor;
+						superPair.a[6][2] += vDistance * vFactor;
+						superPair.a[4][0] += (*itBis)->heDistance * heDistance;
+						superPair.a[4][1] += (*itBis)->heDistance * heDistance
 								* heFactor;
-						superPair.a112 += (*itBis)->heDistance * heDistance
+						superPair.a[4][2] += (*itBis)->heDistance * heDistance
 								* vFactor;
-						superPair.a210 += (*itBis)->heDistance * vDistance;
-						superPair.a211 += (*itBis)->heDistance * vDistance
+						superPair.a[7][0] += (*itBis)->heDistance * vDistance;
+						superPair.a[7][1] += (*itBis)->heDistance * vDistance
 								* heFactor;
-						superPair.a212 += (*itBis)->heDistance * vDistance
+						superPair.a[7][2] += (*itBis)->heDistance * vDistance
 								* vFactor;
-						superPair.a120 += (*itBis)->vDistance * heDistance;
-						superPair.a121 += (*itBis)->vDistance * heDistance
+						superPair.a[5][0] += (*itBis)->vDistance * heDistance;
+						superPair.a[5][1] += (*itBis)->vDistance * heDistance
 								* heFactor;
-						superPair.a122 += (*itBis)->vDistance * heDistance
+						superPair.a[5][2] += (*itBis)->vDistance * heDistance
 								* vFactor;
-						superPair.a220 += (*itBis)->vDistance * vDistance;
-						superPair.a221 += (*itBis)->vDistance * vDistance
+						superPair.a[8][0] += (*itBis)->vDistance * vDistance;
+						superPair.a[8][1] += (*itBis)->vDistance * vDistance
 								* heFactor;
-						superPair.a222 += (*itBis)->vDistance * vDistance
+						superPair.a[8][2] += (*itBis)->vDistance * vDistance
 								* vFactor;
 
 						// Do not delete the element if it is the original one
@@ -654,7 +678,7 @@ void PSISuperCluster::optimizeReactions() {
 			}
 
 			// Add the super pair
-			effCombiningList.push_front(superPair);
+			effCombiningList.push_back(superPair);
 
 			// Remove the reaction from the vector
 			it = clusters.erase(it);
@@ -699,15 +723,15 @@ void PSISuperCluster::optimizeReactions() {
 					if (dissociatingClusterBis == dissociatingCluster
 							&& otherEmittedClusterBis == otherEmittedCluster) {
 						// A is the dissociating cluster
-						superPair.a00 += 1.0;
-						superPair.a01 += heFactor;
-						superPair.a02 += vFactor;
-						superPair.a10 += (*itBis)->firstHeDistance;
-						superPair.a11 += (*itBis)->firstHeDistance * heFactor;
-						superPair.a12 += (*itBis)->firstHeDistance * vFactor;
-						superPair.a20 += (*itBis)->firstVDistance;
-						superPair.a21 += (*itBis)->firstVDistance * heFactor;
-						superPair.a22 += (*itBis)->firstVDistance * vFactor;
+						superPair.a[0][0] += 1.0;
+						superPair.a[0][1] += heFactor;
+						superPair.a[0][2] += vFactor;
+						superPair.a[1][0] += (*itBis)->firstHeDistance;
+						superPair.a[1][1] += (*itBis)->firstHeDistance * heFactor;
+						superPair.a[1][2] += (*itBis)->firstHeDistance * vFactor;
+						superPair.a[2][0] += (*itBis)->firstVDistance;
+						superPair.a[2][1] += (*itBis)->firstVDistance * heFactor;
+						superPair.a[2][2] += (*itBis)->firstVDistance * vFactor;
 
 						// Do not delete the element if it is the original one
 						if (itBis == it) {
@@ -728,7 +752,7 @@ void PSISuperCluster::optimizeReactions() {
 			}
 
 			// Add the super pair
-			effDissociatingList.push_front(superPair);
+			effDissociatingList.push_back(superPair);
 
 			// Remove the reaction from the vector
 			it = pairs.erase(it);
@@ -775,15 +799,15 @@ void PSISuperCluster::optimizeReactions() {
 					if (firstClusterBis == firstCluster
 							&& secondClusterBis == secondCluster) {
 						// A is the dissociating cluster
-						superPair.a00 += 1.0;
-						superPair.a01 += heFactor;
-						superPair.a02 += vFactor;
-						superPair.a10 += heDistance;
-						superPair.a11 += heDistance * heFactor;
-						superPair.a12 += heDistance * vFactor;
-						superPair.a20 += vDistance;
-						superPair.a21 += vDistance * heFactor;
-						superPair.a22 += vDistance * vFactor;
+						superPair.a[0][0] += 1.0;
+						superPair.a[0][1] += heFactor;
+						superPair.a[0][2] += vFactor;
+						superPair.a[1][0] += heDistance;
+						superPair.a[1][1] += heDistance * heFactor;
+						superPair.a[1][2] += heDistance * vFactor;
+						superPair.a[2][0] += vDistance;
+						superPair.a[2][1] += vDistance * heFactor;
+						superPair.a[2][2] += vDistance * vFactor;
 
 						// Do not delete the element if it is the original one
 						if (itBis == it) {
@@ -804,13 +828,19 @@ void PSISuperCluster::optimizeReactions() {
 			}
 
 			// Add the super pair
-			effEmissionList.push_front(superPair);
+			effEmissionList.push_back(superPair);
 
 			// Remove the reaction from the vector
 			it = pairs.erase(it);
 		}
 	}
 
+	// Shrink the vectors to save some space
+	effReactingList.shrink_to_fit();
+	effCombiningList.shrink_to_fit();
+	effDissociatingList.shrink_to_fit();
+	effEmissionList.shrink_to_fit();
+
 	// Clear the maps because they won't be used anymore
 	effReactingPairs.clear();
 	effCombiningReactants.clear();
@@ -895,6 +925,52 @@ void PSISuperCluster::updateRateConstants() {
 	return;
 }
 
+void PSISuperCluster::getRateSlots(std::vector<double *> & slots) {
+	// The values of the reactant itself
+	Reactant::getRateSlots(slots);
+
+	// The same rate constants as the ones updated by updateRateConstants()
+	for (auto it = effReactingList.begin(); it != effReactingList.end(); ++it) {
+		slots.push_back(&((*it).kConstant));
+	}
+	for (auto it = effCombiningList.begin(); it != effCombiningList.end();
+			++it) {
+		slots.push_back(&((*it).kConstant));
+	}
+	for (auto it = effDissociatingList.begin(); it != effDissociatingList.end();
+			++it) {
+		slots.push_back(&((*it).kConstant));
+	}
+	for (auto it = effEmissionList.begin(); it != effEmissionList.end(); ++it) {
+		slots.push_back(&((*it).kConstant));
+	}
+
+	return;
+}
+
+void PSISuperCluster::getRateTerms(PSIRateKernel & kernel) const {
+	// Same order and operations as updateRateConstants()
+	for (auto it = effReactingList.begin(); it != effReactingList.end(); ++it) {
+		kernel.addProduction(*(*it).first, *(*it).second, (double) nTot);
+	}
+	for (auto it = effCombiningList.begin(); it != effCombiningList.end();
+			++it) {
+		kernel.addCombination(*this, *(*it).first, (double) nTot);
+	}
+	// The single cluster comes first
+	for (auto it = effDissociatingList.begin(); it != effDissociatingList.end();
+			++it) {
+		kernel.addDissociation(*(*it).first, *(*it).second, *this,
+				(double) nTot);
+	}
+	for (auto it = effEmissionList.begin(); it != effEmissionList.end(); ++it) {
+		kernel.addDissociation(*this, *(*it).first, *(*it).second,
+				(double) nTot);
+	}
+
+	return;
+}
+
 void PSISuperCluster::resetConnectivities() {
 	// Clear both sets
 	reactionConnectivitySet.clear();
@@ -949,145 +1025,72 @@ void PSISuperCluster::resetConnectivities() {
 }
 
 double PSISuperCluster::getTotalFlux() {
-	// Initialize the fluxes
-	heMomentumFlux = 0.0;
-	vMomentumFlux = 0.0;
+	// The flux and momentum fluxes
+	double fluxes[3] = { };
+
+	// Compute them from the current concentrations and rates
+	if (fillStateScratch())
+		computeFluxes(concScratch.data(), rateScratch.data(), fluxes);
 
-	// Get the fluxes
-	double prodFlux = getProductionFlux();
-	double dissFlux = getDissociationFlux();
-	double combFlux = getCombinationFlux();
-	double emissFlux = getEmissionFlux();
+	// Set the momentum fluxes
+	heMomentumFlux = fluxes[1];
+	vMomentumFlux = fluxes[2];
 
-	return prodFlux - combFlux + dissFlux - emissFlux;
+	return fluxes[0];
 }
 
 double PSISuperCluster::getDissociationFlux() {
-	// Initial declarations
-	double flux = 0.0, value = 0.0;
-	PSICluster *dissociatingCluster = nullptr;
+	// The flux and momentum fluxes of each reaction type
+	alignas(32) double results[4][4] = { };
+	if (fillStateScratch())
+		computeReactionFluxes(concScratch.data(), rateScratch.data(), results);
 
-	// Loop over all the dissociating pairs
-	for (auto it = effDissociatingList.begin(); it != effDissociatingList.end();
-			++it) {
-		// Get the dissociating clusters
-		dissociatingCluster = (*it).first;
-		double l0A = dissociatingCluster->getConcentration(0.0, 0.0);
-		double lHeA = dissociatingCluster->getHeMomentum();
-		double lVA = dissociatingCluster->getVMomentum();
-		// Update the flux
-		value = (*it).kConstant;
-		flux += value * ((*it).a00 * l0A + (*it).a10 * lHeA + (*it).a20 * lVA);
-		// Compute the momentum fluxes
-		heMomentumFlux += value
-				* ((*it).a01 * l0A + (*it).a11 * lHeA + (*it).a21 * lVA);
-		vMomentumFlux += value
-				* ((*it).a02 * l0A + (*it).a12 * lHeA + (*it).a22 * lVA);
-	}
+	// Compute the momentum fluxes
+	heMomentumFlux += results[2][1];
+	vMomentumFlux += results[2][2];
 
 	// Return the flux
-	return flux;
+	return results[2][0];
 }
 
 double PSISuperCluster::getEmissionFlux() {
-	// Initial declarations
-	double flux = 0.0, value = 0.0;
+	// The flux and momentum fluxes of each reaction type
+	alignas(32) double results[4][4] = { };
+	if (fillStateScratch())
+		computeReactionFluxes(concScratch.data(), rateScratch.data(), results);
 
-	// Loop over all the emission pairs
-	for (auto it = effEmissionList.begin(); it != effEmissionList.end(); ++it) {
-		// Update the flux
-		value = (*it).kConstant;
-		flux += value * ((*it).a00 * l0 + (*it).a10 * l1He + (*it).a20 * l1V);
-		// Compute the momentum fluxes
-		heMomentumFlux -= value
-				* ((*it).a01 * l0 + (*it).a11 * l1He + (*it).a21 * l1V);
-		vMomentumFlux -= value
-				* ((*it).a02 * l0 + (*it).a12 * l1He + (*it).a22 * l1V);
-	}
+	// Compute the momentum fluxes
+	heMomentumFlux -= results[3][1];
+	vMomentumFlux -= results[3][2];
 
-	return flux;
+	return results[3][0];
 }
 
 double PSISuperCluster::getProductionFlux() {
-	// Local declarations
-	double flux = 0.0, value = 0.0;
-	PSICluster *firstReactant = nullptr, *secondReactant = nullptr;
+	// The flux and momentum fluxes of each reaction type
+	alignas(32) double results[4][4] = { };
+	if (fillStateScratch())
+		computeReactionFluxes(concScratch.data(), rateScratch.data(), results);
 
-	// Loop over all the reacting pairs
-	for (auto it = effReactingList.begin(); it != effReactingList.end(); ++it) {
-		// Get the two reacting clusters
-		firstReactant = (*it).first;
-		secondReactant = (*it).second;
-		double l0A = firstReactant->getConcentration(0.0, 0.0);
-		double l0B = secondReactant->getConcentration(0.0, 0.0);
-		double lHeA = firstReactant->getHeMomentum();
-		double lHeB = secondReactant->getHeMomentum();
-		double lVA = firstReactant->getVMomentum();
-		double lVB = secondReactant->getVMomentum();
-		// Update the flux
-		value = (*it).kConstant;
-		flux += value
-				* ((*it).a000 * l0A * l0B + (*it).a010 * l0A * lHeB
-						+ (*it).a020 * l0A * lVB + (*it).a100 * lHeA * l0B
-						+ (*it).a110 * lHeA * lHeB + (*it).a120 * lHeA * lVB
-						+ (*it).a200 * lVA * l0B + (*it).a210 * lVA * lHeB
-						+ (*it).a220 * lVA * lVB);
-		// Compute the momentum fluxes
-		heMomentumFlux += value
-				* ((*it).a001 * l0A * l0B + (*it).a011 * l0A * lHeB
-						+ (*it).a021 * l0A * lVB + (*it).a101 * lHeA * l0B
-						+ (*it).a111 * lHeA * lHeB + (*it).a121 * lHeA * lVB
-						+ (*it).a201 * lVA * l0B + (*it).a211 * lVA * lHeB
-						+ (*it).a221 * lVA * lVB);
-		vMomentumFlux += value
-				* ((*it).a002 * l0A * l0B + (*it).a012 * l0A * lHeB
-						+ (*it).a022 * l0A * lVB + (*it).a102 * lHeA * l0B
-						+ (*it).a112 * lHeA * lHeB + (*it).a122 * lHeA * lVB
-						+ (*it).a202 * lVA * l0B + (*it).a212 * lVA * lHeB
-						+ (*it).a222 * lVA * lVB);
-	}
+	// Compute the momentum fluxes
+	heMomentumFlux += results[0][1];
+	vMomentumFlux += results[0][2];
 
 	// Return the production flux
-	return flux;
+	return results[0][0];
 }
 
 double PSISuperCluster::getCombinationFlux() {
-	// Local declarations
-	double flux = 0.0, value = 0.0;
-	PSICluster *combiningCluster = nullptr;
+	// The flux and momentum fluxes of each reaction type
+	alignas(32) double results[4][4] = { };
+	if (fillStateScratch())
+		computeReactionFluxes(concScratch.data(), rateScratch.data(), results);
 
-	// Loop over all the combining clusters
-	for (auto it = effCombiningList.begin(); it != effCombiningList.end();
-			++it) {
-		// Get the two reacting clusters
-		combiningCluster = (*it).first;
-		double l0B = combiningCluster->getConcentration(0.0, 0.0);
-		double lHeB = combiningCluster->getHeMomentum();
-		double lVB = combiningCluster->getVMomentum();
-		// Update the flux
-		value = (*it).kConstant;
-		flux += value
-				* ((*it).a000 * l0B * l0 + (*it).a100 * l0B * l1He
-						+ (*it).a200 * l0B * l1V + (*it).a010 * lHeB * l0
-						+ (*it).a110 * lHeB * l1He + (*it).a210 * lHeB * l1V
-						+ (*it).a020 * lVB * l0 + (*it).a120 * lVB * l1He
-						+ (*it).a220 * lVB * l1V);
-		// Compute the momentum fluxes
-		heMomentumFlux -= value
-				* ((*it).a001 * l0B * l0 + (*it).a101 * l0B * l1He
-						+ (*it).a201 * l0B * l1V + (*it).a011 * lHeB * l0
-						+ (*it).a111 * lHeB * l1He + (*it).a211 * lHeB * l1V
-						+ (*it).a021 * lVB * l0 + (*it).a121 * lVB * l1He
-						+ (*it).a221 * lVB * l1V);
-		vMomentumFlux -= value
-				* ((*it).a002 * l0B * l0 + (*it).a102 * l0B * l1He
-						+ (*it).a202 * l0B * l1V + (*it).a012 * lHeB * l0
-						+ (*it).a112 * lHeB * l1He + (*it).a212 * lHeB * l1V
-						+ (*it).a022 * lVB * l0 + (*it).a122 * lVB * l1He
-						+ (*it).a222 * lVB * l1V);
-	}
+	// Compute the momentum fluxes
+	heMomentumFlux -= results[1][1];
+	vMomentumFlux -= results[1][2];
 
-	return flux;
+	return results[1][0];
 }
 
 void PSISuperCluster::getPartialDerivatives(
@@ -1096,255 +1099,258 @@ void PSISuperCluster::getPartialDerivatives(
 	std::fill(heMomentumPartials.begin(), heMomentumPartials.end(), 0.0);
 	std::fill(vMomentumPartials.begin(), vMomentumPartials.end(), 0.0);
 
-	// Get the partial derivatives for each reaction type
-	getProductionPartialDerivatives(partials);
-	getCombinationPartialDerivatives(partials);
-	getDissociationPartialDerivatives(partials);
-	getEmissionPartialDerivatives(partials);
+	// Compute them from the current concentrations and rates
+	if (fillStateScratch())
+		computePartialDerivatives(concScratch.data(), rateScratch.data(),
+				partials.data(), heMomentumPartials.data(),
+				vMomentumPartials.data());
 
 	return;
 }
 
-void PSISuperCluster::getProductionPartialDerivatives(
+void PSISuperCluster::getHeMomentPartialDerivatives(
 		std::vector<double> & partials) const {
-	// Initial declarations
-	double value = 0.0;
-	int index = 0;
-	PSICluster *firstReactant = nullptr, *secondReactant = nullptr;
-
-	// Production
-	// A + B --> D, D being this cluster
-	// The flux for D is
-	// F(C_D) = k+_(A,B)*C_A*C_B
-	// Thus, the partial derivatives
-	// dF(C_D)/dC_A = k+_(A,B)*C_B
-	// dF(C_D)/dC_B = k+_(A,B)*C_A
+	// Loop on the size of the vector
+	for (int i = 0; i < partials.size(); i++) {
+		// Set to the values that were already computed
+		partials[i] = heMomentumPartials[i];
+	}
 
-	// Loop over all the reacting pairs
-	for (auto it = effReactingList.begin(); it != effReactingList.end(); ++it) {
-		// Get the two reacting clusters
-		firstReactant = (*it).first;
-		secondReactant = (*it).second;
-		double l0A = firstReactant->getConcentration(0.0, 0.0);
-		double l0B = secondReactant->getConcentration(0.0, 0.0);
-		double lHeA = firstReactant->getHeMomentum();
-		double lHeB = secondReactant->getHeMomentum();
-		double lVA = firstReactant->getVMomentum();
-		double lVB = secondReactant->getVMomentum();
+	return;
+}
 
-		// Compute the contribution from the first part of the reacting pair
-		value = (*it).kConstant;
-		index = firstReactant->getId() - 1;
-		partials[index] += value
-				* ((*it).a000 * l0B + (*it).a010 * lHeB + (*it).a020 * lVB);
-		heMomentumPartials[index] += value
-				* ((*it).a001 * l0B + (*it).a011 * lHeB + (*it).a021 * lVB);
-		vMomentumPartials[index] += value
-				* ((*it).a002 * l0B + (*it).a012 * lHeB + (*it).a022 * lVB);
-		index = firstReactant->getHeMomentumId() - 1;
-		partials[index] += value
-				* ((*it).a100 * l0B + (*it).a110 * lHeB + (*it).a120 * lVB);
-		heMomentumPartials[index] += value
-				* ((*it).a101 * l0B + (*it).a111 * lHeB + (*it).a121 * lVB);
-		vMomentumPartials[index] += value
-				* ((*it).a102 * l0B + (*it).a112 * lHeB + (*it).a122 * lVB);
-		index = firstReactant->getVMomentumId() - 1;
-		partials[index] += value
-				* ((*it).a200 * l0B + (*it).a210 * lHeB + (*it).a220 * lVB);
-		heMomentumPartials[index] += value
-				* ((*it).a201 * l0B + (*it).a211 * lHeB + (*it).a221 * lVB);
-		vMomentumPartials[index] += value
-				* ((*it).a202 * l0B + (*it).a212 * lHeB + (*it).a222 * lVB);
-		// Compute the contribution from the second part of the reacting pair
-		index = secondReactant->getId() - 1;
-		partials[index] += value
-				* ((*it).a000 * l0A + (*it).a100 * lHeA + (*it).a200 * lVA);
-		heMomentumPartials[index] += value
-				* ((*it).a001 * l0A + (*it).a101 * lHeA + (*it).a201 * lVA);
-		vMomentumPartials[index] += value
-				* ((*it).a002 * l0A + (*it).a102 * lHeA + (*it).a202 * lVA);
-		index = secondReactant->getHeMomentumId() - 1;
-		partials[index] += value
-				* ((*it).a010 * l0A + (*it).a110 * lHeA + (*it).a210 * lVA);
-		heMomentumPartials[index] += value
-				* ((*it).a011 * l0A + (*it).a111 * lHeA + (*it).a211 * lVA);
-		vMomentumPartials[index] += value
-				* ((*it).a012 * l0A + (*it).a112 * lHeA + (*it).a212 * lVA);
-		index = secondReactant->getVMomentumId() - 1;
-		partials[index] += value
-				* ((*it).a020 * l0A + (*it).a120 * lHeA + (*it).a220 * lVA);
-		heMomentumPartials[index] += value
-				* ((*it).a021 * l0A + (*it).a121 * lHeA + (*it).a221 * lVA);
-		vMomentumPartials[index] += value
-				* ((*it).a022 * l0A + (*it).a122 * lHeA + (*it).a222 * lVA);
+void PSISuperCluster::getVMomentPartialDerivatives(
+		std::vector<double> & partials) const {
+	// Loop on the size of the vector
+	for (int i = 0; i < partials.size(); i++) {
+		// Set to the values that were already computed
+		partials[i] = vMomentumPartials[i];
 	}
 
 	return;
 }
 
-void PSISuperCluster::getCombinationPartialDerivatives(
-		std::vector<double> & partials) const {
-	// Initial declarations
-	int index = 0;
-	PSICluster *cluster = nullptr;
-	double value = 0.0;
+void PSISuperCluster::computeReactionFluxes(const double * concs,
+		const double * rates, double (*results)[4]) const {
+	// Local declarations
+	double value = 0.0, firstValues[3] = { }, secondValues[3] = { },
+			thisValues[3] = { }, values[9] = { };
+	// The flux and momentum fluxes of each reaction type, the last element
+	// is padding
+	double * prodResult = results[0], *combResult = results[1], *dissResult =
+			results[2], *emissResult = results[3];
+	PSICluster *firstReactant = nullptr, *secondReactant = nullptr;
+	// The momentums of this cluster
+	const double l0This = concs[id - 1], l1HeThis = concs[heMomId - 1],
+			l1VThis = concs[vMomId - 1];
+	// The rate constants come after the temperature, diffusion coefficient
+	// and biggest rate, in the order of getRateSlots()
+	const double * k = rates + 3;
 
-	// Combination
-	// A + B --> D, A being this cluster
-	// The flux for A is outgoing
-	// F(C_A) = - k+_(A,B)*C_A*C_B
-	// Thus, the partial derivatives
-	// dF(C_A)/dC_A = - k+_(A,B)*C_B
-	// dF(C_A)/dC_B = - k+_(A,B)*C_A
+	// Production
+	for (auto it = effReactingList.begin(); it != effReactingList.end();
+			++it, ++k) {
+		// Get the two reacting clusters
+		firstReactant = (*it).first;
+		secondReactant = (*it).second;
+		value = *k;
+		firstValues[0] = value * firstReactant->getConcentrationFrom(concs);
+		firstValues[1] = value * firstReactant->getHeMomentumFrom(concs);
+		firstValues[2] = value * firstReactant->getVMomentumFrom(concs);
+		secondValues[0] = secondReactant->getConcentrationFrom(concs);
+		secondValues[1] = secondReactant->getHeMomentumFrom(concs);
+		secondValues[2] = secondReactant->getVMomentumFrom(concs);
+		// Build all the products of momentums
+		for (int i = 0; i < 3; i++) {
+			for (int j = 0; j < 3; j++) {
+				values[3 * i + j] = firstValues[i] * secondValues[j];
+			}
+		}
+		// Update the flux and the momentum fluxes
+		accumulateMomentums((*it).a, 1, values, 9, prodResult);
+	}
 
-	// Loop over all the combining clusters
+	// Combination
 	for (auto it = effCombiningList.begin(); it != effCombiningList.end();
-			++it) {
-		// Get the two reacting clusters
-		cluster = (*it).first;
-		double l0B = cluster->getConcentration(0.0, 0.0);
-		double lHeB = cluster->getHeMomentum();
-		double lVB = cluster->getVMomentum();
+			++it, ++k) {
+		// Get the combining cluster
+		firstReactant = (*it).first;
+		value = *k;
+		double l0B = firstReactant->getConcentrationFrom(concs);
+		double lHeB = firstReactant->getHeMomentumFrom(concs);
+		double lVB = firstReactant->getVMomentumFrom(concs);
+		thisValues[0] = value * l0This;
+		thisValues[1] = value * l1HeThis;
+		thisValues[2] = value * l1VThis;
+		// Build all the products of momentums, this cluster is the first one
+		for (int i = 0; i < 3; i++) {
+			values[3 * i] = thisValues[i] * l0B;
+			values[3 * i + 1] = thisValues[i] * lHeB;
+			values[3 * i + 2] = thisValues[i] * lVB;
+		}
+		// Update the flux and the momentum fluxes
+		accumulateMomentums((*it).a, 1, values, 9, combResult);
+	}
 
-		// Compute the contribution from the combining cluster
-		value = (*it).kConstant;
-		index = cluster->getId() - 1;
-		partials[index] -= value
-				* ((*it).a000 * l0 + (*it).a100 * l1He + (*it).a200 * l1V);
-		heMomentumPartials[index] -= value
-				* ((*it).a001 * l0 + (*it).a101 * l1He + (*it).a201 * l1V);
-		vMomentumPartials[index] -= value
-				* ((*it).a002 * l0 + (*it).a102 * l1He + (*it).a202 * l1V);
-		index = cluster->getHeMomentumId() - 1;
-		partials[index] -= value
-				* ((*it).a010 * l0 + (*it).a110 * l1He + (*it).a210 * l1V);
-		heMomentumPartials[index] -= value
-				* ((*it).a011 * l0 + (*it).a111 * l1He + (*it).a211 * l1V);
-		vMomentumPartials[index] -= value
-				* ((*it).a012 * l0 + (*it).a112 * l1He + (*it).a212 * l1V);
-		index = cluster->getVMomentumId() - 1;
-		partials[index] -= value
-				* ((*it).a020 * l0 + (*it).a120 * l1He + (*it).a220 * l1V);
-		heMomentumPartials[index] -= value
-				* ((*it).a021 * l0 + (*it).a121 * l1He + (*it).a221 * l1V);
-		vMomentumPartials[index] -= value
-				* ((*it).a022 * l0 + (*it).a122 * l1He + (*it).a222 * l1V);
-		// Compute the contribution from this cluster
-		index = id - 1;
-		partials[index] -= value
-				* ((*it).a000 * l0B + (*it).a010 * lHeB + (*it).a020 * lVB);
-		heMomentumPartials[index] -= value
-				* ((*it).a001 * l0B + (*it).a011 * lHeB + (*it).a021 * lVB);
-		vMomentumPartials[index] -= value
-				* ((*it).a002 * l0B + (*it).a012 * lHeB + (*it).a022 * lVB);
-		index = heMomId - 1;
-		partials[index] -= value
-				* ((*it).a100 * l0B + (*it).a110 * lHeB + (*it).a120 * lVB);
-		heMomentumPartials[index] -= value
-				* ((*it).a101 * l0B + (*it).a111 * lHeB + (*it).a121 * lVB);
-		vMomentumPartials[index] -= value
-				* ((*it).a102 * l0B + (*it).a112 * lHeB + (*it).a122 * lVB);
-		index = vMomId - 1;
-		partials[index] -= value
-				* ((*it).a200 * l0B + (*it).a210 * lHeB + (*it).a220 * lVB);
-		heMomentumPartials[index] -= value
-				* ((*it).a201 * l0B + (*it).a211 * lHeB + (*it).a221 * lVB);
-		vMomentumPartials[index] -= value
-				* ((*it).a202 * l0B + (*it).a212 * lHeB + (*it).a222 * lVB);
+	// Dissociation
+	for (auto it = effDissociatingList.begin(); it != effDissociatingList.end();
+			++it, ++k) {
+		// Get the dissociating cluster
+		firstReactant = (*it).first;
+		value = *k;
+		values[0] = value * firstReactant->getConcentrationFrom(concs);
+		values[1] = value * firstReactant->getHeMomentumFrom(concs);
+		values[2] = value * firstReactant->getVMomentumFrom(concs);
+		// Update the flux and the momentum fluxes
+		accumulateMomentums((*it).a, 1, values, 3, dissResult);
+	}
+
+	// Emission
+	for (auto it = effEmissionList.begin(); it != effEmissionList.end();
+			++it, ++k) {
+		value = *k;
+		values[0] = value * l0This;
+		values[1] = value * l1HeThis;
+		values[2] = value * l1VThis;
+		// Update the flux and the momentum fluxes
+		accumulateMomentums((*it).a, 1, values, 3, emissResult);
 	}
 
 	return;
 }
 
-void PSISuperCluster::getDissociationPartialDerivatives(
-		std::vector<double> & partials) const {
-	// Initial declarations
-	int index = 0;
-	PSICluster *cluster = nullptr;
-	double value = 0.0;
+void PSISuperCluster::computeFluxes(const double * concs,
+		const double * rates, double * fluxes) const {
+	// The flux and momentum fluxes of each reaction type, the last element
+	// is padding
+	alignas(32) double results[4][4] = { };
+	computeReactionFluxes(concs, rates, results);
 
-	// Dissociation
-	// A --> B + D, B being this cluster
-	// The flux for B is
-	// F(C_B) = k-_(B,D)*C_A
-	// Thus, the partial derivatives
-	// dF(C_B)/dC_A = k-_(B,D)
-
-	// Loop over all the dissociating pairs
-	for (auto it = effDissociatingList.begin(); it != effDissociatingList.end();
-			++it) {
-		// Get the dissociating clusters
-		cluster = (*it).first;
-		// Compute the contribution from the dissociating cluster
-		value = (*it).kConstant;
-		index = cluster->getId() - 1;
-		partials[index] += value * ((*it).a00);
-		heMomentumPartials[index] += value * ((*it).a01);
-		vMomentumPartials[index] += value * ((*it).a02);
-		index = cluster->getHeMomentumId() - 1;
-		partials[index] += value * ((*it).a10);
-		heMomentumPartials[index] += value * ((*it).a11);
-		vMomentumPartials[index] += value * ((*it).a12);
-		index = cluster->getVMomentumId() - 1;
-		partials[index] += value * ((*it).a20);
-		heMomentumPartials[index] += value * ((*it).a21);
-		vMomentumPartials[index] += value * ((*it).a22);
-	}
+	// Gather everything, the reaction types are production, combination,
+	// dissociation and emission
+	fluxes[0] = results[0][0] - results[1][0] + results[2][0] - results[3][0];
+	fluxes[1] = results[0][1] + results[2][1] - results[1][1] - results[3][1];
+	fluxes[2] = results[0][2] + results[2][2] - results[1][2] - results[3][2];
 
 	return;
 }
 
-void PSISuperCluster::getEmissionPartialDerivatives(
-		std::vector<double> & partials) const {
+void PSISuperCluster::computePartialDerivatives(const double * concs,
+		const double * rates, double * partials, double * hePartials,
+		double * vPartials) const {
 	// Initial declarations
-	int index = 0;
-	double value = 0.0;
+	double value = 0.0, firstValues[3] = { }, secondValues[3] = { };
+	int index[3] = { };
+	PSICluster *firstReactant = nullptr, *secondReactant = nullptr;
+	// The momentums of this cluster
+	const double l0This = concs[id - 1], l1HeThis = concs[heMomId - 1],
+			l1VThis = concs[vMomId - 1];
+	const int thisIndex[3] = { id - 1, heMomId - 1, vMomId - 1 };
+	// The rate constants come after the temperature, diffusion coefficient
+	// and biggest rate, in the order of getRateSlots()
+	const double * k = rates + 3;
 
-	// Emission
-	// A --> B + D, A being this cluster
-	// The flux for A is
-	// F(C_A) = - k-_(B,D)*C_A
-	// Thus, the partial derivatives
-	// dF(C_A)/dC_A = - k-_(B,D)
+	// Production
+	// A + B --> D, D being this cluster
+	for (auto it = effReactingList.begin(); it != effReactingList.end();
+			++it, ++k) {
+		// Get the two reacting clusters
+		firstReactant = (*it).first;
+		secondReactant = (*it).second;
+		value = *k;
+		firstValues[0] = value * firstReactant->getConcentrationFrom(concs);
+		firstValues[1] = value * firstReactant->getHeMomentumFrom(concs);
+		firstValues[2] = value * firstReactant->getVMomentumFrom(concs);
+		secondValues[0] = value * secondReactant->getConcentrationFrom(concs);
+		secondValues[1] = value * secondReactant->getHeMomentumFrom(concs);
+		secondValues[2] = value * secondReactant->getVMomentumFrom(concs);
 
-	// Loop over all the emission pairs
-	for (auto it = effEmissionList.begin(); it != effEmissionList.end(); ++it) {
-		// Compute the contribution from the dissociating cluster
-		value = (*it).kConstant;
-		index = id - 1;
-		partials[index] -= value * ((*it).a00);
-		heMomentumPartials[index] -= value * ((*it).a01);
-		vMomentumPartials[index] -= value * ((*it).a02);
-		index = heMomId - 1;
-		partials[index] -= value * ((*it).a10);
-		heMomentumPartials[index] -= value * ((*it).a11);
-		vMomentumPartials[index] -= value * ((*it).a12);
-		index = vMomId - 1;
-		partials[index] -= value * ((*it).a20);
-		heMomentumPartials[index] -= value * ((*it).a21);
-		vMomentumPartials[index] -= value * ((*it).a22);
+		// Compute the contribution from the first part of the reacting pair
+		index[0] = firstReactant->getId() - 1;
+		index[1] = firstReactant->getHeMomentumId() - 1;
+		index[2] = firstReactant->getVMomentumId() - 1;
+		for (int i = 0; i < 3; i++) {
+			alignas(32) double result[4] = { };
+			accumulateMomentums((*it).a + 3 * i, 1, secondValues, 3, result);
+			partials[index[i]] += result[0];
+			hePartials[index[i]] += result[1];
+			vPartials[index[i]] += result[2];
+		}
+		// Compute the contribution from the second part of the reacting pair
+		index[0] = secondReactant->getId() - 1;
+		index[1] = secondReactant->getHeMomentumId() - 1;
+		index[2] = secondReactant->getVMomentumId() - 1;
+		for (int j = 0; j < 3; j++) {
+			alignas(32) double result[4] = { };
+			accumulateMomentums((*it).a + j, 3, firstValues, 3, result);
+			partials[index[j]] += result[0];
+			hePartials[index[j]] += result[1];
+			vPartials[index[j]] += result[2];
+		}
 	}
 
-	return;
-}
+	// Combination
+	// A + B --> D, A being this cluster
+	for (auto it = effCombiningList.begin(); it != effCombiningList.end();
+			++it, ++k) {
+		// Get the combining cluster
+		firstReactant = (*it).first;
+		value = *k;
+		secondValues[0] = value * firstReactant->getConcentrationFrom(concs);
+		secondValues[1] = value * firstReactant->getHeMomentumFrom(concs);
+		secondValues[2] = value * firstReactant->getVMomentumFrom(concs);
+		firstValues[0] = value * l0This;
+		firstValues[1] = value * l1HeThis;
+		firstValues[2] = value * l1VThis;
 
-void PSISuperCluster::getHeMomentPartialDerivatives(
-		std::vector<double> & partials) const {
-	// Loop on the size of the vector
-	for (int i = 0; i < partials.size(); i++) {
-		// Set to the values that were already computed
-		partials[i] = heMomentumPartials[i];
+		// Compute the contribution from the combining cluster
+		index[0] = firstReactant->getId() - 1;
+		index[1] = firstReactant->getHeMomentumId() - 1;
+		index[2] = firstReactant->getVMomentumId() - 1;
+		for (int j = 0; j < 3; j++) {
+			alignas(32) double result[4] = { };
+			accumulateMomentums((*it).a + j, 3, firstValues, 3, result);
+			partials[index[j]] -= result[0];
+			hePartials[index[j]] -= result[1];
+			vPartials[index[j]] -= result[2];
+		}
+		// Compute the contribution from this cluster
+		for (int i = 0; i < 3; i++) {
+			alignas(32) double result[4] = { };
+			accumulateMomentums((*it).a + 3 * i, 1, secondValues, 3, result);
+			partials[thisIndex[i]] -= result[0];
+			hePartials[thisIndex[i]] -= result[1];
+			vPartials[thisIndex[i]] -= result[2];
+		}
 	}
 
-	return;
-}
+	// Dissociation
+	// A --> B + D, B being this cluster
+	for (auto it = effDissociatingList.begin(); it != effDissociatingList.end();
+			++it, ++k) {
+		// Get the dissociating cluster
+		firstReactant = (*it).first;
+		value = *k;
+		index[0] = firstReactant->getId() - 1;
+		index[1] = firstReactant->getHeMomentumId() - 1;
+		index[2] = firstReactant->getVMomentumId() - 1;
+		for (int i = 0; i < 3; i++) {
+			partials[index[i]] += value * (*it).a[i][0];
+			hePartials[index[i]] += value * (*it).a[i][1];
+			vPartials[index[i]] += value * (*it).a[i][2];
+		}
+	}
 
-void PSISuperCluster::getVMomentPartialDerivatives(
-		std::vector<double> & partials) const {
-	// Loop on the size of the vector
-	for (int i = 0; i < partials.size(); i++) {
-		// Set to the values that were already computed
-		partials[i] = vMomentumPartials[i];
+	// Emission
+	// A --> B + D, A being this cluster
+	for (auto it = effEmissionList.begin(); it != effEmissionList.end();
+			++it, ++k) {
+		value = *k;
+		for (int i = 0; i < 3; i++) {
+			partials[thisIndex[i]] -= value * (*it).a[i][0];
+			hePartials[thisIndex[i]] -= value * (*it).a[i][1];
+			vPartials[thisIndex[i]] -= value * (*it).a[i][2];
+		}
 	}
 
 	return;
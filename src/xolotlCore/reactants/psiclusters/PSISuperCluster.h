@@ -3,8 +3,10 @@
 
 // Includes
 #include "PSICluster.h"
+#include <AlignedAllocator.h>
 #include <string>
-#include <forward_list>
+#include <vector>
+#include <algorithm>
 
 namespace xolotlCore {
 /**
@@ -12,6 +14,9 @@ namespace xolotlCore {
  */
 class PSISuperCluster: public PSICluster {
 
+	//! The network cache reads and writes the optimized reactions directly
+	friend class PSIClusterNetworkCache;
+
 protected:
 
 	/**
@@ -42,54 +47,25 @@ protected:
 		double kConstant;
 
 		/**
-		 * All the coefficient needed to compute each element
-		 * The first number represent the momentum of A, the second of B
+		 * All the coefficient needed to compute each element, stored
+		 * contiguously so that they can be read with vector instructions.
+		 * a[3 * i + j][m]: i represents the momentum of A, j the one of B
 		 * in A + B -> C
 		 *
-		 * The third number represent which momentum we are computing.
+		 * m represents which momentum we are computing, the fourth column
+		 * is only padding.
 		 *
 		 * 0 -> l0
 		 * 1 -> He
 		 * 2 -> V
 		 */
-		double a000;
-		double a001;
-		double a002;
-		double a100;
-		double a101;
-		double a102;
-		double a200;
-		double a201;
-		double a202;
-		double a010;
-		double a011;
-		double a012;
-		double a020;
-		double a021;
-		double a022;
-		double a110;
-		double a111;
-		double a112;
-		double a120;
-		double a121;
-		double a122;
-		double a210;
-		double a211;
-		double a212;
-		double a220;
-		double a221;
-		double a222;
+		alignas(32) double a[9][4];
 
 		//! The constructor
 		SuperClusterProductionPair(PSICluster * firstPtr,
 				PSICluster * secondPtr, double k) :
-				first(firstPtr), second(secondPtr), kConstant(k), a000(0.0), a001(
-						0.0), a002(0.0), a100(0.0), a101(0.0), a102(0.0), a200(
-						0.0), a201(0.0), a202(0.0), a010(0.0), a011(0.0), a012(
-						0.0), a020(0.0), a021(0.0), a022(0.0), a110(0.0), a111(
-						0.0), a112(0.0), a120(0.0), a121(0.0), a122(0.0), a210(
-						0.0), a211(0.0), a212(0.0), a220(0.0), a221(0.0), a222(
-						0.0) {
+				first(firstPtr), second(secondPtr), kConstant(k) {
+			std::fill(&a[0][0], &a[0][0] + 9 * 4, 0.0);
 		}
 	};
 
@@ -121,35 +97,41 @@ protected:
 		double kConstant;
 
 		/**
-		 * All the coefficient needed to compute each element
-		 * The first number represent the momentum of A
-		 * in A -> B + C
+		 * All the coefficient needed to compute each element, stored
+		 * contiguously so that they can be read with vector instructions.
+		 * a[i][m]: i represents the momentum of A in A -> B + C
 		 *
-		 * The second number represent which momentum we are computing.
+		 * m represents which momentum we are computing, the fourth column
+		 * is only padding.
 		 *
 		 * 0 -> l0
 		 * 1 -> He
 		 * 2 -> V
 		 */
-		double a00;
-		double a01;
-		double a02;
-		double a10;
-		double a11;
-		double a12;
-		double a20;
-		double a21;
-		double a22;
+		alignas(32) double a[3][4];
 
 		//! The constructor
 		SuperClusterDissociationPair(PSICluster * firstPtr,
 				PSICluster * secondPtr, double k) :
-				first(firstPtr), second(secondPtr), kConstant(k), a00(0.0), a01(
-						0.0), a02(0.0), a10(0.0), a11(0.0), a12(0.0), a20(0.0), a21(
-						0.0), a22(0.0) {
+				first(firstPtr), second(secondPtr), kConstant(k) {
+			std::fill(&a[0][0], &a[0][0] + 3 * 4, 0.0);
 		}
 	};
 
+	/**
+	 * The contiguous and aligned vector type used to store the optimized
+	 * production pairs.
+	 */
+	typedef std::vector<SuperClusterProductionPair,
+			AlignedAllocator<SuperClusterProductionPair, 64> > ProductionPairVector;
+
+	/**
+	 * The contiguous and aligned vector type used to store the optimized
+	 * dissociation pairs.
+	 */
+	typedef std::vector<SuperClusterDissociationPair,
+			AlignedAllocator<SuperClusterDissociationPair, 64> > DissociationPairVector;
+
 private:
 
 	//! The mean number of helium atoms in this cluster.
@@ -206,17 +188,23 @@ private:
 	//! The map containing all the effective emission pairs separated by original composition.
 	std::map<std::pair<int, int>, std::vector<ClusterPair *> > effEmissionMap;
 
-	//! The list of optimized effective reacting pairs.
-	std::forward_list<SuperClusterProductionPair> effReactingList;
+	//! The vector of optimized effective reacting pairs.
+	ProductionPairVector effReactingList;
 
-	//! The list of optimized effective combining pairs.
-	std::forward_list<SuperClusterProductionPair> effCombiningList;
+	//! The vector of optimized effective combining pairs.
+	ProductionPairVector effCombiningList;
 
-	//! The list of optimized effective dissociating pairs.
-	std::forward_list<SuperClusterDissociationPair> effDissociatingList;
+	//! The vector of optimized effective dissociating pairs.
+	DissociationPairVector effDissociatingList;
 
-	//! The list of optimized effective emission pairs.
-	std::forward_list<SuperClusterDissociationPair> effEmissionList;
+	//! The vector of optimized effective emission pairs.
+	DissociationPairVector effEmissionList;
+
+	/**
+	 * The temperature at which the optimized reactions read from the network
+	 * cache were compiled, negative if they were not read from a cache.
+	 */
+	double cachedTemperature;
 
 	/**
 	 * The helium momentum flux.
@@ -241,6 +229,20 @@ private:
 	 */
 	void optimizeReactions();
 
+	/**
+	 * Compute the flux and the momentum fluxes of each reaction type from the
+	 * given concentrations and rates.
+	 *
+	 * @param concs The concentrations of the grid point, indexed by id - 1
+	 * @param rates The values of this cluster in the rate table, in the
+	 * order of getRateSlots()
+	 * @param results The flux and the helium and vacancy momentum fluxes of
+	 * the production, combination, dissociation and emission, each one
+	 * padded to 4 elements
+	 */
+	void computeReactionFluxes(const double * concs, const double * rates,
+			double (*results)[4]) const;
+
 public:
 
 	//! The vector of HeV clusters it will replace
@@ -391,6 +393,23 @@ public:
 	 */
 	void updateRateConstants();
 
+	/**
+	 * Add the addresses of the temperature dependent values of this cluster,
+	 * including all the rate constants updated by updateRateConstants(), to
+	 * the given vector.
+	 *
+	 * @param slots The vector of addresses
+	 */
+	void getRateSlots(std::vector<double *> & slots);
+
+	/**
+	 * Describe the rate constants updated by updateRateConstants() to the
+	 * rate kernel, in the order of getRateSlots().
+	 *
+	 * @param kernel The rate kernel
+	 */
+	void getRateTerms(PSIRateKernel & kernel) const;
+
 	/**
 	 * This operation sets the zeroth order momentum.
 	 *
@@ -484,60 +503,72 @@ public:
 	double getVMomentumFlux() {return vMomentumFlux;}
 
 	/**
-	 * This operation works as getPartialDerivatives above, but instead of
-	 * returning a vector that it creates it fills a vector that is passed to
-	 * it by the caller. This allows the caller to optimize the amount of
-	 * memory allocations to just one if they are accessing the partial
-	 * derivatives many times.
-	 *
-	 * @param the vector that should be filled with the partial derivatives
-	 * for this reactant where index zero corresponds to the first reactant in
-	 * the list returned by the ReactionNetwork::getAll() operation. The size of
-	 * the vector should be equal to ReactionNetwork::size().
+	 * This operation returns the concentration of the cluster at the given
+	 * distances in the group, read from the concentration array of a grid
+	 * point.
 	 *
+	 * @param concs The concentrations, indexed by id - 1
+	 * @param distHe The helium distance in the group
+	 * @param distV The vacancy distance in the group
+	 * @return The concentration
 	 */
-	void getPartialDerivatives(std::vector<double> & partials) const;
+	double getConcentrationFrom(const double * concs, double distHe = 0.0,
+			double distV = 0.0) const {
+		return concs[id - 1] + (distHe * concs[heMomId - 1])
+				+ (distV * concs[vMomId - 1]);
+	}
 
 	/**
-	 * This operation computes the partial derivatives due to production
-	 * reactions.
+	 * This operation returns the first helium momentum read from the
+	 * concentration array of a grid point.
 	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
+	 * @param concs The concentrations, indexed by id - 1
+	 * @return The momentum
 	 */
-	void getProductionPartialDerivatives(std::vector<double> & partials) const;
+	double getHeMomentumFrom(const double * concs) const {
+		return concs[heMomId - 1];
+	}
 
 	/**
-	 * This operation computes the partial derivatives due to combination
-	 * reactions.
+	 * This operation returns the first vacancy momentum read from the
+	 * concentration array of a grid point.
 	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
+	 * @param concs The concentrations, indexed by id - 1
+	 * @return The momentum
 	 */
-	void getCombinationPartialDerivatives(std::vector<double> & partials) const;
+	double getVMomentumFrom(const double * concs) const {
+		return concs[vMomId - 1];
+	}
 
 	/**
-	 * This operation computes the partial derivatives due to dissociation of
-	 * other clusters into this one.
+	 * This operation computes the total flux of this cluster and the fluxes
+	 * of its momentums like getTotalFlux(), but only from the given
+	 * concentrations and rates so that it can be called by several threads
+	 * at the same time.
 	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
+	 * @param concs The concentrations of the grid point, indexed by id - 1
+	 * @param rates The values of this cluster in the rate table, in the
+	 * order of getRateSlots()
+	 * @param fluxes The array where the flux, the helium momentum flux and
+	 * the vacancy momentum flux are written
 	 */
-	void getDissociationPartialDerivatives(
-			std::vector<double> & partials) const;
+	void computeFluxes(const double * concs, const double * rates,
+			double * fluxes) const;
 
 	/**
-	 * This operation computes the partial derivatives due to emission
-	 * reactions.
+	 * This operation works as getPartialDerivatives above, but instead of
+	 * returning a vector that it creates it fills a vector that is passed to
+	 * it by the caller. This allows the caller to optimize the amount of
+	 * memory allocations to just one if they are accessing the partial
+	 * derivatives many times.
+	 *
+	 * @param the vector that should be filled with the partial derivatives
+	 * for this reactant where index zero corresponds to the first reactant in
+	 * the list returned by the ReactionNetwork::getAll() operation. The size of
+	 * the vector should be equal to ReactionNetwork::size().
 	 *
-	 * @param partials The vector into which the partial derivatives should be
-	 * inserted. This vector should have a length equal to the size of the
-	 * network.
 	 */
-	void getEmissionPartialDerivatives(std::vector<double> & partials) const;
+	void getPartialDerivatives(std::vector<double> & partials) const;
 
 	/**
 	 * This operation computes the partial derivatives for the helium momentum.
@@ -555,6 +586,23 @@ public:
 	 */
 	void getVMomentPartialDerivatives(std::vector<double> & partials) const;
 
+	/**
+	 * This operation computes the partial derivatives of this cluster and
+	 * of its momentums like getPartialDerivatives(), but only from the given
+	 * concentrations and rates so that it can be called by several threads
+	 * at the same time.
+	 *
+	 * @param concs The concentrations of the grid point, indexed by id - 1
+	 * @param rates The values of this cluster in the rate table, in the
+	 * order of getRateSlots()
+	 * @param partials The dense array where the partial derivatives of the
+	 * cluster are added, its size is the number of degrees of freedom
+	 * @param hePartials The same for the helium momentum
+	 * @param vPartials The same for the vacancy momentum
+	 */
+	void computePartialDerivatives(const double * concs, const double * rates,
+			double * partials, double * hePartials, double * vPartials) const;
+
 	/**
 	 * Returns the average number of vacancies.
 	 *
@@ -581,6 +629,26 @@ public:
 		return boundaries;
 	}
 
+	/**
+	 * Returns the optimized effective reacting pairs, with their momentum
+	 * coefficients.
+	 *
+	 * @return The vector of pairs
+	 */
+	const ProductionPairVector & getEffReactingList() const {
+		return effReactingList;
+	}
+
+	/**
+	 * Returns the optimized effective dissociating pairs, with their momentum
+	 * coefficients.
+	 *
+	 * @return The vector of pairs
+	 */
+	const DissociationPairVector & getEffDissociatingList() const {
+		return effDissociatingList;
+	}
+
 };
 //end class PSISuperCluster
 
@@ -19,7 +19,7 @@ VCluster::VCluster(int nV,
 	typeName = vType;
 
 	// Update the composition map
-	compositionMap[vType] = size;
+	composition[PSISpecies::V] = size;
 
 	// Compute the reaction radius
 	// It is the same formula for HeV clusters
@@ -97,7 +97,7 @@ void VCluster::createReactionConnectivity() {
 	// Get all the HeI clusters from the network
 	reactants = network->getAll(heIType);
 	// replaceInCompound handles this reaction
-	replaceInCompound(reactants, iType);
+	replaceInCompound(reactants, PSISpecies::I);
 
 	return;
 }
@@ -136,17 +136,17 @@ void VCluster::createDissociationConnectivity() {
 			auto comp = cluster->getComposition();
 
 			// Skip He_1V_1 because it was counted in the He dissociation
-			if (comp[heType] == 1 && comp[vType] == 1)
+			if (comp[PSISpecies::He] == 1 && comp[PSISpecies::V] == 1)
 				continue;
 
-			std::vector<int> compositionVec = { comp[heType], comp[vType]
+			std::vector<int> compositionVec = { comp[PSISpecies::He], comp[PSISpecies::V]
 					- size, 0 };
 			auto smallerReactant = (PSICluster *) network->getCompound(heVType,
 					compositionVec);
 			// Special case for numV = 1
-			if (comp[vType] == 1) {
+			if (comp[PSISpecies::V] == 1) {
 				smallerReactant = (PSICluster *) network->get(heType,
-						comp[heType]);
+						comp[PSISpecies::He]);
 			}
 			dissociateCluster(cluster, smallerReactant);
 		}
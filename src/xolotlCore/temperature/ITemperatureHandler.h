@@ -35,6 +35,14 @@ public:
 	 */
 	virtual double getTemperature(const std::vector<double>& position, double currentTime) const = 0;
 
+	/**
+	 * This operation returns the times at which the temperature is not
+	 * smooth, the time stepping should land on them.
+	 *
+	 * @return The times, in increasing order
+	 */
+	virtual std::vector<double> getBreakpoints() const = 0;
+
 }; //end class ITemperatureHandler
 
 }
@@ -62,6 +62,15 @@ public:
 	virtual double getTemperature(const std::vector<double>& position,
 			double) const {return surfaceTemperature - position[0] * gradient;}
 
+	/**
+	 * The temperature is constant with time.
+	 *
+	 * @return An empty vector
+	 */
+	virtual std::vector<double> getBreakpoints() const {
+		return std::vector<double>();
+	}
+
 }; //end class TemperatureGradientHandler
 
 }
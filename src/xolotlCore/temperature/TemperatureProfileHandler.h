@@ -2,9 +2,8 @@
 #define TEMPERATUREPROFILEHANDLER_H
 
 #include "ITemperatureHandler.h"
+#include <TimeProfile.h>
 #include <string>
-#include <iostream>
-#include <fstream>
 
 namespace xolotlCore{
 
@@ -29,16 +28,10 @@ private:
 		tempFile("") {}
 
 	/**
-	 * Vector to hold the time read from the input
-	 * temperature file.
+	 * The temperature read from the input temperature file as a function
+	 * of time.
 	 */
-	std::vector<double> time;
-
-	/**
-	 * Vector to hold the temperature read from the input
-	 * temperature file.
-	 */
-	std::vector<double> temp;
+	TimeProfile tempProfile;
 
 public:
 
@@ -60,19 +53,8 @@ public:
 	 * temperature file that was specified by the command line
 	 */
 	virtual void initializeTemperature() {
-		// Open file dataFile.dat containing the time and temperature
-		std::ifstream inputFile(tempFile.c_str());
-		std::string line;
-
-		// Read the file and store the values in the two vectors
-		while (getline(inputFile, line)) {
-			if (!line.length() || line[0] == '#')
-				continue;
-			double xtemp = 0.0, ytemp = 0.0;
-			sscanf(line.c_str(), "%lf %lf", &xtemp, &ytemp);
-			time.push_back(xtemp);
-			temp.push_back(ytemp);
-		}
+		// Read the time and temperature from the file
+		tempProfile.readFile(tempFile);
 
 		return;
 	}
@@ -80,39 +62,24 @@ public:
 	/**
 	 * This operation linearly interpolates the data read from the input
 	 * temperature file and returns the temperature at the given position
-	 * and time.
+	 * and time. The table is only searched when the time changes.
 	 *
 	 * @param position The position
 	 * @param currentTime The time
 	 * @return The temperature
 	 */
 	virtual double getTemperature(const std::vector<double>& position, double currentTime) const {
-		// Initialize the value to return
-		double f = 0.0;
-
-		// If the time is smaller than or equal than the first stored time
-		if (currentTime <= time[0])
-			return f = temp[0];
-
-		// If the time is larger or equal to the last stored time
-		if (currentTime >= time[time.size() - 1])
-			return f = temp[time.size() - 1];
-
-		// Else loop to determine the interval the time falls in
-		// i.e. time[k] < time < time[k + 1]
-		for (unsigned int k = 0; k < time.size() - 1; k++) {
-			if (currentTime < time[k]) continue;
-			if (currentTime > time[k + 1]) continue;
-
-			// Compute the amplitude following a linear interpolation between
-			// the two stored values
-			f = temp[k]
-					+ (temp[k + 1] - temp[k]) * (currentTime - time[k])
-							/ (time[k + 1] - time[k]);
-			break;
-		}
-
-		return f;
+		return tempProfile.getValue(currentTime);
+	}
+
+	/**
+	 * This operation returns the times of the input temperature file, the
+	 * temperature is linear between them.
+	 *
+	 * @return The times
+	 */
+	virtual std::vector<double> getBreakpoints() const {
+		return tempProfile.getTimes();
 	}
 
 }; //end class TemperatureProfileHandler
@@ -54,6 +54,8 @@ public:
 		tempNetworkLoader->setVMin(options.getGroupingMin());
 		tempNetworkLoader->setHeWidth(options.getGroupingWidthA());
 		tempNetworkLoader->setVWidth(options.getGroupingWidthB());
+		// Give the name of the file caching the reaction tables
+		tempNetworkLoader->setCacheFilename(options.getNetworkCacheFilename());
 		theNetworkLoaderHandler = tempNetworkLoader;
 
 		// Check if we want dummy reactions
@@ -0,0 +1,298 @@
+// Includes
+#include "BlockPreconditioner.h"
+#include "PetscSolver.h"
+#include <algorithm>
+#include <string>
+
+using namespace xolotlSolver;
+
+namespace {
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "blockPreconditionerSetUp")
+/**
+ * The setup function of the PCSHELL.
+ */
+PetscErrorCode blockPreconditionerSetUp(PC pc) {
+	PetscErrorCode ierr;
+	void *ctx;
+	Mat A, P;
+
+	PetscFunctionBeginUser;
+	ierr = PCShellGetContext(pc, &ctx);
+	CHKERRQ(ierr);
+	ierr = PCGetOperators(pc, &A, &P);
+	CHKERRQ(ierr);
+	ierr = ((BlockPreconditioner *) ctx)->setUp(P);
+	CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "blockPreconditionerApply")
+/**
+ * The apply function of the PCSHELL.
+ */
+PetscErrorCode blockPreconditionerApply(PC pc, Vec x, Vec y) {
+	PetscErrorCode ierr;
+	void *ctx;
+	Mat A, P;
+
+	PetscFunctionBeginUser;
+	ierr = PCShellGetContext(pc, &ctx);
+	CHKERRQ(ierr);
+	ierr = PCGetOperators(pc, &A, &P);
+	CHKERRQ(ierr);
+	ierr = ((BlockPreconditioner *) ctx)->apply(P, x, y);
+	CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+
+} /* end namespace */
+
+BlockPreconditioner::BlockPreconditioner(DM da, int levels, bool lineSolve) :
+		da(da), dof(0), xs(0), ys(0), zs(0), xm(0), ym(0), zm(0), levels(
+				levels), lineSolve(lineSolve), patternSet(false), residual(
+		NULL), nSetUps(0), nApplications(0) {
+	PetscErrorCode ierr;
+
+	// Get the number of degrees of freedom and the locally owned part of
+	// the grid
+	ierr = DMDAGetInfo(da, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &dof,
+			NULL, NULL, NULL, NULL, NULL);
+	checkPetscError(ierr, "BlockPreconditioner: DMDAGetInfo failed.");
+	ierr = DMDAGetCorners(da, &xs, &ys, &zs, &xm, &ym, &zm);
+	checkPetscError(ierr, "BlockPreconditioner: DMDAGetCorners failed.");
+}
+
+BlockPreconditioner::~BlockPreconditioner() {
+	if (residual)
+		VecDestroy(&residual);
+}
+
+void BlockPreconditioner::attach(PC pc) {
+	PetscErrorCode ierr;
+
+	ierr = PCSetType(pc, PCSHELL);
+	checkPetscError(ierr, "BlockPreconditioner::attach: PCSetType failed.");
+	ierr = PCShellSetContext(pc, this);
+	checkPetscError(ierr,
+			"BlockPreconditioner::attach: PCShellSetContext failed.");
+	ierr = PCShellSetSetUp(pc, blockPreconditionerSetUp);
+	checkPetscError(ierr,
+			"BlockPreconditioner::attach: PCShellSetSetUp failed.");
+	ierr = PCShellSetApply(pc, blockPreconditionerApply);
+	checkPetscError(ierr,
+			"BlockPreconditioner::attach: PCShellSetApply failed.");
+	ierr = PCShellSetName(pc, "Xolotl block preconditioner");
+	checkPetscError(ierr,
+			"BlockPreconditioner::attach: PCShellSetName failed.");
+
+	return;
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "BlockPreconditioner::readPattern")
+PetscErrorCode BlockPreconditioner::readPattern(Mat A) {
+	PetscErrorCode ierr;
+	PetscInt rowStart, nCols;
+	const PetscInt *cols;
+	const PetscScalar *vals;
+
+	PetscFunctionBeginUser;
+	ierr = MatGetOwnershipRange(A, &rowStart, NULL);
+	CHKERRQ(ierr);
+
+	// The columns of the reaction block of each row, gathered on all the
+	// grid points
+	std::vector<std::vector<int> > columns(dof);
+	std::vector<bool> mobile(dof, false);
+	const PetscInt nPoints = xm * ym * zm;
+	for (PetscInt p = 0; p < nPoints; p++) {
+		const PetscInt xi = xs + p % xm;
+		const PetscInt base = rowStart + p * dof;
+		for (PetscInt c = 0; c < dof; c++) {
+			const PetscInt row = base + c;
+			ierr = MatGetRow(A, row, &nCols, &cols, &vals);
+			CHKERRQ(ierr);
+			for (PetscInt n = 0; n < nCols; n++) {
+				if (cols[n] >= base && cols[n] < base + dof)
+					columns[c].push_back(cols[n] - base);
+				// Coupled to the same degree of freedom in x
+				else if ((cols[n] == row - dof && xi > xs)
+						|| (cols[n] == row + dof && xi < xs + xm - 1))
+					mobile[c] = true;
+			}
+			ierr = MatRestoreRow(A, row, &nCols, &cols, &vals);
+			CHKERRQ(ierr);
+		}
+	}
+
+	// Compute the pattern of the factors
+	for (PetscInt c = 0; c < dof; c++) {
+		std::sort(columns[c].begin(), columns[c].end());
+		columns[c].erase(std::unique(columns[c].begin(), columns[c].end()),
+				columns[c].end());
+	}
+	try {
+		factorization.setPattern(dof, columns, levels);
+	} catch (const std::string & error) {
+		SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "%s", error.c_str());
+	}
+	factorization.setNumberOfBlocks(nPoints);
+
+	// List the mobile species
+	mobileIds.clear();
+	mobilePositions.assign(dof, -1);
+	if (lineSolve) {
+		for (PetscInt c = 0; c < dof; c++) {
+			if (mobile[c]) {
+				mobilePositions[c] = mobileIds.size();
+				mobileIds.push_back(c);
+			}
+		}
+	}
+	lineLower.assign(mobileIds.size() * nPoints, 0.0);
+	lineDiag.assign(mobileIds.size() * nPoints, 0.0);
+	lineUpper.assign(mobileIds.size() * nPoints, 0.0);
+	lineValues.assign(xm, 0.0);
+	lineWork.assign(xm, 0.0);
+
+	patternSet = true;
+
+	PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "BlockPreconditioner::setUp")
+PetscErrorCode BlockPreconditioner::setUp(Mat A) {
+	PetscErrorCode ierr;
+	PetscInt rowStart, nCols;
+	const PetscInt *cols;
+	const PetscScalar *vals;
+
+	PetscFunctionBeginUser;
+	if (!patternSet) {
+		ierr = readPattern(A);
+		CHKERRQ(ierr);
+	}
+
+	ierr = MatGetOwnershipRange(A, &rowStart, NULL);
+	CHKERRQ(ierr);
+
+	// Start from zero, the memory is kept
+	const PetscInt nPoints = xm * ym * zm;
+	factorization.setNumberOfBlocks(nPoints);
+	std::fill(lineLower.begin(), lineLower.end(), 0.0);
+	std::fill(lineDiag.begin(), lineDiag.end(), 0.0);
+	std::fill(lineUpper.begin(), lineUpper.end(), 0.0);
+
+	for (PetscInt p = 0; p < nPoints; p++) {
+		const PetscInt xi = xs + p % xm;
+		const PetscInt base = rowStart + p * dof;
+		double *blockValues = factorization.getValues(p);
+		for (PetscInt c = 0; c < dof; c++) {
+			const PetscInt row = base + c;
+			const int m = mobilePositions[c];
+			ierr = MatGetRow(A, row, &nCols, &cols, &vals);
+			CHKERRQ(ierr);
+			for (PetscInt n = 0; n < nCols; n++) {
+				if (cols[n] >= base && cols[n] < base + dof) {
+					// The reaction block
+					int pos = factorization.find(c, cols[n] - base);
+					if (pos >= 0)
+						blockValues[pos] += vals[n];
+					if (m >= 0 && cols[n] == row)
+						lineDiag[m * nPoints + p] = vals[n];
+				}
+				// The line of the mobile species
+				else if (m >= 0 && cols[n] == row - dof && xi > xs)
+					lineLower[m * nPoints + p] = vals[n];
+				else if (m >= 0 && cols[n] == row + dof && xi < xs + xm - 1)
+					lineUpper[m * nPoints + p] = vals[n];
+			}
+			ierr = MatRestoreRow(A, row, &nCols, &cols, &vals);
+			CHKERRQ(ierr);
+		}
+
+		// The symbolic factorization is reused
+		try {
+			factorization.factor(p);
+		} catch (const std::string & error) {
+			SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_MAT_LU_ZRPVT, "%s",
+					error.c_str());
+		}
+	}
+
+	nSetUps++;
+
+	PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "BlockPreconditioner::apply")
+PetscErrorCode BlockPreconditioner::apply(Mat A, Vec x, Vec y) {
+	PetscErrorCode ierr;
+	PetscScalar *yArray;
+	const PetscScalar *rArray;
+
+	PetscFunctionBeginUser;
+
+	// First stage, solve the reaction block of each grid point
+	const PetscInt nPoints = xm * ym * zm;
+	ierr = VecCopy(x, y);
+	CHKERRQ(ierr);
+	ierr = VecGetArray(y, &yArray);
+	CHKERRQ(ierr);
+	for (PetscInt p = 0; p < nPoints; p++) {
+		factorization.solve(p, yArray + p * dof);
+	}
+	ierr = VecRestoreArray(y, &yArray);
+	CHKERRQ(ierr);
+
+	nApplications++;
+
+	if (mobileIds.empty())
+		PetscFunctionReturn(0);
+
+	// Second stage, the residual x - A y of the mobile species is solved
+	// along the lines of the grid
+	if (!residual) {
+		ierr = VecDuplicate(x, &residual);
+		CHKERRQ(ierr);
+	}
+	ierr = MatMult(A, y, residual);
+	CHKERRQ(ierr);
+	ierr = VecAYPX(residual, -1.0, x);
+	CHKERRQ(ierr);
+
+	ierr = VecGetArrayRead(residual, &rArray);
+	CHKERRQ(ierr);
+	ierr = VecGetArray(y, &yArray);
+	CHKERRQ(ierr);
+	for (PetscInt line = 0; line < ym * zm; line++) {
+		const PetscInt first = line * xm;
+		for (unsigned int m = 0; m < mobileIds.size(); m++) {
+			const PetscInt c = mobileIds[m];
+			for (PetscInt i = 0; i < xm; i++) {
+				lineValues[i] = rArray[(first + i) * dof + c];
+			}
+			const PetscInt offset = m * nPoints + first;
+			SparseBlockFactorization::solveTridiagonal(xm,
+					lineLower.data() + offset, lineDiag.data() + offset,
+					lineUpper.data() + offset, lineValues.data(),
+					lineWork.data());
+			for (PetscInt i = 0; i < xm; i++) {
+				yArray[(first + i) * dof + c] += lineValues[i];
+			}
+		}
+	}
+	ierr = VecRestoreArray(y, &yArray);
+	CHKERRQ(ierr);
+	ierr = VecRestoreArrayRead(residual, &rArray);
+	CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
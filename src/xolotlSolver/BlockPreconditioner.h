@@ -0,0 +1,150 @@
+#ifndef BLOCKPRECONDITIONER_H
+#define BLOCKPRECONDITIONER_H
+
+// Includes
+#include <petscksp.h>
+#include <petscdmda.h>
+#include <vector>
+#include "SparseBlockFactorization.h"
+
+namespace xolotlSolver {
+
+/**
+ * This class is a preconditioner for the Jacobian of the
+ * advection-diffusion-reaction problem, used as a PETSc PCSHELL. It is
+ * selected with the -xolotl_pc option instead of the preconditioners of
+ * PETSc.
+ *
+ * It has two stages:
+ * 	- the reaction block of each locally owned grid point is solved with
+ * its incomplete LU factorization. The pattern of the factors is computed
+ * the first time the preconditioner is set up and then reused, only the
+ * numeric factorization is done when the Jacobian changes. The level of
+ * fill is given by -xolotl_pc_levels (0 by default, a large value gives
+ * the exact LU);
+ * 	- the residual of the first stage is then solved for the mobile
+ * species, the only ones coupled to the neighboring grid points, with a
+ * tridiagonal solve along each line of the grid in the x direction. The
+ * coupling in the y and z directions and between processes is ignored. It
+ * is turned off with -xolotl_pc_no_line_solve.
+ *
+ * The blocks and the mobile species are read from the assembled
+ * preconditioning matrix, whose nonzero pattern is fixed by the block fills
+ * of the distributed array.
+ */
+class BlockPreconditioner {
+
+private:
+
+	//! The distributed array
+	DM da;
+
+	//! The number of degrees of freedom at each grid point
+	PetscInt dof;
+
+	//! The locally owned corner of the grid and its widths
+	PetscInt xs, ys, zs, xm, ym, zm;
+
+	//! The maximum level of the fill-in entries of the factors
+	int levels;
+
+	//! Should the mobile species be solved along the lines of the grid?
+	bool lineSolve;
+
+	//! Were the patterns read from the matrix?
+	bool patternSet;
+
+	//! The factorizations of the reaction blocks of all the grid points
+	SparseBlockFactorization factorization;
+
+	//! The degrees of freedom coupled to the neighboring grid points in x
+	std::vector<PetscInt> mobileIds;
+
+	//! The position of each degree of freedom in mobileIds, -1 if it is
+	//! not mobile
+	std::vector<int> mobilePositions;
+
+	//! The tridiagonal coefficients of the mobile species, indexed by
+	//! grid point and then by mobile species
+	std::vector<double> lineLower, lineDiag, lineUpper;
+
+	//! Work arrays for the line solves
+	std::vector<double> lineValues, lineWork;
+
+	//! The residual after the first stage
+	Vec residual;
+
+	//! The number of times the preconditioner was set up and applied
+	PetscInt nSetUps, nApplications;
+
+	/**
+	 * Read the pattern of the reaction blocks and the mobile species from
+	 * the matrix and compute the pattern of the factors.
+	 *
+	 * @param A The preconditioning matrix
+	 * @return The PETSc error code
+	 */
+	PetscErrorCode readPattern(Mat A);
+
+public:
+
+	/**
+	 * The constructor.
+	 *
+	 * @param da The distributed array of the solver
+	 * @param levels The maximum level of the fill-in entries of the factors
+	 * @param lineSolve Should the mobile species be solved along the lines
+	 * of the grid?
+	 */
+	BlockPreconditioner(DM da, int levels, bool lineSolve);
+
+	//! The destructor
+	~BlockPreconditioner();
+
+	/**
+	 * Use this preconditioner in the given PETSc preconditioner.
+	 *
+	 * @param pc The PETSc preconditioner
+	 */
+	void attach(PC pc);
+
+	/**
+	 * Factor the reaction blocks of the preconditioning matrix and read the
+	 * coefficients of the line solves.
+	 *
+	 * @param A The preconditioning matrix
+	 * @return The PETSc error code
+	 */
+	PetscErrorCode setUp(Mat A);
+
+	/**
+	 * Apply the preconditioner.
+	 *
+	 * @param A The preconditioning matrix
+	 * @param x The vector to precondition
+	 * @param y The result
+	 * @return The PETSc error code
+	 */
+	PetscErrorCode apply(Mat A, Vec x, Vec y);
+
+	/**
+	 * Get the number of times the preconditioner was set up.
+	 *
+	 * @return The number of setups
+	 */
+	PetscInt getNumberOfSetUps() const {
+		return nSetUps;
+	}
+
+	/**
+	 * Get the number of times the preconditioner was applied.
+	 *
+	 * @return The number of applications
+	 */
+	PetscInt getNumberOfApplications() const {
+		return nApplications;
+	}
+};
+
+} /* end namespace xolotlSolver */
+#endif
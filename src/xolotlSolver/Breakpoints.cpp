@@ -0,0 +1,22 @@
+#include "Breakpoints.h"
+#include <algorithm>
+
+using namespace xolotlSolver;
+
+constexpr double Breakpoints::tolerance;
+
+Breakpoints::Breakpoints(std::vector<double> _times) :
+		times(_times) {
+	std::sort(times.begin(), times.end());
+	times.erase(std::unique(times.begin(), times.end()), times.end());
+}
+
+double Breakpoints::getTimeStep(double time, double dt) const {
+	// The first breakpoint ahead, the one the previous step landed on is passed
+	auto it = std::upper_bound(times.begin(), times.end(),
+			time + tolerance * dt);
+	if (it != times.end() && time + dt > *it - tolerance * dt)
+		return *it - time;
+
+	return dt;
+}
@@ -0,0 +1,58 @@
+#ifndef BREAKPOINTS_H
+#define BREAKPOINTS_H
+
+#include <vector>
+
+namespace xolotlSolver {
+
+/**
+ * This class keeps the times of the flux and temperature profiles and
+ * shortens the time steps so that they land on these times: the profiles are
+ * only piecewise linear and a step going over one of their breakpoints would
+ * be rejected.
+ */
+class Breakpoints {
+
+private:
+
+	//! The times, in increasing order and without duplicates
+	std::vector<double> times;
+
+public:
+
+	//! The relative distance (to the time step) under which a breakpoint is
+	//! considered as reached
+	static constexpr double tolerance = 1.0e-6;
+
+	/**
+	 * The constructor.
+	 *
+	 * @param times The times of the profiles, in any order and possibly
+	 * duplicated
+	 */
+	Breakpoints(std::vector<double> times = std::vector<double>());
+
+	/**
+	 * Get the breakpoints.
+	 *
+	 * @return The times, in increasing order and without duplicates
+	 */
+	const std::vector<double> & getTimes() const {
+		return times;
+	}
+
+	/**
+	 * Compute the step to take from the given time so that it doesn't go over
+	 * the first breakpoint ahead. The breakpoint the previous step landed on,
+	 * within the tolerance, is already passed.
+	 *
+	 * @param time The current time
+	 * @param dt The time step that would be taken
+	 * @return The time step, shortened to land on the next breakpoint if dt
+	 * goes over it
+	 */
+	double getTimeStep(double time, double dt) const;
+};
+
+} /* end namespace xolotlSolver */
+#endif
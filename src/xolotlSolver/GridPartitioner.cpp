@@ -0,0 +1,78 @@
+#include "GridPartitioner.h"
+#include <algorithm>
+#include <string>
+
+using namespace xolotlSolver;
+
+constexpr double GridPartitioner::boundaryCost;
+constexpr double GridPartitioner::bulkCost;
+constexpr double GridPartitioner::surfaceCost;
+constexpr double GridPartitioner::surfaceDepth;
+
+std::vector<double> GridPartitioner::computeModelCosts(
+		const std::vector<double> & grid, int surfacePosition,
+		double surfaceDepth) {
+	const int n = grid.size();
+	std::vector<double> costs(n, boundaryCost);
+
+	// Everything left of the surface and the last point are only copied
+	for (int xi = surfacePosition + 1; xi < n - 1; xi++) {
+		costs[xi] = bulkCost;
+		if (grid[xi] - grid[surfacePosition] <= surfaceDepth)
+			costs[xi] += surfaceCost;
+	}
+
+	return costs;
+}
+
+std::vector<int> GridPartitioner::computeOwnershipRanges(
+		const std::vector<double> & costs, int nProcs) {
+	const int n = costs.size();
+	if (nProcs < 1 || nProcs > n)
+		throw std::string(
+				"GridPartitioner Exception: each process needs at least one "
+						"grid point.");
+
+	// The cumulated cost before each point
+	std::vector<double> cumulated(n + 1, 0.0);
+	for (int i = 0; i < n; i++) {
+		cumulated[i + 1] = cumulated[i] + std::max(costs[i], 0.0);
+	}
+
+	// Place the end of each range, the previous ones keep their points and
+	// the next ones need at least one
+	std::vector<int> ranges(nProcs, 0);
+	int start = 0;
+	for (int p = 0; p < nProcs - 1; p++) {
+		double target = cumulated[n] * (double) (p + 1) / (double) nProcs;
+		int end = std::lower_bound(cumulated.begin(), cumulated.end(), target)
+				- cumulated.begin();
+		if (end > 0 && target - cumulated[end - 1] < cumulated[end] - target)
+			end--;
+		end = std::min(std::max(end, start + 1), n - (nProcs - p - 1));
+		ranges[p] = end - start;
+		start = end;
+	}
+	ranges[nProcs - 1] = n - start;
+
+	return ranges;
+}
+
+double GridPartitioner::computeImbalance(const std::vector<double> & costs,
+		const std::vector<int> & ranges) {
+	double total = 0.0, largest = 0.0;
+	int xi = 0;
+	for (auto range : ranges) {
+		double load = 0.0;
+		for (int i = 0; i < range; i++, xi++) {
+			load += costs[xi];
+		}
+		total += load;
+		largest = std::max(largest, load);
+	}
+
+	if (total <= 0.0)
+		return 1.0;
+
+	return largest * (double) ranges.size() / total;
+}
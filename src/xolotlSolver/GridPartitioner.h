@@ -0,0 +1,74 @@
+#ifndef GRIDPARTITIONER_H
+#define GRIDPARTITIONER_H
+
+#include <vector>
+
+namespace xolotlSolver {
+
+/**
+ * This class computes how the grid points in the x direction are split
+ * between the processes so that each one gets the same amount of work.
+ *
+ * The work of each grid point is given by a cost, either from a model of the
+ * RHS evaluation or from the time measured during the previous evaluations.
+ * The points left of the surface and the last one only copy their
+ * concentrations and are almost free, while the points close to the surface
+ * also compute the incident flux and the modified trap-mutation.
+ */
+class GridPartitioner {
+
+public:
+
+	//! The cost of a grid point that only copies its concentrations
+	static constexpr double boundaryCost = 0.05;
+
+	//! The cost of a grid point in the bulk
+	static constexpr double bulkCost = 1.0;
+
+	//! The additional cost of a grid point close to the surface
+	static constexpr double surfaceCost = 1.0;
+
+	//! The depth (nm) of the region close to the surface where the incident
+	//! flux and the modified trap-mutation are computed
+	static constexpr double surfaceDepth = 10.0;
+
+	/**
+	 * Compute the modeled cost of each grid point.
+	 *
+	 * @param grid The grid in the x direction
+	 * @param surfacePosition The index of the surface
+	 * @param surfaceDepth The depth (nm) under which a grid point is close
+	 * to the surface
+	 * @return The cost of each grid point
+	 */
+	static std::vector<double> computeModelCosts(
+			const std::vector<double> & grid, int surfacePosition,
+			double surfaceDepth);
+
+	/**
+	 * Split the grid points in contiguous ranges of nearly equal total cost,
+	 * each process getting at least one point. Each range ends at the point
+	 * whose cumulated cost is the closest to its share of the total cost.
+	 *
+	 * @param costs The cost of each grid point
+	 * @param nProcs The number of processes, not larger than the number of
+	 * grid points
+	 * @return The number of grid points of each process
+	 */
+	static std::vector<int> computeOwnershipRanges(
+			const std::vector<double> & costs, int nProcs);
+
+	/**
+	 * Compute the imbalance of a split: the largest total cost of a process
+	 * divided by the mean one.
+	 *
+	 * @param costs The cost of each grid point
+	 * @param ranges The number of grid points of each process
+	 * @return The imbalance, 1 for a perfect split
+	 */
+	static double computeImbalance(const std::vector<double> & costs,
+			const std::vector<int> & ranges);
+};
+
+} /* end namespace xolotlSolver */
+#endif
@@ -12,6 +12,7 @@
 #include <ITrapMutationHandler.h>
 #include <IMaterialFactory.h>
 #include <IReactionNetwork.h>
+#include <HDF5RestartReader.h>
 
 namespace xolotlSolver 
 {
@@ -63,6 +64,42 @@ namespace xolotlSolver
    virtual void 
    initializeConcentration( DM& da, Vec& C ) = 0;
 
+/**
+ * Fill the local vector with the solution: all the degrees of freedom of the
+ * locally owned grid points and, at the ghost points, the ones that are
+ * coupled to the neighboring points. It has the same 2-step process as
+ * DMGlobalToLocalBegin() and DMGlobalToLocalEnd().
+ *
+ * @param da The PETSc distributed array
+ * @param C The PETSc global solution vector
+ * @param localC The PETSc local solution vector
+ * @param begin True to start the communications, false to end them
+ */
+   virtual void 
+   globalToLocal( DM& da, Vec& C, Vec& localC, bool begin ) = 0;
+
+/**
+ * Should the grid be repartitioned between the processes? It is the case
+ * when the work is balanced with custom ownership ranges and the surface
+ * moved by more than the chosen threshold since the last partition.
+ *
+ * @return True if repartition() has to be called
+ */
+   virtual bool 
+   needRepartition() const = 0;
+
+/**
+ * Repartition the grid between the processes from the current cost of each
+ * grid point: a new distributed array is created with the same grid and
+ * block fills, and the solution is migrated to it. The old distributed array
+ * and solution vector are destroyed (their other references are kept).
+ *
+ * @param da The PETSc distributed array, replaced by the new one
+ * @param C The PETSc solution vector, replaced by the new one
+ */
+   virtual void 
+   repartition( DM& da, Vec& C ) = 0;
+
 /**
  * Compute the new concentrations for the RHS function given an initial
  * vector of concentrations.
@@ -189,6 +226,14 @@ namespace xolotlSolver
    virtual xolotlCore::IFluxHandler* 
    getFluxHandler() const = 0;
 
+/**
+ * Get the temperature handler.
+ *
+ * @return The temperature handler
+ */
+   virtual xolotlCore::ITemperatureHandler* 
+   getTemperatureHandler() const = 0;
+
 /**
  * Get the advection handler.
  *
@@ -228,6 +273,15 @@ namespace xolotlSolver
  */
    virtual std::string getNetworkName() const = 0;
 
+/**
+ * Get the reader of the network file, it is only available from the creation
+ * of the solver context until the concentrations are initialized.
+ *
+ * @return The restart reader
+ */
+   virtual xolotlCore::HDF5RestartReader* 
+   getRestartReader() const = 0;
+
  }; //end class ISolverHandler
 
 } /* namespace xolotlSolver */
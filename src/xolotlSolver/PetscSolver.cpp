@@ -1,5 +1,7 @@
 // Includes
 #include <PetscSolver.h>
+#include <BlockPreconditioner.h>
+#include <Breakpoints.h>
 #include <HDF5NetworkLoader.h>
 #include <HDF5Utils.h>
 
@@ -19,6 +21,16 @@ using namespace xolotlCore;
  -ts_max_steps <maxsteps>  -- maximum number of time-steps to take
  -ts_final_time <time>     -- maximum time to compute to
  -ts_dt <size>             -- initial size of the time step
+ -xolotl_pc                -- use the Xolotl block preconditioner
+ -xolotl_pc_levels <k>     -- level of fill of its factorizations (0 by default)
+ -xolotl_pc_no_line_solve  -- don't solve the mobile species along the grid lines
+ -xolotl_balance           -- split the grid (1D) between the processes from the cost of its points
+ -xolotl_balance_threshold <n> -- repartition it when the surface moved by more than n grid points
+ -xolotl_balance_measured  -- use the times measured during the RHS evaluations as costs
+ -xolotl_rate_cache_mb <size> -- memory (MB) of the rate tables cached per temperature (256 by default)
+
+ The time steps always land on the times of the flux and temperature profile
+ files because these profiles are only piecewise linear.
  */
 
 namespace xolotlSolver 
@@ -34,9 +46,14 @@ namespace xolotlSolver
  static char help[] = "Solves C_t =  -D*C_xx + A*C_x + F(C) + R(C) + D(C) from Brian Wirth's SciDAC project.\n";
 
 // ----- GLOBAL VARIABLES ----- //
+// The times of the flux and temperature profiles
+ static Breakpoints breakpoints;
+
  extern PetscErrorCode setupPetsc1DMonitor(TS);
  extern PetscErrorCode setupPetsc2DMonitor(TS);
  extern PetscErrorCode setupPetsc3DMonitor(TS);
+ extern void setTimeStepOffset(PetscInt);
+ extern void finalizeTelemetrySink();
   
 //--------------------------------------------------------------------------------
  PetscSolver::PetscSolver(std::shared_ptr<xolotlPerf::IHandlerRegistry> registry) :
@@ -110,17 +127,18 @@ namespace xolotlSolver
   ierr = DMGetLocalVector(da, &localC); CHKERRQ(ierr);
 
 // Scatter ghost points to local vector, using the 2-step process
-// DMGlobalToLocalBegin(),DMGlobalToLocalEnd().
+// of DMGlobalToLocalBegin(),DMGlobalToLocalEnd(). Only the mobile clusters
+// are sent to the ghost points.
 // By placing code between these two statements, computations can be
 // done while messages are in transition.
-  ierr = DMGlobalToLocalBegin( da, C, INSERT_VALUES, localC ); CHKERRQ(ierr);
-  ierr = DMGlobalToLocalEnd( da, C, INSERT_VALUES, localC ); CHKERRQ(ierr);
+  auto solverHandler = PetscSolver::getSolverHandler();
+  solverHandler->globalToLocal( da, C, localC, true );
+  solverHandler->globalToLocal( da, C, localC, false );
 
 // Set the initial values of F
   ierr = VecSet(F, 0.0);CHKERRQ(ierr);
 
 // Compute the new concentrations
-  auto solverHandler = PetscSolver::getSolverHandler();
   solverHandler->updateConcentration(ts, localC, F, ftime);
 
 // Stop the RHSFunction Timer
@@ -150,13 +168,13 @@ namespace xolotlSolver
   Vec localC;
   ierr = DMGetLocalVector( da, &localC ); CHKERRQ(ierr);
 
-// Get the complete data array
-  ierr = DMGlobalToLocalBegin( da, C, INSERT_VALUES, localC ); CHKERRQ(ierr);
-  ierr = DMGlobalToLocalEnd( da, C, INSERT_VALUES, localC ); CHKERRQ(ierr);
-
 // Get the solver handler
   auto solverHandler = PetscSolver::getSolverHandler();
 
+// Get the local data array, with the mobile clusters at the ghost points
+  solverHandler->globalToLocal( da, C, localC, true );
+  solverHandler->globalToLocal( da, C, localC, false );
+
 /* ----- Compute the off-diagonal part of the Jacobian ----- */
   solverHandler->computeOffDiagonalJacobian(ts, localC, J, ftime);
 
@@ -181,6 +199,107 @@ namespace xolotlSolver
   PetscFunctionReturn(0);
  }
 
+//--------------------------------------------------------------------------------
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "checkRepartition")
+/*
+ Stop the time stepping after the current step if the grid has to be
+ repartitioned between the processes, solve() starts it again afterwards.
+ */
+ PetscErrorCode checkRepartition( TS ts ) 
+ {
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  if (PetscSolver::getSolverHandler()->needRepartition()) 
+  {
+   ierr = TSSetConvergedReason(ts, TS_CONVERGED_USER); CHKERRQ(ierr);
+  }
+
+  PetscFunctionReturn(0);
+ }
+
+//--------------------------------------------------------------------------------
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "continueTimeStepping")
+/*
+ Prepare the time stepper to go on after TSSolve stopped for a repartition:
+ TSSolve numbers its steps from 0 again, so the monitors add the nSteps steps
+ already done and skip the initial call that would monitor the last step a
+ second time, and the next TSSolve can only do what is left of maxSteps.
+ */
+ PetscErrorCode continueTimeStepping( TS ts, PetscInt nSteps, PetscInt maxSteps ) 
+ {
+  PetscErrorCode ierr;
+  PetscInt steps;
+  PetscReal maxTime;
+
+  PetscFunctionBeginUser;
+  setTimeStepOffset(nSteps);
+  ierr = TSGetDuration(ts, &steps, &maxTime); CHKERRQ(ierr);
+  ierr = TSSetDuration(ts, maxSteps - nSteps, maxTime); CHKERRQ(ierr);
+
+  PetscFunctionReturn(0);
+ }
+
+//--------------------------------------------------------------------------------
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "stepToBreakpoint")
+/*
+ Shorten the next time step so that it doesn't go over the next breakpoint of
+ the flux and temperature profiles: the step lands on it instead of being
+ rejected because the profile is not smooth there.
+
+ This is the pre-step, it is only called once per step. When the step is
+ rejected by the adaptor or its nonlinear solve fails, TSStep retries it
+ without calling it again. The retry uses a shorter step, so it still lands
+ before the breakpoint and the next pre-step shortens the following step to
+ land on it. The only way for a retry to go over a breakpoint is an adaptor
+ clamping the shorter step up to its minimum (-ts_adapt_dt_min) when the
+ breakpoint is closer than that minimum: the profile is then integrated across
+ its breakpoint for that step, and keeping -ts_adapt_dt_min below the
+ spacing of the profile times avoids it.
+ */
+ PetscErrorCode stepToBreakpoint( TS ts ) 
+ {
+  PetscErrorCode ierr;
+  PetscReal time, dt;
+
+  PetscFunctionBeginUser;
+  ierr = TSGetTime(ts, &time); CHKERRQ(ierr);
+  ierr = TSGetTimeStep(ts, &dt); CHKERRQ(ierr);
+
+  PetscReal breakpointDt = breakpoints.getTimeStep(time, dt);
+  if (breakpointDt != dt) 
+  {
+   ierr = TSSetTimeStep(ts, breakpointDt); CHKERRQ(ierr);
+  }
+
+  PetscFunctionReturn(0);
+ }
+
+//--------------------------------------------------------------------------------
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "setBreakpoints")
+/*
+ Keep the given times, sorted and without duplicates, as the breakpoints and
+ make the time steps land on them with stepToBreakpoint if there are any.
+ */
+ PetscErrorCode setBreakpoints( TS ts, std::vector<double> times ) 
+ {
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  breakpoints = Breakpoints(times);
+
+  if (!breakpoints.getTimes().empty()) 
+  {
+   ierr = TSSetPreStep(ts, stepToBreakpoint); CHKERRQ(ierr);
+  }
+
+  PetscFunctionReturn(0);
+ }
+
 //--------------------------------------------------------------------------------
  void 
  PetscSolver::solve() 
@@ -226,17 +345,28 @@ namespace xolotlSolver
   ierr = TSSetSolution(ts, C);
   checkPetscError(ierr, "PetscSolver::solve: TSSetSolution failed.");
 
+  ierr = TSSetPostStep(ts, checkRepartition);
+  checkPetscError(ierr, "PetscSolver::solve: TSSetPostStep failed.");
+
+// Make the time steps land on the breakpoints of the flux and temperature
+// profiles
+  auto profileTimes = Solver::solverHandler->getFluxHandler()->getBreakpoints();
+  auto tempBreakpoints =
+      Solver::solverHandler->getTemperatureHandler()->getBreakpoints();
+  profileTimes.insert(profileTimes.end(), tempBreakpoints.begin(), tempBreakpoints.end());
+  ierr = setBreakpoints(ts, profileTimes);
+  checkPetscError(ierr, "PetscSolver::solve: setBreakpoints failed.");
+
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
  Set solver options
  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 // Read the times if the information is in the HDF5 file
-  auto fileName = Solver::solverHandler->getNetworkName();
+  auto restartReader = Solver::solverHandler->getRestartReader();
   double time = 0.0, deltaTime = 1.0e-12;
-  int tempTimeStep = -2;
-  if (HDF5Utils::hasConcentrationGroup(fileName, tempTimeStep)) 
+  if (restartReader->hasConcentrations()) 
   {
-   HDF5Utils::readTimes(fileName, tempTimeStep, time, deltaTime);
+   restartReader->getTimes(time, deltaTime);
   }
 
   ierr = TSSetInitialTimeStep(ts, time, deltaTime);
@@ -244,6 +374,32 @@ namespace xolotlSolver
   ierr = TSSetFromOptions(ts);
   checkPetscError(ierr, "PetscSolver::solve: TSSetFromOptions failed.");
 
+// Replace the PETSc preconditioner by the Xolotl one if it was asked for
+  PetscBool flagPC, flagNoLineSolve, flagLevels;
+  ierr = PetscOptionsHasName(NULL, NULL, "-xolotl_pc", &flagPC);
+  checkPetscError(ierr, "PetscSolver::solve: PetscOptionsHasName (-xolotl_pc) failed.");
+  std::unique_ptr<BlockPreconditioner> preconditioner;
+  PetscInt levels = 0;
+  PC pc;
+  if (flagPC) 
+  {
+   ierr = PetscOptionsGetInt(NULL, NULL, "-xolotl_pc_levels", &levels, &flagLevels);
+   checkPetscError(ierr, "PetscSolver::solve: PetscOptionsGetInt (-xolotl_pc_levels) failed.");
+   ierr = PetscOptionsHasName(NULL, NULL, "-xolotl_pc_no_line_solve", &flagNoLineSolve);
+   checkPetscError(ierr, "PetscSolver::solve: PetscOptionsHasName (-xolotl_pc_no_line_solve) failed.");
+
+   SNES snes;
+   KSP ksp;
+   ierr = TSGetSNES(ts, &snes);
+   checkPetscError(ierr, "PetscSolver::solve: TSGetSNES failed.");
+   ierr = SNESGetKSP(snes, &ksp);
+   checkPetscError(ierr, "PetscSolver::solve: SNESGetKSP failed.");
+   ierr = KSPGetPC(ksp, &pc);
+   checkPetscError(ierr, "PetscSolver::solve: KSPGetPC failed.");
+   preconditioner.reset(new BlockPreconditioner(da, levels, !flagNoLineSolve));
+   preconditioner->attach(pc);
+  }
+
 // Switch on the number of dimensions to set the monitors
   int dim = Solver::solverHandler->getDimension();
   switch (dim) 
@@ -281,8 +437,73 @@ namespace xolotlSolver
  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
   if (ts != NULL && C != NULL) 
   {
-   ierr = TSSolve(ts, C);
-   checkPetscError(ierr, "PetscSolver::solve: TSSolve failed.");
+// The time stepping stops each time the grid has to be repartitioned,
+// the counts of each part are summed
+   PetscInt nSteps = 0, nNonlinear = 0, nLinear = 0, nSetUps = 0, nApplications = 0;
+   PetscInt maxSteps;
+   PetscReal maxTime;
+   ierr = TSGetDuration(ts, &maxSteps, &maxTime);
+   checkPetscError(ierr, "PetscSolver::solve: TSGetDuration failed.");
+   setTimeStepOffset(0);
+   while (true) 
+   {
+    ierr = TSSolve(ts, C);
+    checkPetscError(ierr, "PetscSolver::solve: TSSolve failed.");
+
+    PetscInt steps, nonlinear, linear;
+    ierr = TSGetTimeStepNumber(ts, &steps);
+    checkPetscError(ierr, "PetscSolver::solve: TSGetTimeStepNumber failed.");
+    ierr = TSGetSNESIterations(ts, &nonlinear);
+    checkPetscError(ierr, "PetscSolver::solve: TSGetSNESIterations failed.");
+    ierr = TSGetKSPIterations(ts, &linear);
+    checkPetscError(ierr, "PetscSolver::solve: TSGetKSPIterations failed.");
+    nSteps += steps;
+    nNonlinear += nonlinear;
+    nLinear += linear;
+
+    TSConvergedReason reason;
+    ierr = TSGetConvergedReason(ts, &reason);
+    checkPetscError(ierr, "PetscSolver::solve: TSGetConvergedReason failed.");
+    if (reason != TS_CONVERGED_USER || !Solver::solverHandler->needRepartition()
+        || nSteps >= maxSteps)
+     break;
+
+// Move the solution to the new split of the grid, the time stepper keeps
+// its time, time step and options but drops its vectors and matrices
+    ierr = TSReset(ts);
+    checkPetscError(ierr, "PetscSolver::solve: TSReset failed.");
+    Solver::solverHandler->repartition(da, C);
+    ierr = TSSetDM(ts, da);
+    checkPetscError(ierr, "PetscSolver::solve: TSSetDM failed.");
+    ierr = TSSetSolution(ts, C);
+    checkPetscError(ierr, "PetscSolver::solve: TSSetSolution failed.");
+
+// The step numbers and the maximum number of steps go on from this part
+    ierr = continueTimeStepping(ts, nSteps, maxSteps);
+    checkPetscError(ierr, "PetscSolver::solve: continueTimeStepping failed.");
+    if (preconditioner) 
+    {
+     nSetUps += preconditioner->getNumberOfSetUps();
+     nApplications += preconditioner->getNumberOfApplications();
+     preconditioner.reset(new BlockPreconditioner(da, levels, !flagNoLineSolve));
+     preconditioner->attach(pc);
+    }
+   }
+
+// Report the iteration counts
+   ierr = PetscPrintf(PETSC_COMM_WORLD, "Time steps: %D, nonlinear iterations: %D, "
+                      "linear iterations: %D\n", nSteps, nNonlinear, nLinear);
+   checkPetscError(ierr, "PetscSolver::solve: PetscPrintf failed.");
+   if (preconditioner) 
+   {
+    ierr = PetscPrintf(PETSC_COMM_WORLD, "Xolotl preconditioner setups: %D, "
+                       "applications: %D\n", nSetUps + preconditioner->getNumberOfSetUps(),
+                       nApplications + preconditioner->getNumberOfApplications());
+    checkPetscError(ierr, "PetscSolver::solve: PetscPrintf failed.");
+   }
+
+// Write the rows of the monitors that are still buffered
+   finalizeTelemetrySink();
   } 
   else 
   {
@@ -297,6 +518,7 @@ namespace xolotlSolver
   checkPetscError(ierr, "PetscSolver::solve: VecDestroy failed.");
   ierr = TSDestroy(&ts);
   checkPetscError(ierr, "PetscSolver::solve: TSDestroy failed.");
+  preconditioner.reset();
   ierr = DMDestroy(&da);
   checkPetscError(ierr, "PetscSolver::solve: DMDestroy failed.");
 
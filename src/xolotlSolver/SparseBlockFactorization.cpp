@@ -0,0 +1,164 @@
+#include "SparseBlockFactorization.h"
+#include <algorithm>
+#include <map>
+#include <string>
+
+using namespace xolotlSolver;
+
+void SparseBlockFactorization::setPattern(int n,
+		const std::vector<std::vector<int> > & columns, int levels) {
+	if ((int) columns.size() != n)
+		throw std::string(
+				"SparseBlockFactorization Exception: one vector of columns "
+						"is needed for each row.");
+
+	size = n;
+	rowPtr.assign(1, 0);
+	colIds.clear();
+	diagPtr.assign(n, 0);
+
+	// The levels of the upper part of the rows that were already computed
+	std::vector<std::map<int, int> > upperLevels(n);
+
+	for (int i = 0; i < n; i++) {
+		// The entries of the matrix and the diagonal have the level 0
+		std::map<int, int> rowLevels;
+		rowLevels[i] = 0;
+		for (auto col : columns[i]) {
+			if (col < 0 || col >= n)
+				throw std::string(
+						"SparseBlockFactorization Exception: a column index "
+								"is out of the block.");
+			rowLevels[col] = 0;
+		}
+
+		// Eliminate the lower part in order, the fill-in entries of the row
+		// are inserted in the map while going through it
+		for (auto it = rowLevels.begin(); it != rowLevels.end() && it->first < i;
+				++it) {
+			int k = it->first;
+			for (auto const & upper : upperLevels[k]) {
+				int level = it->second + upper.second + 1;
+				if (level > levels)
+					continue;
+				auto entry = rowLevels.find(upper.first);
+				if (entry == rowLevels.end())
+					rowLevels[upper.first] = level;
+				else
+					entry->second = std::min(entry->second, level);
+			}
+		}
+
+		// Save the pattern of the row
+		for (auto const & entry : rowLevels) {
+			if (entry.first == i)
+				diagPtr[i] = colIds.size();
+			if (entry.first > i)
+				upperLevels[i].insert(entry);
+			colIds.push_back(entry.first);
+		}
+		rowPtr.push_back(colIds.size());
+	}
+
+	positions.assign(n, -1);
+	values.clear();
+
+	return;
+}
+
+void SparseBlockFactorization::setNumberOfBlocks(int nBlocks) {
+	values.assign(nBlocks * colIds.size(), 0.0);
+
+	return;
+}
+
+int SparseBlockFactorization::find(int row, int col) const {
+	auto begin = colIds.begin() + rowPtr[row];
+	auto end = colIds.begin() + rowPtr[row + 1];
+	auto it = std::lower_bound(begin, end, col);
+	if (it == end || *it != col)
+		return -1;
+
+	return it - colIds.begin();
+}
+
+void SparseBlockFactorization::factor(int block) {
+	double * v = getValues(block);
+
+	for (int i = 0; i < size; i++) {
+		// Where the columns of the row are
+		for (int p = rowPtr[i]; p < rowPtr[i + 1]; p++) {
+			positions[colIds[p]] = p;
+		}
+
+		// Eliminate the lower part, the entries outside of the pattern are
+		// dropped
+		for (int p = rowPtr[i]; p < diagPtr[i]; p++) {
+			int k = colIds[p];
+			v[p] /= v[diagPtr[k]];
+			for (int q = diagPtr[k] + 1; q < rowPtr[k + 1]; q++) {
+				int pos = positions[colIds[q]];
+				if (pos >= 0)
+					v[pos] -= v[p] * v[q];
+			}
+		}
+
+		for (int p = rowPtr[i]; p < rowPtr[i + 1]; p++) {
+			positions[colIds[p]] = -1;
+		}
+
+		if (v[diagPtr[i]] == 0.0)
+			throw std::string(
+					"SparseBlockFactorization Exception: zero pivot in row "
+							+ std::to_string(i) + ".");
+	}
+
+	return;
+}
+
+void SparseBlockFactorization::solve(int block, double * x) const {
+	const double * v = values.data() + block * colIds.size();
+
+	// L y = x, L has a unit diagonal
+	for (int i = 0; i < size; i++) {
+		double sum = x[i];
+		for (int p = rowPtr[i]; p < diagPtr[i]; p++) {
+			sum -= v[p] * x[colIds[p]];
+		}
+		x[i] = sum;
+	}
+
+	// U x = y
+	for (int i = size - 1; i >= 0; i--) {
+		double sum = x[i];
+		for (int p = diagPtr[i] + 1; p < rowPtr[i + 1]; p++) {
+			sum -= v[p] * x[colIds[p]];
+		}
+		x[i] = sum / v[diagPtr[i]];
+	}
+
+	return;
+}
+
+void SparseBlockFactorization::solveTridiagonal(int n, const double * lower,
+		const double * diag, const double * upper, double * x,
+		double * work) {
+	if (n < 1)
+		return;
+
+	// Forward sweep, work holds the modified superdiagonal
+	double pivot = diag[0];
+	x[0] /= pivot;
+	for (int i = 1; i < n; i++) {
+		work[i - 1] = upper[i - 1] / pivot;
+		pivot = diag[i] - lower[i] * work[i - 1];
+		x[i] = (x[i] - lower[i] * x[i - 1]) / pivot;
+	}
+
+	// Back substitution
+	for (int i = n - 2; i >= 0; i--) {
+		x[i] -= work[i] * x[i + 1];
+	}
+
+	return;
+}
@@ -0,0 +1,143 @@
+#ifndef SPARSEBLOCKFACTORIZATION_H
+#define SPARSEBLOCKFACTORIZATION_H
+
+#include <vector>
+
+namespace xolotlSolver {
+
+/**
+ * This class stores the incomplete LU factorizations of many small sparse
+ * matrices sharing the same nonzero pattern, the reaction blocks of the
+ * Jacobian at each grid point.
+ *
+ * The pattern of the factors is computed once by setPattern() with the
+ * ILU(k) symbolic factorization: a fill-in entry is kept if its level is at
+ * most k, the level of the entries of the matrix being 0. With k = 0 the
+ * factors have the pattern of the matrix, a k larger than the size of the
+ * blocks gives the exact LU factorization. The numeric factorization of a
+ * block then only goes through this fixed pattern, without any allocation.
+ *
+ * No pivoting is done, the diagonal entries are always added to the pattern.
+ */
+class SparseBlockFactorization {
+
+private:
+
+	//! The number of rows of each block
+	int size;
+
+	//! The position of the first entry of each row in the factors
+	std::vector<int> rowPtr;
+
+	//! The sorted column indices of the entries of each row
+	std::vector<int> colIds;
+
+	//! The position of the diagonal entry of each row
+	std::vector<int> diagPtr;
+
+	//! The values of the factors of all the blocks, L without its unit
+	//! diagonal and U are stored together in the pattern
+	std::vector<double> values;
+
+	//! The position in the current row of each column, -1 if it is not in
+	//! the pattern of the row, used by factor()
+	std::vector<int> positions;
+
+public:
+
+	//! The constructor
+	SparseBlockFactorization() :
+			size(0) {
+	}
+
+	/**
+	 * Compute the pattern of the factors. The values of all the blocks are
+	 * discarded.
+	 *
+	 * @param n The number of rows of each block
+	 * @param columns The column indices of the nonzero entries of each row
+	 * of the blocks
+	 * @param levels The maximum level of the fill-in entries
+	 */
+	void setPattern(int n, const std::vector<std::vector<int> > & columns,
+			int levels);
+
+	/**
+	 * Set the number of blocks, their values are set to zero.
+	 *
+	 * @param nBlocks The number of blocks
+	 */
+	void setNumberOfBlocks(int nBlocks);
+
+	/**
+	 * Get the number of rows of each block.
+	 *
+	 * @return The size
+	 */
+	int getSize() const {
+		return size;
+	}
+
+	/**
+	 * Get the number of entries in the pattern of the factors.
+	 *
+	 * @return The number of nonzero entries of one block
+	 */
+	int getNonZeros() const {
+		return colIds.size();
+	}
+
+	/**
+	 * Find the position of an entry in the pattern.
+	 *
+	 * @param row The row
+	 * @param col The column
+	 * @return Its position, -1 if it is not in the pattern
+	 */
+	int find(int row, int col) const;
+
+	/**
+	 * Get the values of a block. Before factor() is called they are the
+	 * entries of the matrix at the positions given by find(), all the other
+	 * ones have to be zero.
+	 *
+	 * @param block The index of the block
+	 * @return The values
+	 */
+	double * getValues(int block) {
+		return values.data() + block * colIds.size();
+	}
+
+	/**
+	 * Factor a block in place. An exception is thrown if a zero pivot is
+	 * found.
+	 *
+	 * @param block The index of the block
+	 */
+	void factor(int block);
+
+	/**
+	 * Solve the system of a factored block in place.
+	 *
+	 * @param block The index of the block
+	 * @param x The right hand side, replaced by the solution
+	 */
+	void solve(int block, double * x) const;
+
+	/**
+	 * Solve a tridiagonal system with the Thomas algorithm.
+	 *
+	 * @param n The number of rows
+	 * @param lower The subdiagonal, lower[0] is ignored
+	 * @param diag The diagonal
+	 * @param upper The superdiagonal, upper[n - 1] is ignored
+	 * @param x The right hand side, replaced by the solution
+	 * @param work A work array of size n
+	 */
+	static void solveTridiagonal(int n, const double * lower,
+			const double * diag, const double * upper, double * x,
+			double * work);
+};
+
+} /* namespace xolotlSolver */
+#endif
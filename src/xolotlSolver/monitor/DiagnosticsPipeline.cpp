@@ -0,0 +1,136 @@
+#include "DiagnosticsPipeline.h"
+#include <algorithm>
+#include <string>
+
+using namespace xolotlSolver;
+
+int DiagnosticsPipeline::addReduction(int size, Kernel kernel, Sink sink,
+		bool needsUpdate) {
+	if (size < 0)
+		throw std::string(
+				"DiagnosticsPipeline Exception: the size of a reduction can't be negative.");
+	if (needsUpdate && !update)
+		throw std::string(
+				"DiagnosticsPipeline Exception: no method was given to update the network.");
+
+	// The values go at the end of the packed buffer
+	Reduction reduction;
+	reduction.offset = localValues.size();
+	reduction.size = size;
+	reduction.valuesPerPoint = 0;
+	reduction.needsUpdate = needsUpdate;
+	reduction.kernel = kernel;
+	reduction.sink = sink;
+	reductions.push_back(reduction);
+
+	localValues.resize(localValues.size() + size, 0.0);
+	globalValues.resize(localValues.size(), 0.0);
+
+	return reduction.offset;
+}
+
+int DiagnosticsPipeline::addProfile(int nPoints, int valuesPerPoint,
+		Kernel kernel, Sink sink, bool needsUpdate) {
+	if (nPoints < 0 || valuesPerPoint < 1)
+		throw std::string(
+				"DiagnosticsPipeline Exception: a profile needs a positive number of values per grid point.");
+	if (needsUpdate && !update)
+		throw std::string(
+				"DiagnosticsPipeline Exception: no method was given to update the network.");
+
+	// The values go at the end of the packed buffer of the profiles
+	Reduction reduction;
+	reduction.offset = localProfiles.size();
+	reduction.size = nPoints * valuesPerPoint;
+	reduction.valuesPerPoint = valuesPerPoint;
+	reduction.needsUpdate = needsUpdate;
+	reduction.kernel = kernel;
+	reduction.sink = sink;
+	reductions.push_back(reduction);
+
+	localProfiles.resize(localProfiles.size() + reduction.size, 0.0);
+	globalProfiles.resize(localProfiles.size(), 0.0);
+
+	return reduction.offset;
+}
+
+void DiagnosticsPipeline::execute(MPI_Comm comm, int xs, int xm,
+		double * const *solutionArray, int timestep, double time) {
+	// Start from zero
+	std::fill(localValues.begin(), localValues.end(), 0.0);
+	std::fill(localProfiles.begin(), localProfiles.end(), 0.0);
+
+	// Is the network needed?
+	bool needsUpdate = false;
+	for (auto const& reduction : reductions) {
+		needsUpdate = needsUpdate || reduction.needsUpdate;
+	}
+
+	// Single sweep over the locally owned grid points
+	for (int xi = xs; xi < xs + xm; xi++) {
+		double *gridPointSolution = solutionArray[xi];
+
+		// Update the network once for all the kernels
+		if (needsUpdate)
+			update(gridPointSolution);
+
+		for (auto const& reduction : reductions) {
+			double *values =
+					reduction.valuesPerPoint ?
+							localProfiles.data() : localValues.data();
+			reduction.kernel(xi, gridPointSolution,
+					values + reduction.offset);
+		}
+	}
+
+	// Sum everything at once
+	if (!localValues.empty()) {
+		MPI_Allreduce(localValues.data(), globalValues.data(),
+				localValues.size(), MPI_DOUBLE, MPI_SUM, comm);
+	}
+
+	// The master process gathers the owned slice of each profile, the
+	// ownership is gathered each time because the grid can be repartitioned
+	int procId = 0;
+	MPI_Comm_rank(comm, &procId);
+	if (!localProfiles.empty()) {
+		int worldSize;
+		MPI_Comm_size(comm, &worldSize);
+		profileCounts.resize(worldSize);
+		profileDisplacements.resize(worldSize);
+		int corners[2] = { xs, xm };
+		std::vector<int> allCorners(procId == 0 ? 2 * worldSize : 0);
+		MPI_Gather(corners, 2, MPI_INT, allCorners.data(), 2, MPI_INT, 0, comm);
+		if (procId == 0)
+			std::fill(globalProfiles.begin(), globalProfiles.end(), 0.0);
+
+		for (auto const& reduction : reductions) {
+			const int vpp = reduction.valuesPerPoint;
+			if (!vpp)
+				continue;
+			if (procId == 0) {
+				for (int i = 0; i < worldSize; i++) {
+					profileDisplacements[i] = reduction.offset
+							+ allCorners[2 * i] * vpp;
+					profileCounts[i] = allCorners[2 * i + 1] * vpp;
+				}
+			}
+			MPI_Gatherv(localProfiles.data() + reduction.offset + xs * vpp,
+					xm * vpp, MPI_DOUBLE, globalProfiles.data(),
+					profileCounts.data(), profileDisplacements.data(),
+					MPI_DOUBLE, 0, comm);
+		}
+	}
+
+	// Hand the values to the sinks
+	for (auto const& reduction : reductions) {
+		if (!reduction.valuesPerPoint)
+			reduction.sink(timestep, time,
+					globalValues.data() + reduction.offset);
+		else if (procId == 0)
+			reduction.sink(timestep, time,
+					globalProfiles.data() + reduction.offset);
+	}
+
+	return;
+}
@@ -0,0 +1,149 @@
+#ifndef DIAGNOSTICSPIPELINE_H
+#define DIAGNOSTICSPIPELINE_H
+
+#include <mpi.h>
+#include <functional>
+#include <vector>
+
+namespace xolotlSolver {
+
+/**
+ * This class computes the reductions requested by the monitors in a single
+ * sweep over the locally owned grid points.
+ *
+ * Each reduction owns a slice of a packed buffer. At each grid point the
+ * network is updated once (if any reduction needs it) and every kernel adds
+ * its contribution to its slice. The whole buffer is then summed over the
+ * processes with one MPI_Allreduce and each slice is handed to its sink.
+ *
+ * Profiles along the grid have their own packed buffer: the kernel writes
+ * the values of a grid point at the index of this grid point and only the
+ * master process, which writes them, receives the profiles, gathered from
+ * the slices owned by each process.
+ */
+class DiagnosticsPipeline {
+
+public:
+
+	//! Adds the contribution of a grid point to the values of a reduction
+	using Kernel = std::function<void(int xi, const double *gridPointSolution,
+			double *values)>;
+
+	//! Receives the reduced values
+	using Sink = std::function<void(int timestep, double time,
+			const double *values)>;
+
+	//! Updates the network from the solution at a grid point
+	using Update = std::function<void(double *gridPointSolution)>;
+
+private:
+
+	/**
+	 * A registered reduction.
+	 */
+	struct Reduction {
+		//! Where its values start in its packed buffer
+		int offset;
+
+		//! The number of values
+		int size;
+
+		//! The number of values per grid point of a profile, 0 for a sum
+		int valuesPerPoint;
+
+		//! Does the kernel read the network?
+		bool needsUpdate;
+
+		Kernel kernel;
+
+		Sink sink;
+	};
+
+	//! The registered reductions, the sinks are called in this order
+	std::vector<Reduction> reductions;
+
+	//! The method updating the network at each grid point
+	Update update;
+
+	//! The local values of all the reductions
+	std::vector<double> localValues;
+
+	//! The values summed over the processes
+	std::vector<double> globalValues;
+
+	//! The local values of all the profiles
+	std::vector<double> localProfiles;
+
+	//! The profiles gathered on the master process
+	std::vector<double> globalProfiles;
+
+	//! The number of values received from each process and where they go
+	std::vector<int> profileCounts, profileDisplacements;
+
+public:
+
+	/**
+	 * The constructor.
+	 *
+	 * @param update The method updating the network at a grid point
+	 */
+	DiagnosticsPipeline(Update update = nullptr) :
+			update(update) {
+	}
+
+	/**
+	 * Register a reduction.
+	 *
+	 * @param size The number of values it sums
+	 * @param kernel The method called at each locally owned grid point
+	 * @param sink The method receiving the values summed over the processes,
+	 * it is called on all the processes
+	 * @param needsUpdate Should the network be updated before the kernel
+	 * is called?
+	 * @return The offset of its values in the packed buffer of the sums
+	 */
+	int addReduction(int size, Kernel kernel, Sink sink,
+			bool needsUpdate = false);
+
+	/**
+	 * Register a profile along the grid. The kernel writes the values of the
+	 * grid point xi from xi * valuesPerPoint.
+	 *
+	 * @param nPoints The number of grid points
+	 * @param valuesPerPoint The number of values at each grid point
+	 * @param kernel The method called at each locally owned grid point
+	 * @param sink The method receiving the whole profile, it is only called
+	 * on the master process
+	 * @param needsUpdate Should the network be updated before the kernel
+	 * is called?
+	 * @return The offset of its values in the packed buffer of the profiles
+	 */
+	int addProfile(int nPoints, int valuesPerPoint, Kernel kernel, Sink sink,
+			bool needsUpdate = false);
+
+	/**
+	 * Is there any reduction to compute?
+	 *
+	 * @return True if nothing was registered
+	 */
+	bool empty() const {
+		return reductions.empty();
+	}
+
+	/**
+	 * Compute all the reductions and hand them to their sinks. It must be
+	 * called by all the processes of the communicator.
+	 *
+	 * @param comm The communicator of the solver
+	 * @param xs The first locally owned grid point
+	 * @param xm The number of locally owned grid points
+	 * @param solutionArray The solution indexed by the global grid point
+	 * @param timestep The current time step
+	 * @param time The current time
+	 */
+	void execute(MPI_Comm comm, int xs, int xm, double * const *solutionArray,
+			int timestep, double time);
+};
+
+} /* namespace xolotlSolver */
+#endif
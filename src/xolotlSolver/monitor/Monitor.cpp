@@ -12,6 +12,8 @@
 #include <iomanip>
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <TelemetrySink.h>
 
 namespace xolotlSolver {
 
@@ -21,6 +23,284 @@ std::shared_ptr<xolotlViz::IPlot> perfPlot;
 //! The variable to store the time at the previous time step.
 double previousTime = 0.0;
 
+//! The sink receiving the time series of the monitors, only on the master process.
+std::shared_ptr<xolotlCore::TelemetrySink> telemetrySink;
+
+//! The number of time steps done by the previous calls to TSSolve.
+PetscInt timeStepOffset = 0;
+
+/**
+ * The context of the monitors added with addMonitor().
+ */
+struct ContinuousMonitor {
+	//! The monitor
+	PetscErrorCode (*monitor)(TS, PetscInt, PetscReal, Vec, void *);
+};
+
+/**
+ * This method calls a monitor with the number of the time step counted from
+ * the beginning of the solve: TSSolve numbers its steps from 0 and is called
+ * again each time the grid is repartitioned. The initial call of such a
+ * TSSolve is skipped because the same step was monitored at the end of the
+ * previous one.
+ */
+PetscErrorCode monitorContinuousSteps(TS ts, PetscInt timestep,
+		PetscReal time, Vec solution, void *ictx) {
+	if (timestep == 0 && timeStepOffset > 0)
+		return 0;
+
+	auto context = (ContinuousMonitor *) ictx;
+	return context->monitor(ts, timestep + timeStepOffset, time, solution,
+			NULL);
+}
+
+/**
+ * This method destroys the context of a monitor added with addMonitor().
+ */
+PetscErrorCode destroyContinuousMonitor(void **ictx) {
+	delete (ContinuousMonitor *) *ictx;
+	*ictx = NULL;
+
+	return 0;
+}
+
+/**
+ * This method adds a monitor to the time stepper. It replaces TSMonitorSet
+ * so that the monitors see continuous time step numbers across the
+ * repartitions of the grid.
+ *
+ * @param ts The time stepper
+ * @param monitor The monitor, it is called without context
+ * @return The PETSc error code
+ */
+PetscErrorCode addMonitor(TS ts,
+		PetscErrorCode (*monitor)(TS, PetscInt, PetscReal, Vec, void *)) {
+	auto context = new ContinuousMonitor { monitor };
+
+	return TSMonitorSet(ts, monitorContinuousSteps, context,
+			destroyContinuousMonitor);
+}
+
+/**
+ * This method sets the number of time steps done by the previous calls to
+ * TSSolve, the next one numbers its steps from there.
+ *
+ * @param offset The number of time steps already done
+ */
+void setTimeStepOffset(PetscInt offset) {
+	timeStepOffset = offset;
+
+	return;
+}
+
+/**
+ * This method adds a table to the telemetry file where the monitors write their
+ * time series, creating the file the first time. Only the master process writes
+ * it. The rows are buffered and written every -telemetry_flush rows (1000 by
+ * default); use telemetryToText to convert the tables to text files.
+ *
+ * @param name The name of the table
+ * @param columns The names of its columns
+ */
+void addTelemetryTable(const std::string& name,
+		const std::vector<std::string>& columns) {
+	int procId;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	if (procId != 0)
+		return;
+
+	// Create the sink the first time
+	if (!telemetrySink) {
+		PetscErrorCode ierr;
+		PetscBool flag;
+		PetscInt flushStride = 1000;
+		ierr = PetscOptionsGetInt(NULL, NULL, "-telemetry_flush", &flushStride,
+				&flag);
+		checkPetscError(ierr,
+				"addTelemetryTable: PetscOptionsGetInt (-telemetry_flush) failed.");
+		if (!flag)
+			flushStride = 1000;
+
+		telemetrySink = std::make_shared<xolotlCore::TelemetrySink>(
+				"xolotlTelemetry.h5", flushStride);
+	}
+
+	telemetrySink->addTable(name, columns);
+
+	return;
+}
+
+/**
+ * This method writes the buffered rows of the telemetry file and closes it.
+ */
+void finalizeTelemetrySink() {
+	telemetrySink.reset();
+
+	return;
+}
+
+/**
+ * This method gathers on the master process the values packed by each process,
+ * with a single collective operation.
+ *
+ * @param localValues The values of this process
+ * @param values The values of all the processes in the rank order, only on the
+ * master process
+ */
+void gatherValues(const std::vector<double>& localValues,
+		std::vector<double>& values) {
+	int procId, worldSize;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
+
+	// Gather the number of values of each process
+	int localSize = localValues.size();
+	std::vector<int> sizes(worldSize, 0), displacements(worldSize, 0);
+	MPI_Gather(&localSize, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0,
+			PETSC_COMM_WORLD);
+
+	// Compute where each slice goes
+	int totalSize = 0;
+	if (procId == 0) {
+		for (int i = 0; i < worldSize; i++) {
+			displacements[i] = totalSize;
+			totalSize += sizes[i];
+		}
+	}
+	values.resize(totalSize);
+
+	// Gather the values
+	MPI_Gatherv(localValues.data(), localSize, MPI_DOUBLE, values.data(),
+			sizes.data(), displacements.data(), MPI_DOUBLE, 0, PETSC_COMM_WORLD);
+
+	return;
+}
+
+//! The range of cluster ids gathered by gatherConcentrations.
+int gatheredFirstId = 0, gatheredLastId = 0;
+
+//! The time step and time of the concentrations gathered by gatherConcentrations.
+PetscInt gatheredTimestep = -1;
+PetscReal gatheredTime = 0.0;
+
+//! The gathered concentrations, only on the master process.
+std::vector<double> gatheredConcentrations;
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "gatherConcentrations")
+/**
+ * This method gathers on the master process the concentrations of a range of
+ * clusters at all the grid points, for the plots. Each process sends its
+ * slice of the grid at once. The gathered concentrations are kept for the
+ * time step so that the plotting monitors called at the same time step don't
+ * gather them again; the gathered range grows to cover all their requests.
+ *
+ * @param da The DMDA of the solution
+ * @param solution The solution
+ * @param timestep The current time step
+ * @param time The current time
+ * @param firstId The index of the first cluster
+ * @param nIds The number of clusters
+ * @param values The concentrations ordered by grid point (x first, then y and
+ * z) then by cluster, only on the master process
+ * @return The PETSc error code
+ */
+PetscErrorCode gatherConcentrations(DM da, Vec solution, PetscInt timestep,
+		PetscReal time, int firstId, int nIds, std::vector<double>& values) {
+	PetscErrorCode ierr;
+	PetscInt xs, xm, ys, ym, zs, zm, Mx, My, Mz, dof;
+
+	PetscFunctionBeginUser;
+
+	// Get the process ID
+	int procId;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+
+	// Get the size of the total grid
+	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, &My, &Mz, PETSC_IGNORE,
+	PETSC_IGNORE, PETSC_IGNORE, &dof, PETSC_IGNORE, PETSC_IGNORE,
+	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE);
+	CHKERRQ(ierr);
+
+	// Extend the range if it doesn't cover the request
+	bool extended = false;
+	if (gatheredLastId == gatheredFirstId) {
+		gatheredFirstId = firstId;
+		gatheredLastId = firstId + nIds;
+		extended = true;
+	} else if (firstId < gatheredFirstId
+			|| firstId + nIds > gatheredLastId) {
+		gatheredFirstId = std::min(gatheredFirstId, firstId);
+		gatheredLastId = std::max(gatheredLastId, firstId + nIds);
+		extended = true;
+	}
+	int nGathered = gatheredLastId - gatheredFirstId;
+
+	// Gather them if it was not done yet at this time step
+	if (extended || timestep != gatheredTimestep || time != gatheredTime) {
+		// Get the corners of the grid
+		ierr = DMDAGetCorners(da, &xs, &ys, &zs, &xm, &ym, &zm);
+		CHKERRQ(ierr);
+
+		// Pack the corners and the concentrations of the local grid points,
+		// they are stored x first in the local part of the vector
+		const PetscScalar *solutionArray;
+		ierr = VecGetArrayRead(solution, &solutionArray);
+		CHKERRQ(ierr);
+		std::vector<double> localValues = { (double) xs, (double) xm,
+				(double) ys, (double) ym, (double) zs, (double) zm };
+		localValues.reserve(6 + xm * ym * zm * nGathered);
+		for (PetscInt p = 0; p < xm * ym * zm; p++) {
+			for (int l = gatheredFirstId; l < gatheredLastId; l++) {
+				localValues.push_back(solutionArray[p * dof + l]);
+			}
+		}
+		ierr = VecRestoreArrayRead(solution, &solutionArray);
+		CHKERRQ(ierr);
+
+		// Gather everything on the master process
+		std::vector<double> allValues;
+		gatherValues(localValues, allValues);
+
+		// Place the slices of each process on the full grid
+		if (procId == 0) {
+			gatheredConcentrations.assign(Mx * My * Mz * nGathered, 0.0);
+			auto it = allValues.begin();
+			while (it != allValues.end()) {
+				PetscInt pxs = *it++, pxm = *it++, pys = *it++, pym = *it++,
+						pzs = *it++, pzm = *it++;
+				for (PetscInt k = pzs; k < pzs + pzm; k++) {
+					for (PetscInt j = pys; j < pys + pym; j++) {
+						for (PetscInt i = pxs; i < pxs + pxm; i++) {
+							std::copy(it, it + nGathered,
+									gatheredConcentrations.begin()
+											+ ((k * My + j) * Mx + i)
+													* nGathered);
+							it += nGathered;
+						}
+					}
+				}
+			}
+		}
+
+		gatheredTimestep = timestep;
+		gatheredTime = time;
+	}
+
+	// Copy the requested range
+	if (procId == 0) {
+		values.resize(Mx * My * Mz * nIds);
+		for (PetscInt p = 0; p < Mx * My * Mz; p++) {
+			for (int l = 0; l < nIds; l++) {
+				values[p * nIds + l] = gatheredConcentrations[p * nGathered
+						+ firstId - gatheredFirstId + l];
+			}
+		}
+	}
+
+	PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorTime")
 /**
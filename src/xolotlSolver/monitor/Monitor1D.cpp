@@ -17,6 +17,8 @@
 #include <vector>
 #include <memory>
 #include <HDF5Utils.h>
+#include <TelemetrySink.h>
+#include <DiagnosticsPipeline.h>
 #include <NESuperCluster.h>
 #include <PSISuperCluster.h>
 #include <NEClusterReactionNetwork.h>
@@ -32,10 +34,20 @@ namespace xolotlSolver
                                        Vec solution, void* ictx );
  extern PetscErrorCode monitorPerf( TS ts, PetscInt timestep, PetscReal time,
                                     Vec solution, void* ictx );
+ extern PetscErrorCode addMonitor( TS ts, PetscErrorCode (*monitor)( TS, PetscInt,
+                                 PetscReal, Vec, void* ) );
+ extern void gatherValues( const std::vector<double>& localValues,
+                           std::vector<double>& values );
+ extern PetscErrorCode gatherConcentrations( DM da, Vec solution, PetscInt timestep,
+                                             PetscReal time, int firstId, int nIds,
+                                             std::vector<double>& values );
+ extern void addTelemetryTable( const std::string& name,
+                                const std::vector<std::string>& columns );
 
 // Declaration of the variables defined in Monitor.cpp
  extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
  extern double previousTime;
+ extern std::shared_ptr<xolotlCore::TelemetrySink> telemetrySink;
 
 //! The pointer to the plot used in monitorScatter1D.
  std::shared_ptr<xolotlViz::IPlot> scatterPlot1D;
@@ -79,6 +91,9 @@ namespace xolotlSolver
 // Becomes false once it is printed.
  bool printMaxClusterConc1D = true;
   
+// The pipeline computing the reductions of the monitors in a single sweep
+ std::shared_ptr<DiagnosticsPipeline> diagnostics1D;
+
 // Declare the vector that will store all species ids 
  std::vector<int> speciesId1D;
 // Declare the vector that will store the names of all species 
@@ -107,14 +122,6 @@ namespace xolotlSolver
 // Update the previous time
   hdf5Previous1D++;
 
-// Get the number of processes
-  int worldSize;
-  MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-// Gets the process ID (important when it is running in parallel)
-  int procId;
-  MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
 // Get the da from ts
   DM da;
   ierr = TSGetDM(ts, &da);
@@ -144,679 +151,513 @@ namespace xolotlSolver
 // Get the position of the surface
   int surfacePos = solverHandler->getSurfacePosition();
 
-// Open the already created HDF5 file
-  xolotlCore::HDF5Utils::openFile(hdf5OutputName1D);
-
 // Get the current time step
   double currentTimeStep;
   ierr = TSGetTimeStep(ts, &currentTimeStep);
   CHKERRQ(ierr);
 
-// Add a concentration sub group
-  xolotlCore::HDF5Utils::addConcentrationSubGroup( timestep, time,
-                                                   previousTime, currentTimeStep );
-
-// Write the surface positions and the associated interstitial quantities
-// in the concentration sub group
-  xolotlCore::HDF5Utils::writeSurface1D( timestep, surfacePos, nInterstitial1D,
-			                 previousIFlux1D );
-
-// Loop on the full grid
-  for (PetscInt i = 0; i < Mx; i++) 
+// Get the non-zero concentrations of the locally owned grid points
+  std::vector<double> concArray;
+  std::vector<int> concSizes;
+  for (PetscInt i = xs; i < xs + xm; i++) 
   {
-// Wait for all the processes
-   MPI_Barrier(PETSC_COMM_WORLD);
-// Size of the concentration that will be stored
-   int concSize = -1;
-// Vector for the concentrations
-   std::vector<std::vector<double> > concVector;
-
-// If it is the locally owned part of the grid
-   if (i >= xs && i < xs + xm) 
-   {
 // Get the pointer to the beginning of the solution data for this grid point
-    gridPointSolution = solutionArray[i];
+   gridPointSolution = solutionArray[i];
 
 // Loop on the concentrations
-    concVector.clear();
-    for (int l = 0; l < dof; l++) 
-    {
-     if (gridPointSolution[l] > 1.0e-16 || gridPointSolution[l] < -1.0e-16) 
-     {
-// Create the concentration vector for this cluster
-      std::vector<double> conc;
-      conc.push_back((double) l);
-      conc.push_back(gridPointSolution[l]);
-// Add it to the main vector
-      concVector.push_back(conc);
-     }
-    }
-
-// Send the size of the vector to the other processes
-    concSize = concVector.size();
-// Loop on all the processes
-    for (int l = 0; l < worldSize; l++) 
+   int concSize = 0;
+   for (int l = 0; l < dof; l++) 
+   {
+    if (gridPointSolution[l] > 1.0e-16 || gridPointSolution[l] < -1.0e-16) 
     {
-// Skip its own
-     if (l == procId) continue;
-
-// Send the size
-     MPI_Send(&concSize, 1, MPI_INT, l, 0, PETSC_COMM_WORLD);
+// Add the index and concentration of this cluster
+     concArray.push_back((double) l);
+     concArray.push_back(gridPointSolution[l]);
+     concSize++;
     }
    }
-// Else: only receive the conc size
-   else 
-   {
-    MPI_Recv(&concSize, 1, MPI_INT, MPI_ANY_SOURCE, 0, PETSC_COMM_WORLD,
-             MPI_STATUS_IGNORE);
-   }
-// Skip the grid point if the size is 0
-   if (concSize == 0) continue;
-// All processes must create the dataset
-   xolotlCore::HDF5Utils::addConcentrationDataset(concSize, i);
-
-// If it is the locally owned part of the grid
-   if (i >= xs && i < xs + xm) 
-   {
-// Fill the dataset
-    xolotlCore::HDF5Utils::fillConcentrations(concVector, i);
-   }
+   concSizes.push_back(concSize);
   }
 
-// Finalize the HDF5 file
-  xolotlCore::HDF5Utils::closeFile();
-
 // Restore the solutionArray
   ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
   CHKERRQ(ierr);
 
+// Open the already created HDF5 file
+  auto file = xolotlCore::HDF5Utils::openFile(hdf5OutputName1D, PETSC_COMM_WORLD);
+
+// Add a concentration sub group
+  xolotlCore::HDF5Utils::addConcentrationSubGroup( file, timestep, time,
+                                                   previousTime, currentTimeStep );
+
+// Write the surface positions and the associated interstitial quantities
+// in the concentration sub group
+  xolotlCore::HDF5Utils::writeSurface1D( file, timestep, surfacePos, nInterstitial1D,
+                                         previousIFlux1D );
+
+// All processes write their part of the grid at once
+  xolotlCore::HDF5Utils::writeConcentrations(file, concArray, concSizes,
+                                             Mx, xs, xm);
+
+// Finalize the HDF5 file
+  xolotlCore::HDF5Utils::closeFile(file);
+
   PetscFunctionReturn(0);
 
  } // end PetscErrorCode startStop1D( )
 
 //--------------------------------------------------------------------------------
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeHeliumRetention1D")
 /**
- * This is a monitoring method that will compute the helium retention
+ * This method registers the helium retention in the diagnostics pipeline.
  */
- PetscErrorCode 
- computeHeliumRetention1D( TS ts, PetscInt, PetscReal time, Vec solution, void* ) 
+ void
+ addHeliumRetention1D( DiagnosticsPipeline& pipeline )
  {
-// Initial declarations
-  PetscErrorCode ierr;
-  PetscInt xs, xm;
-
-  PetscFunctionBeginUser;
-
 // Get the solver handler
   auto solverHandler = PetscSolver::getSolverHandler();
 
-// Get the flux handler that will be used to know the fluence
-  auto fluxHandler = solverHandler->getFluxHandler();
-
-// Get the da from ts
-  DM da;
-  ierr = TSGetDM(ts, &da);
-  CHKERRQ(ierr);
-
-// Get the corners of the grid
-  ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-  CHKERRQ(ierr);
+// Create its table in the telemetry file
+  addTelemetryTable( "heliumRetention", { "time", "fluence", "retention", "concentration", "meanHeliumSize" } );
 
 // Get the physical grid
   auto grid = solverHandler->getXGrid();
-// Get the position of the surface
-  int surfacePos = solverHandler->getSurfacePosition();
 
-// Get the network
-  auto network = solverHandler->getNetwork();
 // Get all the super clusters
-  auto superClusters = network->getAll(PSISuperType);
+  auto superClusters = solverHandler->getNetwork()->getAll(PSISuperType);
 
-// Get the array of concentration
-  PetscReal** solutionArray;
-  ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
-
-// Store the concentration over the grid
-  double heConcentration = 0.0, bubbleConcentration = 0.0;
-
-// Declare the pointer for the concentrations at a specific grid point
-  PetscReal* gridPointSolution;
-
-// Loop on the grid
-  for (PetscInt xi = xs; xi < xs + xm; xi++) 
-  {
+// The helium and bubble concentrations are summed over the grid
+  pipeline.addReduction( 2,
+   [=] (int xi, const double* gridPointSolution, double* values)
+   {
 // Boundary conditions
-   if (xi <= surfacePos || xi == grid.size() - 1) continue;
-
-// Get the pointer to the beginning of the solution data for this grid point
-   gridPointSolution = solutionArray[xi];
-
-// Update the concentration in the network
-   network->updateConcentrationsFromArray(gridPointSolution);
+    int surfacePos = solverHandler->getSurfacePosition();
+    if (xi <= surfacePos || xi == grid.size() - 1) return;
 
 // Loop on all the indices
-   for (unsigned int l = 0; l < indices1D.size(); l++) 
-   {
+    for (unsigned int l = 0; l < indices1D.size(); l++)
+    {
 // Add the current concentration times the number of helium in the cluster
 // (from the weight vector)
-    heConcentration += gridPointSolution[indices1D[l]] * weights1D[l]
-                       * (grid[xi] - grid[xi - 1]);
-    bubbleConcentration += gridPointSolution[indices1D[l]]
-                       * (grid[xi] - grid[xi - 1]);
-   }
+     values[0] += gridPointSolution[indices1D[l]] * weights1D[l]
+                  * (grid[xi] - grid[xi - 1]);
+     values[1] += gridPointSolution[indices1D[l]]
+                  * (grid[xi] - grid[xi - 1]);
+    }
 
-// Loop on all the super clusters
-   for (int l = 0; l < superClusters.size(); l++) 
+// Loop on all the super clusters, the network was updated at this grid point
+    for (int l = 0; l < superClusters.size(); l++)
+    {
+     auto cluster = (xolotlCore::PSISuperCluster *) superClusters[l];
+     values[0] += cluster->getTotalHeliumConcentration()
+                  * (grid[xi] - grid[xi - 1]);
+     values[1] += cluster->getTotalConcentration()
+                  * (grid[xi] - grid[xi - 1]);
+    }
+   },
+   [=] (int, double time, const double* values)
    {
-    auto cluster = (xolotlCore::PSISuperCluster *) superClusters[l];
-    heConcentration += cluster->getTotalHeliumConcentration()
-                       * (grid[xi] - grid[xi - 1]);
-    bubbleConcentration += cluster->getTotalConcentration()
-                           * (grid[xi] - grid[xi - 1]);
-   }
-  }
+// Only the master process writes
+    int procId;
+    MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+    if (procId != 0) return;
 
-// Get the current process ID
-  int procId;
-  MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+    double totalHeConcentration = values[0];
+    double totalBubbleConcentration = values[1];
 
-// Sum all the concentrations through MPI reduce
-  double totalHeConcentration = 0.0;
-  MPI_Reduce(&heConcentration, &totalHeConcentration, 1, MPI_DOUBLE, MPI_SUM,
-             0, PETSC_COMM_WORLD);
-  double totalBubbleConcentration = 0.0;
-  MPI_Reduce(&bubbleConcentration, &totalBubbleConcentration, 1, MPI_DOUBLE,
-  MPI_SUM, 0, MPI_COMM_WORLD);
-
-// Master process
-  if (procId == 0) 
-  {
 // Get the fluence
-   double heliumFluence = fluxHandler->getFluence();
+    double heliumFluence = solverHandler->getFluxHandler()->getFluence();
 
 // Print the result
-   std::cout << "\nTime: " << time << std::endl;
-   std::cout << "Helium retention = "
-             << 100.0 * (totalHeConcentration / heliumFluence) << " %"
-             << std::endl;
-   std::cout << "Helium concentration = " << totalHeConcentration
-             << std::endl;
-   std::cout << "Helium fluence = " << heliumFluence << "\n" << std::endl;
-
-// Uncomment to write the retention and the fluence in a file
-   std::ofstream outputFile;
-   outputFile.open("retentionOut.txt", ios::app);
-   outputFile << heliumFluence << " "
-              << 100.0 * (totalHeConcentration / heliumFluence) << " "
-              << totalHeConcentration << " "
-              << totalHeConcentration / totalBubbleConcentration << std::endl;
-   outputFile.close();
-  }
+    std::cout << "\nTime: " << time << std::endl;
+    std::cout << "Helium retention = "
+              << 100.0 * (totalHeConcentration / heliumFluence) << " %"
+              << std::endl;
+    std::cout << "Helium concentration = " << totalHeConcentration
+              << std::endl;
+    std::cout << "Helium fluence = " << heliumFluence << "\n" << std::endl;
 
-// Restore the solutionArray
-  ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
+// Write the retention and the fluence in the telemetry file
+    telemetrySink->append( "heliumRetention", { time, heliumFluence,
+                           100.0 * (totalHeConcentration / heliumFluence),
+                           totalHeConcentration,
+                           totalHeConcentration / totalBubbleConcentration } );
+   }, true );
 
-  PetscFunctionReturn(0);
+  return;
 
- } // end PetscErrorCode computeHeliumRetention1D( )
+ } // end void addHeliumRetention1D( )
 
 //--------------------------------------------------------------------------------
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeXenonRetention1D")
 /**
- * This is a monitoring method that will compute the xenon retention
+ * This method registers the xenon retention in the diagnostics pipeline.
  */
- PetscErrorCode 
- computeXenonRetention1D( TS ts, PetscInt, PetscReal time, Vec solution, void* ) 
+ void
+ addXenonRetention1D( DiagnosticsPipeline& pipeline )
  {
-// Initial declarations
-  PetscErrorCode ierr;
-  PetscInt xs, xm;
-
-  PetscFunctionBeginUser;
-
 // Get the solver handler
   auto solverHandler = PetscSolver::getSolverHandler();
 
-// Get the flux handler that will be used to get the fluence
-  auto fluxHandler = solverHandler->getFluxHandler();
-
-// Get the da from ts
-  DM da;
-  ierr = TSGetDM(ts, &da);
-  CHKERRQ(ierr);
-
-// Get the corners of the grid
-  ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-  CHKERRQ(ierr);
+// Create its table in the telemetry file
+  addTelemetryTable( "xenonRetention", { "time", "retention", "concentration", "notRetained", "meanRadius" } );
 
 // Get the physical grid
   auto grid = solverHandler->getXGrid();
-// Get the position of the surface
-  int surfacePos = solverHandler->getSurfacePosition();
 
-// Get the network
-  auto network = solverHandler->getNetwork();
 // Get all the super clusters
-  auto superClusters = network->getAll(NESuperType);
-
-// Get the array of concentration
-  PetscReal **solutionArray;
-  ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
-
-// Store the concentration and other values over the grid
-  double xeConcentration = 0.0, bubbleConcentration = 0.0, radii = 0.0;
+  auto superClusters = solverHandler->getNetwork()->getAll(NESuperType);
 
-// Declare the pointer for the concentrations at a specific grid point
-  PetscReal *gridPointSolution;
-
-// Loop on the grid
-  for (PetscInt xi = xs; xi < xs + xm; xi++) 
-  {
+// The xenon and bubble concentrations and the radii are summed over the grid
+  pipeline.addReduction( 3,
+   [=] (int xi, const double* gridPointSolution, double* values)
+   {
 // Boundary conditions
-   if (xi <= surfacePos || xi == grid.size() - 1) continue;
-
-// Get the pointer to the beginning of the solution data for this grid point
-   gridPointSolution = solutionArray[xi];
-
-// Update the concentration in the network
-   network->updateConcentrationsFromArray(gridPointSolution);
+    int surfacePos = solverHandler->getSurfacePosition();
+    if (xi <= surfacePos || xi == grid.size() - 1) return;
 
 // Loop on all the indices
-   for (unsigned int i = 0; i < indices1D.size(); i++) 
-   {
+    for (unsigned int i = 0; i < indices1D.size(); i++)
+    {
 // Add the current concentration times the number of xenon in the cluster
 // (from the weight vector)
-    xeConcentration += gridPointSolution[indices1D[i]] * weights1D[i]
-                       * (grid[xi] - grid[xi - 1]);
-    bubbleConcentration += gridPointSolution[indices1D[i]]
-                           * (grid[xi] - grid[xi - 1]);
-    radii += gridPointSolution[indices1D[i]] * radii1D[i]
-             * (grid[xi] - grid[xi - 1]);
-   }
+     values[0] += gridPointSolution[indices1D[i]] * weights1D[i]
+                  * (grid[xi] - grid[xi - 1]);
+     values[1] += gridPointSolution[indices1D[i]]
+                  * (grid[xi] - grid[xi - 1]);
+     values[2] += gridPointSolution[indices1D[i]] * radii1D[i]
+                  * (grid[xi] - grid[xi - 1]);
+    }
 
-// Loop on all the super clusters
-   for (int i = 0; i < superClusters.size(); i++) 
+// Loop on all the super clusters, the network was updated at this grid point
+    for (int i = 0; i < superClusters.size(); i++)
+    {
+     auto cluster = (xolotlCore::NESuperCluster *) superClusters[i];
+     values[0] += cluster->getTotalXenonConcentration()
+                  * (grid[xi] - grid[xi - 1]);
+     values[1] += cluster->getTotalConcentration()
+                  * (grid[xi] - grid[xi - 1]);
+     values[2] += cluster->getTotalConcentration()
+                  * cluster->getReactionRadius() * (grid[xi] - grid[xi - 1]);
+    }
+   },
+   [=] (int, double time, const double* values)
    {
-    auto cluster = (xolotlCore::NESuperCluster *) superClusters[i];
-    xeConcentration += cluster->getTotalXenonConcentration()
-                       * (grid[xi] - grid[xi - 1]);
-    bubbleConcentration += cluster->getTotalConcentration()
-                           * (grid[xi] - grid[xi - 1]);
-    radii += cluster->getTotalConcentration()
-             * cluster->getReactionRadius() * (grid[xi] - grid[xi - 1]);
-   }
-  }
+// Only the master process writes
+    int procId;
+    MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+    if (procId != 0) return;
 
-// Get the current process ID
-  int procId;
-  MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+    double totalXeConcentration = values[0];
+    double totalBubbleConcentration = values[1];
+    double totalRadii = values[2];
 
-// Sum all the concentrations through MPI reduce
-  double totalXeConcentration = 0.0;
-  MPI_Reduce(&xeConcentration, &totalXeConcentration, 1, MPI_DOUBLE, MPI_SUM,
-             0, PETSC_COMM_WORLD);
-  double totalBubbleConcentration = 0.0;
-  MPI_Reduce(&bubbleConcentration, &totalBubbleConcentration, 1, MPI_DOUBLE,
-  MPI_SUM, 0, MPI_COMM_WORLD);
-  double totalRadii = 0.0;
-  MPI_Reduce(&radii, &totalRadii, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-
-// Master process
-  if (procId == 0) 
-  {
 // Get the fluence
-   double fluence = fluxHandler->getFluence();
+    double fluence = solverHandler->getFluxHandler()->getFluence();
 
 // Print the result
-   std::cout << "\nTime: " << time << std::endl;
-   std::cout << "Xenon retention = "
-             << 100.0 * (totalXeConcentration / fluence) << " %"
-             << std::endl;
-   std::cout << "Xenon concentration = " << totalXeConcentration
-             << std::endl << std::endl;
-
-// Uncomment to write the retention and the fluence in a file
-   std::ofstream outputFile;
-   outputFile.open("retentionOut.txt", ios::app);
-   outputFile << time << " " << 100.0 * (totalXeConcentration / fluence)
-              << " " << totalXeConcentration << " "
-              << fluence - totalXeConcentration << " "
-              << totalRadii / totalBubbleConcentration << std::endl;
-   outputFile.close();
+    std::cout << "\nTime: " << time << std::endl;
+    std::cout << "Xenon retention = "
+              << 100.0 * (totalXeConcentration / fluence) << " %"
+              << std::endl;
+    std::cout << "Xenon concentration = " << totalXeConcentration
+              << std::endl << std::endl;
 
-// Restore the solutionArray
-   ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-   CHKERRQ(ierr);
+// Write the retention and the fluence in the telemetry file
+    telemetrySink->append( "xenonRetention", { time,
+                           100.0 * (totalXeConcentration / fluence),
+                           totalXeConcentration, fluence - totalXeConcentration,
+                           totalRadii / totalBubbleConcentration } );
+   }, true );
 
-   PetscFunctionReturn(0);
-  }
+  return;
 
- } // PetscErrorCode computeXenonRetention1D( )
+ } // end void addXenonRetention1D( )
 
 //--------------------------------------------------------------------------------
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeHeliumConc1D")
 /**
- * This is a monitoring method that will compute the helium concentrations
+ * This method registers the helium concentrations as a function of the helium
+ * size and the depth in the diagnostics pipeline.
  */
- PetscErrorCode 
- computeHeliumConc1D( TS ts, PetscInt timestep, PetscReal time, Vec solution, void* ictx )
+ void
+ addHeliumConc1D( DiagnosticsPipeline& pipeline )
  {
-// Initial declarations
-  PetscErrorCode ierr;
-  PetscInt xs, xm;
-
-  PetscFunctionBeginUser;
-
-// Get the number of processes
-  int worldSize;
-  MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-// Gets the process ID
-  int procId;
-  MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
 // Get the solver handler
   auto solverHandler = PetscSolver::getSolverHandler();
 
-// Get the da from ts
-  DM da;
-  ierr = TSGetDM( ts, &da );
-  CHKERRQ(ierr);
+// Create its table in the telemetry file
+  addTelemetryTable( "heliumConc", { "timestep", "time", "x", "heliumSize", "concentration" } );
 
-// Get the corners of the grid
-  ierr = DMDAGetCorners( da, &xs, NULL, NULL, &xm, NULL, NULL );
-  CHKERRQ(ierr);
-
-// Get the physical grid in the x direction
+// Get the physical grid
   auto grid = solverHandler->getXGrid();
+  int xSize = grid.size();
 
-// Get the network
-  auto network = solverHandler->getNetwork();
-// Get all the super clusters
-  auto superClusters = network->getAll( PSISuperType );
-
-// Get the position of the surface
-  int surfacePos = solverHandler->getSurfacePosition();
-
-// Get the total size of the grid
-  PetscInt Mx;
-  ierr = DMDAGetInfo( da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-                      PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-                      PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-                      PETSC_IGNORE );
-  CHKERRQ(ierr);
-
-// Get the array of concentration
-  double** solutionArray;
-  double*  gridPointSolution;
-  ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
-
-// Create the vectors that will hold the concentrations
-// as a function of helium size
-  std::vector<double> heConcLocal;
-  std::vector<double> heConcentrations;
-  int maxSize = 1001;  // vfda: why this is hard coded ?
-// Initialize
-  for (int i = 0; i < maxSize; i++) 
-  {
-   heConcLocal.push_back(0.0);
-   heConcentrations.push_back(0.0);
-  }
-
-// Open the file
-
-  std::ofstream outputFile;
-
-  if (procId == 0) 
+// The concentrations are stored up to the largest helium size
+  int maxSize = 1;
+  for (int l = 0; l < weights1D.size(); l++)
   {
-   assert( timeStep <= 9999 ); // fix the field width below setw(4) upon change
-   std::stringstream name;
-   name << "heliumConc_" << setfill('0') << setw(4) << timestep << ".dat";
-   outputFile.open(name.str());
-   outputFile << time << std::endl;
+   maxSize = std::max(maxSize, weights1D[l] + 1);
   }
 
-// Loop on the full grid
-  for ( PetscInt xi = surfacePos; xi < Mx; xi++ ) 
-  {
-// Wait for everybody at each grid point
-   MPI_Barrier( PETSC_COMM_WORLD );
-
-// Set x
-   double x = grid[xi];
-
-// If we are on the right process
-// xs is pointer to the leftmost grid point;
-// xm is total number of points in this process
-   if ( xi >= xs && xi < xs + xm ) 
+// One value per helium size at each grid point
+  pipeline.addProfile( xSize, maxSize,
+   [=] (int xi, const double* gridPointSolution, double* values)
    {
-// Get the pointer to the beginning of the solution data for this grid point
-    gridPointSolution = solutionArray[ xi ];
-
-// related to superclusters
-// Update the concentration in the network
-//    network->updateConcentrationsFromArray( gridPointSolution );
+    if (xi < solverHandler->getSurfacePosition()) return;
 
 // Loop on all the indices
-    for (int l = 0; l < indices1D.size(); l++) 
+    for (int l = 0; l < indices1D.size(); l++)
     {
 // Add the current concentration
-     heConcLocal[ weights1D[l] ] += gridPointSolution[ indices1D[l] ];
+     values[xi * maxSize + weights1D[l]] += gridPointSolution[indices1D[l]];
     }
-
-// superclusters
-// Loop on the super clusters (vfda: what is a super cluster?)
-//    for (int l = 0; l < superClusters.size(); l++) 
-//    {
-// Get the super cluster
-//     auto superCluster = (PSISuperCluster *) superClusters[l];
-// Get its boundaries
-//     auto boundaries = superCluster->getBoundaries();
-// Is it the right one?
-//     for (int i = boundaries[0]; i <= boundaries[1]; i++) 
-//     {
-//      for (int j = boundaries[2]; j <= boundaries[3]; j++) 
-//      {
-//       heConcLocal[i] += superCluster->getConcentration(
-//                                       superCluster->getHeDistance(i), 
-//                                       superCluster->getVDistance(j) ) 
-//                         * (grid[xi] - grid[xi - 1]);
-//      }
-//     }
-//    }
- 
-   }
-
-// Gather all the data
-   for (int i = 0; i < maxSize; i++) 
+   },
+   [=] (int timestep, double time, const double* values)
    {
-    MPI_Reduce( &heConcLocal[i], &heConcentrations[i], 1, MPI_DOUBLE,
-                MPI_SUM, 0, PETSC_COMM_WORLD );
-   }
-
-// Print it from the main proc
-   if (procId == 0) 
-   {
-    for (int i = 0; i < maxSize; i++)  // vfda: careful here: loop over maxSize!!
+// Loop on the full grid
+    for (int xi = solverHandler->getSurfacePosition(); xi < xSize; xi++)
     {
-     if (heConcentrations[i] > 1.0e-16) 
+     for (int i = 0; i < maxSize; i++)
      {
-      outputFile << x << " " << i << " " << heConcentrations[i]
-                 << std::endl;
+      if (values[xi * maxSize + i] > 1.0e-16)
+      {
+       telemetrySink->append( "heliumConc", { (double) timestep, time, grid[xi],
+                              (double) i, values[xi * maxSize + i] } );
+      }
      }
     }
-   }
+   } );
 
+  return;
 
-// Reinitialize the concentrations
-   for (int i = 0; i < maxSize; i++) 
-   {
-    heConcLocal[i]      = 0.0;
-    heConcentrations[i] = 0.0;
-   }
+ } // end void addHeliumConc1D( )
 
+//--------------------------------------------------------------------------------
+/**
+ * This method registers the cumulative distribution of helium in the
+ * diagnostics pipeline.
+ */
+ void
+ addCumulativeHelium1D( DiagnosticsPipeline& pipeline )
+ {
+// Get the solver handler
+  auto solverHandler = PetscSolver::getSolverHandler();
 
-  } // end for ( PetscInt xi = surfacePos; xi < Mx; xi++ ) 
+// Create its table in the telemetry file
+  addTelemetryTable( "heliumCumul", { "timestep", "depth", "cumulativeHelium" } );
 
-// Close the file
-  outputFile.close();
+// Get the network
+  auto network = solverHandler->getNetwork();
 
-// Restore the solutionArray
-  ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
+// Get the physical grid and its length
+  auto grid = solverHandler->getXGrid();
+  int xSize = grid.size();
 
-  PetscFunctionReturn(0);
+// The helium concentration at each grid point
+  pipeline.addProfile( xSize, 1,
+   [=] (int xi, const double*, double* values)
+   {
+    if (xi < solverHandler->getSurfacePosition() || xi == 0) return;
+
+// Get the total helium concentration at this grid point
+    values[xi] = network->getTotalAtomConcentration() * (grid[xi] - grid[xi - 1]);
+   },
+   [=] (int timestep, double, const double* values)
+   {
+// Compute the cumulative value over the entire grid
+    int surfacePos = solverHandler->getSurfacePosition();
+    double heConcentration = 0.0;
+    for (int xi = surfacePos; xi < xSize; xi++)
+    {
+     heConcentration += values[xi];
+     telemetrySink->append( "heliumCumul", { (double) timestep,
+                            grid[xi] - grid[surfacePos], heConcentration } );
+    }
+   }, true );
+
+  return;
+
+ } // end void addCumulativeHelium1D( )
 
- } // PetscErrorCode computeHeliumConc1D( )
-  
 //--------------------------------------------------------------------------------
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "showAllSpeciesConc1D")
 /**
- * This is a monitoring method that will compute the helium concentrations
+ * This method registers the data to send to TRIDYN in the diagnostics pipeline.
  */
- PetscErrorCode 
- showAllSpeciesConc1D( TS ts, PetscInt timestep, PetscReal time, Vec solution, void* ictx )
+ void
+ addTRIDYN1D( DiagnosticsPipeline& pipeline )
  {
-// Initial declarations
-  PetscErrorCode ierr;
-  PetscInt xs, xm;
-
-  PetscFunctionBeginUser;
-
-// Get the number of processes
-  int worldSize;
-  MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-// Gets the process ID
-  int procId;
-  MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
 // Get the solver handler
   auto solverHandler = PetscSolver::getSolverHandler();
 
-// Get the da from ts
-  DM da;
-  ierr = TSGetDM( ts, &da );
-  CHKERRQ(ierr);
-
-// Get the corners of the grid
-  ierr = DMDAGetCorners( da, &xs, NULL, NULL, &xm, NULL, NULL );
-  CHKERRQ(ierr);
-
-// Get the physical grid in the x direction
-  auto grid = solverHandler->getXGrid();
+// Create its table in the telemetry file
+  addTelemetryTable( "TRIDYN", { "timestep", "depth", "helium", "vacancy", "interstitial" } );
 
 // Get the network
   auto network = solverHandler->getNetwork();
 
-// Get the position of the surface
-  int surfacePos = solverHandler->getSurfacePosition();
+// Get the physical grid and its length
+  auto grid = solverHandler->getXGrid();
+  int xSize = grid.size();
 
-// Get the total size of the grid
-  PetscInt Mx;
-  ierr = DMDAGetInfo( da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-                      PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-                      PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-                      PETSC_IGNORE );
-  CHKERRQ(ierr);
+// The helium, vacancy, and interstitial concentrations at each grid point
+  pipeline.addProfile( xSize, 3,
+   [=] (int xi, const double*, double* values)
+   {
+    if (xi < solverHandler->getSurfacePosition()) return;
 
-// Get the array of concentration
-  double** solutionArray;
-  double*  gridPointSolution;
-  ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
+    values[3 * xi] = network->getTotalAtomConcentration();
+    values[3 * xi + 1] = network->getTotalVConcentration();
+    values[3 * xi + 2] = network->getTotalIConcentration();
+   },
+   [=] (int timestep, double, const double* values)
+   {
+// Loop on the entire grid
+    int surfacePos = solverHandler->getSurfacePosition();
+    for (int xi = surfacePos; xi < xSize; xi++)
+    {
+     telemetrySink->append( "TRIDYN", { (double) timestep,
+                            grid[xi] - grid[surfacePos], values[3 * xi],
+                            values[3 * xi + 1], values[3 * xi + 2] } );
+    }
+   }, true );
 
-// Vector to hold the concentration of all species at a mesh point
-  int nSpecies = network->size();
-  std::vector<double> conc_meshPt(nSpecies, 0.0);
+  return;
 
-// Open the file
+ } // end void addTRIDYN1D( )
 
-  std::ofstream outputFile;
+//--------------------------------------------------------------------------------
+/**
+ * This method registers the mean helium size as a function of depth in the
+ * diagnostics pipeline.
+ */
+ void
+ addMeanSize1D( DiagnosticsPipeline& pipeline )
+ {
+// Get the solver handler
+  auto solverHandler = PetscSolver::getSolverHandler();
 
-  if (procId == 0) 
-  {
-   assert( timeStep <= 9999 ); // fix the field width below setw(4) upon change
-   std::stringstream name;
-   name << "speciesConc_" << setfill('0') << setw(4) << timestep << ".dat";
-   outputFile.open(name.str());
-   outputFile << time << std::endl;
-   outputFile.close();
-  }
+// Create its table in the telemetry file
+  addTelemetryTable( "heliumSizeMean", { "timestep", "x", "meanHeliumSize" } );
 
-// All processes loop on the entire grid
-  for ( PetscInt xi = surfacePos; xi < Mx; xi++ ) 
-  {
-// Wait for everybody at each grid point
-   MPI_Barrier( PETSC_COMM_WORLD );
+// Get all the super clusters
+  auto superClusters = solverHandler->getNetwork()->getAll(PSISuperType);
 
-// Set x
-   double x = grid[xi];
+// Get the physical grid
+  auto grid = solverHandler->getXGrid();
+  int xSize = grid.size();
 
-// Only one process will pass this test:
-//      xs is pointer to the leftmost grid point in this process;
-//      xm is total number of points in this process
-   if ( xi >= xs && xi < xs + xm )  // grid partition on this process
+// The total concentration and helium at each grid point
+  pipeline.addProfile( xSize, 2,
+   [=] (int xi, const double* gridPointSolution, double* values)
    {
-// Get the pointer to the beginning of the solution data for this grid point
-    gridPointSolution = solutionArray[ xi ];
+// Initialize the total helium and concentration before looping
+    double concTot = 0.0, heliumTot = 0.0;
 
-// Loop on all the species ids 
-    for (int l = 0; l < nSpecies; l++) 
+// Loop on all the indices to compute the mean
+    for (int i = 0; i < indices1D.size(); i++)
     {
-// Add the current concentration
-     conc_meshPt[ speciesId1D[l] ] = gridPointSolution[ speciesId1D[l] ];
+     concTot += gridPointSolution[indices1D[i]];
+     heliumTot += gridPointSolution[indices1D[i]] * weights1D[i];
     }
 
-    assert( timeStep <= 9999 ); // fix the field width below setw(4) upon change
-    std::stringstream name;
-    name << "speciesConc_" << setfill('0') << setw(4) << timestep << ".dat";
-    outputFile.open(name.str(),ios::out|ios::app);
-    for (int i = 0; i < nSpecies; i++)  
+// Loop on all the super clusters, the network was updated at this grid point
+    for (int i = 0; i < superClusters.size(); i++)
     {
-     if (conc_meshPt[i] > 1.0e-15) // note that mesh point may be skipped
-     {
-      outputFile << x << " " << speciesNames1D[i] << " " << conc_meshPt[i]
-                 << std::endl;
-     }
-    } 
-   outputFile.close();
-   } // end if ( xi >= xs && xi < xs + xm ) 
+     auto cluster = (xolotlCore::PSISuperCluster *) superClusters[i];
+     concTot += cluster->getTotalConcentration();
+     heliumTot += cluster->getTotalHeliumConcentration();
+    }
 
-// Zero conc_meshPt vector 
- 
-   std::fill( conc_meshPt.begin(), conc_meshPt.end(), 0.0 );
+    values[2 * xi] = concTot;
+    values[2 * xi + 1] = heliumTot;
+   },
+   [=] (int timestep, double, const double* values)
+   {
+// Compute the mean size of helium at each depth
+    for (int xi = 0; xi < xSize; xi++)
+    {
+     telemetrySink->append( "heliumSizeMean", { (double) timestep, grid[xi],
+                            values[2 * xi + 1] / values[2 * xi] } );
+    }
+   }, true );
 
-  } // end for ( PetscInt xi = surfacePos; xi < Mx; xi++ ) 
+  return;
 
-// Close the file
-  outputFile.close();
+ } // end void addMeanSize1D( )
+
+//--------------------------------------------------------------------------------
+/**
+ * This method registers the check on the concentration of the biggest cluster
+ * in the network in the diagnostics pipeline. A message is printed when it
+ * reaches a non-negligible value.
+ */
+ void
+ addMaxClusterConc1D( DiagnosticsPipeline& pipeline )
+ {
+// Get the solver handler
+  auto solverHandler = PetscSolver::getSolverHandler();
+
+// Get the network
+  auto network = solverHandler->getNetwork();
+
+// Get the maximum size of HeV clusters
+  auto psiNetwork = dynamic_cast<PSIClusterReactionNetwork*>(network);
+  int maxHeVClusterSize = psiNetwork->getMaxHeVClusterSize();
+// Get the maximum size of V clusters
+  int maxVClusterSize = psiNetwork->getMaxVClusterSize();
+// Get the number of He in the max HeV cluster
+  int maxHeSize = (maxHeVClusterSize - maxVClusterSize);
+// Get the maximum stable HeV cluster
+  IReactant * maxCluster;
+  maxCluster = network->getCompound( heVType, { maxHeSize, maxVClusterSize, 0 } );
+  if (!maxCluster)
+  {
+// Get the maximum size of Xe clusters
+   auto neNetwork = dynamic_cast<NEClusterReactionNetwork*>(network);
+   int maxXeClusterSize = neNetwork->getMaxXeClusterSize();
+   maxCluster = network->get(xeType, maxXeClusterSize);
+  }
+  int id = maxCluster->getId() - 1;
+
+// The number of grid points where the concentration is too big
+  pipeline.addReduction( 1,
+   [=] (int, const double* gridPointSolution, double* values)
+   {
+    if (printMaxClusterConc1D && gridPointSolution[id] > 1.0e-16) values[0] += 1.0;
+   },
+   [=] (int timestep, double time, const double* values)
+   {
+// Don't do anything if it was already printed
+    if (!printMaxClusterConc1D || values[0] == 0.0) return;
+
+// All the processes know the result, only the master one prints
+    int procId;
+    MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+    if (procId == 0)
+    {
+     std::cout << std::endl;
+     std::cout << "At time step: " << timestep << " and time: " << time
+               << " the biggest cluster: " << maxCluster->getName()
+               << " reached a concentration above 1.0e-16 at at least one grid point."
+               << std::endl << std::endl;
+    }
 
-// Restore the solutionArray
-  ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
+// Don't print anymore
+    printMaxClusterConc1D = false;
+   } );
 
-  PetscFunctionReturn(0);
+  return;
 
- } // PetscErrorCode showAllSpeciesConc1D( )
+ } // end void addMaxClusterConc1D( )
 
 //--------------------------------------------------------------------------------
 #undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeCumulativeHelium1D")
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorDiagnostics1D")
 /**
- * This is a monitoring method that will compute the cumulative distribution of helium
+ * This is a monitoring method that computes all the reductions registered in
+ * the diagnostics pipeline with a single sweep over the grid and a single
+ * MPI reduction.
  */
- PetscErrorCode 
- computeCumulativeHelium1D( TS ts, PetscInt timestep, PetscReal time, Vec solution, void* ictx ) 
+ PetscErrorCode
+ monitorDiagnostics1D( TS ts, PetscInt timestep, PetscReal time, Vec solution, void* )
  {
 // Initial declarations
   PetscErrorCode ierr;
@@ -824,23 +665,6 @@ namespace xolotlSolver
 
   PetscFunctionBeginUser;
 
-// Get the number of processes
-  int worldSize;
-  MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-// Gets the process ID
-  int procId;
-  MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
-// Get the solver handler
-  auto solverHandler = PetscSolver::getSolverHandler();
-
-// Get the network
-  auto network = solverHandler->getNetwork();
-
-// Get the position of the surface
-  int surfacePos = solverHandler->getSurfacePosition();
-
 // Get the da from ts
   DM da;
   ierr = TSGetDM(ts, &da);
@@ -850,99 +674,29 @@ namespace xolotlSolver
   ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
   CHKERRQ(ierr);
 
-// Get the physical grid and its length
-  auto grid = solverHandler->getXGrid();
-  int xSize = grid.size();
-
 // Get the array of concentration
-  PetscReal **solutionArray;
+  PetscReal** solutionArray;
   ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
   CHKERRQ(ierr);
 
-// Store the concentration over the grid
-  double heConcentration = 0.0;
-
-// Declare the pointer for the concentrations at a specific grid point
-  PetscReal *gridPointSolution;
-
-// Create the output file
-  std::ofstream outputFile;
-  if (procId == 0) 
-  {
-   std::stringstream name;
-   name << "heliumCumul_" << timestep << ".dat";
-   outputFile.open(name.str());
-  }
-
-// Loop on the entire grid
-  for (int xi = surfacePos; xi < xSize; xi++) 
-  {
-// Wait for everybody at each grid point
-   MPI_Barrier(PETSC_COMM_WORLD);
-
-// Set x
-   double x = grid[xi];
-
-// Initialize the helium concentration at this grid point
-   double heLocalConc = 0.0;
-
-// Check if this process is in charge of xi
-   if (xi >= xs && xi < xs + xm) 
-   {
-// Get the pointer to the beginning of the solution data for this grid point
-    gridPointSolution = solutionArray[xi];
-
-// Update the concentration in the network
-    network->updateConcentrationsFromArray(gridPointSolution);
-
-// Get the total helium concentration at this grid point
-    heLocalConc += network->getTotalAtomConcentration() * (grid[xi] - grid[xi - 1]);
-
-// If this is not the master process, send the value
-    if (procId != 0) 
-    {
-     MPI_Send(&heLocalConc, 1, MPI_DOUBLE, 0, 2, PETSC_COMM_WORLD);
-    }
-   }
-// If this process is not in charge of xi but is the master one, receive the value
-   else if (procId == 0) 
-   {
-    MPI_Recv(&heLocalConc, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 2,
-             PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
-   }
-
-// The master process writes computes the cumulative value and writes in the file
-   if (procId == 0) 
-   {
-    heConcentration += heLocalConc;
-    outputFile << x - grid[surfacePos] << " " << heConcentration
-               << std::endl;
-   }
-
-  } // end for (int xi = surfacePos; xi < xSize; xi++) 
-
-// Close the file
-  if (procId == 0) 
-  {
-   outputFile.close();
-  }
+// Compute everything and write the results
+  diagnostics1D->execute(PETSC_COMM_WORLD, xs, xm, solutionArray, timestep, time);
 
 // Restore the solutionArray
   ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-         CHKERRQ(ierr);
+  CHKERRQ(ierr);
 
   PetscFunctionReturn(0);
 
- } // end PetscErrorCode computeCumulativeHelium1D( TS ts, PetscInt timestep,
-
+ } // end PetscErrorCode monitorDiagnostics1D( )
 //--------------------------------------------------------------------------------
 #undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeTRIDYN1D")
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "showAllSpeciesConc1D")
 /**
- * This is a monitoring method that will compute the data to send to TRIDYN
+ * This is a monitoring method that will compute the helium concentrations
  */
  PetscErrorCode 
- computeTRIDYN1D( TS ts, PetscInt timestep, PetscReal time, Vec solution, void* ictx ) 
+ showAllSpeciesConc1D( TS ts, PetscInt timestep, PetscReal time, Vec solution, void* ictx )
  {
 // Initial declarations
   PetscErrorCode ierr;
@@ -961,108 +715,111 @@ namespace xolotlSolver
 // Get the solver handler
   auto solverHandler = PetscSolver::getSolverHandler();
 
-// Get the network
-  auto network = solverHandler->getNetwork();
-
-// Get the position of the surface
-  int surfacePos = solverHandler->getSurfacePosition();
-
 // Get the da from ts
   DM da;
-  ierr = TSGetDM(ts, &da);
+  ierr = TSGetDM( ts, &da );
   CHKERRQ(ierr);
 
 // Get the corners of the grid
-  ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
+  ierr = DMDAGetCorners( da, &xs, NULL, NULL, &xm, NULL, NULL );
   CHKERRQ(ierr);
 
-// Get the physical grid and its length
+// Get the physical grid in the x direction
   auto grid = solverHandler->getXGrid();
-  int xSize = grid.size();
+
+// Get the network
+  auto network = solverHandler->getNetwork();
+
+// Get the position of the surface
+  int surfacePos = solverHandler->getSurfacePosition();
+
+// Get the total size of the grid
+  PetscInt Mx;
+  ierr = DMDAGetInfo( da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
+                      PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+                      PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+                      PETSC_IGNORE );
+  CHKERRQ(ierr);
 
 // Get the array of concentration
-  PetscReal** solutionArray;
+  double** solutionArray;
+  double*  gridPointSolution;
   ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-         CHKERRQ(ierr);
+  CHKERRQ(ierr);
+
+// Vector to hold the concentration of all species at a mesh point
+  int nSpecies = network->size();
+  std::vector<double> conc_meshPt(nSpecies, 0.0);
 
-// Declare the pointer for the concentrations at a specific grid point
-  PetscReal* gridPointSolution;
+// Open the file
 
-// Create the output file
   std::ofstream outputFile;
+
   if (procId == 0) 
   {
+   assert( timeStep <= 9999 ); // fix the field width below setw(4) upon change
    std::stringstream name;
-   name << "TRIDYN_" << timestep << ".dat";
+   name << "speciesConc_" << setfill('0') << setw(4) << timestep << ".dat";
    outputFile.open(name.str());
+   outputFile << time << std::endl;
+   outputFile.close();
   }
 
-// Loop on the entire grid
-  for (int xi = surfacePos; xi < xSize; xi++) 
+// All processes loop on the entire grid
+  for ( PetscInt xi = surfacePos; xi < Mx; xi++ ) 
   {
 // Wait for everybody at each grid point
-   MPI_Barrier(PETSC_COMM_WORLD);
+   MPI_Barrier( PETSC_COMM_WORLD );
 
 // Set x
    double x = grid[xi];
 
-// Initialize the concentrations at this grid point
-   double heLocalConc = 0.0, vLocalConc = 0.0, iLocalConc = 0.0;
-
-// Check if this process is in charge of xi
-   if (xi >= xs && xi < xs + xm) 
+// Only one process will pass this test:
+//      xs is pointer to the leftmost grid point in this process;
+//      xm is total number of points in this process
+   if ( xi >= xs && xi < xs + xm )  // grid partition on this process
    {
 // Get the pointer to the beginning of the solution data for this grid point
-    gridPointSolution = solutionArray[xi];
-
-// Update the concentration in the network
-    network->updateConcentrationsFromArray(gridPointSolution);
-
-// Get the total helium concentration at this grid point
-    heLocalConc += network->getTotalAtomConcentration();
-    vLocalConc += network->getTotalVConcentration();
-    iLocalConc += network->getTotalIConcentration();
+    gridPointSolution = solutionArray[ xi ];
 
-// If this is not the master process, send the values
-    if (procId != 0) 
+// Loop on all the species ids 
+    for (int l = 0; l < nSpecies; l++) 
     {
-     MPI_Send(&heLocalConc, 1, MPI_DOUBLE, 0, 2, PETSC_COMM_WORLD);
-              MPI_Send(&vLocalConc, 1, MPI_DOUBLE, 0, 3, PETSC_COMM_WORLD);
-     MPI_Send(&iLocalConc, 1, MPI_DOUBLE, 0, 4, PETSC_COMM_WORLD);
+// Add the current concentration
+     conc_meshPt[ speciesId1D[l] ] = gridPointSolution[ speciesId1D[l] ];
     }
-   }
-// If this process is not in charge of xi but is the master one, receive the values
-   else if (procId == 0) 
-   {
-    MPI_Recv(&heLocalConc, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 2,
-             PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
-    MPI_Recv(&vLocalConc, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 3,
-             PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
-    MPI_Recv(&vLocalConc, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 4,
-             PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
-   }
 
-// The master process writes computes the cumulative value and writes in the file
-   if (procId == 0) 
-   {
-    outputFile << x - grid[surfacePos] << " " << heLocalConc << " " << vLocalConc 
-               << " " << iLocalConc << std::endl;
-   }
-  }
+    assert( timeStep <= 9999 ); // fix the field width below setw(4) upon change
+    std::stringstream name;
+    name << "speciesConc_" << setfill('0') << setw(4) << timestep << ".dat";
+    outputFile.open(name.str(),ios::out|ios::app);
+    for (int i = 0; i < nSpecies; i++)  
+    {
+     if (conc_meshPt[i] > 1.0e-15) // note that mesh point may be skipped
+     {
+      outputFile << x << " " << speciesNames1D[i] << " " << conc_meshPt[i]
+                 << std::endl;
+     }
+    } 
+   outputFile.close();
+   } // end if ( xi >= xs && xi < xs + xm ) 
+
+// Zero conc_meshPt vector 
+ 
+   std::fill( conc_meshPt.begin(), conc_meshPt.end(), 0.0 );
+
+  } // end for ( PetscInt xi = surfacePos; xi < Mx; xi++ ) 
 
 // Close the file
-  if (procId == 0) 
-  {
-   outputFile.close();
-  }
+  outputFile.close();
 
 // Restore the solutionArray
   ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-         CHKERRQ(ierr);
+  CHKERRQ(ierr);
 
   PetscFunctionReturn(0);
 
- } // end PetscErrorCode computeTRIDYN1D( )
+ } // PetscErrorCode showAllSpeciesConc1D( )
 
 //--------------------------------------------------------------------------------
 #undef __FUNCT__
@@ -1078,20 +835,16 @@ namespace xolotlSolver
   PetscErrorCode ierr;
   double** solutionArray;
   double*  gridPointSolution;
-  PetscInt xs, xm, xi, Mx;
+  PetscInt xs, xm, Mx;
 
   PetscFunctionBeginUser;
 
 // Don't do anything if it is not on the stride
   if (timestep % 10 != 0) PetscFunctionReturn(0);
 
-// Get the number of processes
-  int worldSize;
-  MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
 // Gets the process ID (important when it is running in parallel)
   int procId;
-  MPI_Comm_rank(MPI_COMM_WORLD, &procId);
+  MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 
 // Get the da from ts
   DM da;
@@ -1124,97 +877,62 @@ namespace xolotlSolver
 // Get the index of the middle of the grid
   PetscInt ix = Mx / 2;
 
-  if (procId == 0) 
+// The process owning the middle packs the size distribution
+  std::vector<double> localConcs;
+  if ( ix >= xs && ix < xs + xm ) 
   {
-// Create a Point vector to store the data to give to the data provider
-// for the visualization
-   auto myPoints = std::make_shared<std::vector<xolotlViz::Point> >();
-
-// If the middle is on this MPI process
-   if ( ix >= xs && ix < xs + xm ) 
-   {
 // Get the pointer to the beginning of the solution data for this grid point
-    gridPointSolution = solutionArray[ix];
+   gridPointSolution = solutionArray[ix];
 
 // Update the concentration in the network
-    network->updateConcentrationsFromArray(gridPointSolution);
+   network->updateConcentrationsFromArray(gridPointSolution);
 
-    for (int i = 0; i < networkSize - superClusters.size(); i++) 
-    {
-// Create a Point with the concentration[i] as the value
-// and add it to myPoints
-     xolotlViz::Point aPoint;
-     aPoint.value = gridPointSolution[i];
-     aPoint.t = time;
-     aPoint.x = (double) i + 1.0;
-     myPoints->push_back(aPoint);
-    }
-    int nXe = networkSize - superClusters.size() + 1;
-    for (int i = 0; i < superClusters.size(); i++) 
-    {
+   for (int i = 0; i < networkSize - superClusters.size(); i++) 
+   {
+    localConcs.push_back(gridPointSolution[i]);
+   }
+   int nXe = networkSize - superClusters.size() + 1;
+   for (int i = 0; i < superClusters.size(); i++) 
+   {
 // Get the cluster
-     auto cluster = (NESuperCluster *) superClusters[i];
+    auto cluster = (NESuperCluster *) superClusters[i];
 // Get the width
-     int width = cluster->getSectionWidth();
+    int width = cluster->getSectionWidth();
 // Loop on the width
-     for (int k = 0; k < width; k++) 
-     {
+    for (int k = 0; k < width; k++) 
+    {
 // Compute the distance
-      double dist = cluster->getDistance(nXe + k);
-// Create a Point with the concentration[i] as the value
-// and add it to myPoints
-      xolotlViz::Point aPoint;
-      aPoint.value = cluster->getConcentration(dist);
-      aPoint.t = time;
-      aPoint.x = (double) nXe + k;
-      myPoints->push_back(aPoint);
-     }
+     double dist = cluster->getDistance(nXe + k);
+     localConcs.push_back(cluster->getConcentration(dist));
+    }
 
 // update nXe
-     nXe += width;
-    }
+    nXe += width;
    }
-// else receive the values from another process
-   else 
+  }
+
+// Restore the solutionArray
+  ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
+  CHKERRQ(ierr);
+
+// Send it to the master process, the other processes have nothing to send
+  std::vector<double> concs;
+  gatherValues(localConcs, concs);
+
+  if (procId == 0) 
+  {
+// Create a Point vector to store the data to give to the data provider
+// for the visualization
+   auto myPoints = std::make_shared<std::vector<xolotlViz::Point> >();
+   for (int i = 0; i < concs.size(); i++) 
    {
-    for (int i = 0; i < networkSize - superClusters.size(); i++) 
-    {
-     double conc = 0.0;
-     MPI_Recv(&conc, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 10,
-              MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-// Create a Point with conc as the value
-// and add it to myPoints
-     xolotlViz::Point aPoint;
-     aPoint.value = conc;
-     aPoint.t = time;
-     aPoint.x = (double) i + 1.0;
-     myPoints->push_back(aPoint);
-    }
-    int nXe = networkSize - superClusters.size() + 1;
-    for (int i = 0; i < superClusters.size(); i++) 
-    {
-// Get the cluster
-     auto cluster = (NESuperCluster *) superClusters[i];
-// Get the width
-     int width = cluster->getSectionWidth();
-// Loop on the width
-     for (int k = 0; k < width; k++) 
-     {
-      double conc = 0.0;
-      MPI_Recv(&conc, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 10,
-               MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-// Create a Point with conc as the value
+// Create a Point with the concentration[i] as the value
 // and add it to myPoints
-      xolotlViz::Point aPoint;
-      aPoint.value = conc;
-      aPoint.t = time;
-      aPoint.x = (double) nXe + k;
-      myPoints->push_back(aPoint);
-     }
-
-// update nXe
-     nXe += width;
-    }
+    xolotlViz::Point aPoint;
+    aPoint.value = concs[i];
+    aPoint.t = time;
+    aPoint.x = (double) i + 1.0;
+    myPoints->push_back(aPoint);
    }
 
 // Get the data provider and give it the points
@@ -1239,52 +957,12 @@ namespace xolotlSolver
                  << "s";
    scatterPlot1D->plotLabelProvider->timeStepLabel = timeStepLabel.str();
 
-// Render and save in file
-   std::stringstream fileName;
-   fileName << "Scatter_TS" << timestep << ".png";
-   scatterPlot1D->write(fileName.str());
-  }
-  else 
-  {
-// If the middle is on this process
-   if (ix >= xs && ix < xs + xm) 
-   {
-// Get the pointer to the beginning of the solution data for this grid point
-    gridPointSolution = solutionArray[ix];
-
-    for (int i = 0; i < networkSize - superClusters.size(); i++) 
-    {
-// Send the value of each concentration to the master process
-     MPI_Send(&gridPointSolution[i], 1, MPI_DOUBLE, 0, 10,
-              MPI_COMM_WORLD);
-    }
-    int nXe = networkSize - superClusters.size() + 1;
-    for (int i = 0; i < superClusters.size(); i++) 
-    {
-// Get the cluster
-     auto cluster = (NESuperCluster *) superClusters[i];
-// Get the width
-     int width = cluster->getSectionWidth();
-// Loop on the width
-     for (int k = 0; k < width; k++) 
-     {
-// Compute the distance
-      double dist = cluster->getDistance(nXe + k);
-      double conc = cluster->getConcentration(dist);
-// Send the value of each concentration to the master process
-      MPI_Send(&conc, 1, MPI_DOUBLE, 0, 10, MPI_COMM_WORLD);
-     }
-
-// update nXe
-     nXe += width;
-    }
-   }
+// Render and save in file
+   std::stringstream fileName;
+   fileName << "Scatter_TS" << timestep << ".png";
+   scatterPlot1D->write(fileName.str());
   }
 
-// Restore the solutionArray
-  ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
-
   PetscFunctionReturn(0);
 
  } // end PetscErrorCode monitorScatter1D( )
@@ -1300,19 +978,12 @@ namespace xolotlSolver
  {
 // Initial declarations
   PetscErrorCode ierr;
-  const double **solutionArray, *gridPointSolution;
-  PetscInt xs, xm, xi;
-  double x = 0.0;
 
   PetscFunctionBeginUser;
 
 // Don't do anything if it is not on the stride
   if (timestep % 10 != 0) PetscFunctionReturn(0);
 
-// Get the number of processes
-  int worldSize;
-  MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
 // Gets the process ID (important when it is running in parallel)
   int procId;
   MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
@@ -1322,14 +993,6 @@ namespace xolotlSolver
   ierr = TSGetDM(ts, &da);
   CHKERRQ(ierr);
 
-// Get the solutionArray
-  ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
-
-// Get the corners of the grid
-  ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-  CHKERRQ(ierr);
-
 // Get the solver handler
   auto solverHandler = PetscSolver::getSolverHandler();
 
@@ -1343,6 +1006,12 @@ namespace xolotlSolver
 // To plot a maximum of 18 clusters of the whole benchmark
   const int loopSize = std::min(18, networkSize);
 
+// Gather the concentrations of the whole grid on the master process
+  std::vector<double> concentrations;
+  ierr = gatherConcentrations(da, solution, timestep, time, 0, loopSize,
+                              concentrations);
+  CHKERRQ(ierr);
+
   if (procId == 0) 
   {
 // Create a Point vector to store the data to give to the data provider
@@ -1350,56 +1019,20 @@ namespace xolotlSolver
    std::vector<std::vector<xolotlViz::Point> > myPoints(loopSize);
 
 // Loop on the grid
-   for (xi = xs; xi < xs + xm; xi++) 
+   for (int xi = 0; xi < grid.size(); xi++) 
    {
-// Get the pointer to the beginning of the solution data for this grid point
-    gridPointSolution = solutionArray[xi];
-
     for (int i = 0; i < loopSize; i++) 
     {
 // Create a Point with the concentration[i] as the value
 // and add it to myPoints
      xolotlViz::Point aPoint;
-     aPoint.value = gridPointSolution[i];
+     aPoint.value = concentrations[xi * loopSize + i];
      aPoint.t = time;
      aPoint.x = grid[xi];
      myPoints[i].push_back(aPoint);
     }
    }
 
-// Loop on the other processes
-   for (int i = 1; i < worldSize; i++) 
-   {
-// Get the size of the local grid of that process
-    int localSize = 0;
-    MPI_Recv(&localSize, 1, MPI_INT, i, 20, PETSC_COMM_WORLD,
-             MPI_STATUS_IGNORE);
-
-// Loop on their grid
-    for (int k = 0; k < localSize; k++) 
-    {
-// Get the position
-     MPI_Recv(&x, 1, MPI_DOUBLE, i, 21, PETSC_COMM_WORLD,
-              MPI_STATUS_IGNORE);
-
-     for (int j = 0; j < loopSize; j++) 
-     {
-// and the concentrations
-      double conc = 0.0;
-      MPI_Recv(&conc, 1, MPI_DOUBLE, i, 22, PETSC_COMM_WORLD,
-               MPI_STATUS_IGNORE);
-
-// Create a Point with the concentration[i] as the value
-// and add it to myPoints
-      xolotlViz::Point aPoint;
-      aPoint.value = conc; // He
-      aPoint.t = time;
-      aPoint.x = x;
-      myPoints[j].push_back(aPoint);
-     }
-    }
-   }
-
 // Get all the reactants to have access to their names
    auto reactants = network->getAll();
 
@@ -1435,35 +1068,6 @@ namespace xolotlSolver
    fileName << "log_series_TS" << timestep << ".png";
    seriesPlot1D->write(fileName.str());
   }
-  else 
-  {
-// Send the value of the local grid size to the master process
-   MPI_Send(&xm, 1, MPI_DOUBLE, 0, 20, PETSC_COMM_WORLD);
-
-// Loop on the grid
-   for (xi = xs; xi < xs + xm; xi++) 
-   {
-// Dump x
-    x = grid[xi];
-
-// Get the pointer to the beginning of the solution data for this grid point
-    gridPointSolution = solutionArray[xi];
-
-// Send the value of the local position to the master process
-    MPI_Send(&x, 1, MPI_DOUBLE, 0, 21, PETSC_COMM_WORLD);
-
-    for (int i = 0; i < loopSize; i++) 
-    {
-// Send the value of the concentrations to the master process
-     MPI_Send(&gridPointSolution[i], 1, MPI_DOUBLE, 0, 22,
-              PETSC_COMM_WORLD);
-    }
-   }
-  }
-
-// Restore the solutionArray
-  ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
 
   PetscFunctionReturn(0);
 
@@ -1645,252 +1249,6 @@ namespace xolotlSolver
 
  } // end PetscErrorCode monitorSurface1D( )
 
-//--------------------------------------------------------------------------------
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorMeanSize1D")
-/**
- * This is a monitoring method that will create files with the mean
- * helium size as a function of depth at each time step.
- */
- PetscErrorCode 
- monitorMeanSize1D( TS ts, PetscInt timestep, PetscReal time, Vec solution, void* ictx )  
- {
-// Initial declaration
-  PetscErrorCode ierr;
-  const double** solutionArray;
-  const double*  gridPointSolution;
-  PetscInt xs, xm, xi;
-  double x = 0.0;
-
-  PetscFunctionBeginUser;
-
-// Get the number of processes
-  int worldSize;
-  MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-// Gets the process ID
-  int procId;
-  MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
-// Get the da from ts
-  DM da;
-  ierr = TSGetDM(ts, &da);
-  CHKERRQ(ierr);
-
-// Get the solutionArray
-  ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
-
-// Get the corners of the grid
-  ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-  CHKERRQ(ierr);
-
-// Get the solver handler
-  auto solverHandler = PetscSolver::getSolverHandler();
-
-// Get the network
-  auto network = solverHandler->getNetwork();
-
-// Get all the super clusters
-  auto superClusters = network->getAll(PSISuperType);
-
-// Get the physical grid
-  auto grid = solverHandler->getXGrid();
-
-// Create the output file
-  std::ofstream outputFile;
-  if (procId == 0) 
-  {
-   std::stringstream name;
-   name << "heliumSizeMean_" << timestep << ".dat";
-   outputFile.open(name.str());
-  }
-
-// Loop on the full grid
-  for (xi = 0; xi < grid.size(); xi++) 
-  {
-// Wait for everybody at each grid point
-   MPI_Barrier(PETSC_COMM_WORLD);
-
-// Get the x position
-   x = grid[xi];
-
-// Initialize the values to write in the file
-   double heliumMean = 0.0;
-
-// If this is the locally owned part of the grid
-   if (xi >= xs && xi < xs + xm) 
-   {
-// Compute the mean and standard deviation of helium cluster size
-
-// Get the pointer to the beginning of the solution data for this grid point
-    gridPointSolution = solutionArray[xi];
-
-// Initialize the total helium and concentration before looping
-    double concTot = 0.0, heliumTot = 0.0;
-
-// Loop on all the indices to compute the mean
-    for (int i = 0; i < indices1D.size(); i++) 
-    {
-     concTot += gridPointSolution[indices1D[i]];
-     heliumTot += gridPointSolution[indices1D[i]] * weights1D[i];
-    }
-
-// Loop on all the super clusters
-    for (int i = 0; i < superClusters.size(); i++) 
-    {
-     auto cluster = (xolotlCore::PSISuperCluster *) superClusters[i];
-     concTot += cluster->getTotalConcentration();
-     heliumTot += cluster->getTotalHeliumConcentration();
-    }
-
-// Compute the mean size of helium at this depth
-    heliumMean = heliumTot / concTot;
-
-// If this is not the master process, send the values
-    if (procId != 0) 
-    {
-     MPI_Send(&heliumMean, 1, MPI_DOUBLE, 0, 5, PETSC_COMM_WORLD);
-    }
-   }
-// If this process is not in charge of xi but is the master one, receive the value
-   else if (procId == 0) 
-   {
-    MPI_Recv(&heliumMean, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 5,
-             PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
-   }
-
-// The master process writes in the file
-   if (procId == 0) 
-   {
-    outputFile << x << " " << heliumMean << std::endl;
-   }
-  }
-
-// Close the file
-  if (procId == 0) 
-  {
-   outputFile.close();
-  }
-
-// Restore the solutionArray
-  ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
-
-  PetscFunctionReturn(0);
-
- } // end PetscErrorCode monitorMeanSize1D( )
-
-//--------------------------------------------------------------------------------
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorMaxClusterConc1D")
-/**
- * This is a monitoring method that will print a message when the biggest cluster
- * in the network reaches a non-negligible concentration value.
- */
- PetscErrorCode 
- monitorMaxClusterConc1D( TS ts, PetscInt timestep, PetscReal time, Vec solution, void* ) 
- {
-// Initial declarations
-  PetscErrorCode ierr;
-  const double **solutionArray;
-  const double* gridPointSolution;
-  PetscInt xs, xm, xi;
-
-  PetscFunctionBeginUser;
-
-// Don't do anything if it was already printed
-  if (!printMaxClusterConc1D) PetscFunctionReturn(0);
-
-// Get the da from ts
-  DM da;
-  ierr = TSGetDM(ts, &da);
-  CHKERRQ(ierr);
-
-// Get the solutionArray
-  ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
-
-// Get the corners of the grid
-  ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-  CHKERRQ(ierr);
-
-// Get the solver handler
-  auto solverHandler = PetscSolver::getSolverHandler();
-
-// Get the network
-  auto network = solverHandler->getNetwork();
-
-// Get the maximum size of HeV clusters
-  auto psiNetwork = dynamic_cast<PSIClusterReactionNetwork*>(network);
-  int maxHeVClusterSize = psiNetwork->getMaxHeVClusterSize();
-// Get the maximum size of V clusters
-  int maxVClusterSize = psiNetwork->getMaxVClusterSize();
-// Get the number of He in the max HeV cluster
-  int maxHeSize = (maxHeVClusterSize - maxVClusterSize);
-// Get the maximum stable HeV cluster
-  IReactant * maxCluster;
-  maxCluster = network->getCompound( heVType, { maxHeSize, maxVClusterSize, 0 } );
-  if (!maxCluster) 
-  {
-// Get the maximum size of Xe clusters
-   auto neNetwork = dynamic_cast<NEClusterReactionNetwork*>(network);
-   int maxXeClusterSize = neNetwork->getMaxXeClusterSize();
-   maxCluster = network->get(xeType, maxXeClusterSize);
-  }
-
-// Boolean to know if the concentration is too big
-  bool maxClusterTooBig = false;
-
-// Check the concentration of the biggest cluster at each grid point
-  for (xi = xs; xi < xs + xm; xi++) 
-  {
-// Get the pointer to the beginning of the solution data for this grid point
-   gridPointSolution = solutionArray[xi];
-
-// Get the concentration of the maximum HeV cluster
-   auto maxClusterConc = gridPointSolution[maxCluster->getId() - 1];
-
-   if (maxClusterConc > 1.0e-16) maxClusterTooBig = true;
-  }
-
-// Get the current process ID
-  int procId;
-  MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
-// Is the concentration too big on any process?
-  bool tooBig = false;
-  MPI_Reduce(&maxClusterTooBig, &tooBig, 1, MPI_C_BOOL, MPI_LOR, 0,
-             PETSC_COMM_WORLD);
-
-// Main process
-  if (procId == 0) 
-  {
-// Print if tooBig is true
-   if (tooBig) 
-   {
-    std::cout << std::endl;
-    std::cout << "At time step: " << timestep << " and time: " << time
-              << " the biggest cluster: " << maxCluster->getName()
-              << " reached a concentration above 1.0e-16 at at least one grid point."
-              << std::endl << std::endl;
-
-// Don't print anymore
-    printMaxClusterConc1D = false;
-   }
-  }
-
-// Broadcast the information about printMaxClusterConc1D to the other processes
-  MPI_Bcast(&printMaxClusterConc1D, 1, MPI_C_BOOL, 0, PETSC_COMM_WORLD);
-
-// Restore the solutionArray
-  ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-  CHKERRQ(ierr);
-
-  PetscFunctionReturn(0);
-
- } // end PetscErrorCode monitorMaxClusterConc1D( )
-
 //--------------------------------------------------------------------------------
 #undef __FUNCT__
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorMovingSurface1D")
@@ -2111,21 +1469,19 @@ namespace xolotlSolver
    solverHandler->setSurfacePosition(surfacePos);
   }
 
-// Reinitialize the physics handlers if the surface has moved
+// Move the surface in the physics handlers if it has moved
   if (surfaceHasMoved) 
   {
  // Set the new surface location in the surface advection handler
    auto advecHandler = solverHandler->getAdvectionHandler();
    advecHandler->setLocation(grid[surfacePos]);
 
-// Get the flux handler to reinitialize it
-   auto fluxHandler = solverHandler->getFluxHandler();
-   fluxHandler->initializeFluxHandler(network, surfacePos, grid);
-
-// Get the modified trap-mutation handler to reinitialize it
+// The flux profile and the modified trap-mutation indices are relative to
+// the surface, the ones of a new position are computed here rather than in
+// the RHS
+   fluxHandler->setSurfacePosition(surfacePos);
    auto mutationHandler = solverHandler->getMutationHandler();
-   auto advecHandlers = solverHandler->getAdvectionHandlers();
-   mutationHandler->initializeIndex1D(surfacePos, network, advecHandlers, grid);
+   mutationHandler->setSurfacePosition(surfacePos);
   }
 
 // Restore the solutionArray
@@ -2255,7 +1611,7 @@ namespace xolotlSolver
      auto cluster = clusters[i];
 // Get the V cluster of the same size
      auto comp = cluster->getComposition();
-     auto vCluster = network->get(vType, comp[vType]);
+     auto vCluster = network->get(vType, comp[PSISpecies::V]);
      int vId = vCluster->getId() - 1;
      int id = cluster->getId() - 1;
      gridPointSolution[vId] = gridPointSolution[id];
@@ -2375,6 +1731,14 @@ namespace xolotlSolver
   auto network = solverHandler->getNetwork();
   const int networkSize = network->size();
 
+// Create the pipeline computing the reductions of the monitors, the network
+// is updated only once per grid point for all of them
+  diagnostics1D = std::make_shared<DiagnosticsPipeline>(
+   [network] (double* gridPointSolution) 
+   {
+    network->updateConcentrationsFromArray(gridPointSolution);
+   } );
+
 // Set the monitor to save the status of the simulation in hdf5 file
   if (flagStatus) 
   {
@@ -2400,7 +1764,7 @@ namespace xolotlSolver
    checkPetscError(ierr, "setupPetsc1DMonitor: DMDAGetInfo failed.");
 
 // Initialize the HDF5 file for all the processes
-   xolotlCore::HDF5Utils::initializeFile(hdf5OutputName1D);
+   auto file = xolotlCore::HDF5Utils::initializeFile(hdf5OutputName1D);
 
 // Get the solver handler
    auto solverHandler = PetscSolver::getSolverHandler();
@@ -2409,37 +1773,36 @@ namespace xolotlSolver
    auto grid = solverHandler->getXGrid();
 
 // Save the header in the HDF5 file
-   xolotlCore::HDF5Utils::fillHeader( Mx, grid[1] - grid[0] );
+   xolotlCore::HDF5Utils::fillHeader( file, Mx, grid[1] - grid[0] );
 
 // Save the network in the HDF5 file
-   xolotlCore::HDF5Utils::fillNetwork( solverHandler->getNetworkName() );
+   xolotlCore::HDF5Utils::fillNetwork( file, solverHandler->getNetworkName() );
 
 // Finalize the HDF5 file
-   xolotlCore::HDF5Utils::finalizeFile();
+   xolotlCore::HDF5Utils::finalizeFile(file);
 
 // startStop1D will be called at each timestep
-   ierr = TSMonitorSet(ts, startStop1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (startStop1D) failed.");
+   ierr = addMonitor(ts, startStop1D);
+   checkPetscError(ierr, "setupPetsc1DMonitor: addMonitor (startStop1D) failed.");
   }
 
 // If the user wants the surface to be able to move
   if ( solverHandler->moveSurface() ) 
   {
 
-// Get the last time step written in the HDF5 file
-   int tempTimeStep = -2;
-   std::string networkName = solverHandler->getNetworkName();
-   bool hasConcentrations = xolotlCore::HDF5Utils::hasConcentrationGroup( networkName, tempTimeStep);
+// Get the restart information read from the HDF5 file
+   auto restartReader = solverHandler->getRestartReader();
+   bool hasConcentrations = restartReader->hasConcentrations();
 
 // Get the interstitial information at the surface if concentrations were stored
    if (hasConcentrations) 
    {
 // Get the interstitial quantity from the HDF5 file
-    nInterstitial1D = xolotlCore::HDF5Utils::readNInterstitial1D( networkName, tempTimeStep);
+    nInterstitial1D = restartReader->getNInterstitial1D();
 // Get the previous I flux from the HDF5 file
-    previousIFlux1D = xolotlCore::HDF5Utils::readPreviousIFlux1D( networkName, tempTimeStep);
+    previousIFlux1D = restartReader->getPreviousIFlux1D();
 // Get the previous time from the HDF5 file
-    previousTime = xolotlCore::HDF5Utils::readPreviousTime(networkName, tempTimeStep);
+    previousTime = restartReader->getPreviousTime();
    }
 
 // Compute the sputtering yield
@@ -2447,8 +1810,8 @@ namespace xolotlSolver
 
 // Set the monitor on moving surface
 // monitorMovingSurface1D will be called at each timestep
-   ierr = TSMonitorSet(ts, monitorMovingSurface1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (monitorMovingSurface1D) failed.");
+   ierr = addMonitor(ts, monitorMovingSurface1D);
+   checkPetscError(ierr, "setupPetsc1DMonitor: addMonitor (monitorMovingSurface1D) failed.");
 
 //		// Uncomment to clear the file where the interstitial will be written
 //		std::ofstream outputFile;
@@ -2461,8 +1824,8 @@ namespace xolotlSolver
   {
 // Set the monitor on the bubble bursting
 // monitorBursting1D will be called at each timestep
-   ierr = TSMonitorSet(ts, monitorBursting1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (monitorBursting1D) failed.");
+   ierr = addMonitor(ts, monitorBursting1D);
+   checkPetscError(ierr, "setupPetsc1DMonitor: addMonitor (monitorBursting1D) failed.");
    std::srand(time(NULL));
   }
 
@@ -2493,8 +1856,8 @@ namespace xolotlSolver
    }
 
 // monitorScatter1D will be called at each timestep
-   ierr = TSMonitorSet(ts, monitorScatter1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (monitorScatter1D) failed.");
+   ierr = addMonitor(ts, monitorScatter1D);
+   checkPetscError(ierr, "setupPetsc1DMonitor: addMonitor (monitorScatter1D) failed.");
   }
 
 // Set the monitor to save 1D plot of many concentrations
@@ -2535,8 +1898,8 @@ namespace xolotlSolver
    }
 
 // monitorSeries1D will be called at each timestep
-   ierr = TSMonitorSet(ts, monitorSeries1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (monitorSeries1D) failed.");
+   ierr = addMonitor(ts, monitorSeries1D);
+   checkPetscError(ierr, "setupPetsc1DMonitor: addMonitor (monitorSeries1D) failed.");
   }
 
 // Set the monitor to save surface plots of clusters concentration
@@ -2562,8 +1925,8 @@ namespace xolotlSolver
    surfacePlot1D->setDataProvider(dataProvider);
 
 // monitorSurface1D will be called at each timestep
-   ierr = TSMonitorSet(ts, monitorSurface1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (monitorSurface1D) failed.");
+   ierr = addMonitor(ts, monitorSurface1D);
+   checkPetscError(ierr, "setupPetsc1DMonitor: addMonitor (monitorSurface1D) failed.");
   }
 
 // Set the monitor to save performance plots (has to be in parallel)
@@ -2591,8 +1954,8 @@ namespace xolotlSolver
    }
 
 // monitorPerf will be called at each timestep
-   ierr = TSMonitorSet(ts, monitorPerf, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (monitorPerf) failed.");
+   ierr = addMonitor(ts, monitorPerf);
+   checkPetscError(ierr, "setupPetsc1DMonitor: addMonitor (monitorPerf) failed.");
   }
 
 //................................................................................
@@ -2627,7 +1990,7 @@ namespace xolotlSolver
     indices1D.push_back(id);
 // Add the number of heliums of this cluster to the weight
     auto comp = cluster->getComposition();
-    weights1D.push_back(comp[heType]);
+    weights1D.push_back(comp[PSISpecies::He]);
     radii1D.push_back(cluster->getReactionRadius());
    }
   } // end if (flagMeanSize || flagConc || flagHeRetention) 
@@ -2655,16 +2018,15 @@ namespace xolotlSolver
 // for the retention calculation
   if (flagHeRetention) 
   {
-// Get the last time step written in the HDF5 file
-   int tempTimeStep = -2;
-   std::string networkName = solverHandler->getNetworkName();
-   bool hasConcentrations = xolotlCore::HDF5Utils::hasConcentrationGroup( networkName, tempTimeStep);
+// Get the restart information read from the HDF5 file
+   auto restartReader = solverHandler->getRestartReader();
+   bool hasConcentrations = restartReader->hasConcentrations();
 
 // Get the previous time if concentrations were stored and initialize the fluence
    if (hasConcentrations) 
    {
 // Get the previous time from the HDF5 file
-    double time = xolotlCore::HDF5Utils::readPreviousTime(networkName, tempTimeStep);
+    double time = restartReader->getPreviousTime();
 // Initialize the fluence
     auto fluxHandler = solverHandler->getFluxHandler();
 // The length of the time step
@@ -2672,21 +2034,15 @@ namespace xolotlSolver
 // Increment the fluence with the value at this current timestep
     fluxHandler->incrementFluence(dt);
 // Get the previous time from the HDF5 file
-    previousTime = xolotlCore::HDF5Utils::readPreviousTime(networkName, tempTimeStep);
+    previousTime = restartReader->getPreviousTime();
    }
 
 // computeFluence will be called at each timestep
-   ierr = TSMonitorSet(ts, computeFluence, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (computeFluence) failed.");
-
-// computeHeliumRetention1D will be called at each timestep
-   ierr = TSMonitorSet(ts, computeHeliumRetention1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (computeHeliumRetention1D) failed.");
+   ierr = addMonitor(ts, computeFluence);
+   checkPetscError(ierr, "setupPetsc1DMonitor: addMonitor (computeFluence) failed.");
 
-// Uncomment to clear the file where the retention will be written
-   std::ofstream outputFile;
-   outputFile.open("retentionOut.txt");
-   outputFile.close();
+// Its reductions will be computed by monitorDiagnostics1D
+   addHeliumRetention1D(*diagnostics1D);
   } // end if (flagHeRetention) 
 
 //................................................................................
@@ -2709,16 +2065,15 @@ namespace xolotlSolver
     radii1D.push_back(cluster->getReactionRadius());
    }
 
-// Get the last time step written in the HDF5 file
-   int tempTimeStep = -2;
-   std::string networkName = solverHandler->getNetworkName();
-   bool hasConcentrations = xolotlCore::HDF5Utils::hasConcentrationGroup( networkName, tempTimeStep);
+// Get the restart information read from the HDF5 file
+   auto restartReader = solverHandler->getRestartReader();
+   bool hasConcentrations = restartReader->hasConcentrations();
 
 // Get the previous time if concentrations were stored and initialize the fluence
    if (hasConcentrations) 
    {
 // Get the previous time from the HDF5 file
-    double time = xolotlCore::HDF5Utils::readPreviousTime(networkName, tempTimeStep);
+    double time = restartReader->getPreviousTime();
 // Initialize the fluence
     auto fluxHandler = solverHandler->getFluxHandler();
 // The length of the time step
@@ -2726,39 +2081,31 @@ namespace xolotlSolver
 // Increment the fluence with the value at this current timestep
     fluxHandler->incrementFluence(dt);
 // Get the previous time from the HDF5 file
-    previousTime = xolotlCore::HDF5Utils::readPreviousTime(networkName, tempTimeStep);
+    previousTime = restartReader->getPreviousTime();
    }
 
 // computeFluence will be called at each timestep
-   ierr = TSMonitorSet(ts, computeFluence, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (computeFluence) failed.");
-
-// computeXenonRetention1D will be called at each timestep
-   ierr = TSMonitorSet(ts, computeXenonRetention1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (computeXenonRetention1D) failed.");
+   ierr = addMonitor(ts, computeFluence);
+   checkPetscError(ierr, "setupPetsc1DMonitor: addMonitor (computeFluence) failed.");
 
-// Uncomment to clear the file where the retention will be written
-   std::ofstream outputFile;
-   outputFile.open("retentionOut.txt");
-   outputFile.close();
+// Its reductions will be computed by monitorDiagnostics1D
+   addXenonRetention1D(*diagnostics1D);
   } // end if (flagXeRetention) 
 
 //................................................................................
 // Set the monitor to compute the cumulative helium concentration
   if (flagCumul) 
   {
-// computeCumulativeHelium1D will be called at each timestep
-   ierr = TSMonitorSet(ts, computeCumulativeHelium1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (computeCumulativeHelium1D) failed.");
+// Its reductions will be computed by monitorDiagnostics1D
+   addCumulativeHelium1D(*diagnostics1D);
   }
 
 //................................................................................
 // Set the monitor to save text file of the mean helium size
   if (flagMeanSize) 
   {
-// monitorMeanSize1D will be called at each timestep
-   ierr = TSMonitorSet(ts, monitorMeanSize1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (monitorMeanSize1D) failed.");
+// Its reductions will be computed by monitorDiagnostics1D
+   addMeanSize1D(*diagnostics1D);
   }
 
 //................................................................................
@@ -2766,27 +2113,24 @@ namespace xolotlSolver
 // cluster in the network first becomes greater than 1.0e-16
   if (flagMaxClusterConc) 
   {
-// monitorMaxClusterConc1D will be called at each timestep
-   ierr = TSMonitorSet(ts, monitorMaxClusterConc1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (monitorMaxClusterConc1D) failed.");
+// Its reductions will be computed by monitorDiagnostics1D
+   addMaxClusterConc1D(*diagnostics1D);
   }
 
 //................................................................................
 // Set the monitor to compute the helium concentrations
   if (flagConc) 
   {
-// computeHeliumConc1D will be called at each timestep
-   ierr = TSMonitorSet(ts, computeHeliumConc1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (computeHeliumConc1D) failed.");
+// Its reductions will be computed by monitorDiagnostics1D
+   addHeliumConc1D(*diagnostics1D);
   }
 
 //................................................................................
 // Set the monitor to output data for TRIDYN
   if (flagTRIDYN) 
   { 
-// computeTRIDYN1D will be called at each timestep
-   ierr = TSMonitorSet(ts, computeTRIDYN1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (computeTRIDYN1D) failed.");
+// Its reductions will be computed by monitorDiagnostics1D
+   addTRIDYN1D(*diagnostics1D);
   }
 
 //................................................................................
@@ -2794,15 +2138,24 @@ namespace xolotlSolver
   if (flagAllSpeciesConc) 
   {
 // computeHeliumConc1D will be called at each timestep
-   ierr = TSMonitorSet(ts, showAllSpeciesConc1D, NULL, NULL);
-   checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (showAllSpeciesConc1D) failed.");
+   ierr = addMonitor(ts, showAllSpeciesConc1D);
+   checkPetscError(ierr, "setupPetsc1DMonitor: addMonitor (showAllSpeciesConc1D) failed.");
+  }
+
+//................................................................................
+// Set the monitor computing all the registered reductions in a single sweep
+  if (!diagnostics1D->empty()) 
+  {
+// monitorDiagnostics1D will be called at each timestep
+   ierr = addMonitor(ts, monitorDiagnostics1D);
+   checkPetscError(ierr, "setupPetsc1DMonitor: addMonitor (monitorDiagnostics1D) failed.");
   }
 
 //................................................................................
 // Set the monitor to simply change the previous time to the new time
 // monitorTime will be called at each timestep
-  ierr = TSMonitorSet(ts, monitorTime, NULL, NULL);
-  checkPetscError(ierr, "setupPetsc1DMonitor: TSMonitorSet (monitorTime) failed.");
+  ierr = addMonitor(ts, monitorTime);
+  checkPetscError(ierr, "setupPetsc1DMonitor: addMonitor (monitorTime) failed.");
 
   PetscFunctionReturn(0);
 
@@ -16,6 +16,7 @@
 #include <vector>
 #include <memory>
 #include <HDF5Utils.h>
+#include <TelemetrySink.h>
 #include <PSISuperCluster.h>
 #include <NESuperCluster.h>
 
@@ -28,10 +29,18 @@ extern PetscErrorCode computeFluence(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
 extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
+extern PetscErrorCode addMonitor(TS ts,
+		PetscErrorCode (*monitor)(TS, PetscInt, PetscReal, Vec, void *));
+extern PetscErrorCode gatherConcentrations(DM da, Vec solution,
+		PetscInt timestep, PetscReal time, int firstId, int nIds,
+		std::vector<double>& values);
+extern void addTelemetryTable(const std::string& name,
+		const std::vector<std::string>& columns);
 
 // Declaration of the variables defined in Monitor.cpp
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
 extern double previousTime;
+extern std::shared_ptr<xolotlCore::TelemetrySink> telemetrySink;
 
 //! How often HDF5 file is written
 PetscReal hdf5Stride2D = 0.0;
@@ -67,14 +76,6 @@ PetscErrorCode startStop2D(TS ts, PetscInt timestep, PetscReal time,
 	// Update the previous time
 	hdf5Previous2D++;
 
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-	// Gets the process ID (important when it is running in parallel)
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -109,93 +110,57 @@ PetscErrorCode startStop2D(TS ts, PetscInt timestep, PetscReal time,
 		surfaceIndices.push_back(solverHandler->getSurfacePosition(i));
 	}
 
-	// Open the already created HDF5 file
-	xolotlCore::HDF5Utils::openFile(hdf5OutputName2D);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
+	// Get the non-zero concentrations of the locally owned grid points
+	std::vector<double> concArray;
+	std::vector<int> concSizes;
+	for (PetscInt j = ys; j < ys + ym; j++) {
+		for (PetscInt i = xs; i < xs + xm; i++) {
+			// Get the pointer to the beginning of the solution data for this grid point
+			gridPointSolution = solutionArray[j][i];
+
+			// Loop on the concentrations
+			int concSize = 0;
+			for (int l = 0; l < dof; l++) {
+				if (gridPointSolution[l] > 1.0e-16
+						|| gridPointSolution[l] < -1.0e-16) {
+					// Add the index and concentration of this cluster
+					concArray.push_back((double) l);
+					concArray.push_back(gridPointSolution[l]);
+					concSize++;
+				}
+			}
+			concSizes.push_back(concSize);
+		}
+	}
+
+	// Restore the solutionArray
+	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
+	CHKERRQ(ierr);
+
+	// Open the already created HDF5 file
+	auto file = xolotlCore::HDF5Utils::openFile(hdf5OutputName2D,
+			PETSC_COMM_WORLD);
+
 	// Add a concentration sub group
-	xolotlCore::HDF5Utils::addConcentrationSubGroup(timestep, time,
+	xolotlCore::HDF5Utils::addConcentrationSubGroup(file, timestep, time,
 			previousTime, currentTimeStep);
 
 	// Write the surface positions and the associated interstitial quantities
 	// in the concentration sub group
-	xolotlCore::HDF5Utils::writeSurface2D(timestep, surfaceIndices,
+	xolotlCore::HDF5Utils::writeSurface2D(file, timestep, surfaceIndices,
 			nInterstitial2D, previousIFlux2D);
 
-	// Loop on the full grid
-	for (PetscInt j = 0; j < My; j++) {
-		for (PetscInt i = 0; i < Mx; i++) {
-			// Wait for all the processes
-			MPI_Barrier(PETSC_COMM_WORLD);
-			// Size of the concentration that will be stored
-			int concSize = -1;
-			// Vector for the concentrations
-			std::vector<std::vector<double> > concVector;
-
-			// If it is the locally owned part of the grid
-			if (i >= xs && i < xs + xm && j >= ys && j < ys + ym) {
-				// Get the pointer to the beginning of the solution data for this grid point
-				gridPointSolution = solutionArray[j][i];
-
-				// Loop on the concentrations
-				concVector.clear();
-				for (int l = 0; l < dof; l++) {
-					if (gridPointSolution[l] > 1.0e-16
-							|| gridPointSolution[l] < -1.0e-16) {
-						// Create the concentration vector for this cluster
-						std::vector<double> conc;
-						conc.push_back((double) l);
-						conc.push_back(gridPointSolution[l]);
-
-						// Add it to the main vector
-						concVector.push_back(conc);
-					}
-				}
-
-				// Send the size of the vector to the other processes
-				concSize = concVector.size();
-				// Loop on all the processes
-				for (int l = 0; l < worldSize; l++) {
-					// Skip its own
-					if (l == procId)
-						continue;
-
-					// Send the size
-					MPI_Send(&concSize, 1, MPI_INT, l, 0, PETSC_COMM_WORLD);
-				}
-			}
-
-			// Else: only receive the conc size
-			else {
-				MPI_Recv(&concSize, 1, MPI_INT, MPI_ANY_SOURCE, 0,
-						PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
-			}
-
-			// Skip the grid point if the size is 0
-			if (concSize == 0)
-				continue;
-
-			// All processes must create the dataset
-			xolotlCore::HDF5Utils::addConcentrationDataset(concSize, i, j);
-
-			// If it is the locally owned part of the grid
-			if (i >= xs && i < xs + xm && j >= ys && j < ys + ym) {
-				// Fill the dataset
-				xolotlCore::HDF5Utils::fillConcentrations(concVector, i, j);
-			}
-		}
-	}
+	// All processes write their part of the grid at once
+	xolotlCore::HDF5Utils::writeConcentrations(file, concArray, concSizes,
+			Mx, xs, xm, My, ys, ym);
 
 	// Finalize the HDF5 file
-	xolotlCore::HDF5Utils::closeFile();
-
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+	xolotlCore::HDF5Utils::closeFile(file);
 
 	PetscFunctionReturn(0);
 }
@@ -304,12 +269,9 @@ PetscErrorCode computeHeliumRetention2D(TS ts, PetscInt, PetscReal time,
 				<< std::endl;
 		std::cout << "Helium fluence = " << heliumFluence << "\n" << std::endl;
 
-		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << heliumFluence << " "
-				<< 100.0 * (totalHeConcentration / heliumFluence) << std::endl;
-		outputFile.close();
+		// Write the retention and the fluence in the telemetry file
+		telemetrySink->append("heliumRetention", { time, heliumFluence, 100.0
+				* (totalHeConcentration / heliumFluence), totalHeConcentration });
 	}
 
 	// Restore the solutionArray
@@ -329,9 +291,7 @@ PetscErrorCode monitorSurface2D(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *) {
 	// Initial declarations
 	PetscErrorCode ierr;
-	const double ***solutionArray, *gridPointSolution;
-	PetscInt xs, xm, Mx, ys, ym, My;
-	double x = 0.0, y = 0.0;
+	PetscInt Mx, My;
 
 	PetscFunctionBeginUser;
 
@@ -348,13 +308,6 @@ PetscErrorCode monitorSurface2D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = TSGetDM(ts, &da);
 	CHKERRQ(ierr);
 
-	// Get the solutionArray
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, &ys, NULL, &xm, &ym, NULL);
-	CHKERRQ(ierr);
 	// Get the size of the total grid
 	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, &My, PETSC_IGNORE,
 	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
@@ -377,6 +330,12 @@ PetscErrorCode monitorSurface2D(TS ts, PetscInt timestep, PetscReal time,
 	// Choice of the cluster to be plotted
 	int iCluster = 19;
 
+	// Gather the concentrations of the whole grid on the master process
+	std::vector<double> concentrations;
+	ierr = gatherConcentrations(da, solution, timestep, time, iCluster, 1,
+			concentrations);
+	CHKERRQ(ierr);
+
 	// Create a Point vector to store the data to give to the data provider
 	// for the visualization
 	auto myPoints = std::make_shared<std::vector<xolotlViz::Point> >();
@@ -384,62 +343,17 @@ PetscErrorCode monitorSurface2D(TS ts, PetscInt timestep, PetscReal time,
 	xolotlViz::Point thePoint;
 
 	// Loop on the full grid
-	for (PetscInt j = 0; j < My; j++) {
-		for (PetscInt i = 0; i < Mx; i++) {
-			// If it is the locally owned part of the grid
-			if (i >= xs && i < xs + xm && j >= ys && j < ys + ym) {
-				// Get the pointer to the beginning of the solution data for this grid point
-				gridPointSolution = solutionArray[j][i];
-				// Compute x and y
-				x = grid[i];
-				y = (double) j * hy;
-
-				// If it is procId 0 just store the value in the myPoints vector
-				if (procId == 0) {
-					// Modify the Point with the gridPointSolution[iCluster] as the value
-					// and add it to myPoints
-					thePoint.value = gridPointSolution[iCluster];
-					thePoint.t = time;
-					thePoint.x = x;
-					thePoint.y = y;
-					myPoints->push_back(thePoint);
-				}
-				// Else, the values must be sent to procId 0
-				else {
-					// Send the value of the local position to the master process
-					MPI_Send(&x, 1, MPI_DOUBLE, 0, 10, PETSC_COMM_WORLD);
-					// Send the value of the local position to the master process
-					MPI_Send(&y, 1, MPI_DOUBLE, 0, 11, PETSC_COMM_WORLD);
-
-					// Send the value of the concentration to the master process
-					MPI_Send(&gridPointSolution[iCluster], 1, MPI_DOUBLE, 0, 12,
-							PETSC_COMM_WORLD);
-				}
-			}
-			// Else if it is NOT the locally owned part of the grid but still procId == 0,
-			// it should receive the values for the point and add them to myPoint
-			else if (procId == 0) {
-				// Get the position
-				MPI_Recv(&x, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 10,
-						PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
-				MPI_Recv(&y, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 11,
-						PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
-
-				// and the concentration
-				double conc = 0.0;
-				MPI_Recv(&conc, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 12,
-						PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
-
-				// Modify the Point with the received values and add it to myPoints
-				thePoint.value = conc;
+	if (procId == 0) {
+		for (PetscInt j = 0; j < My; j++) {
+			for (PetscInt i = 0; i < Mx; i++) {
+				// Modify the Point with the concentration as the value
+				// and add it to myPoints
+				thePoint.value = concentrations[j * Mx + i];
 				thePoint.t = time;
-				thePoint.x = x;
-				thePoint.y = y;
+				thePoint.x = grid[i];
+				thePoint.y = (double) j * hy;
 				myPoints->push_back(thePoint);
 			}
-
-			// Wait for everybody at each grid point
-			MPI_Barrier(PETSC_COMM_WORLD);
 		}
 	}
 
@@ -478,10 +392,6 @@ PetscErrorCode monitorSurface2D(TS ts, PetscInt timestep, PetscReal time,
 		surfacePlot2D->write(fileName.str());
 	}
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
 	PetscFunctionReturn(0);
 }
 
@@ -543,9 +453,6 @@ PetscErrorCode monitorMovingSurface2D(TS ts, PetscInt timestep, PetscReal time,
 	// Get the physical grid
 	auto grid = solverHandler->getXGrid();
 
-	// Setup step size variables
-	double hy = solverHandler->getStepSizeY();
-
 	// Get the initial vacancy concentration
 	double initialVConc = solverHandler->getInitialVConc();
 
@@ -668,20 +575,17 @@ PetscErrorCode monitorMovingSurface2D(TS ts, PetscInt timestep, PetscReal time,
 		}
 	}
 
-	// Reinitialize the modified trap-mutation handler if the surface has moved
+	// Move the surface in the flux and modified trap-mutation handlers if it
+	// has moved, their profile and indices are relative to the surface
 	if (surfaceHasMoved) {
-		// Get the modified trap-mutation handler to reinitialize it
+		auto fluxHandler = solverHandler->getFluxHandler();
 		auto mutationHandler = solverHandler->getMutationHandler();
-		auto advecHandlers = solverHandler->getAdvectionHandlers();
-
-		// Get the vector of positions of the surface
-		std::vector<int> surfaceIndices;
 		for (PetscInt i = 0; i < My; i++) {
-			surfaceIndices.push_back(solverHandler->getSurfacePosition(i));
+			fluxHandler->setSurfacePosition(
+					solverHandler->getSurfacePosition(i));
+			mutationHandler->setSurfacePosition(
+					solverHandler->getSurfacePosition(i), i);
 		}
-
-		mutationHandler->initializeIndex2D(surfaceIndices, network,
-				advecHandlers, grid, My, hy);
 	}
 
 	// Restore the solutionArray
@@ -806,7 +710,7 @@ PetscErrorCode monitorBursting2D(TS ts, PetscInt, PetscReal time,
 					auto cluster = clusters[i];
 					// Get the V cluster of the same size
 					auto comp = cluster->getComposition();
-					auto vCluster = network->get(vType, comp[vType]);
+					auto vCluster = network->get(vType, comp[PSISpecies::V]);
 					int vId = vCluster->getId() - 1;
 					int id = cluster->getId() - 1;
 					gridPointSolution[vId] = gridPointSolution[id];
@@ -913,7 +817,7 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 			hdf5Stride2D = 1.0;
 
 		// Initialize the HDF5 file for all the processes
-		xolotlCore::HDF5Utils::initializeFile(hdf5OutputName2D);
+		auto file = xolotlCore::HDF5Utils::initializeFile(hdf5OutputName2D);
 
 		// Get the solver handler
 		auto solverHandler = PetscSolver::getSolverHandler();
@@ -925,18 +829,18 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 		double hy = solverHandler->getStepSizeY();
 
 		// Save the header in the HDF5 file
-		xolotlCore::HDF5Utils::fillHeader(Mx, grid[1] - grid[0], My, hy);
+		xolotlCore::HDF5Utils::fillHeader(file, Mx, grid[1] - grid[0], My, hy);
 
 		// Save the network in the HDF5 file
-		xolotlCore::HDF5Utils::fillNetwork(solverHandler->getNetworkName());
+		xolotlCore::HDF5Utils::fillNetwork(file, solverHandler->getNetworkName());
 
 		// Finalize the HDF5 file
-		xolotlCore::HDF5Utils::finalizeFile();
+		xolotlCore::HDF5Utils::finalizeFile(file);
 
 		// startStop2D will be called at each timestep
-		ierr = TSMonitorSet(ts, startStop2D, NULL, NULL);
+		ierr = addMonitor(ts, startStop2D);
 		checkPetscError(ierr,
-				"setupPetsc2DMonitor: TSMonitorSet (startStop2D) failed.");
+				"setupPetsc2DMonitor: addMonitor (startStop2D) failed.");
 	}
 
 	// If the user wants the surface to be able to move
@@ -948,38 +852,33 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 			previousIFlux2D.push_back(0.0);
 		}
 
-		// Get the last time step written in the HDF5 file
-		int tempTimeStep = -2;
-		std::string networkName = solverHandler->getNetworkName();
-		bool hasConcentrations = xolotlCore::HDF5Utils::hasConcentrationGroup(
-				networkName, tempTimeStep);
+		// Get the restart information read from the HDF5 file
+		auto restartReader = solverHandler->getRestartReader();
+		bool hasConcentrations = restartReader->hasConcentrations();
 
 		// Get the interstitial information at the surface if concentrations were stored
 		if (hasConcentrations) {
 			// Get the interstitial quantity from the HDF5 file
-			nInterstitial2D = xolotlCore::HDF5Utils::readNInterstitial2D(
-					networkName, tempTimeStep);
+			nInterstitial2D = restartReader->getNInterstitial2D();
 			// Get the previous I flux from the HDF5 file
-			previousIFlux2D = xolotlCore::HDF5Utils::readPreviousIFlux2D(
-					networkName, tempTimeStep);
+			previousIFlux2D = restartReader->getPreviousIFlux2D();
 			// Get the previous time from the HDF5 file
-			previousTime = xolotlCore::HDF5Utils::readPreviousTime(networkName,
-					tempTimeStep);
+			previousTime = restartReader->getPreviousTime();
 		}
 
 		// Set the monitor on the outgoing flux of interstitials at the surface
 		// monitorMovingSurface2D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorMovingSurface2D, NULL, NULL);
+		ierr = addMonitor(ts, monitorMovingSurface2D);
 		checkPetscError(ierr,
-				"setupPetsc2DMonitor: TSMonitorSet (monitorMovingSurface2D) failed.");
+				"setupPetsc2DMonitor: addMonitor (monitorMovingSurface2D) failed.");
 	}
 
 	// If the user wants bubble bursting
 	if (solverHandler->burstBubbles()) {
 		// Set the monitor on the bubble bursting
 		// monitorBursting2D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorBursting2D, NULL, NULL);
-		checkPetscError(ierr, "setupPetsc2DMonitor: TSMonitorSet (monitorBursting2D) failed.");
+		ierr = addMonitor(ts, monitorBursting2D);
+		checkPetscError(ierr, "setupPetsc2DMonitor: addMonitor (monitorBursting2D) failed.");
 		std::srand (time(NULL));
 	}
 
@@ -1009,25 +908,22 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 		}
 
 		// monitorPerf will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorPerf, NULL, NULL);
+		ierr = addMonitor(ts, monitorPerf);
 		checkPetscError(ierr,
-				"setupPetsc2DMonitor: TSMonitorSet (monitorPerf) failed.");
+				"setupPetsc2DMonitor: addMonitor (monitorPerf) failed.");
 	}
 
 	// Set the monitor to compute the helium fluence for the retention calculation
 	if (flagRetention) {
 
-		// Get the last time step written in the HDF5 file
-		int tempTimeStep = -2;
-		std::string networkName = solverHandler->getNetworkName();
-		bool hasConcentrations = xolotlCore::HDF5Utils::hasConcentrationGroup(
-				networkName, tempTimeStep);
+		// Get the restart information read from the HDF5 file
+		auto restartReader = solverHandler->getRestartReader();
+		bool hasConcentrations = restartReader->hasConcentrations();
 
 		// Get the previous time if concentrations were stored and initialize the fluence
 		if (hasConcentrations) {
 			// Get the previous time from the HDF5 file
-			double time = xolotlCore::HDF5Utils::readPreviousTime(networkName,
-					tempTimeStep);
+			double time = restartReader->getPreviousTime();
 			// Initialize the fluence
 			auto fluxHandler = solverHandler->getFluxHandler();
 			// The length of the time step
@@ -1035,24 +931,22 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 			// Increment the fluence with the value at this current timestep
 			fluxHandler->incrementFluence(dt);
 			// Get the previous time from the HDF5 file
-			previousTime = xolotlCore::HDF5Utils::readPreviousTime(networkName,
-					tempTimeStep);
+			previousTime = restartReader->getPreviousTime();
 		}
 
 		// computeFluence will be called at each timestep
-		ierr = TSMonitorSet(ts, computeFluence, NULL, NULL);
+		ierr = addMonitor(ts, computeFluence);
 		checkPetscError(ierr,
-				"setupPetsc2DMonitor: TSMonitorSet (computeFluence) failed.");
+				"setupPetsc2DMonitor: addMonitor (computeFluence) failed.");
 
 		// computeHeliumRetention2D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeHeliumRetention2D, NULL, NULL);
+		ierr = addMonitor(ts, computeHeliumRetention2D);
 		checkPetscError(ierr,
-				"setupPetsc2DMonitor: TSMonitorSet (computeHeliumRetention2D) failed.");
+				"setupPetsc2DMonitor: addMonitor (computeHeliumRetention2D) failed.");
 
-		// Uncomment to clear the file where the retention will be written
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt");
-		outputFile.close();
+		// Create the table where the retention will be written
+		addTelemetryTable("heliumRetention", { "time", "fluence", "retention",
+				"concentration" });
 	}
 
 	// Set the monitor to save surface plots of clusters concentration
@@ -1082,16 +976,16 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 		}
 
 		// monitorSurface2D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorSurface2D, NULL, NULL);
+		ierr = addMonitor(ts, monitorSurface2D);
 		checkPetscError(ierr,
-				"setupPetsc2DMonitor: TSMonitorSet (monitorSurface2D) failed.");
+				"setupPetsc2DMonitor: addMonitor (monitorSurface2D) failed.");
 	}
 
 	// Set the monitor to simply change the previous time to the new time
 	// monitorTime will be called at each timestep
-	ierr = TSMonitorSet(ts, monitorTime, NULL, NULL);
+	ierr = addMonitor(ts, monitorTime);
 	checkPetscError(ierr,
-			"setupPetsc2DMonitor: TSMonitorSet (monitorTime) failed.");
+			"setupPetsc2DMonitor: addMonitor (monitorTime) failed.");
 
 	PetscFunctionReturn(0);
 }
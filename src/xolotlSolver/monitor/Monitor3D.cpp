@@ -16,6 +16,7 @@
 #include <vector>
 #include <memory>
 #include <HDF5Utils.h>
+#include <TelemetrySink.h>
 #include <PSISuperCluster.h>
 #include <NESuperCluster.h>
 
@@ -28,10 +29,18 @@ extern PetscErrorCode computeFluence(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
 extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
+extern PetscErrorCode addMonitor(TS ts,
+		PetscErrorCode (*monitor)(TS, PetscInt, PetscReal, Vec, void *));
+extern PetscErrorCode gatherConcentrations(DM da, Vec solution,
+		PetscInt timestep, PetscReal time, int firstId, int nIds,
+		std::vector<double>& values);
+extern void addTelemetryTable(const std::string& name,
+		const std::vector<std::string>& columns);
 
 // Declaration of the variables defined in Monitor.cpp
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
 extern double previousTime;
+extern std::shared_ptr<xolotlCore::TelemetrySink> telemetrySink;
 
 //! How often HDF5 file is written
 PetscReal hdf5Stride3D = 0.0;
@@ -69,14 +78,6 @@ PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 	// Update the previous time
 	hdf5Previous3D++;
 
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-	// Gets the process ID (important when it is running in parallel)
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -117,99 +118,59 @@ PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 		surfaceIndices.push_back(temp);
 	}
 
-	// Open the already created HDF5 file
-	xolotlCore::HDF5Utils::openFile(hdf5OutputName3D);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration sub group
-	xolotlCore::HDF5Utils::addConcentrationSubGroup(timestep, time,
-			previousTime, currentTimeStep);
-
-	// Write the surface positions in the concentration sub group
-	xolotlCore::HDF5Utils::writeSurface3D(timestep, surfaceIndices,
-			nInterstitial3D, previousIFlux3D);
-
-	// Loop on the full grid
-	for (PetscInt k = 0; k < Mz; k++) {
-		for (PetscInt j = 0; j < My; j++) {
-			for (PetscInt i = 0; i < Mx; i++) {
-				// Wait for all the processes
-				MPI_Barrier(PETSC_COMM_WORLD);
-				// Size of the concentration that will be stored
-				int concSize = -1;
-				// Vector for the concentrations
-				std::vector<std::vector<double> > concVector;
-
-				// If it is the locally owned part of the grid
-				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym && k >= zs
-						&& k < zs + zm) {
-					// Get the pointer to the beginning of the solution data for this grid point
-					gridPointSolution = solutionArray[k][j][i];
-
-					// Loop on the concentrations
-					concVector.clear();
-					for (int l = 0; l < dof; l++) {
-						if (gridPointSolution[l] > 1.0e-16
-								|| gridPointSolution[l] < -1.0e-16) {
-							// Create the concentration vector for this cluster
-							std::vector<double> conc;
-							conc.push_back((double) l);
-							conc.push_back(gridPointSolution[l]);
-
-							// Add it to the main vector
-							concVector.push_back(conc);
-						}
-					}
-
-					// Send the size of the vector to the other processes
-					concSize = concVector.size();
-					// Loop on all the processes
-					for (int l = 0; l < worldSize; l++) {
-						// Skip its own
-						if (l == procId)
-							continue;
-
-						// Send the size
-						MPI_Send(&concSize, 1, MPI_INT, l, 0, PETSC_COMM_WORLD);
+	// Get the non-zero concentrations of the locally owned grid points
+	std::vector<double> concArray;
+	std::vector<int> concSizes;
+	for (PetscInt k = zs; k < zs + zm; k++) {
+		for (PetscInt j = ys; j < ys + ym; j++) {
+			for (PetscInt i = xs; i < xs + xm; i++) {
+				// Get the pointer to the beginning of the solution data for this grid point
+				gridPointSolution = solutionArray[k][j][i];
+
+				// Loop on the concentrations
+				int concSize = 0;
+				for (int l = 0; l < dof; l++) {
+					if (gridPointSolution[l] > 1.0e-16
+							|| gridPointSolution[l] < -1.0e-16) {
+						// Add the index and concentration of this cluster
+						concArray.push_back((double) l);
+						concArray.push_back(gridPointSolution[l]);
+						concSize++;
 					}
 				}
-
-				// Else: only receive the conc size
-				else {
-					MPI_Recv(&concSize, 1, MPI_INT, MPI_ANY_SOURCE, 0,
-							PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
-				}
-
-				// Skip the grid point if the size is 0
-				if (concSize == 0)
-					continue;
-
-				// All processes must create the dataset
-				xolotlCore::HDF5Utils::addConcentrationDataset(concSize, i, j,
-						k);
-
-				// If it is the locally owned part of the grid
-				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym && k >= zs
-						&& k < zs + zm) {
-					// Fill the dataset
-					xolotlCore::HDF5Utils::fillConcentrations(concVector, i, j,
-							k);
-				}
+				concSizes.push_back(concSize);
 			}
 		}
 	}
 
-	// Finalize the HDF5 file
-	xolotlCore::HDF5Utils::closeFile();
-
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
+	// Open the already created HDF5 file
+	auto file = xolotlCore::HDF5Utils::openFile(hdf5OutputName3D,
+			PETSC_COMM_WORLD);
+
+	// Add a concentration sub group
+	xolotlCore::HDF5Utils::addConcentrationSubGroup(file, timestep, time,
+			previousTime, currentTimeStep);
+
+	// Write the surface positions in the concentration sub group
+	xolotlCore::HDF5Utils::writeSurface3D(file, timestep, surfaceIndices,
+			nInterstitial3D, previousIFlux3D);
+
+	// All processes write their part of the grid at once
+	xolotlCore::HDF5Utils::writeConcentrations(file, concArray, concSizes,
+			Mx, xs, xm, My, ys, ym, Mz, zs, zm);
+
+	// Finalize the HDF5 file
+	xolotlCore::HDF5Utils::closeFile(file);
+
 	PetscFunctionReturn(0);
 }
 
@@ -323,12 +284,9 @@ PetscErrorCode computeHeliumRetention3D(TS ts, PetscInt, PetscReal time,
 				<< std::endl;
 		std::cout << "Helium fluence = " << heliumFluence << "\n" << std::endl;
 
-		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << heliumFluence << " "
-				<< 100.0 * (totalHeConcentration / heliumFluence) << std::endl;
-		outputFile.close();
+		// Write the retention and the fluence in the telemetry file
+		telemetrySink->append("heliumRetention", { time, heliumFluence, 100.0
+				* (totalHeConcentration / heliumFluence), totalHeConcentration });
 	}
 
 	// Restore the solutionArray
@@ -348,9 +306,7 @@ PetscErrorCode monitorSurfaceXY3D(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *) {
 	// Initial declarations
 	PetscErrorCode ierr;
-	const double ****solutionArray, *gridPointSolution;
-	PetscInt xs, xm, Mx, ys, ym, My, zs, zm, Mz;
-	double x, y;
+	PetscInt Mx, My, Mz;
 
 	PetscFunctionBeginUser;
 
@@ -367,13 +323,6 @@ PetscErrorCode monitorSurfaceXY3D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = TSGetDM(ts, &da);
 	CHKERRQ(ierr);
 
-	// Get the solutionArray
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, &ys, &zs, &xm, &ym, &zm);
-	CHKERRQ(ierr);
 	// Get the size of the total grid
 	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, &My, &Mz,
 	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
@@ -396,6 +345,13 @@ PetscErrorCode monitorSurfaceXY3D(TS ts, PetscInt timestep, PetscReal time,
 	// Choice of the cluster to be plotted
 	int iCluster = 0;
 
+	// Gather the concentrations of the whole grid on the master process, the
+	// other surface plot uses the same ones
+	std::vector<double> concentrations;
+	ierr = gatherConcentrations(da, solution, timestep, time, iCluster, 1,
+			concentrations);
+	CHKERRQ(ierr);
+
 	// Create a Point vector to store the data to give to the data provider
 	// for the visualization
 	auto myPoints = std::make_shared<std::vector<xolotlViz::Point> >();
@@ -403,40 +359,20 @@ PetscErrorCode monitorSurfaceXY3D(TS ts, PetscInt timestep, PetscReal time,
 	xolotlViz::Point thePoint;
 
 	// Loop on the full grid, Y and X first because they are the axis of the plot
-	for (PetscInt j = 0; j < My; j++) {
-		// Compute y
-		y = (double) j * hy;
-
-		for (PetscInt i = 0; i < Mx; i++) {
-			// Compute x
-			x = grid[i];
-
-			// Initialize the value of the concentration to integrate over Z
-			double conc = 0.0;
-
-			for (PetscInt k = 0; k < Mz; k++) {
-				// If it is the locally owned part of the grid
-				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym && k >= zs
-						&& k < zs + zm) {
-					// Get the pointer to the beginning of the solution data for this grid point
-					gridPointSolution = solutionArray[k][j][i];
-
-					// Integrate over Z
-					conc += gridPointSolution[iCluster];
+	if (procId == 0) {
+		for (PetscInt j = 0; j < My; j++) {
+			for (PetscInt i = 0; i < Mx; i++) {
+				// Integrate over Z
+				double totalConc = 0.0;
+				for (PetscInt k = 0; k < Mz; k++) {
+					totalConc += concentrations[(k * My + j) * Mx + i];
 				}
-			} // End of the loop on Z
-
-			// Sum all the concentration on Z
-			double totalConc = 0.0;
-			MPI_Reduce(&conc, &totalConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-					PETSC_COMM_WORLD);
 
-			// If it is procId == 0 just store the integrated value in the myPoints vector
-			if (procId == 0) {
+				// Store the integrated value in the myPoints vector
 				thePoint.value = totalConc;
 				thePoint.t = time;
-				thePoint.x = x;
-				thePoint.y = y;
+				thePoint.x = grid[i];
+				thePoint.y = (double) j * hy;
 				myPoints->push_back(thePoint);
 			}
 		}
@@ -477,10 +413,6 @@ PetscErrorCode monitorSurfaceXY3D(TS ts, PetscInt timestep, PetscReal time,
 		surfacePlotXY3D->write(fileName.str());
 	}
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
 	PetscFunctionReturn(0);
 }
 
@@ -494,9 +426,7 @@ PetscErrorCode monitorSurfaceXZ3D(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *) {
 	// Initial declarations
 	PetscErrorCode ierr;
-	const double ****solutionArray, *gridPointSolution;
-	PetscInt xs, xm, Mx, ys, ym, My, zs, zm, Mz;
-	double x, z;
+	PetscInt Mx, My, Mz;
 
 	PetscFunctionBeginUser;
 
@@ -513,13 +443,6 @@ PetscErrorCode monitorSurfaceXZ3D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = TSGetDM(ts, &da);
 	CHKERRQ(ierr);
 
-	// Get the solutionArray
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, &ys, &zs, &xm, &ym, &zm);
-	CHKERRQ(ierr);
 	// Get the size of the total grid
 	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, &My, &Mz,
 	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
@@ -542,6 +465,13 @@ PetscErrorCode monitorSurfaceXZ3D(TS ts, PetscInt timestep, PetscReal time,
 	// Choice of the cluster to be plotted
 	int iCluster = 0;
 
+	// Gather the concentrations of the whole grid on the master process, the
+	// other surface plot uses the same ones
+	std::vector<double> concentrations;
+	ierr = gatherConcentrations(da, solution, timestep, time, iCluster, 1,
+			concentrations);
+	CHKERRQ(ierr);
+
 	// Create a Point vector to store the data to give to the data provider
 	// for the visualization
 	auto myPoints = std::make_shared<std::vector<xolotlViz::Point> >();
@@ -549,40 +479,20 @@ PetscErrorCode monitorSurfaceXZ3D(TS ts, PetscInt timestep, PetscReal time,
 	xolotlViz::Point thePoint;
 
 	// Loop on the full grid, Z and X first because they are the axis of the plot
-	for (PetscInt k = 0; k < Mz; k++) {
-		// Compute z
-		z = (double) k * hz;
-
-		for (PetscInt i = 0; i < Mx; i++) {
-			// Compute x
-			x = grid[i];
-
-			// Initialize the value of the concentration to integrate over Y
-			double conc = 0.0;
-
-			for (PetscInt j = 0; j < My; j++) {
-				// If it is the locally owned part of the grid
-				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym && k >= zs
-						&& k < zs + zm) {
-					// Get the pointer to the beginning of the solution data for this grid point
-					gridPointSolution = solutionArray[k][j][i];
-
-					// Integrate over Y
-					conc += gridPointSolution[iCluster];
+	if (procId == 0) {
+		for (PetscInt k = 0; k < Mz; k++) {
+			for (PetscInt i = 0; i < Mx; i++) {
+				// Integrate over Y
+				double totalConc = 0.0;
+				for (PetscInt j = 0; j < My; j++) {
+					totalConc += concentrations[(k * My + j) * Mx + i];
 				}
-			} // End of the loop on Y
-
-			// Sum all the concentration on Y
-			double totalConc = 0.0;
-			MPI_Reduce(&conc, &totalConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-					PETSC_COMM_WORLD);
 
-			// If it is procId == 0 just store the integrated value in the myPoints vector
-			if (procId == 0) {
+				// Store the integrated value in the myPoints vector
 				thePoint.value = totalConc;
 				thePoint.t = time;
-				thePoint.x = x;
-				thePoint.y = z;
+				thePoint.x = grid[i];
+				thePoint.y = (double) k * hz;
 				myPoints->push_back(thePoint);
 			}
 		}
@@ -623,10 +533,6 @@ PetscErrorCode monitorSurfaceXZ3D(TS ts, PetscInt timestep, PetscReal time,
 		surfacePlotXZ3D->write(fileName.str());
 	}
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
 	PetscFunctionReturn(0);
 }
 
@@ -685,10 +591,6 @@ PetscErrorCode monitorMovingSurface3D(TS ts, PetscInt timestep, PetscReal time,
 	if (singleVacancyCluster)
 		vacancyIndex = singleVacancyCluster->getId() - 1;
 
-	// Setup step size variables
-	double hy = solverHandler->getStepSizeY();
-	double hz = solverHandler->getStepSizeZ();
-
 	// Get the initial vacancy concentration
 	double initialVConc = solverHandler->getInitialVConc();
 
@@ -820,26 +722,19 @@ PetscErrorCode monitorMovingSurface3D(TS ts, PetscInt timestep, PetscReal time,
 		}
 	}
 
-	// Reinitialize the modified trap-mutation handler if the surface has moved
+	// Move the surface in the flux and modified trap-mutation handlers if it
+	// has moved, their profile and indices are relative to the surface
 	if (surfaceHasMoved) {
-		// Get the modified trap-mutation handler to reinitialize it
+		auto fluxHandler = solverHandler->getFluxHandler();
 		auto mutationHandler = solverHandler->getMutationHandler();
-		auto advecHandlers = solverHandler->getAdvectionHandlers();
-
-		// Get the vector of positions of the surface
-		std::vector<std::vector<int> > surfaceIndices;
 		for (PetscInt i = 0; i < My; i++) {
-			// Create a temporary vector
-			std::vector<int> temp;
 			for (PetscInt j = 0; j < Mz; j++) {
-				temp.push_back(solverHandler->getSurfacePosition(i, j));
+				fluxHandler->setSurfacePosition(
+						solverHandler->getSurfacePosition(i, j));
+				mutationHandler->setSurfacePosition(
+						solverHandler->getSurfacePosition(i, j), i, j);
 			}
-			// Add the temporary vector to the vector of surface indices
-			surfaceIndices.push_back(temp);
 		}
-
-		mutationHandler->initializeIndex3D(surfaceIndices, network,
-				advecHandlers, grid, My, hy, Mz, hz);
 	}
 
 	// Write the surface position in a file
@@ -993,7 +888,7 @@ PetscErrorCode monitorBursting3D(TS ts, PetscInt, PetscReal time,
 						auto cluster = clusters[i];
 						// Get the V cluster of the same size
 						auto comp = cluster->getComposition();
-						auto vCluster = network->get(vType, comp[vType]);
+						auto vCluster = network->get(vType, comp[PSISpecies::V]);
 						int vId = vCluster->getId() - 1;
 						int id = cluster->getId() - 1;
 						gridPointSolution[vId] = gridPointSolution[id];
@@ -1106,7 +1001,7 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 			hdf5Stride3D = 1.0;
 
 		// Initialize the HDF5 file for all the processes
-		xolotlCore::HDF5Utils::initializeFile(hdf5OutputName3D);
+		auto file = xolotlCore::HDF5Utils::initializeFile(hdf5OutputName3D);
 
 		// Get the solver handler
 		auto solverHandler = PetscSolver::getSolverHandler();
@@ -1119,19 +1014,19 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 		double hz = solverHandler->getStepSizeZ();
 
 		// Save the header in the HDF5 file
-		xolotlCore::HDF5Utils::fillHeader(Mx, grid[1] - grid[0], My, hy, Mz,
+		xolotlCore::HDF5Utils::fillHeader(file, Mx, grid[1] - grid[0], My, hy, Mz,
 				hz);
 
 		// Save the network in the HDF5 file
-		xolotlCore::HDF5Utils::fillNetwork(solverHandler->getNetworkName());
+		xolotlCore::HDF5Utils::fillNetwork(file, solverHandler->getNetworkName());
 
 		// Finalize the HDF5 file
-		xolotlCore::HDF5Utils::finalizeFile();
+		xolotlCore::HDF5Utils::finalizeFile(file);
 
 		// startStop3D will be called at each timestep
-		ierr = TSMonitorSet(ts, startStop3D, NULL, NULL);
+		ierr = addMonitor(ts, startStop3D);
 		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (startStop3D) failed.");
+				"setupPetsc3DMonitor: addMonitor (startStop3D) failed.");
 	}
 
 	// If the user wants the surface to be able to move
@@ -1150,38 +1045,33 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 			previousIFlux3D.push_back(tempVector);
 		}
 
-		// Get the last time step written in the HDF5 file
-		int tempTimeStep = -2;
-		std::string networkName = solverHandler->getNetworkName();
-		bool hasConcentrations = xolotlCore::HDF5Utils::hasConcentrationGroup(
-				networkName, tempTimeStep);
+		// Get the restart information read from the HDF5 file
+		auto restartReader = solverHandler->getRestartReader();
+		bool hasConcentrations = restartReader->hasConcentrations();
 
 		// Get the interstitial information at the surface if concentrations were stored
 		if (hasConcentrations) {
 			// Get the interstitial quantity from the HDF5 file
-			nInterstitial3D = xolotlCore::HDF5Utils::readNInterstitial3D(
-					networkName, tempTimeStep);
+			nInterstitial3D = restartReader->getNInterstitial3D();
 			// Get the previous I flux from the HDF5 file
-			previousIFlux3D = xolotlCore::HDF5Utils::readPreviousIFlux3D(
-					networkName, tempTimeStep);
+			previousIFlux3D = restartReader->getPreviousIFlux3D();
 			// Get the previous time from the HDF5 file
-			previousTime = xolotlCore::HDF5Utils::readPreviousTime(networkName,
-					tempTimeStep);
+			previousTime = restartReader->getPreviousTime();
 		}
 
 		// Set the monitor on the outgoing flux of interstitials at the surface
 		// monitorMovingSurface3D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorMovingSurface3D, NULL, NULL);
+		ierr = addMonitor(ts, monitorMovingSurface3D);
 		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (monitorMovingSurface3D) failed.");
+				"setupPetsc3DMonitor: addMonitor (monitorMovingSurface3D) failed.");
 	}
 
 	// If the user wants bubble bursting
 	if (solverHandler->burstBubbles()) {
 		// Set the monitor on the bubble bursting
 		// monitorBursting3D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorBursting3D, NULL, NULL);
-		checkPetscError(ierr, "setupPetsc3DMonitor: TSMonitorSet (monitorBursting3D) failed.");
+		ierr = addMonitor(ts, monitorBursting3D);
+		checkPetscError(ierr, "setupPetsc3DMonitor: addMonitor (monitorBursting3D) failed.");
 		std::srand (time(NULL));
 	}
 
@@ -1211,25 +1101,22 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 		}
 
 		// monitorPerf will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorPerf, NULL, NULL);
+		ierr = addMonitor(ts, monitorPerf);
 		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (monitorPerf) failed.");
+				"setupPetsc3DMonitor: addMonitor (monitorPerf) failed.");
 	}
 
 	// Set the monitor to compute the helium fluence for the retention calculation
 	if (flagRetention) {
 
-		// Get the last time step written in the HDF5 file
-		int tempTimeStep = -2;
-		std::string networkName = solverHandler->getNetworkName();
-		bool hasConcentrations = xolotlCore::HDF5Utils::hasConcentrationGroup(
-				networkName, tempTimeStep);
+		// Get the restart information read from the HDF5 file
+		auto restartReader = solverHandler->getRestartReader();
+		bool hasConcentrations = restartReader->hasConcentrations();
 
 		// Get the previous time if concentrations were stored and initialize the fluence
 		if (hasConcentrations) {
 			// Get the previous time from the HDF5 file
-			double time = xolotlCore::HDF5Utils::readPreviousTime(networkName,
-					tempTimeStep);
+			double time = restartReader->getPreviousTime();
 			// Initialize the fluence
 			auto fluxHandler = solverHandler->getFluxHandler();
 			// The length of the time step
@@ -1237,24 +1124,22 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 			// Increment the fluence with the value at this current timestep
 			fluxHandler->incrementFluence(dt);
 			// Get the previous time from the HDF5 file
-			previousTime = xolotlCore::HDF5Utils::readPreviousTime(networkName,
-					tempTimeStep);
+			previousTime = restartReader->getPreviousTime();
 		}
 
 		// computeFluence will be called at each timestep
-		ierr = TSMonitorSet(ts, computeFluence, NULL, NULL);
+		ierr = addMonitor(ts, computeFluence);
 		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (computeFluence) failed.");
+				"setupPetsc3DMonitor: addMonitor (computeFluence) failed.");
 
 		// computeHeliumRetention3D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeHeliumRetention3D, NULL, NULL);
+		ierr = addMonitor(ts, computeHeliumRetention3D);
 		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (computeHeliumRetention3D) failed.");
+				"setupPetsc3DMonitor: addMonitor (computeHeliumRetention3D) failed.");
 
-		// Uncomment to clear the file where the retention will be written
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt");
-		outputFile.close();
+		// Create the table where the retention will be written
+		addTelemetryTable("heliumRetention", { "time", "fluence", "retention",
+				"concentration" });
 	}
 
 	// Set the monitor to save surface plots of clusters concentration
@@ -1284,9 +1169,9 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 		}
 
 		// monitorSurfaceXY3D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorSurfaceXY3D, NULL, NULL);
+		ierr = addMonitor(ts, monitorSurfaceXY3D);
 		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (monitorSurfaceXY3D) failed.");
+				"setupPetsc3DMonitor: addMonitor (monitorSurfaceXY3D) failed.");
 	}
 
 	// Set the monitor to save surface plots of clusters concentration
@@ -1316,16 +1201,16 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 		}
 
 		// monitorSurfaceXZ3D will be called at each timestep
-		ierr = TSMonitorSet(ts, monitorSurfaceXZ3D, NULL, NULL);
+		ierr = addMonitor(ts, monitorSurfaceXZ3D);
 		checkPetscError(ierr,
-				"setupPetsc3DMonitor: TSMonitorSet (monitorSurfaceXZ3D) failed.");
+				"setupPetsc3DMonitor: addMonitor (monitorSurfaceXZ3D) failed.");
 	}
 
 	// Set the monitor to simply change the previous time to the new time
 	// monitorTime will be called at each timestep
-	ierr = TSMonitorSet(ts, monitorTime, NULL, NULL);
+	ierr = addMonitor(ts, monitorTime);
 	checkPetscError(ierr,
-			"setupPetsc3DMonitor: TSMonitorSet (monitorTime) failed.");
+			"setupPetsc3DMonitor: addMonitor (monitorTime) failed.");
 
 	PetscFunctionReturn(0);
 }
@@ -1,8 +1,9 @@
 // Includes
 #include <PetscSolver1DHandler.h>
-#include <HDF5Utils.h>
+#include <HDF5RestartReader.h>
 #include <MathUtils.h>
 #include <Constants.h>
+#include <cstdlib>
 
 namespace xolotlSolver 
 {
@@ -54,18 +55,14 @@ namespace xolotlSolver
  Create distributed array (DMDA) to manage parallel grid and vectors
  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
+// Open the HDF5 file once, it is kept open until the concentrations are
+// initialized
+  restartReader = std::make_shared<xolotlCore::HDF5RestartReader>(networkName);
+
 // Get starting conditions from HDF5 file
   int    nx = 0,   ny = 0,   nz = 0;
   double hx = 0.0, hy = 0.0, hz = 0.0;
-  xolotlCore::HDF5Utils::readHeader(networkName, nx, hx, ny, hy, nz, hz);
-
-  ierr = DMDACreate1d( PETSC_COMM_WORLD, DM_BOUNDARY_GHOSTED, nx, dof, 1,
-                       NULL, &da );
-  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: DMDACreate1d failed.");
-  ierr = DMSetFromOptions(da);
-  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: DMSetFromOptions failed.");
-  ierr = DMSetUp(da);
-  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: DMSetUp failed.");
+  restartReader->getHeader(nx, hx, ny, hy, nz, hz);
 
 // Set the position of the surface
   surfacePosition = 0;
@@ -76,13 +73,49 @@ namespace xolotlSolver
 
 // Now that the grid was generated, we can update the surface position
 // if we are using a restart file
-  int tempTimeStep = -2;
-  bool hasConcentrations = xolotlCore::HDF5Utils::hasConcentrationGroup( networkName, tempTimeStep);
-  if (hasConcentrations) 
+  if (restartReader->hasConcentrations()) 
   {
-   surfacePosition = xolotlCore::HDF5Utils::readSurface1D(networkName, tempTimeStep);
+   surfacePosition = restartReader->getSurface1D();
   }
 
+// Read the load balancing options
+  PetscBool flagBalance, flagMeasured, flagThreshold;
+  ierr = PetscOptionsHasName(NULL, NULL, "-xolotl_balance", &flagBalance);
+  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: "
+                        "PetscOptionsHasName (-xolotl_balance) failed.");
+  PetscInt threshold = 0;
+  ierr = PetscOptionsGetInt(NULL, NULL, "-xolotl_balance_threshold", &threshold,
+                            &flagThreshold);
+  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: "
+                        "PetscOptionsGetInt (-xolotl_balance_threshold) failed.");
+  ierr = PetscOptionsHasName(NULL, NULL, "-xolotl_balance_measured", &flagMeasured);
+  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: "
+                        "PetscOptionsHasName (-xolotl_balance_measured) failed.");
+  loadBalancing = flagBalance;
+  repartitionThreshold = (loadBalancing && flagThreshold) ? threshold : 0;
+  if (loadBalancing && flagMeasured) pointTimes.assign(nx, 0.0);
+  partitionSurfacePosition = surfacePosition;
+
+// Split the grid points between the processes from their modeled cost
+// (nothing was measured yet), or evenly
+  std::vector<PetscInt> ownershipRanges;
+  if (loadBalancing) 
+  {
+   int nProcs;
+   MPI_Comm_size(PETSC_COMM_WORLD, &nProcs);
+   auto ranges = GridPartitioner::computeOwnershipRanges(getPointCosts(), nProcs);
+   ownershipRanges.assign(ranges.begin(), ranges.end());
+  }
+
+  ierr = DMDACreate1d( PETSC_COMM_WORLD, DM_BOUNDARY_GHOSTED, nx, dof, 1,
+                       ownershipRanges.empty() ? NULL : ownershipRanges.data(),
+                       &da );
+  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: DMDACreate1d failed.");
+  ierr = DMSetFromOptions(da);
+  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: DMSetFromOptions failed.");
+  ierr = DMSetUp(da);
+  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: DMSetUp failed.");
+
 // Initialize the surface of the first advection handler corresponding to the
 // advection toward the surface (or a dummy one if it is deactivated)
   advectionHandlers[0]->setLocation( grid[surfacePosition] );
@@ -92,10 +125,6 @@ namespace xolotlSolver
 //	}
 //	std::cout << std::endl;
 
-// Set the size of the partial derivatives vectors
-  clusterPartials.resize(dof, 0.0);
-  reactingPartialsForCluster.resize(dof, 0.0);
-
 /*  The only spatial coupling in the Jacobian is due to diffusion.
  *  The ofill (thought of as a dof by dof 2d (row-oriented) array represents
  *  the nonzero coupling between degrees of freedom at one point with degrees
@@ -104,17 +133,10 @@ namespace xolotlSolver
  *  to degree of freedom j at the adjacent point.
  *  In this case ofill has only a few diagonal entries since the only spatial
  *  coupling is regular diffusion.
+ *  Both ofill and dfill are stored in a sparse format, only the column
+ *  indices of the 1s of each row are kept.
  */
-  PetscInt* ofill;
-  PetscInt* dfill;
-  ierr = PetscMalloc(dof * dof * sizeof(PetscInt), &ofill);
-  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: PetscMalloc (ofill) failed.");
-  ierr = PetscMalloc(dof * dof * sizeof(PetscInt), &dfill);
-  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: PetscMalloc (dfill) failed.");
-  ierr = PetscMemzero(ofill, dof * dof * sizeof(PetscInt));
-  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: PetscMemzero (ofill) failed.");
-  ierr = PetscMemzero(dfill, dof * dof * sizeof(PetscInt));
-  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: PetscMemzero (dfill) failed.");
+  xolotlCore::SparseFillMap ofill, dfill;
 
 // Fill ofill, the matrix of "off-diagonal" elements that represents diffusion
   diffusionHandler->initializeOFill(network, ofill);
@@ -132,15 +154,125 @@ namespace xolotlSolver
 // Get the diagonal fill
   network->getDiagonalFill(dfill);
 
+// Set the size of the partial derivatives vector to the number of non-zero
+// entries of the reaction block
+  reactionPartials.resize(network->getPartialsRowPointers()[dof], 0.0);
+
+// And the vectors used at each grid point
+  initializeScratch();
+
 // Load up the block fills
-  ierr = DMDASetBlockFills(da, dfill, ofill);
-  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: DMDASetBlockFills failed.");
+  setBlockFills(da, dof, dfill, ofill);
 
-// Free the temporary fill arrays
-  ierr = PetscFree(ofill);
-  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: PetscFree (ofill) failed.");
-  ierr = PetscFree(dfill);
-  checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: PetscFree (dfill) failed.");
+// Only send the mobile clusters to the ghost points
+  createGhostScatter(da, dof, ofill);
+
+  return;
+ }
+
+//--------------------------------------------------------------------------------
+ std::vector<double> 
+ PetscSolver1DHandler::getPointCosts() 
+ {
+// Sum the times measured by each process on its own grid points
+  if (!pointTimes.empty()) 
+  {
+   std::vector<double> times(pointTimes.size(), 0.0);
+   MPI_Allreduce(pointTimes.data(), times.data(), times.size(), MPI_DOUBLE,
+                 MPI_SUM, PETSC_COMM_WORLD);
+
+// Use them if the RHS was evaluated
+   double totalTime = 0.0;
+   for (int i = 0; i < times.size(); i++) totalTime += times[i];
+   if (totalTime > 0.0) return times;
+  }
+
+  return GridPartitioner::computeModelCosts(grid, surfacePosition,
+                                            GridPartitioner::surfaceDepth);
+ }
+
+//--------------------------------------------------------------------------------
+ bool 
+ PetscSolver1DHandler::needRepartition() const 
+ {
+  return repartitionThreshold > 0
+         && std::abs(surfacePosition - partitionSurfacePosition) > repartitionThreshold;
+ }
+
+//--------------------------------------------------------------------------------
+ void 
+ PetscSolver1DHandler::repartition( DM& da, Vec& C ) 
+ {
+  PetscErrorCode ierr;
+
+// Compute the new split of the grid points from their current cost
+  int nProcs;
+  MPI_Comm_size(PETSC_COMM_WORLD, &nProcs);
+  auto costs = getPointCosts();
+  auto ranges = GridPartitioner::computeOwnershipRanges(costs, nProcs);
+  std::vector<PetscInt> ownershipRanges(ranges.begin(), ranges.end());
+
+// Get the current split to report the improvement
+  const PetscInt *oldOwnershipRanges = nullptr;
+  ierr = DMDAGetOwnershipRanges(da, &oldOwnershipRanges, NULL, NULL);
+  checkPetscError(ierr, "PetscSolver1DHandler::repartition: "
+                        "DMDAGetOwnershipRanges failed.");
+  std::vector<int> oldRanges(oldOwnershipRanges, oldOwnershipRanges + nProcs);
+
+// Create the new distributed array with the same grid, degrees of freedom,
+// block fills and ghost exchange
+  const int dof = network->getDOF();
+  DM newDA;
+  ierr = DMDACreate1d( PETSC_COMM_WORLD, DM_BOUNDARY_GHOSTED, grid.size(), dof, 1,
+                       ownershipRanges.data(), &newDA );
+  checkPetscError(ierr, "PetscSolver1DHandler::repartition: DMDACreate1d failed.");
+  ierr = DMSetFromOptions(newDA);
+  checkPetscError(ierr, "PetscSolver1DHandler::repartition: DMSetFromOptions failed.");
+  ierr = DMSetUp(newDA);
+  checkPetscError(ierr, "PetscSolver1DHandler::repartition: DMSetUp failed.");
+  ierr = DMDASetBlockFillsSparse(newDA, dfillSparse.data(), ofillSparse.data());
+  checkPetscError(ierr, "PetscSolver1DHandler::repartition: "
+                        "DMDASetBlockFillsSparse failed.");
+  attachGhostScatter(newDA, dof);
+
+// Migrate the solution. In 1D the global ordering of the distributed array
+// is the natural one whatever the split, so every value keeps its index.
+  Vec newC;
+  ierr = DMCreateGlobalVector(newDA, &newC);
+  checkPetscError(ierr, "PetscSolver1DHandler::repartition: "
+                        "DMCreateGlobalVector failed.");
+  VecScatter scatter;
+  ierr = VecScatterCreate(C, NULL, newC, NULL, &scatter);
+  checkPetscError(ierr, "PetscSolver1DHandler::repartition: VecScatterCreate failed.");
+  ierr = VecScatterBegin(scatter, C, newC, INSERT_VALUES, SCATTER_FORWARD);
+  checkPetscError(ierr, "PetscSolver1DHandler::repartition: VecScatterBegin failed.");
+  ierr = VecScatterEnd(scatter, C, newC, INSERT_VALUES, SCATTER_FORWARD);
+  checkPetscError(ierr, "PetscSolver1DHandler::repartition: VecScatterEnd failed.");
+  ierr = VecScatterDestroy(&scatter);
+  checkPetscError(ierr, "PetscSolver1DHandler::repartition: VecScatterDestroy failed.");
+
+// Replace the old ones
+  ierr = VecDestroy(&C);
+  checkPetscError(ierr, "PetscSolver1DHandler::repartition: VecDestroy failed.");
+  ierr = DMDestroy(&da);
+  checkPetscError(ierr, "PetscSolver1DHandler::repartition: DMDestroy failed.");
+  C = newC;
+  da = newDA;
+
+// Measure the times of the new split from the beginning
+  if (!pointTimes.empty()) pointTimes.assign(pointTimes.size(), 0.0);
+  partitionSurfacePosition = surfacePosition;
+
+// Report the imbalance on the master process
+  int procId;
+  MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+  if (procId == 0) 
+  {
+   std::cout << "Repartitioned the grid for the surface at " << surfacePosition
+             << ", imbalance: " << GridPartitioner::computeImbalance(costs, oldRanges)
+             << " -> " << GridPartitioner::computeImbalance(costs, ranges)
+             << std::endl;
+  }
 
   return;
  }
@@ -163,11 +295,6 @@ namespace xolotlSolver
   checkPetscError(ierr, "PetscSolver1DHandler::initializeConcentration: "
                         "DMDAGetCorners failed.");
 
-// Get the last time step written in the HDF5 file
-  int tempTimeStep = -2;
-  bool hasConcentrations = xolotlCore::HDF5Utils::hasConcentrationGroup( networkName, 
-                                                  tempTimeStep);
-
 // Get the total size of the grid for the boundary conditions
   int xSize = grid.size();
 
@@ -212,26 +339,29 @@ namespace xolotlSolver
   }
 
 // If the concentration must be set from the HDF5 file
-  if (hasConcentrations) 
+  if (restartReader && restartReader->hasConcentrations()) 
   {
-// Loop on the full grid
-   for (int i = 0; i < xSize; i++) 
+// Read the concentrations of the locally owned grid points only
+   std::vector<double> concArray;
+   std::vector<int> concSizes;
+   restartReader->readConcentrations(concArray, concSizes, xs, xm);
+
+// Loop on the local grid points
+   int l = 0;
+   for (PetscInt i = xs; i < xs + xm; i++) 
    {
-// Read the concentrations from the HDF5 file
-    auto concVector = xolotlCore::HDF5Utils::readGridPoint(networkName, tempTimeStep, i);
-
-// Change the concentration only if we are on the locally owned part of the grid
-    if (i >= xs && i < xs + xm) 
+    concOffset = concentrations[i];
+// Loop on the concentrations of this grid point
+    for (int n = 0; n < concSizes[i - xs]; n++, l++) 
     {
-     concOffset = concentrations[i];
-// Loop on the concVector size
-     for (unsigned int l = 0; l < concVector.size(); l++) 
-     {
-      concOffset[(int) concVector.at(l).at(0)] = concVector.at(l).at(1);
-     }
+     concOffset[(int) concArray[2 * l]] = concArray[2 * l + 1];
     }
    }
   }
+
+// Everything was read, close the file
+  restartReader.reset();
+
 /*
  Restore vectors
  */
@@ -249,6 +379,12 @@ namespace xolotlSolver
  {
   PetscErrorCode ierr;
 
+// Compute the temperature on the grid at this time
+  updateTemperatures(ftime);
+
+// Drop the cached rate tables if the temperature field changed
+  updateRateTables(ftime);
+
 // Get the local data vector from PETSc
   DM da;
   ierr = TSGetDM(ts, &da);
@@ -314,12 +450,24 @@ namespace xolotlSolver
   mutationHandler->updateDisappearingRate(totalAtomConc);
 
 // Declarations for variables used in the loop
-  double **concVector = new double*[3];
-  std::vector<double> gridPosition = { 0.0, 0.0, 0.0 };
+  double *concVector[3];
+
+// The time of each grid point is the time between the start of its
+// iteration and the start of the next one, plus the time of its delayed
+// reactions
+  const bool measureTimes = !pointTimes.empty();
+  double pointStartTime = measureTimes ? MPI_Wtime() : 0.0;
 
 // Loop over grid points computing ODE terms for each grid point
   for (PetscInt xi = xs; xi < xs + xm; xi++) 
   {
+   if (measureTimes && xi > xs) 
+   {
+    double now = MPI_Wtime();
+    pointTimes[xi - 1] += now - pointStartTime;
+    pointStartTime = now;
+   }
+
 // Compute the old and new array offsets
    concOffset = concs[xi];
    updatedConcOffset = updatedConcs[xi];
@@ -344,25 +492,11 @@ namespace xolotlSolver
    concVector[1] = concs[xi - 1]; // left
    concVector[2] = concs[xi + 1]; // right
 
-// Get the temperature from the temperature handler
-   auto temperature = temperatureHandler->getTemperature(gridPosition, ftime);
+// Get the temperature at this depth
+   auto temperature = temperatures[xi];
 
 // Update the network if the temperature changed
-   if (!xolotlCore::equal(temperature, lastTemperature)) 
-   {
-    network->setTemperature(temperature);
-// Update the modified trap-mutation rate
-// that depends on the network reaction rates
-    mutationHandler->updateTrapMutationRate(network);
-    lastTemperature = temperature;
-   }
-
-// Copy data into the ReactionNetwork so that it can
-// compute the fluxes properly. The network is only used to compute the
-// fluxes and hold the state data from the last time step. I'm reusing
-// it because it cuts down on memory significantly (about 400MB per
-// grid point) at the expense of being a little tricky to comprehend.
-   network->updateConcentrationsFromArray(concOffset);
+   auto rates = setNetworkTemperature(temperature);
 
 // ----- Account for flux of incoming particles -----
    fluxHandler->computeIncidentFlux(ftime, updatedConcOffset, xi, surfacePosition);
@@ -384,8 +518,25 @@ namespace xolotlSolver
    mutationHandler->computeTrapMutation(network, concOffset, updatedConcOffset, xi);
 
 // ----- Compute the reaction fluxes over the locally owned part of the grid -----
+   if (useThreads(rates)) 
+   {
+// They will be computed by the threads after the loop
+    reactionPoints.push_back( { xi, 0, 0, concOffset, updatedConcOffset, rates } );
+    continue;
+   }
+
+// Copy data into the ReactionNetwork so that it can
+// compute the fluxes properly. The network is only used to compute the
+// fluxes and hold the state data from the last time step. I'm reusing
+// it because it cuts down on memory significantly (about 400MB per
+// grid point) at the expense of being a little tricky to comprehend.
+   network->updateConcentrationsFromArray(concOffset);
    network->computeAllFluxes(updatedConcOffset);
   }
+  if (measureTimes && xm > 0) pointTimes[xs + xm - 1] += MPI_Wtime() - pointStartTime;
+
+// Compute the reaction fluxes that were delayed
+  computeReactionFluxes();
 
 /*
  Restore vectors
@@ -400,9 +551,6 @@ namespace xolotlSolver
   checkPetscError(ierr, "PetscSolver1DHandler::updateConcentration: "
                         "DMRestoreLocalVector failed.");
 
-// Clear memory
-  delete[] concVector;
-
   return;
  }
 
@@ -413,6 +561,12 @@ namespace xolotlSolver
  {
   PetscErrorCode ierr;
 
+// Compute the temperature on the grid at this time
+  updateTemperatures(ftime);
+
+// Drop the cached rate tables if the temperature field changed
+  updateRateTables(ftime);
+
 // Get the distributed array
   DM da;
   ierr = TSGetDM(ts, &da);
@@ -445,7 +599,6 @@ namespace xolotlSolver
   PetscInt diffIndices[nDiff];
   PetscScalar advecVals[2 * nAdvec];
   PetscInt advecIndices[nAdvec];
-  std::vector<double> gridPosition = { 0.0, 0.0, 0.0 };
 
 /*
  Loop over grid points computing Jacobian terms for diffusion and advection
@@ -460,18 +613,11 @@ namespace xolotlSolver
 // Set the grid position
    gridPosition[0] = grid[xi];
 
-// Get the temperature from the temperature handler
-   auto temperature = temperatureHandler->getTemperature(gridPosition, ftime);
+// Get the temperature at this depth
+   auto temperature = temperatures[xi];
 
 // Update the network if the temperature changed
-   if (!xolotlCore::equal(temperature, lastTemperature)) 
-   {
-    network->setTemperature(temperature);
-// Update the modified trap-mutation rate
-// that depends on the network reaction rates
-    mutationHandler->updateTrapMutationRate(network);
-    lastTemperature = temperature;
-   }
+   setNetworkTemperature(temperature);
 
 // Get the partial derivatives for the diffusion
    diffusionHandler->computePartialsForDiffusion( network, diffVals,
@@ -558,6 +704,12 @@ namespace xolotlSolver
  {
   PetscErrorCode ierr;
 
+// Compute the temperature on the grid at this time
+  updateTemperatures(ftime);
+
+// Drop the cached rate tables if the temperature field changed
+  updateRateTables(ftime);
+
 // Get the distributed array
   DM da;
   ierr = TSGetDM(ts, &da);
@@ -582,12 +734,6 @@ namespace xolotlSolver
 // Pointer to the concentrations at a given grid point
   PetscScalar *concOffset = nullptr;
 
-// Degrees of freedom is the total number of clusters in the network
-  const int dof = network->getDOF();
-
-// Get all the He clusters in the network
-  auto heliums = network->getAll(xolotlCore::heType);
-
 // Compute the total concentration of atoms contained in bubbles
   double atomConc = 0.0;
 
@@ -619,24 +765,7 @@ namespace xolotlSolver
   mutationHandler->updateDisappearingRate(totalAtomConc);
 
 // Arguments for MatSetValuesStencil called below
-  MatStencil rowId;
-  MatStencil colIds[dof];
-  int pdColIdsVectorSize = 0;
-  PetscScalar *reactionVals;
-  reactionVals = new PetscScalar[dof * dof];
-  PetscInt *reactionIndices;
-  reactionIndices = new PetscInt[dof * dof];
-  PetscInt reactionSize[dof];
-
-// Store the total number of He clusters in the network for the
-// modified trap-mutation
-  int nHelium = heliums.size();
-
-// Declarations for variables used in the loop
-  std::vector<double> gridPosition;
-  gridPosition.push_back(0.0);
-  gridPosition.push_back(0.0);
-  gridPosition.push_back(0.0);
+  MatStencil row, col;
 
 // Loop over the grid points
   for (PetscInt xi = xs; xi < xs + xm; xi++) 
@@ -648,64 +777,38 @@ namespace xolotlSolver
 // Set the grid position
    gridPosition[0] = grid[xi];
 
-// Get the temperature from the temperature handler
-   auto temperature = temperatureHandler->getTemperature(gridPosition, ftime);
+// Get the temperature at this depth
+   auto temperature = temperatures[xi];
 
 // Update the network if the temperature changed
-   if (!xolotlCore::equal(temperature, lastTemperature)) 
+   auto rates = setNetworkTemperature(temperature);
+
+// ----- Take care of the reactions for all the reactants -----
+
+   concOffset = concs[xi];
+   if (useThreads(rates)) 
    {
-    network->setTemperature(temperature);
-// Update the modified trap-mutation rate
-// that depends on the network reaction rates
-    mutationHandler->updateTrapMutationRate(network);
-    lastTemperature = temperature;
+// They will be computed by the threads after the loop
+    reactionPoints.push_back( { xi, 0, 0, concOffset, nullptr, rates } );
    }
-
+   else 
+   {
 // Copy data into the ReactionNetwork so that it can
 // compute the new concentrations.
-   concOffset = concs[xi];
-   network->updateConcentrationsFromArray(concOffset);
-
-// ----- Take care of the reactions for all the reactants -----
+    network->updateConcentrationsFromArray(concOffset);
 
 // Compute all the partial derivatives for the reactions
-   network->computeAllPartials(reactionVals, reactionIndices, reactionSize);
+    network->computeAllPartials(reactionPartials.data());
 
-// Update the column in the Jacobian that represents each DOF
-   for (int i = 0; i < dof; i++) 
-   {
-// Set grid coordinate and component number for the row
-    rowId.i = xi;
-    rowId.c = i;
-
-// Number of partial derivatives
-    pdColIdsVectorSize = reactionSize[i];
-// Loop over the list of column ids
-    for (int j = 0; j < pdColIdsVectorSize; j++) 
-    {
-// Set grid coordinate and component number for a column in the list
-     colIds[j].i = xi;
-     colIds[j].c = reactionIndices[i * dof + j];
-// Get the partial derivative from the array of all of the partials
-     reactingPartialsForCluster[j] = reactionVals[i * dof + j];
-    }
-// Update the matrix
-    ierr = MatSetValuesStencil(J, 1, &rowId, pdColIdsVectorSize, colIds,
-                               reactingPartialsForCluster.data(), ADD_VALUES);
-    checkPetscError(ierr, "PetscSolver1DHandler::computeDiagonalJacobian: "
-                          "MatSetValuesStencil (reactions) failed.");
+// Update the rows in the Jacobian that represent each DOF
+    setReactionPartials(J, xi, 0, 0, reactionPartials.data());
    }
 
 // ----- Take care of the modified trap-mutation for all the reactants -----
 
-// Arguments for MatSetValuesStencil called below
-   MatStencil row, col;
-   PetscScalar mutationVals[3 * nHelium];
-   PetscInt mutationIndices[3 * nHelium];
-
 // Compute the partial derivative from modified trap-mutation at this grid point
    int nMutating = mutationHandler->computePartialsForTrapMutation( network,
-                                                 mutationVals, mutationIndices, xi);
+                                                 mutationVals.data(), mutationIndices.data(), xi);
 
 // Loop on the number of helium undergoing trap-mutation to set the values
 // in the Jacobian
@@ -719,7 +822,7 @@ namespace xolotlSolver
     col.c = mutationIndices[3 * i];
 
     ierr = MatSetValuesStencil(J, 1, &row, 1, &col,
-                               mutationVals + (3 * i), ADD_VALUES);
+                               mutationVals.data() + (3 * i), ADD_VALUES);
     checkPetscError(ierr, "PetscSolver1DHandler::computeDiagonalJacobian: "
                           "MatSetValuesStencil (He trap-mutation) failed.");
 
@@ -728,7 +831,7 @@ namespace xolotlSolver
     row.c = mutationIndices[(3 * i) + 1];
 
     ierr = MatSetValuesStencil(J, 1, &row, 1, &col,
-                               mutationVals + (3 * i) + 1, ADD_VALUES);
+                               mutationVals.data() + (3 * i) + 1, ADD_VALUES);
     checkPetscError(ierr, "PetscSolver1DHandler::computeDiagonalJacobian: "
                           "MatSetValuesStencil (HeV trap-mutation) failed.");
 
@@ -737,13 +840,16 @@ namespace xolotlSolver
     row.c = mutationIndices[(3 * i) + 2];
 
     ierr = MatSetValuesStencil(J, 1, &row, 1, &col,
-                               mutationVals + (3 * i) + 2, ADD_VALUES);
+                               mutationVals.data() + (3 * i) + 2, ADD_VALUES);
     checkPetscError(ierr, "PetscSolver1DHandler::computeDiagonalJacobian: "
                           "MatSetValuesStencil (I trap-mutation) failed.");
    }
 
   }
 
+// Compute the reaction partial derivatives that were delayed
+  computeReactionPartials(da, J);
+
 /*
  Restore vectors
  */
@@ -754,10 +860,6 @@ namespace xolotlSolver
   checkPetscError(ierr, "PetscSolver1DHandler::computeDiagonalJacobian: "
                         "DMRestoreLocalVector failed.");
 
-// Delete arrays
-  delete[] reactionVals;
-  delete[] reactionIndices;
-
   return;
 
  }
@@ -3,6 +3,7 @@
 
 // Includes
 #include "PetscSolverHandler.h"
+#include <GridPartitioner.h>
 
 namespace xolotlSolver 
 {
@@ -17,10 +18,32 @@ namespace xolotlSolver
 //! The position of the surface
    int surfacePosition;
 
+//! Are the grid points split between the processes from their cost?
+   bool loadBalancing;
+
+/**
+ * The number of grid points the surface has to move by before the grid is
+ * repartitioned, 0 to keep the first partition.
+ */
+   int repartitionThreshold;
+
+//! The position of the surface when the grid was last partitioned
+   int partitionSurfacePosition;
+
+/**
+ * Get the cost of each grid point: the times measured during the RHS
+ * evaluations since the last partition if there are some, the modeled costs
+ * otherwise.
+ *
+ * @return The cost of each grid point
+ */
+   std::vector<double> getPointCosts();
+
   public:
 
 //! The Constructor
-   PetscSolver1DHandler(){}
+   PetscSolver1DHandler() : surfacePosition(0), loadBalancing(false),
+                            repartitionThreshold(0), partitionSurfacePosition(0) {}
 
 //! The Destructor
    ~PetscSolver1DHandler(){}
@@ -56,6 +79,19 @@ namespace xolotlSolver
  */
    void computeDiagonalJacobian( TS& ts, Vec& localC, Mat& J, PetscReal ftime );
 
+/**
+ * The grid has to be repartitioned when the surface moved by more than the
+ * threshold since the last partition.
+ * \see ISolverHandler.h
+ */
+   bool needRepartition() const;
+
+/**
+ * Repartition the grid from the cost of its points.
+ * \see ISolverHandler.h
+ */
+   void repartition( DM& da, Vec& C );
+
 /**
  * Get the position of the surface.
  * \see ISolverHandler.h
@@ -1,6 +1,6 @@
 // Includes
 #include <PetscSolver2DHandler.h>
-#include <HDF5Utils.h>
+#include <HDF5RestartReader.h>
 #include <MathUtils.h>
 #include <Constants.h>
 
@@ -47,10 +47,15 @@ void PetscSolver2DHandler::createSolverContext(DM &da) {
 	/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 	 Create distributed array (DMDA) to manage parallel grid and vectors
 	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+	// Open the HDF5 file once, it is kept open until the concentrations are
+	// initialized
+	restartReader = std::make_shared<xolotlCore::HDF5RestartReader>(
+			networkName);
+
 	// Get starting conditions from HDF5 file
 	int nx = 0, ny = 0, nz = 0;
 	double hx = 0.0, hy = 0.0, hz = 0.0;
-	xolotlCore::HDF5Utils::readHeader(networkName, nx, hx, ny, hy, nz, hz);
+	restartReader->getHeader(nx, hx, ny, hy, nz, hz);
 
 	ierr = DMDACreate2d(PETSC_COMM_WORLD, DM_BOUNDARY_GHOSTED,
 			DM_BOUNDARY_PERIODIC, DMDA_STENCIL_STAR, nx, ny, PETSC_DECIDE,
@@ -76,14 +81,9 @@ void PetscSolver2DHandler::createSolverContext(DM &da) {
 
 	// Now that the grid was generated, we can update the surface position
 	// if we are using a restart file
-	int tempTimeStep = -2;
-	bool hasConcentrations = xolotlCore::HDF5Utils::hasConcentrationGroup(
-			networkName, tempTimeStep);
-
 	// Get the actual surface position if concentrations were stored
-	if (hasConcentrations) {
-		auto surfaceIndices = xolotlCore::HDF5Utils::readSurface2D(networkName,
-				tempTimeStep);
+	if (restartReader->hasConcentrations()) {
+		auto surfaceIndices = restartReader->getSurface2D();
 
 		// Set the actual surface positions
 		for (int i = 0; i < surfaceIndices.size(); i++) {
@@ -103,10 +103,6 @@ void PetscSolver2DHandler::createSolverContext(DM &da) {
 	// Set the step size
 	hY = hy;
 
-	// Set the size of the partial derivatives vectors
-	clusterPartials.resize(dof, 0.0);
-	reactingPartialsForCluster.resize(dof, 0.0);
-
 	/*  The only spatial coupling in the Jacobian is due to diffusion.
 	 *  The ofill (thought of as a dof by dof 2d (row-oriented) array represents
 	 *  the nonzero coupling between degrees of freedom at one point with degrees
@@ -115,20 +111,10 @@ void PetscSolver2DHandler::createSolverContext(DM &da) {
 	 *  to degree of freedom j at the adjacent point.
 	 *  In this case ofill has only a few diagonal entries since the only spatial
 	 *  coupling is regular diffusion.
+	 *  Both ofill and dfill are stored in a sparse format, only the column
+	 *  indices of the 1s of each row are kept.
 	 */
-	PetscInt *ofill, *dfill;
-	ierr = PetscMalloc(dof * dof * sizeof(PetscInt), &ofill);
-	checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
-			"PetscMalloc (ofill) failed.");
-	ierr = PetscMalloc(dof * dof * sizeof(PetscInt), &dfill);
-	checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
-			"PetscMalloc (dfill) failed.");
-	ierr = PetscMemzero(ofill, dof * dof * sizeof(PetscInt));
-	checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
-			"PetscMemzero (ofill) failed.");
-	ierr = PetscMemzero(dfill, dof * dof * sizeof(PetscInt));
-	checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
-			"PetscMemzero (dfill) failed.");
+	xolotlCore::SparseFillMap ofill, dfill;
 
 	// Fill ofill, the matrix of "off-diagonal" elements that represents diffusion
 	diffusionHandler->initializeOFill(network, ofill);
@@ -145,18 +131,18 @@ void PetscSolver2DHandler::createSolverContext(DM &da) {
 	// Get the diagonal fill
 	network->getDiagonalFill(dfill);
 
+	// Set the size of the partial derivatives vector to the number of non-zero
+	// entries of the reaction block
+	reactionPartials.resize(network->getPartialsRowPointers()[dof], 0.0);
+
+	// And the vectors used at each grid point
+	initializeScratch();
+
 	// Load up the block fills
-	ierr = DMDASetBlockFills(da, dfill, ofill);
-	checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
-			"DMDASetBlockFills failed.");
+	setBlockFills(da, dof, dfill, ofill);
 
-	// Free the temporary fill arrays
-	ierr = PetscFree(ofill);
-	checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
-			"PetscFree (ofill) failed.");
-	ierr = PetscFree(dfill);
-	checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
-			"PetscFree (dfill) failed.");
+	// Only send the mobile clusters to the ghost points
+	createGhostScatter(da, dof, ofill);
 
 	return;
 }
@@ -176,11 +162,6 @@ void PetscSolver2DHandler::initializeConcentration(DM &da, Vec &C) {
 	checkPetscError(ierr, "PetscSolver2DHandler::initializeConcentration: "
 			"DMDAGetCorners failed.");
 
-	// Get the last time step written in the HDF5 file
-	int tempTimeStep = -2;
-	bool hasConcentrations = xolotlCore::HDF5Utils::hasConcentrationGroup(
-			networkName, tempTimeStep);
-
 	// Get the total size of the grid for the boundary conditions
 	PetscInt Mx, My;
 	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, &My, PETSC_IGNORE,
@@ -190,8 +171,12 @@ void PetscSolver2DHandler::initializeConcentration(DM &da, Vec &C) {
 	checkPetscError(ierr, "PetscSolver2DHandler::initializeConcentration: "
 			"DMDAGetInfo failed.");
 
-	// Initialize the flux handler
+	// Initialize the flux handler and prepare the flux for the surface
+	// position of every Y grid point
 	fluxHandler->initializeFluxHandler(network, surfacePosition[0], grid);
+	for (PetscInt j = 0; j < My; j++) {
+		fluxHandler->setSurfacePosition(surfacePosition[j]);
+	}
 
 	// Initialize the grid for the diffusion
 	diffusionHandler->initializeDiffusionGrid(advectionHandlers, grid, My, hY);
@@ -230,27 +215,29 @@ void PetscSolver2DHandler::initializeConcentration(DM &da, Vec &C) {
 	}
 
 	// If the concentration must be set from the HDF5 file
-	if (hasConcentrations) {
-		// Loop on the full grid
-		for (PetscInt j = 0; j < My; j++) {
-			for (PetscInt i = 0; i < Mx; i++) {
-				// Read the concentrations from the HDF5 file
-				auto concVector = xolotlCore::HDF5Utils::readGridPoint(
-						networkName, tempTimeStep, i, j);
-
-				// Change the concentration only if we are on the locally owned part of the grid
-				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym) {
-					concOffset = concentrations[j][i];
-					// Loop on the concVector size
-					for (unsigned int l = 0; l < concVector.size(); l++) {
-						concOffset[(int) concVector.at(l).at(0)] =
-								concVector.at(l).at(1);
-					}
+	if (restartReader && restartReader->hasConcentrations()) {
+		// Read the concentrations of the locally owned grid points only
+		std::vector<double> concArray;
+		std::vector<int> concSizes;
+		restartReader->readConcentrations(concArray, concSizes, xs, xm, ys,
+				ym);
+
+		// Loop on the local grid points
+		int l = 0, p = 0;
+		for (PetscInt j = ys; j < ys + ym; j++) {
+			for (PetscInt i = xs; i < xs + xm; i++, p++) {
+				concOffset = concentrations[j][i];
+				// Loop on the concentrations of this grid point
+				for (int n = 0; n < concSizes[p]; n++, l++) {
+					concOffset[(int) concArray[2 * l]] = concArray[2 * l + 1];
 				}
 			}
 		}
 	}
 
+	// Everything was read, close the file
+	restartReader.reset();
+
 	/*
 	 Restore vectors
 	 */
@@ -265,6 +252,12 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 		PetscReal ftime) {
 	PetscErrorCode ierr;
 
+	// Compute the temperature on the grid at this time
+	updateTemperatures(ftime);
+
+	// Drop the cached rate tables if the temperature field changed
+	updateRateTables(ftime);
+
 	// Get the local data vector from PETSc
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -309,8 +302,7 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	double sy = 1.0 / (hY * hY);
 
 	// Declarations for variables used in the loop
-	double **concVector = new double*[5];
-	std::vector<double> gridPosition = { 0.0, 0.0, 0.0 }, incidentFluxVector;
+	double *concVector[5];
 	double atomConc = 0.0, totalAtomConc = 0.0;
 
 	// Degrees of freedom is the total number of clusters in the network
@@ -356,9 +348,9 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 		// Set the grid position
 		gridPosition[1] = yj * hY;
 
-		// Initialize the flux, advection, and trap-mutation handlers which depend
-		// on the surface position at Y
-		fluxHandler->initializeFluxHandler(network, surfacePosition[yj], grid);
+		// Set the surface position at Y in the advection handler, the flux
+		// and trap-mutation handlers get their profile of this surface
+		// position by themselves
 		advectionHandlers[0]->setLocation(grid[surfacePosition[yj]]);
 
 		for (PetscInt xi = xs; xi < xs + xm; xi++) {
@@ -386,25 +378,11 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 			concVector[3] = concs[yj - 1][xi]; // bottom
 			concVector[4] = concs[yj + 1][xi]; // top
 
-			// Get the temperature from the temperature handler
-			auto temperature = temperatureHandler->getTemperature(gridPosition,
-					ftime);
+			// Get the temperature at this depth
+			auto temperature = temperatures[xi];
 
 			// Update the network if the temperature changed
-			if (!xolotlCore::equal(temperature, lastTemperature)) {
-				network->setTemperature(temperature);
-				// Update the modified trap-mutation rate that depends on the
-				// network reaction rates
-				mutationHandler->updateTrapMutationRate(network);
-				lastTemperature = temperature;
-			}
-
-			// Copy data into the ReactionNetwork so that it can
-			// compute the fluxes properly. The network is only used to compute the
-			// fluxes and hold the state data from the last time step. I'm reusing
-			// it because it cuts down on memory significantly (about 400MB per
-			// grid point) at the expense of being a little tricky to comprehend.
-			network->updateConcentrationsFromArray(concOffset);
+			auto rates = setNetworkTemperature(temperature);
 
 			// ----- Account for flux of incoming particles -----
 			fluxHandler->computeIncidentFlux(ftime, updatedConcOffset, xi, surfacePosition[yj]);
@@ -426,10 +404,26 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 					updatedConcOffset, xi, yj);
 
 			// ----- Compute the reaction fluxes over the locally owned part of the grid -----
+			if (useThreads(rates)) {
+				// They will be computed by the threads after the loop
+				reactionPoints.push_back( { xi, yj, 0, concOffset,
+						updatedConcOffset, rates });
+				continue;
+			}
+
+			// Copy data into the ReactionNetwork so that it can
+			// compute the fluxes properly. The network is only used to compute the
+			// fluxes and hold the state data from the last time step. I'm reusing
+			// it because it cuts down on memory significantly (about 400MB per
+			// grid point) at the expense of being a little tricky to comprehend.
+			network->updateConcentrationsFromArray(concOffset);
 			network->computeAllFluxes(updatedConcOffset);
 		}
 	}
 
+	// Compute the reaction fluxes that were delayed
+	computeReactionFluxes();
+
 	/*
 	 Restore vectors
 	 */
@@ -443,9 +437,6 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	checkPetscError(ierr, "PetscSolver2DHandler::updateConcentration: "
 			"DMRestoreLocalVector failed.");
 
-	// Clear memory
-	delete[] concVector;
-
 	return;
 }
 
@@ -453,6 +444,12 @@ void PetscSolver2DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 		Mat &J, PetscReal ftime) {
 	PetscErrorCode ierr;
 
+	// Compute the temperature on the grid at this time
+	updateTemperatures(ftime);
+
+	// Drop the cached rate tables if the temperature field changed
+	updateRateTables(ftime);
+
 	// Get the distributed array
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -488,7 +485,6 @@ void PetscSolver2DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 	PetscInt diffIndices[nDiff];
 	PetscScalar advecVals[2 * nAdvec];
 	PetscInt advecIndices[nAdvec];
-	std::vector<double> gridPosition = { 0.0, 0.0, 0.0 };
 
 	/*
 	 Loop over grid points computing Jacobian terms for diffusion and advection
@@ -511,18 +507,11 @@ void PetscSolver2DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 			// Set the grid position
 			gridPosition[0] = grid[xi];
 
-			// Get the temperature from the temperature handler
-			auto temperature = temperatureHandler->getTemperature(gridPosition,
-					ftime);
+			// Get the temperature at this depth
+			auto temperature = temperatures[xi];
 
 			// Update the network if the temperature changed
-			if (!xolotlCore::equal(temperature, lastTemperature)) {
-				network->setTemperature(temperature);
-				// Update the modified trap-mutation rate that depends on the
-				// network reaction rates
-				mutationHandler->updateTrapMutationRate(network);
-				lastTemperature = temperature;
-			}
+			setNetworkTemperature(temperature);
 
 			// Get the partial derivatives for the diffusion
 			diffusionHandler->computePartialsForDiffusion(network, diffVals,
@@ -621,6 +610,12 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		PetscReal ftime) {
 	PetscErrorCode ierr;
 
+	// Compute the temperature on the grid at this time
+	updateTemperatures(ftime);
+
+	// Drop the cached rate tables if the temperature field changed
+	updateRateTables(ftime);
+
 	// Get the distributed array
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -651,29 +646,11 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	checkPetscError(ierr, "PetscSolver2DHandler::computeDiagonalJacobian: "
 			"DMDAGetInfo failed.");
 
-	// The degree of freedom is the size of the network
-	const int dof = network->getDOF();
-
 	// Pointer to the concentrations at a given grid point
 	PetscScalar *concOffset = nullptr;
 
-	// Arguments for MatSetValuesStencil called below
-	MatStencil rowId;
-	MatStencil colIds[dof];
-	int pdColIdsVectorSize = 0;
-	PetscScalar *reactionVals;
-	reactionVals = new PetscScalar[dof * dof];
-	PetscInt *reactionIndices;
-	reactionIndices = new PetscInt[dof * dof];
-	PetscInt reactionSize[dof];
-
-	// Store the total number of He clusters in the network for the
-	// modified trap-mutation
-	int nHelium = network->getAll(xolotlCore::heType).size();
-
 	// Declarations for variables used in the loop
 	double atomConc = 0.0, totalAtomConc = 0.0;
-	std::vector<double> gridPosition = { 0.0, 0.0, 0.0 };
 
 	// Loop over the grid points
 	for (PetscInt yj = 0; yj < My; yj++) {
@@ -724,66 +701,39 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 			// Set the grid position
 			gridPosition[0] = grid[xi];
 
-			// Get the temperature from the temperature handler
-			auto temperature = temperatureHandler->getTemperature(gridPosition,
-					ftime);
+			// Get the temperature at this depth
+			auto temperature = temperatures[xi];
 
 			// Update the network if the temperature changed
-			if (!xolotlCore::equal(temperature, lastTemperature)) {
-				network->setTemperature(temperature);
-				// Update the modified trap-mutation rate that depends on the
-				// network reaction rates
-				mutationHandler->updateTrapMutationRate(network);
-				lastTemperature = temperature;
-			}
-
-			// Copy data into the ReactionNetwork so that it can
-			// compute the new concentrations.
-			concOffset = concs[yj][xi];
-			network->updateConcentrationsFromArray(concOffset);
+			auto rates = setNetworkTemperature(temperature);
 
 			// ----- Take care of the reactions for all the reactants -----
 
-			// Compute all the partial derivatives for the reactions
-			network->computeAllPartials(reactionVals, reactionIndices,
-					reactionSize);
+			concOffset = concs[yj][xi];
+			if (useThreads(rates)) {
+				// They will be computed by the threads after the loop
+				reactionPoints.push_back( { xi, yj, 0, concOffset, nullptr,
+						rates });
+			} else {
+				// Copy data into the ReactionNetwork so that it can
+				// compute the new concentrations.
+				network->updateConcentrationsFromArray(concOffset);
 
-			// Update the column in the Jacobian that represents each DOF
-			for (int i = 0; i < dof; i++) {
-				// Set grid coordinate and component number for the row
-				rowId.i = xi;
-				rowId.j = yj;
-				rowId.c = i;
-
-				// Number of partial derivatives
-				pdColIdsVectorSize = reactionSize[i];
-				// Loop over the list of column ids
-				for (int j = 0; j < pdColIdsVectorSize; j++) {
-					// Set grid coordinate and component number for a column in the list
-					colIds[j].i = xi;
-					colIds[j].j = yj;
-					colIds[j].c = reactionIndices[i * dof + j];
-					// Get the partial derivative from the array of all of the partials
-					reactingPartialsForCluster[j] = reactionVals[i * dof + j];
-				}
-				// Update the matrix
-				ierr = MatSetValuesStencil(J, 1, &rowId, pdColIdsVectorSize,
-						colIds, reactingPartialsForCluster.data(), ADD_VALUES);
-				checkPetscError(ierr,
-						"PetscSolver1DHandler::computeDiagonalJacobian: "
-								"MatSetValuesStencil (reactions) failed.");
+				// Compute all the partial derivatives for the reactions
+				network->computeAllPartials(reactionPartials.data());
+
+				// Update the rows in the Jacobian that represent each DOF
+				setReactionPartials(J, xi, yj, 0, reactionPartials.data());
 			}
 
 			// ----- Take care of the modified trap-mutation for all the reactants -----
 
 			// Arguments for MatSetValuesStencil called below
 			MatStencil row, col;
-			PetscScalar mutationVals[3 * nHelium];
-			PetscInt mutationIndices[3 * nHelium];
 
 			// Compute the partial derivative from modified trap-mutation at this grid point
 			int nMutating = mutationHandler->computePartialsForTrapMutation(
-					network, mutationVals, mutationIndices, xi, yj);
+					network, mutationVals.data(), mutationIndices.data(), xi, yj);
 
 			// Loop on the number of helium undergoing trap-mutation to set the values
 			// in the Jacobian
@@ -798,7 +748,7 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 				col.c = mutationIndices[3 * i];
 
 				ierr = MatSetValuesStencil(J, 1, &row, 1, &col,
-						mutationVals + (3 * i), ADD_VALUES);
+						mutationVals.data() + (3 * i), ADD_VALUES);
 				checkPetscError(ierr,
 						"PetscSolver2DHandler::computeDiagonalJacobian: "
 								"MatSetValuesStencil (He trap-mutation) failed.");
@@ -808,7 +758,7 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 				row.c = mutationIndices[(3 * i) + 1];
 
 				ierr = MatSetValuesStencil(J, 1, &row, 1, &col,
-						mutationVals + (3 * i) + 1, ADD_VALUES);
+						mutationVals.data() + (3 * i) + 1, ADD_VALUES);
 				checkPetscError(ierr,
 						"PetscSolver2DHandler::computeDiagonalJacobian: "
 								"MatSetValuesStencil (HeV trap-mutation) failed.");
@@ -818,7 +768,7 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 				row.c = mutationIndices[(3 * i) + 2];
 
 				ierr = MatSetValuesStencil(J, 1, &row, 1, &col,
-						mutationVals + (3 * i) + 2, ADD_VALUES);
+						mutationVals.data() + (3 * i) + 2, ADD_VALUES);
 				checkPetscError(ierr,
 						"PetscSolver2DHandler::computeDiagonalJacobian: "
 								"MatSetValuesStencil (I trap-mutation) failed.");
@@ -826,6 +776,9 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		}
 	}
 
+	// Compute the reaction partial derivatives that were delayed
+	computeReactionPartials(da, J);
+
 	/*
 	 Restore vectors
 	 */
@@ -836,10 +789,6 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	checkPetscError(ierr, "PetscSolver2DHandler::computeDiagonalJacobian: "
 			"DMRestoreLocalVector failed.");
 
-	// Delete arrays
-	delete[] reactionVals;
-	delete[] reactionIndices;
-
 	return;
 }
 
@@ -0,0 +1,599 @@
+// Includes
+#include <PetscSolverHandler.h>
+#include <MathUtils.h>
+#include <Constants.h>
+#include <algorithm>
+#include <iostream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace xolotlSolver {
+
+/**
+ * Convert a sparse fill map to the format expected by DMDASetBlockFillsSparse:
+ * entry i < dof is the position in the array where the column indices of row i
+ * start, entry dof is the total length of the array, and the sorted column
+ * indices of all the rows follow.
+ *
+ * @param dof The number of degrees of freedom
+ * @param fillMap The sparse fill map, its rows are sorted and duplicates
+ * (the same entry set by several handlers) are removed
+ * @return The fill in the PETSc sparse format
+ */
+static std::vector<PetscInt> getPetscSparseFill(int dof,
+		xolotlCore::SparseFillMap &fillMap) {
+	std::vector<PetscInt> fillSparse(dof + 1, 0);
+
+	// Loop on the rows
+	for (int i = 0; i < dof; i++) {
+		fillSparse[i] = fillSparse.size();
+
+		// Skip the empty rows
+		auto it = fillMap.find(i);
+		if (it == fillMap.end())
+			continue;
+
+		// Sort the column indices and remove the duplicates
+		auto &columns = it->second;
+		std::sort(columns.begin(), columns.end());
+		columns.erase(std::unique(columns.begin(), columns.end()),
+				columns.end());
+
+		fillSparse.insert(fillSparse.end(), columns.begin(), columns.end());
+	}
+	fillSparse[dof] = fillSparse.size();
+
+	return fillSparse;
+}
+
+void PetscSolverHandler::setBlockFills(DM &da, int dof,
+		xolotlCore::SparseFillMap &dfill, xolotlCore::SparseFillMap &ofill) {
+	// Convert the fill maps, they are kept for the repartitions
+	dfillSparse = getPetscSparseFill(dof, dfill);
+	ofillSparse = getPetscSparseFill(dof, ofill);
+
+	// Load up the block fills
+	PetscErrorCode ierr = DMDASetBlockFillsSparse(da, dfillSparse.data(),
+			ofillSparse.data());
+	checkPetscError(ierr, "PetscSolverHandler::setBlockFills: "
+			"DMDASetBlockFillsSparse failed.");
+
+	// Report the fill density on the master process
+	int procId;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	if (procId == 0) {
+		int dNonZeros = dfillSparse.size() - (dof + 1);
+		int oNonZeros = ofillSparse.size() - (dof + 1);
+		double blockSize = (double) dof * (double) dof;
+		std::cout << "Jacobian block fill for " << dof
+				<< " degrees of freedom: diagonal " << dNonZeros
+				<< " non-zeros (" << 100.0 * (double) dNonZeros / blockSize
+				<< "%), off-diagonal " << oNonZeros << " non-zeros ("
+				<< 100.0 * (double) oNonZeros / blockSize << "%)"
+				<< std::endl;
+	}
+
+	return;
+}
+
+//! The name under which the ghost scatter is attached to the distributed array
+static const char ghostScatterName[] = "xolotlGhostScatter";
+
+void PetscSolverHandler::createGhostScatter(DM &da, int dof,
+		xolotlCore::SparseFillMap &ofill) {
+	// The degrees of freedom read at the neighboring grid points are the
+	// columns of ofill
+	mobileDOFs.clear();
+	for (auto it = ofill.begin(); it != ofill.end(); ++it) {
+		mobileDOFs.insert(mobileDOFs.end(), it->second.begin(),
+				it->second.end());
+	}
+	std::sort(mobileDOFs.begin(), mobileDOFs.end());
+	mobileDOFs.erase(std::unique(mobileDOFs.begin(), mobileDOFs.end()),
+			mobileDOFs.end());
+
+	// Create the scatter
+	attachGhostScatter(da, dof);
+
+	// Report the size of the exchange on the master process
+	int procId;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	if (procId == 0) {
+		std::cout << "Ghost exchange: " << mobileDOFs.size() << " of " << dof
+				<< " degrees of freedom" << std::endl;
+	}
+
+	return;
+}
+
+void PetscSolverHandler::attachGhostScatter(DM &da, int dof) {
+	PetscErrorCode ierr;
+
+	// Get the local grid and its ghosts, the unused directions have a size of 1
+	PetscInt xs, ys, zs, xm, ym, zm, gxs, gys, gzs, gxm, gym, gzm;
+	ierr = DMDAGetCorners(da, &xs, &ys, &zs, &xm, &ym, &zm);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"DMDAGetCorners failed.");
+	ierr = DMDAGetGhostCorners(da, &gxs, &gys, &gzs, &gxm, &gym, &gzm);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"DMDAGetGhostCorners failed.");
+
+	// List the entries of the local vector to fill: everything at the local
+	// grid points and the mobile clusters at the ghost points that are
+	// neighbors in one direction (the corners are never read)
+	std::vector<PetscInt> localIndices;
+	for (PetscInt k = gzs; k < gzs + gzm; k++) {
+		for (PetscInt j = gys; j < gys + gym; j++) {
+			for (PetscInt i = gxs; i < gxs + gxm; i++) {
+				int nOutside = (i < xs || i >= xs + xm)
+						+ (j < ys || j >= ys + ym) + (k < zs || k >= zs + zm);
+				if (nOutside > 1)
+					continue;
+				PetscInt pointIndex = (((k - gzs) * gym + (j - gys)) * gxm
+						+ (i - gxs)) * dof;
+				if (nOutside == 0) {
+					for (int l = 0; l < dof; l++)
+						localIndices.push_back(pointIndex + l);
+				} else {
+					for (unsigned int l = 0; l < mobileDOFs.size(); l++)
+						localIndices.push_back(pointIndex + mobileDOFs[l]);
+				}
+			}
+		}
+	}
+
+	// Find them in the global vector, the ghost points outside of the grid
+	// don't exist there and are skipped like DMGlobalToLocal() does
+	ISLocalToGlobalMapping ltog;
+	ierr = DMGetLocalToGlobalMapping(da, &ltog);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"DMGetLocalToGlobalMapping failed.");
+	std::vector<PetscInt> globalIndices(localIndices.size());
+	ierr = ISLocalToGlobalMappingApply(ltog, localIndices.size(),
+			localIndices.data(), globalIndices.data());
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"ISLocalToGlobalMappingApply failed.");
+	PetscInt n = 0;
+	for (unsigned int m = 0; m < localIndices.size(); m++) {
+		if (globalIndices[m] < 0)
+			continue;
+		localIndices[n] = localIndices[m];
+		globalIndices[n] = globalIndices[m];
+		n++;
+	}
+
+	// Create the scatter between the vectors of the distributed array
+	IS isFrom, isTo;
+	ierr = ISCreateGeneral(PETSC_COMM_SELF, n, globalIndices.data(),
+			PETSC_COPY_VALUES, &isFrom);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"ISCreateGeneral (from) failed.");
+	ierr = ISCreateGeneral(PETSC_COMM_SELF, n, localIndices.data(),
+			PETSC_COPY_VALUES, &isTo);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"ISCreateGeneral (to) failed.");
+	Vec C, localC;
+	ierr = DMGetGlobalVector(da, &C);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"DMGetGlobalVector failed.");
+	ierr = DMGetLocalVector(da, &localC);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"DMGetLocalVector failed.");
+	VecScatter scatter;
+	ierr = VecScatterCreate(C, isFrom, localC, isTo, &scatter);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"VecScatterCreate failed.");
+
+	// The distributed array keeps the scatter and destroys it with itself
+	ierr = PetscObjectCompose((PetscObject) da, ghostScatterName,
+			(PetscObject) scatter);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"PetscObjectCompose failed.");
+
+	// Release everything else
+	ierr = VecScatterDestroy(&scatter);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"VecScatterDestroy failed.");
+	ierr = DMRestoreLocalVector(da, &localC);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"DMRestoreLocalVector failed.");
+	ierr = DMRestoreGlobalVector(da, &C);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"DMRestoreGlobalVector failed.");
+	ierr = ISDestroy(&isFrom);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"ISDestroy (from) failed.");
+	ierr = ISDestroy(&isTo);
+	checkPetscError(ierr, "PetscSolverHandler::attachGhostScatter: "
+			"ISDestroy (to) failed.");
+
+	return;
+}
+
+void PetscSolverHandler::globalToLocal(DM &da, Vec &C, Vec &localC,
+		bool begin) {
+	PetscErrorCode ierr;
+
+	// Get the scatter attached to the distributed array
+	VecScatter scatter = nullptr;
+	ierr = PetscObjectQuery((PetscObject) da, ghostScatterName,
+			(PetscObject *) &scatter);
+	checkPetscError(ierr, "PetscSolverHandler::globalToLocal: "
+			"PetscObjectQuery failed.");
+
+	// Exchange everything if there is none
+	if (!scatter) {
+		if (begin)
+			ierr = DMGlobalToLocalBegin(da, C, INSERT_VALUES, localC);
+		else
+			ierr = DMGlobalToLocalEnd(da, C, INSERT_VALUES, localC);
+		checkPetscError(ierr, "PetscSolverHandler::globalToLocal: "
+				"DMGlobalToLocal failed.");
+
+		return;
+	}
+
+	if (begin)
+		ierr = VecScatterBegin(scatter, C, localC, INSERT_VALUES,
+				SCATTER_FORWARD);
+	else
+		ierr = VecScatterEnd(scatter, C, localC, INSERT_VALUES,
+				SCATTER_FORWARD);
+	checkPetscError(ierr, "PetscSolverHandler::globalToLocal: "
+			"VecScatter failed.");
+
+	return;
+}
+
+void PetscSolverHandler::initializeScratch() {
+	// The grid position always has three coordinates
+	gridPosition.assign(3, 0.0);
+
+	// At most three partial derivatives for each helium cluster undergoing
+	// the modified trap-mutation
+	const int nHelium = network->getAll(xolotlCore::heType).size();
+	mutationVals.assign(3 * nHelium, 0.0);
+	mutationIndices.assign(3 * nHelium, 0);
+
+	// Read the memory budget of the cached rate tables
+	PetscReal budget = 256.0;
+	PetscBool flagBudget;
+	PetscErrorCode ierr = PetscOptionsGetReal(NULL, NULL,
+			"-xolotl_rate_cache_mb", &budget, &flagBudget);
+	checkPetscError(ierr, "PetscSolverHandler::initializeScratch: "
+			"PetscOptionsGetReal (-xolotl_rate_cache_mb) failed.");
+	rateTablesBudget = (std::size_t) (std::max(budget, 0.0) * 1024.0 * 1024.0);
+
+	return;
+}
+
+void PetscSolverHandler::updateRateTables(double time) {
+	// Nothing to do if the time did not change
+	if (xolotlCore::equal(time, rateTablesTime))
+		return;
+
+	// Drop the tables that were not used at the previous time, the
+	// temperature field changed
+	for (auto it = rateTables.begin(); it != rateTables.end();) {
+		if (it->second.used) {
+			it->second.used = false;
+			++it;
+		} else
+			it = rateTables.erase(it);
+	}
+	rateTablesTime = time;
+
+	return;
+}
+
+void PetscSolverHandler::updateTemperatures(double time) {
+	// Nothing to do if the time did not change and the grid is the same
+	if (time == temperaturesTime && temperatures.size() == grid.size())
+		return;
+
+	// Only the depth is needed by the temperature handlers, the evaluations
+	// set the other coordinates of the grid position afterwards
+	temperatures.resize(grid.size());
+	gridPosition.assign(3, 0.0);
+	for (unsigned int xi = 0; xi < grid.size(); xi++) {
+		gridPosition[0] = grid[xi];
+		temperatures[xi] = temperatureHandler->getTemperature(gridPosition,
+				time);
+	}
+	temperaturesTime = time;
+
+	return;
+}
+
+bool PetscSolverHandler::makeRoomForRateTable() {
+	// Nothing can be cached without memory
+	if (rateTablesBudget == 0)
+		return false;
+
+	// The size of a table is only known once one was computed
+	if (rateTableBytes == 0)
+		return true;
+	std::size_t maxTables = rateTablesBudget / rateTableBytes;
+	if (rateTables.size() < maxTables)
+		return true;
+
+	// Evict the least recently used table that was not used at this time
+	auto lru = rateTables.end();
+	for (auto it = rateTables.begin(); it != rateTables.end(); ++it) {
+		if (it->second.used)
+			continue;
+		if (lru == rateTables.end()
+				|| it->second.lastUse < lru->second.lastUse)
+			lru = it;
+	}
+	if (lru == rateTables.end())
+		return false;
+	rateTables.erase(lru);
+
+	return rateTables.size() < maxTables;
+}
+
+const xolotlCore::RateTable * PetscSolverHandler::setNetworkTemperature(
+		double temperature) {
+	// The table of this temperature, if it is cached
+	const xolotlCore::RateTable * rates = nullptr;
+
+	// Look for the table of this temperature
+	auto it = rateTables.find(temperature);
+	if (it != rateTables.end()) {
+		it->second.used = true;
+		it->second.lastUse = ++rateTablesUses;
+		rates = &(it->second.rates);
+		// Nothing to do if the network is already at this temperature
+		if (xolotlCore::equal(temperature, lastTemperature))
+			return rates;
+		network->setRateTable(it->second.rates);
+	} else {
+		// Compute the rates and keep them if there is some room left in the
+		// memory budget, even if the network is already at this temperature
+		// because the threads need the table
+		if (makeRoomForRateTable()) {
+			auto & table = rateTables[temperature];
+			network->computeRateTable(temperature, table.rates);
+			table.used = true;
+			table.lastUse = ++rateTablesUses;
+			rates = &(table.rates);
+			if (rateTableBytes == 0)
+				rateTableBytes = sizeof(CachedRateTable)
+						+ table.rates.values.capacity() * sizeof(double);
+		} else if (!xolotlCore::equal(temperature, lastTemperature))
+			network->setTemperature(temperature);
+		// Nothing else to do if the network was already at this temperature
+		if (xolotlCore::equal(temperature, lastTemperature))
+			return rates;
+	}
+
+	// Update the modified trap-mutation rate
+	// that depends on the network reaction rates
+	mutationHandler->updateTrapMutationRate(network);
+	lastTemperature = temperature;
+
+	return rates;
+}
+
+void PetscSolverHandler::computeReactionFluxes() {
+	const int nPoints = reactionPoints.size();
+
+	// Each point only modifies its own updated concentrations, and its own
+	// time when they are measured
+	const bool measureTimes = !pointTimes.empty();
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic)
+	for (int n = 0; n < nPoints; n++) {
+		const auto & point = reactionPoints[n];
+		double startTime = measureTimes ? MPI_Wtime() : 0.0;
+		network->computeFluxes(point.concOffset, point.updatedConcOffset,
+				*(point.rates));
+		if (measureTimes)
+			pointTimes[point.xi] += MPI_Wtime() - startTime;
+	}
+
+	reactionPoints.clear();
+
+	return;
+}
+
+void PetscSolverHandler::computeReactionPartials(DM &da, Mat &J) {
+	PetscErrorCode ierr;
+	const int nPoints = reactionPoints.size();
+	if (nPoints == 0)
+		return;
+
+	// Get one vector of partial derivatives for each thread
+	if ((int) threadPartials.size() != numThreads)
+		threadPartials.resize(numThreads);
+	for (int t = 0; t < numThreads; t++) {
+		threadPartials[t].resize(reactionPartials.size());
+	}
+
+	// The partial derivatives of the reactions only couple the clusters of
+	// the same grid point, they are all in the local diagonal block of the
+	// matrix. With an AIJ matrix the threads add them directly in the values
+	// of this block, each one in the rows of its own points.
+	Mat Ad = nullptr;
+	PetscBool isSeq, isMPI;
+	ierr = PetscObjectTypeCompare((PetscObject) J, MATSEQAIJ, &isSeq);
+	checkPetscError(ierr, "PetscSolverHandler::computeReactionPartials: "
+			"PetscObjectTypeCompare (seq) failed.");
+	ierr = PetscObjectTypeCompare((PetscObject) J, MATMPIAIJ, &isMPI);
+	checkPetscError(ierr, "PetscSolverHandler::computeReactionPartials: "
+			"PetscObjectTypeCompare (mpi) failed.");
+	if (isSeq)
+		Ad = J;
+	else if (isMPI) {
+		ierr = MatMPIAIJGetSeqAIJ(J, &Ad, NULL, NULL);
+		checkPetscError(ierr, "PetscSolverHandler::computeReactionPartials: "
+				"MatMPIAIJGetSeqAIJ failed.");
+	}
+
+	// Any other matrix type is filled by the main thread, one batch of one
+	// point per thread at a time
+	if (!Ad) {
+		for (int first = 0; first < nPoints; first += numThreads) {
+			const int nBatch = std::min(numThreads, nPoints - first);
+
+#pragma omp parallel for num_threads(numThreads)
+			for (int t = 0; t < nBatch; t++) {
+				const auto & point = reactionPoints[first + t];
+				network->computePartials(point.concOffset,
+						threadPartials[t].data(), *(point.rates));
+			}
+
+			for (int t = 0; t < nBatch; t++) {
+				const auto & point = reactionPoints[first + t];
+				setReactionPartials(J, point.xi, point.yj, point.zk,
+						threadPartials[t].data());
+			}
+		}
+		reactionPoints.clear();
+
+		return;
+	}
+
+	// The values are added in place, in the structure built by the last
+	// assembly, which only exists if the matrix is assembled
+	PetscBool assembled;
+	ierr = MatAssembled(J, &assembled);
+	checkPetscError(ierr, "PetscSolverHandler::computeReactionPartials: "
+			"MatAssembled failed.");
+	if (!assembled) {
+		reactionPoints.clear();
+		throw std::string("PetscSolverHandler::computeReactionPartials: "
+				"the Jacobian must be assembled before the reaction partial "
+				"derivatives are added.");
+	}
+
+	// Get the local grid boundaries to find the local rows of each point
+	PetscInt xs, ys, zs, xm, ym, zm;
+	ierr = DMDAGetCorners(da, &xs, &ys, &zs, &xm, &ym, &zm);
+	checkPetscError(ierr, "PetscSolverHandler::computeReactionPartials: "
+			"DMDAGetCorners failed.");
+	PetscInt daDof;
+	ierr = DMDAGetInfo(da, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &daDof,
+			NULL, NULL, NULL, NULL, NULL);
+	checkPetscError(ierr, "PetscSolverHandler::computeReactionPartials: "
+			"DMDAGetInfo failed.");
+
+	// The CSR structure and values of the diagonal block
+	PetscInt nRows;
+	const PetscInt *ai = nullptr, *aj = nullptr;
+	PetscBool done;
+	ierr = MatGetRowIJ(Ad, 0, PETSC_FALSE, PETSC_FALSE, &nRows, &ai, &aj,
+			&done);
+	checkPetscError(ierr, "PetscSolverHandler::computeReactionPartials: "
+			"MatGetRowIJ failed.");
+	if (!done)
+		throw std::string("PetscSolverHandler::computeReactionPartials: "
+				"the structure of the matrix is not available.");
+	PetscScalar *a = nullptr;
+	ierr = MatSeqAIJGetArray(Ad, &a);
+	checkPetscError(ierr, "PetscSolverHandler::computeReactionPartials: "
+			"MatSeqAIJGetArray failed.");
+
+	// The CSR pattern of the partial derivatives from the reactions
+	const auto& rowPtr = network->getPartialsRowPointers();
+	const auto& colIndices = network->getPartialsColumnIds();
+	const int dof = rowPtr.size() - 1;
+
+	// Set if an entry is missing from the matrix structure
+	bool missingEntry = false;
+
+#pragma omp parallel num_threads(numThreads)
+	{
+#ifdef _OPENMP
+		auto & vals = threadPartials[omp_get_thread_num()];
+#else
+		auto & vals = threadPartials[0];
+#endif
+
+#pragma omp for schedule(dynamic) reduction(||:missingEntry)
+		for (int n = 0; n < nPoints; n++) {
+			const auto & point = reactionPoints[n];
+			network->computePartials(point.concOffset, vals.data(),
+					*(point.rates));
+
+			// The first local row of this point
+			const PetscInt base = (((point.zk - zs) * ym + (point.yj - ys)) * xm
+					+ (point.xi - xs)) * daDof;
+			for (int i = 0; i < dof; i++) {
+				// The columns of the row, sorted
+				const PetscInt *rowBegin = aj + ai[base + i];
+				const PetscInt *rowEnd = aj + ai[base + i + 1];
+				for (int k = rowPtr[i]; k < rowPtr[i + 1]; k++) {
+					const PetscInt col = base + colIndices[k];
+					const PetscInt *pos = std::lower_bound(rowBegin, rowEnd,
+							col);
+					if (pos == rowEnd || *pos != col) {
+						missingEntry = true;
+						continue;
+					}
+					a[pos - aj] += vals[k];
+				}
+			}
+		}
+	}
+
+	ierr = MatSeqAIJRestoreArray(Ad, &a);
+	checkPetscError(ierr, "PetscSolverHandler::computeReactionPartials: "
+			"MatSeqAIJRestoreArray failed.");
+	ierr = MatRestoreRowIJ(Ad, 0, PETSC_FALSE, PETSC_FALSE, &nRows, &ai, &aj,
+			&done);
+	checkPetscError(ierr, "PetscSolverHandler::computeReactionPartials: "
+			"MatRestoreRowIJ failed.");
+	if (missingEntry)
+		throw std::string("PetscSolverHandler::computeReactionPartials: "
+				"a partial derivative is not in the structure of the matrix.");
+
+	reactionPoints.clear();
+
+	return;
+}
+
+void PetscSolverHandler::setReactionPartials(Mat &J, PetscInt xi, PetscInt yj,
+		PetscInt zk, const double *vals) {
+	// The CSR pattern of the partial derivatives from the reactions
+	const auto& rowPtr = network->getPartialsRowPointers();
+	const auto& colIndices = network->getPartialsColumnIds();
+	const int dof = rowPtr.size() - 1;
+	if ((int) reactionColIds.size() < dof)
+		reactionColIds.resize(dof);
+
+	// Arguments for MatSetValuesStencil called below
+	MatStencil rowId;
+	rowId.i = xi;
+	rowId.j = yj;
+	rowId.k = zk;
+	int pdColIdsVectorSize = 0;
+
+	// Update the row in the Jacobian that represents each DOF
+	for (int i = 0; i < dof; i++) {
+		// Set component number for the row
+		rowId.c = i;
+
+		// Number of partial derivatives
+		pdColIdsVectorSize = rowPtr[i + 1] - rowPtr[i];
+		// Loop over the list of column ids
+		for (int j = 0; j < pdColIdsVectorSize; j++) {
+			// Set grid coordinate and component number for a column in the list
+			reactionColIds[j].i = xi;
+			reactionColIds[j].j = yj;
+			reactionColIds[j].k = zk;
+			reactionColIds[j].c = colIndices[rowPtr[i] + j];
+		}
+		// Update the matrix directly from the CSR values of this row
+		PetscErrorCode ierr = MatSetValuesStencil(J, 1, &rowId,
+				pdColIdsVectorSize, reactionColIds.data(), vals + rowPtr[i],
+				ADD_VALUES);
+		checkPetscError(ierr, "PetscSolverHandler::setReactionPartials: "
+				"MatSetValuesStencil (reactions) failed.");
+	}
+
+	return;
+}
+
+} /* end namespace xolotlSolver */
@@ -3,6 +3,7 @@
 
 // Includes
 #include "SolverHandler.h"
+#include <map>
 
 namespace xolotlSolver 
 {
@@ -40,6 +41,176 @@ namespace xolotlSolver
  */
    double lastTemperature;
 
+/**
+ * A rate table of the network cached by the handler, whether it was used
+ * during the evaluations at the current time and when it was last used.
+ */
+   struct CachedRateTable 
+   {
+    xolotlCore::RateTable rates;
+    bool used;
+    unsigned long lastUse;
+   };
+
+/**
+ * The rate tables of the network for each distinct temperature found on the
+ * grid. With a temperature gradient, loading a table is much cheaper than
+ * recomputing all the rates each time the temperature changes between two
+ * grid points. The tables that were not used at a given time are dropped
+ * when the time changes.
+ */
+   std::map<double, CachedRateTable> rateTables;
+
+/**
+ * The time of the last evaluation that used the rate tables.
+ */
+   double rateTablesTime;
+
+/**
+ * The temperature at each grid point in the x direction at the time of the
+ * current evaluation. The temperature handlers only depend on the depth and
+ * on the time, so it is computed once per time instead of once per grid
+ * point.
+ */
+   std::vector<double> temperatures;
+
+/**
+ * The time at which the temperatures were computed.
+ */
+   double temperaturesTime;
+
+/**
+ * The memory (in bytes) the cached rate tables can use, the tables are
+ * O(number of reactions) so their number depends on the network. It is set
+ * with the -xolotl_rate_cache_mb option, 256 MB by default.
+ */
+   std::size_t rateTablesBudget;
+
+/**
+ * The memory (in bytes) of one cached rate table, 0 until the first one is
+ * computed.
+ */
+   std::size_t rateTableBytes;
+
+/**
+ * The number of times a rate table was used, it orders the tables from the
+ * least to the most recently used one.
+ */
+   unsigned long rateTablesUses;
+
+/**
+ * Make some room in the memory budget for a new rate table, evicting the
+ * least recently used table if needed. The tables used at the current time
+ * are never evicted because the delayed reaction points point to them.
+ *
+ * @return True if the new table can be cached
+ */
+   bool makeRoomForRateTable();
+
+/**
+ * Drop the cached rate tables that were not used since the time changed. It
+ * has to be called at the beginning of each RHS or Jacobian evaluation.
+ *
+ * @param time The current time
+ */
+   void updateRateTables(double time);
+
+/**
+ * Compute the temperature at each grid point in the x direction if the time
+ * changed. It has to be called at the beginning of each RHS or Jacobian
+ * evaluation.
+ *
+ * @param time The current time
+ */
+   void updateTemperatures(double time);
+
+/**
+ * Set the temperature of the network, using the cached rate table of this
+ * temperature when there is one, and update the modified trap-mutation rate.
+ * Nothing is done if the temperature is the same as the last one.
+ *
+ * @param temperature The temperature
+ * @return The cached rate table of this temperature, nullptr if there is none
+ */
+   const xolotlCore::RateTable * setNetworkTemperature(double temperature);
+
+/**
+ * A grid point whose reactions are computed by the threads after the loop
+ * over the grid, with the stateless evaluation of the network.
+ */
+   struct ReactionPoint 
+   {
+    PetscInt xi, yj, zk;
+    const PetscScalar * concOffset;
+    PetscScalar * updatedConcOffset;
+    const xolotlCore::RateTable * rates;
+   };
+
+/**
+ * The grid points waiting for their reactions to be computed. The vector is
+ * cleared after each use but keeps its memory.
+ */
+   std::vector<ReactionPoint> reactionPoints;
+
+/**
+ * One vector of partial derivatives of the reactions for each thread, in the
+ * same format as reactionPartials.
+ */
+   std::vector<std::vector<double> > threadPartials;
+
+/**
+ * The column stencils used to add the partial derivatives of the reactions
+ * of one row to the Jacobian.
+ */
+   std::vector<MatStencil> reactionColIds;
+
+/**
+ * Should the reactions at the grid point be delayed and computed by the
+ * threads? It is the case when several threads are used and the rate table
+ * of the temperature of the point is cached, otherwise the reactions have to
+ * be computed right away by the network.
+ *
+ * @param rates The cached rate table returned by setNetworkTemperature()
+ * @return True if the point has to be added to reactionPoints
+ */
+   bool useThreads(const xolotlCore::RateTable * rates) const 
+   {
+    return numThreads > 1 && rates;
+   }
+
+/**
+ * Add the fluxes from the reactions of all the points in reactionPoints to
+ * their updated concentrations, with the points shared between the threads.
+ * The list of points is then cleared.
+ */
+   void computeReactionFluxes();
+
+/**
+ * Add the partial derivatives from the reactions of all the points in
+ * reactionPoints to the Jacobian. Each thread computes one point at a time in
+ * its own vector and, with an AIJ matrix, adds the values directly in the
+ * rows of this point in the local diagonal block, which must be assembled
+ * (an exception is thrown otherwise). With other matrix types the values are
+ * added by the main thread. The list of points is then cleared.
+ *
+ * @param da The PETSc distributed array
+ * @param J The Jacobian
+ */
+   void computeReactionPartials(DM &da, Mat &J);
+
+/**
+ * Add the partial derivatives from the reactions at one grid point to the
+ * Jacobian.
+ *
+ * @param J The Jacobian
+ * @param xi The index of the grid point in the x direction
+ * @param yj The index in the y direction, ignored in 1D
+ * @param zk The index in the z direction, ignored in 1D and 2D
+ * @param vals The partial derivatives, in the CSR pattern of the network
+ */
+   void setReactionPartials(Mat &J, PetscInt xi, PetscInt yj, PetscInt zk,
+                            const double *vals);
+
 /**
  * A pointer to all of the reactants in the network. It is retrieved from the
  * network after it is set.
@@ -47,35 +218,120 @@ namespace xolotlSolver
    std::shared_ptr<std::vector<xolotlCore::IReactant *>> allReactants;
 
 /**
- * A vector for holding the partial derivatives of one cluster. It is sized in
- * the createSolverContext() operation.
+ * A vector for holding the partial derivatives of the reactions at one grid
+ * point, in the compressed sparse row (CSR) format given by the network.
+ * It is sized in the createSolverContext() operation, right after the
+ * network built its diagonal fill pattern.
  *
- * The vector is used for every cluster and immediately reset to zero before
- * being used for the next. This allows the acquisition of the partial
- * derivatives to take up minimal memory and require no additional dynamic
- * allocations.
+ * The vector is used for every grid point and fully overwritten by the
+ * network. This allows the acquisition of the partial derivatives to take up
+ * minimal memory and require no additional dynamic allocations.
+ */
+   std::vector<double> reactionPartials;
+
+/**
+ * The position of the current grid point given to the temperature and
+ * advection handlers. It is a member so that the RHS and Jacobian
+ * evaluations don't build a new vector each time.
+ */
+   std::vector<double> gridPosition;
+
+/**
+ * The partial derivatives from the modified trap-mutation at one grid point
+ * and their indices, three for each helium cluster. They are sized by
+ * initializeScratch().
  */
-   std::vector<double> clusterPartials;
+   std::vector<PetscScalar> mutationVals;
+   std::vector<PetscInt> mutationIndices;
 
 /**
- * A vector for holding the partial derivatives for one cluster in the order
- * that PETSc expects. It is sized in the createSolverContext() operation.
+ * Size the vectors used at each grid point by the RHS and Jacobian
+ * evaluations, so that they don't have to allocate any memory. It is called
+ * in the createSolverContext() operation, after reactionPartials is sized.
+ */
+   void initializeScratch();
+
+/**
+ * The time spent in the RHS evaluations at each grid point in the x
+ * direction, used to balance the work between the processes. It is only
+ * sized (to the number of grid points) when the times have to be measured,
+ * and only in 1D where each point of the list of reactionPoints has its own
+ * x index.
+ */
+   std::vector<double> pointTimes;
+
+/**
+ * The sparse block fills and the mobile degrees of freedom, saved by
+ * setBlockFills() and createGhostScatter() so that they can be given to a
+ * new distributed array when the grid is repartitioned.
+ */
+   std::vector<PetscInt> dfillSparse, ofillSparse, mobileDOFs;
+
+/**
+ * Set the sparse block fills of the distributed array and report their
+ * density. It is called in the createSolverContext() operation.
+ *
+ * @param da The PETSc distributed array
+ * @param dof The number of degrees of freedom
+ * @param dfill The fill of the diagonal block (reactions)
+ * @param ofill The fill of the off-diagonal block (diffusion and advection)
+ */
+   void setBlockFills(DM &da, int dof, xolotlCore::SparseFillMap &dfill,
+                      xolotlCore::SparseFillMap &ofill);
+
+/**
+ * Create the scatter used by globalToLocal() and attach it to the distributed
+ * array. Only the degrees of freedom appearing in ofill (the mobile clusters)
+ * are coupled to the neighboring grid points, so they are the only ones sent
+ * to the ghost points. It is called in the createSolverContext() operation,
+ * after setBlockFills().
+ *
+ * @param da The PETSc distributed array
+ * @param dof The number of degrees of freedom
+ * @param ofill The fill of the off-diagonal block (diffusion and advection)
+ */
+   void createGhostScatter(DM &da, int dof, xolotlCore::SparseFillMap &ofill);
+
+/**
+ * Create the scatter used by globalToLocal() from the saved mobileDOFs and
+ * attach it to the distributed array.
  *
- * The vector is used for every cluster and immediately reset to zero before
- * being used for the next. This allows the acquisition of the partial
- * derivatives to take up minimal memory and require no additional dynamic
- * allocations.
+ * @param da The PETSc distributed array
+ * @param dof The number of degrees of freedom
  */
-   std::vector<double> reactingPartialsForCluster;
+   void attachGhostScatter(DM &da, int dof);
 
   public:
 
 //! The Constructor
-  PetscSolverHandler() : lastTemperature(0.0) {}
+  PetscSolverHandler() : lastTemperature(0.0), rateTablesTime(-1.0),
+                         temperaturesTime(-1.0),
+                         rateTablesBudget(256 * 1024 * 1024), rateTableBytes(0),
+                         rateTablesUses(0), gridPosition(3, 0.0) {}
 
 //! The Destructor
   ~PetscSolverHandler() {}
 
+/**
+ * Fill the local vector with the solution using the scatter created by
+ * createGhostScatter(), or with the full ghost exchange of the distributed
+ * array if there is none.
+ * \see ISolverHandler.h
+ */
+  void globalToLocal(DM &da, Vec &C, Vec &localC, bool begin);
+
+/**
+ * The grid is never repartitioned by default.
+ * \see ISolverHandler.h
+ */
+  bool needRepartition() const { return false; }
+
+/**
+ * The grid is never repartitioned by default.
+ * \see ISolverHandler.h
+ */
+  void repartition(DM &da, Vec &C) { return; }
+
  }; //end class PetscSolverHandler
 
 } /* end namespace xolotlSolver */
@@ -18,6 +18,9 @@ namespace xolotlSolver
 //! The name of the network file
   std::string networkName;
 
+//! The reader of the network file used to restart the simulation.
+  std::shared_ptr<xolotlCore::HDF5RestartReader> restartReader;
+
 //! The original network created from the network loader.
   xolotlCore::IReactionNetwork* network;
 
@@ -66,6 +69,9 @@ namespace xolotlSolver
 //! The sputtering yield for the problem.
   double sputteringYield;
 
+//! The number of threads computing the reactions at the local grid points.
+  int numThreads;
+
 //! Method generating the grid in the x direction
   void 
   generateGrid( int nx, double hx, int surfacePos )
@@ -186,6 +192,18 @@ namespace xolotlSolver
 // Look at if the user wants to use a regular grid in the x direction
     useRegularGrid = options.useRegularXGrid();
 
+// Set the number of threads, they need OpenMP
+    numThreads = options.getNumThreads();
+#ifndef _OPENMP
+    if (numThreads > 1) 
+    {
+     std::cerr << "SolverHandler Message: Xolotl was built without OpenMP, "
+               << "the reactions will be computed with only one thread." 
+               << std::endl;
+     numThreads = 1;
+    }
+#endif
+
 // Should we be able to move the surface?
     auto map = options.getProcesses();
     movingSurface = map["movingSurface"];
@@ -285,6 +303,16 @@ namespace xolotlSolver
     return fluxHandler;
    }
 
+/**
+ * Get the temperature handler.
+ * \see ISolverHandler.h
+ */
+   xolotlCore::ITemperatureHandler*
+   getTemperatureHandler() const 
+   {
+    return temperatureHandler;
+   }
+
 /**
  * Get the advection handler.
  * \see ISolverHandler.h
@@ -335,6 +363,16 @@ namespace xolotlSolver
     return networkName;
    }
 
+/**
+ * Get the restart reader.
+ * \see ISolverHandler.h
+ */
+   xolotlCore::HDF5RestartReader* 
+   getRestartReader() const 
+   {
+    return restartReader.get();
+   }
+
  };
 //end class SolverHandler
 